@@ -28,8 +28,12 @@ struct UserData{
 
 // Include this header file to get access to VectorNav sensors.
 #include "vn/sensors.h"
+#include "vn/serialport.h"
 #include "vn/util.h"
 #include "vn/compositedata.h"
+#include "vn/configurationplan.h"
+#include "vn/binarylayout.h"
+#include "vn/lazycompositeview.h"
 #include "vn/matrix.h"
 
 // We need this file for our sleep function.
@@ -41,6 +45,59 @@ using namespace vn::sensors;
 using namespace vn::protocol::uart;
 using namespace vn::xplat;
 
+// Binary output message configured on the sensor.
+typedef BinaryLayout<
+  layout::Common<
+    layout::common::Quaternion,
+    layout::common::AngularRate,
+    layout::common::Position,
+    layout::common::Accel,
+    layout::common::MagPres>,
+  layout::Attitude<
+    layout::attitude::YprU>, //<-- returning yaw pitch roll uncertainties
+  layout::Ins<
+    layout::ins::InsStatus,
+    layout::ins::PosLla,
+    layout::ins::PosEcef,
+    layout::ins::VelBody,
+    layout::ins::AccelEcef> > AsyncOutputLayout;
+
+// Gives publishAsyncData the fields of a packet decoded with
+// AsyncOutputLayout, which holds every field the layout lists. Where two
+// groups hold the same value the later group is used, as CompositeData does.
+class DecodedAsyncOutput{
+public:
+  explicit DecodedAsyncOutput(const AsyncOutputLayout::Data& d) : d(d) { }
+
+  bool hasQuaternion() const { return true; }
+  vec4f quaternion() const { return d.get<layout::common::Quaternion>(); }
+  bool hasAngularRate() const { return true; }
+  vec3f angularRate() const { return d.get<layout::common::AngularRate>(); }
+  bool hasAcceleration() const { return true; }
+  vec3f acceleration() const { return d.get<layout::common::Accel>(); }
+  bool hasAttitudeUncertainty() const { return true; }
+  vec3f attitudeUncertainty() const { return d.get<layout::attitude::YprU>(); }
+  bool hasMagnetic() const { return true; }
+  vec3f magnetic() const { return d.get<layout::common::MagPres>().magnetic; }
+  bool hasTemperature() const { return true; }
+  float temperature() const { return d.get<layout::common::MagPres>().temperature; }
+  bool hasPressure() const { return true; }
+  float pressure() const { return d.get<layout::common::MagPres>().pressure; }
+  bool hasPositionEstimatedLla() const { return true; }
+  vec3d positionEstimatedLla() const { return d.get<layout::ins::PosLla>(); }
+  bool hasPositionEstimatedEcef() const { return true; }
+  vec3d positionEstimatedEcef() const { return d.get<layout::ins::PosEcef>(); }
+  bool hasInsStatus() const { return true; }
+  InsStatus insStatus() const { return d.get<layout::ins::InsStatus>(); }
+
+  // The layout does not include yaw, pitch, roll.
+  bool hasYawPitchRoll() const { return false; }
+  vec3f yawPitchRoll() const { throw vn::invalid_operation(); }
+
+private:
+  const AsyncOutputLayout::Data& d;
+};
+
 //Unused covariances initilized to zero's
 boost::array<double, 9ul> linear_accel_covariance = { };
 boost::array<double, 9ul> angular_vel_covariance = { };
@@ -61,6 +118,7 @@ diagnostic_msgs::KeyValue msgKey;
 
 // Method declarations for future use.
 void asciiOrBinaryAsyncMessageReceived(void* userData, Packet& p, size_t index);
+template<typename Data> void publishAsyncData(Data& cd);
 void ConnectionState(void *userData, const char *rawData, size_t length, size_t runningIndex);
 void ClearCharArray(char *Data, int length);
 vec3d ECEF2ENU(vec3d posECEF, vec3d lla);
@@ -119,6 +177,8 @@ int main(int argc, char *argv[]){
   // Serial Port Settings
   string SensorPort;
   int SensorBaudrate;
+  bool optimize_serial_port;
+  bool pipeline_mode;
   int async_output_rate;
 
   // Sensor IMURATE (800Hz by default, used to configure device)
@@ -133,6 +193,8 @@ int main(int argc, char *argv[]){
   pn.param<int>("async_output_rate", async_output_rate, 20);
   pn.param<std::string>("serial_port", SensorPort, "/dev/ttyUSB0");
   pn.param<int>("serial_baud", SensorBaudrate, 115200);
+  pn.param<bool>("optimize_serial_port", optimize_serial_port, true);
+  pn.param<bool>("pipeline_mode", pipeline_mode, true);
   pn.param<int>("fixed_imu_rate", SensorImuRate, 800);
 
   //Call to set covariances
@@ -156,7 +218,20 @@ int main(int argc, char *argv[]){
 
   // Now let's create a VnSensor object and use it to connect to our sensor.
   VnSensor vs;
-  vs.connect(SensorPort, SensorBaudrate);
+  vs.setPipelineMode(pipeline_mode);
+  // Nothing else configures the sensor while we are connected, so registers
+  // read or written once need not be fetched again.
+  vs.setRegisterCacheEnabled(true);
+  vs.connect(SensorPort, SensorBaudrate, optimize_serial_port);
+
+  if (optimize_serial_port)
+  {
+    SerialPort::LatencySettings latency = SerialPort::latencySettings(SensorPort);
+    if (latency.hasLowLatencyMode)
+      ROS_INFO("Serial port low latency mode: %s", latency.lowLatencyMode ? "on" : "off");
+    if (latency.hasLatencyTimer)
+      ROS_INFO("Serial port latency timer: %u ms", latency.latencyTimerMs);
+  }
 
   // Now we verify connection (Should be good if we made it this far)
   if (vs.verifySensorConnectivity())
@@ -168,21 +243,25 @@ int main(int argc, char *argv[]){
   string mn = vs.readModelNumber();
   ROS_INFO("Model Number: %s\n", mn.c_str());
 
-  ROS_INFO("Restarting factory configuration .....................................");
-  vs.restoreFactorySettings();
-  Thread::sleepSec(3);
-
-  // Let's do some simple reconfiguration of the sensor. As it comes from the
-  // factory, the sensor outputs asynchronous data at 40 Hz.
+  // Describe the configuration we want. It is only written to the sensor
+  // when it differs from the one saved there on a previous launch, so
+  // restarts skip the factory reset and the flash write. Fields we do not
+  // set keep the values the sensor already has.
   ROS_INFO("New resgister configuration.........................................");
-  vs.writeAsyncDataOutputFrequency(async_output_rate); // see table 6.2.8
-  uint32_t newHz = vs.readAsyncDataOutputFrequency();
+  ConfigurationPlan plan;
+  // Everything published comes from binary output 1, written below, so the
+  // ASCII message and the other binary outputs are turned off rather than
+  // left as a previous user or the factory defaults had them.
+  plan.setAsyncDataOutputType(VNOFF);
+  plan.setAsyncDataOutputFrequency(async_output_rate); // see table 6.2.8
+  BinaryOutputRegister disabledOutput;
+  plan.setBinaryOutput2(disabledOutput);
+  plan.setBinaryOutput3(disabledOutput);
 
   //added by Harold
   ImuRateConfigurationRegister IMUR = vs.readImuRateConfiguration();
   IMUR.imuRate = SensorImuRate;
-  vs.writeImuRateConfiguration(IMUR);
-  IMUR = vs.readImuRateConfiguration();
+  plan.setImuRateConfiguration(IMUR);
 
   /* VPE Resgister */
   VpeBasicControlRegister vpeReg = vs.readVpeBasicControl();
@@ -198,7 +277,7 @@ int main(int argc, char *argv[]){
   // Tuning Mode ****************************************************************
   // vpeReg.tuningMode = VPEMODE_OFF;
   vpeReg.tuningMode = VPEMODE_MODE1;
-  vs.writeVpeBasicControl(vpeReg);
+  plan.setVpeBasicControl(vpeReg);
 
   /* INS Resgister */
   InsBasicConfigurationRegisterVn300 InsReg = vs.readInsBasicConfigurationVn300();
@@ -212,7 +291,7 @@ int main(int argc, char *argv[]){
   InsReg.ahrsAiding = 1;
   // Estimation Base line *******************************************************
   InsReg.estBaseline = 1;
-  vs.writeInsBasicConfigurationVn300(InsReg); //added by Harold
+  plan.setInsBasicConfigurationVn300(InsReg); //added by Harold
 
   /* HIS Calibration */
   MagnetometerCalibrationControlRegister hsiReg = vs.readMagnetometerCalibrationControl();
@@ -222,11 +301,11 @@ int main(int argc, char *argv[]){
   // HSI Output *****************************************************************
   hsiReg.hsiOutput = HSIOUTPUT_USEONBOARD;
   //hsiReg.hsiOutput = HSIOUTPUT_NOONBOARD;
-  vs.writeMagnetometerCalibrationControl(hsiReg);  //added by Harold
+  plan.setMagnetometerCalibrationControl(hsiReg);  //added by Harold
 
   /* BaseLine Configuration */
   /// BaseLine and Antenna A offset Configuration
-  vs.writeGpsAntennaOffset(Antenna_A_offset);
+  plan.setGpsAntennaOffset(Antenna_A_offset);
   GpsCompassBaselineRegister baseli_config = vs.readGpsCompassBaseline();
   baseli_config.position = baseline_position;
   // Uncertainty calculation
@@ -236,39 +315,65 @@ int main(int argc, char *argv[]){
       max = baseli_config.position[i];
   }
   baseli_config.uncertainty = {max * 0.025, max * 0.025, max * 0.025};
-  vs.writeGpsCompassBaseline(baseli_config);
-
-  /* Save on flash memory all configurations */
-  vs.writeSettings();
+  plan.setGpsCompassBaseline(baseli_config);
+
+  /* Write the registers that differ and save them on flash memory */
+  size_t numOfRegistersWritten;
+  switch (plan.apply(vs, &numOfRegistersWritten)){
+    case PLANOUTCOME_UNCHANGED:
+      ROS_INFO("Sensor already configured (%s)", plan.fingerprint().c_str());
+      break;
+    case PLANOUTCOME_TAGREFRESHED:
+      ROS_INFO("Sensor settings matched; stored configuration tag (%s)", plan.fingerprint().c_str());
+      break;
+    default:
+      ROS_INFO("Updated %d registers (%s)", (int)numOfRegistersWritten, plan.fingerprint().c_str());
+      break;
+  }
 
   /* --------------------------------------- */
   /* ------- Read all configurations ------- */
   /* --------------------------------------- */
+  // The reads are independent, so send them as one pipelined batch instead
+  // of waiting a full round trip for each register. The cache is emptied
+  // first so the sensor itself is checked rather than what we last wrote.
+  vs.invalidateRegisterCache();
+  vector<Packet> config = vs.readRegisters({7, 227, 35, 67, 44, 57, 93});
+  uint32_t newHz;
+  config[0].parseAsyncDataOutputFrequency(&newHz);
+  uint16_t navDivisor;
+  float filterTargetRate, filterMinRate;
+  config[1].parseImuRateConfiguration(&IMUR.imuRate, &navDivisor, &filterTargetRate, &filterMinRate);
+  uint8_t vpeEnable, headingMode, filteringMode, tuningMode;
+  config[2].parseVpeBasicControl(&vpeEnable, &headingMode, &filteringMode, &tuningMode);
+  uint8_t scenario, ahrsAiding, estBaseline;
+  config[3].parseInsBasicConfiguration(&scenario, &ahrsAiding, &estBaseline);
+  uint8_t hsiMode, hsiOutput, convergeRate;
+  config[4].parseMagnetometerCalibrationControl(&hsiMode, &hsiOutput, &convergeRate);
+  vec3f Ant_offset;
+  config[5].parseGpsAntennaOffset(&Ant_offset);
+  config[6].parseGpsCompassBaseline(&baseli_config.position, &baseli_config.uncertainty);
+
   ROS_INFO("Async output frequency:\t%d Hz", newHz);
   ROS_INFO("IMU Frequency:\t\t%d Hz", IMUR.imuRate);
   /* VPE Resgister */
   ROS_INFO("...VPE Resgister....................................................");
-  vpeReg = vs.readVpeBasicControl();
-  ROS_INFO("Enable:\t\t%d", vpeReg.enable);
-  ROS_INFO("Heading Mode:\t%d", vpeReg.headingMode);
-  ROS_INFO("Filtering Mode:\t%d", vpeReg.filteringMode);
-  ROS_INFO("Tuning Mode:\t%d", vpeReg.tuningMode);
+  ROS_INFO("Enable:\t\t%d", vpeEnable);
+  ROS_INFO("Heading Mode:\t%d", headingMode);
+  ROS_INFO("Filtering Mode:\t%d", filteringMode);
+  ROS_INFO("Tuning Mode:\t%d", tuningMode);
   /* INS Resgister */
   ROS_INFO("...INS Resgister....................................................");
-  InsReg = vs.readInsBasicConfigurationVn300(); //added by Harold
-  ROS_INFO("Scenario:\t%d", InsReg.scenario);
-  ROS_INFO("AHRS Aiding:\t%d", InsReg.ahrsAiding);
-  ROS_INFO("Base Line:\t%d", InsReg.estBaseline);
+  ROS_INFO("Scenario:\t%d", scenario);
+  ROS_INFO("AHRS Aiding:\t%d", ahrsAiding);
+  ROS_INFO("Base Line:\t%d", estBaseline);
   /* HIS Calibration */
   ROS_INFO("...HIS Calibration..................................................");
-  hsiReg = vs.readMagnetometerCalibrationControl();//added by Harold
-  ROS_INFO("Mode:\t%d", hsiReg.hsiMode);
-  ROS_INFO("Output:\t%d\n", hsiReg.hsiOutput);
+  ROS_INFO("Mode:\t%d", hsiMode);
+  ROS_INFO("Output:\t%d\n", hsiOutput);
   /* BaseLine Configuration */
   ROS_INFO("BaseLine Configuration..............................................");
-  vec3f Ant_offset = vs.readGpsAntennaOffset();
   ROS_INFO("Antena A offset:\t[%.2f, %.2f, %.2f]", Ant_offset[0], Ant_offset[1], Ant_offset[2]);
-  baseli_config = vs.readGpsCompassBaseline();
   ROS_INFO("Position:\t\t[%.2f, %.2f, %.2f]", baseli_config.position[0], baseli_config.position[1], baseli_config.position[2]);
   ROS_INFO("Uncertainty:\t\t[%.4f, %.4f, %.4f]\n", baseli_config.uncertainty[0], baseli_config.uncertainty[1], baseli_config.uncertainty[2]);
   ROS_INFO("Convertion Configuration..............................................");
@@ -281,24 +386,9 @@ int main(int argc, char *argv[]){
   else                 ROS_INFO("Rotation mode: No apply\n");
   cout << endl << endl << endl << endl;
 
-  BinaryOutputRegister bor(
+  BinaryOutputRegister bor = AsyncOutputLayout::binaryOutputRegister(
     ASYNCMODE_PORT1,
-    SensorImuRate / async_output_rate,  // update rate [ms]
-    COMMONGROUP_QUATERNION
-    | COMMONGROUP_ANGULARRATE
-    | COMMONGROUP_POSITION
-    | COMMONGROUP_ACCEL
-    | COMMONGROUP_MAGPRES,
-    TIMEGROUP_NONE,
-    IMUGROUP_NONE,
-    GPSGROUP_NONE,
-    ATTITUDEGROUP_YPRU, //<-- returning yaw pitch roll uncertainties
-    INSGROUP_INSSTATUS
-    | INSGROUP_POSLLA
-    | INSGROUP_POSECEF
-    | INSGROUP_VELBODY
-    | INSGROUP_ACCELECEF,
-    GPSGROUP_NONE);
+    SensorImuRate / async_output_rate);  // update rate [ms]
 
   msgKey.key = "ConnStatus[%]";
   vs.registerRawDataReceivedHandler(NULL, ConnectionState);
@@ -328,8 +418,34 @@ int main(int argc, char *argv[]){
 }
 
 void asciiOrBinaryAsyncMessageReceived(void* userData, Packet& p, size_t index){
+  if (p.type() == Packet::TYPE_BINARY){
+    // Handlers are only called from the sensor's packet thread, so the
+    // decoded values can be reused for every packet.
+    static AsyncOutputLayout::Data decoded;
+
+    if (AsyncOutputLayout::decode(p, decoded)){
+      // Packets from the configured binary output are read at fixed offsets.
+      DecodedAsyncOutput cd(decoded);
+      publishAsyncData(cd);
+    }
+    else{
+      // Only the fields read while publishing are decoded.
+      vn::sensors::LazyCompositeView cd(p);
+      publishAsyncData(cd);
+    }
+  }
+  else{
+    // Handlers are only called from the sensor's packet thread, so the same
+    // CompositeData can be reused for every packet without allocating.
+    static vn::sensors::CompositeData cd;
+    vn::sensors::CompositeData::parseInto(p, cd);
+    publishAsyncData(cd);
+  }
+}
+
+// Data is a CompositeData, a LazyCompositeView or a DecodedAsyncOutput.
+template<typename Data> void publishAsyncData(Data& cd){
   // By default, the orientation of IMU is NED (North East Down).
-  vn::sensors::CompositeData cd = vn::sensors::CompositeData::parse(p);
   sensor_msgs::MagneticField msgMag;
   sensor_msgs::Imu msgIMU;
   sensor_msgs::NavSatFix msgGPS;
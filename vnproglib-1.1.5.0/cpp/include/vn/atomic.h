@@ -0,0 +1,213 @@
+/// \file
+/// {COMMON_HEADER}
+///
+/// \section DESCRIPTION
+/// This header file provides the class Atomic and memory fences.
+#ifndef _VNXPLAT_ATOMIC_H_
+#define _VNXPLAT_ATOMIC_H_
+
+#include "nocopy.h"
+#include "compiler.h"
+#include "export.h"
+
+#if VN_SUPPORTS_ATOMIC
+	#include <atomic>
+#elif !defined(__GNUC__)
+	#error "Unknown System"
+#endif
+
+namespace vn {
+namespace xplat {
+
+/// \brief Holds a value which may be read and written by multiple threads
+///     without locking.
+///
+/// Only integral and pointer types are supported. Unless noted otherwise,
+/// the operations are sequentially consistent.
+template <typename T>
+class Atomic : private util::NoCopy
+{
+
+	// Constructors ///////////////////////////////////////////////////////////
+
+public:
+
+	/// \brief Creates a new atomic value.
+	///
+	/// \param[in] value The initial value.
+	explicit Atomic(T value = T()) :
+		_value(value)
+	{ }
+
+	// Public Methods /////////////////////////////////////////////////////////
+
+public:
+
+	/// \brief Reads the value.
+	///
+	/// \return The current value.
+	T load() const
+	{
+		#if VN_SUPPORTS_ATOMIC
+		return _value.load();
+		#else
+		return __atomic_load_n(&_value, __ATOMIC_SEQ_CST);
+		#endif
+	}
+
+	/// \brief Reads the value with acquire ordering only. Writes made by the
+	///     thread which stored the value with \ref storeRelease are visible
+	///     after this returns.
+	///
+	/// \return The current value.
+	T loadAcquire() const
+	{
+		#if VN_SUPPORTS_ATOMIC
+		return _value.load(std::memory_order_acquire);
+		#else
+		return __atomic_load_n(&_value, __ATOMIC_ACQUIRE);
+		#endif
+	}
+
+	/// \brief Writes the value.
+	///
+	/// \param[in] value The new value.
+	void store(T value)
+	{
+		#if VN_SUPPORTS_ATOMIC
+		_value.store(value);
+		#else
+		__atomic_store_n(&_value, value, __ATOMIC_SEQ_CST);
+		#endif
+	}
+
+	/// \brief Writes the value with release ordering only. See
+	///     \ref loadAcquire.
+	///
+	/// \param[in] value The new value.
+	void storeRelease(T value)
+	{
+		#if VN_SUPPORTS_ATOMIC
+		_value.store(value, std::memory_order_release);
+		#else
+		__atomic_store_n(&_value, value, __ATOMIC_RELEASE);
+		#endif
+	}
+
+	/// \brief Replaces the value.
+	///
+	/// \param[in] value The new value.
+	/// \return The previous value.
+	T exchange(T value)
+	{
+		#if VN_SUPPORTS_ATOMIC
+		return _value.exchange(value);
+		#else
+		return __atomic_exchange_n(&_value, value, __ATOMIC_SEQ_CST);
+		#endif
+	}
+
+	/// \brief Replaces the value only if it currently equals the expected
+	///     value.
+	///
+	/// \param[in,out] expected The expected value. If the exchange fails,
+	///     this is updated with the current value.
+	/// \param[in] desired The new value.
+	/// \return <c>true</c> if the value was replaced; otherwise <c>false</c>.
+	bool compareExchange(T& expected, T desired)
+	{
+		#if VN_SUPPORTS_ATOMIC
+		return _value.compare_exchange_strong(expected, desired);
+		#else
+		return __atomic_compare_exchange_n(&_value, &expected, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+		#endif
+	}
+
+	/// \brief Adds to the value. Only available for integral types.
+	///
+	/// \param[in] amount The amount to add.
+	/// \return The previous value.
+	T fetchAdd(T amount)
+	{
+		#if VN_SUPPORTS_ATOMIC
+		return _value.fetch_add(amount);
+		#else
+		return __atomic_fetch_add(&_value, amount, __ATOMIC_SEQ_CST);
+		#endif
+	}
+
+	// Private Members ////////////////////////////////////////////////////////
+
+private:
+
+	#if VN_SUPPORTS_ATOMIC
+	std::atomic<T> _value;
+	#else
+	T _value;
+	#endif
+
+};
+
+/// \brief Prevents memory reads before the fence from being reordered with
+///     reads and writes after it.
+inline void fenceAcquire()
+{
+	#if VN_SUPPORTS_ATOMIC
+	std::atomic_thread_fence(std::memory_order_acquire);
+	#else
+	__atomic_thread_fence(__ATOMIC_ACQUIRE);
+	#endif
+}
+
+/// \brief Prevents memory reads and writes before the fence from being
+///     reordered with writes after it.
+inline void fenceRelease()
+{
+	#if VN_SUPPORTS_ATOMIC
+	std::atomic_thread_fence(std::memory_order_release);
+	#else
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+	#endif
+}
+
+/// \brief Indicates if \ref fenceHeavy can make other threads' memory
+///     accesses ordered, which lets \ref fenceLight skip the hardware fence.
+///     Set once when the library is loaded.
+extern vn_proglib_DLLEXPORT bool AsymmetricFencesSupported;
+
+/// \brief Half of a full fence split unevenly between two threads.
+///
+/// A thread which calls \ref fenceLight between a write and a read is
+/// ordered as if by a full fence with respect to a thread which calls
+/// \ref fenceHeavy. Where the operating system can interrupt other threads
+/// to order their accesses, this is only a compiler barrier, so it suits a
+/// path that runs often while the other side runs rarely.
+inline void fenceLight()
+{
+	if (AsymmetricFencesSupported)
+	{
+		#if VN_SUPPORTS_ATOMIC
+		std::atomic_signal_fence(std::memory_order_seq_cst);
+		#else
+		__atomic_signal_fence(__ATOMIC_SEQ_CST);
+		#endif
+	}
+	else
+	{
+		#if VN_SUPPORTS_ATOMIC
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		#else
+		__atomic_thread_fence(__ATOMIC_SEQ_CST);
+		#endif
+	}
+}
+
+/// \brief The expensive half of the fence described at \ref fenceLight.
+///     Orders the memory accesses of every thread in the process, which
+///     can take several microseconds.
+vn_proglib_DLLEXPORT void fenceHeavy();
+
+}
+}
+
+#endif
@@ -0,0 +1,746 @@
+/// \file
+/// {COMMON_HEADER}
+///
+/// \section DESCRIPTION
+/// This header file provides the BinaryLayout class template which describes
+/// a binary output message at compile time.
+#ifndef _VNSENSORS_BINARYLAYOUT_H_
+#define _VNSENSORS_BINARYLAYOUT_H_
+
+#include <cstring>
+
+#include "int.h"
+#include "vector.h"
+#include "matrix.h"
+#include "types.h"
+#include "utilities.h"
+#include "packet.h"
+#include "registers.h"
+#include "compositedata.h"
+
+namespace vn {
+namespace sensors {
+
+/// \brief Building blocks for \ref BinaryLayout.
+///
+/// A layout is made up of groups which are made up of fields. The fields of
+/// each group are found in the nested namespace named after the group, for
+/// example <c>layout::common::Quaternion</c>. Currently the Common, Attitude
+/// and INS groups are described.
+namespace layout {
+
+/// \brief Marks an unused field or group slot.
+struct None { };
+
+/// \brief Decodes a value of type <c>T</c> from its binary representation.
+///
+/// Each specialization provides the number of bytes the value occupies in a
+/// binary packet and a read method which assumes that many bytes are
+/// available.
+template<typename T>
+struct FieldReader;
+
+/// \brief The values of the Common group's Imu field.
+struct ImuValues
+{
+	math::vec3f accelerationUncompensated;	///< The uncompensated acceleration.
+	math::vec3f angularRateUncompensated;	///< The uncompensated angular rate.
+};
+
+/// \brief The values of the Common group's MagPres field.
+struct MagPresValues
+{
+	math::vec3f magnetic;	///< The compensated magnetic measurement.
+	float temperature;		///< The temperature.
+	float pressure;			///< The pressure.
+};
+
+/// \brief The values of the Common group's DeltaTheta field.
+struct DeltaThetaValues
+{
+	float deltaTime;			///< The integration time.
+	math::vec3f deltaTheta;		///< The delta rotation angles.
+	math::vec3f deltaVelocity;	///< The delta velocity.
+};
+
+template<>
+struct FieldReader<uint8_t>
+{
+	static const size_t Size = 1;
+
+	static uint8_t read(const char* data)
+	{
+		return static_cast<uint8_t>(*data);
+	}
+};
+
+template<>
+struct FieldReader<uint16_t>
+{
+	static const size_t Size = 2;
+
+	static uint16_t read(const char* data)
+	{
+		uint16_t v;
+		std::memcpy(&v, data, sizeof(v));
+
+		return stoh(v);
+	}
+};
+
+template<>
+struct FieldReader<uint32_t>
+{
+	static const size_t Size = 4;
+
+	static uint32_t read(const char* data)
+	{
+		uint32_t v;
+		std::memcpy(&v, data, sizeof(v));
+
+		return stoh(v);
+	}
+};
+
+template<>
+struct FieldReader<uint64_t>
+{
+	static const size_t Size = 8;
+
+	static uint64_t read(const char* data)
+	{
+		uint64_t v;
+		std::memcpy(&v, data, sizeof(v));
+
+		return stoh(v);
+	}
+};
+
+template<>
+struct FieldReader<float>
+{
+	static const size_t Size = 4;
+
+	static float read(const char* data)
+	{
+		float v;
+		std::memcpy(&v, data, sizeof(v));
+
+		return v;
+	}
+};
+
+template<>
+struct FieldReader<math::vec3f>
+{
+	static const size_t Size = 12;
+
+	static math::vec3f read(const char* data)
+	{
+		math::vec3f v;
+		std::memcpy(&v.x, data, sizeof(float));
+		std::memcpy(&v.y, data + sizeof(float), sizeof(float));
+		std::memcpy(&v.z, data + 2 * sizeof(float), sizeof(float));
+
+		return v;
+	}
+};
+
+template<>
+struct FieldReader<math::vec3d>
+{
+	static const size_t Size = 24;
+
+	static math::vec3d read(const char* data)
+	{
+		math::vec3d v;
+		std::memcpy(&v.x, data, sizeof(double));
+		std::memcpy(&v.y, data + sizeof(double), sizeof(double));
+		std::memcpy(&v.z, data + 2 * sizeof(double), sizeof(double));
+
+		return v;
+	}
+};
+
+template<>
+struct FieldReader<math::vec4f>
+{
+	static const size_t Size = 16;
+
+	static math::vec4f read(const char* data)
+	{
+		math::vec4f v;
+		std::memcpy(&v.x, data, sizeof(float));
+		std::memcpy(&v.y, data + sizeof(float), sizeof(float));
+		std::memcpy(&v.z, data + 2 * sizeof(float), sizeof(float));
+		std::memcpy(&v.w, data + 3 * sizeof(float), sizeof(float));
+
+		return v;
+	}
+};
+
+template<>
+struct FieldReader<math::mat3f>
+{
+	static const size_t Size = 36;
+
+	static math::mat3f read(const char* data)
+	{
+		// The sensor sends the matrix in column-major order.
+		math::mat3f m;
+		std::memcpy(&m.e00, data, sizeof(float));
+		std::memcpy(&m.e10, data + sizeof(float), sizeof(float));
+		std::memcpy(&m.e20, data + 2 * sizeof(float), sizeof(float));
+		std::memcpy(&m.e01, data + 3 * sizeof(float), sizeof(float));
+		std::memcpy(&m.e11, data + 4 * sizeof(float), sizeof(float));
+		std::memcpy(&m.e21, data + 5 * sizeof(float), sizeof(float));
+		std::memcpy(&m.e02, data + 6 * sizeof(float), sizeof(float));
+		std::memcpy(&m.e12, data + 7 * sizeof(float), sizeof(float));
+		std::memcpy(&m.e22, data + 8 * sizeof(float), sizeof(float));
+
+		return m;
+	}
+};
+
+template<>
+struct FieldReader<protocol::uart::VpeStatus>
+{
+	static const size_t Size = 2;
+
+	static protocol::uart::VpeStatus read(const char* data)
+	{
+		uint16_t v;
+		std::memcpy(&v, data, sizeof(v));
+
+		return protocol::uart::VpeStatus(stoh(v));
+	}
+};
+
+template<>
+struct FieldReader<protocol::uart::InsStatus>
+{
+	static const size_t Size = 2;
+
+	static protocol::uart::InsStatus read(const char* data)
+	{
+		uint16_t v;
+		std::memcpy(&v, data, sizeof(v));
+
+		return static_cast<protocol::uart::InsStatus>(stoh(v));
+	}
+};
+
+template<>
+struct FieldReader<protocol::uart::GpsFix>
+{
+	static const size_t Size = 1;
+
+	static protocol::uart::GpsFix read(const char* data)
+	{
+		return static_cast<protocol::uart::GpsFix>(static_cast<uint8_t>(*data));
+	}
+};
+
+template<>
+struct FieldReader<ImuValues>
+{
+	static const size_t Size = 24;
+
+	static ImuValues read(const char* data)
+	{
+		ImuValues v;
+		v.accelerationUncompensated = FieldReader<math::vec3f>::read(data);
+		v.angularRateUncompensated = FieldReader<math::vec3f>::read(data + 12);
+
+		return v;
+	}
+};
+
+template<>
+struct FieldReader<MagPresValues>
+{
+	static const size_t Size = 20;
+
+	static MagPresValues read(const char* data)
+	{
+		MagPresValues v;
+		v.magnetic = FieldReader<math::vec3f>::read(data);
+		v.temperature = FieldReader<float>::read(data + 12);
+		v.pressure = FieldReader<float>::read(data + 16);
+
+		return v;
+	}
+};
+
+template<>
+struct FieldReader<DeltaThetaValues>
+{
+	static const size_t Size = 28;
+
+	static DeltaThetaValues read(const char* data)
+	{
+		DeltaThetaValues v;
+		v.deltaTime = FieldReader<float>::read(data);
+		v.deltaTheta = FieldReader<math::vec3f>::read(data + 4);
+		v.deltaVelocity = FieldReader<math::vec3f>::read(data + 16);
+
+		return v;
+	}
+};
+
+/// \brief Common base of all field descriptions.
+///
+/// \tparam G The group the field belongs to.
+/// \tparam FlagValue The field's flag in the group field.
+/// \tparam T The type the field is decoded to.
+template<protocol::uart::BinaryGroup G, uint16_t FlagValue, typename T>
+struct FieldBase
+{
+	typedef T Type;
+
+	static const uint8_t GroupBit = G;
+	static const uint16_t Flag = FlagValue;
+	static const size_t Size = FieldReader<T>::Size;
+
+	static T read(const char* data)
+	{
+		return FieldReader<T>::read(data);
+	}
+};
+
+/// \brief Description of a field which maps onto a single value of
+///     \ref CompositeData.
+///
+/// \tparam Has The CompositeData method indicating the value is present.
+/// \tparam Get The CompositeData method returning the value.
+template<protocol::uart::BinaryGroup G, uint16_t FlagValue, typename T, bool (CompositeData::*Has)(), T (CompositeData::*Get)()>
+struct Field : FieldBase<G, FlagValue, T>
+{
+	/// \brief Retrieves the field from data parsed by \ref CompositeData.
+	///
+	/// \param[in] cd The parsed data.
+	/// \param[out] value The field's value.
+	/// \return <c>true</c> if the field was present; otherwise <c>false</c>.
+	static bool fromComposite(CompositeData& cd, T& value)
+	{
+		if (!(cd.*Has)())
+			return false;
+
+		value = (cd.*Get)();
+
+		return true;
+	}
+};
+
+/// \brief Fields of binary group 1 'Common'.
+namespace common {
+
+struct TimeStartup : Field<protocol::uart::BINARYGROUP_COMMON, protocol::uart::COMMONGROUP_TIMESTARTUP, uint64_t, &CompositeData::hasTimeStartup, &CompositeData::timeStartup> { };
+struct TimeGps : Field<protocol::uart::BINARYGROUP_COMMON, protocol::uart::COMMONGROUP_TIMEGPS, uint64_t, &CompositeData::hasTimeGps, &CompositeData::timeGps> { };
+struct TimeSyncIn : Field<protocol::uart::BINARYGROUP_COMMON, protocol::uart::COMMONGROUP_TIMESYNCIN, uint64_t, &CompositeData::hasTimeSyncIn, &CompositeData::timeSyncIn> { };
+struct YawPitchRoll : Field<protocol::uart::BINARYGROUP_COMMON, protocol::uart::COMMONGROUP_YAWPITCHROLL, math::vec3f, &CompositeData::hasYawPitchRoll, &CompositeData::yawPitchRoll> { };
+struct Quaternion : Field<protocol::uart::BINARYGROUP_COMMON, protocol::uart::COMMONGROUP_QUATERNION, math::vec4f, &CompositeData::hasQuaternion, &CompositeData::quaternion> { };
+struct AngularRate : Field<protocol::uart::BINARYGROUP_COMMON, protocol::uart::COMMONGROUP_ANGULARRATE, math::vec3f, &CompositeData::hasAngularRate, &CompositeData::angularRate> { };
+struct Position : Field<protocol::uart::BINARYGROUP_COMMON, protocol::uart::COMMONGROUP_POSITION, math::vec3d, &CompositeData::hasPositionEstimatedLla, &CompositeData::positionEstimatedLla> { };
+struct Velocity : Field<protocol::uart::BINARYGROUP_COMMON, protocol::uart::COMMONGROUP_VELOCITY, math::vec3f, &CompositeData::hasVelocityEstimatedNed, &CompositeData::velocityEstimatedNed> { };
+struct Accel : Field<protocol::uart::BINARYGROUP_COMMON, protocol::uart::COMMONGROUP_ACCEL, math::vec3f, &CompositeData::hasAcceleration, &CompositeData::acceleration> { };
+
+struct Imu : FieldBase<protocol::uart::BINARYGROUP_COMMON, protocol::uart::COMMONGROUP_IMU, ImuValues>
+{
+	static bool fromComposite(CompositeData& cd, Type& value)
+	{
+		if (!cd.hasAccelerationUncompensated() || !cd.hasAngularRateUncompensated())
+			return false;
+
+		value.accelerationUncompensated = cd.accelerationUncompensated();
+		value.angularRateUncompensated = cd.angularRateUncompensated();
+
+		return true;
+	}
+};
+
+struct MagPres : FieldBase<protocol::uart::BINARYGROUP_COMMON, protocol::uart::COMMONGROUP_MAGPRES, MagPresValues>
+{
+	static bool fromComposite(CompositeData& cd, Type& value)
+	{
+		if (!cd.hasMagnetic() || !cd.hasTemperature() || !cd.hasPressure())
+			return false;
+
+		value.magnetic = cd.magnetic();
+		value.temperature = cd.temperature();
+		value.pressure = cd.pressure();
+
+		return true;
+	}
+};
+
+struct DeltaTheta : FieldBase<protocol::uart::BINARYGROUP_COMMON, protocol::uart::COMMONGROUP_DELTATHETA, DeltaThetaValues>
+{
+	static bool fromComposite(CompositeData& cd, Type& value)
+	{
+		if (!cd.hasDeltaTime() || !cd.hasDeltaTheta() || !cd.hasDeltaVelocity())
+			return false;
+
+		value.deltaTime = cd.deltaTime();
+		value.deltaTheta = cd.deltaTheta();
+		value.deltaVelocity = cd.deltaVelocity();
+
+		return true;
+	}
+};
+
+struct InsStatus : Field<protocol::uart::BINARYGROUP_COMMON, protocol::uart::COMMONGROUP_INSSTATUS, protocol::uart::InsStatus, &CompositeData::hasInsStatus, &CompositeData::insStatus> { };
+struct SyncInCnt : Field<protocol::uart::BINARYGROUP_COMMON, protocol::uart::COMMONGROUP_SYNCINCNT, uint32_t, &CompositeData::hasSyncInCnt, &CompositeData::syncInCnt> { };
+struct TimeGpsPps : Field<protocol::uart::BINARYGROUP_COMMON, protocol::uart::COMMONGROUP_TIMEGPSPPS, uint64_t, &CompositeData::hasTimeGpsPps, &CompositeData::timeGpsPps> { };
+
+}
+
+/// \brief Fields of binary group 5 'Attitude'.
+namespace attitude {
+
+struct VpeStatus : Field<protocol::uart::BINARYGROUP_ATTITUDE, protocol::uart::ATTITUDEGROUP_VPESTATUS, protocol::uart::VpeStatus, &CompositeData::hasVpeStatus, &CompositeData::vpeStatus> { };
+struct YawPitchRoll : Field<protocol::uart::BINARYGROUP_ATTITUDE, protocol::uart::ATTITUDEGROUP_YAWPITCHROLL, math::vec3f, &CompositeData::hasYawPitchRoll, &CompositeData::yawPitchRoll> { };
+struct Quaternion : Field<protocol::uart::BINARYGROUP_ATTITUDE, protocol::uart::ATTITUDEGROUP_QUATERNION, math::vec4f, &CompositeData::hasQuaternion, &CompositeData::quaternion> { };
+struct Dcm : Field<protocol::uart::BINARYGROUP_ATTITUDE, protocol::uart::ATTITUDEGROUP_DCM, math::mat3f, &CompositeData::hasDirectionCosineMatrix, &CompositeData::directionCosineMatrix> { };
+struct MagNed : Field<protocol::uart::BINARYGROUP_ATTITUDE, protocol::uart::ATTITUDEGROUP_MAGNED, math::vec3f, &CompositeData::hasMagneticNed, &CompositeData::magneticNed> { };
+struct AccelNed : Field<protocol::uart::BINARYGROUP_ATTITUDE, protocol::uart::ATTITUDEGROUP_ACCELNED, math::vec3f, &CompositeData::hasAccelerationNed, &CompositeData::accelerationNed> { };
+struct LinearAccelBody : Field<protocol::uart::BINARYGROUP_ATTITUDE, protocol::uart::ATTITUDEGROUP_LINEARACCELBODY, math::vec3f, &CompositeData::hasAccelerationLinearBody, &CompositeData::accelerationLinearBody> { };
+struct LinearAccelNed : Field<protocol::uart::BINARYGROUP_ATTITUDE, protocol::uart::ATTITUDEGROUP_LINEARACCELNED, math::vec3f, &CompositeData::hasAccelerationLinearNed, &CompositeData::accelerationLinearNed> { };
+struct YprU : Field<protocol::uart::BINARYGROUP_ATTITUDE, protocol::uart::ATTITUDEGROUP_YPRU, math::vec3f, &CompositeData::hasAttitudeUncertainty, &CompositeData::attitudeUncertainty> { };
+
+}
+
+/// \brief Fields of binary group 6 'INS'.
+namespace ins {
+
+struct InsStatus : Field<protocol::uart::BINARYGROUP_INS, protocol::uart::INSGROUP_INSSTATUS, protocol::uart::InsStatus, &CompositeData::hasInsStatus, &CompositeData::insStatus> { };
+struct PosLla : Field<protocol::uart::BINARYGROUP_INS, protocol::uart::INSGROUP_POSLLA, math::vec3d, &CompositeData::hasPositionEstimatedLla, &CompositeData::positionEstimatedLla> { };
+struct PosEcef : Field<protocol::uart::BINARYGROUP_INS, protocol::uart::INSGROUP_POSECEF, math::vec3d, &CompositeData::hasPositionEstimatedEcef, &CompositeData::positionEstimatedEcef> { };
+struct VelBody : Field<protocol::uart::BINARYGROUP_INS, protocol::uart::INSGROUP_VELBODY, math::vec3f, &CompositeData::hasVelocityEstimatedBody, &CompositeData::velocityEstimatedBody> { };
+struct VelNed : Field<protocol::uart::BINARYGROUP_INS, protocol::uart::INSGROUP_VELNED, math::vec3f, &CompositeData::hasVelocityEstimatedNed, &CompositeData::velocityEstimatedNed> { };
+struct VelEcef : Field<protocol::uart::BINARYGROUP_INS, protocol::uart::INSGROUP_VELECEF, math::vec3f, &CompositeData::hasVelocityEstimatedEcef, &CompositeData::velocityEstimatedEcef> { };
+struct MagEcef : Field<protocol::uart::BINARYGROUP_INS, protocol::uart::INSGROUP_MAGECEF, math::vec3f, &CompositeData::hasMagneticEcef, &CompositeData::magneticEcef> { };
+struct AccelEcef : Field<protocol::uart::BINARYGROUP_INS, protocol::uart::INSGROUP_ACCELECEF, math::vec3f, &CompositeData::hasAccelerationEcef, &CompositeData::accelerationEcef> { };
+struct LinearAccelEcef : Field<protocol::uart::BINARYGROUP_INS, protocol::uart::INSGROUP_LINEARACCELECEF, math::vec3f, &CompositeData::hasAccelerationLinearEcef, &CompositeData::accelerationLinearEcef> { };
+struct PosU : Field<protocol::uart::BINARYGROUP_INS, protocol::uart::INSGROUP_POSU, float, &CompositeData::hasPositionUncertaintyEstimated, &CompositeData::positionUncertaintyEstimated> { };
+struct VelU : Field<protocol::uart::BINARYGROUP_INS, protocol::uart::INSGROUP_VELU, float, &CompositeData::hasVelocityUncertaintyEstimated, &CompositeData::velocityUncertaintyEstimated> { };
+
+}
+
+/// \brief Storage for the decoded value of field <c>F</c>.
+template<typename F>
+struct FieldValue
+{
+	typename F::Type value;
+};
+
+/// \brief A list of fields from a single group, given in the order of their
+///     flags (which is the order they appear in a packet).
+///
+/// Mistakes in the list are caught at compile time as a negative array size
+/// in one of the checks named <c>FieldsMust...</c>.
+template<
+	typename F1 = None, typename F2 = None, typename F3 = None, typename F4 = None, typename F5 = None,
+	typename F6 = None, typename F7 = None, typename F8 = None, typename F9 = None, typename F10 = None,
+	typename F11 = None, typename F12 = None, typename F13 = None, typename F14 = None, typename F15 = None>
+struct FieldGroup
+{
+	typedef FieldGroup<F2, F3, F4, F5, F6, F7, F8, F9, F10, F11, F12, F13, F14, F15, None> Tail;
+
+	static const uint8_t GroupBit = F1::GroupBit;
+	static const uint16_t Mask = F1::Flag | Tail::Mask;
+	static const uint32_t FirstFlag = F1::Flag;
+	static const size_t Size = F1::Size + Tail::Size;
+
+	typedef char FieldsMustBeInPacketOrder[F1::Flag < Tail::FirstFlag ? 1 : -1];
+	typedef char FieldsMustBeFromTheSameGroup[Tail::GroupBit == 0 || Tail::GroupBit == F1::GroupBit ? 1 : -1];
+
+	struct Values : FieldValue<F1>, Tail::Values { };
+
+	template<size_t Offset>
+	static void read(const char* data, Values& values)
+	{
+		static_cast<FieldValue<F1>&>(values).value = F1::read(data + Offset);
+
+		Tail::template read<Offset + F1::Size>(data, values);
+	}
+
+	static bool fromComposite(CompositeData& cd, Values& values)
+	{
+		return F1::fromComposite(cd, static_cast<FieldValue<F1>&>(values).value)
+			&& Tail::fromComposite(cd, values);
+	}
+};
+
+template<>
+struct FieldGroup<None, None, None, None, None, None, None, None, None, None, None, None, None, None, None>
+{
+	static const uint8_t GroupBit = 0;
+	static const uint16_t Mask = 0;
+	static const uint32_t FirstFlag = 0x10000;
+	static const size_t Size = 0;
+
+	struct Values { };
+
+	template<size_t Offset>
+	static void read(const char*, Values&) { }
+
+	static bool fromComposite(CompositeData&, Values&)
+	{
+		return true;
+	}
+};
+
+/// \brief Fields of binary group 1 'Common'.
+template<
+	typename F1 = None, typename F2 = None, typename F3 = None, typename F4 = None, typename F5 = None,
+	typename F6 = None, typename F7 = None, typename F8 = None, typename F9 = None, typename F10 = None,
+	typename F11 = None, typename F12 = None, typename F13 = None, typename F14 = None, typename F15 = None>
+struct Common : FieldGroup<F1, F2, F3, F4, F5, F6, F7, F8, F9, F10, F11, F12, F13, F14, F15>
+{
+	typedef char FieldsMustBeFromTheCommonGroup[F1::GroupBit == protocol::uart::BINARYGROUP_COMMON ? 1 : -1];
+};
+
+/// \brief Fields of binary group 5 'Attitude'.
+template<
+	typename F1 = None, typename F2 = None, typename F3 = None, typename F4 = None, typename F5 = None,
+	typename F6 = None, typename F7 = None, typename F8 = None, typename F9 = None>
+struct Attitude : FieldGroup<F1, F2, F3, F4, F5, F6, F7, F8, F9>
+{
+	typedef char FieldsMustBeFromTheAttitudeGroup[F1::GroupBit == protocol::uart::BINARYGROUP_ATTITUDE ? 1 : -1];
+};
+
+/// \brief Fields of binary group 6 'INS'.
+template<
+	typename F1 = None, typename F2 = None, typename F3 = None, typename F4 = None, typename F5 = None,
+	typename F6 = None, typename F7 = None, typename F8 = None, typename F9 = None, typename F10 = None,
+	typename F11 = None>
+struct Ins : FieldGroup<F1, F2, F3, F4, F5, F6, F7, F8, F9, F10, F11>
+{
+	typedef char FieldsMustBeFromTheInsGroup[F1::GroupBit == protocol::uart::BINARYGROUP_INS ? 1 : -1];
+};
+
+/// \brief A list of groups, given in the order of their group bits.
+template<typename G1 = None, typename G2 = None, typename G3 = None, typename G4 = None, typename G5 = None, typename G6 = None, typename G7 = None>
+struct GroupList
+{
+	typedef GroupList<G2, G3, G4, G5, G6, G7, None> Tail;
+
+	static const uint8_t Groups = G1::GroupBit | Tail::Groups;
+	static const uint32_t FirstGroupBit = G1::GroupBit;
+	static const size_t NumOfGroups = 1 + Tail::NumOfGroups;
+	static const size_t Size = G1::Size + Tail::Size;
+
+	typedef char GroupsMustBeInPacketOrder[G1::GroupBit < Tail::FirstGroupBit ? 1 : -1];
+
+	struct Values : G1::Values, Tail::Values { };
+
+	static uint16_t groupField(protocol::uart::BinaryGroup group)
+	{
+		return G1::GroupBit == group ? G1::Mask : Tail::groupField(group);
+	}
+
+	static bool matches(const char* groupFields)
+	{
+		uint16_t field;
+		std::memcpy(&field, groupFields, sizeof(field));
+
+		return stoh(field) == G1::Mask && Tail::matches(groupFields + sizeof(field));
+	}
+
+	template<size_t Offset>
+	static void read(const char* data, Values& values)
+	{
+		G1::template read<Offset>(data, values);
+
+		Tail::template read<Offset + G1::Size>(data, values);
+	}
+
+	static bool fromComposite(CompositeData& cd, Values& values)
+	{
+		return G1::fromComposite(cd, values) && Tail::fromComposite(cd, values);
+	}
+};
+
+template<>
+struct GroupList<None, None, None, None, None, None, None>
+{
+	static const uint8_t Groups = 0;
+	static const uint32_t FirstGroupBit = 0x100;
+	static const size_t NumOfGroups = 0;
+	static const size_t Size = 0;
+
+	struct Values { };
+
+	static uint16_t groupField(protocol::uart::BinaryGroup)
+	{
+		return 0;
+	}
+
+	static bool matches(const char*)
+	{
+		return true;
+	}
+
+	template<size_t Offset>
+	static void read(const char*, Values&) { }
+
+	static bool fromComposite(CompositeData&, Values&)
+	{
+		return true;
+	}
+};
+
+}
+
+/// \brief Describes the contents of a binary output message at compile time.
+///
+/// From the description the matching \ref BinaryOutputRegister can be
+/// generated and received packets can be decoded. Since the position of
+/// every field is known at compile time, a packet whose header matches the
+/// layout is decoded with a single length check and direct reads at fixed
+/// offsets instead of walking the group fields as \ref CompositeData does.
+///
+/// Groups and the fields within them must be listed in the order they
+/// appear in a packet, which is the order of their bits.
+///
+/// \code
+/// using namespace vn::sensors::layout;
+///
+/// typedef BinaryLayout<
+///     Common<common::Quaternion, common::AngularRate>,
+///     Ins<ins::PosLla, ins::PosEcef> > MyLayout;
+///
+/// vs.writeBinaryOutput1(MyLayout::binaryOutputRegister(ASYNCMODE_PORT1, 4));
+///
+/// // In the async packet handler.
+/// MyLayout::Data d;
+/// if (MyLayout::parse(p, d))
+///     vec4f q = d.get<common::Quaternion>();
+/// \endcode
+template<typename G1, typename G2 = layout::None, typename G3 = layout::None, typename G4 = layout::None, typename G5 = layout::None, typename G6 = layout::None, typename G7 = layout::None>
+class BinaryLayout
+{
+	typedef layout::GroupList<G1, G2, G3, G4, G5, G6, G7> List;
+
+public:
+
+	/// \brief The groups byte of a matching packet.
+	static const uint8_t Groups = List::Groups;
+
+	/// \brief The number of bytes before the payload of a matching packet,
+	///     i.e. the sync byte, groups byte and group fields.
+	static const size_t HeaderSize = 2 + 2 * List::NumOfGroups;
+
+	/// \brief The number of payload bytes in a matching packet.
+	static const size_t PayloadSize = List::Size;
+
+	/// \brief The total number of bytes in a matching packet, including the
+	///     CRC.
+	static const size_t PacketSize = HeaderSize + PayloadSize + 2;
+
+	/// \brief Holds the values of all the fields in the layout.
+	struct Data : List::Values
+	{
+		/// \brief Returns the value of field <c>F</c>.
+		///
+		/// \return The field's value.
+		template<typename F>
+		typename F::Type& get()
+		{
+			return static_cast<layout::FieldValue<F>&>(*this).value;
+		}
+
+		/// \brief Returns the value of field <c>F</c>.
+		///
+		/// \return The field's value.
+		template<typename F>
+		const typename F::Type& get() const
+		{
+			return static_cast<const layout::FieldValue<F>&>(*this).value;
+		}
+	};
+
+	/// \brief Generates the binary output register configuration which has
+	///     the sensor output packets matching this layout.
+	///
+	/// \param[in] asyncMode Selects the ports to output the message on.
+	/// \param[in] rateDivisor The rate divisor.
+	/// \return The register configuration.
+	static BinaryOutputRegister binaryOutputRegister(protocol::uart::AsyncMode asyncMode, uint16_t rateDivisor)
+	{
+		return BinaryOutputRegister(
+			asyncMode,
+			rateDivisor,
+			static_cast<protocol::uart::CommonGroup>(List::groupField(protocol::uart::BINARYGROUP_COMMON)),
+			static_cast<protocol::uart::TimeGroup>(List::groupField(protocol::uart::BINARYGROUP_TIME)),
+			static_cast<protocol::uart::ImuGroup>(List::groupField(protocol::uart::BINARYGROUP_IMU)),
+			static_cast<protocol::uart::GpsGroup>(List::groupField(protocol::uart::BINARYGROUP_GPS)),
+			static_cast<protocol::uart::AttitudeGroup>(List::groupField(protocol::uart::BINARYGROUP_ATTITUDE)),
+			static_cast<protocol::uart::InsGroup>(List::groupField(protocol::uart::BINARYGROUP_INS)),
+			static_cast<protocol::uart::GpsGroup>(List::groupField(protocol::uart::BINARYGROUP_GPS2)));
+	}
+
+	/// \brief Decodes a packet which exactly matches the layout.
+	///
+	/// The packet's data integrity is not checked.
+	///
+	/// \param[in] p The packet to decode.
+	/// \param[out] data The decoded values. Left untouched if the packet
+	///     does not match.
+	/// \return <c>true</c> if the packet matched the layout and was decoded;
+	///     otherwise <c>false</c>.
+	static bool decode(protocol::uart::Packet& p, Data& data)
+	{
+		if (p.length() != PacketSize)
+			return false;
+
+		const char* raw = p.data();
+
+		if (static_cast<uint8_t>(raw[0]) != 0xFA || static_cast<uint8_t>(raw[1]) != Groups || !List::matches(raw + 2))
+			return false;
+
+		List::template read<HeaderSize>(raw, data);
+
+		return true;
+	}
+
+	/// \brief Decodes a packet, falling back to \ref CompositeData::parse if
+	///     the packet does not exactly match the layout.
+	///
+	/// This allows packets which contain extra data, or ASCII asynchronous
+	/// messages, to still be used.
+	///
+	/// \param[in] p The packet to parse.
+	/// \param[out] data The decoded values.
+	/// \return <c>true</c> if every field of the layout was found in the
+	///     packet; otherwise <c>false</c>.
+	static bool parse(protocol::uart::Packet& p, Data& data)
+	{
+		if (decode(p, data))
+			return true;
+
+		CompositeData cd;
+		CompositeData::parse(p, cd);
+
+		return List::fromComposite(cd, data);
+	}
+};
+
+// Definitions of the constants so they can be bound to references.
+template<typename G1, typename G2, typename G3, typename G4, typename G5, typename G6, typename G7>
+const uint8_t BinaryLayout<G1, G2, G3, G4, G5, G6, G7>::Groups;
+
+template<typename G1, typename G2, typename G3, typename G4, typename G5, typename G6, typename G7>
+const size_t BinaryLayout<G1, G2, G3, G4, G5, G6, G7>::HeaderSize;
+
+template<typename G1, typename G2, typename G3, typename G4, typename G5, typename G6, typename G7>
+const size_t BinaryLayout<G1, G2, G3, G4, G5, G6, G7>::PayloadSize;
+
+template<typename G1, typename G2, typename G3, typename G4, typename G5, typename G6, typename G7>
+const size_t BinaryLayout<G1, G2, G3, G4, G5, G6, G7>::PacketSize;
+
+}
+}
+
+#endif
@@ -0,0 +1,125 @@
+/// \file
+/// {COMMON_HEADER}
+///
+/// \section DESCRIPTION
+/// This header file provides the structure BinaryPlan.
+#ifndef _VNPROTOCOL_UART_BINARYPLAN_H_
+#define _VNPROTOCOL_UART_BINARYPLAN_H_
+
+#include <cstddef>
+
+#include "int.h"
+#include "export.h"
+
+namespace vn {
+namespace protocol {
+namespace uart {
+
+/// \brief Precomputed layout of binary packets with a particular header.
+///
+/// The header of a binary packet (the sync byte, groups byte and group
+/// fields) completely determines its length and where each field is
+/// located. A sensor only outputs a handful of different headers, so the
+/// plans are cached the first time a header is seen and finding the length
+/// of, or decoding, later packets with the same header does not require
+/// walking the group fields again.
+///
+/// Cached plans are never modified or freed, so a plan returned from the
+/// cache can be used from any thread for the lifetime of the process.
+struct vn_proglib_DLLEXPORT BinaryPlan
+{
+	/// \brief The maximum number of bytes in the header of a binary packet.
+	static const size_t MaximumHeaderLength = 2 + 8 * sizeof(uint16_t);
+
+	/// \brief The maximum number of fields a binary packet can contain.
+	static const size_t MaximumNumOfFields = 7 * 15;
+
+	/// \brief The maximum number of plans that are cached.
+	static const size_t MaximumNumOfCachedPlans = 16;
+
+	/// \brief The number of entries in <c>fieldOffsets</c>, one for each
+	///     possible field code.
+	static const size_t NumOfFieldCodes = 7 << 4;
+
+	/// \brief A field present in the packet.
+	struct Field
+	{
+		/// \brief Identifies the field. The upper four bits are the index of
+		///     the group (0 for Common) and the lower four bits are the bit
+		///     of the field within its group field.
+		uint8_t code;
+
+		/// \brief Offset of the field from the start of the packet.
+		uint16_t offset;
+	};
+
+	/// \brief The header the plan describes.
+	char header[MaximumHeaderLength];
+
+	/// \brief The number of bytes in the header.
+	size_t headerLength;
+
+	/// \brief The total number of bytes in a packet with this header,
+	///     including the CRC.
+	size_t length;
+
+	/// \brief The number of entries in <c>fields</c>.
+	size_t numOfFields;
+
+	/// \brief The fields present, in the order they appear in the packet.
+	Field fields[MaximumNumOfFields];
+
+	/// \brief Offset of each field from the start of the packet, indexed by
+	///     field code. Fields which are not present have an offset of 0.
+	uint16_t fieldOffsets[NumOfFieldCodes];
+
+	/// \brief Makes a field code.
+	///
+	/// \param[in] groupIndex The index of the group (0 for Common).
+	/// \param[in] fieldIndex The bit of the field in its group field.
+	/// \return The field code.
+	static uint8_t code(size_t groupIndex, size_t fieldIndex)
+	{
+		return static_cast<uint8_t>((groupIndex << 4) | fieldIndex);
+	}
+
+	/// \brief Computes the plan for a packet header.
+	///
+	/// \param[in] startOfPacket The start of the binary packet (i.e. the 0xFA
+	///     character). The complete header must be available.
+	void build(char const* startOfPacket);
+
+	/// \brief Indicates if this plan describes packets with the provided
+	///     header.
+	///
+	/// \param[in] startOfPacket The start of the binary packet. The complete
+	///     header must be available.
+	/// \return <c>true</c> if the headers match; otherwise <c>false</c>.
+	bool matches(char const* startOfPacket) const;
+
+	/// \brief Looks up the cached plan for a packet header.
+	///
+	/// \param[in] startOfPacket The start of the binary packet. The complete
+	///     header must be available.
+	/// \return The cached plan or <c>NULL</c> if the header has not been
+	///     cached.
+	static const BinaryPlan* find(char const* startOfPacket);
+
+	/// \brief Returns the plan for a packet header, adding it to the cache if
+	///     it has not been seen before.
+	///
+	/// Only headers from packets known to be valid should be provided so the
+	/// cache is not filled up with garbage.
+	///
+	/// \param[in] startOfPacket The start of the binary packet. The complete
+	///     header must be available.
+	/// \param[in] scratch Used to hold the plan if the cache is full.
+	/// \return The plan.
+	static const BinaryPlan& get(char const* startOfPacket, BinaryPlan& scratch);
+};
+
+}
+}
+}
+
+#endif
@@ -0,0 +1,153 @@
+/// \file
+/// {COMMON_HEADER}
+///
+/// \section DESCRIPTION
+/// This header file provides the ColumnarBatch structure which holds decoded
+/// sensor data as columns.
+#ifndef _VNSENSORS_COLUMNARBATCH_H_
+#define _VNSENSORS_COLUMNARBATCH_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "int.h"
+#include "export.h"
+#include "types.h"
+#include "vector.h"
+
+namespace vn {
+namespace sensors {
+
+class CompositeData;
+
+/// \brief The values of one field across all of the rows of a
+///     \ref ColumnarBatch.
+///
+/// Each component of the field is stored in its own contiguous array, so
+/// for example the yaw of every row is in <c>values[0]</c>. Every array has
+/// one entry per row; rows where the field was not present hold zero.
+template<typename T, size_t Components>
+struct Column
+{
+	/// \brief The number of components in each value.
+	static const size_t NumOfComponents = Components;
+
+	/// \brief The values of each component, indexed by row.
+	std::vector<T> values[Components];
+
+	/// \brief Indicates which rows hold a value. Bit <c>row % 64</c> of
+	///     <c>validity[row / 64]</c> is set if the field was present in
+	///     that row.
+	std::vector<uint64_t> validity;
+
+	/// \brief Indicates if the field was present in a row.
+	///
+	/// \param[in] row The index of the row.
+	/// \return <c>true</c> if the row holds a value; otherwise <c>false</c>.
+	bool isValid(size_t row) const
+	{
+		return ((validity[row / 64] >> (row % 64)) & 0x01) != 0;
+	}
+
+	/// \brief Returns the values of one component.
+	///
+	/// \param[in] component The index of the component.
+	/// \return Pointer to the value of the component for the first row, or
+	///     <c>NULL</c> if the batch is empty.
+	T const* component(size_t component) const
+	{
+		return values[component].empty() ? NULL : &values[component][0];
+	}
+};
+
+/// \brief Decoded sensor data stored as columns rather than as one
+///     \ref CompositeData per packet.
+///
+/// Each packet added to the batch becomes one row, in the order the packets
+/// were added, whether or not it contained any of the fields below. This
+/// makes the batch suitable for post-processing captured data with loops
+/// that run over contiguous arrays.
+///
+/// The columns are named after the corresponding \ref CompositeData
+/// accessors.
+struct vn_proglib_DLLEXPORT ColumnarBatch
+{
+	/// \name Time
+	/// \{
+
+	Column<uint64_t, 1> timeStartup;	///< Time since startup, in nanoseconds.
+	Column<uint64_t, 1> timeGps;		///< Absolute GPS time, in nanoseconds.
+	Column<uint64_t, 1> gpsTow;			///< GPS time of week, in nanoseconds.
+	Column<double, 1> tow;				///< GPS time of week, in seconds.
+	Column<uint16_t, 1> week;			///< GPS week.
+
+	/// \}
+
+	/// \name Attitude and IMU
+	/// \{
+
+	Column<float, 3> yawPitchRoll;		///< Yaw, pitch, roll.
+	Column<float, 4> quaternion;		///< Quaternion.
+	Column<float, 3> angularRate;		///< Compensated angular rate.
+	Column<float, 3> acceleration;		///< Compensated acceleration.
+	Column<float, 3> magnetic;			///< Compensated magnetic.
+	Column<float, 1> temperature;		///< Temperature.
+	Column<float, 1> pressure;			///< Pressure.
+	Column<float, 1> deltaTime;			///< Delta time.
+	Column<float, 3> deltaTheta;		///< Delta theta.
+	Column<float, 3> deltaVelocity;		///< Delta velocity.
+
+	/// \}
+
+	/// \name INS
+	/// \{
+
+	Column<uint16_t, 1> insStatus;						///< INS status.
+	Column<double, 3> positionEstimatedLla;				///< Estimated latitude, longitude, altitude.
+	Column<float, 3> velocityEstimatedNed;				///< Estimated NED velocity.
+	Column<float, 3> attitudeUncertainty;				///< Attitude uncertainty.
+	Column<float, 1> positionUncertaintyEstimated;		///< Estimated position uncertainty.
+	Column<float, 1> velocityUncertaintyEstimated;		///< Estimated velocity uncertainty.
+
+	/// \}
+
+	/// \name GPS
+	/// \{
+
+	Column<uint8_t, 1> fix;					///< GPS fix.
+	Column<uint8_t, 1> numSats;				///< Number of satellites.
+	Column<double, 3> positionGpsLla;		///< GPS latitude, longitude, altitude.
+	Column<float, 3> velocityGpsNed;		///< GPS NED velocity.
+
+	/// \}
+
+	ColumnarBatch();
+
+	/// \brief Returns the number of rows in the batch.
+	///
+	/// \return The number of rows.
+	size_t size() const;
+
+	/// \brief Removes all rows. The memory already allocated for the columns
+	///     is kept so the batch can be refilled without allocating.
+	void clear();
+
+	/// \brief Allocates room for a number of rows.
+	///
+	/// \param[in] numOfRows The total number of rows to make room for.
+	void reserve(size_t numOfRows);
+
+	/// \brief Adds a row holding the data in a CompositeData object.
+	///
+	/// \param[in] data The data to add.
+	void append(CompositeData& data);
+
+private:
+
+	size_t _numOfRows;
+};
+
+}
+}
+
+#endif
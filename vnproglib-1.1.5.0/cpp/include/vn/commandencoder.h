@@ -0,0 +1,129 @@
+/// \file
+/// {COMMON_HEADER}
+///
+/// \section DESCRIPTION
+/// This header file provides the class CommandEncoder.
+#ifndef _VNPROTOCOL_UART_COMMANDENCODER_H_
+#define _VNPROTOCOL_UART_COMMANDENCODER_H_
+
+#include <cstddef>
+#include <cstring>
+
+#include "int.h"
+#include "export.h"
+#include "types.h"
+
+namespace vn {
+namespace protocol {
+namespace uart {
+
+/// \brief Writes an ASCII command straight into a caller-provided buffer.
+///
+/// A command is started with its prefix, such as <c>"$VNWRG,35"</c>, whose
+/// length is known at compile time. Each field is then appended preceded by
+/// a comma, and \ref finalize appends the error detection code and line
+/// ending. Nothing is allocated and numbers are formatted without going
+/// through printf, while producing the same text as the <c>%u</c>,
+/// <c>%d</c>, <c>%X</c>, <c>%f</c> and <c>%E</c> conversions.
+///
+/// \exception invalid_operation Thrown by the appending methods if the
+///     command does not fit in the buffer.
+class vn_proglib_DLLEXPORT CommandEncoder
+{
+public:
+
+	/// \brief The maximum number of characters \ref writeErrorDetectionCode
+	///     writes.
+	static const size_t MaximumErrorDetectionCodeLength = 6;
+
+	/// \brief Starts a command with the provided prefix.
+	///
+	/// \param[in] buffer The buffer to write the command into.
+	/// \param[in] size The size of the buffer.
+	/// \param[in] prefix The start of the command, including the '$'.
+	template<size_t N>
+	CommandEncoder(char* buffer, size_t size, const char (&prefix)[N]) :
+		_buffer(buffer),
+		_size(size),
+		_length(0)
+	{
+		append(prefix, N - 1);
+	}
+
+	/// \brief Appends an unsigned integer field, as by <c>%u</c>.
+	///
+	/// \param[in] value The value of the field.
+	/// \param[in] minNumOfDigits The field is padded with leading zeros to at
+	///     least this many digits.
+	void unsignedField(uint32_t value, size_t minNumOfDigits = 1);
+
+	/// \brief Appends a signed integer field, as by <c>%d</c>.
+	///
+	/// \param[in] value The value of the field.
+	void signedField(int32_t value);
+
+	/// \brief Appends an unsigned integer field in upper case hexadecimal, as
+	///     by <c>%X</c>.
+	///
+	/// \param[in] value The value of the field.
+	void hexField(uint32_t value);
+
+	/// \brief Appends a floating point field with six decimal places, as by
+	///     <c>%f</c>.
+	///
+	/// \param[in] value The value of the field.
+	void floatField(double value);
+
+	/// \brief Appends a floating point field in scientific notation with six
+	///     decimal places, as by <c>%E</c>.
+	///
+	/// \param[in] value The value of the field.
+	void scientificField(double value);
+
+	/// \brief Appends a text field, as by <c>%s</c>.
+	///
+	/// \param[in] value The value of the field.
+	void textField(const char* value);
+
+	/// \brief Completes the command with the error detection code and line
+	///     ending. A null terminator is also written if there is room.
+	///
+	/// \param[in] errorDetectionMode The error detection mode to use.
+	/// \return The length of the command.
+	size_t finalize(ErrorDetectionMode errorDetectionMode);
+
+	/// \brief Writes the error detection code of a command followed by the
+	///     line ending.
+	///
+	/// \param[in] errorDetectionMode The error detection mode to use.
+	/// \param[in] body The command between its '$' and '*'.
+	/// \param[in] length The length of the body.
+	/// \param[out] code Receives at most \ref MaximumErrorDetectionCodeLength
+	///     characters.
+	/// \return The number of characters written.
+	static size_t writeErrorDetectionCode(ErrorDetectionMode errorDetectionMode, const char* body, size_t length, char* code);
+
+private:
+
+	void append(const char* text, size_t length)
+	{
+		ensureFits(length);
+
+		memcpy(_buffer + _length, text, length);
+		_length += length;
+	}
+
+	void ensureFits(size_t length);
+
+	void appendFormatted(const char* format, double value);
+
+	char* _buffer;
+	size_t _size;
+	size_t _length;
+};
+
+}
+}
+}
+
+#endif
@@ -67,6 +67,53 @@
 	#define VN_SUPPORTS_CSTR_STRING_CONCATENATE	1
 #endif
 
+// The VN_SUPPORTS_ATOMIC define indicates if the compiler provides the STL
+// <atomic> header. When it is not available, vn::xplat::Atomic falls back to
+// the compiler's atomic builtins.
+//
+// [Example]
+//
+// #if VN_SUPPORTS_ATOMIC
+//     std::atomic<size_t> _head;
+// #else
+//     size_t _head;
+// #endif
+//
+#if (defined(_MSC_VER) && _MSC_VER >= 1700) || (__cplusplus >= 201103L)
+	#define VN_SUPPORTS_ATOMIC 1
+#else
+	#define VN_SUPPORTS_ATOMIC 0
+#endif
+
+// The VN_HAVE_X86_DISPATCH define indicates if the compiler is targeting an
+// x86 processor and can build functions using instruction set extensions
+// (SSE2, AVX2, etc.) that are not enabled for the whole build. These
+// functions must only be called after checking the processor supports the
+// extension with vn::xplat::Cpu. Such functions are marked with VN_TARGET.
+//
+// [Example]
+//
+// #if VN_HAVE_X86_DISPATCH
+// VN_TARGET("avx2")
+// static const uint8_t* findCandidateAvx2(const uint8_t* begin, const uint8_t* end);
+// #endif
+//
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+	#if defined(__clang__) || (defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9)))
+		#define VN_HAVE_X86_DISPATCH 1
+		#define VN_TARGET(isa) __attribute__((target(isa)))
+	#elif defined(_MSC_VER) && _MSC_VER >= 1800
+		#define VN_HAVE_X86_DISPATCH 1
+		#define VN_TARGET(isa)
+	#else
+		#define VN_HAVE_X86_DISPATCH 0
+		#define VN_TARGET(isa)
+	#endif
+#else
+	#define VN_HAVE_X86_DISPATCH 0
+	#define VN_TARGET(isa)
+#endif
+
 // Determine if the secure CRT and SCL are available.
 #if defined(_MSC_VER)
 	#define VN_HAVE_SECURE_CRT 1
@@ -4,6 +4,8 @@
 #include <vector>
 
 #include "vn/export.h"
+#include "vn/compiler.h"
+#include "vn/exceptions.h"
 #include "vn/packet.h"
 #include "vn/attitude.h"
 #include "vn/position.h"
@@ -11,17 +13,14 @@
 namespace vn {
 namespace sensors {
 
+struct ColumnarBatch;
+
 /// \brief Composite structure of all data types available from VectorNav sensors.
 class vn_proglib_DLLEXPORT CompositeData
 {
 public:
 
 	CompositeData();
-	CompositeData(const CompositeData& cd);
-
-	~CompositeData();
-
-	CompositeData& operator=(const CompositeData& RHS);
 
 	/// \brief Parses a packet.
 	///
@@ -41,6 +40,40 @@ public:
 	/// \param[in] o The collection of CompositeData objects to update.
 	static void parse(protocol::uart::Packet& p, std::vector<CompositeData*>& o);
 
+	/// \brief Parses a packet and updates multiple CompositeData objects
+	///     without allocating any memory.
+	///
+	/// \param[in] p The packet to parse.
+	/// \param[in] o The CompositeData objects to update.
+	/// \param[in] count The number of objects in <c>o</c>.
+	static void parse(protocol::uart::Packet& p, CompositeData* const o[], size_t count);
+
+	/// \brief Replaces the data in a CompositeData object with the data in a
+	///     packet. This has the same result as assigning the return value of
+	///     <c>parse(p)</c> but reuses the storage of <c>o</c>, so decoding a
+	///     stream of packets into the same object does not allocate memory.
+	///
+	/// \param[in] p The packet to parse. This is typically the
+	///     \ref protocol::uart::PacketView passed to an async packet handler.
+	/// \param[out] o The CompositeData structure to write the data to.
+	static void parseInto(protocol::uart::Packet& p, CompositeData& o);
+
+	/// \brief Parses a sequence of packets into columns, adding one row to
+	///     the batch for each packet.
+	///
+	/// \param[in] packets The packets to parse.
+	/// \param[in] count The number of packets.
+	/// \param[in/out] batch The batch to add the rows to.
+	static void parseBatch(protocol::uart::Packet* packets, size_t count, ColumnarBatch& batch);
+
+	/// \brief Parses a sequence of packet views into columns, adding one row
+	///     to the batch for each packet.
+	///
+	/// \param[in] packets The packets to parse.
+	/// \param[in] count The number of packets.
+	/// \param[in/out] batch The batch to add the rows to.
+	static void parseBatch(protocol::uart::PacketView* packets, size_t count, ColumnarBatch& batch);
+
 	/// \brief Resets the data contained in the CompositeData object.
 	void reset();
 
@@ -66,6 +99,11 @@ public:
 	/// \exception invalid_operation Thrown if there is not any valid data.
 	math::vec3f yawPitchRoll();
 
+	/// \brief Gets <c>yawPitchRoll</c> without throwing an exception when it has no valid data.
+	/// \param[out] value Receives the data if it is valid.
+	/// \return <c>true</c> if <c>yawPitchRoll</c> has valid data; otherwise <c>false</c>.
+	bool tryGetYawPitchRoll(math::vec3f& value);
+
 	/// \brief Indicates if <c>quaternion</c> has valid data.
 	/// \return <c>true</c> if <c>quaternion</c> has valid data; otherwise <c>false</c>.
 	bool hasQuaternion();
@@ -75,6 +113,11 @@ public:
 	/// \exception invalid_operation Thrown if there is not any valid data.
 	math::vec4f quaternion();
 
+	/// \brief Gets <c>quaternion</c> without throwing an exception when it has no valid data.
+	/// \param[out] value Receives the data if it is valid.
+	/// \return <c>true</c> if <c>quaternion</c> has valid data; otherwise <c>false</c>.
+	bool tryGetQuaternion(math::vec4f& value);
+
 	/// \brief Indicates if <c>directionCosineMatrix</c> has valid data.
 	/// \return <c>true</c> if <c>directionCosineMatrix</c> has valid data; otherwise <c>false</c>.
 	bool hasDirectionCosineMatrix();
@@ -84,6 +127,11 @@ public:
 	/// \exception invalid_operation Thrown if there is not any valid data.
 	math::mat3f directionCosineMatrix();
 
+	/// \brief Gets <c>directionCosineMatrix</c> without throwing an exception when it has no valid data.
+	/// \param[out] value Receives the data if it is valid.
+	/// \return <c>true</c> if <c>directionCosineMatrix</c> has valid data; otherwise <c>false</c>.
+	bool tryGetDirectionCosineMatrix(math::mat3f& value);
+
 	/// \brief Indicates if <c>anyMagnetic</c> has valid data.
 	/// \return <c>true</c> if <c>anyMagnetic</c> has valid data; otherwise <c>false</c>.
 	bool hasAnyMagnetic();
@@ -106,6 +154,11 @@ public:
 	/// \exception invalid_operation Thrown if there is not any valid data.
 	math::vec3f magnetic();
 
+	/// \brief Gets <c>magnetic</c> without throwing an exception when it has no valid data.
+	/// \param[out] value Receives the data if it is valid.
+	/// \return <c>true</c> if <c>magnetic</c> has valid data; otherwise <c>false</c>.
+	bool tryGetMagnetic(math::vec3f& value);
+
 	/// \brief Indicates if <c>magneticUncompensated</c> has valid data.
 	/// \return <c>true</c> if <c>magneticUncompensated</c> has valid data; otherwise <c>false</c>.
 	bool hasMagneticUncompensated();
@@ -115,6 +168,11 @@ public:
 	/// \exception invalid_operation Thrown if there is not any valid data.
 	math::vec3f magneticUncompensated();
 
+	/// \brief Gets <c>magneticUncompensated</c> without throwing an exception when it has no valid data.
+	/// \param[out] value Receives the data if it is valid.
+	/// \return <c>true</c> if <c>magneticUncompensated</c> has valid data; otherwise <c>false</c>.
+	bool tryGetMagneticUncompensated(math::vec3f& value);
+
 	/// \brief Indicates if <c>magneticNed</c> has valid data.
 	/// \return <c>true</c> if <c>magneticNed</c> has valid data; otherwise <c>false</c>.
 	bool hasMagneticNed();
@@ -124,6 +182,11 @@ public:
 	/// \exception invalid_operation Thrown if there is not any valid data.
 	math::vec3f magneticNed();
 
+	/// \brief Gets <c>magneticNed</c> without throwing an exception when it has no valid data.
+	/// \param[out] value Receives the data if it is valid.
+	/// \return <c>true</c> if <c>magneticNed</c> has valid data; otherwise <c>false</c>.
+	bool tryGetMagneticNed(math::vec3f& value);
+
 	/// \brief Indicates if <c>magneticEcef</c> has valid data.
 	/// \return <c>true</c> if <c>magneticEcef</c> has valid data; otherwise <c>false</c>.
 	bool hasMagneticEcef();
@@ -133,6 +196,11 @@ public:
 	/// \exception invalid_operation Thrown if there is not any valid data.
 	math::vec3f magneticEcef();
 
+	/// \brief Gets <c>magneticEcef</c> without throwing an exception when it has no valid data.
+	/// \param[out] value Receives the data if it is valid.
+	/// \return <c>true</c> if <c>magneticEcef</c> has valid data; otherwise <c>false</c>.
+	bool tryGetMagneticEcef(math::vec3f& value);
+
 
 	/// \brief Indicates if <c>anyAcceleration</c> has valid data.
 	/// \return <c>true</c> if <c>anyAcceleration</c> has valid data; otherwise <c>false</c>.
@@ -154,6 +222,11 @@ public:
 	/// \exception invalid_operation Thrown if there is not any valid data.
 	math::vec3f acceleration();
 
+	/// \brief Gets <c>acceleration</c> without throwing an exception when it has no valid data.
+	/// \param[out] value Receives the data if it is valid.
+	/// \return <c>true</c> if <c>acceleration</c> has valid data; otherwise <c>false</c>.
+	bool tryGetAcceleration(math::vec3f& value);
+
 	/// \brief Indicates if <c>accelerationLinearBody</c> has valid data.
 	/// \return <c>true</c> if <c>accelerationLinearBody</c> has valid data; otherwise <c>false</c>.
 	bool hasAccelerationLinearBody();
@@ -162,6 +235,11 @@ public:
 	/// \return The acceleration linear body data.
 	/// \exception invalid_operation Thrown if there is not any valid data.
 	math::vec3f accelerationLinearBody();
+
+	/// \brief Gets <c>accelerationLinearBody</c> without throwing an exception when it has no valid data.
+	/// \param[out] value Receives the data if it is valid.
+	/// \return <c>true</c> if <c>accelerationLinearBody</c> has valid data; otherwise <c>false</c>.
+	bool tryGetAccelerationLinearBody(math::vec3f& value);
 	
 	/// \brief Indicates if <c>accelerationUncompensated</c> has valid data.
 	/// \return <c>true</c> if <c>accelerationUncompensated</c> has valid data; otherwise <c>false</c>.
@@ -172,6 +250,11 @@ public:
 	/// \exception invalid_operation Thrown if there is not any valid data.
 	math::vec3f accelerationUncompensated();
 
+	/// \brief Gets <c>accelerationUncompensated</c> without throwing an exception when it has no valid data.
+	/// \param[out] value Receives the data if it is valid.
+	/// \return <c>true</c> if <c>accelerationUncompensated</c> has valid data; otherwise <c>false</c>.
+	bool tryGetAccelerationUncompensated(math::vec3f& value);
+
 	/// \brief Indicates if <c>accelerationLinearNed</c> has valid data.
 	/// \return <c>true</c> if <c>accelerationLinearNed</c> has valid data; otherwise <c>false</c>.
 	bool hasAccelerationLinearNed();
@@ -181,6 +264,11 @@ public:
 	/// \exception invalid_operation Thrown if there is not any valid data.
 	math::vec3f accelerationLinearNed();
 
+	/// \brief Gets <c>accelerationLinearNed</c> without throwing an exception when it has no valid data.
+	/// \param[out] value Receives the data if it is valid.
+	/// \return <c>true</c> if <c>accelerationLinearNed</c> has valid data; otherwise <c>false</c>.
+	bool tryGetAccelerationLinearNed(math::vec3f& value);
+
 	/// \brief Indicates if <c>accelerationLinearEcef</c> has valid data.
 	/// \return <c>true</c> if <c>accelerationLinearEcef</c> has valid data; otherwise <c>false</c>.
 	bool hasAccelerationLinearEcef();
@@ -190,6 +278,11 @@ public:
 	/// \exception invalid_operation Thrown if there is not any valid data.
 	math::vec3f accelerationLinearEcef();
 
+	/// \brief Gets <c>accelerationLinearEcef</c> without throwing an exception when it has no valid data.
+	/// \param[out] value Receives the data if it is valid.
+	/// \return <c>true</c> if <c>accelerationLinearEcef</c> has valid data; otherwise <c>false</c>.
+	bool tryGetAccelerationLinearEcef(math::vec3f& value);
+
 	/// \brief Indicates if <c>accelerationNed</c> has valid data.
 	/// \return <c>true</c> if <c>accelerationNed</c> has valid data; otherwise <c>false</c>.
 	bool hasAccelerationNed();
@@ -199,6 +292,11 @@ public:
 	/// \exception invalid_operation Thrown if there is not any valid data.
 	math::vec3f accelerationNed();
 
+	/// \brief Gets <c>accelerationNed</c> without throwing an exception when it has no valid data.
+	/// \param[out] value Receives the data if it is valid.
+	/// \return <c>true</c> if <c>accelerationNed</c> has valid data; otherwise <c>false</c>.
+	bool tryGetAccelerationNed(math::vec3f& value);
+
 	/// \brief Indicates if <c>accelerationEcef</c> has valid data.
 	/// \return <c>true</c> if <c>accelerationEcef</c> has valid data; otherwise <c>false</c>.
 	bool hasAccelerationEcef();
@@ -208,6 +306,11 @@ public:
 	/// \exception invalid_operation Thrown if there is not any valid data.
 	math::vec3f accelerationEcef();
 
+	/// \brief Gets <c>accelerationEcef</c> without throwing an exception when it has no valid data.
+	/// \param[out] value Receives the data if it is valid.
+	/// \return <c>true</c> if <c>accelerationEcef</c> has valid data; otherwise <c>false</c>.
+	bool tryGetAccelerationEcef(math::vec3f& value);
+
 
 	/// \brief Indicates if <c>anyAngularRate</c> has valid data.
 	/// \return <c>true</c> if <c>anyAngularRate</c> has valid data; otherwise <c>false</c>.
@@ -229,6 +332,11 @@ public:
 	/// \exception invalid_operation Thrown if there is not any valid data.
 	math::vec3f angularRate();
 
+	/// \brief Gets <c>angularRate</c> without throwing an exception when it has no valid data.
+	/// \param[out] value Receives the data if it is valid.
+	/// \return <c>true</c> if <c>angularRate</c> has valid data; otherwise <c>false</c>.
+	bool tryGetAngularRate(math::vec3f& value);
+
 	/// \brief Indicates if <c>angularRateUncompensated</c> has valid data.
 	/// \return <c>true</c> if <c>angularRateUncompensated</c> has valid data; otherwise <c>false</c>.
 	bool hasAngularRateUncompensated();
@@ -238,6 +346,11 @@ public:
 	/// \exception invalid_operation Thrown if there is not any valid data.
 	math::vec3f angularRateUncompensated();
 
+	/// \brief Gets <c>angularRateUncompensated</c> without throwing an exception when it has no valid data.
+	/// \param[out] value Receives the data if it is valid.
+	/// \return <c>true</c> if <c>angularRateUncompensated</c> has valid data; otherwise <c>false</c>.
+	bool tryGetAngularRateUncompensated(math::vec3f& value);
+
 
 	/// \brief Indicates if <c>anyTemperature</c> has valid data.
 	/// \return <c>true</c> if <c>anyTemperature</c> has valid data; otherwise <c>false</c>.
@@ -259,6 +372,11 @@ public:
 	/// \exception invalid_operation Thrown if there is not any valid data.
 	float temperature();
 
+	/// \brief Gets <c>temperature</c> without throwing an exception when it has no valid data.
+	/// \param[out] value Receives the data if it is valid.
+	/// \return <c>true</c> if <c>temperature</c> has valid data; otherwise <c>false</c>.
+	bool tryGetTemperature(float& value);
+
 
 	/// \brief Indicates if <c>anyPressure</c> has valid data.
 	/// \return <c>true</c> if <c>anyPressure</c> has valid data; otherwise <c>false</c>.
@@ -280,6 +398,11 @@ public:
 	/// \exception invalid_operation Thrown if there is not any valid data.
 	float pressure();
 
+	/// \brief Gets <c>pressure</c> without throwing an exception when it has no valid data.
+	/// \param[out] value Receives the data if it is valid.
+	/// \return <c>true</c> if <c>pressure</c> has valid data; otherwise <c>false</c>.
+	bool tryGetPressure(float& value);
+
 	/// \brief Indicates if <c>anyPosition</c> has valid data.
 	/// \return <c>true</c> if <c>anyPosition</c> has valid data; otherwise <c>false</c>.
 	bool hasAnyPosition();
@@ -304,11 +427,21 @@ public:
   /// \exception invalid_operation Thrown if there is not any valid data.
   math::vec3d positionGpsLla();
 
+  /// \brief Gets <c>positionGpsLla</c> without throwing an exception when it has no valid data.
+  /// \param[out] value Receives the data if it is valid.
+  /// \return <c>true</c> if <c>positionGpsLla</c> has valid data; otherwise <c>false</c>.
+  bool tryGetPositionGpsLla(math::vec3d& value);
+
   /// \brief Position GPS2 LLA data.
   /// \return The Position GPS2 LLA data.
   /// \exception invalid_operation Thrown if there is not any valid data.
   math::vec3d positionGps2Lla();
 
+  /// \brief Gets <c>positionGps2Lla</c> without throwing an exception when it has no valid data.
+  /// \param[out] value Receives the data if it is valid.
+  /// \return <c>true</c> if <c>positionGps2Lla</c> has valid data; otherwise <c>false</c>.
+  bool tryGetPositionGps2Lla(math::vec3d& value);
+
   /// \brief Indicates if <c>positionGpsEcef</c> has valid data.
   /// \return <c>true</c> if <c>positionGpsEcef</c> has valid data; otherwise <c>false</c>.
   bool hasPositionGpsEcef();
@@ -322,11 +455,21 @@ public:
   /// \exception invalid_operation Thrown if there is not any valid data.
   math::vec3d positionGpsEcef();
 
+  /// \brief Gets <c>positionGpsEcef</c> without throwing an exception when it has no valid data.
+  /// \param[out] value Receives the data if it is valid.
+  /// \return <c>true</c> if <c>positionGpsEcef</c> has valid data; otherwise <c>false</c>.
+  bool tryGetPositionGpsEcef(math::vec3d& value);
+
   /// \brief Position GPS2 ECEF data.
   /// \return The Position GPS2 ECEF data.
   /// \exception invalid_operation Thrown if there is not any valid data.
   math::vec3d positionGps2Ecef();
 
+  /// \brief Gets <c>positionGps2Ecef</c> without throwing an exception when it has no valid data.
+  /// \param[out] value Receives the data if it is valid.
+  /// \return <c>true</c> if <c>positionGps2Ecef</c> has valid data; otherwise <c>false</c>.
+  bool tryGetPositionGps2Ecef(math::vec3d& value);
+
   /// \brief Indicates if <c>positionEstimatedLla</c> has valid data.
 	/// \return <c>true</c> if <c>positionEstimatedLla</c> has valid data; otherwise <c>false</c>.
 	bool hasPositionEstimatedLla();
@@ -336,6 +479,11 @@ public:
 	/// \exception invalid_operation Thrown if there is not any valid data.
 	math::vec3d positionEstimatedLla();
 
+	/// \brief Gets <c>positionEstimatedLla</c> without throwing an exception when it has no valid data.
+	/// \param[out] value Receives the data if it is valid.
+	/// \return <c>true</c> if <c>positionEstimatedLla</c> has valid data; otherwise <c>false</c>.
+	bool tryGetPositionEstimatedLla(math::vec3d& value);
+
 	/// \brief Indicates if <c>positionEstimatedEcef</c> has valid data.
 	/// \return <c>true</c> if <c>positionEstimatedEcef</c> has valid data; otherwise <c>false</c>.
 	bool hasPositionEstimatedEcef();
@@ -345,6 +493,11 @@ public:
 	/// \exception invalid_operation Thrown if there is not any valid data.
 	math::vec3d positionEstimatedEcef();
 
+	/// \brief Gets <c>positionEstimatedEcef</c> without throwing an exception when it has no valid data.
+	/// \param[out] value Receives the data if it is valid.
+	/// \return <c>true</c> if <c>positionEstimatedEcef</c> has valid data; otherwise <c>false</c>.
+	bool tryGetPositionEstimatedEcef(math::vec3d& value);
+
 	/// \brief Indicates if <c>anyVelocity</c> has valid data.
 	/// \return <c>true</c> if <c>anyVelocity</c> has valid data; otherwise <c>false</c>.
 	bool hasAnyVelocity();
@@ -369,11 +522,21 @@ public:
   /// \exception invalid_operation Thrown if there is not any valid data.
   math::vec3f velocityGpsNed();
 
+  /// \brief Gets <c>velocityGpsNed</c> without throwing an exception when it has no valid data.
+  /// \param[out] value Receives the data if it is valid.
+  /// \return <c>true</c> if <c>velocityGpsNed</c> has valid data; otherwise <c>false</c>.
+  bool tryGetVelocityGpsNed(math::vec3f& value);
+
   /// \brief Velocity GPS2 NED data.
   /// \return The velocity GPS2 NED data.
   /// \exception invalid_operation Thrown if there is not any valid data.
   math::vec3f velocityGps2Ned();
 
+  /// \brief Gets <c>velocityGps2Ned</c> without throwing an exception when it has no valid data.
+  /// \param[out] value Receives the data if it is valid.
+  /// \return <c>true</c> if <c>velocityGps2Ned</c> has valid data; otherwise <c>false</c>.
+  bool tryGetVelocityGps2Ned(math::vec3f& value);
+
   /// \brief Indicates if <c>velocityGpsEcef</c> has valid data.
   /// \return <c>true</c> if <c>velocityGpsEcef</c> has valid data; otherwise <c>false</c>.
   bool hasVelocityGpsEcef();
@@ -387,11 +550,21 @@ public:
   /// \exception invalid_operation Thrown if there is not any valid data.
   math::vec3f velocityGpsEcef();
 
+  /// \brief Gets <c>velocityGpsEcef</c> without throwing an exception when it has no valid data.
+  /// \param[out] value Receives the data if it is valid.
+  /// \return <c>true</c> if <c>velocityGpsEcef</c> has valid data; otherwise <c>false</c>.
+  bool tryGetVelocityGpsEcef(math::vec3f& value);
+
   /// \brief Velocity GPS2 ECEF data.
   /// \return The velocity GPS2 ECEF data.
   /// \exception invalid_operation Thrown if there is not any valid data.
   math::vec3f velocityGps2Ecef();
 
+  /// \brief Gets <c>velocityGps2Ecef</c> without throwing an exception when it has no valid data.
+  /// \param[out] value Receives the data if it is valid.
+  /// \return <c>true</c> if <c>velocityGps2Ecef</c> has valid data; otherwise <c>false</c>.
+  bool tryGetVelocityGps2Ecef(math::vec3f& value);
+
   /// \brief Indicates if <c>velocityEstimatedNed</c> has valid data.
 	/// \return <c>true</c> if <c>velocityEstimatedNed</c> has valid data; otherwise <c>false</c>.
 	bool hasVelocityEstimatedNed();
@@ -401,6 +574,11 @@ public:
 	/// \exception invalid_operation Thrown if there is not any valid data.
 	math::vec3f velocityEstimatedNed();
 
+	/// \brief Gets <c>velocityEstimatedNed</c> without throwing an exception when it has no valid data.
+	/// \param[out] value Receives the data if it is valid.
+	/// \return <c>true</c> if <c>velocityEstimatedNed</c> has valid data; otherwise <c>false</c>.
+	bool tryGetVelocityEstimatedNed(math::vec3f& value);
+
 	/// \brief Indicates if <c>velocityEstimatedEcef</c> has valid data.
 	/// \return <c>true</c> if <c>velocityEstimatedEcef</c> has valid data; otherwise <c>false</c>.
 	bool hasVelocityEstimatedEcef();
@@ -409,6 +587,11 @@ public:
 	/// \return The velocity estimated ECEF data.
 	/// \exception invalid_operation Thrown if there is not any valid data.
 	math::vec3f velocityEstimatedEcef();
+
+	/// \brief Gets <c>velocityEstimatedEcef</c> without throwing an exception when it has no valid data.
+	/// \param[out] value Receives the data if it is valid.
+	/// \return <c>true</c> if <c>velocityEstimatedEcef</c> has valid data; otherwise <c>false</c>.
+	bool tryGetVelocityEstimatedEcef(math::vec3f& value);
 	
 	/// \brief Indicates if <c>velocityEstimatedBody</c> has valid data.
 	/// \return <c>true</c> if <c>velocityEstimatedBody</c> has valid data; otherwise <c>false</c>.
@@ -419,6 +602,11 @@ public:
 	/// \exception invalid_operation Thrown if there is not any valid data.
 	math::vec3f velocityEstimatedBody();
 
+	/// \brief Gets <c>velocityEstimatedBody</c> without throwing an exception when it has no valid data.
+	/// \param[out] value Receives the data if it is valid.
+	/// \return <c>true</c> if <c>velocityEstimatedBody</c> has valid data; otherwise <c>false</c>.
+	bool tryGetVelocityEstimatedBody(math::vec3f& value);
+
 	/// \brief Indicates if <c>deltaTime</c> has valid data.
 	/// \return <c>true</c> if <c>deltaTime</c> has valid data; otherwise <c>false</c>.
 	bool hasDeltaTime();
@@ -428,6 +616,11 @@ public:
 	/// \exception invalid_operation Thrown if there is not any valid data.
 	float deltaTime();
 
+	/// \brief Gets <c>deltaTime</c> without throwing an exception when it has no valid data.
+	/// \param[out] value Receives the data if it is valid.
+	/// \return <c>true</c> if <c>deltaTime</c> has valid data; otherwise <c>false</c>.
+	bool tryGetDeltaTime(float& value);
+
 	/// \brief Indicates if <c>deltaTheta</c> has valid data.
 	/// \return <c>true</c> if <c>deltaTheta</c> has valid data; otherwise <c>false</c>.
 	bool hasDeltaTheta();
@@ -437,6 +630,11 @@ public:
 	/// \exception invalid_operation Thrown if there is not any valid data.
 	math::vec3f deltaTheta();
 
+	/// \brief Gets <c>deltaTheta</c> without throwing an exception when it has no valid data.
+	/// \param[out] value Receives the data if it is valid.
+	/// \return <c>true</c> if <c>deltaTheta</c> has valid data; otherwise <c>false</c>.
+	bool tryGetDeltaTheta(math::vec3f& value);
+
 	/// \brief Indicates if <c>deltaVelocity</c> has valid data.
 	/// \return <c>true</c> if <c>deltaVelocity</c> has valid data; otherwise <c>false</c>.
 	bool hasDeltaVelocity();
@@ -446,6 +644,11 @@ public:
 	/// \exception invalid_operation Thrown if there is not any valid data.
 	math::vec3f deltaVelocity();
 
+	/// \brief Gets <c>deltaVelocity</c> without throwing an exception when it has no valid data.
+	/// \param[out] value Receives the data if it is valid.
+	/// \return <c>true</c> if <c>deltaVelocity</c> has valid data; otherwise <c>false</c>.
+	bool tryGetDeltaVelocity(math::vec3f& value);
+
 	/// \brief Indicates if <c>timeStartup</c> has valid data.
 	/// \return <c>true</c> if <c>timeStartup</c> has valid data; otherwise <c>false</c>.
 	bool hasTimeStartup();
@@ -455,6 +658,11 @@ public:
 	/// \exception invalid_operation Thrown if there is not any valid data.
 	uint64_t timeStartup();
 
+	/// \brief Gets <c>timeStartup</c> without throwing an exception when it has no valid data.
+	/// \param[out] value Receives the data if it is valid.
+	/// \return <c>true</c> if <c>timeStartup</c> has valid data; otherwise <c>false</c>.
+	bool tryGetTimeStartup(uint64_t& value);
+
   /// \brief Indicates if <c>timeGps</c> has valid data.
   /// \return <c>true</c> if <c>timeGps</c> has valid data; otherwise <c>false</c>.
   bool hasTimeGps();
@@ -468,11 +676,21 @@ public:
   /// \exception invalid_operation Thrown if there is not any valid data.
   uint64_t timeGps();
 
+  /// \brief Gets <c>timeGps</c> without throwing an exception when it has no valid data.
+  /// \param[out] value Receives the data if it is valid.
+  /// \return <c>true</c> if <c>timeGps</c> has valid data; otherwise <c>false</c>.
+  bool tryGetTimeGps(uint64_t& value);
+
   /// \brief Time GPS2 data.
   /// \return The time GPS2 data.
   /// \exception invalid_operation Thrown if there is not any valid data.
   uint64_t timeGps2();
 
+  /// \brief Gets <c>timeGps2</c> without throwing an exception when it has no valid data.
+  /// \param[out] value Receives the data if it is valid.
+  /// \return <c>true</c> if <c>timeGps2</c> has valid data; otherwise <c>false</c>.
+  bool tryGetTimeGps2(uint64_t& value);
+
   /// \brief Indicates if <c>tow</c> has valid data.
   /// \return <c>true</c> if <c>tow</c> has valid data; otherwise <c>false</c>.
   bool hasTow();
@@ -482,6 +700,11 @@ public:
   /// \exception invalid_operation Thrown if there is not any valid data.
   double tow();
 
+  /// \brief Gets <c>tow</c> without throwing an exception when it has no valid data.
+  /// \param[out] value Receives the data if it is valid.
+  /// \return <c>true</c> if <c>tow</c> has valid data; otherwise <c>false</c>.
+  bool tryGetTow(double& value);
+
   /// \brief Indicates if <c>week</c> has valid data.
 	/// \return <c>true</c> if <c>week</c> has valid data; otherwise <c>false</c>.
 	bool hasWeek();
@@ -491,6 +714,11 @@ public:
 	/// \exception invalid_operation Thrown if there is not any valid data.
 	uint16_t week();
 
+	/// \brief Gets <c>week</c> without throwing an exception when it has no valid data.
+	/// \param[out] value Receives the data if it is valid.
+	/// \return <c>true</c> if <c>week</c> has valid data; otherwise <c>false</c>.
+	bool tryGetWeek(uint16_t& value);
+
 	/// \brief Indicates if <c>numSats</c> has valid data.
 	/// \return <c>true</c> if <c>numSats</c> has valid data; otherwise <c>false</c>.
 	bool hasNumSats();
@@ -500,6 +728,11 @@ public:
 	/// \exception invalid_operation Thrown if there is not any valid data.
 	uint8_t numSats();
 
+	/// \brief Gets <c>numSats</c> without throwing an exception when it has no valid data.
+	/// \param[out] value Receives the data if it is valid.
+	/// \return <c>true</c> if <c>numSats</c> has valid data; otherwise <c>false</c>.
+	bool tryGetNumSats(uint8_t& value);
+
 	/// \brief Indicates if <c>timeSyncIn</c> has valid data.
 	/// \return <c>true</c> if <c>timeSyncIn</c> has valid data; otherwise <c>false</c>.
 	bool hasTimeSyncIn();
@@ -509,6 +742,11 @@ public:
 	/// \exception invalid_operation Thrown if there is not any valid data.
 	uint64_t timeSyncIn();
 
+	/// \brief Gets <c>timeSyncIn</c> without throwing an exception when it has no valid data.
+	/// \param[out] value Receives the data if it is valid.
+	/// \return <c>true</c> if <c>timeSyncIn</c> has valid data; otherwise <c>false</c>.
+	bool tryGetTimeSyncIn(uint64_t& value);
+
 	/// \brief Indicates if <c>vpeStatus</c> has valid data.
 	/// \return <c>true</c> if <c>vpeStatus</c> has valid data; otherwise <c>false</c>.
 	bool hasVpeStatus();
@@ -518,6 +756,11 @@ public:
 	/// \exception invalid_operation Thrown if there is not any valid data.
 	protocol::uart::VpeStatus vpeStatus();
 
+	/// \brief Gets <c>vpeStatus</c> without throwing an exception when it has no valid data.
+	/// \param[out] value Receives the data if it is valid.
+	/// \return <c>true</c> if <c>vpeStatus</c> has valid data; otherwise <c>false</c>.
+	bool tryGetVpeStatus(protocol::uart::VpeStatus& value);
+
 	/// \brief Indicates if <c>insStatus</c> has valid data.
 	/// \return <c>true</c> if <c>insStatus</c> has valid data; otherwise <c>false</c>.
 	bool hasInsStatus();
@@ -527,6 +770,11 @@ public:
 	/// \exception invalid_operation Thrown if there is not any valid data.
 	protocol::uart::InsStatus insStatus();
 
+	/// \brief Gets <c>insStatus</c> without throwing an exception when it has no valid data.
+	/// \param[out] value Receives the data if it is valid.
+	/// \return <c>true</c> if <c>insStatus</c> has valid data; otherwise <c>false</c>.
+	bool tryGetInsStatus(protocol::uart::InsStatus& value);
+
 	/// \brief Indicates if <c>syncInCnt</c> has valid data.
 	/// \return <c>true</c> if <c>syncInCnt</c> has valid data; otherwise <c>false</c>.
 	bool hasSyncInCnt();
@@ -536,6 +784,11 @@ public:
 	/// \exception invalid_operation Thrown if there is not any valid data.
 	uint32_t syncInCnt();
 
+	/// \brief Gets <c>syncInCnt</c> without throwing an exception when it has no valid data.
+	/// \param[out] value Receives the data if it is valid.
+	/// \return <c>true</c> if <c>syncInCnt</c> has valid data; otherwise <c>false</c>.
+	bool tryGetSyncInCnt(uint32_t& value);
+
   /// \brief Indicates if <c>syncOutCnt</c> has valid data.
   /// \return <c>true</c> if <c>syncOutCnt</c> has valid data; otherwise <c>false</c>.
   bool hasSyncOutCnt();
@@ -545,6 +798,11 @@ public:
   /// \exception invalid_operation Thrown if there is not any valid data.
   uint32_t syncOutCnt();
 
+  /// \brief Gets <c>syncOutCnt</c> without throwing an exception when it has no valid data.
+  /// \param[out] value Receives the data if it is valid.
+  /// \return <c>true</c> if <c>syncOutCnt</c> has valid data; otherwise <c>false</c>.
+  bool tryGetSyncOutCnt(uint32_t& value);
+
   /// \brief Indicates if <c>timeStatus</c> has valid data.
   /// \return <c>true</c> if <c>timeStatus</c> has valid data; otherwise <c>false</c>.
   bool hasTimeStatus();
@@ -554,6 +812,11 @@ public:
   /// \exception invalid_operation Thrown if there is not any valid data.
   uint8_t timeStatus();
 
+  /// \brief Gets <c>timeStatus</c> without throwing an exception when it has no valid data.
+  /// \param[out] value Receives the data if it is valid.
+  /// \return <c>true</c> if <c>timeStatus</c> has valid data; otherwise <c>false</c>.
+  bool tryGetTimeStatus(uint8_t& value);
+
   /// \brief Indicates if <c>timeGpsPps</c> has valid data.
   /// \return <c>true</c> if <c>timeGpsPps</c> has valid data; otherwise <c>false</c>.
   bool hasTimeGpsPps();
@@ -567,11 +830,21 @@ public:
   /// \exception invalid_operation Thrown if there is not any valid data.
   uint64_t timeGpsPps();
 
+  /// \brief Gets <c>timeGpsPps</c> without throwing an exception when it has no valid data.
+  /// \param[out] value Receives the data if it is valid.
+  /// \return <c>true</c> if <c>timeGpsPps</c> has valid data; otherwise <c>false</c>.
+  bool tryGetTimeGpsPps(uint64_t& value);
+
   /// \brief TimeGps2Pps data.
   /// \return The TimeGps2Pps data.
   /// \exception invalid_operation Thrown if there is not any valid data.
   uint64_t timeGps2Pps();
 
+  /// \brief Gets <c>timeGps2Pps</c> without throwing an exception when it has no valid data.
+  /// \param[out] value Receives the data if it is valid.
+  /// \return <c>true</c> if <c>timeGps2Pps</c> has valid data; otherwise <c>false</c>.
+  bool tryGetTimeGps2Pps(uint64_t& value);
+
   /// \brief Indicates if <c>gpsTow</c> has valid data.
   /// \return <c>true</c> if <c>gpsTow</c> has valid data; otherwise <c>false</c>.
   bool hasGpsTow();
@@ -585,11 +858,21 @@ public:
   /// \exception invalid_operation Thrown if there is not any valid data.
   uint64_t gpsTow();
 
+  /// \brief Gets <c>gpsTow</c> without throwing an exception when it has no valid data.
+  /// \param[out] value Receives the data if it is valid.
+  /// \return <c>true</c> if <c>gpsTow</c> has valid data; otherwise <c>false</c>.
+  bool tryGetGpsTow(uint64_t& value);
+
   /// \brief Gps2Tow data.
   /// \return The Gps2Tow data.
   /// \exception invalid_operation Thrown if there is not any valid data.
   uint64_t gps2Tow();
 
+  /// \brief Gets <c>gps2Tow</c> without throwing an exception when it has no valid data.
+  /// \param[out] value Receives the data if it is valid.
+  /// \return <c>true</c> if <c>gps2Tow</c> has valid data; otherwise <c>false</c>.
+  bool tryGetGps2Tow(uint64_t& value);
+
   /// \brief Indicates if <c>timeUtc</c> has valid data.
 	/// \return <c>true</c> if <c>timeUtc</c> has valid data; otherwise <c>false</c>.
 	bool hasTimeUtc();
@@ -599,6 +882,11 @@ public:
 	/// \exception invalid_operation Thrown if there is not any valid data.
 	protocol::uart::TimeUtc timeUtc();
 
+	/// \brief Gets <c>timeUtc</c> without throwing an exception when it has no valid data.
+	/// \param[out] value Receives the data if it is valid.
+	/// \return <c>true</c> if <c>timeUtc</c> has valid data; otherwise <c>false</c>.
+	bool tryGetTimeUtc(protocol::uart::TimeUtc& value);
+
 	/// \brief Indicates if <c>sensSat</c> has valid data.
 	/// \return <c>true</c> if <c>sensSat</c> has valid data; otherwise <c>false</c>.
 	bool hasSensSat();
@@ -608,6 +896,11 @@ public:
 	/// \exception invalid_operation Thrown if there is not any valid data.
 	protocol::uart::SensSat sensSat();
 
+	/// \brief Gets <c>sensSat</c> without throwing an exception when it has no valid data.
+	/// \param[out] value Receives the data if it is valid.
+	/// \return <c>true</c> if <c>sensSat</c> has valid data; otherwise <c>false</c>.
+	bool tryGetSensSat(protocol::uart::SensSat& value);
+
   /// \brief Indicates if <c>fix</c> has valid data.
   /// \return <c>true</c> if <c>fix</c> has valid data; otherwise <c>false</c>.
   bool hasFix();
@@ -621,11 +914,21 @@ public:
   /// \exception invalid_operation Thrown if there is not any valid data.
   protocol::uart::GpsFix fix();
 
+  /// \brief Gets <c>fix</c> without throwing an exception when it has no valid data.
+  /// \param[out] value Receives the data if it is valid.
+  /// \return <c>true</c> if <c>fix</c> has valid data; otherwise <c>false</c>.
+  bool tryGetFix(protocol::uart::GpsFix& value);
+
   /// \brief GPS2 fix data.
   /// \return The GPS2 fix data.
   /// \exception invalid_operation Thrown if there is not any valid data.
   protocol::uart::GpsFix fix2();
 
+  /// \brief Gets <c>fix2</c> without throwing an exception when it has no valid data.
+  /// \param[out] value Receives the data if it is valid.
+  /// \return <c>true</c> if <c>fix2</c> has valid data; otherwise <c>false</c>.
+  bool tryGetFix2(protocol::uart::GpsFix& value);
+
   /// \brief Indicates if <c>anyPositionUncertainty</c> has valid data.
 	/// \return <c>true</c> if <c>anyPositionUncertainty</c> has valid data; otherwise <c>false</c>.
 	bool hasAnyPositionUncertainty();
@@ -650,11 +953,21 @@ public:
 	/// \exception invalid_operation Thrown if there is not any valid data.
 	math::vec3f positionUncertaintyGpsNed();
 
+	/// \brief Gets <c>positionUncertaintyGpsNed</c> without throwing an exception when it has no valid data.
+	/// \param[out] value Receives the data if it is valid.
+	/// \return <c>true</c> if <c>positionUncertaintyGpsNed</c> has valid data; otherwise <c>false</c>.
+	bool tryGetPositionUncertaintyGpsNed(math::vec3f& value);
+
   /// \brief GPS2 position uncertainty NED data.
   /// \return The GPS2 position uncertainty NED data.
   /// \exception invalid_operation Thrown if there is not any valid data.
   math::vec3f positionUncertaintyGps2Ned();
 
+  /// \brief Gets <c>positionUncertaintyGps2Ned</c> without throwing an exception when it has no valid data.
+  /// \param[out] value Receives the data if it is valid.
+  /// \return <c>true</c> if <c>positionUncertaintyGps2Ned</c> has valid data; otherwise <c>false</c>.
+  bool tryGetPositionUncertaintyGps2Ned(math::vec3f& value);
+
   /// \brief Indicates if <c>positionUncertaintyGpsEcef</c> has valid data.
   /// \return <c>true</c> if <c>positionUncertaintyGpsEcef</c> has valid data; otherwise <c>false</c>.
   bool hasPositionUncertaintyGpsEcef();
@@ -668,11 +981,21 @@ public:
 	/// \exception invalid_operation Thrown if there is not any valid data.
 	math::vec3f positionUncertaintyGpsEcef();
 
+	/// \brief Gets <c>positionUncertaintyGpsEcef</c> without throwing an exception when it has no valid data.
+	/// \param[out] value Receives the data if it is valid.
+	/// \return <c>true</c> if <c>positionUncertaintyGpsEcef</c> has valid data; otherwise <c>false</c>.
+	bool tryGetPositionUncertaintyGpsEcef(math::vec3f& value);
+
   /// \brief GPS2 position uncertainty ECEF data.
   /// \return The GPS2 position uncertainty ECEF data.
   /// \exception invalid_operation Thrown if there is not any valid data.
   math::vec3f positionUncertaintyGps2Ecef();
 
+  /// \brief Gets <c>positionUncertaintyGps2Ecef</c> without throwing an exception when it has no valid data.
+  /// \param[out] value Receives the data if it is valid.
+  /// \return <c>true</c> if <c>positionUncertaintyGps2Ecef</c> has valid data; otherwise <c>false</c>.
+  bool tryGetPositionUncertaintyGps2Ecef(math::vec3f& value);
+
   /// \brief Indicates if <c>positionUncertaintyEstimated</c> has valid data.
 	/// \return <c>true</c> if <c>positionUncertaintyEstimated</c> has valid data; otherwise <c>false</c>.
 	bool hasPositionUncertaintyEstimated();
@@ -682,6 +1005,11 @@ public:
 	/// \exception invalid_operation Thrown if there is not any valid data.
 	float positionUncertaintyEstimated();
 
+	/// \brief Gets <c>positionUncertaintyEstimated</c> without throwing an exception when it has no valid data.
+	/// \param[out] value Receives the data if it is valid.
+	/// \return <c>true</c> if <c>positionUncertaintyEstimated</c> has valid data; otherwise <c>false</c>.
+	bool tryGetPositionUncertaintyEstimated(float& value);
+
 	/// \brief Indicates if <c>anyVelocityUncertainty</c> has valid data.
 	/// \return <c>true</c> if <c>anyVelocityUncertainty</c> has valid data; otherwise <c>false</c>.
 	bool hasAnyVelocityUncertainty();
@@ -706,11 +1034,21 @@ public:
   /// \exception invalid_operation Thrown if there is not any valid data.
   float velocityUncertaintyGps();
 
+  /// \brief Gets <c>velocityUncertaintyGps</c> without throwing an exception when it has no valid data.
+  /// \param[out] value Receives the data if it is valid.
+  /// \return <c>true</c> if <c>velocityUncertaintyGps</c> has valid data; otherwise <c>false</c>.
+  bool tryGetVelocityUncertaintyGps(float& value);
+
   /// \brief GPS2 velocity uncertainty data.
   /// \return The GPS2 velocity uncertainty data.
   /// \exception invalid_operation Thrown if there is not any valid data.
   float velocityUncertaintyGps2();
 
+  /// \brief Gets <c>velocityUncertaintyGps2</c> without throwing an exception when it has no valid data.
+  /// \param[out] value Receives the data if it is valid.
+  /// \return <c>true</c> if <c>velocityUncertaintyGps2</c> has valid data; otherwise <c>false</c>.
+  bool tryGetVelocityUncertaintyGps2(float& value);
+
   /// \brief Indicates if <c>velocityUncertaintyEstimated</c> has valid data.
 	/// \return <c>true</c> if <c>velocityUncertaintyEstimated</c> has valid data; otherwise <c>false</c>.
 	bool hasVelocityUncertaintyEstimated();
@@ -719,6 +1057,11 @@ public:
 	/// \return The estimated velocity uncertainty data.
 	/// \exception invalid_operation Thrown if there is not any valid data.
 	float velocityUncertaintyEstimated();
+
+	/// \brief Gets <c>velocityUncertaintyEstimated</c> without throwing an exception when it has no valid data.
+	/// \param[out] value Receives the data if it is valid.
+	/// \return <c>true</c> if <c>velocityUncertaintyEstimated</c> has valid data; otherwise <c>false</c>.
+	bool tryGetVelocityUncertaintyEstimated(float& value);
 	
 	/// \brief Indicates if <c>timeUncertainty</c> has valid data.
 	/// \return <c>true</c> if <c>timeUncertainty</c> has valid data; otherwise <c>false</c>.
@@ -728,6 +1071,11 @@ public:
 	/// \return The time uncertainty data.
 	/// \exception invalid_operation Thrown if there is not any valid data.
 	uint32_t timeUncertainty();
+
+	/// \brief Gets <c>timeUncertainty</c> without throwing an exception when it has no valid data.
+	/// \param[out] value Receives the data if it is valid.
+	/// \return <c>true</c> if <c>timeUncertainty</c> has valid data; otherwise <c>false</c>.
+	bool tryGetTimeUncertainty(uint32_t& value);
 	
 	/// \brief Indicates if <c>attitudeUncertainty</c> has valid data.
 	/// \return <c>true</c> if <c>attitudeUncertainty</c> has valid data; otherwise <c>false</c>.
@@ -738,6 +1086,11 @@ public:
 	/// \exception invalid_operation Thrown if there is not any valid data.
 	math::vec3f attitudeUncertainty();
 
+	/// \brief Gets <c>attitudeUncertainty</c> without throwing an exception when it has no valid data.
+	/// \param[out] value Receives the data if it is valid.
+	/// \return <c>true</c> if <c>attitudeUncertainty</c> has valid data; otherwise <c>false</c>.
+	bool tryGetAttitudeUncertainty(math::vec3f& value);
+
 	/// \brief Indicates if <c>courseOverGround</c> has valid data.
 	/// \return <c>true</c> if <c>courseOverGround</c> havs valid data; otherwise <c>false</c>.
 	bool hasCourseOverGround();
@@ -768,12 +1121,22 @@ public:
   /// \exception invalid_operation Thrown if there is no valid data.
   protocol::uart::TimeInfo timeInfo();
 
+  /// \brief Gets <c>timeInfo</c> without throwing an exception when it has no valid data.
+  /// \param[out] value Receives the data if it is valid.
+  /// \return <c>true</c> if <c>timeInfo</c> has valid data; otherwise <c>false</c>.
+  bool tryGetTimeInfo(protocol::uart::TimeInfo& value);
+
   /// \brief GPS2 Time Status and number of leap seconds.
   ///
   /// \return Current Time Info.
   /// \exception invalid_operation Thrown if there is no valid data.
   protocol::uart::TimeInfo timeInfo2();
 
+  /// \brief Gets <c>timeInfo2</c> without throwing an exception when it has no valid data.
+  /// \param[out] value Receives the data if it is valid.
+  /// \return <c>true</c> if <c>timeInfo2</c> has valid data; otherwise <c>false</c>.
+  bool tryGetTimeInfo2(protocol::uart::TimeInfo& value);
+
   /// \brief Indicates if <c>dop</c> has valid data.
   /// \return <c>true</c> if <c>dop</c> havs valid data; otherwise <c>false</c>.
   bool hasDop();
@@ -784,32 +1147,2070 @@ public:
   /// \exception invalid_operation Thrown if there is no valid data.
   protocol::uart::GnssDop dop();
 
+  /// \brief Gets <c>dop</c> without throwing an exception when it has no valid data.
+  /// \param[out] value Receives the data if it is valid.
+  /// \return <c>true</c> if <c>dop</c> has valid data; otherwise <c>false</c>.
+  bool tryGetDop(protocol::uart::GnssDop& value);
+
 
 private:
-	static void parseBinary(protocol::uart::Packet& p, std::vector<CompositeData*>& o);
-	static void parseAscii(protocol::uart::Packet& p, std::vector<CompositeData*>& o);
-	static void parseBinaryPacketCommonGroup(protocol::uart::Packet& p, protocol::uart::CommonGroup gf, std::vector<CompositeData*>& o);
-	static void parseBinaryPacketTimeGroup(protocol::uart::Packet& p, protocol::uart::TimeGroup gf, std::vector<CompositeData*>& o);
-	static void parseBinaryPacketImuGroup(protocol::uart::Packet& p, protocol::uart::ImuGroup gf, std::vector<CompositeData*>& o);
-	static void parseBinaryPacketGpsGroup(protocol::uart::Packet& p, protocol::uart::GpsGroup gf, std::vector<CompositeData*>& o);
-	static void parseBinaryPacketAttitudeGroup(protocol::uart::Packet& p, protocol::uart::AttitudeGroup gf, std::vector<CompositeData*>& o);
-	static void parseBinaryPacketInsGroup(protocol::uart::Packet& p, protocol::uart::InsGroup gf, std::vector<CompositeData*>& o);
-	static void parseBinaryPacketGps2Group(protocol::uart::Packet& p, protocol::uart::GpsGroup gf, std::vector<CompositeData*>& o);
+	// The CompositeData objects a packet is parsed into.
+	struct Targets
+	{
+		CompositeData* const* first;
+		CompositeData* const* last;
+
+		CompositeData* const* begin() const { return first; }
+		CompositeData* const* end() const { return last; }
+	};
+
+	static void parse(protocol::uart::Packet& p, const Targets& o);
+	static void parseBinary(protocol::uart::Packet& p, const Targets& o);
+	static void parseAscii(protocol::uart::Packet& p, const Targets& o);
+	static void parseBinaryPacketCommonImu(const char* data, const Targets& o);
+	static void parseBinaryPacketCommonMagPres(const char* data, const Targets& o);
+	static void parseBinaryPacketCommonDeltaTheta(const char* data, const Targets& o);
+	static void parseBinaryPacketCommonInsStatus(const char* data, const Targets& o);
+	static void parseBinaryPacketImuDeltaTheta(const char* data, const Targets& o);
 
 private:
-	struct Impl;
-	Impl* _i;
+	// Storage for the data. It is trivially copyable so CompositeData objects are
+	// copied with a single memcpy and never allocate.
+	struct Impl
+	{
+		enum AttitudeType
+		{
+			CDATT_None,
+			CDATT_YawPitchRoll,
+			CDATT_Quaternion,
+			CDATT_DirectionCosineMatrix
+		};
+
+		enum AccelerationType
+		{
+			CDACC_None,
+			CDACC_Normal,
+			CDACC_Uncompensated,
+			CDACC_LinearBody,
+			CDACC_LinearNed,
+			CDACC_Ned,
+			CDACC_Ecef,
+			CDACC_LinearEcef,
+		};
+
+		enum MagneticType
+		{
+			CDMAG_None,
+			CDMAG_Normal,
+			CDMAG_Uncompensated,
+			CDMAG_Ned,
+			CDMAG_Ecef,
+		};
+
+		enum AngularRateType
+		{
+			CDANR_None,
+			CDANR_Normal,
+			CDANR_Uncompensated,
+		};
+
+		enum TemperatureType
+		{
+			CDTEM_None,
+			CDTEM_Normal,
+		};
+
+		enum PressureType
+		{
+			CDPRE_None,
+			CDPRE_Normal
+		};
+
+		enum PositionType
+		{
+			CDPOS_None,
+			CDPOS_GpsLla,
+			CDPOS_Gps2Lla,
+			CDPOS_GpsEcef,
+			CDPOS_Gps2Ecef,
+			CDPOS_EstimatedLla,
+			CDPOS_EstimatedEcef
+		};
+
+		enum VelocityType
+		{
+			CDVEL_None,
+			CDVEL_GpsNed,
+			CDVEL_Gps2Ned,
+			CDVEL_GpsEcef,
+			CDVEL_Gps2Ecef,
+			CDVEL_EstimatedNed,
+			CDVEL_EstimatedEcef,
+			CDVEL_EstimatedBody
+		};
+
+		enum PositionUncertaintyType
+		{
+			CDPOU_None,
+			CDPOU_GpsNed,
+			CDPOU_Gps2Ned,
+			CDPOU_GpsEcef,
+			CDPOU_Gps2Ecef,
+			CDPOU_Estimated
+		};
+
+		enum VelocityUncertaintyType
+		{
+			CDVEU_None,
+			CDVEU_Gps,
+			CDVEU_Gps2,
+			CDVEU_Estimated
+		};
+
+		// Bits of <c>presence</c> indicating which data is valid.
+		enum PresenceBit
+		{
+			CDHAS_YawPitchRoll,
+			CDHAS_Quaternion,
+			CDHAS_DirectionCosineMatrix,
+			CDHAS_Magnetic,
+			CDHAS_MagneticUncompensated,
+			CDHAS_MagneticNed,
+			CDHAS_MagneticEcef,
+			CDHAS_Acceleration,
+			CDHAS_AccelerationLinearBody,
+			CDHAS_AccelerationUncompensated,
+			CDHAS_AccelerationLinearNed,
+			CDHAS_AccelerationLinearEcef,
+			CDHAS_AccelerationNed,
+			CDHAS_AccelerationEcef,
+			CDHAS_AngularRate,
+			CDHAS_AngularRateUncompensated,
+			CDHAS_Temperature,
+			CDHAS_Pressure,
+			CDHAS_PositionGpsLla,
+			CDHAS_PositionGps2Lla,
+			CDHAS_PositionGpsEcef,
+			CDHAS_PositionGps2Ecef,
+			CDHAS_PositionEstimatedLla,
+			CDHAS_PositionEstimatedEcef,
+			CDHAS_VelocityGpsNed,
+			CDHAS_VelocityGps2Ned,
+			CDHAS_VelocityGpsEcef,
+			CDHAS_VelocityGps2Ecef,
+			CDHAS_VelocityEstimatedNed,
+			CDHAS_VelocityEstimatedEcef,
+			CDHAS_VelocityEstimatedBody,
+			CDHAS_DeltaTime,
+			CDHAS_DeltaTheta,
+			CDHAS_DeltaVelocity,
+			CDHAS_TimeStartup,
+			CDHAS_TimeGps,
+			CDHAS_TimeGps2,
+			CDHAS_Tow,
+			CDHAS_Week,
+			CDHAS_GpsWeek,
+			CDHAS_Gps2Week,
+			CDHAS_NumSats,
+			CDHAS_NumSats2,
+			CDHAS_TimeSyncIn,
+			CDHAS_VpeStatus,
+			CDHAS_InsStatus,
+			CDHAS_SyncInCnt,
+			CDHAS_SyncOutCnt,
+			CDHAS_TimeStatus,
+			CDHAS_TimeGpsPps,
+			CDHAS_TimeGps2Pps,
+			CDHAS_GpsTow,
+			CDHAS_Gps2Tow,
+			CDHAS_TimeUtc,
+			CDHAS_TimeUtc2,
+			CDHAS_SensSat,
+			CDHAS_Fix,
+			CDHAS_Fix2,
+			CDHAS_PositionUncertaintyGpsNed,
+			CDHAS_PositionUncertaintyGps2Ned,
+			CDHAS_PositionUncertaintyGpsEcef,
+			CDHAS_PositionUncertaintyGps2Ecef,
+			CDHAS_PositionUncertaintyEstimated,
+			CDHAS_VelocityUncertaintyGps,
+			CDHAS_VelocityUncertaintyGps2,
+			CDHAS_VelocityUncertaintyEstimated,
+			CDHAS_TimeUncertainty,
+			CDHAS_TimeUncertainty2,
+			CDHAS_AttitudeUncertainty,
+			CDHAS_TimeInfo,
+			CDHAS_TimeInfo2,
+			CDHAS_Dop,
+			CDHAS_Dop2,
+			CDHAS_Count
+		};
+
+		typedef char PresenceBitsMustFitInMask[CDHAS_Count <= 128 ? 1 : -1];
+
+		// Checked by every accessor and cleared by reset(), so it is kept
+		// together at the front.
+		uint64_t presence[2];
+		AttitudeType mostRecentlyUpdatedAttitudeType;
+		MagneticType mostRecentlyUpdatedMagneticType;
+		AccelerationType mostRecentlyUpdatedAccelerationType;
+		AngularRateType mostRecentlyUpdatedAngularRateType;
+		TemperatureType mostRecentlyUpdatedTemperatureType;
+		PressureType mostRecentlyUpdatePressureType;
+		PositionType mostRecentlyUpdatedPositionType;
+		VelocityType mostRecentlyUpdatedVelocityType;
+		PositionUncertaintyType mostRecentlyUpdatedPositionUncertaintyType;
+		VelocityUncertaintyType mostRecentlyUpdatedVelocityUncertaintyType;
+
+		// Outputs typically enabled at the IMU rate.
+		math::vec3f yawPitchRoll;
+		math::vec4f quaternion;
+		math::mat3f directionConsineMatrix;
+		math::vec3f angularRate, acceleration, magnetic;
+		float temperature, pressure;
+		uint64_t timeStartup, timeGps, timeSyncIn;
+		uint32_t syncInCnt;
+		protocol::uart::VpeStatus vpeStatus;
+		protocol::uart::InsStatus insStatus;
+		float deltaTime;
+		math::vec3f deltaTheta, deltaVelocity;
+
+		// Navigation solution.
+		math::vec3d positionEstimatedLla, positionEstimatedEcef;
+		math::vec3f velocityEstimatedNed, velocityEstimatedEcef, velocityEstimatedBody;
+		math::vec3f accelerationLinearBody, accelerationLinearNed, accelerationLinearEcef, accelerationNed, accelerationEcef;
+		math::vec3f magneticNed, magneticEcef;
+		math::vec3f attitudeUncertainty;
+		float positionUncertaintyEstimated, velocityUncertaintyEstimated;
+
+		// Uncompensated IMU measurements.
+		math::vec3f magneticUncompensated, accelerationUncompensated, angularRateUncompensated;
+		protocol::uart::SensSat sensSat;
+
+		// GPS receiver.
+		double tow;
+		uint64_t gpsTow, timeGpsPps;
+		uint16_t week, gpsWeek;
+		protocol::uart::TimeUtc timeUtc;
+		protocol::uart::TimeInfo timeInfo;
+		uint8_t numSats, timeStatus;
+		protocol::uart::GpsFix fix;
+		math::vec3d positionGpsLla, positionGpsEcef;
+		math::vec3f velocityGpsNed, velocityGpsEcef;
+		math::vec3f positionUncertaintyGpsNed, positionUncertaintyGpsEcef;
+		float velocityUncertaintyGps;
+		uint32_t timeUncertainty, syncOutCnt;
+		protocol::uart::GnssDop dop;
+
+		// Second GPS receiver.
+		uint64_t timeGps2, gps2Tow, timeGps2Pps;
+		uint16_t gps2Week;
+		protocol::uart::TimeUtc timeUtc2;
+		protocol::uart::TimeInfo timeInfo2;
+		uint8_t numSats2;
+		protocol::uart::GpsFix fix2;
+		math::vec3d positionGps2Lla, positionGps2Ecef;
+		math::vec3f velocityGps2Ned, velocityGps2Ecef;
+		math::vec3f positionUncertaintyGps2Ned, positionUncertaintyGps2Ecef;
+		float velocityUncertaintyGps2;
+		uint32_t timeUncertainty2;
+		protocol::uart::GnssDop dop2;
+
+		bool has(PresenceBit bit) const
+		{
+			return ((presence[bit >> 6] >> (bit & 0x3F)) & 0x01) != 0;
+		}
+
+		void set(PresenceBit bit)
+		{
+			presence[bit >> 6] |= static_cast<uint64_t>(1) << (bit & 0x3F);
+		}
+
+		void reset()
+		{
+			// Values are only read when their presence bit is set, so only
+			// the front block needs clearing.
+			presence[0] = 0;
+			presence[1] = 0;
+			mostRecentlyUpdatedAttitudeType = CDATT_None;
+			mostRecentlyUpdatedMagneticType = CDMAG_None;
+			mostRecentlyUpdatedAccelerationType = CDACC_None;
+			mostRecentlyUpdatedAngularRateType = CDANR_None;
+			mostRecentlyUpdatedTemperatureType = CDTEM_None;
+			mostRecentlyUpdatePressureType = CDPRE_None;
+			mostRecentlyUpdatedPositionType = CDPOS_None;
+			mostRecentlyUpdatedVelocityType = CDVEL_None;
+			mostRecentlyUpdatedPositionUncertaintyType = CDPOU_None;
+			mostRecentlyUpdatedVelocityUncertaintyType = CDVEU_None;
+		}
+
+		void setYawPitchRoll(math::vec3f ypr);
+		void setQuaternion(math::vec4f quat);
+		void setDirectionConsineMatrix(math::mat3f dcm);
+		void setMagnetic(math::vec3f mag);
+		void setMagneticUncompensated(math::vec3f mag);
+		void setMagneticNed(math::vec3f mag);
+		void setMagneticEcef(math::vec3f mag);
+		void setAcceleration(math::vec3f accel);
+		void setAccelerationLinearBody(math::vec3f accel);
+		void setAccelerationUncompensated(math::vec3f accel);
+		void setAccelerationLinearNed(math::vec3f accel);
+		void setAccelerationLinearEcef(math::vec3f accel);
+		void setAccelerationNed(math::vec3f accel);
+		void setAccelerationEcef(math::vec3f accel);
+		void setAngularRate(math::vec3f ar);
+		void setAngularRateUncompensated(math::vec3f ar);
+		void setTemperature(float temp);
+		void setPressure(float pres);
+		void setPositionGpsLla(math::vec3d pos);
+		void setPositionGps2Lla(math::vec3d pos);
+		void setPositionGpsEcef(math::vec3d pos);
+		void setPositionGps2Ecef(math::vec3d pos);
+		void setPositionEstimatedLla(math::vec3d pos);
+		void setPositionEstimatedEcef(math::vec3d pos);
+		void setVelocityGpsNed(math::vec3f vel);
+		void setVelocityGps2Ned(math::vec3f vel);
+		void setVelocityGpsEcef(math::vec3f vel);
+		void setVelocityGps2Ecef(math::vec3f vel);
+		void setVelocityEstimatedNed(math::vec3f vel);
+		void setVelocityEstimatedEcef(math::vec3f vel);
+		void setVelocityEstimatedBody(math::vec3f vel);
+		void setDeltaTime(float time);
+		void setDeltaTheta(math::vec3f theta);
+		void setDeltaVelocity(math::vec3f vel);
+		void setTimeStartup(uint64_t ts);
+		void setTimeGps(uint64_t time);
+		void setTimeGps2(uint64_t time);
+		void setTow(double t);
+		void setWeek(uint16_t w);
+		void setGpsWeek(uint16_t w);
+		void setGps2Week(uint16_t w);
+		void setNumSats(uint8_t s);
+		void setNumSats2(uint8_t s);
+		void setTimeSyncIn(uint64_t t);
+		void setVpeStatus(protocol::uart::VpeStatus s);
+		void setInsStatus(protocol::uart::InsStatus s);
+		void setSyncInCnt(uint32_t count);
+		void setSyncOutCnt(uint32_t count);
+		void setTimeStatus(uint8_t status);
+		void setTimeGpsPps(uint64_t pps);
+		void setTimeGps2Pps(uint64_t pps);
+		void setGpsTow(uint64_t tow);
+		void setGps2Tow(uint64_t tow);
+		void setPositionUncertaintyGpsNed(math::vec3f u);
+		void setPositionUncertaintyGps2Ned(math::vec3f u);
+		void setPositionUncertaintyGpsEcef(math::vec3f u);
+		void setPositionUncertaintyGps2Ecef(math::vec3f u);
+		void setPositionUncertaintyEstimated(float u);
+		void setVelocityUncertaintyGps(float u);
+		void setVelocityUncertaintyGps2(float u);
+		void setVelocityUncertaintyEstimated(float u);
+		void setTimeUncertainty(uint32_t u);
+		void setTimeUncertainty2(uint32_t u);
+		void setAttitudeUncertainty(math::vec3f u);
+		void setFix(protocol::uart::GpsFix f);
+		void setFix2(protocol::uart::GpsFix f);
+		void setTimeUtc(protocol::uart::TimeUtc t);
+		void setTimeUtc2(protocol::uart::TimeUtc t);
+		void setSensSat(protocol::uart::SensSat s);
+		void setGnssDop(protocol::uart::GnssDop d);
+		void setGnssDop2(protocol::uart::GnssDop d);
+		void setTimeInfo(protocol::uart::TimeInfo t);
+		void setTimeInfo2(protocol::uart::TimeInfo t);
+	};
+
+	Impl _i;
 
 	template<typename T>
-	static void setValues(T val, std::vector<CompositeData*>& o, void (Impl::* function)(T))
+	static void setValues(T val, const Targets& o, void (Impl::* function)(T))
+	{
+		for (CompositeData* const* i = o.begin(); i != o.end(); ++i)
+			(((*i)->_i).*function)(val);
+	}
+
+	// Parses one field of a binary packet, indexed by group and field bit.
+	typedef void (*BinaryFieldParser)(const char* data, const Targets& o);
+	static const BinaryFieldParser BinaryFieldParsers[7][15];
+
+	template<typename T, T (*read)(const char*), void (Impl::* function)(T)>
+	static void parseBinaryField(const char* data, const Targets& o)
 	{
-		for (std::vector<CompositeData*>::iterator i = o.begin(); i != o.end(); ++i)
-			(*((*i)->_i).*function)(val);
+		setValues(read(data), o, function);
 	}
 };
 
 
 
+inline bool CompositeData::hasYawPitchRoll()
+{
+	return _i.has(Impl::CDHAS_YawPitchRoll);
+}
+
+inline bool CompositeData::tryGetYawPitchRoll(math::vec3f& value)
+{
+	if (!hasYawPitchRoll())
+		return false;
+
+	value = _i.yawPitchRoll;
+
+	return true;
+}
+
+inline math::vec3f CompositeData::yawPitchRoll()
+{
+	math::vec3f value;
+
+	if (!tryGetYawPitchRoll(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::hasQuaternion()
+{
+	return _i.has(Impl::CDHAS_Quaternion);
+}
+
+inline bool CompositeData::tryGetQuaternion(math::vec4f& value)
+{
+	if (!hasQuaternion())
+		return false;
+
+	value = _i.quaternion;
+
+	return true;
+}
+
+inline math::vec4f CompositeData::quaternion()
+{
+	math::vec4f value;
+
+	if (!tryGetQuaternion(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::hasDirectionCosineMatrix()
+{
+	return _i.has(Impl::CDHAS_DirectionCosineMatrix);
+}
+
+inline bool CompositeData::tryGetDirectionCosineMatrix(math::mat3f& value)
+{
+	if (!hasDirectionCosineMatrix())
+		return false;
+
+	value = _i.directionConsineMatrix;
+
+	return true;
+}
+
+inline math::mat3f CompositeData::directionCosineMatrix()
+{
+	math::mat3f value;
+
+	if (!tryGetDirectionCosineMatrix(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::hasMagnetic()
+{
+	return _i.has(Impl::CDHAS_Magnetic);
+}
+
+inline bool CompositeData::tryGetMagnetic(math::vec3f& value)
+{
+	if (!hasMagnetic())
+		return false;
+
+	value = _i.magnetic;
+
+	return true;
+}
+
+inline math::vec3f CompositeData::magnetic()
+{
+	math::vec3f value;
+
+	if (!tryGetMagnetic(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::hasMagneticUncompensated()
+{
+	return _i.has(Impl::CDHAS_MagneticUncompensated);
+}
+
+inline bool CompositeData::tryGetMagneticUncompensated(math::vec3f& value)
+{
+	if (!hasMagneticUncompensated())
+		return false;
+
+	value = _i.magneticUncompensated;
+
+	return true;
+}
+
+inline math::vec3f CompositeData::magneticUncompensated()
+{
+	math::vec3f value;
+
+	if (!tryGetMagneticUncompensated(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::hasMagneticNed()
+{
+	return _i.has(Impl::CDHAS_MagneticNed);
+}
+
+inline bool CompositeData::tryGetMagneticNed(math::vec3f& value)
+{
+	if (!hasMagneticNed())
+		return false;
+
+	value = _i.magneticNed;
+
+	return true;
+}
+
+inline math::vec3f CompositeData::magneticNed()
+{
+	math::vec3f value;
+
+	if (!tryGetMagneticNed(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::hasMagneticEcef()
+{
+	return _i.has(Impl::CDHAS_MagneticEcef);
+}
+
+inline bool CompositeData::tryGetMagneticEcef(math::vec3f& value)
+{
+	if (!hasMagneticEcef())
+		return false;
+
+	value = _i.magneticEcef;
+
+	return true;
+}
+
+inline math::vec3f CompositeData::magneticEcef()
+{
+	math::vec3f value;
+
+	if (!tryGetMagneticEcef(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::hasAcceleration()
+{
+	return _i.has(Impl::CDHAS_Acceleration);
+}
+
+inline bool CompositeData::tryGetAcceleration(math::vec3f& value)
+{
+	if (!hasAcceleration())
+		return false;
+
+	value = _i.acceleration;
+
+	return true;
+}
+
+inline math::vec3f CompositeData::acceleration()
+{
+	math::vec3f value;
+
+	if (!tryGetAcceleration(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::hasAccelerationLinearBody()
+{
+	return _i.has(Impl::CDHAS_AccelerationLinearBody);
+}
+
+inline bool CompositeData::tryGetAccelerationLinearBody(math::vec3f& value)
+{
+	if (!hasAccelerationLinearBody())
+		return false;
+
+	value = _i.accelerationLinearBody;
+
+	return true;
+}
+
+inline math::vec3f CompositeData::accelerationLinearBody()
+{
+	math::vec3f value;
+
+	if (!tryGetAccelerationLinearBody(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::hasAccelerationUncompensated()
+{
+	return _i.has(Impl::CDHAS_AccelerationUncompensated);
+}
+
+inline bool CompositeData::tryGetAccelerationUncompensated(math::vec3f& value)
+{
+	if (!hasAccelerationUncompensated())
+		return false;
+
+	value = _i.accelerationUncompensated;
+
+	return true;
+}
+
+inline math::vec3f CompositeData::accelerationUncompensated()
+{
+	math::vec3f value;
+
+	if (!tryGetAccelerationUncompensated(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::hasAccelerationLinearNed()
+{
+	return _i.has(Impl::CDHAS_AccelerationLinearNed);
+}
+
+inline bool CompositeData::tryGetAccelerationLinearNed(math::vec3f& value)
+{
+	if (!hasAccelerationLinearNed())
+		return false;
+
+	value = _i.accelerationLinearNed;
+
+	return true;
+}
+
+inline math::vec3f CompositeData::accelerationLinearNed()
+{
+	math::vec3f value;
+
+	if (!tryGetAccelerationLinearNed(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::hasAccelerationLinearEcef()
+{
+	return _i.has(Impl::CDHAS_AccelerationLinearEcef);
+}
+
+inline bool CompositeData::tryGetAccelerationLinearEcef(math::vec3f& value)
+{
+	if (!hasAccelerationLinearEcef())
+		return false;
+
+	value = _i.accelerationLinearEcef;
+
+	return true;
+}
+
+inline math::vec3f CompositeData::accelerationLinearEcef()
+{
+	math::vec3f value;
+
+	if (!tryGetAccelerationLinearEcef(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::hasAccelerationNed()
+{
+	return _i.has(Impl::CDHAS_AccelerationNed);
+}
+
+inline bool CompositeData::tryGetAccelerationNed(math::vec3f& value)
+{
+	if (!hasAccelerationNed())
+		return false;
+
+	value = _i.accelerationNed;
+
+	return true;
+}
+
+inline math::vec3f CompositeData::accelerationNed()
+{
+	math::vec3f value;
+
+	if (!tryGetAccelerationNed(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::hasAccelerationEcef()
+{
+	return _i.has(Impl::CDHAS_AccelerationEcef);
+}
+
+inline bool CompositeData::tryGetAccelerationEcef(math::vec3f& value)
+{
+	if (!hasAccelerationEcef())
+		return false;
+
+	value = _i.accelerationEcef;
+
+	return true;
+}
+
+inline math::vec3f CompositeData::accelerationEcef()
+{
+	math::vec3f value;
+
+	if (!tryGetAccelerationEcef(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::hasAngularRate()
+{
+	return _i.has(Impl::CDHAS_AngularRate);
+}
+
+inline bool CompositeData::tryGetAngularRate(math::vec3f& value)
+{
+	if (!hasAngularRate())
+		return false;
+
+	value = _i.angularRate;
+
+	return true;
+}
+
+inline math::vec3f CompositeData::angularRate()
+{
+	math::vec3f value;
+
+	if (!tryGetAngularRate(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::hasAngularRateUncompensated()
+{
+	return _i.has(Impl::CDHAS_AngularRateUncompensated);
+}
+
+inline bool CompositeData::tryGetAngularRateUncompensated(math::vec3f& value)
+{
+	if (!hasAngularRateUncompensated())
+		return false;
+
+	value = _i.angularRateUncompensated;
+
+	return true;
+}
+
+inline math::vec3f CompositeData::angularRateUncompensated()
+{
+	math::vec3f value;
+
+	if (!tryGetAngularRateUncompensated(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::hasTemperature()
+{
+	return _i.has(Impl::CDHAS_Temperature);
+}
+
+inline bool CompositeData::tryGetTemperature(float& value)
+{
+	if (!hasTemperature())
+		return false;
+
+	value = _i.temperature;
+
+	return true;
+}
+
+inline float CompositeData::temperature()
+{
+	float value;
+
+	if (!tryGetTemperature(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::hasPressure()
+{
+	return _i.has(Impl::CDHAS_Pressure);
+}
+
+inline bool CompositeData::tryGetPressure(float& value)
+{
+	if (!hasPressure())
+		return false;
+
+	value = _i.pressure;
+
+	return true;
+}
+
+inline float CompositeData::pressure()
+{
+	float value;
+
+	if (!tryGetPressure(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::hasPositionGpsLla()
+{
+	return _i.has(Impl::CDHAS_PositionGpsLla);
+}
+
+inline bool CompositeData::hasPositionGps2Lla()
+{
+	return _i.has(Impl::CDHAS_PositionGps2Lla);
+}
+
+inline bool CompositeData::tryGetPositionGpsLla(math::vec3d& value)
+{
+	if (!hasPositionGpsLla())
+		return false;
+
+	value = _i.positionGpsLla;
+
+	return true;
+}
+
+inline math::vec3d CompositeData::positionGpsLla()
+{
+	math::vec3d value;
+
+	if (!tryGetPositionGpsLla(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::tryGetPositionGps2Lla(math::vec3d& value)
+{
+	if (!hasPositionGps2Lla())
+		return false;
+
+	value = _i.positionGps2Lla;
+
+	return true;
+}
+
+inline math::vec3d CompositeData::positionGps2Lla()
+{
+	math::vec3d value;
+
+	if (!tryGetPositionGps2Lla(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::hasPositionGpsEcef()
+{
+	return _i.has(Impl::CDHAS_PositionGpsEcef);
+}
+
+inline bool CompositeData::hasPositionGps2Ecef()
+{
+	return _i.has(Impl::CDHAS_PositionGps2Ecef);
+}
+
+inline bool CompositeData::tryGetPositionGpsEcef(math::vec3d& value)
+{
+	if (!hasPositionGpsEcef())
+		return false;
+
+	value = _i.positionGpsEcef;
+
+	return true;
+}
+
+inline math::vec3d CompositeData::positionGpsEcef()
+{
+	math::vec3d value;
+
+	if (!tryGetPositionGpsEcef(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::tryGetPositionGps2Ecef(math::vec3d& value)
+{
+	if (!hasPositionGps2Ecef())
+		return false;
+
+	value = _i.positionGps2Ecef;
+
+	return true;
+}
+
+inline math::vec3d CompositeData::positionGps2Ecef()
+{
+	math::vec3d value;
+
+	if (!tryGetPositionGps2Ecef(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::hasPositionEstimatedLla()
+{
+	return _i.has(Impl::CDHAS_PositionEstimatedLla);
+}
+
+inline bool CompositeData::tryGetPositionEstimatedLla(math::vec3d& value)
+{
+	if (!hasPositionEstimatedLla())
+		return false;
+
+	value = _i.positionEstimatedLla;
+
+	return true;
+}
+
+inline math::vec3d CompositeData::positionEstimatedLla()
+{
+	math::vec3d value;
+
+	if (!tryGetPositionEstimatedLla(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::hasPositionEstimatedEcef()
+{
+	return _i.has(Impl::CDHAS_PositionEstimatedEcef);
+}
+
+inline bool CompositeData::tryGetPositionEstimatedEcef(math::vec3d& value)
+{
+	if (!hasPositionEstimatedEcef())
+		return false;
+
+	value = _i.positionEstimatedEcef;
+
+	return true;
+}
+
+inline math::vec3d CompositeData::positionEstimatedEcef()
+{
+	math::vec3d value;
+
+	if (!tryGetPositionEstimatedEcef(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::hasVelocityGpsNed()
+{
+	return _i.has(Impl::CDHAS_VelocityGpsNed);
+}
+
+inline bool CompositeData::hasVelocityGps2Ned()
+{
+	return _i.has(Impl::CDHAS_VelocityGps2Ned);
+}
+
+inline bool CompositeData::tryGetVelocityGpsNed(math::vec3f& value)
+{
+	if (!hasVelocityGpsNed())
+		return false;
+
+	value = _i.velocityGpsNed;
+
+	return true;
+}
+
+inline math::vec3f CompositeData::velocityGpsNed()
+{
+	math::vec3f value;
+
+	if (!tryGetVelocityGpsNed(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::tryGetVelocityGps2Ned(math::vec3f& value)
+{
+	if (!hasVelocityGps2Ned())
+		return false;
+
+	value = _i.velocityGps2Ned;
+
+	return true;
+}
+
+inline math::vec3f CompositeData::velocityGps2Ned()
+{
+	math::vec3f value;
+
+	if (!tryGetVelocityGps2Ned(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::hasVelocityGpsEcef()
+{
+	return _i.has(Impl::CDHAS_VelocityGpsEcef);
+}
+
+inline bool CompositeData::hasVelocityGps2Ecef()
+{
+	return _i.has(Impl::CDHAS_VelocityGps2Ecef);
+}
+
+inline bool CompositeData::tryGetVelocityGpsEcef(math::vec3f& value)
+{
+	if (!hasVelocityGpsEcef())
+		return false;
+
+	value = _i.velocityGpsEcef;
+
+	return true;
+}
+
+inline math::vec3f CompositeData::velocityGpsEcef()
+{
+	math::vec3f value;
+
+	if (!tryGetVelocityGpsEcef(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::tryGetVelocityGps2Ecef(math::vec3f& value)
+{
+	if (!hasVelocityGps2Ecef())
+		return false;
+
+	value = _i.velocityGps2Ecef;
+
+	return true;
+}
+
+inline math::vec3f CompositeData::velocityGps2Ecef()
+{
+	math::vec3f value;
+
+	if (!tryGetVelocityGps2Ecef(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::hasVelocityEstimatedNed()
+{
+	return _i.has(Impl::CDHAS_VelocityEstimatedNed);
+}
+
+inline bool CompositeData::tryGetVelocityEstimatedNed(math::vec3f& value)
+{
+	if (!hasVelocityEstimatedNed())
+		return false;
+
+	value = _i.velocityEstimatedNed;
+
+	return true;
+}
+
+inline math::vec3f CompositeData::velocityEstimatedNed()
+{
+	math::vec3f value;
+
+	if (!tryGetVelocityEstimatedNed(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::hasVelocityEstimatedEcef()
+{
+	return _i.has(Impl::CDHAS_VelocityEstimatedEcef);
+}
+
+inline bool CompositeData::tryGetVelocityEstimatedEcef(math::vec3f& value)
+{
+	if (!hasVelocityEstimatedEcef())
+		return false;
+
+	value = _i.velocityEstimatedEcef;
+
+	return true;
+}
+
+inline math::vec3f CompositeData::velocityEstimatedEcef()
+{
+	math::vec3f value;
+
+	if (!tryGetVelocityEstimatedEcef(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::hasVelocityEstimatedBody()
+{
+	return _i.has(Impl::CDHAS_VelocityEstimatedBody);
+}
+
+inline bool CompositeData::tryGetVelocityEstimatedBody(math::vec3f& value)
+{
+	if (!hasVelocityEstimatedBody())
+		return false;
+
+	value = _i.velocityEstimatedBody;
+
+	return true;
+}
+
+inline math::vec3f CompositeData::velocityEstimatedBody()
+{
+	math::vec3f value;
+
+	if (!tryGetVelocityEstimatedBody(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::hasDeltaTime()
+{
+	return _i.has(Impl::CDHAS_DeltaTime);
+}
+
+inline bool CompositeData::tryGetDeltaTime(float& value)
+{
+	if (!hasDeltaTime())
+		return false;
+
+	value = _i.deltaTime;
+
+	return true;
+}
+
+inline float CompositeData::deltaTime()
+{
+	float value;
+
+	if (!tryGetDeltaTime(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::hasDeltaTheta()
+{
+	return _i.has(Impl::CDHAS_DeltaTheta);
+}
+
+inline bool CompositeData::tryGetDeltaTheta(math::vec3f& value)
+{
+	if (!hasDeltaTheta())
+		return false;
+
+	value = _i.deltaTheta;
+
+	return true;
+}
+
+inline math::vec3f CompositeData::deltaTheta()
+{
+	math::vec3f value;
+
+	if (!tryGetDeltaTheta(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::hasDeltaVelocity()
+{
+	return _i.has(Impl::CDHAS_DeltaVelocity);
+}
+
+inline bool CompositeData::tryGetDeltaVelocity(math::vec3f& value)
+{
+	if (!hasDeltaVelocity())
+		return false;
+
+	value = _i.deltaVelocity;
+
+	return true;
+}
+
+inline math::vec3f CompositeData::deltaVelocity()
+{
+	math::vec3f value;
+
+	if (!tryGetDeltaVelocity(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::hasTimeStartup()
+{
+	return _i.has(Impl::CDHAS_TimeStartup);
+}
+
+inline bool CompositeData::tryGetTimeStartup(uint64_t& value)
+{
+	if (!hasTimeStartup())
+		return false;
+
+	value = _i.timeStartup;
+
+	return true;
+}
+
+inline uint64_t CompositeData::timeStartup()
+{
+	uint64_t value;
+
+	if (!tryGetTimeStartup(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::hasTimeGps()
+{
+	return _i.has(Impl::CDHAS_TimeGps);
+}
+
+inline bool CompositeData::hasTimeGps2()
+{
+	return _i.has(Impl::CDHAS_TimeGps2);
+}
+
+inline bool CompositeData::tryGetTimeGps(uint64_t& value)
+{
+	if (!hasTimeGps())
+		return false;
+
+	value = _i.timeGps;
+
+	return true;
+}
+
+inline uint64_t CompositeData::timeGps()
+{
+	uint64_t value;
+
+	if (!tryGetTimeGps(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::tryGetTimeGps2(uint64_t& value)
+{
+	if (!hasTimeGps2())
+		return false;
+
+	value = _i.timeGps2;
+
+	return true;
+}
+
+inline uint64_t CompositeData::timeGps2()
+{
+	uint64_t value;
+
+	if (!tryGetTimeGps2(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::hasTow()
+{
+	return _i.has(Impl::CDHAS_Tow);
+}
+
+inline bool CompositeData::tryGetTow(double& value)
+{
+	if (!hasTow())
+		return false;
+
+	value = _i.tow;
+
+	return true;
+}
+
+inline double CompositeData::tow()
+{
+	double value;
+
+	if (!tryGetTow(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::hasWeek()
+{
+	return _i.has(Impl::CDHAS_Week);
+}
+
+inline bool CompositeData::tryGetWeek(uint16_t& value)
+{
+	if (!hasWeek())
+		return false;
+
+	value = _i.week;
+
+	return true;
+}
+
+inline uint16_t CompositeData::week()
+{
+	uint16_t value;
+
+	if (!tryGetWeek(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::hasNumSats()
+{
+	return _i.has(Impl::CDHAS_NumSats);
+}
+
+inline bool CompositeData::tryGetNumSats(uint8_t& value)
+{
+	if (!hasNumSats())
+		return false;
+
+	value = _i.numSats;
+
+	return true;
+}
+
+inline uint8_t CompositeData::numSats()
+{
+	uint8_t value;
+
+	if (!tryGetNumSats(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::hasTimeSyncIn()
+{
+	return _i.has(Impl::CDHAS_TimeSyncIn);
+}
+
+inline bool CompositeData::tryGetTimeSyncIn(uint64_t& value)
+{
+	if (!hasTimeSyncIn())
+		return false;
+
+	value = _i.timeSyncIn;
+
+	return true;
+}
+
+inline uint64_t CompositeData::timeSyncIn()
+{
+	uint64_t value;
+
+	if (!tryGetTimeSyncIn(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::hasVpeStatus()
+{
+	return _i.has(Impl::CDHAS_VpeStatus);
+}
+
+inline bool CompositeData::tryGetVpeStatus(protocol::uart::VpeStatus& value)
+{
+	if (!hasVpeStatus())
+		return false;
+
+	value = _i.vpeStatus;
+
+	return true;
+}
+
+inline protocol::uart::VpeStatus CompositeData::vpeStatus()
+{
+	protocol::uart::VpeStatus value;
+
+	if (!tryGetVpeStatus(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::hasInsStatus()
+{
+	return _i.has(Impl::CDHAS_InsStatus);
+}
+
+inline bool CompositeData::tryGetInsStatus(protocol::uart::InsStatus& value)
+{
+	if (!hasInsStatus())
+		return false;
+
+	value = _i.insStatus;
+
+	return true;
+}
+
+inline protocol::uart::InsStatus CompositeData::insStatus()
+{
+	protocol::uart::InsStatus value;
+
+	if (!tryGetInsStatus(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::hasSyncInCnt()
+{
+	return _i.has(Impl::CDHAS_SyncInCnt);
+}
+
+inline bool CompositeData::tryGetSyncInCnt(uint32_t& value)
+{
+	if (!hasSyncInCnt())
+		return false;
+
+	value = _i.syncInCnt;
+
+	return true;
+}
+
+inline uint32_t CompositeData::syncInCnt()
+{
+	uint32_t value;
+
+	if (!tryGetSyncInCnt(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::hasSyncOutCnt()
+{
+	return _i.has(Impl::CDHAS_SyncOutCnt);
+}
+
+inline bool CompositeData::tryGetSyncOutCnt(uint32_t& value)
+{
+	if (!hasSyncOutCnt())
+		return false;
+
+	value = _i.syncOutCnt;
+
+	return true;
+}
+
+inline uint32_t CompositeData::syncOutCnt()
+{
+	uint32_t value;
+
+	if (!tryGetSyncOutCnt(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::hasTimeStatus()
+{
+	return _i.has(Impl::CDHAS_TimeStatus);
+}
+
+inline bool CompositeData::tryGetTimeStatus(uint8_t& value)
+{
+	if (!hasTimeStatus())
+		return false;
+
+	value = _i.timeStatus;
+
+	return true;
+}
+
+inline uint8_t CompositeData::timeStatus()
+{
+	uint8_t value;
+
+	if (!tryGetTimeStatus(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::hasTimeGpsPps()
+{
+	return _i.has(Impl::CDHAS_TimeGpsPps);
+}
+
+inline bool CompositeData::hasTimeGps2Pps()
+{
+	return _i.has(Impl::CDHAS_TimeGps2Pps);
+}
+
+inline bool CompositeData::tryGetTimeGpsPps(uint64_t& value)
+{
+	if (!hasTimeGpsPps())
+		return false;
+
+	value = _i.timeGpsPps;
+
+	return true;
+}
+
+inline uint64_t CompositeData::timeGpsPps()
+{
+	uint64_t value;
+
+	if (!tryGetTimeGpsPps(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::tryGetTimeGps2Pps(uint64_t& value)
+{
+	if (!hasTimeGps2Pps())
+		return false;
+
+	value = _i.timeGps2Pps;
+
+	return true;
+}
+
+inline uint64_t CompositeData::timeGps2Pps()
+{
+	uint64_t value;
+
+	if (!tryGetTimeGps2Pps(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::hasGpsTow()
+{
+	return _i.has(Impl::CDHAS_GpsTow);
+}
+
+inline bool CompositeData::hasGps2Tow()
+{
+	return _i.has(Impl::CDHAS_Gps2Tow);
+}
+
+inline bool CompositeData::tryGetGpsTow(uint64_t& value)
+{
+	if (!hasGpsTow())
+		return false;
+
+	value = _i.gpsTow;
+
+	return true;
+}
+
+inline uint64_t CompositeData::gpsTow()
+{
+	uint64_t value;
+
+	if (!tryGetGpsTow(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::tryGetGps2Tow(uint64_t& value)
+{
+	if (!hasGps2Tow())
+		return false;
+
+	value = _i.gps2Tow;
+
+	return true;
+}
+
+inline uint64_t CompositeData::gps2Tow()
+{
+	uint64_t value;
+
+	if (!tryGetGps2Tow(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::hasTimeUtc()
+{
+	return _i.has(Impl::CDHAS_TimeUtc);
+}
+
+inline bool CompositeData::tryGetTimeUtc(protocol::uart::TimeUtc& value)
+{
+	if (!hasTimeUtc())
+		return false;
+
+	value = _i.timeUtc;
+
+	return true;
+}
+
+inline protocol::uart::TimeUtc CompositeData::timeUtc()
+{
+	protocol::uart::TimeUtc value;
+
+	if (!tryGetTimeUtc(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::hasSensSat()
+{
+	return _i.has(Impl::CDHAS_SensSat);
+}
+
+inline bool CompositeData::tryGetSensSat(protocol::uart::SensSat& value)
+{
+	if (!hasSensSat())
+		return false;
+
+	value = _i.sensSat;
+
+	return true;
+}
+
+inline protocol::uart::SensSat CompositeData::sensSat()
+{
+	protocol::uart::SensSat value;
+
+	if (!tryGetSensSat(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::hasFix()
+{
+	return _i.has(Impl::CDHAS_Fix);
+}
+
+inline bool CompositeData::hasFix2()
+{
+	return _i.has(Impl::CDHAS_Fix2);
+}
+
+inline bool CompositeData::tryGetFix(protocol::uart::GpsFix& value)
+{
+	if (!hasFix())
+		return false;
+
+	value = _i.fix;
+
+	return true;
+}
+
+inline protocol::uart::GpsFix CompositeData::fix()
+{
+	protocol::uart::GpsFix value;
+
+	if (!tryGetFix(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::tryGetFix2(protocol::uart::GpsFix& value)
+{
+	if (!hasFix2())
+		return false;
+
+	value = _i.fix2;
+
+	return true;
+}
+
+inline protocol::uart::GpsFix CompositeData::fix2()
+{
+	protocol::uart::GpsFix value;
+
+	if (!tryGetFix2(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::hasPositionUncertaintyGpsNed()
+{
+	return _i.has(Impl::CDHAS_PositionUncertaintyGpsNed);
+}
+
+inline bool CompositeData::hasPositionUncertaintyGps2Ned()
+{
+	return _i.has(Impl::CDHAS_PositionUncertaintyGps2Ned);
+}
+
+inline bool CompositeData::tryGetPositionUncertaintyGpsNed(math::vec3f& value)
+{
+	if (!hasPositionUncertaintyGpsNed())
+		return false;
+
+	value = _i.positionUncertaintyGpsNed;
+
+	return true;
+}
+
+inline math::vec3f CompositeData::positionUncertaintyGpsNed()
+{
+	math::vec3f value;
+
+	if (!tryGetPositionUncertaintyGpsNed(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::tryGetPositionUncertaintyGps2Ned(math::vec3f& value)
+{
+	if (!hasPositionUncertaintyGps2Ned())
+		return false;
+
+	value = _i.positionUncertaintyGps2Ned;
+
+	return true;
+}
+
+inline math::vec3f CompositeData::positionUncertaintyGps2Ned()
+{
+	math::vec3f value;
+
+	if (!tryGetPositionUncertaintyGps2Ned(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::hasPositionUncertaintyGpsEcef()
+{
+	return _i.has(Impl::CDHAS_PositionUncertaintyGpsEcef);
+}
+
+inline bool CompositeData::hasPositionUncertaintyGps2Ecef()
+{
+	return _i.has(Impl::CDHAS_PositionUncertaintyGps2Ecef);
+}
+
+inline bool CompositeData::tryGetPositionUncertaintyGpsEcef(math::vec3f& value)
+{
+	if (!hasPositionUncertaintyGpsEcef())
+		return false;
+
+	value = _i.positionUncertaintyGpsEcef;
+
+	return true;
+}
+
+inline math::vec3f CompositeData::positionUncertaintyGpsEcef()
+{
+	math::vec3f value;
+
+	if (!tryGetPositionUncertaintyGpsEcef(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::tryGetPositionUncertaintyGps2Ecef(math::vec3f& value)
+{
+	if (!hasPositionUncertaintyGps2Ecef())
+		return false;
+
+	value = _i.positionUncertaintyGps2Ecef;
+
+	return true;
+}
+
+inline math::vec3f CompositeData::positionUncertaintyGps2Ecef()
+{
+	math::vec3f value;
+
+	if (!tryGetPositionUncertaintyGps2Ecef(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::hasPositionUncertaintyEstimated()
+{
+	return _i.has(Impl::CDHAS_PositionUncertaintyEstimated);
+}
+
+inline bool CompositeData::tryGetPositionUncertaintyEstimated(float& value)
+{
+	if (!hasPositionUncertaintyEstimated())
+		return false;
+
+	value = _i.positionUncertaintyEstimated;
+
+	return true;
+}
+
+inline float CompositeData::positionUncertaintyEstimated()
+{
+	float value;
+
+	if (!tryGetPositionUncertaintyEstimated(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::hasVelocityUncertaintyGps()
+{
+	return _i.has(Impl::CDHAS_VelocityUncertaintyGps);
+}
+
+inline bool CompositeData::hasVelocityUncertaintyGps2()
+{
+	return _i.has(Impl::CDHAS_VelocityUncertaintyGps2);
+}
+
+inline bool CompositeData::tryGetVelocityUncertaintyGps(float& value)
+{
+	if (!hasVelocityUncertaintyGps())
+		return false;
+
+	value = _i.velocityUncertaintyGps;
+
+	return true;
+}
+
+inline float CompositeData::velocityUncertaintyGps()
+{
+	float value;
+
+	if (!tryGetVelocityUncertaintyGps(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::tryGetVelocityUncertaintyGps2(float& value)
+{
+	if (!hasVelocityUncertaintyGps2())
+		return false;
+
+	value = _i.velocityUncertaintyGps2;
+
+	return true;
+}
+
+inline float CompositeData::velocityUncertaintyGps2()
+{
+	float value;
+
+	if (!tryGetVelocityUncertaintyGps2(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::hasVelocityUncertaintyEstimated()
+{
+	return _i.has(Impl::CDHAS_VelocityUncertaintyEstimated);
+}
+
+inline bool CompositeData::tryGetVelocityUncertaintyEstimated(float& value)
+{
+	if (!hasVelocityUncertaintyEstimated())
+		return false;
+
+	value = _i.velocityUncertaintyEstimated;
+
+	return true;
+}
+
+inline float CompositeData::velocityUncertaintyEstimated()
+{
+	float value;
+
+	if (!tryGetVelocityUncertaintyEstimated(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::hasTimeUncertainty()
+{
+	return _i.has(Impl::CDHAS_TimeUncertainty);
+}
+
+inline bool CompositeData::tryGetTimeUncertainty(uint32_t& value)
+{
+	if (!hasTimeUncertainty())
+		return false;
+
+	value = _i.timeUncertainty;
+
+	return true;
+}
+
+inline uint32_t CompositeData::timeUncertainty()
+{
+	uint32_t value;
+
+	if (!tryGetTimeUncertainty(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::hasAttitudeUncertainty()
+{
+	return _i.has(Impl::CDHAS_AttitudeUncertainty);
+}
+
+inline bool CompositeData::tryGetAttitudeUncertainty(math::vec3f& value)
+{
+	if (!hasAttitudeUncertainty())
+		return false;
+
+	value = _i.attitudeUncertainty;
+
+	return true;
+}
+
+inline math::vec3f CompositeData::attitudeUncertainty()
+{
+	math::vec3f value;
+
+	if (!tryGetAttitudeUncertainty(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::hasTimeInfo()
+{
+	return _i.has(Impl::CDHAS_TimeInfo);
+}
+
+inline bool CompositeData::tryGetTimeInfo(protocol::uart::TimeInfo& value)
+{
+	if (!hasTimeInfo())
+		return false;
+
+	value = _i.timeInfo;
+
+	return true;
+}
+
+inline protocol::uart::TimeInfo CompositeData::timeInfo()
+{
+	protocol::uart::TimeInfo value;
+
+	if (!tryGetTimeInfo(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::tryGetTimeInfo2(protocol::uart::TimeInfo& value)
+{
+	if (!_i.has(Impl::CDHAS_TimeInfo2))
+		return false;
+
+	value = _i.timeInfo2;
+
+	return true;
+}
+
+inline protocol::uart::TimeInfo CompositeData::timeInfo2()
+{
+	protocol::uart::TimeInfo value;
+
+	if (!tryGetTimeInfo2(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+inline bool CompositeData::hasDop()
+{
+	return _i.has(Impl::CDHAS_Dop);
+}
+
+inline bool CompositeData::tryGetDop(protocol::uart::GnssDop& value)
+{
+	if (!hasDop())
+		return false;
+
+	value = _i.dop;
+
+	return true;
+}
+
+inline protocol::uart::GnssDop CompositeData::dop()
+{
+	protocol::uart::GnssDop value;
+
+	if (!tryGetDop(value))
+		throw invalid_operation();
+
+	return value;
+}
+
 }
 }
 
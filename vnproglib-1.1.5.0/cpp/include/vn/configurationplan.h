@@ -0,0 +1,139 @@
+/// \file
+/// {COMMON_HEADER}
+///
+/// \section DESCRIPTION
+/// This header file provides the ConfigurationPlan class which applies a set
+/// of register values to a sensor only when they are not already in place.
+#ifndef _VNSENSORS_CONFIGURATIONPLAN_H_
+#define _VNSENSORS_CONFIGURATIONPLAN_H_
+
+#include <string>
+
+#include "int.h"
+#include "export.h"
+#include "nocopy.h"
+#include "registers.h"
+#include "vector.h"
+
+namespace vn {
+namespace sensors {
+
+class VnSensor;
+
+/// \brief What \ref ConfigurationPlan::apply found on the sensor.
+enum PlanOutcome
+{
+	PLANOUTCOME_UNCHANGED,		///< The User Tag matched, so nothing was written.
+	PLANOUTCOME_TAGREFRESHED,	///< The registers already held the plan, so only the User Tag was written.
+	PLANOUTCOME_APPLIED			///< At least one register was written.
+};
+
+/// \brief The register values a sensor should be configured with.
+///
+/// The plan is identified by a fingerprint computed from the values it
+/// holds. \ref apply stores the fingerprint in the sensor's User Tag register
+/// along with the settings, so on later connections a sensor which already
+/// holds the plan is recognized with a single read instead of being
+/// reconfigured. The User Tag register is therefore reserved for the plan.
+///
+/// Registers which are not part of the plan are left as they are.
+class vn_proglib_DLLEXPORT ConfigurationPlan : private util::NoCopy
+{
+public:
+
+	ConfigurationPlan();
+
+	~ConfigurationPlan();
+
+	/// \brief Sets the value of the Async Data Output Type register.
+	///
+	/// \param[in] ador The register's ADOR field.
+	void setAsyncDataOutputType(protocol::uart::AsciiAsync ador);
+
+	/// \brief Sets the value of the Async Data Output Frequency register.
+	///
+	/// \param[in] adof The register's ADOF field.
+	void setAsyncDataOutputFrequency(uint32_t adof);
+
+	/// \brief Sets the value of the IMU Rate Configuration register.
+	///
+	/// \param[in] fields The register's values.
+	void setImuRateConfiguration(ImuRateConfigurationRegister &fields);
+
+	/// \brief Sets the value of the VPE Basic Control register.
+	///
+	/// \param[in] fields The register's values.
+	void setVpeBasicControl(VpeBasicControlRegister &fields);
+
+	/// \brief Sets the value of the INS Basic Configuration register for a
+	///     VN-300.
+	///
+	/// \param[in] fields The register's values.
+	void setInsBasicConfigurationVn300(InsBasicConfigurationRegisterVn300 &fields);
+
+	/// \brief Sets the value of the Magnetometer Calibration Control register.
+	///
+	/// \param[in] fields The register's values.
+	void setMagnetometerCalibrationControl(MagnetometerCalibrationControlRegister &fields);
+
+	/// \brief Sets the value of the GPS Antenna Offset register.
+	///
+	/// \param[in] position The register's Position field.
+	void setGpsAntennaOffset(math::vec3f position);
+
+	/// \brief Sets the value of the GPS Compass Baseline register.
+	///
+	/// \param[in] fields The register's values.
+	void setGpsCompassBaseline(GpsCompassBaselineRegister &fields);
+
+	/// \brief Sets the value of the Binary Output 1 register.
+	///
+	/// \param[in] fields The register's values.
+	void setBinaryOutput1(BinaryOutputRegister &fields);
+
+	/// \brief Sets the value of the Binary Output 2 register.
+	///
+	/// \param[in] fields The register's values.
+	void setBinaryOutput2(BinaryOutputRegister &fields);
+
+	/// \brief Sets the value of the Binary Output 3 register.
+	///
+	/// \param[in] fields The register's values.
+	void setBinaryOutput3(BinaryOutputRegister &fields);
+
+	/// \brief Returns the fingerprint of the values in the plan, as stored in
+	///     the User Tag register.
+	///
+	/// The fingerprint does not depend on the order the values were set in.
+	///
+	/// \return The fingerprint.
+	std::string fingerprint() const;
+
+	/// \brief Configures a sensor with the plan unless it already holds it.
+	///
+	/// If the sensor's User Tag matches \ref fingerprint, nothing else is
+	/// read or written, so the registers are not checked at all. A register
+	/// changed by another tool since the plan was applied is therefore not
+	/// corrected; clear the User Tag to have the plan checked again.
+	///
+	/// Otherwise the registers in the plan are read in one pipelined batch,
+	/// those holding different values are written, and the fingerprint is
+	/// written to the User Tag before the settings are saved to non-volatile
+	/// memory. The tag and settings are written even if every register
+	/// already held its value.
+	///
+	/// \param[in] sensor The connected sensor.
+	/// \param[out] numOfRegistersWritten If not NULL, receives the number of
+	///     registers written, not counting the User Tag.
+	/// \return What was found on the sensor.
+	PlanOutcome apply(VnSensor& sensor, size_t* numOfRegistersWritten = NULL);
+
+private:
+	struct Impl;
+	Impl* _pi;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,53 @@
+/// \file
+/// {COMMON_HEADER}
+///
+/// \section DESCRIPTION
+/// This header file provides the class Cpu.
+#ifndef _VNXPLAT_CPU_H_
+#define _VNXPLAT_CPU_H_
+
+#include "export.h"
+
+namespace vn {
+namespace xplat {
+
+/// \brief Provides information about the instruction set extensions supported
+///     by the processor the library is running on.
+///
+/// The processor is only queried once, the first time any of the methods are
+/// called. On non-x86 processors all of the methods return false.
+class vn_proglib_DLLEXPORT Cpu
+{
+
+	// Public Methods /////////////////////////////////////////////////////////
+
+public:
+
+	/// \brief Indicates if the processor supports SSE2 instructions.
+	///
+	/// \return <c>true</c> if SSE2 is supported; otherwise <c>false</c>.
+	static bool hasSse2();
+
+	/// \brief Indicates if the processor and operating system support AVX2
+	///     instructions.
+	///
+	/// \return <c>true</c> if AVX2 is supported; otherwise <c>false</c>.
+	static bool hasAvx2();
+
+	/// \brief Indicates if the processor supports SSSE3 instructions.
+	///
+	/// \return <c>true</c> if SSSE3 is supported; otherwise <c>false</c>.
+	static bool hasSsse3();
+
+	/// \brief Indicates if the processor supports the carry-less multiply
+	///     (PCLMULQDQ) instruction.
+	///
+	/// \return <c>true</c> if PCLMULQDQ is supported; otherwise <c>false</c>.
+	static bool hasPclmul();
+
+};
+
+}
+}
+
+#endif
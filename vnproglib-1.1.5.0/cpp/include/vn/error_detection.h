@@ -38,12 +38,30 @@ public:
 
 	/// \brief Computes the 16-bit CRC of the provided data.
 	///
+	/// This is the CRC-16/CCITT (polynomial 0x1021, initial value 0) used by
+	/// the sensor. The fastest implementation supported by the processor is
+	/// selected on first use.
+	///
 	/// \param[in] data The data array to compute the 16-bit CRC for.
 	/// \param[in] length The length of data bytes from the array to compute
 	///     the CRC over.
 	/// \return The computed CRC.
 	static uint16_t compute(const char data[], size_t length);
 
+	/// \brief Continues computing a 16-bit CRC over more data.
+	///
+	/// Computing the CRC over data split into several pieces by calling this
+	/// for each piece in order gives the same result as calling compute over
+	/// all of the data at once.
+	///
+	/// \param[in] crc The CRC computed over the preceding data, or 0 if there
+	///     is no preceding data.
+	/// \param[in] data The data array to continue the 16-bit CRC with.
+	/// \param[in] length The length of data bytes from the array to continue
+	///     the CRC over.
+	/// \return The updated CRC.
+	static uint16_t update(uint16_t crc, const char data[], size_t length);
+
 };
 
 }
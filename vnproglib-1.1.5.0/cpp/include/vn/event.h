@@ -9,6 +9,10 @@ namespace vn {
 namespace xplat {
 
 /// \brief Represents a cross-platform event.
+///
+/// The event resets automatically when a wait returns because of a signal.
+/// A signal made while no thread is waiting is remembered, so the next wait
+/// returns immediately.
 class vn_proglib_DLLEXPORT Event : private util::NoCopy
 {
 
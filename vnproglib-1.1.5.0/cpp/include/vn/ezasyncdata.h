@@ -67,6 +67,10 @@ private:
 	VnSensor* _sensor;
 	xplat::CriticalSection _mainCS, _copyCS;
 	CompositeData _persistentData, _nextData;
+
+	// Holds the data of the packet being handled. Only used by
+	// asyncPacketReceivedHandler so its storage is reused for every packet.
+	CompositeData _receivedData;
 	xplat::Event _newDataEvent;
 };
 
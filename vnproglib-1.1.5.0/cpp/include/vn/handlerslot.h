@@ -0,0 +1,226 @@
+/// \file
+/// {COMMON_HEADER}
+///
+/// \section DESCRIPTION
+/// This header file provides the class HandlerSlot.
+#ifndef _VNXPLAT_HANDLERSLOT_H_
+#define _VNXPLAT_HANDLERSLOT_H_
+
+#include <cstddef>
+
+#include "atomic.h"
+#include "exceptions.h"
+#include "nocopy.h"
+#include "thread.h"
+
+namespace vn {
+namespace xplat {
+
+/// \brief Holds a registered callback handler and its user data so one
+///     thread can call the handler while others register and unregister it,
+///     without locking.
+///
+/// The handler is published through an atomic pointer. A dispatch loads the
+/// pointer and, while the handler runs, leaves the dispatch epoch odd.
+/// Unregistering clears the pointer and then only has to wait if the epoch
+/// shows a dispatch, which may have seen the old handler, is still running.
+/// Once \ref unregisterHandler returns, the handler will not be called again
+/// and its user data may be destroyed.
+///
+/// The epoch write has to be ordered before the pointer is loaded again.
+/// The cost of that ordering is put on the rarely called
+/// \ref unregisterHandler through \ref fenceHeavy, so a dispatch uses plain
+/// loads and stores where the operating system supports it.
+///
+/// Only one thread may dispatch at a time, and \ref unregisterHandler must
+/// not be called from within the handler itself since it would wait for the
+/// handler to return.
+///
+/// Example of dispatching.
+/// \code
+/// HandlerSlot<DataReceivedHandler>::Dispatch dispatch(_dataReceived);
+///
+/// if (dispatch.isRegistered())
+///     dispatch->handler(dispatch->userData);
+/// \endcode
+template <typename Handler>
+class HandlerSlot : private util::NoCopy
+{
+
+	// Types //////////////////////////////////////////////////////////////////
+
+public:
+
+	/// \brief A registered handler along with its user data.
+	struct Registration
+	{
+		Handler handler;
+		void* userData;
+	};
+
+	/// \brief Calls to the registered handler are made through a Dispatch,
+	///     which marks the dispatch as running for its lifetime.
+	class Dispatch : private util::NoCopy
+	{
+	public:
+
+		/// \brief Starts a dispatch.
+		///
+		/// \param[in] slot The slot to dispatch to.
+		explicit Dispatch(HandlerSlot& slot) :
+			_slot(slot),
+			_registration(slot.beginDispatch())
+		{ }
+
+		~Dispatch()
+		{
+			if (_registration != NULL)
+				_slot.endDispatch();
+		}
+
+		/// \brief Indicates if a handler was registered when the dispatch
+		///     started.
+		///
+		/// \return <c>true</c> if a handler is registered; otherwise
+		///     <c>false</c>.
+		bool isRegistered() const
+		{
+			return _registration != NULL;
+		}
+
+		/// \brief Provides access to the registered handler and user data.
+		const Registration* operator->() const
+		{
+			return _registration;
+		}
+
+	private:
+
+		HandlerSlot& _slot;
+		const Registration* _registration;
+	};
+
+	// Constructors ///////////////////////////////////////////////////////////
+
+public:
+
+	/// \brief Creates an empty slot.
+	HandlerSlot() :
+		_registration(NULL),
+		_dispatchEpoch(0)
+	{ }
+
+	~HandlerSlot()
+	{
+		delete _registration.load();
+	}
+
+	// Public Methods /////////////////////////////////////////////////////////
+
+public:
+
+	/// \brief Registers a handler.
+	///
+	/// \param[in] userData Pointer to user data, which will be provided to
+	///     the handler.
+	/// \param[in] handler The handler.
+	/// \exception invalid_operation A handler is already registered.
+	void registerHandler(void* userData, Handler handler)
+	{
+		Registration* registration = new Registration;
+		registration->handler = handler;
+		registration->userData = userData;
+
+		Registration* expected = NULL;
+
+		if (!_registration.compareExchange(expected, registration))
+		{
+			delete registration;
+			throw invalid_operation();
+		}
+	}
+
+	/// \brief Unregisters the handler, waiting for a dispatch to it which is
+	///     in progress to finish.
+	///
+	/// \exception invalid_operation No handler is registered.
+	void unregisterHandler()
+	{
+		Registration* registration = _registration.exchange(NULL);
+
+		if (registration == NULL)
+			throw invalid_operation();
+
+		// Pairs with the fenceLight in beginDispatch. Afterwards either the
+		// dispatch's epoch write is visible here or it will load the cleared
+		// handler.
+		fenceHeavy();
+
+		size_t epoch = _dispatchEpoch.loadAcquire();
+
+		// An odd epoch means a dispatch started before the handler was
+		// cleared and it may still be using the handler. Polling keeps the
+		// dispatch from having to check for a waiting thread when it ends.
+		if (epoch % 2 != 0)
+		{
+			while (_dispatchEpoch.loadAcquire() == epoch)
+				Thread::sleepUs(50);
+		}
+
+		delete registration;
+	}
+
+	/// \brief Indicates if a handler is registered.
+	///
+	/// \return <c>true</c> if a handler is registered; otherwise
+	///     <c>false</c>.
+	bool isRegistered() const
+	{
+		return _registration.loadAcquire() != NULL;
+	}
+
+	// Private Methods ////////////////////////////////////////////////////////
+
+private:
+
+	const Registration* beginDispatch()
+	{
+		// Nothing to publish when there is no handler to call.
+		if (_registration.loadAcquire() == NULL)
+			return NULL;
+
+		size_t epoch = _dispatchEpoch.loadAcquire() + 1;
+
+		// The epoch must be visible before the handler is loaded again so
+		// unregisterHandler either sees the dispatch running or the dispatch
+		// sees the cleared handler.
+		_dispatchEpoch.storeRelease(epoch);
+
+		fenceLight();
+
+		const Registration* registration = _registration.loadAcquire();
+
+		if (registration == NULL)
+			_dispatchEpoch.storeRelease(epoch + 1);
+
+		return registration;
+	}
+
+	void endDispatch()
+	{
+		_dispatchEpoch.storeRelease(_dispatchEpoch.loadAcquire() + 1);
+	}
+
+	// Private Members ////////////////////////////////////////////////////////
+
+private:
+
+	Atomic<Registration*> _registration;
+	Atomic<size_t> _dispatchEpoch;
+
+};
+
+}
+}
+
+#endif
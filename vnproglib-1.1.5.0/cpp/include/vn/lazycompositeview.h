@@ -0,0 +1,614 @@
+/// \file
+/// {COMMON_HEADER}
+///
+/// \section DESCRIPTION
+/// This header file provides the LazyCompositeView class which decodes the
+/// fields of a binary packet on demand.
+#ifndef _VNSENSORS_LAZYCOMPOSITEVIEW_H_
+#define _VNSENSORS_LAZYCOMPOSITEVIEW_H_
+
+#include "int.h"
+#include "export.h"
+#include "nocopy.h"
+#include "exceptions.h"
+#include "vector.h"
+#include "matrix.h"
+#include "types.h"
+#include "packet.h"
+#include "binaryplan.h"
+#include "binarylayout.h"
+
+namespace vn {
+namespace sensors {
+
+/// \brief Provides the data in a binary packet, decoding each field only when
+///     it is asked for.
+///
+/// The accessors have the same names and behave the same as those of
+/// \ref CompositeData, so code reading the data can be written against
+/// either. Where a value can come from more than one group (e.g. the yaw,
+/// pitch, roll is in both the Common and Attitude groups), the value from the
+/// group appearing last in the packet is returned, as it would be by
+/// CompositeData.
+///
+/// The view refers to the packet's data and the cached layout of its header,
+/// so it is only valid while the packet is. Only binary packets are
+/// supported and only the values listed below are available; use
+/// CompositeData for ASCII packets or other values.
+class vn_proglib_DLLEXPORT LazyCompositeView : private util::NoCopy
+{
+public:
+
+	/// \brief Creates a view of a binary packet.
+	///
+	/// \param[in] p The packet. This is typically the
+	///     \ref protocol::uart::PacketView passed to an async packet handler.
+	/// \exception invalid_operation Thrown if the packet is not a binary
+	///     packet or is shorter than its header says it should be.
+	explicit LazyCompositeView(protocol::uart::Packet& p);
+
+	/// \name Time
+	/// \{
+
+	bool hasTimeStartup();
+	uint64_t timeStartup();
+	bool hasTimeGps();
+	uint64_t timeGps();
+	bool hasTimeSyncIn();
+	uint64_t timeSyncIn();
+	bool hasTow();
+	double tow();
+	bool hasWeek();
+	uint16_t week();
+	bool hasTimeGpsPps();
+	uint64_t timeGpsPps();
+	bool hasSyncInCnt();
+	uint32_t syncInCnt();
+
+	/// \}
+
+	/// \name Attitude
+	/// \{
+
+	bool hasYawPitchRoll();
+	math::vec3f yawPitchRoll();
+	bool hasQuaternion();
+	math::vec4f quaternion();
+	bool hasDirectionCosineMatrix();
+	math::mat3f directionCosineMatrix();
+	bool hasVpeStatus();
+	protocol::uart::VpeStatus vpeStatus();
+	bool hasAttitudeUncertainty();
+	math::vec3f attitudeUncertainty();
+
+	/// \}
+
+	/// \name IMU
+	/// \{
+
+	bool hasAngularRate();
+	math::vec3f angularRate();
+	bool hasAcceleration();
+	math::vec3f acceleration();
+	bool hasMagnetic();
+	math::vec3f magnetic();
+	bool hasTemperature();
+	float temperature();
+	bool hasPressure();
+	float pressure();
+	bool hasAccelerationUncompensated();
+	math::vec3f accelerationUncompensated();
+	bool hasAngularRateUncompensated();
+	math::vec3f angularRateUncompensated();
+	bool hasMagneticUncompensated();
+	math::vec3f magneticUncompensated();
+	bool hasDeltaTime();
+	float deltaTime();
+	bool hasDeltaTheta();
+	math::vec3f deltaTheta();
+	bool hasDeltaVelocity();
+	math::vec3f deltaVelocity();
+
+	/// \}
+
+	/// \name INS
+	/// \{
+
+	bool hasInsStatus();
+	protocol::uart::InsStatus insStatus();
+	bool hasPositionEstimatedLla();
+	math::vec3d positionEstimatedLla();
+	bool hasPositionEstimatedEcef();
+	math::vec3d positionEstimatedEcef();
+	bool hasVelocityEstimatedBody();
+	math::vec3f velocityEstimatedBody();
+	bool hasVelocityEstimatedNed();
+	math::vec3f velocityEstimatedNed();
+	bool hasVelocityEstimatedEcef();
+	math::vec3f velocityEstimatedEcef();
+	bool hasAccelerationEcef();
+	math::vec3f accelerationEcef();
+	bool hasPositionUncertaintyEstimated();
+	float positionUncertaintyEstimated();
+	bool hasVelocityUncertaintyEstimated();
+	float velocityUncertaintyEstimated();
+
+	/// \}
+
+	/// \name GPS
+	/// \{
+
+	bool hasGpsTow();
+	uint64_t gpsTow();
+	bool hasNumSats();
+	uint8_t numSats();
+	bool hasFix();
+	protocol::uart::GpsFix fix();
+	bool hasPositionGpsLla();
+	math::vec3d positionGpsLla();
+	bool hasPositionGpsEcef();
+	math::vec3d positionGpsEcef();
+	bool hasVelocityGpsNed();
+	math::vec3f velocityGpsNed();
+	bool hasVelocityGpsEcef();
+	math::vec3f velocityGpsEcef();
+
+	/// \}
+
+private:
+
+	// Indices of the binary groups.
+	enum GroupIndex
+	{
+		COMMON,
+		TIME,
+		IMU,
+		GPS,
+		ATTITUDE,
+		INS
+	};
+
+	// Returns the start of a field or NULL if the packet does not contain it.
+	const char* field(size_t groupIndex, size_t fieldIndex) const
+	{
+		uint16_t offset = _plan->fieldOffsets[protocol::uart::BinaryPlan::code(groupIndex, fieldIndex)];
+
+		return offset == 0 ? NULL : _data + offset;
+	}
+
+	// Returns the start of the first field of the two that is present, or
+	// NULL if neither is.
+	const char* field(size_t groupIndex, size_t fieldIndex, size_t otherGroupIndex, size_t otherFieldIndex) const
+	{
+		const char* f = field(groupIndex, fieldIndex);
+
+		return f != NULL ? f : field(otherGroupIndex, otherFieldIndex);
+	}
+
+	// Returns the start of a value stored at an offset within a field.
+	static const char* within(const char* field, size_t offset)
+	{
+		return field == NULL ? NULL : field + offset;
+	}
+
+	template<typename T>
+	static T read(const char* field)
+	{
+		if (field == NULL)
+			throw invalid_operation();
+
+		return layout::FieldReader<T>::read(field);
+	}
+
+	const char* _data;
+	const protocol::uart::BinaryPlan* _plan;
+
+	// Holds the plan if the header could not be cached.
+	protocol::uart::BinaryPlan _scratch;
+};
+
+inline bool LazyCompositeView::hasTimeStartup()
+{
+	return field(TIME, 0, COMMON, 0) != NULL;
+}
+
+inline uint64_t LazyCompositeView::timeStartup()
+{
+	return read<uint64_t>(field(TIME, 0, COMMON, 0));
+}
+
+inline bool LazyCompositeView::hasTimeGps()
+{
+	return field(TIME, 1, COMMON, 1) != NULL;
+}
+
+inline uint64_t LazyCompositeView::timeGps()
+{
+	return read<uint64_t>(field(TIME, 1, COMMON, 1));
+}
+
+inline bool LazyCompositeView::hasTimeSyncIn()
+{
+	return field(TIME, 4, COMMON, 2) != NULL;
+}
+
+inline uint64_t LazyCompositeView::timeSyncIn()
+{
+	return read<uint64_t>(field(TIME, 4, COMMON, 2));
+}
+
+inline bool LazyCompositeView::hasTow()
+{
+	return field(TIME, 2) != NULL;
+}
+
+inline double LazyCompositeView::tow()
+{
+	// The sensor sends the time of week in nanoseconds.
+	return static_cast<double>(read<uint64_t>(field(TIME, 2))) / 1000000000;
+}
+
+inline bool LazyCompositeView::hasWeek()
+{
+	return field(TIME, 3) != NULL;
+}
+
+inline uint16_t LazyCompositeView::week()
+{
+	return read<uint16_t>(field(TIME, 3));
+}
+
+inline bool LazyCompositeView::hasTimeGpsPps()
+{
+	return field(TIME, 5, COMMON, 14) != NULL;
+}
+
+inline uint64_t LazyCompositeView::timeGpsPps()
+{
+	return read<uint64_t>(field(TIME, 5, COMMON, 14));
+}
+
+inline bool LazyCompositeView::hasSyncInCnt()
+{
+	return field(TIME, 7, COMMON, 13) != NULL;
+}
+
+inline uint32_t LazyCompositeView::syncInCnt()
+{
+	return read<uint32_t>(field(TIME, 7, COMMON, 13));
+}
+
+inline bool LazyCompositeView::hasYawPitchRoll()
+{
+	return field(ATTITUDE, 1, COMMON, 3) != NULL;
+}
+
+inline math::vec3f LazyCompositeView::yawPitchRoll()
+{
+	return read<math::vec3f>(field(ATTITUDE, 1, COMMON, 3));
+}
+
+inline bool LazyCompositeView::hasQuaternion()
+{
+	return field(ATTITUDE, 2, COMMON, 4) != NULL;
+}
+
+inline math::vec4f LazyCompositeView::quaternion()
+{
+	return read<math::vec4f>(field(ATTITUDE, 2, COMMON, 4));
+}
+
+inline bool LazyCompositeView::hasDirectionCosineMatrix()
+{
+	return field(ATTITUDE, 3) != NULL;
+}
+
+inline math::mat3f LazyCompositeView::directionCosineMatrix()
+{
+	return read<math::mat3f>(field(ATTITUDE, 3));
+}
+
+inline bool LazyCompositeView::hasVpeStatus()
+{
+	return field(ATTITUDE, 0, COMMON, 12) != NULL;
+}
+
+inline protocol::uart::VpeStatus LazyCompositeView::vpeStatus()
+{
+	return read<protocol::uart::VpeStatus>(field(ATTITUDE, 0, COMMON, 12));
+}
+
+inline bool LazyCompositeView::hasAttitudeUncertainty()
+{
+	return field(ATTITUDE, 8) != NULL;
+}
+
+inline math::vec3f LazyCompositeView::attitudeUncertainty()
+{
+	return read<math::vec3f>(field(ATTITUDE, 8));
+}
+
+inline bool LazyCompositeView::hasAngularRate()
+{
+	return field(IMU, 10, COMMON, 5) != NULL;
+}
+
+inline math::vec3f LazyCompositeView::angularRate()
+{
+	return read<math::vec3f>(field(IMU, 10, COMMON, 5));
+}
+
+inline bool LazyCompositeView::hasAcceleration()
+{
+	return field(IMU, 9, COMMON, 8) != NULL;
+}
+
+inline math::vec3f LazyCompositeView::acceleration()
+{
+	return read<math::vec3f>(field(IMU, 9, COMMON, 8));
+}
+
+inline bool LazyCompositeView::hasMagnetic()
+{
+	return field(IMU, 8, COMMON, 10) != NULL;
+}
+
+inline math::vec3f LazyCompositeView::magnetic()
+{
+	// The magnetic measurement is at the start of the Common group's MagPres
+	// field.
+	return read<math::vec3f>(field(IMU, 8, COMMON, 10));
+}
+
+inline bool LazyCompositeView::hasTemperature()
+{
+	return field(IMU, 4, COMMON, 10) != NULL;
+}
+
+inline float LazyCompositeView::temperature()
+{
+	const char* f = field(IMU, 4);
+
+	return read<float>(f != NULL ? f : within(field(COMMON, 10), 12));
+}
+
+inline bool LazyCompositeView::hasPressure()
+{
+	return field(IMU, 5, COMMON, 10) != NULL;
+}
+
+inline float LazyCompositeView::pressure()
+{
+	const char* f = field(IMU, 5);
+
+	return read<float>(f != NULL ? f : within(field(COMMON, 10), 16));
+}
+
+inline bool LazyCompositeView::hasAccelerationUncompensated()
+{
+	return field(IMU, 2, COMMON, 9) != NULL;
+}
+
+inline math::vec3f LazyCompositeView::accelerationUncompensated()
+{
+	return read<math::vec3f>(field(IMU, 2, COMMON, 9));
+}
+
+inline bool LazyCompositeView::hasAngularRateUncompensated()
+{
+	return field(IMU, 3, COMMON, 9) != NULL;
+}
+
+inline math::vec3f LazyCompositeView::angularRateUncompensated()
+{
+	const char* f = field(IMU, 3);
+
+	return read<math::vec3f>(f != NULL ? f : within(field(COMMON, 9), 12));
+}
+
+inline bool LazyCompositeView::hasMagneticUncompensated()
+{
+	return field(IMU, 1) != NULL;
+}
+
+inline math::vec3f LazyCompositeView::magneticUncompensated()
+{
+	return read<math::vec3f>(field(IMU, 1));
+}
+
+inline bool LazyCompositeView::hasDeltaTime()
+{
+	return field(IMU, 6, COMMON, 11) != NULL;
+}
+
+inline float LazyCompositeView::deltaTime()
+{
+	return read<float>(field(IMU, 6, COMMON, 11));
+}
+
+inline bool LazyCompositeView::hasDeltaTheta()
+{
+	return field(IMU, 6, COMMON, 11) != NULL;
+}
+
+inline math::vec3f LazyCompositeView::deltaTheta()
+{
+	return read<math::vec3f>(within(field(IMU, 6, COMMON, 11), 4));
+}
+
+inline bool LazyCompositeView::hasDeltaVelocity()
+{
+	return field(IMU, 7, COMMON, 11) != NULL;
+}
+
+inline math::vec3f LazyCompositeView::deltaVelocity()
+{
+	const char* f = field(IMU, 7);
+
+	return read<math::vec3f>(f != NULL ? f : within(field(COMMON, 11), 16));
+}
+
+inline bool LazyCompositeView::hasInsStatus()
+{
+	return field(INS, 0, COMMON, 12) != NULL;
+}
+
+inline protocol::uart::InsStatus LazyCompositeView::insStatus()
+{
+	return read<protocol::uart::InsStatus>(field(INS, 0, COMMON, 12));
+}
+
+inline bool LazyCompositeView::hasPositionEstimatedLla()
+{
+	return field(INS, 1, COMMON, 6) != NULL;
+}
+
+inline math::vec3d LazyCompositeView::positionEstimatedLla()
+{
+	return read<math::vec3d>(field(INS, 1, COMMON, 6));
+}
+
+inline bool LazyCompositeView::hasPositionEstimatedEcef()
+{
+	return field(INS, 2) != NULL;
+}
+
+inline math::vec3d LazyCompositeView::positionEstimatedEcef()
+{
+	return read<math::vec3d>(field(INS, 2));
+}
+
+inline bool LazyCompositeView::hasVelocityEstimatedBody()
+{
+	return field(INS, 3) != NULL;
+}
+
+inline math::vec3f LazyCompositeView::velocityEstimatedBody()
+{
+	return read<math::vec3f>(field(INS, 3));
+}
+
+inline bool LazyCompositeView::hasVelocityEstimatedNed()
+{
+	return field(INS, 4, COMMON, 7) != NULL;
+}
+
+inline math::vec3f LazyCompositeView::velocityEstimatedNed()
+{
+	return read<math::vec3f>(field(INS, 4, COMMON, 7));
+}
+
+inline bool LazyCompositeView::hasVelocityEstimatedEcef()
+{
+	return field(INS, 5) != NULL;
+}
+
+inline math::vec3f LazyCompositeView::velocityEstimatedEcef()
+{
+	return read<math::vec3f>(field(INS, 5));
+}
+
+inline bool LazyCompositeView::hasAccelerationEcef()
+{
+	return field(INS, 7) != NULL;
+}
+
+inline math::vec3f LazyCompositeView::accelerationEcef()
+{
+	return read<math::vec3f>(field(INS, 7));
+}
+
+inline bool LazyCompositeView::hasPositionUncertaintyEstimated()
+{
+	return field(INS, 9) != NULL;
+}
+
+inline float LazyCompositeView::positionUncertaintyEstimated()
+{
+	return read<float>(field(INS, 9));
+}
+
+inline bool LazyCompositeView::hasVelocityUncertaintyEstimated()
+{
+	return field(INS, 10) != NULL;
+}
+
+inline float LazyCompositeView::velocityUncertaintyEstimated()
+{
+	return read<float>(field(INS, 10));
+}
+
+inline bool LazyCompositeView::hasGpsTow()
+{
+	return field(GPS, 1) != NULL;
+}
+
+inline uint64_t LazyCompositeView::gpsTow()
+{
+	return read<uint64_t>(field(GPS, 1));
+}
+
+inline bool LazyCompositeView::hasNumSats()
+{
+	return field(GPS, 3) != NULL;
+}
+
+inline uint8_t LazyCompositeView::numSats()
+{
+	return read<uint8_t>(field(GPS, 3));
+}
+
+inline bool LazyCompositeView::hasFix()
+{
+	return field(GPS, 4) != NULL;
+}
+
+inline protocol::uart::GpsFix LazyCompositeView::fix()
+{
+	return read<protocol::uart::GpsFix>(field(GPS, 4));
+}
+
+inline bool LazyCompositeView::hasPositionGpsLla()
+{
+	return field(GPS, 5) != NULL;
+}
+
+inline math::vec3d LazyCompositeView::positionGpsLla()
+{
+	return read<math::vec3d>(field(GPS, 5));
+}
+
+inline bool LazyCompositeView::hasPositionGpsEcef()
+{
+	return field(GPS, 6) != NULL;
+}
+
+inline math::vec3d LazyCompositeView::positionGpsEcef()
+{
+	return read<math::vec3d>(field(GPS, 6));
+}
+
+inline bool LazyCompositeView::hasVelocityGpsNed()
+{
+	return field(GPS, 7) != NULL;
+}
+
+inline math::vec3f LazyCompositeView::velocityGpsNed()
+{
+	return read<math::vec3f>(field(GPS, 7));
+}
+
+inline bool LazyCompositeView::hasVelocityGpsEcef()
+{
+	return field(GPS, 8) != NULL;
+}
+
+inline math::vec3f LazyCompositeView::velocityGpsEcef()
+{
+	return read<math::vec3f>(field(GPS, 8));
+}
+
+}
+}
+
+#endif
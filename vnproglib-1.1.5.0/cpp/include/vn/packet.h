@@ -55,6 +55,16 @@ struct vn_proglib_DLLEXPORT Packet
 	/// \return The packet data.
 	std::string datastr();
 
+	/// \brief Returns a pointer to the encapsulated data without copying it.
+	///
+	/// \return The packet data, including the sync byte and checksum.
+	char const* data() const;
+
+	/// \brief Returns the number of bytes in the packet.
+	///
+	/// \return The packet length.
+	size_t length() const;
+
 	/// \brief Returns the type of packet.
 	///
 	/// \return The type of packet.
@@ -69,6 +79,13 @@ struct vn_proglib_DLLEXPORT Packet
 	///     otherwise <c>false</c>.
 	bool isValid();
 
+	/// \brief Records that the packet's data integrity has already been
+	///     checked so later calls to \ref isValid return immediately.
+	///
+	/// PacketFinder uses this for binary packets since it computes their CRC
+	/// while the data is being received.
+	void markAsValid();
+
 	/// \brief Indicates if the packet is an ASCII error message.
 	///
 	/// \return <c>true</c> if the packet is an error message; otherwise
@@ -154,60 +171,140 @@ struct vn_proglib_DLLEXPORT Packet
 	/// \return The extracted value.
 	uint8_t extractUint8();
 
+	/// \brief Extracts a uint8_t data type from a binary packet without throwing
+	/// an exception and advances the next extraction point appropriately.
+	///
+	/// \param[out] value The extracted value.
+	/// \return <c>true</c> if the value was extracted; <c>false</c> if the
+	///     packet does not hold enough data, in which case nothing is advanced.
+	bool tryExtractUint8(uint8_t& value);
+
 	/// \brief Extracts a int8_t data type from a binary packet and advances
 	/// the next extraction point appropriately.
 	///
 	/// \return The extracted value.
 	int8_t extractInt8();
 
+	/// \brief Extracts a int8_t data type from a binary packet without throwing
+	/// an exception and advances the next extraction point appropriately.
+	///
+	/// \param[out] value The extracted value.
+	/// \return <c>true</c> if the value was extracted; <c>false</c> if the
+	///     packet does not hold enough data, in which case nothing is advanced.
+	bool tryExtractInt8(int8_t& value);
+
 	/// \brief Extracts a uint16_t data type from a binary packet and advances
 	/// the next extraction point appropriately.
 	///
 	/// \return The extracted value.
 	uint16_t extractUint16();
 
+	/// \brief Extracts a uint16_t data type from a binary packet without throwing
+	/// an exception and advances the next extraction point appropriately.
+	///
+	/// \param[out] value The extracted value.
+	/// \return <c>true</c> if the value was extracted; <c>false</c> if the
+	///     packet does not hold enough data, in which case nothing is advanced.
+	bool tryExtractUint16(uint16_t& value);
+
 	/// \brief Extracts a uint32_t data type from a binary packet and advances
 	/// the next extraction point appropriately.
 	///
 	/// \return The extracted value.
 	uint32_t extractUint32();
 
+	/// \brief Extracts a uint32_t data type from a binary packet without throwing
+	/// an exception and advances the next extraction point appropriately.
+	///
+	/// \param[out] value The extracted value.
+	/// \return <c>true</c> if the value was extracted; <c>false</c> if the
+	///     packet does not hold enough data, in which case nothing is advanced.
+	bool tryExtractUint32(uint32_t& value);
+
 	/// \brief Extracts a uint64_t data type from a binary packet and advances
 	/// the next extraction point appropriately.
 	///
 	/// \return The extracted value.
 	uint64_t extractUint64();
 
+	/// \brief Extracts a uint64_t data type from a binary packet without throwing
+	/// an exception and advances the next extraction point appropriately.
+	///
+	/// \param[out] value The extracted value.
+	/// \return <c>true</c> if the value was extracted; <c>false</c> if the
+	///     packet does not hold enough data, in which case nothing is advanced.
+	bool tryExtractUint64(uint64_t& value);
+
 	/// \brief Extracts a float fdata type from a binary packet and advances
 	/// the next extraction point appropriately.
 	///
 	/// \return The extracted value.
 	float extractFloat();
 
+	/// \brief Extracts a float data type from a binary packet without throwing
+	/// an exception and advances the next extraction point appropriately.
+	///
+	/// \param[out] value The extracted value.
+	/// \return <c>true</c> if the value was extracted; <c>false</c> if the
+	///     packet does not hold enough data, in which case nothing is advanced.
+	bool tryExtractFloat(float& value);
+
 	/// \brief Extracts a vec3f data type from a binary packet and advances
 	/// the next extraction point appropriately.
 	///
 	/// \return The extracted value.
 	vn::math::vec3f extractVec3f();
 
+	/// \brief Extracts a vec3f data type from a binary packet without throwing
+	/// an exception and advances the next extraction point appropriately.
+	///
+	/// \param[out] value The extracted value.
+	/// \return <c>true</c> if the value was extracted; <c>false</c> if the
+	///     packet does not hold enough data, in which case nothing is advanced.
+	bool tryExtractVec3f(vn::math::vec3f& value);
+
 	/// \brief Extracts a vec3d data type from a binary packet and advances
 	/// the next extraction point appropriately.
 	///
 	/// \return The extracted value.
 	vn::math::vec3d extractVec3d();
 
+	/// \brief Extracts a vec3d data type from a binary packet without throwing
+	/// an exception and advances the next extraction point appropriately.
+	///
+	/// \param[out] value The extracted value.
+	/// \return <c>true</c> if the value was extracted; <c>false</c> if the
+	///     packet does not hold enough data, in which case nothing is advanced.
+	bool tryExtractVec3d(vn::math::vec3d& value);
+
 	/// \brief Extracts a vec4f data type from a binary packet and advances
 	/// the next extraction point appropriately.
 	///
 	/// \return The extracted value.
 	vn::math::vec4f extractVec4f();
 
+	/// \brief Extracts a vec4f data type from a binary packet without throwing
+	/// an exception and advances the next extraction point appropriately.
+	///
+	/// \param[out] value The extracted value.
+	/// \return <c>true</c> if the value was extracted; <c>false</c> if the
+	///     packet does not hold enough data, in which case nothing is advanced.
+	bool tryExtractVec4f(vn::math::vec4f& value);
+
 	/// \brief Extract a mat3f data type from a binary packet and advances
 	/// the next extraction point appropriately.
 	///
 	/// \return The extracted value.
 	vn::math::mat3f extractMat3f();
 
+	/// \brief Extracts a mat3f data type from a binary packet without throwing
+	/// an exception and advances the next extraction point appropriately.
+	///
+	/// \param[out] value The extracted value.
+	/// \return <c>true</c> if the value was extracted; <c>false</c> if the
+	///     packet does not hold enough data, in which case nothing is advanced.
+	bool tryExtractMat3f(vn::math::mat3f& value);
+
 	/// \}
 
 	/// \brief Appends astrick (*), checksum, and newlines to command.
@@ -2096,12 +2193,59 @@ struct vn_proglib_DLLEXPORT Packet
 
 private:
 
+	/// \brief What a packet is, as determined by \ref classify.
+	enum Kind
+	{
+		KIND_UNCLASSIFIED,	///< The packet has not been classified yet.
+		KIND_OTHER,			///< Binary or unrecognized packet.
+		KIND_ERROR,			///< ASCII error message.
+		KIND_RESPONSE,		///< ASCII response message.
+		KIND_ASCII_ASYNC	///< ASCII asynchronous message.
+	};
+
+	bool canExtract(size_t numOfBytes);
 	void ensureCanExtract(size_t numOfBytes);
 
+	/// \brief Determines the kind of packet from its header and stores it so
+	///     later queries do not have to look at the header again.
+	void classify();
+
+protected:
+
 	bool _isPacketDataMine;
 	size_t _length;
 	char *_data;
 	size_t _curExtractLoc;
+	bool _isKnownValid;
+	uint8_t _kind;
+	uint8_t _asciiAsyncType;
+};
+
+/// \brief Non-owning view of packet data held in someone else's buffer.
+///
+/// A PacketView can be used anywhere a Packet is accepted but is only valid
+/// while the buffer it refers to is. PacketFinder hands packets to its
+/// handler as views directly over its receive buffers so no copy is made per
+/// packet. Copying a PacketView into a Packet takes ownership of a copy
+/// of the data, which must be done for any packet that has to outlive the
+/// callback it was received in.
+struct vn_proglib_DLLEXPORT PacketView : public Packet
+{
+	/// \brief Creates a view of the provided packet data without copying it.
+	///
+	/// \param[in] packet Pointer to buffer containing the packet.
+	/// \param[in] length The number of bytes in the packet.
+	PacketView(char const* packet, size_t length);
+
+	/// \brief Copy constructor. The new view refers to the same data.
+	///
+	/// \param[in] toCopy The PacketView to copy.
+	PacketView(const PacketView &toCopy);
+
+private:
+
+	// Assigning to a view is not supported.
+	PacketView& operator=(const PacketView &from);
 };
 
 }
@@ -30,6 +30,10 @@ public:
 	/// \brief Defines the signature for a method that can receive
 	/// notifications of new valid packets found.
 	///
+	/// The packet may be a \ref PacketView over the finder's buffers and is
+	/// only valid until the callback returns. Copy it into a Packet to keep
+	/// it longer.
+	///
 	/// \param[in] userData Pointer to user data that was initially supplied
 	///     when the callback was registered via registerPossiblePacketFoundHandler.
 	/// \param[in] possiblePacket The possible packet that was found.
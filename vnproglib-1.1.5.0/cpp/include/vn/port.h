@@ -64,6 +64,11 @@ public:
 	virtual void registerDataReceivedHandler(void* userData, DataReceivedHandler handler) = 0;
 
 	/// \brief Unregisters the registered callback method.
+	///
+	/// Waits for a call to the handler in progress on another thread to
+	/// return, after which the handler is not called again and its user data
+	/// may be destroyed. Must not be called from within the handler itself,
+	/// since it would wait on itself forever.
 	virtual void unregisterDataReceivedHandler() = 0;
 
 	#if PYTHON && !PL156_ORIGINAL && !PL156_FIX_ATTEMPT_1
@@ -54,6 +54,16 @@ private:
 	char *_errorMessage;
 };
 
+/// \brief The outcome of a transaction with a VectorNav sensor, as returned by
+/// the methods which report failures without throwing an exception.
+enum TransactionStatus
+{
+	TRANSACTIONSTATUS_OK,			///< The response was received.
+	TRANSACTIONSTATUS_NOTCONNECTED,	///< The VnSensor is not connected.
+	TRANSACTIONSTATUS_TIMEOUT,		///< No response was received in time.
+	TRANSACTIONSTATUS_SENSORERROR	///< The sensor responded with an error.
+};
+
 /// \brief Helpful class for working with VectorNav sensors.
 class vn_proglib_DLLEXPORT VnSensor : private util::NoCopy
 {
@@ -99,6 +109,9 @@ public:
 	/// This packet will have already had and pertinent error checking
 	/// performed and determined to be an asynchronous packet.
 	///
+	/// The packet may be a \ref protocol::uart::PacketView and is only valid
+	/// until the callback returns. Copy it into a Packet to keep it longer.
+	///
 	/// \param[in] userData Pointer to user data that was initially supplied
 	///     when the callback was registered via registerAsyncPacketReceivedHandler.
 	/// \param[in] asyncPacket The asynchronous packet received.
@@ -119,6 +132,43 @@ public:
 	///     the packet.
 	typedef void(*ErrorPacketReceivedHandler)(void* userData, protocol::uart::Packet& errorPacket, size_t packetStartRunningIndex);
 
+	/// \brief Defines the signature for a method that can receive
+	/// notification when a command issued with one of the asynchronous
+	/// methods completes.
+	///
+	/// The method is called on the thread processing received data, or on the
+	/// thread timing out asynchronous commands, so it should return quickly.
+	/// It may issue further asynchronous commands but must not disconnect the
+	/// sensor.
+	///
+	/// \param[in] userData Pointer to user data that was initially supplied
+	///     when the command was issued.
+	/// \param[in] status The outcome of the command.
+	/// \param[in] response The response received from the sensor, or an
+	///     empty packet if none was received. It is only valid until the
+	///     callback returns.
+	typedef void(*CommandCompletedHandler)(void* userData, TransactionStatus status, protocol::uart::Packet& response);
+
+	/// \brief Statistics about the buffer between the reader and parser
+	///     threads when pipeline mode is enabled.
+	struct PipelineStatistics
+	{
+		/// \brief The number of bytes the buffer can hold.
+		size_t capacity;
+
+		/// \brief The most bytes that have been waiting in the buffer at
+		///     once.
+		size_t highWaterMark;
+
+		/// \brief The number of times received data was dropped because the
+		///     buffer was full.
+		size_t numOfOverflows;
+
+		/// \brief The total number of bytes dropped because the buffer was
+		///     full.
+		size_t numOfBytesDropped;
+	};
+
 	/// \brief The list of baudrates supported by VectorNav sensors.
 	static std::vector<uint32_t> supportedBaudrates();
 
@@ -183,6 +233,67 @@ public:
 	/// \param[in] delay The retransmit delay in milliseconds.
 	void setRetransmitDelayMs(uint16_t delay);
 
+	/// \brief Indicates if pipeline mode is enabled.
+	///
+	/// \return <c>true</c> if pipeline mode is enabled; otherwise
+	///     <c>false</c>.
+	bool pipelineMode();
+
+	/// \brief Enables or disables pipeline mode. May only be changed while
+	///     not connected.
+	///
+	/// Normally received data is read, searched for packets and handed to
+	/// the registered handlers all on the port's notification thread, so a
+	/// slow handler delays reading from the port. In pipeline mode that
+	/// thread only reads the data into a buffer, along with the time it
+	/// arrived, and a separate thread searches it for packets and calls the
+	/// handlers. If the handlers fall so far behind that the buffer fills,
+	/// newly received data is dropped and counted in
+	/// \ref pipelineStatistics. Dropped bytes are not included in running
+	/// indexes.
+	///
+	/// \param[in] enabled Indicates if pipeline mode should be enabled.
+	void setPipelineMode(bool enabled);
+
+	/// \brief Returns statistics about the buffer used in pipeline mode for
+	///     the current or most recent connection.
+	///
+	/// \return The statistics.
+	PipelineStatistics pipelineStatistics();
+
+	/// \brief Indicates if the register cache is enabled.
+	///
+	/// \return <c>true</c> if the register cache is enabled; otherwise
+	///     <c>false</c>.
+	bool registerCacheEnabled();
+
+	/// \brief Enables or disables the register cache.
+	///
+	/// When enabled, the values of configuration registers read from or
+	/// written to the sensor are kept, and later reads of those registers
+	/// are answered from the cache without communicating with the sensor.
+	/// Registers holding measurements or status are always read from the
+	/// sensor. Any command other than a register read or write which may
+	/// change registers, such as restoring the factory settings, resetting
+	/// the sensor or setting the gyro bias, empties the cache, as do
+	/// disconnecting and disabling it.
+	///
+	/// Only changes made through this VnSensor are seen, so the cache should
+	/// not be enabled if the sensor is also configured by other means.
+	///
+	/// \param[in] enabled Indicates if the register cache should be enabled.
+	void setRegisterCacheEnabled(bool enabled);
+
+	/// \brief Discards all cached registers so they are read from the sensor
+	///     the next time they are needed.
+	void invalidateRegisterCache();
+
+	/// \brief Discards a cached register so it is read from the sensor the
+	///     next time it is needed.
+	///
+	/// \param[in] registerId The ID of the register.
+	void invalidateRegisterCache(uint8_t registerId);
+
 	/// \}
 
 	/// \brief Checks if we are able to send and receive communication with a sensor.
@@ -196,6 +307,20 @@ public:
 	/// \param[in] baudrate The baudrate to connect at.
 	void connect(const std::string &portName, uint32_t baudrate);
 
+	/// \brief Connects to a VectorNav sensor, optionally first optimizing the
+	///     serial port for low latency.
+	///
+	/// The optimization is done with \ref xplat::SerialPort::optimizePort and
+	/// is best effort. If it fails, for example because the process does not
+	/// have the required permissions, the connection is still made. Use
+	/// \ref xplat::SerialPort::latencySettings to see the effective settings.
+	///
+	/// \param[in] portName The name of the serial port to connect to.
+	/// \param[in] baudrate The baudrate to connect at.
+	/// \param[in] optimizePort Indicates if the serial port should be
+	///     optimized for low latency before connecting.
+	void connect(const std::string &portName, uint32_t baudrate, bool optimizePort);
+
 	/// \brief Allows connecting to a VectorNav sensor over a
 	///     \ref vn::common::ISimplePort.
 	///
@@ -224,8 +349,111 @@ public:
 	///
 	/// \param[in] toSend The command to send to the sensor.
 	/// \return The response received from the sensor.
+	/// \exception invalid_operation Thrown if the command is longer than 249
+	///     characters.
 	std::string transaction(std::string toSend);
 
+	/// \brief Sends the provided command and reports the outcome without
+	/// throwing an exception.
+	///
+	/// The command is completed the same way as for \ref transaction.
+	///
+	/// \param[in] toSend The command to send to the sensor.
+	/// \param[out] response The response received from the sensor. When the
+	///     sensor responds with an error, this holds the error message.
+	/// \return The outcome of the transaction.
+	/// \exception invalid_operation Thrown if the command is longer than 249
+	///     characters.
+	TransactionStatus tryTransaction(std::string toSend, std::string& response);
+
+	/// \brief Sends several commands with more than one of them awaiting a
+	/// response at a time, so the round trips to the sensor overlap.
+	///
+	/// Each command is completed the same way as for \ref transaction.
+	/// Responses are matched to their commands by the command type and
+	/// register ID, and each command is retransmitted and timed out on its
+	/// own according to \ref retransmitDelayMs and \ref responseTimeoutMs.
+	/// Since the sensor answers commands in order, an error response is
+	/// attributed to the oldest command still awaiting a response.
+	///
+	/// \param[in] commands The commands to send.
+	/// \return The response to each command, in the same order as the
+	///     commands.
+	/// \exception timeout Thrown if a command was not answered in time.
+	/// \exception sensor_error Thrown if the sensor answered a command with
+	///     an error.
+	/// \exception invalid_operation Thrown if a command is longer than 249
+	///     characters.
+	std::vector<protocol::uart::Packet> transactions(const std::vector<std::string>& commands);
+
+	/// \brief Reads several registers with their read commands sent as by
+	/// \ref transactions.
+	///
+	/// The responses can be decoded with the corresponding Packet parse
+	/// method, for example \ref protocol::uart::Packet::parseVpeBasicControl
+	/// for register 35.
+	///
+	/// \param[in] registerIds The IDs of the registers to read.
+	/// \return The response for each register, in the same order as
+	///     <c>registerIds</c>.
+	/// \exception timeout Thrown if a read was not answered in time.
+	/// \exception sensor_error Thrown if the sensor answered a read with an
+	///     error.
+	std::vector<protocol::uart::Packet> readRegisters(const std::vector<uint8_t>& registerIds);
+
+	/// \brief Sends the provided command and returns without waiting for the
+	/// response.
+	///
+	/// The command is completed the same way as for \ref transaction. It is
+	/// retransmitted according to \ref retransmitDelayMs until the sensor
+	/// responds or the timeout elapses, and the handler is then called with
+	/// the outcome. Responses are matched to their commands as for
+	/// \ref transactions, so any number of asynchronous commands may be
+	/// outstanding. The sensor answers commands in the order it receives
+	/// them, so when a blocking method and an asynchronous command await
+	/// responses which look alike, a response goes to whichever command was
+	/// sent first. Error responses do not say which command they answer, so
+	/// each goes to the command sent first among all those awaiting a
+	/// response.
+	///
+	/// Commands still outstanding when the sensor is disconnected complete
+	/// with \ref TRANSACTIONSTATUS_NOTCONNECTED.
+	///
+	/// \param[in] toSend The command to send to the sensor.
+	/// \param[in] handler The method to call when the command completes.
+	/// \param[in] userData Pointer to user data passed to the handler.
+	/// \param[in] timeoutMs How long to wait for the response, in
+	///     milliseconds. Zero uses \ref responseTimeoutMs.
+	/// \return An identifier for the command which can be given to
+	///     \ref cancelAsync.
+	/// \exception invalid_operation Thrown if the VnSensor is not
+	///     connected, or if the command is longer than 249 characters.
+	uint32_t transactionAsync(std::string toSend, CommandCompletedHandler handler, void* userData, uint16_t timeoutMs = 0);
+
+	/// \brief Reads a register as by \ref transactionAsync.
+	///
+	/// The response can be decoded with the corresponding Packet parse
+	/// method, as for \ref readRegisters.
+	///
+	/// \param[in] registerId The ID of the register to read.
+	/// \param[in] handler The method to call when the read completes.
+	/// \param[in] userData Pointer to user data passed to the handler.
+	/// \param[in] timeoutMs How long to wait for the response, in
+	///     milliseconds. Zero uses \ref responseTimeoutMs.
+	/// \return An identifier for the read which can be given to
+	///     \ref cancelAsync.
+	uint32_t readRegisterAsync(uint8_t registerId, CommandCompletedHandler handler, void* userData, uint16_t timeoutMs = 0);
+
+	/// \brief Cancels a command issued with one of the asynchronous methods.
+	///
+	/// The command may still reach the sensor, but its handler will not be
+	/// called.
+	///
+	/// \param[in] id The identifier returned when the command was issued.
+	/// \return <c>true</c> if the command was cancelled; <c>false</c> if it
+	///     had already completed.
+	bool cancelAsync(uint32_t id);
+
 	/// \brief Writes a raw data string to the sensor, normally appending an
 	/// appropriate error detection checksum.
 	///
@@ -282,6 +510,40 @@ public:
 	///     response from the sensor.
 	void accelerationDisturbancePresent(bool disturbancePresent, bool waitForReply = true);
 
+	/// \brief Issues a tare command as by \ref transactionAsync.
+	///
+	/// \param[in] handler The method to call when the command completes.
+	/// \param[in] userData Pointer to user data passed to the handler.
+	/// \param[in] timeoutMs How long to wait for the response, in
+	///     milliseconds. Zero uses \ref responseTimeoutMs.
+	/// \return An identifier for the command which can be given to
+	///     \ref cancelAsync.
+	uint32_t tareAsync(CommandCompletedHandler handler, void* userData, uint16_t timeoutMs = 0);
+
+	/// \brief Issues a command to set the gyro's bias as by
+	///     \ref transactionAsync.
+	///
+	/// \param[in] handler The method to call when the command completes.
+	/// \param[in] userData Pointer to user data passed to the handler.
+	/// \param[in] timeoutMs How long to wait for the response, in
+	///     milliseconds. Zero uses \ref responseTimeoutMs.
+	/// \return An identifier for the command which can be given to
+	///     \ref cancelAsync.
+	uint32_t setGyroBiasAsync(CommandCompletedHandler handler, void* userData, uint16_t timeoutMs = 0);
+
+	/// \brief Informs the sensor if there is a magnetic disturbance present
+	///     as by \ref transactionAsync.
+	///
+	/// \param[in] disturbancePresent Indicates the presence of a magnetic
+	///     disturbance.
+	/// \param[in] handler The method to call when the command completes.
+	/// \param[in] userData Pointer to user data passed to the handler.
+	/// \param[in] timeoutMs How long to wait for the response, in
+	///     milliseconds. Zero uses \ref responseTimeoutMs.
+	/// \return An identifier for the command which can be given to
+	///     \ref cancelAsync.
+	uint32_t magneticDisturbancePresentAsync(bool disturbancePresent, CommandCompletedHandler handler, void* userData, uint16_t timeoutMs = 0);
+
 	/// \brief Issues a Write Settings command to the VectorNav Sensor.
 	///
 	/// \param[in] waitForReply Indicates if the method should wait for a
@@ -330,6 +592,11 @@ public:
 	/// \brief This group of methods allow registering/unregistering for events
 	/// of the VnSensor.
 	///
+	/// The handlers are called from the thread which reads the serial port,
+	/// or from the parser thread in pipeline mode. A handler may register or
+	/// unregister the other handlers, but must not unregister itself or
+	/// disconnect the sensor, which unregisters from the port.
+	///
 	/// \{
 
 	/// \brief Registers a callback method for notification when raw data is
@@ -351,6 +618,11 @@ public:
 	#endif
 
 	/// \brief Unregisters the registered callback method.
+	///
+	/// Waits for a call to the handler in progress on another thread to
+	/// return, after which the handler is not called again and its user data
+	/// may be destroyed. Must not be called from within the handler itself,
+	/// since it would wait on itself forever.
 	void unregisterRawDataReceivedHandler();
 
 	/// \brief Registers a callback method for notification when a new possible
@@ -362,6 +634,11 @@ public:
 	void registerPossiblePacketFoundHandler(void* userData, PossiblePacketFoundHandler handler);
 
 	/// \brief Unregisters the registered callback method.
+	///
+	/// Waits for a call to the handler in progress on another thread to
+	/// return, after which the handler is not called again and its user data
+	/// may be destroyed. Must not be called from within the handler itself,
+	/// since it would wait on itself forever.
 	void unregisterPossiblePacketFoundHandler();
 
 	/// \brief Registers a callback method for notification when a new
@@ -386,6 +663,11 @@ public:
 	#endif
 
 	/// \brief Unregisters the registered callback method.
+	///
+	/// Waits for a call to the handler in progress on another thread to
+	/// return, after which the handler is not called again and its user data
+	/// may be destroyed. Must not be called from within the handler itself,
+	/// since it would wait on itself forever.
 	void unregisterAsyncPacketReceivedHandler();
 
 	/// \brief Registers a callback method for notification when an error
@@ -397,6 +679,11 @@ public:
 	void registerErrorPacketReceivedHandler(void* userData, ErrorPacketReceivedHandler handler);
 
 	/// \brief Unregisters the registered callback method.
+	///
+	/// Waits for a call to the handler in progress on another thread to
+	/// return, after which the handler is not called again and its user data
+	/// may be destroyed. Must not be called from within the handler itself,
+	/// since it would wait on itself forever.
 	void unregisterErrorPacketReceivedHandler();
 
 	/// \}
@@ -593,6 +880,19 @@ public:
 	/// \return The register's values.
 	vn::math::vec3f readYawPitchRoll();
 
+	/// \brief Reads the Yaw Pitch Roll register as by \ref transactionAsync.
+	///
+	/// The response can be decoded with
+	/// \ref protocol::uart::Packet::parseYawPitchRoll.
+	///
+	/// \param[in] handler The method to call when the read completes.
+	/// \param[in] userData Pointer to user data passed to the handler.
+	/// \param[in] timeoutMs How long to wait for the response, in
+	///     milliseconds. Zero uses \ref responseTimeoutMs.
+	/// \return An identifier for the read which can be given to
+	///     \ref cancelAsync.
+	uint32_t readYawPitchRollAsync(CommandCompletedHandler handler, void* userData, uint16_t timeoutMs = 0);
+
 	/// \brief Reads the Attitude Quaternion register.
 	///
 	/// \return The register's values.
@@ -44,6 +44,25 @@ public:
 		TWO_STOP_BITS
 	};
 
+	/// \brief The driver settings of a serial port which affect how long
+	///     received data is held before being delivered to the application.
+	struct LatencySettings
+	{
+		/// \brief Indicates if the driver has a low latency mode.
+		bool hasLowLatencyMode;
+
+		/// \brief Indicates if the driver's low latency mode is enabled.
+		bool lowLatencyMode;
+
+		/// \brief Indicates if the port is a USB serial adapter with a latency
+		///     timer (such as FTDI devices).
+		bool hasLatencyTimer;
+
+		/// \brief The adapter's latency timer in milliseconds. Only valid if
+		///     \ref hasLatencyTimer is <c>true</c>.
+		uint8_t latencyTimerMs;
+	};
+
 	// Constructors ///////////////////////////////////////////////////////////
 
 public:
@@ -114,6 +133,12 @@ public:
 	///     not indicative of the total number of dropped bytes.
 	size_t NumberOfReceiveDataDroppedSections();
 
+	/// \brief Returns the number of bytes received by the operating system
+	///     that are waiting to be read.
+	///
+	/// \return The number of bytes waiting to be read.
+	size_t bytesToRead();
+
 	/// \brief With regard to optimizing COM ports provided by FTDI drivers, this
 	/// method will check if the COM port has been optimized.
 	///
@@ -126,8 +151,21 @@ public:
 	/// If calling this method on Windows, the process must have administrator
 	/// privileges to write settings to the registry. Otherwise an
 	///
+	/// On Linux, the driver's low latency mode is enabled and, for adapters
+	/// that have one, the latency timer is set to 1 ms through sysfs. Writing
+	/// to sysfs normally requires root privileges or a udev rule granting
+	/// access, otherwise a \ref permission_denied exception is thrown.
+	///
 	/// \param[in] portName The FTDI USB Serial Port to optimize.
-	static void optimizePort(std::string portName);
+	/// \return The effective settings after the optimization.
+	static LatencySettings optimizePort(std::string portName);
+
+	/// \brief Reads the current latency related driver settings of a serial
+	///     port.
+	///
+	/// \param[in] portName The serial port to query.
+	/// \return The current settings.
+	static LatencySettings latencySettings(std::string portName);
 	
 	#if PYTHON && !PL156_ORIGINAL && !PL156_FIX_ATTEMPT_1
 
@@ -0,0 +1,169 @@
+/// \file
+/// {COMMON_HEADER}
+///
+/// \section DESCRIPTION
+/// This header file provides the TelemetryStore class which keeps a bounded
+/// history of sensor values.
+#ifndef _VNSENSORS_TELEMETRYSTORE_H_
+#define _VNSENSORS_TELEMETRYSTORE_H_
+
+#include <cstddef>
+
+#include "int.h"
+#include "export.h"
+#include "nocopy.h"
+#include "packet.h"
+
+namespace vn {
+namespace sensors {
+
+class CompositeData;
+
+/// \brief The values recorded by a \ref TelemetryStore.
+enum TelemetryField
+{
+	TELEMETRYFIELD_YAWPITCHROLL,			///< Yaw, pitch, roll.
+	TELEMETRYFIELD_QUATERNION,				///< Quaternion.
+	TELEMETRYFIELD_ANGULARRATE,				///< Compensated angular rate.
+	TELEMETRYFIELD_ACCELERATION,			///< Compensated acceleration.
+	TELEMETRYFIELD_MAGNETIC,				///< Compensated magnetic.
+	TELEMETRYFIELD_TEMPERATURE,				///< Temperature.
+	TELEMETRYFIELD_PRESSURE,				///< Pressure.
+	TELEMETRYFIELD_POSITIONESTIMATEDLLA,	///< Estimated latitude, longitude, altitude.
+	TELEMETRYFIELD_VELOCITYESTIMATEDNED,	///< Estimated NED velocity.
+	TELEMETRYFIELD_ATTITUDEUNCERTAINTY		///< Attitude uncertainty.
+};
+
+/// \brief A value read from a \ref TelemetryStore.
+struct TelemetrySample
+{
+	uint64_t timestamp;	///< The time of the sample, in nanoseconds.
+	double value[4];	///< The components of the value. Unused components are zero.
+};
+
+/// \brief Statistics of the samples in a window of a \ref TelemetryStore.
+/// Each array holds one entry per component of the field.
+struct TelemetryStats
+{
+	size_t count;		///< The number of samples in the window.
+	double mean[4];		///< The mean of each component.
+	double min[4];		///< The minimum of each component.
+	double max[4];		///< The maximum of each component.
+	double rms[4];		///< The root mean square of each component.
+};
+
+/// \brief Keeps the most recent values of a set of fields along with their
+///     timestamps.
+///
+/// Each field is stored in its own ring buffer holding a fixed number of
+/// samples, so the memory used is bounded. The timestamps and each component
+/// are kept in separate cache-aligned arrays so windows can be reduced with
+/// SIMD instructions.
+///
+/// Samples must be added from a single thread (typically the sensor's packet
+/// thread via \ref asyncPacketReceivedHandler) and their timestamps must not
+/// decrease. Any number of threads may read at the same time without taking
+/// a lock; reads that were overtaken by the writer are retried.
+class vn_proglib_DLLEXPORT TelemetryStore : private util::NoCopy
+{
+public:
+
+	/// \brief The number of fields in \ref TelemetryField.
+	static const size_t NumOfFields = TELEMETRYFIELD_ATTITUDEUNCERTAINTY + 1;
+
+	/// \brief Creates a store holding the same number of samples for every
+	///     field.
+	///
+	/// \param[in] capacity The number of samples to hold per field. This is
+	///     rounded up to a power of two of at least 8.
+	explicit TelemetryStore(size_t capacity = 1024);
+
+	~TelemetryStore();
+
+	/// \brief Changes the number of samples held for a field. Samples already
+	///     held for the field are discarded.
+	///
+	/// This must not be called while samples are being added or read.
+	///
+	/// \param[in] field The field.
+	/// \param[in] capacity The number of samples to hold. This is rounded up
+	///     to a power of two of at least 8.
+	void setCapacity(TelemetryField field, size_t capacity);
+
+	/// \brief Returns the number of samples held for a field.
+	///
+	/// \param[in] field The field.
+	/// \return The capacity.
+	size_t capacity(TelemetryField field) const;
+
+	/// \brief Returns the number of components of a field.
+	///
+	/// \param[in] field The field.
+	/// \return The number of components, from 1 to 4.
+	static size_t numOfComponents(TelemetryField field);
+
+	/// \brief Adds the fields present in decoded data.
+	///
+	/// \param[in] data The decoded data.
+	/// \param[in] timestamp The time of the data, in nanoseconds.
+	void add(CompositeData& data, uint64_t timestamp);
+
+	/// \brief Returns the timestamp of the newest sample of a field.
+	///
+	/// \param[in] field The field.
+	/// \param[out] timestamp The timestamp.
+	/// \return <c>true</c> if the field has any samples; otherwise
+	///     <c>false</c>.
+	bool latestTimestamp(TelemetryField field, uint64_t& timestamp) const;
+
+	/// \brief Copies the newest samples of a field.
+	///
+	/// \param[in] field The field.
+	/// \param[in] numOfSamples The maximum number of samples to copy.
+	/// \param[out] samples Receives the samples, oldest first.
+	/// \return The number of samples copied.
+	size_t latest(TelemetryField field, size_t numOfSamples, TelemetrySample* samples) const;
+
+	/// \brief Copies the samples of a field taken in a range of time.
+	///
+	/// If there are more than <c>maxNumOfSamples</c> samples in the range,
+	/// the newest ones are copied.
+	///
+	/// \param[in] field The field.
+	/// \param[in] from The start of the range, inclusive.
+	/// \param[in] to The end of the range, inclusive.
+	/// \param[out] samples Receives the samples, oldest first.
+	/// \param[in] maxNumOfSamples The maximum number of samples to copy.
+	/// \return The number of samples copied.
+	size_t range(TelemetryField field, uint64_t from, uint64_t to, TelemetrySample* samples, size_t maxNumOfSamples) const;
+
+	/// \brief Computes statistics of the samples of a field taken in a range
+	///     of time.
+	///
+	/// \param[in] field The field.
+	/// \param[in] from The start of the range, inclusive.
+	/// \param[in] to The end of the range, inclusive.
+	/// \param[out] stats The statistics.
+	/// \return <c>true</c> if there were any samples in the range; otherwise
+	///     <c>false</c>.
+	bool stats(TelemetryField field, uint64_t from, uint64_t to, TelemetryStats& stats) const;
+
+	/// \brief Handler which can be registered with
+	///     \ref VnSensor::registerAsyncPacketReceivedHandler to add every
+	///     async packet to a store. <c>userData</c> must point to the store.
+	///
+	/// Packets are timestamped with their TimeStartup value when they have
+	/// one and otherwise with the host's clock. Since timestamps must not
+	/// decrease, either every async output of the sensor should include
+	/// TimeStartup or none should.
+	static void asyncPacketReceivedHandler(void* userData, protocol::uart::Packet& p, size_t index);
+
+private:
+	struct Impl;
+	Impl* _pi;
+};
+
+}
+}
+
+#endif
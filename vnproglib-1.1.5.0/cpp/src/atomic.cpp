@@ -0,0 +1,94 @@
+#include "vn/atomic.h"
+
+#if _WIN32
+	#include <Windows.h>
+#elif __linux__
+	#include <unistd.h>
+	#include <sys/syscall.h>
+#endif
+
+namespace vn {
+namespace xplat {
+
+namespace {
+
+// A thread sanitizer cannot see the ordering the operating system provides,
+// so the hardware fences are kept to avoid false reports.
+#if defined(__SANITIZE_THREAD__)
+	#define VN_ASYMMETRIC_FENCES 0
+#elif defined(__has_feature)
+	#if __has_feature(thread_sanitizer)
+		#define VN_ASYMMETRIC_FENCES 0
+	#endif
+#endif
+
+#if !defined(VN_ASYMMETRIC_FENCES)
+	#if _WIN32 || (__linux__ && defined(__NR_membarrier))
+		#define VN_ASYMMETRIC_FENCES 1
+	#else
+		#define VN_ASYMMETRIC_FENCES 0
+	#endif
+#endif
+
+#if VN_ASYMMETRIC_FENCES && __linux__
+
+// Commands of the membarrier system call, from <linux/membarrier.h> which
+// older kernel headers do not have.
+const int MembarrierQuery = 0;
+const int MembarrierPrivateExpedited = 1 << 3;
+const int MembarrierRegisterPrivateExpedited = 1 << 4;
+
+#endif
+
+bool enableAsymmetricFences()
+{
+	#if !VN_ASYMMETRIC_FENCES
+
+	return false;
+
+	#elif _WIN32
+
+	return true;
+
+	#else
+
+	long commands = syscall(__NR_membarrier, MembarrierQuery, 0);
+
+	if (commands < 0 || (commands & MembarrierPrivateExpedited) == 0)
+		return false;
+
+	return syscall(__NR_membarrier, MembarrierRegisterPrivateExpedited, 0) == 0;
+
+	#endif
+}
+
+}
+
+bool AsymmetricFencesSupported = enableAsymmetricFences();
+
+void fenceHeavy()
+{
+	#if VN_ASYMMETRIC_FENCES
+
+	if (AsymmetricFencesSupported)
+	{
+		#if _WIN32
+		FlushProcessWriteBuffers();
+		#else
+		syscall(__NR_membarrier, MembarrierPrivateExpedited, 0);
+		#endif
+
+		return;
+	}
+
+	#endif
+
+	#if VN_SUPPORTS_ATOMIC
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	#else
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+	#endif
+}
+
+}
+}
@@ -1,26 +1,57 @@
-#ifdef _win32
-#include <Windows.h>
-#include <tchar.h>
+#include "benchmark/benchmark.h"
+#include "benchmark.h"
 
-#endif
+#include "vn/packet.h"
+#include "vn/error_detection.h"
 
-#include <stdio.h>
-#include <iostream>
+using namespace std;
+using namespace vn::data::integrity;
+using namespace vn::protocol::uart;
 
-#include "hayai_main.hpp"
+// Builds the binary packet the ROS node configures on binary output 1.
+vector<char> makeInsAndImuPacket(uint32_t sequence)
+{
+	const uint16_t groupFields[] = {
+		COMMONGROUP_QUATERNION | COMMONGROUP_ANGULARRATE | COMMONGROUP_POSITION | COMMONGROUP_ACCEL | COMMONGROUP_MAGPRES,
+		ATTITUDEGROUP_YPRU,
+		INSGROUP_INSSTATUS | INSGROUP_POSLLA | INSGROUP_POSECEF | INSGROUP_VELBODY | INSGROUP_ACCELECEF };
+
+	vector<char> packet;
+	packet.push_back(static_cast<char>(0xFA));
+	packet.push_back(BINARYGROUP_COMMON | BINARYGROUP_ATTITUDE | BINARYGROUP_INS);
+
+	// Group fields are stored little endian.
+	for (size_t i = 0; i < sizeof(groupFields) / sizeof(groupFields[0]); i++)
+	{
+		packet.push_back(static_cast<char>(groupFields[i]));
+		packet.push_back(static_cast<char>(groupFields[i] >> 8));
+	}
+
+	size_t length = Packet::computeBinaryPacketLength(&packet[0]);
+
+	for (size_t i = packet.size(); i < length - 2; i++)
+		packet.push_back(static_cast<char>((i * 37 + sequence) & 0xFF));
+
+	uint16_t crc = Crc16::compute(&packet[1], packet.size() - 1);
+	packet.push_back(static_cast<char>(crc >> 8));
+	packet.push_back(static_cast<char>(crc));
+
+	return packet;
+}
 
 int main(int argc, char* argv[])
 {
-	// Set up the main runner.
-	::hayai::MainRunner runner;
-
 	// Parse the arguments.
-	int result = runner.ParseArgs(argc, argv);
-	if (result)
+	::benchmark::Initialize(&argc, argv);
+
+	if (::benchmark::ReportUnrecognizedArguments(argc, argv))
 	{
-		return result;
+		return 1;
 	}
 
-	// Execute based on the selected mode.
-	return runner.Run();
+	// Execute the selected benchmarks.
+	::benchmark::RunSpecifiedBenchmarks();
+	::benchmark::Shutdown();
+
+	return 0;
 }
@@ -0,0 +1,15 @@
+#ifndef _VN_BENCHMARK_H_
+#define _VN_BENCHMARK_H_
+
+#include <vector>
+
+#include "vn/int.h"
+
+/// \brief Builds a binary packet with the layout the ROS node configures on
+///     binary output 1. The payload varies with the sequence number.
+///
+/// \param[in] sequence Number of the packet in the stream.
+/// \return The complete packet, including its CRC.
+std::vector<char> makeInsAndImuPacket(uint32_t sequence);
+
+#endif
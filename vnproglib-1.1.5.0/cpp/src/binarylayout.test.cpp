@@ -0,0 +1,150 @@
+#include "gtest/gtest.h"
+
+#include "vn/binarylayout.h"
+#include "vn/compositedata.h"
+#include "vn/packet.h"
+#include "vn/error_detection.h"
+
+#include <cstring>
+#include <vector>
+
+using namespace std;
+using namespace vn::math;
+using namespace vn::sensors;
+using namespace vn::protocol::uart;
+using namespace vn::data::integrity;
+
+namespace {
+
+// The layout the ROS node configures on the sensor.
+typedef BinaryLayout<
+	layout::Common<
+		layout::common::Quaternion,
+		layout::common::AngularRate,
+		layout::common::Position,
+		layout::common::Accel,
+		layout::common::MagPres>,
+	layout::Attitude<
+		layout::attitude::YprU>,
+	layout::Ins<
+		layout::ins::InsStatus,
+		layout::ins::PosLla,
+		layout::ins::PosEcef,
+		layout::ins::VelBody,
+		layout::ins::AccelEcef> > NodeLayout;
+
+// Deterministic generator so every run sees the same packets.
+class PayloadRandom
+{
+public:
+	PayloadRandom() : _state(88172645463325252ULL) { }
+
+	uint64_t next()
+	{
+		_state ^= _state << 13;
+		_state ^= _state >> 7;
+		_state ^= _state << 17;
+
+		return _state;
+	}
+
+private:
+	uint64_t _state;
+};
+
+// Builds a binary packet with the group fields of the register and a
+// random payload. The payload bytes are kept below 0x40 so every float and
+// double in it is finite.
+Packet makePacket(const BinaryOutputRegister& bor, PayloadRandom& rnd)
+{
+	const uint16_t fields[7] = { static_cast<uint16_t>(bor.commonField), static_cast<uint16_t>(bor.timeField), static_cast<uint16_t>(bor.imuField), static_cast<uint16_t>(bor.gpsField), static_cast<uint16_t>(bor.attitudeField), static_cast<uint16_t>(bor.insField), static_cast<uint16_t>(bor.gps2Field) };
+
+	vector<char> packet;
+	packet.push_back(static_cast<char>(0xFA));
+	packet.push_back(0);
+
+	for (size_t i = 0; i < 7; i++)
+	{
+		if (fields[i] == 0)
+			continue;
+
+		packet[1] = static_cast<char>(packet[1] | (1 << i));
+		packet.push_back(static_cast<char>(fields[i] & 0xFF));
+		packet.push_back(static_cast<char>(fields[i] >> 8));
+	}
+
+	size_t length = Packet::computeBinaryPacketLength(&packet[0]);
+
+	while (packet.size() < length - 2)
+		packet.push_back(static_cast<char>(rnd.next() & 0x3F));
+
+	uint16_t crc = Crc16::compute(&packet[1], packet.size() - 1);
+	packet.push_back(static_cast<char>(crc >> 8));
+	packet.push_back(static_cast<char>(crc & 0xFF));
+
+	return Packet(&packet[0], packet.size());
+}
+
+// Compares values bit for bit, as vectors have no equality operator.
+template<typename T>
+::testing::AssertionResult isSameBits(const char* expectedText, const char* actualText, const T& expected, const T& actual)
+{
+	if (memcmp(&expected, &actual, sizeof(T)) == 0)
+		return ::testing::AssertionSuccess();
+
+	return ::testing::AssertionFailure() << actualText << " differs from " << expectedText;
+}
+
+}
+
+TEST(BinaryLayoutTest, DecodeMatchesCompositeDataParse)
+{
+	PayloadRandom rnd;
+	BinaryOutputRegister bor = NodeLayout::binaryOutputRegister(ASYNCMODE_PORT1, 4);
+
+	for (size_t i = 0; i < 100; i++)
+	{
+		Packet p = makePacket(bor, rnd);
+		ASSERT_EQ(NodeLayout::PacketSize, p.length());
+
+		NodeLayout::Data d;
+		ASSERT_TRUE(NodeLayout::decode(p, d));
+
+		CompositeData cd;
+		CompositeData::parse(p, cd);
+
+		EXPECT_PRED_FORMAT2(isSameBits, cd.quaternion(), d.get<layout::common::Quaternion>());
+		EXPECT_PRED_FORMAT2(isSameBits, cd.angularRate(), d.get<layout::common::AngularRate>());
+		EXPECT_PRED_FORMAT2(isSameBits, cd.acceleration(), d.get<layout::common::Accel>());
+		EXPECT_PRED_FORMAT2(isSameBits, cd.magnetic(), d.get<layout::common::MagPres>().magnetic);
+		EXPECT_PRED_FORMAT2(isSameBits, cd.temperature(), d.get<layout::common::MagPres>().temperature);
+		EXPECT_PRED_FORMAT2(isSameBits, cd.pressure(), d.get<layout::common::MagPres>().pressure);
+		EXPECT_PRED_FORMAT2(isSameBits, cd.attitudeUncertainty(), d.get<layout::attitude::YprU>());
+		EXPECT_EQ(cd.insStatus(), d.get<layout::ins::InsStatus>());
+		EXPECT_PRED_FORMAT2(isSameBits, cd.positionEstimatedEcef(), d.get<layout::ins::PosEcef>());
+		EXPECT_PRED_FORMAT2(isSameBits, cd.velocityEstimatedBody(), d.get<layout::ins::VelBody>());
+		EXPECT_PRED_FORMAT2(isSameBits, cd.accelerationEcef(), d.get<layout::ins::AccelEcef>());
+
+		// The position is in both the Common and INS groups and CompositeData
+		// keeps the later one.
+		EXPECT_PRED_FORMAT2(isSameBits, cd.positionEstimatedLla(), d.get<layout::ins::PosLla>());
+	}
+}
+
+TEST(BinaryLayoutTest, DecodeRejectsPacketsWithOtherFields)
+{
+	PayloadRandom rnd;
+	BinaryOutputRegister bor = NodeLayout::binaryOutputRegister(ASYNCMODE_PORT1, 4);
+	bor.commonField = static_cast<CommonGroup>(bor.commonField | COMMONGROUP_YAWPITCHROLL);
+
+	Packet p = makePacket(bor, rnd);
+
+	NodeLayout::Data d;
+	d.get<layout::ins::InsStatus>() = INSSTATUS_GPS_FIX;
+
+	EXPECT_FALSE(NodeLayout::decode(p, d));
+	EXPECT_EQ(INSSTATUS_GPS_FIX, d.get<layout::ins::InsStatus>());
+
+	// Parsing still finds every field of the layout.
+	EXPECT_TRUE(NodeLayout::parse(p, d));
+}
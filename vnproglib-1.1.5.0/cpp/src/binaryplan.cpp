@@ -0,0 +1,142 @@
+#include "vn/binaryplan.h"
+#include "vn/packet.h"
+#include "vn/utilities.h"
+#include "vn/atomic.h"
+
+#include <cstring>
+
+using namespace std;
+using namespace vn::xplat;
+
+namespace vn {
+namespace protocol {
+namespace uart {
+
+namespace {
+
+// Slots are filled in order and never emptied, so the first empty slot marks
+// the end of the cache.
+Atomic<BinaryPlan*> CachedPlans[BinaryPlan::MaximumNumOfCachedPlans];
+
+}
+
+void BinaryPlan::build(char const* startOfPacket)
+{
+	uint8_t groupsPresent = static_cast<uint8_t>(startOfPacket[1]);
+
+	headerLength = 2 + 2 * countSetBits(groupsPresent);
+	memcpy(header, startOfPacket, headerLength);
+
+	size_t offset = headerLength;
+	const char* pCurrentGroupField = startOfPacket + 2;
+
+	numOfFields = 0;
+	memset(fieldOffsets, 0, sizeof(fieldOffsets));
+
+	for (size_t groupIndex = 0; groupIndex < 8; groupIndex++)
+	{
+		if (((groupsPresent >> groupIndex) & 0x01) == 0)
+			continue;
+
+		uint16_t groupField;
+		memcpy(&groupField, pCurrentGroupField, sizeof(uint16_t));
+		groupField = stoh(groupField);
+		pCurrentGroupField += sizeof(uint16_t);
+
+		for (size_t fieldIndex = 0; fieldIndex < 15; fieldIndex++)
+		{
+			if (((groupField >> fieldIndex) & 0x01) == 0)
+				continue;
+
+			size_t fieldLength = Packet::BinaryGroupLengths[groupIndex][fieldIndex];
+
+			// Fields we do not know the size of are left out of the plan.
+			if (fieldLength == 0)
+				continue;
+
+			fields[numOfFields].code = code(groupIndex, fieldIndex);
+			fields[numOfFields].offset = static_cast<uint16_t>(offset);
+			fieldOffsets[fields[numOfFields].code] = fields[numOfFields].offset;
+			numOfFields++;
+
+			offset += fieldLength;
+		}
+	}
+
+	length = offset + 2;	// Add 2 bytes for CRC.
+}
+
+bool BinaryPlan::matches(char const* startOfPacket) const
+{
+	// Comparing the groups byte first also ensures the rest of the header
+	// has the same length. The headers are only a few bytes long so they are
+	// compared directly rather than with memcmp.
+	if (header[1] != startOfPacket[1])
+		return false;
+
+	for (size_t i = 2; i < headerLength; i++)
+	{
+		if (header[i] != startOfPacket[i])
+			return false;
+	}
+
+	return true;
+}
+
+const BinaryPlan* BinaryPlan::find(char const* startOfPacket)
+{
+	for (size_t i = 0; i < MaximumNumOfCachedPlans; i++)
+	{
+		BinaryPlan* plan = CachedPlans[i].loadAcquire();
+
+		if (plan == NULL)
+			return NULL;
+
+		if (plan->matches(startOfPacket))
+			return plan;
+	}
+
+	return NULL;
+}
+
+const BinaryPlan& BinaryPlan::get(char const* startOfPacket, BinaryPlan& scratch)
+{
+	BinaryPlan* created = NULL;
+
+	for (size_t i = 0; i < MaximumNumOfCachedPlans; i++)
+	{
+		BinaryPlan* plan = CachedPlans[i].loadAcquire();
+
+		if (plan == NULL)
+		{
+			if (created == NULL)
+			{
+				created = new BinaryPlan;
+				created->build(startOfPacket);
+			}
+
+			if (CachedPlans[i].compareExchange(plan, created))
+				return *created;
+
+			// Another thread filled the slot first; plan now holds its entry.
+		}
+
+		if (plan->matches(startOfPacket))
+		{
+			delete created;
+
+			return *plan;
+		}
+	}
+
+	// The cache is full.
+	delete created;
+
+	scratch.build(startOfPacket);
+
+	return scratch;
+}
+
+}
+}
+}
@@ -0,0 +1,199 @@
+#include "vn/columnarbatch.h"
+#include "vn/compositedata.h"
+
+using namespace std;
+using namespace vn::math;
+using namespace vn::protocol::uart;
+
+namespace vn {
+namespace sensors {
+
+namespace {
+
+template<typename T, size_t N>
+void clearColumn(Column<T, N>& column)
+{
+	for (size_t i = 0; i < N; i++)
+		column.values[i].clear();
+
+	column.validity.clear();
+}
+
+template<typename T, size_t N>
+void reserveColumn(Column<T, N>& column, size_t numOfRows)
+{
+	for (size_t i = 0; i < N; i++)
+		column.values[i].reserve(numOfRows);
+
+	column.validity.reserve((numOfRows + 63) / 64);
+}
+
+// Adds row number row to a column. When valid is false, value is ignored and
+// the components are set to zero.
+template<typename T, size_t N>
+void appendToColumn(Column<T, N>& column, size_t row, bool valid, T const* value)
+{
+	if (row % 64 == 0)
+		column.validity.push_back(0);
+
+	if (valid)
+	{
+		column.validity.back() |= static_cast<uint64_t>(1) << (row % 64);
+
+		for (size_t i = 0; i < N; i++)
+			column.values[i].push_back(value[i]);
+	}
+	else
+	{
+		for (size_t i = 0; i < N; i++)
+			column.values[i].push_back(T());
+	}
+}
+
+template<typename T>
+void appendToColumn(Column<T, 1>& column, size_t row, bool valid, T value)
+{
+	appendToColumn(column, row, valid, &value);
+}
+
+template<size_t Dim, typename T>
+void appendToColumn(Column<T, Dim>& column, size_t row, bool valid, vec<Dim, T> const& value)
+{
+	appendToColumn(column, row, valid, value.c);
+}
+
+}
+
+ColumnarBatch::ColumnarBatch() :
+	_numOfRows(0)
+{
+}
+
+size_t ColumnarBatch::size() const
+{
+	return _numOfRows;
+}
+
+void ColumnarBatch::clear()
+{
+	clearColumn(timeStartup);
+	clearColumn(timeGps);
+	clearColumn(gpsTow);
+	clearColumn(tow);
+	clearColumn(week);
+	clearColumn(yawPitchRoll);
+	clearColumn(quaternion);
+	clearColumn(angularRate);
+	clearColumn(acceleration);
+	clearColumn(magnetic);
+	clearColumn(temperature);
+	clearColumn(pressure);
+	clearColumn(deltaTime);
+	clearColumn(deltaTheta);
+	clearColumn(deltaVelocity);
+	clearColumn(insStatus);
+	clearColumn(positionEstimatedLla);
+	clearColumn(velocityEstimatedNed);
+	clearColumn(attitudeUncertainty);
+	clearColumn(positionUncertaintyEstimated);
+	clearColumn(velocityUncertaintyEstimated);
+	clearColumn(fix);
+	clearColumn(numSats);
+	clearColumn(positionGpsLla);
+	clearColumn(velocityGpsNed);
+
+	_numOfRows = 0;
+}
+
+void ColumnarBatch::reserve(size_t numOfRows)
+{
+	reserveColumn(timeStartup, numOfRows);
+	reserveColumn(timeGps, numOfRows);
+	reserveColumn(gpsTow, numOfRows);
+	reserveColumn(tow, numOfRows);
+	reserveColumn(week, numOfRows);
+	reserveColumn(yawPitchRoll, numOfRows);
+	reserveColumn(quaternion, numOfRows);
+	reserveColumn(angularRate, numOfRows);
+	reserveColumn(acceleration, numOfRows);
+	reserveColumn(magnetic, numOfRows);
+	reserveColumn(temperature, numOfRows);
+	reserveColumn(pressure, numOfRows);
+	reserveColumn(deltaTime, numOfRows);
+	reserveColumn(deltaTheta, numOfRows);
+	reserveColumn(deltaVelocity, numOfRows);
+	reserveColumn(insStatus, numOfRows);
+	reserveColumn(positionEstimatedLla, numOfRows);
+	reserveColumn(velocityEstimatedNed, numOfRows);
+	reserveColumn(attitudeUncertainty, numOfRows);
+	reserveColumn(positionUncertaintyEstimated, numOfRows);
+	reserveColumn(velocityUncertaintyEstimated, numOfRows);
+	reserveColumn(fix, numOfRows);
+	reserveColumn(numSats, numOfRows);
+	reserveColumn(positionGpsLla, numOfRows);
+	reserveColumn(velocityGpsNed, numOfRows);
+}
+
+void ColumnarBatch::append(CompositeData& d)
+{
+	size_t row = _numOfRows;
+
+	bool has = d.hasTimeStartup();
+	appendToColumn(timeStartup, row, has, has ? d.timeStartup() : 0);
+	has = d.hasTimeGps();
+	appendToColumn(timeGps, row, has, has ? d.timeGps() : 0);
+	has = d.hasGpsTow();
+	appendToColumn(gpsTow, row, has, has ? d.gpsTow() : 0);
+	has = d.hasTow();
+	appendToColumn(tow, row, has, has ? d.tow() : 0);
+	has = d.hasWeek();
+	appendToColumn(week, row, has, has ? d.week() : static_cast<uint16_t>(0));
+
+	has = d.hasYawPitchRoll();
+	appendToColumn(yawPitchRoll, row, has, has ? d.yawPitchRoll() : vec3f());
+	has = d.hasQuaternion();
+	appendToColumn(quaternion, row, has, has ? d.quaternion() : vec4f());
+	has = d.hasAngularRate();
+	appendToColumn(angularRate, row, has, has ? d.angularRate() : vec3f());
+	has = d.hasAcceleration();
+	appendToColumn(acceleration, row, has, has ? d.acceleration() : vec3f());
+	has = d.hasMagnetic();
+	appendToColumn(magnetic, row, has, has ? d.magnetic() : vec3f());
+	has = d.hasTemperature();
+	appendToColumn(temperature, row, has, has ? d.temperature() : 0.f);
+	has = d.hasPressure();
+	appendToColumn(pressure, row, has, has ? d.pressure() : 0.f);
+	has = d.hasDeltaTime();
+	appendToColumn(deltaTime, row, has, has ? d.deltaTime() : 0.f);
+	has = d.hasDeltaTheta();
+	appendToColumn(deltaTheta, row, has, has ? d.deltaTheta() : vec3f());
+	has = d.hasDeltaVelocity();
+	appendToColumn(deltaVelocity, row, has, has ? d.deltaVelocity() : vec3f());
+
+	has = d.hasInsStatus();
+	appendToColumn(insStatus, row, has, has ? static_cast<uint16_t>(d.insStatus()) : static_cast<uint16_t>(0));
+	has = d.hasPositionEstimatedLla();
+	appendToColumn(positionEstimatedLla, row, has, has ? d.positionEstimatedLla() : vec3d());
+	has = d.hasVelocityEstimatedNed();
+	appendToColumn(velocityEstimatedNed, row, has, has ? d.velocityEstimatedNed() : vec3f());
+	has = d.hasAttitudeUncertainty();
+	appendToColumn(attitudeUncertainty, row, has, has ? d.attitudeUncertainty() : vec3f());
+	has = d.hasPositionUncertaintyEstimated();
+	appendToColumn(positionUncertaintyEstimated, row, has, has ? d.positionUncertaintyEstimated() : 0.f);
+	has = d.hasVelocityUncertaintyEstimated();
+	appendToColumn(velocityUncertaintyEstimated, row, has, has ? d.velocityUncertaintyEstimated() : 0.f);
+
+	has = d.hasFix();
+	appendToColumn(fix, row, has, has ? static_cast<uint8_t>(d.fix()) : static_cast<uint8_t>(0));
+	has = d.hasNumSats();
+	appendToColumn(numSats, row, has, has ? d.numSats() : static_cast<uint8_t>(0));
+	has = d.hasPositionGpsLla();
+	appendToColumn(positionGpsLla, row, has, has ? d.positionGpsLla() : vec3d());
+	has = d.hasVelocityGpsNed();
+	appendToColumn(velocityGpsNed, row, has, has ? d.velocityGpsNed() : vec3f());
+
+	_numOfRows++;
+}
+
+}
+}
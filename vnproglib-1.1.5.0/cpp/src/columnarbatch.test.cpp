@@ -0,0 +1,260 @@
+#include "gtest/gtest.h"
+
+#include "vn/columnarbatch.h"
+#include "vn/compositedata.h"
+#include "vn/packet.h"
+#include "vn/error_detection.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace vn::math;
+using namespace vn::sensors;
+using namespace vn::protocol::uart;
+using namespace vn::data::integrity;
+
+namespace {
+
+// Deterministic generator so every run sees the same packets.
+class PayloadRandom
+{
+public:
+	PayloadRandom() : _state(88172645463325252ULL) { }
+
+	uint64_t next()
+	{
+		_state ^= _state << 13;
+		_state ^= _state >> 7;
+		_state ^= _state << 17;
+
+		return _state;
+	}
+
+private:
+	uint64_t _state;
+};
+
+// Every field of each of the seven binary groups.
+const uint16_t AllFields[7] = { 0x7FFF, 0x03FF, 0x0FFF, 0x3FFF, 0x01FF, 0x07FF, 0x3FFF };
+
+// Builds a binary packet holding a random selection of fields from random
+// groups and a random payload. The payload bytes are kept below 0x40 so
+// every float and double in it is finite.
+vector<char> makeBinaryPacket(PayloadRandom& rnd)
+{
+	vector<char> packet;
+	packet.push_back(static_cast<char>(0xFA));
+	packet.push_back(0);
+
+	for (size_t i = 0; i < 7; i++)
+	{
+		uint16_t fields = static_cast<uint16_t>(rnd.next() & AllFields[i]);
+
+		if (rnd.next() % 3 != 0 || fields == 0)
+			continue;
+
+		packet[1] = static_cast<char>(packet[1] | (1 << i));
+		packet.push_back(static_cast<char>(fields & 0xFF));
+		packet.push_back(static_cast<char>(fields >> 8));
+	}
+
+	// A packet needs at least one group.
+	if (packet[1] == 0)
+	{
+		packet[1] = 0x01;
+		packet.push_back(static_cast<char>(COMMONGROUP_YAWPITCHROLL));
+		packet.push_back(0);
+	}
+
+	size_t length = Packet::computeBinaryPacketLength(&packet[0]);
+
+	while (packet.size() < length - 2)
+		packet.push_back(static_cast<char>(rnd.next() & 0x3F));
+
+	uint16_t crc = Crc16::compute(&packet[1], packet.size() - 1);
+	packet.push_back(static_cast<char>(crc >> 8));
+	packet.push_back(static_cast<char>(crc & 0xFF));
+
+	return packet;
+}
+
+vector<char> makeAsciiPacket(const char* sentence)
+{
+	char packet[256];
+	int length = sprintf(packet, "%s*%02X\r\n", sentence, Checksum8::compute(sentence + 1, strlen(sentence) - 1));
+
+	return vector<char>(packet, packet + length);
+}
+
+// A capture of more than 64 packets so the validity bitmaps span several
+// words, mixing binary packets with ASCII ones.
+vector<vector<char> > makeCapture()
+{
+	PayloadRandom rnd;
+	vector<vector<char> > capture;
+
+	for (size_t i = 0; i < 200; i++)
+	{
+		if (i % 50 == 7)
+			capture.push_back(makeAsciiPacket("$VNYPR,+010.000,-020.500,+030.250"));
+		else if (i % 50 == 31)
+			capture.push_back(makeAsciiPacket("$VNINS,342008.010000,1845,0207,+010.000,-020.500,+030.250,+37.12345678,-121.12345678,+00010.000,+001.000,-002.000,+003.000,00.5,01.0,0.25"));
+		else
+			capture.push_back(makeBinaryPacket(rnd));
+	}
+
+	return capture;
+}
+
+// Checks one row of a column against the value CompositeData parsed.
+template<typename T, size_t N>
+void expectRow(const Column<T, N>& column, size_t row, bool has, const T* value)
+{
+	ASSERT_EQ(has, column.isValid(row));
+
+	for (size_t i = 0; i < N; i++)
+	{
+		T expected = has ? value[i] : T();
+
+		EXPECT_EQ(0, memcmp(&expected, &column.component(i)[row], sizeof(T))) << "component " << i;
+	}
+}
+
+template<typename T>
+void expectRow(const Column<T, 1>& column, size_t row, bool has, T value)
+{
+	expectRow(column, row, has, &value);
+}
+
+template<size_t Dim, typename T>
+void expectRow(const Column<T, Dim>& column, size_t row, bool has, const vec<Dim, T>& value)
+{
+	expectRow(column, row, has, value.c);
+}
+
+#define EXPECT_ROW(column, Name, type) \
+	{ \
+		SCOPED_TRACE(#column); \
+		bool has = cd.has##Name(); \
+		expectRow(batch.column, row, has, has ? static_cast<type>(cd.column()) : type()); \
+	}
+
+// Checks every column of a row against parsing the packet on its own.
+void expectRowMatchesParse(const ColumnarBatch& batch, size_t row, Packet& p)
+{
+	CompositeData cd = CompositeData::parse(p);
+
+	EXPECT_ROW(timeStartup, TimeStartup, uint64_t);
+	EXPECT_ROW(timeGps, TimeGps, uint64_t);
+	EXPECT_ROW(gpsTow, GpsTow, uint64_t);
+	EXPECT_ROW(tow, Tow, double);
+	EXPECT_ROW(week, Week, uint16_t);
+	EXPECT_ROW(yawPitchRoll, YawPitchRoll, vec3f);
+	EXPECT_ROW(quaternion, Quaternion, vec4f);
+	EXPECT_ROW(angularRate, AngularRate, vec3f);
+	EXPECT_ROW(acceleration, Acceleration, vec3f);
+	EXPECT_ROW(magnetic, Magnetic, vec3f);
+	EXPECT_ROW(temperature, Temperature, float);
+	EXPECT_ROW(pressure, Pressure, float);
+	EXPECT_ROW(deltaTime, DeltaTime, float);
+	EXPECT_ROW(deltaTheta, DeltaTheta, vec3f);
+	EXPECT_ROW(deltaVelocity, DeltaVelocity, vec3f);
+	EXPECT_ROW(insStatus, InsStatus, uint16_t);
+	EXPECT_ROW(positionEstimatedLla, PositionEstimatedLla, vec3d);
+	EXPECT_ROW(velocityEstimatedNed, VelocityEstimatedNed, vec3f);
+	EXPECT_ROW(attitudeUncertainty, AttitudeUncertainty, vec3f);
+	EXPECT_ROW(positionUncertaintyEstimated, PositionUncertaintyEstimated, float);
+	EXPECT_ROW(velocityUncertaintyEstimated, VelocityUncertaintyEstimated, float);
+	EXPECT_ROW(fix, Fix, uint8_t);
+	EXPECT_ROW(numSats, NumSats, uint8_t);
+	EXPECT_ROW(positionGpsLla, PositionGpsLla, vec3d);
+	EXPECT_ROW(velocityGpsNed, VelocityGpsNed, vec3f);
+}
+
+#undef EXPECT_ROW
+
+}
+
+TEST(ColumnarBatchTest, ColumnsMatchParsingEachPacket)
+{
+	vector<vector<char> > capture = makeCapture();
+
+	vector<Packet> packets;
+	for (size_t i = 0; i < capture.size(); i++)
+		packets.push_back(Packet(&capture[i][0], capture[i].size()));
+
+	ColumnarBatch batch;
+	CompositeData::parseBatch(&packets[0], packets.size(), batch);
+
+	ASSERT_EQ(capture.size(), batch.size());
+
+	for (size_t row = 0; row < packets.size(); row++)
+	{
+		SCOPED_TRACE(row);
+		expectRowMatchesParse(batch, row, packets[row]);
+	}
+}
+
+TEST(ColumnarBatchTest, PacketViewsGiveTheSameColumnsAsPackets)
+{
+	vector<vector<char> > capture = makeCapture();
+
+	vector<Packet> packets;
+	vector<PacketView> views;
+	for (size_t i = 0; i < capture.size(); i++)
+	{
+		packets.push_back(Packet(&capture[i][0], capture[i].size()));
+		views.push_back(PacketView(&capture[i][0], capture[i].size()));
+	}
+
+	ColumnarBatch fromPackets;
+	CompositeData::parseBatch(&packets[0], packets.size(), fromPackets);
+
+	// Added in two calls to check the rows carry on from the first.
+	ColumnarBatch fromViews;
+	CompositeData::parseBatch(&views[0], 100, fromViews);
+	CompositeData::parseBatch(&views[100], views.size() - 100, fromViews);
+
+	ASSERT_EQ(fromPackets.size(), fromViews.size());
+	EXPECT_EQ(fromPackets.yawPitchRoll.validity, fromViews.yawPitchRoll.validity);
+	EXPECT_EQ(fromPackets.positionEstimatedLla.validity, fromViews.positionEstimatedLla.validity);
+
+	for (size_t i = 0; i < 3; i++)
+	{
+		EXPECT_EQ(fromPackets.yawPitchRoll.values[i], fromViews.yawPitchRoll.values[i]);
+		EXPECT_EQ(fromPackets.positionEstimatedLla.values[i], fromViews.positionEstimatedLla.values[i]);
+	}
+
+	EXPECT_EQ(fromPackets.timeStartup.values[0], fromViews.timeStartup.values[0]);
+}
+
+TEST(ColumnarBatchTest, ClearedBatchIsRefilledFromTheFirstRow)
+{
+	vector<vector<char> > capture = makeCapture();
+
+	vector<Packet> packets;
+	for (size_t i = 0; i < capture.size(); i++)
+		packets.push_back(Packet(&capture[i][0], capture[i].size()));
+
+	ColumnarBatch batch;
+	batch.reserve(packets.size());
+	CompositeData::parseBatch(&packets[0], packets.size(), batch);
+
+	batch.clear();
+	EXPECT_EQ(0u, batch.size());
+	EXPECT_TRUE(batch.quaternion.component(0) == NULL);
+
+	CompositeData::parseBatch(&packets[7], 1, batch);
+
+	ASSERT_EQ(1u, batch.size());
+	ASSERT_EQ(1u, batch.yawPitchRoll.validity.size());
+	expectRowMatchesParse(batch, 0, packets[7]);
+
+	EXPECT_FLOAT_EQ(10, batch.yawPitchRoll.component(0)[0]);
+	EXPECT_FLOAT_EQ(-20.5f, batch.yawPitchRoll.component(1)[0]);
+	EXPECT_FLOAT_EQ(30.25f, batch.yawPitchRoll.component(2)[0]);
+	EXPECT_FALSE(batch.quaternion.isValid(0));
+}
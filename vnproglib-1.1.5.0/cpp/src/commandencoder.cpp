@@ -0,0 +1,333 @@
+#include "vn/commandencoder.h"
+#include "vn/error_detection.h"
+#include "vn/exceptions.h"
+#include "vn/compiler.h"
+
+#include <cmath>
+#include <cstdio>
+
+using namespace vn::data::integrity;
+
+namespace vn {
+namespace protocol {
+namespace uart {
+
+namespace {
+
+const char HexDigits[] = "0123456789ABCDEF";
+
+const uint64_t Uint64Max = ~static_cast<uint64_t>(0);
+
+// The largest number of decimal digits in a uint64_t.
+const size_t MaximumNumOfDecimalDigits = 20;
+
+// Writes the decimal digits of value padded with leading zeros to at least
+// minNumOfDigits. Returns the number of digits written.
+size_t writeDecimal(uint64_t value, size_t minNumOfDigits, char* digits)
+{
+	char reversed[MaximumNumOfDecimalDigits];
+	size_t n = 0;
+
+	do
+	{
+		reversed[n++] = static_cast<char>('0' + value % 10);
+		value /= 10;
+	} while (value != 0);
+
+	while (n < minNumOfDigits && n < MaximumNumOfDecimalDigits)
+		reversed[n++] = '0';
+
+	for (size_t i = 0; i < n; i++)
+		digits[i] = reversed[n - 1 - i];
+
+	return n;
+}
+
+uint64_t bitsOf(double value)
+{
+	uint64_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+
+	return bits;
+}
+
+// Also true for -0.0, which printf writes with a sign.
+bool isNegative(double value)
+{
+	return (bitsOf(value) >> 63) != 0;
+}
+
+bool isFinite(double value)
+{
+	return ((bitsOf(value) >> 52) & 0x7FF) != 0x7FF;
+}
+
+bool multiplyFits(uint64_t& value, uint64_t factor)
+{
+	if (factor != 0 && value > Uint64Max / factor)
+		return false;
+
+	value *= factor;
+
+	return true;
+}
+
+bool shiftFits(uint64_t& value, int shift)
+{
+	if (shift >= 64 || value > (Uint64Max >> shift))
+		return false;
+
+	value <<= shift;
+
+	return true;
+}
+
+// Computes |value| * 10^exponent rounded to the nearest integer with ties to
+// even. This is exact, as printf is, since the value is scaled as a ratio of
+// integers. Returns false if the integers do not fit in 64 bits, which only
+// happens for values far outside what the sensor's registers hold or for
+// doubles with more significant bits than a float.
+bool scaleAndRound(double value, int exponent, uint64_t& result)
+{
+	int binaryExponent;
+	double mantissa = frexp(fabs(value), &binaryExponent);
+
+	// |value| is significand * 2^binaryExponent.
+	uint64_t significand = static_cast<uint64_t>(ldexp(mantissa, 53));
+	binaryExponent -= 53;
+
+	if (significand == 0)
+	{
+		result = 0;
+		return true;
+	}
+
+	while ((significand & 1) == 0)
+	{
+		significand >>= 1;
+		binaryExponent++;
+	}
+
+	// 10^exponent is 5^exponent * 2^exponent.
+	uint64_t numerator = significand;
+	uint64_t denominator = 1;
+	int powerOf2 = binaryExponent + exponent;
+
+	for (int i = 0; i < exponent; i++)
+		if (!multiplyFits(numerator, 5))
+			return false;
+
+	for (int i = 0; i < -exponent; i++)
+		if (!multiplyFits(denominator, 5))
+			return false;
+
+	if (powerOf2 >= 0 ? !shiftFits(numerator, powerOf2) : !shiftFits(denominator, -powerOf2))
+		return false;
+
+	if (denominator > Uint64Max / 2)
+		return false;
+
+	result = numerator / denominator;
+	uint64_t twiceRemainder = 2 * (numerator % denominator);
+
+	if (twiceRemainder > denominator || (twiceRemainder == denominator && (result & 1) != 0))
+		result++;
+
+	return true;
+}
+
+}
+
+void CommandEncoder::unsignedField(uint32_t value, size_t minNumOfDigits)
+{
+	char text[1 + MaximumNumOfDecimalDigits];
+	text[0] = ',';
+
+	append(text, 1 + writeDecimal(value, minNumOfDigits, text + 1));
+}
+
+void CommandEncoder::signedField(int32_t value)
+{
+	char text[2 + MaximumNumOfDecimalDigits];
+	size_t n = 0;
+	text[n++] = ',';
+
+	int64_t wide = value;
+
+	if (wide < 0)
+	{
+		text[n++] = '-';
+		wide = -wide;
+	}
+
+	n += writeDecimal(static_cast<uint64_t>(wide), 1, text + n);
+
+	append(text, n);
+}
+
+void CommandEncoder::hexField(uint32_t value)
+{
+	char text[1 + 2 * sizeof(value)];
+	size_t n = 0;
+	text[n++] = ',';
+
+	int shift = 4 * 2 * sizeof(value) - 4;
+
+	// Skip the leading zeros but keep the last digit.
+	while (shift > 0 && ((value >> shift) & 0xF) == 0)
+		shift -= 4;
+
+	for (; shift >= 0; shift -= 4)
+		text[n++] = HexDigits[(value >> shift) & 0xF];
+
+	append(text, n);
+}
+
+void CommandEncoder::floatField(double value)
+{
+	uint64_t scaled;
+
+	if (!isFinite(value) || !scaleAndRound(value, 6, scaled))
+	{
+		appendFormatted(",%f", value);
+		return;
+	}
+
+	char text[3 + 2 * MaximumNumOfDecimalDigits];
+	size_t n = 0;
+	text[n++] = ',';
+
+	if (isNegative(value))
+		text[n++] = '-';
+
+	n += writeDecimal(scaled / 1000000, 1, text + n);
+	text[n++] = '.';
+	n += writeDecimal(scaled % 1000000, 6, text + n);
+
+	append(text, n);
+}
+
+void CommandEncoder::scientificField(double value)
+{
+	int exponent = 0;
+	uint64_t digits = 0;
+
+	if (!isFinite(value))
+	{
+		appendFormatted(",%E", value);
+		return;
+	}
+
+	if (value != 0)
+	{
+		exponent = static_cast<int>(floor(log10(fabs(value))));
+
+		// The logarithm may be off by one near powers of ten, and rounding
+		// may carry into another digit, so the exponent is settled by
+		// checking that there are exactly seven digits.
+		for (int attempt = 0; ; attempt++)
+		{
+			if (attempt == 3 || !scaleAndRound(value, 6 - exponent, digits))
+			{
+				appendFormatted(",%E", value);
+				return;
+			}
+
+			if (digits >= 10000000)
+				exponent++;
+			else if (digits < 1000000)
+				exponent--;
+			else
+				break;
+		}
+	}
+
+	char text[16];
+	size_t n = 0;
+	text[n++] = ',';
+
+	if (isNegative(value))
+		text[n++] = '-';
+
+	n += writeDecimal(digits / 1000000, 1, text + n);
+	text[n++] = '.';
+	n += writeDecimal(digits % 1000000, 6, text + n);
+	text[n++] = 'E';
+	text[n++] = exponent < 0 ? '-' : '+';
+	n += writeDecimal(static_cast<uint64_t>(exponent < 0 ? -exponent : exponent), 2, text + n);
+
+	append(text, n);
+}
+
+void CommandEncoder::textField(const char* value)
+{
+	append(",", 1);
+	append(value, strlen(value));
+}
+
+size_t CommandEncoder::finalize(ErrorDetectionMode errorDetectionMode)
+{
+	append("*", 1);
+
+	char code[MaximumErrorDetectionCodeLength];
+	append(code, writeErrorDetectionCode(errorDetectionMode, _buffer + 1, _length - 2, code));
+
+	if (_length < _size)
+		_buffer[_length] = '\0';
+
+	return _length;
+}
+
+size_t CommandEncoder::writeErrorDetectionCode(ErrorDetectionMode errorDetectionMode, const char* body, size_t length, char* code)
+{
+	size_t n = 0;
+
+	if (errorDetectionMode == ERRORDETECTIONMODE_CHECKSUM)
+	{
+		uint8_t checksum = Checksum8::compute(body, length);
+
+		code[n++] = HexDigits[checksum >> 4];
+		code[n++] = HexDigits[checksum & 0xF];
+	}
+	else if (errorDetectionMode == ERRORDETECTIONMODE_CRC)
+	{
+		uint16_t crc = Crc16::compute(body, length);
+
+		for (int shift = 12; shift >= 0; shift -= 4)
+			code[n++] = HexDigits[(crc >> shift) & 0xF];
+	}
+	else
+	{
+		code[n++] = 'X';
+		code[n++] = 'X';
+	}
+
+	code[n++] = '\r';
+	code[n++] = '\n';
+
+	return n;
+}
+
+void CommandEncoder::ensureFits(size_t length)
+{
+	if (length > _size - _length)
+		throw invalid_operation("Command does not fit in the buffer.");
+}
+
+void CommandEncoder::appendFormatted(const char* format, double value)
+{
+	// Large enough for any double formatted with %f.
+	char text[512];
+
+	#if VN_HAVE_SECURE_CRT
+	int length = sprintf_s(text, sizeof(text), format, value);
+	#else
+	int length = sprintf(text, format, value);
+	#endif
+
+	append(text, static_cast<size_t>(length));
+}
+
+}
+}
+}
@@ -0,0 +1,211 @@
+#include "gtest/gtest.h"
+
+#include "vn/commandencoder.h"
+#include "vn/error_detection.h"
+#include "vn/exceptions.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <string>
+
+using namespace std;
+using namespace vn::protocol::uart;
+using namespace vn::data::integrity;
+
+namespace {
+
+// Deterministic generator so every run sees the same values.
+class EncoderRandom
+{
+public:
+	EncoderRandom() : _state(88172645463325252ULL) { }
+
+	uint64_t next()
+	{
+		_state ^= _state << 13;
+		_state ^= _state >> 7;
+		_state ^= _state << 17;
+
+		return _state;
+	}
+
+private:
+	uint64_t _state;
+};
+
+double doubleFromBits(uint64_t bits)
+{
+	double value;
+	memcpy(&value, &bits, sizeof(value));
+
+	return value;
+}
+
+// Large enough for any double formatted with %f.
+char Buffer[1024];
+
+// The length of "*XX\r\n", which finalize appends without error detection.
+const size_t UncheckedEndingLength = 5;
+
+// The field a CommandEncoder appends after the prefix, without the comma.
+string encodedFloat(double value)
+{
+	CommandEncoder e(Buffer, sizeof(Buffer), "$");
+	e.floatField(value);
+	size_t length = e.finalize(ERRORDETECTIONMODE_NONE);
+
+	return string(Buffer + 2, Buffer + length - UncheckedEndingLength);
+}
+
+string encodedScientific(double value)
+{
+	CommandEncoder e(Buffer, sizeof(Buffer), "$");
+	e.scientificField(value);
+	size_t length = e.finalize(ERRORDETECTIONMODE_NONE);
+
+	return string(Buffer + 2, Buffer + length - UncheckedEndingLength);
+}
+
+string formatted(const char* format, double value)
+{
+	char text[1024];
+	sprintf(text, format, value);
+
+	return text;
+}
+
+// Values printf has to get right which a shortcut easily gets wrong.
+const double EdgeValues[] =
+{
+	0.0, -0.0, 1.0, -1.0, 0.1, 0.5, 1.5, 2.5, 1e-6, 5e-7, 4.9999999e-7,
+	0.0078125, -0.0078125, 0.0234375, 0.0000005, 0.9999995, 0.99999949999,
+	9.9999995, 12345.125, 12345.135, 1234567.5, 99999999.5, 0.000015,
+	1e15, 1e16, 1e17, 1e22, 1e23, -1e23, 123456789012.345678, 4294967295.0,
+	18446744073709551615.0, 1e300, -1e300, 1.7976931348623157e308,
+	-1.7976931348623157e308, 2.2250738585072014e-308, 2.225073858507201e-308,
+	4.9406564584124654e-324, -4.9406564584124654e-324, 1e-310, 3.4028234663852886e38,
+	1.1754943508222875e-38, 1.401298464324817e-45, 360.0, -179.99999, 9.80665
+};
+
+}
+
+TEST(CommandEncoderTest, FloatFieldMatchesPrintfForEdgeValues)
+{
+	for (size_t i = 0; i < sizeof(EdgeValues) / sizeof(EdgeValues[0]); i++)
+		EXPECT_EQ(formatted("%f", EdgeValues[i]), encodedFloat(EdgeValues[i])) << "value " << EdgeValues[i];
+}
+
+TEST(CommandEncoderTest, ScientificFieldMatchesPrintfForEdgeValues)
+{
+	for (size_t i = 0; i < sizeof(EdgeValues) / sizeof(EdgeValues[0]); i++)
+		EXPECT_EQ(formatted("%E", EdgeValues[i]), encodedScientific(EdgeValues[i])) << "value " << EdgeValues[i];
+}
+
+TEST(CommandEncoderTest, FloatingPointFieldsMatchPrintfForNonFiniteValues)
+{
+	const double Values[] =
+	{
+		numeric_limits<double>::infinity(),
+		-numeric_limits<double>::infinity(),
+		numeric_limits<double>::quiet_NaN()
+	};
+
+	for (size_t i = 0; i < sizeof(Values) / sizeof(Values[0]); i++)
+	{
+		EXPECT_EQ(formatted("%f", Values[i]), encodedFloat(Values[i]));
+		EXPECT_EQ(formatted("%E", Values[i]), encodedScientific(Values[i]));
+	}
+}
+
+TEST(CommandEncoderTest, FloatingPointFieldsMatchPrintfForRandomValues)
+{
+	EncoderRandom rnd;
+
+	for (size_t i = 0; i < 20000; i++)
+	{
+		uint64_t r = rnd.next();
+		double value;
+
+		// Mostly floats in the range register values take, as the encoder
+		// is mostly given those, with arbitrary doubles in between.
+		if (r % 4 == 0)
+		{
+			value = doubleFromBits(rnd.next());
+
+			if (value != value || value - value != 0)
+				continue;
+		}
+		else
+		{
+			float f = static_cast<float>(static_cast<int64_t>(rnd.next()) >> 20);
+			value = static_cast<float>(ldexp(f, -static_cast<int>(r % 40)));
+		}
+
+		ASSERT_EQ(formatted("%f", value), encodedFloat(value)) << "value " << value;
+		ASSERT_EQ(formatted("%E", value), encodedScientific(value)) << "value " << value;
+	}
+}
+
+TEST(CommandEncoderTest, IntegerFieldsMatchPrintf)
+{
+	EncoderRandom rnd;
+	char expected[64];
+
+	const uint32_t EdgeValues[] = { 0, 1, 9, 10, 0x7FFFFFFF, 0x80000000, 0xFFFFFFFF };
+
+	for (size_t i = 0; i < 5000 + sizeof(EdgeValues) / sizeof(EdgeValues[0]); i++)
+	{
+		uint32_t value = i < sizeof(EdgeValues) / sizeof(EdgeValues[0]) ? EdgeValues[i] : static_cast<uint32_t>(rnd.next() >> (rnd.next() % 32));
+		size_t minNumOfDigits = i % 4;
+
+		CommandEncoder e(Buffer, sizeof(Buffer), "$");
+		e.unsignedField(value, minNumOfDigits == 0 ? 1 : minNumOfDigits);
+		e.signedField(static_cast<int32_t>(value));
+		e.hexField(value);
+		e.finalize(ERRORDETECTIONMODE_NONE);
+
+		sprintf(expected, "$,%0*u,%d,%X*XX\r\n", static_cast<int>(minNumOfDigits == 0 ? 1 : minNumOfDigits), value, static_cast<int32_t>(value), value);
+
+		ASSERT_STREQ(expected, Buffer);
+	}
+}
+
+TEST(CommandEncoderTest, FinalizeAppendsTheSameCodeAsPrintf)
+{
+	const char Body[] = "VNWRG,35,1,0,1,1";
+	char expected[64];
+
+	CommandEncoder checksum(Buffer, sizeof(Buffer), "$VNWRG,35");
+	checksum.textField("1,0,1,1");
+	size_t length = checksum.finalize(ERRORDETECTIONMODE_CHECKSUM);
+
+	sprintf(expected, "$%s*%02X\r\n", Body, Checksum8::compute(Body, sizeof(Body) - 1));
+	EXPECT_EQ(strlen(expected), length);
+	EXPECT_STREQ(expected, Buffer);
+
+	CommandEncoder crc(Buffer, sizeof(Buffer), "$VNWRG,35");
+	crc.textField("1,0,1,1");
+	crc.finalize(ERRORDETECTIONMODE_CRC);
+
+	sprintf(expected, "$%s*%04X\r\n", Body, Crc16::compute(Body, sizeof(Body) - 1));
+	EXPECT_STREQ(expected, Buffer);
+
+	CommandEncoder none(Buffer, sizeof(Buffer), "$VNWRG,35");
+	none.textField("1,0,1,1");
+	none.finalize(ERRORDETECTIONMODE_NONE);
+
+	sprintf(expected, "$%s*XX\r\n", Body);
+	EXPECT_STREQ(expected, Buffer);
+}
+
+TEST(CommandEncoderTest, ThrowsRatherThanOverrunningTheBuffer)
+{
+	char small[16];
+
+	CommandEncoder e(small, sizeof(small), "$VNWRG,35");
+	e.unsignedField(1);
+
+	EXPECT_THROW(e.floatField(1e10), vn::invalid_operation);
+}
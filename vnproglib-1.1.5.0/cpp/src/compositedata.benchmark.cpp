@@ -0,0 +1,75 @@
+#include "benchmark/benchmark.h"
+#include "benchmark.h"
+
+#include "vn/compositedata.h"
+#include "vn/binaryplan.h"
+
+#include <vector>
+
+using namespace std;
+using namespace vn::sensors;
+using namespace vn::protocol::uart;
+
+namespace {
+
+// Stands in for a capture of the ROS node's binary output.
+vector<vector<char> > makeCapturedPackets()
+{
+	vector<vector<char> > packets;
+
+	for (uint32_t i = 0; i < 256; i++)
+		packets.push_back(makeInsAndImuPacket(i));
+
+	return packets;
+}
+
+// Walks the group fields the way every packet was handled before plans were
+// cached.
+void BinaryPlan_Build(benchmark::State& state)
+{
+	vector<char> packet = makeInsAndImuPacket(0);
+	BinaryPlan plan;
+
+	while (state.KeepRunning())
+	{
+		plan.build(&packet[0]);
+		benchmark::DoNotOptimize(plan.length);
+	}
+}
+
+void Packet_ComputeBinaryPacketLength(benchmark::State& state)
+{
+	vector<char> packet = makeInsAndImuPacket(0);
+
+	// Cache the plan as the finder does when it first sees a valid packet.
+	BinaryPlan scratch;
+	BinaryPlan::get(&packet[0], scratch);
+
+	while (state.KeepRunning())
+		benchmark::DoNotOptimize(Packet::computeBinaryPacketLength(&packet[0]));
+}
+
+void CompositeData_ParseCapture(benchmark::State& state)
+{
+	vector<vector<char> > packets = makeCapturedPackets();
+	CompositeData cd;
+
+	while (state.KeepRunning())
+	{
+		for (size_t i = 0; i < packets.size(); i++)
+		{
+			PacketView p(&packets[i][0], packets[i].size());
+			CompositeData::parse(p, cd);
+		}
+
+		benchmark::DoNotOptimize(cd);
+	}
+
+	state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * packets.size()));
+}
+
+}
+
+BENCHMARK(BinaryPlan_Build);
+BENCHMARK(Packet_ComputeBinaryPacketLength);
+BENCHMARK(CompositeData_ParseCapture);
@@ -1,1971 +1,727 @@
 #include "vn/compositedata.h"
+#include "vn/columnarbatch.h"
 #include "vn/conversions.h"
+#include "vn/binaryplan.h"
+#include "vn/utilities.h"
 
-using namespace std;
-using namespace vn::math;
-using namespace vn::protocol::uart;
-
-namespace vn {
-namespace sensors {
-
-typedef vector<CompositeData*>::iterator cditer;
-
-struct CompositeData::Impl
-{
-	enum AttitudeType
-	{
-		CDATT_None,
-		CDATT_YawPitchRoll,
-		CDATT_Quaternion,
-		CDATT_DirectionCosineMatrix
-	};
-
-	enum AccelerationType
-	{
-		CDACC_None,
-		CDACC_Normal,
-		CDACC_Uncompensated,
-		CDACC_LinearBody,
-		CDACC_LinearNed,
-		CDACC_Ned,
-		CDACC_Ecef,
-		CDACC_LinearEcef,
-	};
-
-	enum MagneticType
-	{
-		CDMAG_None,
-		CDMAG_Normal,
-		CDMAG_Uncompensated,
-		CDMAG_Ned,
-		CDMAG_Ecef,
-	};
-
-	enum AngularRateType
-	{
-		CDANR_None,
-		CDANR_Normal,
-		CDANR_Uncompensated,
-	};
-
-	enum TemperatureType
-	{
-		CDTEM_None,
-		CDTEM_Normal,
-	};
-
-	enum PressureType
-	{
-		CDPRE_None,
-		CDPRE_Normal
-	};
-
-	enum PositionType
-	{
-		CDPOS_None,
-    CDPOS_GpsLla,
-    CDPOS_Gps2Lla,
-    CDPOS_GpsEcef,
-    CDPOS_Gps2Ecef,
-    CDPOS_EstimatedLla,
-		CDPOS_EstimatedEcef
-	};
-
-	enum VelocityType
-	{
-		CDVEL_None,
-    CDVEL_GpsNed,
-    CDVEL_Gps2Ned,
-    CDVEL_GpsEcef,
-    CDVEL_Gps2Ecef,
-    CDVEL_EstimatedNed,
-		CDVEL_EstimatedEcef,
-		CDVEL_EstimatedBody
-	};
-
-	enum PositionUncertaintyType
-	{
-		CDPOU_None,
-    CDPOU_GpsNed,
-    CDPOU_Gps2Ned,
-    CDPOU_GpsEcef,
-    CDPOU_Gps2Ecef,
-    CDPOU_Estimated
-	};
-
-	enum VelocityUncertaintyType
-	{
-		CDVEU_None,
-    CDVEU_Gps,
-    CDVEU_Gps2,
-    CDVEU_Estimated
-	};
-
-	AttitudeType mostRecentlyUpdatedAttitudeType;
-	MagneticType mostRecentlyUpdatedMagneticType;
-	AccelerationType mostRecentlyUpdatedAccelerationType;
-	AngularRateType mostRecentlyUpdatedAngularRateType;
-	TemperatureType mostRecentlyUpdatedTemperatureType;
-	PressureType mostRecentlyUpdatePressureType;
-	PositionType mostRecentlyUpdatedPositionType;
-	VelocityType mostRecentlyUpdatedVelocityType;
-	PositionUncertaintyType mostRecentlyUpdatedPositionUncertaintyType;
-	VelocityUncertaintyType mostRecentlyUpdatedVelocityUncertaintyType;
-	bool hasYawPitchRoll, hasQuaternion, hasDirectionCosineMatrix,
-		hasMagnetic, hasMagneticUncompensated, hasMagneticNed, hasMagneticEcef,
-		hasAcceleration, hasAccelerationLinearBody, hasAccelerationUncompensated, hasAccelerationLinearNed, hasAccelerationLinearEcef, hasAccelerationNed, hasAccelerationEcef,
-		hasAngularRate, hasAngularRateUncompensated,
-		hasTemperature, hasPressure,
-    hasPositionGpsLla, hasPositionGps2Lla, hasPositionGpsEcef, hasPositionGps2Ecef, hasPositionEstimatedLla, hasPositionEstimatedEcef,
-    hasVelocityGpsNed, hasVelocityGps2Ned, hasVelocityGpsEcef, hasVelocityGps2Ecef, hasVelocityEstimatedNed, hasVelocityEstimatedEcef, hasVelocityEstimatedBody,
-		hasDeltaTime, hasDeltaTheta, hasDeltaVelocity,
-		hasTimeStartup, hasTimeGps, hasTimeGps2, hasTow, hasWeek, hasGpsWeek, hasGps2Week, hasNumSats, hasNumSats2, hasTimeSyncIn, hasVpeStatus, hasInsStatus,
-    hasSyncInCnt, hasSyncOutCnt, hasTimeStatus, hasTimeGpsPps, hasTimeGps2Pps, hasGpsTow, hasGps2Tow, hasTimeUtc, hasTimeUtc2, hasSensSat, hasFix, hasFix2,
-    hasPositionUncertaintyGpsNed, hasPositionUncertaintyGps2Ned, hasPositionUncertaintyGpsEcef, hasPositionUncertaintyGps2Ecef, hasPositionUncertaintyEstimated,
-    hasVelocityUncertaintyGps, hasVelocityUncertaintyGps2, hasVelocityUncertaintyEstimated, hasTimeUncertainty, hasTimeUncertainty2, hasAttitudeUncertainty,
-    hasTimeInfo, hasTimeInfo2, hasDop, hasDop2;
-	vec3f yawPitchRoll,
-		magnetic, magneticUncompensated, magneticNed, magneticEcef,
-		acceleration, accelerationLinearBody, accelerationUncompensated, accelerationLinearNed, accelerationLinearEcef, accelerationNed, accelerationEcef,
-		angularRate, angularRateUncompensated,
-    velocityGpsNed, velocityGps2Ned, velocityGpsEcef, velocityGps2Ecef, velocityEstimatedNed, velocityEstimatedEcef, velocityEstimatedBody,
-		deltaTheta, deltaVelocity, positionUncertaintyGpsNed, positionUncertaintyGps2Ned, positionUncertaintyGpsEcef, positionUncertaintyGps2Ecef, attitudeUncertainty;
-	vec3d positionGpsLla, positionGps2Lla, positionGpsEcef, positionGps2Ecef, positionEstimatedLla, positionEstimatedEcef;
-	vec4f quaternion;
-	mat3f directionConsineMatrix;
-	float temperature, pressure, deltaTime, positionUncertaintyEstimated,
-    velocityUncertaintyGps, velocityUncertaintyGps2, velocityUncertaintyEstimated;
-	uint64_t timeStartup, timeGps, timeGps2, timeSyncIn, timeGpsPps, timeGps2Pps, gpsTow, gps2Tow;
-	double tow;
-	uint16_t week, gpsWeek, gps2Week;
-	uint8_t numSats, numSats2, timeStatus;
-	VpeStatus vpeStatus;
-	InsStatus insStatus;
-  uint32_t syncInCnt, syncOutCnt, timeUncertainty, timeUncertainty2;
-  GpsFix fix;
-  GpsFix fix2;
-  TimeUtc timeUtc;
-  TimeUtc timeUtc2;
-  SensSat sensSat;
-  TimeInfo timeInfo;
-  TimeInfo timeInfo2;
-  GnssDop dop;
-  GnssDop dop2;
-
-	Impl& operator=(Impl& aImpl)
-	{
-		yawPitchRoll = aImpl.yawPitchRoll;
-		magnetic = aImpl.magnetic;
-		magneticUncompensated = aImpl.magneticUncompensated;
-		magneticNed = aImpl.magneticNed;
-		magneticEcef = aImpl.magneticEcef;
-		acceleration = aImpl.acceleration;
-		accelerationLinearBody = aImpl.accelerationLinearBody;
-		accelerationUncompensated = aImpl.accelerationUncompensated;
-		accelerationLinearNed = aImpl.accelerationLinearNed;
-		accelerationLinearEcef = aImpl.accelerationLinearEcef;
-		accelerationNed = aImpl.accelerationNed;
-		accelerationEcef = aImpl.accelerationEcef;
-		angularRate = aImpl.angularRate;
-		angularRateUncompensated = aImpl.angularRateUncompensated;
-    velocityGpsNed = aImpl.velocityGpsNed;
-    velocityGps2Ned = aImpl.velocityGps2Ned;
-    velocityGpsEcef = aImpl.velocityGpsEcef;
-    velocityGps2Ecef = aImpl.velocityGps2Ecef;
-    velocityEstimatedNed = aImpl.velocityEstimatedNed;
-		velocityEstimatedEcef = aImpl.velocityEstimatedEcef;
-		velocityEstimatedBody = aImpl.velocityEstimatedBody;
-		deltaTheta = aImpl.deltaTheta;
-		deltaVelocity = aImpl.deltaVelocity;
-    positionUncertaintyGpsNed = aImpl.positionUncertaintyGpsNed;
-    positionUncertaintyGps2Ned = aImpl.positionUncertaintyGps2Ned;
-    positionUncertaintyGpsEcef = aImpl.positionUncertaintyGpsEcef;
-    positionUncertaintyGps2Ecef = aImpl.positionUncertaintyGps2Ecef;
-    attitudeUncertainty = aImpl.attitudeUncertainty;
-    positionGpsLla = aImpl.positionGpsLla;
-    positionGps2Lla = aImpl.positionGps2Lla;
-    positionGpsEcef = aImpl.positionGpsEcef;
-    positionGps2Ecef = aImpl.positionGps2Ecef;
-    positionEstimatedLla = aImpl.positionEstimatedLla;
-		positionEstimatedEcef = aImpl.positionEstimatedEcef;
-		quaternion = aImpl.quaternion;
-		directionConsineMatrix = aImpl.directionConsineMatrix;
-
-		temperature = aImpl.temperature;
-		pressure = aImpl.pressure;
-		deltaTime = aImpl.deltaTime;
-		positionUncertaintyEstimated = aImpl.positionUncertaintyEstimated;
-    velocityUncertaintyGps = aImpl.velocityUncertaintyGps;
-    velocityUncertaintyGps2 = aImpl.velocityUncertaintyGps2;
-    velocityUncertaintyEstimated = aImpl.velocityUncertaintyEstimated;
-		timeStartup = aImpl.timeStartup;
-    timeGps = aImpl.timeGps;
-    timeGps2 = aImpl.timeGps2;
-    timeUtc = aImpl.timeUtc;
-    timeUtc2 = aImpl.timeUtc2;
-    timeSyncIn = aImpl.timeSyncIn;
-    timeGpsPps = aImpl.timeGpsPps;
-    timeGps2Pps = aImpl.timeGps2Pps;
-    gpsTow = aImpl.gpsTow;
-    gps2Tow = aImpl.gps2Tow;
-    tow = aImpl.tow;
-    week = aImpl.week;
-    gpsWeek = aImpl.gpsWeek;
-    gps2Week = aImpl.gps2Week;
-    numSats = aImpl.numSats;
-    numSats2 = aImpl.numSats2;
-    insStatus = aImpl.insStatus;
-		syncInCnt = aImpl.syncInCnt;
-    syncOutCnt = aImpl.syncOutCnt;
-    timeStatus = aImpl.timeStatus;
-    timeUncertainty = aImpl.timeUncertainty;
-    timeUncertainty2 = aImpl.timeUncertainty2;
-    fix = aImpl.fix;
-		sensSat = aImpl.sensSat;
-    timeInfo = aImpl.timeInfo;
-    dop = aImpl.dop;
-    dop2 = aImpl.dop2;
-
-		mostRecentlyUpdatedAttitudeType = aImpl.mostRecentlyUpdatedAttitudeType;
-		mostRecentlyUpdatedMagneticType = aImpl.mostRecentlyUpdatedMagneticType;
-		mostRecentlyUpdatedAccelerationType = aImpl.mostRecentlyUpdatedAccelerationType;
-		mostRecentlyUpdatedAngularRateType = aImpl.mostRecentlyUpdatedAngularRateType;
-		mostRecentlyUpdatedTemperatureType = aImpl.mostRecentlyUpdatedTemperatureType;
-		mostRecentlyUpdatePressureType = aImpl.mostRecentlyUpdatePressureType;
-		mostRecentlyUpdatedPositionType = aImpl.mostRecentlyUpdatedPositionType;
-		mostRecentlyUpdatedVelocityType = aImpl.mostRecentlyUpdatedVelocityType;
-		mostRecentlyUpdatedPositionUncertaintyType = aImpl.mostRecentlyUpdatedPositionUncertaintyType;
-		mostRecentlyUpdatedVelocityUncertaintyType = aImpl.mostRecentlyUpdatedVelocityUncertaintyType;
-		hasYawPitchRoll = aImpl.hasYawPitchRoll;
-		hasQuaternion = aImpl.hasQuaternion;
-		hasDirectionCosineMatrix = aImpl.hasDirectionCosineMatrix;
-		hasMagnetic = aImpl.hasMagnetic;
-		hasMagneticUncompensated = aImpl.hasMagneticUncompensated;
-		hasMagneticNed = aImpl.hasMagneticNed;
-		hasMagneticEcef = aImpl.hasMagneticEcef;
-		hasAcceleration = aImpl.hasAcceleration;
-		hasAccelerationLinearBody = aImpl.hasAccelerationLinearBody;
-		hasAccelerationUncompensated = aImpl.hasAccelerationUncompensated;
-		hasAccelerationLinearNed = aImpl.hasAccelerationLinearNed;
-		hasAccelerationLinearEcef = aImpl.hasAccelerationLinearEcef;
-		hasAccelerationNed = aImpl.hasAccelerationNed;
-		hasAccelerationEcef = aImpl.hasAccelerationEcef;
-		hasAngularRate = aImpl.hasAngularRate;
-		hasAngularRateUncompensated = aImpl.hasAngularRateUncompensated;
-		hasTemperature = aImpl.hasTemperature;
-		hasPressure = aImpl.hasPressure;
-    hasPositionGpsLla = aImpl.hasPositionGpsLla;
-    hasPositionGps2Lla = aImpl.hasPositionGps2Lla;
-    hasPositionGpsEcef = aImpl.hasPositionGpsEcef;
-    hasPositionGps2Ecef = aImpl.hasPositionGps2Ecef;
-    hasPositionEstimatedLla = aImpl.hasPositionEstimatedLla;
-		hasPositionEstimatedEcef = aImpl.hasPositionEstimatedEcef;
-    hasVelocityGpsNed = aImpl.hasVelocityGpsNed;
-    hasVelocityGps2Ned = aImpl.hasVelocityGps2Ned;
-    hasVelocityGpsEcef = aImpl.hasVelocityGpsEcef;
-    hasVelocityGps2Ecef = aImpl.hasVelocityGps2Ecef;
-    hasVelocityEstimatedNed = aImpl.hasVelocityEstimatedNed;
-		hasVelocityEstimatedEcef = aImpl.hasVelocityEstimatedEcef;
-		hasVelocityEstimatedBody = aImpl.hasVelocityEstimatedBody;
-		hasDeltaTime = aImpl.hasDeltaTime;
-		hasDeltaTheta = aImpl.hasDeltaTheta;
-		hasDeltaVelocity = aImpl.hasDeltaVelocity;
-		hasTimeStartup = aImpl.hasTimeStartup;
-    hasTimeGps = aImpl.hasTimeGps;
-    hasTimeGps2 = aImpl.hasTimeGps2;
-    hasTow = aImpl.hasTow;
-    hasWeek = aImpl.hasWeek;
-    hasGpsWeek = aImpl.hasGpsWeek;
-    hasGps2Week = aImpl.hasGps2Week;
-    hasNumSats = aImpl.hasNumSats;
-    hasNumSats2 = aImpl.hasNumSats2;
-    hasTimeSyncIn = aImpl.hasTimeSyncIn;
-		hasVpeStatus = aImpl.hasVpeStatus;
-		hasInsStatus = aImpl.hasInsStatus;
-		hasSyncInCnt = aImpl.hasSyncInCnt;
-    hasSyncOutCnt = aImpl.hasSyncOutCnt;
-    hasTimeStatus = aImpl.hasTimeStatus;
-    hasTimeGpsPps = aImpl.hasTimeGpsPps;
-    hasTimeGps2Pps = aImpl.hasTimeGps2Pps;
-    hasGpsTow = aImpl.hasGpsTow;
-    hasGps2Tow = aImpl.hasGps2Tow;
-    hasTimeUtc = aImpl.hasTimeUtc;
-    hasTimeUtc2 = aImpl.hasTimeUtc2;
-    hasSensSat = aImpl.hasSensSat;
-		hasFix = aImpl.hasFix;
-    hasPositionUncertaintyGpsNed = aImpl.hasPositionUncertaintyGpsNed;
-    hasPositionUncertaintyGps2Ned = aImpl.hasPositionUncertaintyGps2Ned;
-    hasPositionUncertaintyGpsEcef = aImpl.hasPositionUncertaintyGpsEcef;
-    hasPositionUncertaintyGps2Ecef = aImpl.hasPositionUncertaintyGps2Ecef;
-    hasPositionUncertaintyEstimated = aImpl.hasPositionUncertaintyEstimated;
-    hasVelocityUncertaintyGps = aImpl.hasVelocityUncertaintyGps;
-    hasVelocityUncertaintyGps2 = aImpl.hasVelocityUncertaintyGps2;
-    hasVelocityUncertaintyEstimated = aImpl.hasVelocityUncertaintyEstimated;
-    hasTimeUncertainty = aImpl.hasTimeUncertainty;
-    hasTimeUncertainty2 = aImpl.hasTimeUncertainty2;
-    hasAttitudeUncertainty = aImpl.hasAttitudeUncertainty;
-    hasTimeInfo = aImpl.hasTimeInfo;
-    hasTimeInfo2 = aImpl.hasTimeInfo2;
-    hasDop = aImpl.hasDop;
-    hasDop2 = aImpl.hasDop2;
-
-		return *this;
-	}
-
-	void reset()
-	{
-		mostRecentlyUpdatedAttitudeType = CDATT_None;
-		mostRecentlyUpdatedMagneticType = CDMAG_None;
-		mostRecentlyUpdatedAccelerationType = CDACC_None;
-		mostRecentlyUpdatedAngularRateType = CDANR_None;
-		mostRecentlyUpdatedTemperatureType = CDTEM_None;
-		mostRecentlyUpdatePressureType = CDPRE_None;
-		mostRecentlyUpdatedPositionType = CDPOS_None;
-		mostRecentlyUpdatedVelocityType = CDVEL_None;
-		mostRecentlyUpdatedPositionUncertaintyType = CDPOU_None;
-		mostRecentlyUpdatedVelocityUncertaintyType = CDVEU_None;
-		hasYawPitchRoll = false;
-		hasQuaternion = false;
-		hasDirectionCosineMatrix = false;
-		hasMagnetic = false;
-		hasMagneticUncompensated = false;
-		hasMagneticNed = false;
-		hasMagneticEcef = false;
-		hasAcceleration = false;
-		hasAccelerationLinearBody = false;
-		hasAccelerationUncompensated = false;
-		hasAccelerationLinearNed = false;
-		hasAccelerationLinearEcef = false;
-		hasAccelerationNed = false;
-		hasAccelerationEcef = false;
-		hasAngularRate = false;
-		hasAngularRateUncompensated = false;
-		hasTemperature = false;
-		hasPressure = false;
-    hasPositionGpsLla = false;
-    hasPositionGps2Lla = false;
-    hasPositionGpsEcef = false;
-    hasPositionGps2Ecef = false;
-    hasPositionEstimatedLla = false;
-		hasPositionEstimatedEcef = false;
-    hasVelocityGpsNed = false;
-    hasVelocityGps2Ned = false;
-    hasVelocityGpsEcef = false;
-    hasVelocityGps2Ecef = false;
-    hasVelocityEstimatedNed = false;
-		hasVelocityEstimatedEcef = false;
-		hasVelocityEstimatedBody = false;
-		hasDeltaTime = false;
-		hasDeltaTheta = false;
-		hasDeltaVelocity = false;
-		hasTimeStartup = false;
-    hasTimeGps = false;
-    hasTimeGps2 = false;
-    hasTow = false;
-    hasWeek = false;
-    hasGpsWeek = false;
-    hasGps2Week = false;
-    hasNumSats = false;
-    hasNumSats2 = false;
-    hasTimeSyncIn = false;
-		hasVpeStatus = false;
-		hasInsStatus = false;
-		hasSyncInCnt = false;
-    hasTimeGpsPps = false;
-    hasTimeGps2Pps = false;
-    hasGpsTow = false;
-    hasGps2Tow = false;
-    hasTimeUtc = false;
-    hasTimeUtc2 = false;
-    hasSensSat = false;
-		hasFix = false;
-    hasPositionUncertaintyGpsNed = false;
-    hasPositionUncertaintyGps2Ned = false;
-    hasPositionUncertaintyGpsEcef = false;
-    hasPositionUncertaintyGps2Ecef = false;
-    hasPositionUncertaintyEstimated = false;
-    hasVelocityUncertaintyGps = false;
-    hasVelocityUncertaintyGps2 = false;
-    hasVelocityUncertaintyEstimated = false;
-    hasTimeUncertainty = false;
-    hasTimeUncertainty2 = false;
-    hasAttitudeUncertainty = false;
-    hasTimeInfo = false;
-    hasTimeInfo2 = false;
-    hasDop = false;
-    hasDop2 = false;
-  }
-
-	void setYawPitchRoll(vec3f ypr)
-	{
-		mostRecentlyUpdatedAttitudeType = CDATT_YawPitchRoll;
-		hasYawPitchRoll = true;
-		yawPitchRoll = ypr;
-	}
-
-	void setQuaternion(vec4f quat)
-	{
-		mostRecentlyUpdatedAttitudeType = CDATT_Quaternion;
-		hasQuaternion = true;
-		quaternion = quat;
-	}
-
-	void setDirectionConsineMatrix(mat3f dcm)
-	{
-		mostRecentlyUpdatedAttitudeType = CDATT_DirectionCosineMatrix;
-		hasDirectionCosineMatrix = true;
-		directionConsineMatrix = dcm;
-	}
-
-	void setMagnetic(vec3f mag)
-	{
-		mostRecentlyUpdatedMagneticType = CDMAG_Normal;
-		hasMagnetic = true;
-		magnetic = mag;
-	}
-
-	void setMagneticUncompensated(vec3f mag)
-	{
-		mostRecentlyUpdatedMagneticType = CDMAG_Uncompensated;
-		hasMagneticUncompensated = true;
-		magneticUncompensated = mag;
-	}
-
-	void setMagneticNed(vec3f mag)
-	{
-		mostRecentlyUpdatedMagneticType = CDMAG_Ned;
-		hasMagneticNed = true;
-		magneticNed = mag;
-	}
-
-	void setMagneticEcef(vec3f mag)
-	{
-		mostRecentlyUpdatedMagneticType = CDMAG_Ecef;
-		hasMagneticEcef = true;
-		magneticEcef = mag;
-	}
-
-
-	void setAcceleration(vec3f accel)
-	{
-		mostRecentlyUpdatedAccelerationType = CDACC_Normal;
-		hasAcceleration = true;
-		acceleration = accel;
-	}
-
-	void setAccelerationLinearBody(vec3f accel)
-	{
-		mostRecentlyUpdatedAccelerationType = CDACC_LinearBody;
-		hasAccelerationLinearBody = true;
-		accelerationLinearBody = accel;
-	}
-
-	void setAccelerationUncompensated(vec3f accel)
-	{
-		mostRecentlyUpdatedAccelerationType = CDACC_Uncompensated;
-		hasAccelerationUncompensated = true;
-		accelerationUncompensated = accel;
-	}
-
-	void setAccelerationLinearNed(vec3f accel)
-	{
-		mostRecentlyUpdatedAccelerationType = CDACC_LinearNed;
-		hasAccelerationLinearNed = true;
-		accelerationLinearNed = accel;
-	}
-
-	void setAccelerationLinearEcef(vec3f accel)
-	{
-		mostRecentlyUpdatedAccelerationType = CDACC_LinearEcef;
-		hasAccelerationLinearEcef = true;
-		accelerationLinearEcef = accel;
-	}
-
-	void setAccelerationNed(vec3f accel)
-	{
-		mostRecentlyUpdatedAccelerationType = CDACC_Ned;
-		hasAccelerationNed = true;
-		accelerationNed = accel;
-	}
-
-	void setAccelerationEcef(vec3f accel)
-	{
-		mostRecentlyUpdatedAccelerationType = CDACC_Ecef;
-		hasAccelerationEcef = true;
-		accelerationEcef = accel;
-	}
-
-
-	void setAngularRate(vec3f ar)
-	{
-		mostRecentlyUpdatedAngularRateType = CDANR_Normal;
-		hasAngularRate = true;
-		angularRate = ar;
-	}
-
-	void setAngularRateUncompensated(vec3f ar)
-	{
-		mostRecentlyUpdatedAngularRateType = CDANR_Uncompensated;
-		hasAngularRateUncompensated = true;
-		angularRateUncompensated = ar;
-	}
-
-
-	void setTemperature(float temp)
-	{
-		mostRecentlyUpdatedTemperatureType = CDTEM_Normal;
-		hasTemperature = true;
-		temperature = temp;
-	}
-
-
-	void setPressure(float pres)
-	{
-		mostRecentlyUpdatePressureType = CDPRE_Normal;
-		hasPressure = true;
-		pressure = pres;
-	}
-
-  void setPositionGpsLla(vec3d pos)
-  {
-    mostRecentlyUpdatedPositionType = CDPOS_GpsLla;
-    hasPositionGpsLla = true;
-    positionGpsLla = pos;
-  }
-
-  void setPositionGps2Lla(vec3d pos)
-  {
-    mostRecentlyUpdatedPositionType = CDPOS_Gps2Lla;
-    hasPositionGps2Lla = true;
-    positionGps2Lla = pos;
-  }
-
-  void setPositionGpsEcef(vec3d pos)
-  {
-    mostRecentlyUpdatedPositionType = CDPOS_GpsEcef;
-    hasPositionGpsEcef = true;
-    positionGpsEcef = pos;
-  }
-
-  void setPositionGps2Ecef(vec3d pos)
-  {
-    mostRecentlyUpdatedPositionType = CDPOS_Gps2Ecef;
-    hasPositionGps2Ecef = true;
-    positionGps2Ecef = pos;
-  }
-
-  void setPositionEstimatedLla(vec3d pos)
-	{
-		mostRecentlyUpdatedPositionType = CDPOS_EstimatedLla;
-		hasPositionEstimatedLla = true;
-		positionEstimatedLla = pos;
-	}
-
-	void setPositionEstimatedEcef(vec3d pos)
-	{
-		mostRecentlyUpdatedPositionType = CDPOS_EstimatedEcef;
-		hasPositionEstimatedEcef = true;
-		positionEstimatedEcef = pos;
-	}
-
-  void setVelocityGpsNed(vec3f vel)
-  {
-    mostRecentlyUpdatedVelocityType = CDVEL_GpsNed;
-    hasVelocityGpsNed = true;
-    velocityGpsNed = vel;
-  }
-
-  void setVelocityGps2Ned(vec3f vel)
-  {
-    mostRecentlyUpdatedVelocityType = CDVEL_Gps2Ned;
-    hasVelocityGps2Ned = true;
-    velocityGps2Ned = vel;
-  }
-
-  void setVelocityGpsEcef(vec3f vel)
-  {
-    mostRecentlyUpdatedVelocityType = CDVEL_GpsEcef;
-    hasVelocityGpsEcef = true;
-    velocityGpsEcef = vel;
-  }
-
-  void setVelocityGps2Ecef(vec3f vel)
-  {
-    mostRecentlyUpdatedVelocityType = CDVEL_Gps2Ecef;
-    hasVelocityGps2Ecef = true;
-    velocityGps2Ecef = vel;
-  }
-
-  void setVelocityEstimatedNed(vec3f vel)
-	{
-		mostRecentlyUpdatedVelocityType = CDVEL_EstimatedNed;
-		hasVelocityEstimatedNed = true;
-		velocityEstimatedNed = vel;
-	}
-
-	void setVelocityEstimatedEcef(vec3f vel)
-	{
-		mostRecentlyUpdatedVelocityType = CDVEL_EstimatedEcef;
-		hasVelocityEstimatedEcef = true;
-		velocityEstimatedEcef = vel;
-	}
-
-	void setVelocityEstimatedBody(vec3f vel)
-	{
-		mostRecentlyUpdatedVelocityType = CDVEL_EstimatedBody;
-		hasVelocityEstimatedBody = true;
-		velocityEstimatedBody = vel;
-	}
-
-	void setDeltaTime(float time)
-	{
-		hasDeltaTime = true;
-		deltaTime = time;
-	}
-
-	void setDeltaTheta(vec3f theta)
-	{
-		hasDeltaTheta = true;
-		deltaTheta = theta;
-	}
-
-	void setDeltaVelocity(vec3f vel)
-	{
-		hasDeltaVelocity = true;
-		deltaVelocity = vel;
-	}
-
-	void setTimeStartup(uint64_t ts)
-	{
-		hasTimeStartup = true;
-		timeStartup = ts;
-	}
-
-  void setTimeGps(uint64_t time)
-  {
-    hasTimeGps = true;
-    timeGps = time;
-  }
-
-  void setTimeGps2(uint64_t time)
-  {
-    hasTimeGps2 = true;
-    timeGps2 = time;
-  }
-
-  void setTow(double t)
-  {
-    hasTow = true;
-    tow = t;
-  }
-
-  void setWeek(uint16_t w)
-  {
-    hasWeek = true;
-    week = w;
-  }
-
-  void setGpsWeek(uint16_t w)
-  {
-    hasGpsWeek = true;
-    gpsWeek = w;
-  }
-
-  void setGps2Week(uint16_t w)
-  {
-    hasGps2Week = true;
-    gps2Week = w;
-  }
-
-  void setNumSats(uint8_t s)
-  {
-    hasNumSats = true;
-    numSats = s;
-  }
-
-  void setNumSats2(uint8_t s)
-  {
-    hasNumSats2 = true;
-    numSats2 = s;
-  }
-
-  void setTimeSyncIn(uint64_t t)
-	{
-		hasTimeSyncIn = true;
-		timeSyncIn = t;
-	}
-
-	void setVpeStatus(VpeStatus s)
-	{
-		hasVpeStatus = true;
-		vpeStatus = s;
-	}
-
-	void setInsStatus(InsStatus s)
-	{
-		hasInsStatus = true;
-		insStatus = s;
-	}
-
-	void setSyncInCnt(uint32_t count)
-	{
-		hasSyncInCnt = true;
-		syncInCnt = count;
-	}
-
-  void setSyncOutCnt(uint32_t count)
-  {
-    hasSyncOutCnt = true;
-    syncOutCnt = count;
-  }
-
-  void setTimeStatus(uint8_t status)
-  {
-    hasTimeStatus = true;
-    timeStatus = status;
-  }
-
-  void setTimeGpsPps(uint64_t pps)
-  {
-    hasTimeGpsPps = true;
-    timeGpsPps = pps;
-  }
-
-  void setTimeGps2Pps(uint64_t pps)
-  {
-    hasTimeGps2Pps = true;
-    timeGps2Pps = pps;
-  }
-
-  void setGpsTow(uint64_t tow)
-  {
-    hasGpsTow = true;
-    gpsTow = tow;
-  }
-
-  void setGps2Tow(uint64_t tow)
-  {
-    hasGps2Tow = true;
-    gps2Tow = tow;
-  }
-
-  void setPositionUncertaintyGpsNed(vec3f u)
-  {
-    mostRecentlyUpdatedPositionUncertaintyType = CDPOU_GpsNed;
-    hasPositionUncertaintyGpsNed = true;
-    positionUncertaintyGpsNed = u;
-  }
-
-  void setPositionUncertaintyGps2Ned(vec3f u)
-  {
-    mostRecentlyUpdatedPositionUncertaintyType = CDPOU_Gps2Ned;
-    hasPositionUncertaintyGps2Ned = true;
-    positionUncertaintyGps2Ned = u;
-  }
-
-  void setPositionUncertaintyGpsEcef(vec3f u)
-	{
-		mostRecentlyUpdatedPositionUncertaintyType = CDPOU_GpsEcef;
-		hasPositionUncertaintyGpsEcef = true;
-		positionUncertaintyGpsEcef = u;
-	}
-
-  void setPositionUncertaintyGps2Ecef(vec3f u)
-  {
-    mostRecentlyUpdatedPositionUncertaintyType = CDPOU_Gps2Ecef;
-    hasPositionUncertaintyGps2Ecef = true;
-    positionUncertaintyGps2Ecef = u;
-  }
-
-  void setPositionUncertaintyEstimated(float u)
-	{
-		mostRecentlyUpdatedPositionUncertaintyType = CDPOU_Estimated;
-		hasPositionUncertaintyEstimated = true;
-		positionUncertaintyEstimated = u;
-	}
-
-  void setVelocityUncertaintyGps(float u)
-  {
-    mostRecentlyUpdatedVelocityUncertaintyType = CDVEU_Gps;
-    hasVelocityUncertaintyGps = true;
-    velocityUncertaintyGps = u;
-  }
-
-  void setVelocityUncertaintyGps2(float u)
-  {
-    mostRecentlyUpdatedVelocityUncertaintyType = CDVEU_Gps2;
-    hasVelocityUncertaintyGps2 = true;
-    velocityUncertaintyGps2 = u;
-  }
-
-  void setVelocityUncertaintyEstimated(float u)
-	{
-		mostRecentlyUpdatedVelocityUncertaintyType = CDVEU_Estimated;
-		hasVelocityUncertaintyEstimated = true;
-		velocityUncertaintyEstimated = u;
-	}
-
-  void setTimeUncertainty(uint32_t u)
-  {
-    hasTimeUncertainty = true;
-    timeUncertainty = u;
-  }
-
-  void setTimeUncertainty2(uint32_t u)
-  {
-    hasTimeUncertainty2 = true;
-    timeUncertainty2 = u;
-  }
-
-  void setAttitudeUncertainty(vec3f u)
-	{
-		hasAttitudeUncertainty = true;
-		attitudeUncertainty = u;
-	}
-
-  void setFix(GpsFix f)
-  {
-    hasFix = true;
-    fix = f;
-  }
-
-  void setFix2(GpsFix f)
-  {
-    hasFix2 = true;
-    fix2 = f;
-  }
-
-  void setTimeUtc(TimeUtc t)
-  {
-    hasTimeUtc = true;
-    timeUtc = t;
-  }
-
-  void setTimeUtc2(TimeUtc t)
-  {
-    hasTimeUtc2 = true;
-    timeUtc2 = t;
-  }
-
-  void setSensSat(SensSat s)
-	{
-		hasSensSat = true;
-		sensSat = s;
-	}
-
-  void setGnssDop(GnssDop d)
-  {
-    hasDop = true;
-    dop = d;
-  }
-
-  void setGnssDop2(GnssDop d)
-  {
-    hasDop2 = true;
-    dop2 = d;
-  }
-
-  void setTimeInfo(TimeInfo t)
-  {
-    hasTimeInfo = true;
-    timeInfo = t;
-  }
-
-  void setTimeInfo2(TimeInfo t)
-  {
-    hasTimeInfo2 = true;
-    timeInfo2 = t;
-  }
-};
-
-
-
-CompositeData::CompositeData() :
-_i(new Impl)
-{
-	_i->reset();
-}
-
-CompositeData::CompositeData(const CompositeData& cd) :
-_i(NULL)
-{
-	(*this) = cd;
-}
-
-
-CompositeData::~CompositeData()
-{
-	if (NULL != _i)
-	{
-		delete _i;
-		_i = NULL;
-	}
-}
-
-CompositeData& CompositeData::operator=(const CompositeData& RHS)
-{
-	if (NULL != _i)
-	{
-		delete _i;
-	}
-
-	_i = new Impl();
-	(*_i) = (*RHS._i);
-
-	return *this;
-}
-
-bool CompositeData::hasYawPitchRoll()
-{
-	return _i->hasYawPitchRoll;
-}
-
-vec3f CompositeData::yawPitchRoll()
-{
-	if (!hasYawPitchRoll())
-		throw invalid_operation();
-
-	return _i->yawPitchRoll;
-}
-
-bool CompositeData::hasQuaternion()
-{
-	return _i->hasQuaternion;
-}
-
-vec4f CompositeData::quaternion()
-{
-	if (!hasQuaternion())
-		throw invalid_operation();
-
-	return _i->quaternion;
-}
-
-bool CompositeData::hasDirectionCosineMatrix()
-{
-	return _i->hasDirectionCosineMatrix;
-}
-
-mat3f CompositeData::directionCosineMatrix()
-{
-	if (!hasDirectionCosineMatrix())
-		throw invalid_operation();
-
-	return _i->directionConsineMatrix;
-}
-
-bool CompositeData::hasAnyMagnetic()
-{
-	return _i->mostRecentlyUpdatedMagneticType != Impl::CDMAG_None;
-}
-
-vec3f CompositeData::anyMagnetic()
-{
-	switch (_i->mostRecentlyUpdatedMagneticType)
-	{
-	case Impl::CDMAG_None:
-		throw invalid_operation();
-	case Impl::CDMAG_Normal:
-		return _i->magnetic;
-	case Impl::CDMAG_Uncompensated:
-		return _i->magneticUncompensated;
-	case Impl::CDMAG_Ned:
-		return _i->magneticNed;
-	case Impl::CDMAG_Ecef:
-		return _i->magneticEcef;
-	default:
-		throw not_implemented();
-	}
-}
-
-bool CompositeData::hasMagnetic()
-{
-	return _i->hasMagnetic;
-}
-
-vec3f CompositeData::magnetic()
-{
-	if (!hasMagnetic())
-		throw invalid_operation();
-
-	return _i->magnetic;
-}
-
-bool CompositeData::hasMagneticUncompensated()
-{
-	return _i->hasMagneticUncompensated;
-}
-
-vec3f CompositeData::magneticUncompensated()
-{
-	if (!hasMagneticUncompensated())
-		throw invalid_operation();
-
-	return _i->magneticUncompensated;
-}
-
-bool CompositeData::hasMagneticNed()
-{
-	return _i->hasMagneticNed;
-}
-
-vec3f CompositeData::magneticNed()
-{
-	if (!hasMagneticNed())
-		throw invalid_operation();
-
-	return _i->magneticNed;
-}
-
-bool CompositeData::hasMagneticEcef()
-{
-	return _i->hasMagneticEcef;
-}
-
-vec3f CompositeData::magneticEcef()
-{
-	if (!hasMagneticEcef())
-		throw invalid_operation();
-
-	return _i->magneticEcef;
-}
-
-
-bool CompositeData::hasAnyAcceleration()
-{
-	return _i->mostRecentlyUpdatedAccelerationType != Impl::CDACC_None;
-}
-
-vec3f CompositeData::anyAcceleration()
-{
-	switch (_i->mostRecentlyUpdatedAccelerationType)
-	{
-	case Impl::CDACC_None:
-		throw invalid_operation();
-	case Impl::CDACC_Normal:
-		return _i->acceleration;
-	case Impl::CDACC_LinearBody:
-		return _i->accelerationLinearBody;
-	case Impl::CDACC_Uncompensated:
-		return _i->accelerationUncompensated;
-	case Impl::CDACC_LinearNed:
-		return _i->accelerationLinearNed;
-	case Impl::CDACC_Ned:
-		return _i->accelerationNed;
-	case Impl::CDACC_Ecef:
-		return _i->accelerationEcef;
-	case Impl::CDACC_LinearEcef:
-		return _i->accelerationLinearEcef;
-	default:
-		throw not_implemented();
-	}
-}
-
-bool CompositeData::hasAcceleration()
-{
-	return _i->hasAcceleration;
-}
-
-vec3f CompositeData::acceleration()
-{
-	if (!hasAcceleration())
-		throw invalid_operation();
-
-	return _i->acceleration;
-}
-
-bool CompositeData::hasAccelerationLinearBody()
-{
-	return _i->hasAccelerationLinearBody;
-}
-
-vec3f CompositeData::accelerationLinearBody()
-{
-	if (!hasAccelerationLinearBody())
-		throw invalid_operation();
-
-	return _i->accelerationLinearBody;
-}
-
-bool CompositeData::hasAccelerationUncompensated()
-{
-	return _i->hasAccelerationUncompensated;
-}
-
-vec3f CompositeData::accelerationUncompensated()
-{
-	if (!hasAccelerationUncompensated())
-		throw invalid_operation();
-
-	return _i->accelerationUncompensated;
-}
-
-bool CompositeData::hasAccelerationLinearNed()
-{
-	return _i->hasAccelerationLinearNed;
-}
-
-vec3f CompositeData::accelerationLinearNed()
-{
-	if (!hasAccelerationLinearNed())
-		throw invalid_operation();
-
-	return _i->accelerationLinearNed;
-}
-
-bool CompositeData::hasAccelerationLinearEcef()
-{
-	return _i->hasAccelerationLinearEcef;
-}
-
-vec3f CompositeData::accelerationLinearEcef()
-{
-	if (!hasAccelerationLinearEcef())
-		throw invalid_operation();
-
-	return _i->accelerationLinearEcef;
-}
-
-bool CompositeData::hasAccelerationNed()
-{
-	return _i->hasAccelerationNed;
-}
-
-vec3f CompositeData::accelerationNed()
-{
-	if (!hasAccelerationNed())
-		throw invalid_operation();
-
-	return _i->accelerationNed;
-}
-
-bool CompositeData::hasAccelerationEcef()
-{
-	return _i->hasAccelerationEcef;
-}
-
-vec3f CompositeData::accelerationEcef()
-{
-	if (!hasAccelerationEcef())
-		throw invalid_operation();
-
-	return _i->accelerationEcef;
-}
-
-
-bool CompositeData::hasAnyAngularRate()
-{
-	return _i->mostRecentlyUpdatedAngularRateType != Impl::CDANR_None;
-}
-
-vec3f CompositeData::anyAngularRate()
-{
-	switch (_i->mostRecentlyUpdatedAngularRateType)
-	{
-	case Impl::CDANR_None:
-		throw invalid_operation();
-	case Impl::CDANR_Normal:
-		return _i->angularRate;
-	case Impl::CDANR_Uncompensated:
-		return _i->angularRateUncompensated;
-	default:
-		throw not_implemented();
-	}
-}
-
-bool CompositeData::hasAngularRate()
-{
-	return _i->hasAngularRate;
-}
-
-vec3f CompositeData::angularRate()
-{
-	if (!hasAngularRate())
-		throw invalid_operation();
-
-	return _i->angularRate;
-}
-
-bool CompositeData::hasAngularRateUncompensated()
-{
-	return _i->hasAngularRateUncompensated;
-}
-
-vec3f CompositeData::angularRateUncompensated()
-{
-	if (!hasAngularRateUncompensated())
-		throw invalid_operation();
-
-	return _i->angularRateUncompensated;
-}
-
-
-bool CompositeData::hasAnyTemperature()
-{
-	return _i->mostRecentlyUpdatedTemperatureType != Impl::CDTEM_None;
-}
-
-float CompositeData::anyTemperature()
-{
-	switch (_i->mostRecentlyUpdatedTemperatureType)
-	{
-	case Impl::CDTEM_None:
-		throw invalid_operation();
-	case Impl::CDTEM_Normal:
-		return _i->temperature;
-	default:
-		throw not_implemented();
-	}
-}
-
-bool CompositeData::hasTemperature()
-{
-	return _i->hasTemperature;
-}
-
-float CompositeData::temperature()
-{
-	if (!hasTemperature())
-		throw invalid_operation();
-
-	return _i->temperature;
-}
-
-
-bool CompositeData::hasAnyPressure()
-{
-	return _i->mostRecentlyUpdatePressureType != Impl::CDPRE_None;
-}
-
-float CompositeData::anyPressure()
-{
-	switch (_i->mostRecentlyUpdatePressureType)
-	{
-	case Impl::CDPRE_None:
-		throw invalid_operation();
-	case Impl::CDPRE_Normal:
-		return _i->pressure;
-	default:
-		throw not_implemented();
-	}
-}
-
-bool CompositeData::hasPressure()
-{
-	return _i->hasPressure;
-}
-
-float CompositeData::pressure()
-{
-	if (!hasPressure())
-		throw invalid_operation();
-
-	return _i->pressure;
-}
+#include <cstring>
 
-bool CompositeData::hasAnyPosition()
-{
-	return _i->mostRecentlyUpdatedPositionType != Impl::CDPOS_None;
-}
-
-PositionD CompositeData::anyPosition()
-{
-	switch (_i->mostRecentlyUpdatedPositionType)
-	{
-	case Impl::CDPOS_None:
-		throw invalid_operation();
-  case Impl::CDPOS_GpsLla:
-    return PositionD::fromLla(_i->positionGpsLla);
-  case Impl::CDPOS_Gps2Lla:
-    return PositionD::fromLla(_i->positionGps2Lla);
-  case Impl::CDPOS_GpsEcef:
-    return PositionD::fromEcef(_i->positionGpsEcef);
-  case Impl::CDPOS_Gps2Ecef:
-    return PositionD::fromEcef(_i->positionGps2Ecef);
-  case Impl::CDPOS_EstimatedLla:
-		return PositionD::fromLla(_i->positionEstimatedLla);
-	case Impl::CDPOS_EstimatedEcef:
-		return PositionD::fromEcef(_i->positionEstimatedEcef);
-	default:
-		throw not_implemented();
-	}
-}
-
-bool CompositeData::hasPositionGpsLla()
-{
-  return _i->hasPositionGpsLla;
-}
-
-bool CompositeData::hasPositionGps2Lla()
-{
-  return _i->hasPositionGps2Lla;
-}
-
-vec3d CompositeData::positionGpsLla()
-{
-  if(!hasPositionGpsLla())
-    throw invalid_operation();
-
-  return _i->positionGpsLla;
-}
-
-vec3d CompositeData::positionGps2Lla()
-{
-  if(!hasPositionGps2Lla())
-    throw invalid_operation();
-
-  return _i->positionGps2Lla;
-}
-
-bool CompositeData::hasPositionGpsEcef()
-{
-  return _i->hasPositionGpsEcef;
-}
-
-bool CompositeData::hasPositionGps2Ecef()
-{
-  return _i->hasPositionGps2Ecef;
-}
-
-vec3d CompositeData::positionGps2Ecef()
-{
-	if (!hasPositionGps2Ecef())
-		throw invalid_operation();
+using namespace std;
+using namespace vn::math;
+using namespace vn::protocol::uart;
 
-	return _i->positionGps2Ecef;
-}
+namespace vn {
+namespace sensors {
 
-bool CompositeData::hasPositionEstimatedLla()
-{
-	return _i->hasPositionEstimatedLla;
-}
+typedef CompositeData* const* cditer;
 
-vec3d CompositeData::positionEstimatedLla()
+void CompositeData::Impl::setYawPitchRoll(vec3f ypr)
 {
-	if (!hasPositionEstimatedLla())
-		throw invalid_operation();
-
-	return _i->positionEstimatedLla;
+	mostRecentlyUpdatedAttitudeType = CDATT_YawPitchRoll;
+	set(CDHAS_YawPitchRoll);
+	yawPitchRoll = ypr;
 }
 
-bool CompositeData::hasPositionEstimatedEcef()
+void CompositeData::Impl::setQuaternion(vec4f quat)
 {
-	return _i->hasPositionEstimatedEcef;
+	mostRecentlyUpdatedAttitudeType = CDATT_Quaternion;
+	set(CDHAS_Quaternion);
+	quaternion = quat;
 }
 
-vec3d CompositeData::positionEstimatedEcef()
+void CompositeData::Impl::setDirectionConsineMatrix(mat3f dcm)
 {
-	if (!hasPositionEstimatedEcef())
-		throw invalid_operation();
-
-	return _i->positionEstimatedEcef;
+	mostRecentlyUpdatedAttitudeType = CDATT_DirectionCosineMatrix;
+	set(CDHAS_DirectionCosineMatrix);
+	directionConsineMatrix = dcm;
 }
 
-bool CompositeData::hasAnyVelocity()
+void CompositeData::Impl::setMagnetic(vec3f mag)
 {
-	return _i->mostRecentlyUpdatedVelocityType != Impl::CDVEL_None;
+	mostRecentlyUpdatedMagneticType = CDMAG_Normal;
+	set(CDHAS_Magnetic);
+	magnetic = mag;
 }
 
-vec3f CompositeData::anyVelocity()
+void CompositeData::Impl::setMagneticUncompensated(vec3f mag)
 {
-	switch (_i->mostRecentlyUpdatedVelocityType)
-	{
-	case Impl::CDVEL_None:
-		throw invalid_operation();
-  case Impl::CDVEL_GpsNed:
-    return _i->velocityGpsNed;
-  case Impl::CDVEL_Gps2Ned:
-    return _i->velocityGps2Ned;
-  case Impl::CDVEL_GpsEcef:
-    return _i->velocityGpsEcef;
-  case Impl::CDVEL_Gps2Ecef:
-    return _i->velocityGps2Ecef;
-  case Impl::CDVEL_EstimatedNed:
-		return _i->velocityEstimatedNed;
-	case Impl::CDVEL_EstimatedEcef:
-		return _i->velocityEstimatedEcef;
-	case Impl::CDVEL_EstimatedBody:
-		return _i->velocityEstimatedBody;
-	default:
-		throw not_implemented();
-	}
+	mostRecentlyUpdatedMagneticType = CDMAG_Uncompensated;
+	set(CDHAS_MagneticUncompensated);
+	magneticUncompensated = mag;
 }
 
-bool CompositeData::hasVelocityGpsNed()
+void CompositeData::Impl::setMagneticNed(vec3f mag)
 {
-  return _i->hasVelocityGpsNed;
+	mostRecentlyUpdatedMagneticType = CDMAG_Ned;
+	set(CDHAS_MagneticNed);
+	magneticNed = mag;
 }
 
-bool CompositeData::hasVelocityGps2Ned()
+void CompositeData::Impl::setMagneticEcef(vec3f mag)
 {
-  return _i->hasVelocityGps2Ned;
+	mostRecentlyUpdatedMagneticType = CDMAG_Ecef;
+	set(CDHAS_MagneticEcef);
+	magneticEcef = mag;
 }
 
-vec3f CompositeData::velocityGpsNed()
+void CompositeData::Impl::setAcceleration(vec3f accel)
 {
-  if(!hasVelocityGpsNed())
-    throw invalid_operation();
-
-  return _i->velocityGpsNed;
+	mostRecentlyUpdatedAccelerationType = CDACC_Normal;
+	set(CDHAS_Acceleration);
+	acceleration = accel;
 }
 
-vec3f CompositeData::velocityGps2Ned()
+void CompositeData::Impl::setAccelerationLinearBody(vec3f accel)
 {
-  if(!hasVelocityGps2Ned())
-    throw invalid_operation();
-
-  return _i->velocityGps2Ned;
+	mostRecentlyUpdatedAccelerationType = CDACC_LinearBody;
+	set(CDHAS_AccelerationLinearBody);
+	accelerationLinearBody = accel;
 }
 
-bool CompositeData::hasVelocityGpsEcef()
+void CompositeData::Impl::setAccelerationUncompensated(vec3f accel)
 {
-  return _i->hasVelocityGpsEcef;
+	mostRecentlyUpdatedAccelerationType = CDACC_Uncompensated;
+	set(CDHAS_AccelerationUncompensated);
+	accelerationUncompensated = accel;
 }
 
-bool CompositeData::hasVelocityGps2Ecef()
+void CompositeData::Impl::setAccelerationLinearNed(vec3f accel)
 {
-  return _i->hasVelocityGps2Ecef;
+	mostRecentlyUpdatedAccelerationType = CDACC_LinearNed;
+	set(CDHAS_AccelerationLinearNed);
+	accelerationLinearNed = accel;
 }
 
-vec3f CompositeData::velocityGpsEcef()
+void CompositeData::Impl::setAccelerationLinearEcef(vec3f accel)
 {
-  if(!hasVelocityGpsEcef())
-    throw invalid_operation();
-
-  return _i->velocityGpsEcef;
+	mostRecentlyUpdatedAccelerationType = CDACC_LinearEcef;
+	set(CDHAS_AccelerationLinearEcef);
+	accelerationLinearEcef = accel;
 }
 
-vec3f CompositeData::velocityGps2Ecef()
+void CompositeData::Impl::setAccelerationNed(vec3f accel)
 {
-  if(!hasVelocityGps2Ecef())
-    throw invalid_operation();
-
-  return _i->velocityGps2Ecef;
+	mostRecentlyUpdatedAccelerationType = CDACC_Ned;
+	set(CDHAS_AccelerationNed);
+	accelerationNed = accel;
 }
 
-bool CompositeData::hasVelocityEstimatedNed()
+void CompositeData::Impl::setAccelerationEcef(vec3f accel)
 {
-	return _i->hasVelocityEstimatedNed;
+	mostRecentlyUpdatedAccelerationType = CDACC_Ecef;
+	set(CDHAS_AccelerationEcef);
+	accelerationEcef = accel;
 }
 
-vec3f CompositeData::velocityEstimatedNed()
+void CompositeData::Impl::setAngularRate(vec3f ar)
 {
-	if (!hasVelocityEstimatedNed())
-		throw invalid_operation();
-
-	return _i->velocityEstimatedNed;
+	mostRecentlyUpdatedAngularRateType = CDANR_Normal;
+	set(CDHAS_AngularRate);
+	angularRate = ar;
 }
 
-bool CompositeData::hasVelocityEstimatedEcef()
+void CompositeData::Impl::setAngularRateUncompensated(vec3f ar)
 {
-	return _i->hasVelocityEstimatedEcef;
+	mostRecentlyUpdatedAngularRateType = CDANR_Uncompensated;
+	set(CDHAS_AngularRateUncompensated);
+	angularRateUncompensated = ar;
 }
 
-vec3f CompositeData::velocityEstimatedEcef()
+void CompositeData::Impl::setTemperature(float temp)
 {
-	if (!hasVelocityEstimatedEcef())
-		throw invalid_operation();
-
-	return _i->velocityEstimatedEcef;
+	mostRecentlyUpdatedTemperatureType = CDTEM_Normal;
+	set(CDHAS_Temperature);
+	temperature = temp;
 }
 
-bool CompositeData::hasVelocityEstimatedBody()
+void CompositeData::Impl::setPressure(float pres)
 {
-	return _i->hasVelocityEstimatedBody;
+	mostRecentlyUpdatePressureType = CDPRE_Normal;
+	set(CDHAS_Pressure);
+	pressure = pres;
 }
 
-vec3f CompositeData::velocityEstimatedBody()
+void CompositeData::Impl::setPositionGpsLla(vec3d pos)
 {
-	if (!hasVelocityEstimatedBody())
-		throw invalid_operation();
-
-	return _i->velocityEstimatedBody;
+	mostRecentlyUpdatedPositionType = CDPOS_GpsLla;
+	set(CDHAS_PositionGpsLla);
+	positionGpsLla = pos;
 }
 
-bool CompositeData::hasDeltaTime()
+void CompositeData::Impl::setPositionGps2Lla(vec3d pos)
 {
-	return _i->hasDeltaTime;
+	mostRecentlyUpdatedPositionType = CDPOS_Gps2Lla;
+	set(CDHAS_PositionGps2Lla);
+	positionGps2Lla = pos;
 }
 
-float CompositeData::deltaTime()
+void CompositeData::Impl::setPositionGpsEcef(vec3d pos)
 {
-	if (!hasDeltaTime())
-		throw invalid_operation();
-
-	return _i->deltaTime;
+	mostRecentlyUpdatedPositionType = CDPOS_GpsEcef;
+	set(CDHAS_PositionGpsEcef);
+	positionGpsEcef = pos;
 }
 
-bool CompositeData::hasDeltaTheta()
+void CompositeData::Impl::setPositionGps2Ecef(vec3d pos)
 {
-	return _i->hasDeltaTheta;
+	mostRecentlyUpdatedPositionType = CDPOS_Gps2Ecef;
+	set(CDHAS_PositionGps2Ecef);
+	positionGps2Ecef = pos;
 }
 
-vec3f CompositeData::deltaTheta()
+void CompositeData::Impl::setPositionEstimatedLla(vec3d pos)
 {
-	if (!hasDeltaTheta())
-		throw invalid_operation();
-
-	return _i->deltaTheta;
+	mostRecentlyUpdatedPositionType = CDPOS_EstimatedLla;
+	set(CDHAS_PositionEstimatedLla);
+	positionEstimatedLla = pos;
 }
 
-bool CompositeData::hasDeltaVelocity()
+void CompositeData::Impl::setPositionEstimatedEcef(vec3d pos)
 {
-	return _i->hasDeltaVelocity;
+	mostRecentlyUpdatedPositionType = CDPOS_EstimatedEcef;
+	set(CDHAS_PositionEstimatedEcef);
+	positionEstimatedEcef = pos;
 }
 
-vec3f CompositeData::deltaVelocity()
+void CompositeData::Impl::setVelocityGpsNed(vec3f vel)
 {
-	if (!hasDeltaVelocity())
-		throw invalid_operation();
-
-	return _i->deltaVelocity;
+	mostRecentlyUpdatedVelocityType = CDVEL_GpsNed;
+	set(CDHAS_VelocityGpsNed);
+	velocityGpsNed = vel;
 }
 
-bool CompositeData::hasTimeStartup()
+void CompositeData::Impl::setVelocityGps2Ned(vec3f vel)
 {
-	return _i->hasTimeStartup;
+	mostRecentlyUpdatedVelocityType = CDVEL_Gps2Ned;
+	set(CDHAS_VelocityGps2Ned);
+	velocityGps2Ned = vel;
 }
 
-uint64_t CompositeData::timeStartup()
+void CompositeData::Impl::setVelocityGpsEcef(vec3f vel)
 {
-	if (!hasTimeStartup())
-		throw invalid_operation();
-
-	return _i->timeStartup;
+	mostRecentlyUpdatedVelocityType = CDVEL_GpsEcef;
+	set(CDHAS_VelocityGpsEcef);
+	velocityGpsEcef = vel;
 }
 
-bool CompositeData::hasTimeGps()
+void CompositeData::Impl::setVelocityGps2Ecef(vec3f vel)
 {
-  return _i->hasTimeGps;
+	mostRecentlyUpdatedVelocityType = CDVEL_Gps2Ecef;
+	set(CDHAS_VelocityGps2Ecef);
+	velocityGps2Ecef = vel;
 }
 
-bool CompositeData::hasTimeGps2()
+void CompositeData::Impl::setVelocityEstimatedNed(vec3f vel)
 {
-  return _i->hasTimeGps2;
+	mostRecentlyUpdatedVelocityType = CDVEL_EstimatedNed;
+	set(CDHAS_VelocityEstimatedNed);
+	velocityEstimatedNed = vel;
 }
 
-uint64_t CompositeData::timeGps()
+void CompositeData::Impl::setVelocityEstimatedEcef(vec3f vel)
 {
-  if(!hasTimeGps())
-    throw invalid_operation();
-
-  return _i->timeGps;
+	mostRecentlyUpdatedVelocityType = CDVEL_EstimatedEcef;
+	set(CDHAS_VelocityEstimatedEcef);
+	velocityEstimatedEcef = vel;
 }
 
-uint64_t CompositeData::timeGps2()
+void CompositeData::Impl::setVelocityEstimatedBody(vec3f vel)
 {
-  if(!hasTimeGps2())
-    throw invalid_operation();
-
-  return _i->timeGps2;
+	mostRecentlyUpdatedVelocityType = CDVEL_EstimatedBody;
+	set(CDHAS_VelocityEstimatedBody);
+	velocityEstimatedBody = vel;
 }
 
-bool CompositeData::hasTow()
+void CompositeData::Impl::setDeltaTime(float time)
 {
-  return _i->hasTow;
+	set(CDHAS_DeltaTime);
+	deltaTime = time;
 }
 
-double CompositeData::tow()
+void CompositeData::Impl::setDeltaTheta(vec3f theta)
 {
-  if(!hasTow())
-    throw invalid_operation();
-
-  return _i->tow;
+	set(CDHAS_DeltaTheta);
+	deltaTheta = theta;
 }
 
-bool CompositeData::hasWeek()
+void CompositeData::Impl::setDeltaVelocity(vec3f vel)
 {
-	return _i->hasWeek;
+	set(CDHAS_DeltaVelocity);
+	deltaVelocity = vel;
 }
 
-uint16_t CompositeData::week()
+void CompositeData::Impl::setTimeStartup(uint64_t ts)
 {
-	if (!hasWeek())
-		throw invalid_operation();
-
-	return _i->week;
+	set(CDHAS_TimeStartup);
+	timeStartup = ts;
 }
 
-bool CompositeData::hasNumSats()
+void CompositeData::Impl::setTimeGps(uint64_t time)
 {
-	return _i->hasNumSats;
+	set(CDHAS_TimeGps);
+	timeGps = time;
 }
 
-uint8_t CompositeData::numSats()
+void CompositeData::Impl::setTimeGps2(uint64_t time)
 {
-	if (!hasNumSats())
-		throw invalid_operation();
-
-	return _i->numSats;
+	set(CDHAS_TimeGps2);
+	timeGps2 = time;
 }
 
-bool CompositeData::hasTimeSyncIn()
+void CompositeData::Impl::setTow(double t)
 {
-	return _i->hasTimeSyncIn;
+	set(CDHAS_Tow);
+	tow = t;
 }
 
-uint64_t CompositeData::timeSyncIn()
+void CompositeData::Impl::setWeek(uint16_t w)
 {
-	if (!hasTimeSyncIn())
-		throw invalid_operation();
-
-	return _i->timeSyncIn;
+	set(CDHAS_Week);
+	week = w;
 }
 
-bool CompositeData::hasVpeStatus()
+void CompositeData::Impl::setGpsWeek(uint16_t w)
 {
-	return _i->hasVpeStatus;
+	set(CDHAS_GpsWeek);
+	gpsWeek = w;
 }
 
-VpeStatus CompositeData::vpeStatus()
+void CompositeData::Impl::setGps2Week(uint16_t w)
 {
-	if (!hasVpeStatus())
-		throw invalid_operation();
-
-	return _i->vpeStatus;
+	set(CDHAS_Gps2Week);
+	gps2Week = w;
 }
 
-bool CompositeData::hasInsStatus()
+void CompositeData::Impl::setNumSats(uint8_t s)
 {
-	return _i->hasInsStatus;
+	set(CDHAS_NumSats);
+	numSats = s;
 }
 
-InsStatus CompositeData::insStatus()
+void CompositeData::Impl::setNumSats2(uint8_t s)
 {
-	if (!hasInsStatus())
-		throw invalid_operation();
-
-	return _i->insStatus;
+	set(CDHAS_NumSats2);
+	numSats2 = s;
 }
 
-bool CompositeData::hasSyncInCnt()
+void CompositeData::Impl::setTimeSyncIn(uint64_t t)
 {
-	return _i->hasSyncInCnt;
+	set(CDHAS_TimeSyncIn);
+	timeSyncIn = t;
 }
 
-uint32_t CompositeData::syncInCnt()
+void CompositeData::Impl::setVpeStatus(VpeStatus s)
 {
-	if (!hasSyncInCnt())
-		throw invalid_operation();
-
-	return _i->syncInCnt;
+	set(CDHAS_VpeStatus);
+	vpeStatus = s;
 }
 
-bool CompositeData::hasSyncOutCnt()
+void CompositeData::Impl::setInsStatus(InsStatus s)
 {
-  return _i->hasSyncOutCnt;
+	set(CDHAS_InsStatus);
+	insStatus = s;
 }
 
-uint32_t CompositeData::syncOutCnt()
+void CompositeData::Impl::setSyncInCnt(uint32_t count)
 {
-  if (!hasSyncOutCnt())
-    throw invalid_operation();
-
-  return _i->syncOutCnt;
+	set(CDHAS_SyncInCnt);
+	syncInCnt = count;
 }
 
-bool CompositeData::hasTimeStatus()
+void CompositeData::Impl::setSyncOutCnt(uint32_t count)
 {
-  return _i->hasTimeStatus;
+	set(CDHAS_SyncOutCnt);
+	syncOutCnt = count;
 }
 
-uint8_t CompositeData::timeStatus()
+void CompositeData::Impl::setTimeStatus(uint8_t status)
 {
-  if (!hasTimeStatus())
-    throw invalid_operation();
-
-  return _i->timeStatus;
+	set(CDHAS_TimeStatus);
+	timeStatus = status;
 }
 
-bool CompositeData::hasTimeGpsPps()
+void CompositeData::Impl::setTimeGpsPps(uint64_t pps)
 {
-  return _i->hasTimeGpsPps;
+	set(CDHAS_TimeGpsPps);
+	timeGpsPps = pps;
 }
 
-bool CompositeData::hasTimeGps2Pps()
+void CompositeData::Impl::setTimeGps2Pps(uint64_t pps)
 {
-  return _i->hasTimeGps2Pps;
+	set(CDHAS_TimeGps2Pps);
+	timeGps2Pps = pps;
 }
 
-uint64_t CompositeData::timeGpsPps()
+void CompositeData::Impl::setGpsTow(uint64_t tow)
 {
-	if (!hasTimeGpsPps())
-		throw invalid_operation();
-
-	return _i->timeGpsPps;
+	set(CDHAS_GpsTow);
+	gpsTow = tow;
 }
 
-uint64_t CompositeData::timeGps2Pps()
+void CompositeData::Impl::setGps2Tow(uint64_t tow)
 {
-  if(!hasTimeGps2Pps())
-    throw invalid_operation();
-
-  return _i->timeGps2Pps;
+	set(CDHAS_Gps2Tow);
+	gps2Tow = tow;
 }
 
-bool CompositeData::hasGpsTow()
+void CompositeData::Impl::setPositionUncertaintyGpsNed(vec3f u)
 {
-  return _i->hasGpsTow;
+	mostRecentlyUpdatedPositionUncertaintyType = CDPOU_GpsNed;
+	set(CDHAS_PositionUncertaintyGpsNed);
+	positionUncertaintyGpsNed = u;
 }
 
-bool CompositeData::hasGps2Tow()
+void CompositeData::Impl::setPositionUncertaintyGps2Ned(vec3f u)
 {
-  return _i->hasGps2Tow;
+	mostRecentlyUpdatedPositionUncertaintyType = CDPOU_Gps2Ned;
+	set(CDHAS_PositionUncertaintyGps2Ned);
+	positionUncertaintyGps2Ned = u;
 }
 
-uint64_t CompositeData::gpsTow()
+void CompositeData::Impl::setPositionUncertaintyGpsEcef(vec3f u)
 {
-  if(!hasGpsTow())
-    throw invalid_operation();
-
-  return _i->gpsTow;
+	mostRecentlyUpdatedPositionUncertaintyType = CDPOU_GpsEcef;
+	set(CDHAS_PositionUncertaintyGpsEcef);
+	positionUncertaintyGpsEcef = u;
 }
 
-uint64_t CompositeData::gps2Tow()
+void CompositeData::Impl::setPositionUncertaintyGps2Ecef(vec3f u)
 {
-  if(!hasGps2Tow())
-    throw invalid_operation();
-
-  return _i->gps2Tow;
+	mostRecentlyUpdatedPositionUncertaintyType = CDPOU_Gps2Ecef;
+	set(CDHAS_PositionUncertaintyGps2Ecef);
+	positionUncertaintyGps2Ecef = u;
 }
 
-bool CompositeData::hasTimeUtc()
+void CompositeData::Impl::setPositionUncertaintyEstimated(float u)
 {
-	return _i->hasTimeUtc;
+	mostRecentlyUpdatedPositionUncertaintyType = CDPOU_Estimated;
+	set(CDHAS_PositionUncertaintyEstimated);
+	positionUncertaintyEstimated = u;
 }
 
-TimeUtc CompositeData::timeUtc()
+void CompositeData::Impl::setVelocityUncertaintyGps(float u)
 {
-	if (!hasTimeUtc())
-		throw invalid_operation();
-
-	return _i->timeUtc;
+	mostRecentlyUpdatedVelocityUncertaintyType = CDVEU_Gps;
+	set(CDHAS_VelocityUncertaintyGps);
+	velocityUncertaintyGps = u;
 }
 
-bool CompositeData::hasSensSat()
+void CompositeData::Impl::setVelocityUncertaintyGps2(float u)
 {
-	return _i->hasSensSat;
+	mostRecentlyUpdatedVelocityUncertaintyType = CDVEU_Gps2;
+	set(CDHAS_VelocityUncertaintyGps2);
+	velocityUncertaintyGps2 = u;
 }
 
-SensSat CompositeData::sensSat()
+void CompositeData::Impl::setVelocityUncertaintyEstimated(float u)
 {
-	if (!hasSensSat())
-		throw invalid_operation();
-
-	return _i->sensSat;
+	mostRecentlyUpdatedVelocityUncertaintyType = CDVEU_Estimated;
+	set(CDHAS_VelocityUncertaintyEstimated);
+	velocityUncertaintyEstimated = u;
 }
 
-bool CompositeData::hasFix()
+void CompositeData::Impl::setTimeUncertainty(uint32_t u)
 {
-  return _i->hasFix;
+	set(CDHAS_TimeUncertainty);
+	timeUncertainty = u;
 }
 
-bool CompositeData::hasFix2()
+void CompositeData::Impl::setTimeUncertainty2(uint32_t u)
 {
-  return _i->hasFix2;
+	set(CDHAS_TimeUncertainty2);
+	timeUncertainty2 = u;
 }
 
-GpsFix CompositeData::fix()
+void CompositeData::Impl::setAttitudeUncertainty(vec3f u)
 {
-  if(!hasFix())
-    throw invalid_operation();
-
-  return _i->fix;
+	set(CDHAS_AttitudeUncertainty);
+	attitudeUncertainty = u;
 }
 
-GpsFix CompositeData::fix2()
+void CompositeData::Impl::setFix(GpsFix f)
 {
-  if(!hasFix2())
-    throw invalid_operation();
-
-  return _i->fix2;
+	set(CDHAS_Fix);
+	fix = f;
 }
 
-bool CompositeData::hasAnyPositionUncertainty()
+void CompositeData::Impl::setFix2(GpsFix f)
 {
-	return _i->mostRecentlyUpdatedPositionUncertaintyType != Impl::CDPOU_None;
+	set(CDHAS_Fix2);
+	fix2 = f;
 }
 
-vec3f CompositeData::anyPositionUncertainty()
+void CompositeData::Impl::setTimeUtc(TimeUtc t)
 {
-	switch (_i->mostRecentlyUpdatedPositionUncertaintyType)
-	{
-	case Impl::CDPOU_None:
-		throw invalid_operation();
-  case Impl::CDPOU_GpsNed:
-    return _i->positionUncertaintyGpsNed;
-  case Impl::CDPOU_Gps2Ned:
-    return _i->positionUncertaintyGps2Ned;
-  case Impl::CDPOU_GpsEcef:
-    return _i->positionUncertaintyGpsEcef;
-  case Impl::CDPOU_Gps2Ecef:
-    return _i->positionUncertaintyGps2Ecef;
-  case Impl::CDPOU_Estimated:
-		return vec3f(_i->positionUncertaintyEstimated);
-	default:
-		throw not_implemented();
-	}
+	set(CDHAS_TimeUtc);
+	timeUtc = t;
 }
 
-bool CompositeData::hasPositionUncertaintyGpsNed()
+void CompositeData::Impl::setTimeUtc2(TimeUtc t)
 {
-  return _i->hasPositionUncertaintyGpsNed;
+	set(CDHAS_TimeUtc2);
+	timeUtc2 = t;
 }
 
-bool CompositeData::hasPositionUncertaintyGps2Ned()
+void CompositeData::Impl::setSensSat(SensSat s)
 {
-  return _i->hasPositionUncertaintyGps2Ned;
+	set(CDHAS_SensSat);
+	sensSat = s;
 }
 
-vec3f CompositeData::positionUncertaintyGpsNed()
+void CompositeData::Impl::setGnssDop(GnssDop d)
 {
-  if(!hasPositionUncertaintyGpsNed())
-    throw invalid_operation();
-
-  return _i->positionUncertaintyGpsNed;
+	set(CDHAS_Dop);
+	dop = d;
 }
 
-vec3f CompositeData::positionUncertaintyGps2Ned()
+void CompositeData::Impl::setGnssDop2(GnssDop d)
 {
-  if(!hasPositionUncertaintyGps2Ned())
-    throw invalid_operation();
-
-  return _i->positionUncertaintyGps2Ned;
+	set(CDHAS_Dop2);
+	dop2 = d;
 }
 
-bool CompositeData::hasPositionUncertaintyGpsEcef()
+void CompositeData::Impl::setTimeInfo(TimeInfo t)
 {
-  return _i->hasPositionUncertaintyGpsEcef;
+	set(CDHAS_TimeInfo);
+	timeInfo = t;
 }
 
-bool CompositeData::hasPositionUncertaintyGps2Ecef()
+void CompositeData::Impl::setTimeInfo2(TimeInfo t)
 {
-  return _i->hasPositionUncertaintyGps2Ecef;
+	set(CDHAS_TimeInfo2);
+	timeInfo2 = t;
 }
 
-vec3f CompositeData::positionUncertaintyGpsEcef()
-{
-  if(!hasPositionUncertaintyGpsEcef())
-    throw invalid_operation();
 
-  return _i->positionUncertaintyGpsEcef;
+
+CompositeData::CompositeData()
+{
+	_i.reset();
 }
 
-vec3f CompositeData::positionUncertaintyGps2Ecef()
+bool CompositeData::hasAnyMagnetic()
 {
-  if(!hasPositionUncertaintyGps2Ecef())
-    throw invalid_operation();
+	return _i.mostRecentlyUpdatedMagneticType != Impl::CDMAG_None;
+}
 
-  return _i->positionUncertaintyGps2Ecef;
+vec3f CompositeData::anyMagnetic()
+{
+	switch (_i.mostRecentlyUpdatedMagneticType)
+	{
+	case Impl::CDMAG_None:
+		throw invalid_operation();
+	case Impl::CDMAG_Normal:
+		return _i.magnetic;
+	case Impl::CDMAG_Uncompensated:
+		return _i.magneticUncompensated;
+	case Impl::CDMAG_Ned:
+		return _i.magneticNed;
+	case Impl::CDMAG_Ecef:
+		return _i.magneticEcef;
+	default:
+		throw not_implemented();
+	}
 }
 
-bool CompositeData::hasPositionUncertaintyEstimated()
+bool CompositeData::hasAnyAcceleration()
 {
-	return _i->hasPositionUncertaintyEstimated;
+	return _i.mostRecentlyUpdatedAccelerationType != Impl::CDACC_None;
 }
 
-float CompositeData::positionUncertaintyEstimated()
+vec3f CompositeData::anyAcceleration()
 {
-	if (!hasPositionUncertaintyEstimated())
+	switch (_i.mostRecentlyUpdatedAccelerationType)
+	{
+	case Impl::CDACC_None:
 		throw invalid_operation();
-
-	return _i->positionUncertaintyEstimated;
+	case Impl::CDACC_Normal:
+		return _i.acceleration;
+	case Impl::CDACC_LinearBody:
+		return _i.accelerationLinearBody;
+	case Impl::CDACC_Uncompensated:
+		return _i.accelerationUncompensated;
+	case Impl::CDACC_LinearNed:
+		return _i.accelerationLinearNed;
+	case Impl::CDACC_Ned:
+		return _i.accelerationNed;
+	case Impl::CDACC_Ecef:
+		return _i.accelerationEcef;
+	case Impl::CDACC_LinearEcef:
+		return _i.accelerationLinearEcef;
+	default:
+		throw not_implemented();
+	}
 }
 
-bool CompositeData::hasAnyVelocityUncertainty()
+bool CompositeData::hasAnyAngularRate()
 {
-	return _i->mostRecentlyUpdatedVelocityUncertaintyType != Impl::CDVEU_None;
+	return _i.mostRecentlyUpdatedAngularRateType != Impl::CDANR_None;
 }
 
-float CompositeData::anyVelocityUncertainty()
+vec3f CompositeData::anyAngularRate()
 {
-	switch (_i->mostRecentlyUpdatedVelocityUncertaintyType)
+	switch (_i.mostRecentlyUpdatedAngularRateType)
 	{
-	case Impl::CDVEU_None:
+	case Impl::CDANR_None:
 		throw invalid_operation();
-  case Impl::CDVEU_Gps:
-    return _i->velocityUncertaintyGps;
-  case Impl::CDVEU_Gps2:
-    return _i->velocityUncertaintyGps2;
-  case Impl::CDVEU_Estimated:
-		return _i->velocityUncertaintyEstimated;
+	case Impl::CDANR_Normal:
+		return _i.angularRate;
+	case Impl::CDANR_Uncompensated:
+		return _i.angularRateUncompensated;
 	default:
 		throw not_implemented();
 	}
 }
 
-bool CompositeData::hasVelocityUncertaintyGps()
+bool CompositeData::hasAnyTemperature()
+{
+	return _i.mostRecentlyUpdatedTemperatureType != Impl::CDTEM_None;
+}
+
+float CompositeData::anyTemperature()
 {
-  return _i->hasVelocityUncertaintyGps;
+	switch (_i.mostRecentlyUpdatedTemperatureType)
+	{
+	case Impl::CDTEM_None:
+		throw invalid_operation();
+	case Impl::CDTEM_Normal:
+		return _i.temperature;
+	default:
+		throw not_implemented();
+	}
 }
 
-bool CompositeData::hasVelocityUncertaintyGps2()
+bool CompositeData::hasAnyPressure()
 {
-  return _i->hasVelocityUncertaintyGps2;
+	return _i.mostRecentlyUpdatePressureType != Impl::CDPRE_None;
 }
 
-float CompositeData::velocityUncertaintyGps()
+float CompositeData::anyPressure()
 {
-	if (!hasVelocityUncertaintyGps())
+	switch (_i.mostRecentlyUpdatePressureType)
+	{
+	case Impl::CDPRE_None:
 		throw invalid_operation();
-
-	return _i->velocityUncertaintyGps;
+	case Impl::CDPRE_Normal:
+		return _i.pressure;
+	default:
+		throw not_implemented();
+	}
 }
 
-float CompositeData::velocityUncertaintyGps2()
+bool CompositeData::hasAnyPosition()
 {
-  if(!hasVelocityUncertaintyGps2())
-    throw invalid_operation();
+	return _i.mostRecentlyUpdatedPositionType != Impl::CDPOS_None;
+}
 
-  return _i->velocityUncertaintyGps2;
+PositionD CompositeData::anyPosition()
+{
+	switch (_i.mostRecentlyUpdatedPositionType)
+	{
+	case Impl::CDPOS_None:
+		throw invalid_operation();
+  case Impl::CDPOS_GpsLla:
+    return PositionD::fromLla(_i.positionGpsLla);
+  case Impl::CDPOS_Gps2Lla:
+    return PositionD::fromLla(_i.positionGps2Lla);
+  case Impl::CDPOS_GpsEcef:
+    return PositionD::fromEcef(_i.positionGpsEcef);
+  case Impl::CDPOS_Gps2Ecef:
+    return PositionD::fromEcef(_i.positionGps2Ecef);
+  case Impl::CDPOS_EstimatedLla:
+		return PositionD::fromLla(_i.positionEstimatedLla);
+	case Impl::CDPOS_EstimatedEcef:
+		return PositionD::fromEcef(_i.positionEstimatedEcef);
+	default:
+		throw not_implemented();
+	}
 }
 
-bool CompositeData::hasVelocityUncertaintyEstimated()
+bool CompositeData::hasAnyVelocity()
 {
-	return _i->hasVelocityUncertaintyEstimated;
+	return _i.mostRecentlyUpdatedVelocityType != Impl::CDVEL_None;
 }
 
-float CompositeData::velocityUncertaintyEstimated()
+vec3f CompositeData::anyVelocity()
 {
-	if (!hasVelocityUncertaintyEstimated())
+	switch (_i.mostRecentlyUpdatedVelocityType)
+	{
+	case Impl::CDVEL_None:
 		throw invalid_operation();
-
-	return _i->velocityUncertaintyEstimated;
+  case Impl::CDVEL_GpsNed:
+    return _i.velocityGpsNed;
+  case Impl::CDVEL_Gps2Ned:
+    return _i.velocityGps2Ned;
+  case Impl::CDVEL_GpsEcef:
+    return _i.velocityGpsEcef;
+  case Impl::CDVEL_Gps2Ecef:
+    return _i.velocityGps2Ecef;
+  case Impl::CDVEL_EstimatedNed:
+		return _i.velocityEstimatedNed;
+	case Impl::CDVEL_EstimatedEcef:
+		return _i.velocityEstimatedEcef;
+	case Impl::CDVEL_EstimatedBody:
+		return _i.velocityEstimatedBody;
+	default:
+		throw not_implemented();
+	}
 }
 
-bool CompositeData::hasTimeUncertainty()
+bool CompositeData::hasAnyPositionUncertainty()
 {
-	return _i->hasTimeUncertainty;
+	return _i.mostRecentlyUpdatedPositionUncertaintyType != Impl::CDPOU_None;
 }
 
-uint32_t CompositeData::timeUncertainty()
+vec3f CompositeData::anyPositionUncertainty()
 {
-	if (!hasTimeUncertainty())
+	switch (_i.mostRecentlyUpdatedPositionUncertaintyType)
+	{
+	case Impl::CDPOU_None:
 		throw invalid_operation();
-
-	return _i->timeUncertainty;
+  case Impl::CDPOU_GpsNed:
+    return _i.positionUncertaintyGpsNed;
+  case Impl::CDPOU_Gps2Ned:
+    return _i.positionUncertaintyGps2Ned;
+  case Impl::CDPOU_GpsEcef:
+    return _i.positionUncertaintyGpsEcef;
+  case Impl::CDPOU_Gps2Ecef:
+    return _i.positionUncertaintyGps2Ecef;
+  case Impl::CDPOU_Estimated:
+		return vec3f(_i.positionUncertaintyEstimated);
+	default:
+		throw not_implemented();
+	}
 }
 
-bool CompositeData::hasAttitudeUncertainty()
+bool CompositeData::hasAnyVelocityUncertainty()
 {
-	return _i->hasAttitudeUncertainty;
+	return _i.mostRecentlyUpdatedVelocityUncertaintyType != Impl::CDVEU_None;
 }
 
-vec3f CompositeData::attitudeUncertainty()
+float CompositeData::anyVelocityUncertainty()
 {
-	if (!hasAttitudeUncertainty())
+	switch (_i.mostRecentlyUpdatedVelocityUncertaintyType)
+	{
+	case Impl::CDVEU_None:
 		throw invalid_operation();
-
-	return _i->attitudeUncertainty;
+  case Impl::CDVEU_Gps:
+    return _i.velocityUncertaintyGps;
+  case Impl::CDVEU_Gps2:
+    return _i.velocityUncertaintyGps2;
+  case Impl::CDVEU_Estimated:
+		return _i.velocityUncertaintyEstimated;
+	default:
+		throw not_implemented();
+	}
 }
 
 bool CompositeData::hasCourseOverGround()
 {
-  return _i->mostRecentlyUpdatedVelocityType != Impl::CDVEL_None
-    && _i->mostRecentlyUpdatedVelocityType != Impl::CDVEL_EstimatedBody	// TODO: Don't have conversion formula from body frame to NED frame.
-    && _i->mostRecentlyUpdatedVelocityType != Impl::CDVEL_EstimatedEcef	// TODO: Don't have conversion formula from ECEF frame to NED frame.
-    && _i->mostRecentlyUpdatedVelocityType != Impl::CDVEL_GpsEcef		// TODO: Don't have conversion formula from ECEF frame to NED frame.
-    && _i->mostRecentlyUpdatedVelocityType != Impl::CDVEL_Gps2Ecef;		// TODO: Don't have conversion formula from ECEF frame to NED frame.
+  return _i.mostRecentlyUpdatedVelocityType != Impl::CDVEL_None
+    && _i.mostRecentlyUpdatedVelocityType != Impl::CDVEL_EstimatedBody	// TODO: Don't have conversion formula from body frame to NED frame.
+    && _i.mostRecentlyUpdatedVelocityType != Impl::CDVEL_EstimatedEcef	// TODO: Don't have conversion formula from ECEF frame to NED frame.
+    && _i.mostRecentlyUpdatedVelocityType != Impl::CDVEL_GpsEcef		// TODO: Don't have conversion formula from ECEF frame to NED frame.
+    && _i.mostRecentlyUpdatedVelocityType != Impl::CDVEL_Gps2Ecef;		// TODO: Don't have conversion formula from ECEF frame to NED frame.
 }
 
 float CompositeData::courseOverGround()
@@ -1973,14 +729,14 @@ float CompositeData::courseOverGround()
 	if (!hasCourseOverGround())
 		throw invalid_operation();
 
-	switch (_i->mostRecentlyUpdatedVelocityType)
+	switch (_i.mostRecentlyUpdatedVelocityType)
 	{
     case Impl::CDVEL_GpsNed:
-      return course_over_ground(_i->velocityGpsNed);
+      return course_over_ground(_i.velocityGpsNed);
     case Impl::CDVEL_Gps2Ned:
-      return course_over_ground(_i->velocityGps2Ned);
+      return course_over_ground(_i.velocityGps2Ned);
     case Impl::CDVEL_EstimatedNed:
-		return course_over_ground(_i->velocityEstimatedNed);
+		return course_over_ground(_i.velocityEstimatedNed);
 	default:
 		throw not_implemented();
 	}
@@ -1988,11 +744,11 @@ float CompositeData::courseOverGround()
 
 bool CompositeData::hasSpeedOverGround()
 {
-  return _i->mostRecentlyUpdatedVelocityType != Impl::CDVEL_None
-    && _i->mostRecentlyUpdatedVelocityType != Impl::CDVEL_EstimatedBody	// TODO: Don't have conversion formula from body frame to NED frame.
-    && _i->mostRecentlyUpdatedVelocityType != Impl::CDVEL_EstimatedEcef	// TODO: Don't have conversion formula from ECEF frame to NED frame.
-    && _i->mostRecentlyUpdatedVelocityType != Impl::CDVEL_GpsEcef		// TODO: Don't have conversion formula from ECEF frame to NED frame.
-    && _i->mostRecentlyUpdatedVelocityType != Impl::CDVEL_Gps2Ecef;		// TODO: Don't have conversion formula from ECEF frame to NED frame.
+  return _i.mostRecentlyUpdatedVelocityType != Impl::CDVEL_None
+    && _i.mostRecentlyUpdatedVelocityType != Impl::CDVEL_EstimatedBody	// TODO: Don't have conversion formula from body frame to NED frame.
+    && _i.mostRecentlyUpdatedVelocityType != Impl::CDVEL_EstimatedEcef	// TODO: Don't have conversion formula from ECEF frame to NED frame.
+    && _i.mostRecentlyUpdatedVelocityType != Impl::CDVEL_GpsEcef		// TODO: Don't have conversion formula from ECEF frame to NED frame.
+    && _i.mostRecentlyUpdatedVelocityType != Impl::CDVEL_Gps2Ecef;		// TODO: Don't have conversion formula from ECEF frame to NED frame.
 }
 
 float CompositeData::speedOverGround()
@@ -2000,63 +756,85 @@ float CompositeData::speedOverGround()
 	if (!hasSpeedOverGround())
 		throw invalid_operation();
 
-	switch (_i->mostRecentlyUpdatedVelocityType)
+	switch (_i.mostRecentlyUpdatedVelocityType)
 	{
     case Impl::CDVEL_GpsNed:
-      return speed_over_ground(_i->velocityGpsNed);
+      return speed_over_ground(_i.velocityGpsNed);
     case Impl::CDVEL_Gps2Ned:
-      return speed_over_ground(_i->velocityGps2Ned);
+      return speed_over_ground(_i.velocityGps2Ned);
     case Impl::CDVEL_EstimatedNed:
-		return speed_over_ground(_i->velocityEstimatedNed);
+		return speed_over_ground(_i.velocityEstimatedNed);
 	default:
 		throw not_implemented();
 	}
 }
 
-bool CompositeData::hasTimeInfo()
+CompositeData CompositeData::parse(Packet& p)
 {
-  return _i->hasTimeInfo;
+	CompositeData o;
+
+	parse(p, o);
+
+	return o;
 }
 
-TimeInfo CompositeData::timeInfo()
+void CompositeData::parse(Packet& p, CompositeData& o)
 {
-  if (!hasTimeInfo())
-    throw invalid_operation();
+	CompositeData* const v[] = { &o };
 
-  return _i->timeInfo;
+	parse(p, v, 1);
 }
 
-bool CompositeData::hasDop()
+void CompositeData::parse(Packet& p, vector<CompositeData*>& o)
 {
-  return _i->hasDop;
+	if (o.empty())
+		parse(p, NULL, 0);
+	else
+		parse(p, &o[0], o.size());
 }
 
-GnssDop CompositeData::dop()
+void CompositeData::parse(Packet& p, CompositeData* const o[], size_t count)
 {
-  if (!hasDop())
-    throw invalid_operation();
+	Targets t = { o, o + count };
 
-  return _i->dop;
+	parse(p, t);
 }
 
-CompositeData CompositeData::parse(Packet& p)
+void CompositeData::parseInto(Packet& p, CompositeData& o)
 {
-	CompositeData o;
+	o.reset();
 
 	parse(p, o);
+}
 
-	return o;
+namespace {
+
+template<typename P>
+void parseBatchOf(P* packets, size_t count, ColumnarBatch& batch)
+{
+	CompositeData scratch;
+
+	for (size_t i = 0; i < count; i++)
+	{
+		CompositeData::parseInto(packets[i], scratch);
+
+		batch.append(scratch);
+	}
 }
 
-void CompositeData::parse(Packet& p, CompositeData& o)
+}
+
+void CompositeData::parseBatch(Packet* packets, size_t count, ColumnarBatch& batch)
 {
-	vector<CompositeData*> v;
-	v.push_back(&o);
+	parseBatchOf(packets, count, batch);
+}
 
-	parse(p, v);
+void CompositeData::parseBatch(PacketView* packets, size_t count, ColumnarBatch& batch)
+{
+	parseBatchOf(packets, count, batch);
 }
 
-void CompositeData::parse(Packet& p, vector<CompositeData*>& o)
+void CompositeData::parse(Packet& p, const Targets& o)
 {
 	if (p.type() == Packet::TYPE_ASCII)
 		parseAscii(p, o);
@@ -2068,32 +846,32 @@ void CompositeData::parse(Packet& p, vector<CompositeData*>& o)
 
 void CompositeData::reset()
 {
-	_i->reset();
+	_i.reset();
 }
 
 bool CompositeData::hasAnyAttitude()
 {
-	return _i->mostRecentlyUpdatedAttitudeType != Impl::CDATT_None;
+	return _i.mostRecentlyUpdatedAttitudeType != Impl::CDATT_None;
 }
 
 AttitudeF CompositeData::anyAttitude()
 {
-	switch (_i->mostRecentlyUpdatedAttitudeType)
+	switch (_i.mostRecentlyUpdatedAttitudeType)
 	{
 	case Impl::CDATT_None:
 		throw invalid_operation("no attitude data present");
 	case Impl::CDATT_YawPitchRoll:
-		return AttitudeF::fromYprInDegs(_i->yawPitchRoll);
+		return AttitudeF::fromYprInDegs(_i.yawPitchRoll);
 	case Impl::CDATT_Quaternion:
-		return AttitudeF::fromQuat(_i->quaternion);
+		return AttitudeF::fromQuat(_i.quaternion);
 	case Impl::CDATT_DirectionCosineMatrix:
-		return AttitudeF::fromDcm(_i->directionConsineMatrix);
+		return AttitudeF::fromDcm(_i.directionConsineMatrix);
 	default:
 		throw not_implemented();
 	}
 }
 
-void CompositeData::parseAscii(Packet& p, vector<CompositeData*>& o)
+void CompositeData::parseAscii(Packet& p, const Targets& o)
 {
 	switch (p.determineAsciiAsyncType())
 	{
@@ -2105,7 +883,7 @@ void CompositeData::parseAscii(Packet& p, vector<CompositeData*>& o)
 		p.parseVNYPR(&ypr);
 
 		for (cditer i = o.begin(); i != o.end(); ++i)
-			(*i)->_i->setYawPitchRoll(ypr);
+			(*i)->_i.setYawPitchRoll(ypr);
 
 		break;
 	}
@@ -2117,7 +895,7 @@ void CompositeData::parseAscii(Packet& p, vector<CompositeData*>& o)
 		p.parseVNQTN(&quat);
 
 		for (cditer i = o.begin(); i != o.end(); ++i)
-			(*i)->_i->setQuaternion(quat);
+			(*i)->_i.setQuaternion(quat);
 
 		break;
 	}
@@ -2132,10 +910,10 @@ void CompositeData::parseAscii(Packet& p, vector<CompositeData*>& o)
 
 		for (cditer i = o.begin(); i != o.end(); ++i)
 		{
-			(*i)->_i->setQuaternion(quat);
-			(*i)->_i->setMagnetic(mag);
-			(*i)->_i->setAcceleration(accel);
-			(*i)->_i->setAngularRate(ar);
+			(*i)->_i.setQuaternion(quat);
+			(*i)->_i.setMagnetic(mag);
+			(*i)->_i.setAcceleration(accel);
+			(*i)->_i.setAngularRate(ar);
 		}
 
 		break;
@@ -2149,7 +927,7 @@ void CompositeData::parseAscii(Packet& p, vector<CompositeData*>& o)
 		p.parseVNMAG(&mag);
 
 		for (cditer i = o.begin(); i != o.end(); ++i)
-			(*i)->_i->setMagnetic(mag);
+			(*i)->_i.setMagnetic(mag);
 
 		break;
 	}
@@ -2161,7 +939,7 @@ void CompositeData::parseAscii(Packet& p, vector<CompositeData*>& o)
 		p.parseVNACC(&accel);
 
 		for (cditer i = o.begin(); i != o.end(); ++i)
-			(*i)->_i->setAcceleration(accel);
+			(*i)->_i.setAcceleration(accel);
 
 		break;
 	}
@@ -2173,7 +951,7 @@ void CompositeData::parseAscii(Packet& p, vector<CompositeData*>& o)
 		p.parseVNGYR(&ar);
 
 		for (cditer i = o.begin(); i != o.end(); ++i)
-			(*i)->_i->setAngularRate(ar);
+			(*i)->_i.setAngularRate(ar);
 
 		break;
 	}
@@ -2186,9 +964,9 @@ void CompositeData::parseAscii(Packet& p, vector<CompositeData*>& o)
 
 		for (cditer i = o.begin(); i != o.end(); ++i)
 		{
-			(*i)->_i->setMagnetic(mag);
-			(*i)->_i->setAcceleration(accel);
-			(*i)->_i->setAngularRate(ar);
+			(*i)->_i.setMagnetic(mag);
+			(*i)->_i.setAcceleration(accel);
+			(*i)->_i.setAngularRate(ar);
 		}
 
 		break;
@@ -2202,10 +980,10 @@ void CompositeData::parseAscii(Packet& p, vector<CompositeData*>& o)
 
 		for (cditer i = o.begin(); i != o.end(); ++i)
 		{
-			(*i)->_i->setYawPitchRoll(ypr);
-			(*i)->_i->setMagnetic(mag);
-			(*i)->_i->setAcceleration(accel);
-			(*i)->_i->setAngularRate(ar);
+			(*i)->_i.setYawPitchRoll(ypr);
+			(*i)->_i.setMagnetic(mag);
+			(*i)->_i.setAcceleration(accel);
+			(*i)->_i.setAngularRate(ar);
 		}
 
 		break;
@@ -2220,9 +998,9 @@ void CompositeData::parseAscii(Packet& p, vector<CompositeData*>& o)
 
 		for (cditer i = o.begin(); i != o.end(); ++i)
 		{
-			(*i)->_i->setYawPitchRoll(ypr);
-			(*i)->_i->setAccelerationLinearBody(accel);
-			(*i)->_i->setAngularRate(ar);
+			(*i)->_i.setYawPitchRoll(ypr);
+			(*i)->_i.setAccelerationLinearBody(accel);
+			(*i)->_i.setAngularRate(ar);
 		}
 
 		break;
@@ -2236,9 +1014,9 @@ void CompositeData::parseAscii(Packet& p, vector<CompositeData*>& o)
 
 		for (cditer i = o.begin(); i != o.end(); ++i)
 		{
-			(*i)->_i->setYawPitchRoll(ypr);
-			(*i)->_i->setAccelerationLinearNed(accel);
-			(*i)->_i->setAngularRate(ar);
+			(*i)->_i.setYawPitchRoll(ypr);
+			(*i)->_i.setAccelerationLinearNed(accel);
+			(*i)->_i.setAngularRate(ar);
 		}
 
 		break;
@@ -2254,11 +1032,11 @@ void CompositeData::parseAscii(Packet& p, vector<CompositeData*>& o)
 
 		for (cditer i = o.begin(); i != o.end(); ++i)
 		{
-			(*i)->_i->setMagneticUncompensated(mag);
-			(*i)->_i->setAccelerationUncompensated(accel);
-			(*i)->_i->setAngularRateUncompensated(ar);
-			(*i)->_i->setTemperature(temp);
-			(*i)->_i->setPressure(pres);
+			(*i)->_i.setMagneticUncompensated(mag);
+			(*i)->_i.setAccelerationUncompensated(accel);
+			(*i)->_i.setAngularRateUncompensated(ar);
+			(*i)->_i.setTemperature(temp);
+			(*i)->_i.setPressure(pres);
 		}
 
 		break;
@@ -2276,16 +1054,16 @@ void CompositeData::parseAscii(Packet& p, vector<CompositeData*>& o)
     p.parseVNGPS(&time, &week, &fix, &numSats, &lla, &nedVel, &nedAcc, &speedAcc, &timeAcc);
 
     for(cditer i = o.begin(); i != o.end(); ++i) {
-      (*i)->_i->setGpsTow(time);
-      (*i)->_i->setGpsWeek(week);
-      (*i)->_i->setFix(static_cast<GpsFix>(fix));
-      (*i)->_i->setNumSats(numSats);
-      (*i)->_i->setPositionGpsLla(lla);
-      (*i)->_i->setVelocityGpsNed(nedVel);
-      (*i)->_i->setPositionUncertaintyGpsNed(nedAcc);
-      (*i)->_i->setVelocityUncertaintyGps(speedAcc);
+      (*i)->_i.setGpsTow(time);
+      (*i)->_i.setGpsWeek(week);
+      (*i)->_i.setFix(static_cast<GpsFix>(fix));
+      (*i)->_i.setNumSats(numSats);
+      (*i)->_i.setPositionGpsLla(lla);
+      (*i)->_i.setVelocityGpsNed(nedVel);
+      (*i)->_i.setPositionUncertaintyGpsNed(nedAcc);
+      (*i)->_i.setVelocityUncertaintyGps(speedAcc);
       // Convert to uint32_t since this is the binary representation in nanoseconds.
-      (*i)->_i->setTimeUncertainty(static_cast<uint32_t>(timeAcc * 1e9));
+      (*i)->_i.setTimeUncertainty(static_cast<uint32_t>(timeAcc * 1e9));
     }
 
     break;
@@ -2303,16 +1081,16 @@ void CompositeData::parseAscii(Packet& p, vector<CompositeData*>& o)
     p.parseVNGPS(&time, &week, &fix, &numSats, &lla, &nedVel, &nedAcc, &speedAcc, &timeAcc);
 
     for(cditer i = o.begin(); i != o.end(); ++i) {
-      (*i)->_i->setGps2Tow(time);
-      (*i)->_i->setGps2Week(week);
-      (*i)->_i->setFix2(static_cast<GpsFix>(fix));
-      (*i)->_i->setNumSats2(numSats);
-      (*i)->_i->setPositionGps2Lla(lla);
-      (*i)->_i->setVelocityGps2Ned(nedVel);
-      (*i)->_i->setPositionUncertaintyGps2Ned(nedAcc);
-      (*i)->_i->setVelocityUncertaintyGps2(speedAcc);
+      (*i)->_i.setGps2Tow(time);
+      (*i)->_i.setGps2Week(week);
+      (*i)->_i.setFix2(static_cast<GpsFix>(fix));
+      (*i)->_i.setNumSats2(numSats);
+      (*i)->_i.setPositionGps2Lla(lla);
+      (*i)->_i.setVelocityGps2Ned(nedVel);
+      (*i)->_i.setPositionUncertaintyGps2Ned(nedAcc);
+      (*i)->_i.setVelocityUncertaintyGps2(speedAcc);
       // Convert to uint32_t since this is the binary representation in nanoseconds.
-      (*i)->_i->setTimeUncertainty2(static_cast<uint32_t>(timeAcc * 1e9));
+      (*i)->_i.setTimeUncertainty2(static_cast<uint32_t>(timeAcc * 1e9));
     }
 
     break;
@@ -2330,16 +1108,16 @@ void CompositeData::parseAscii(Packet& p, vector<CompositeData*>& o)
     p.parseVNGPE(&tow, &week, &fix, &numSats, &position, &ecefVel, &ecefAcc, &speedAcc, &timeAcc);
 
     for(cditer i = o.begin(); i != o.end(); ++i) {
-      (*i)->_i->setGpsTow(tow);
-      (*i)->_i->setGpsWeek(week);
-      (*i)->_i->setFix(static_cast<GpsFix>(fix));
-      (*i)->_i->setNumSats(numSats);
-      (*i)->_i->setPositionGpsEcef(position);
-      (*i)->_i->setVelocityGpsEcef(ecefVel);
-      (*i)->_i->setPositionUncertaintyGpsEcef(ecefAcc);
-      (*i)->_i->setVelocityUncertaintyGps(speedAcc);
+      (*i)->_i.setGpsTow(tow);
+      (*i)->_i.setGpsWeek(week);
+      (*i)->_i.setFix(static_cast<GpsFix>(fix));
+      (*i)->_i.setNumSats(numSats);
+      (*i)->_i.setPositionGpsEcef(position);
+      (*i)->_i.setVelocityGpsEcef(ecefVel);
+      (*i)->_i.setPositionUncertaintyGpsEcef(ecefAcc);
+      (*i)->_i.setVelocityUncertaintyGps(speedAcc);
       // Convert to uint32_t since this is the binary representation in nanoseconds.
-      (*i)->_i->setTimeUncertainty(static_cast<uint32_t>(timeAcc * 1e9));
+      (*i)->_i.setTimeUncertainty(static_cast<uint32_t>(timeAcc * 1e9));
     }
 
     break;
@@ -2357,16 +1135,16 @@ void CompositeData::parseAscii(Packet& p, vector<CompositeData*>& o)
     p.parseVNGPE(&tow, &week, &fix, &numSats, &position, &ecefVel, &ecefAcc, &speedAcc, &timeAcc);
 
     for(cditer i = o.begin(); i != o.end(); ++i) {
-      (*i)->_i->setGps2Tow(tow);
-      (*i)->_i->setGps2Week(week);
-      (*i)->_i->setFix2(static_cast<GpsFix>(fix));
-      (*i)->_i->setNumSats2(numSats);
-      (*i)->_i->setPositionGps2Ecef(position);
-      (*i)->_i->setVelocityGps2Ecef(ecefVel);
-      (*i)->_i->setPositionUncertaintyGps2Ecef(ecefAcc);
-      (*i)->_i->setVelocityUncertaintyGps2(speedAcc);
+      (*i)->_i.setGps2Tow(tow);
+      (*i)->_i.setGps2Week(week);
+      (*i)->_i.setFix2(static_cast<GpsFix>(fix));
+      (*i)->_i.setNumSats2(numSats);
+      (*i)->_i.setPositionGps2Ecef(position);
+      (*i)->_i.setVelocityGps2Ecef(ecefVel);
+      (*i)->_i.setPositionUncertaintyGps2Ecef(ecefAcc);
+      (*i)->_i.setVelocityUncertaintyGps2(speedAcc);
       // Convert to uint32_t since this is the binary representation in nanoseconds.
-      (*i)->_i->setTimeUncertainty2(static_cast<uint32_t>(timeAcc * 1e9));
+      (*i)->_i.setTimeUncertainty2(static_cast<uint32_t>(timeAcc * 1e9));
     }
 
     break;
@@ -2384,16 +1162,16 @@ void CompositeData::parseAscii(Packet& p, vector<CompositeData*>& o)
 
 		for (cditer i = o.begin(); i != o.end(); ++i)
 		{
-			(*i)->_i->setTow(tow);
-			(*i)->_i->setWeek(week);
-			(*i)->_i->setInsStatus(static_cast<InsStatus>(status));
-			(*i)->_i->setYawPitchRoll(ypr);
-			(*i)->_i->setPositionEstimatedLla(position);
-			(*i)->_i->setVelocityEstimatedNed(nedVel);
+			(*i)->_i.setTow(tow);
+			(*i)->_i.setWeek(week);
+			(*i)->_i.setInsStatus(static_cast<InsStatus>(status));
+			(*i)->_i.setYawPitchRoll(ypr);
+			(*i)->_i.setPositionEstimatedLla(position);
+			(*i)->_i.setVelocityEstimatedNed(nedVel);
 			// Binary data provides 3 components to yaw, pitch, roll uncertainty.
-			(*i)->_i->setAttitudeUncertainty(vec3f(attUncertainty));
-			(*i)->_i->setPositionUncertaintyEstimated(posUncertainty);
-			(*i)->_i->setVelocityUncertaintyEstimated(velUncertainty);
+			(*i)->_i.setAttitudeUncertainty(vec3f(attUncertainty));
+			(*i)->_i.setPositionUncertaintyEstimated(posUncertainty);
+			(*i)->_i.setVelocityUncertaintyEstimated(velUncertainty);
 		}
 
 		break;
@@ -2411,16 +1189,16 @@ void CompositeData::parseAscii(Packet& p, vector<CompositeData*>& o)
 
 		for (cditer i = o.begin(); i != o.end(); ++i)
 		{
-			(*i)->_i->setTow(tow);
-			(*i)->_i->setWeek(week);
-			(*i)->_i->setInsStatus(static_cast<InsStatus>(status));
-			(*i)->_i->setYawPitchRoll(ypr);
-			(*i)->_i->setPositionEstimatedEcef(position);
-			(*i)->_i->setVelocityEstimatedEcef(velocity);
+			(*i)->_i.setTow(tow);
+			(*i)->_i.setWeek(week);
+			(*i)->_i.setInsStatus(static_cast<InsStatus>(status));
+			(*i)->_i.setYawPitchRoll(ypr);
+			(*i)->_i.setPositionEstimatedEcef(position);
+			(*i)->_i.setVelocityEstimatedEcef(velocity);
 			// Binary data provides 3 components to yaw, pitch, roll uncertainty.
-			(*i)->_i->setAttitudeUncertainty(vec3f(attUncertainty));
-			(*i)->_i->setPositionUncertaintyEstimated(posUncertainty);
-			(*i)->_i->setVelocityUncertaintyEstimated(velUncertainty);
+			(*i)->_i.setAttitudeUncertainty(vec3f(attUncertainty));
+			(*i)->_i.setPositionUncertaintyEstimated(posUncertainty);
+			(*i)->_i.setVelocityUncertaintyEstimated(velUncertainty);
 		}
 
 		break;
@@ -2435,11 +1213,11 @@ void CompositeData::parseAscii(Packet& p, vector<CompositeData*>& o)
 
 		for (cditer i = o.begin(); i != o.end(); ++i)
 		{
-			(*i)->_i->setYawPitchRoll(ypr);
-			(*i)->_i->setPositionEstimatedLla(lla);
-			(*i)->_i->setVelocityEstimatedNed(velocity);
-			(*i)->_i->setAcceleration(accel);
-			(*i)->_i->setAngularRate(ar);
+			(*i)->_i.setYawPitchRoll(ypr);
+			(*i)->_i.setPositionEstimatedLla(lla);
+			(*i)->_i.setVelocityEstimatedNed(velocity);
+			(*i)->_i.setAcceleration(accel);
+			(*i)->_i.setAngularRate(ar);
 		}
 
 		break;
@@ -2454,11 +1232,11 @@ void CompositeData::parseAscii(Packet& p, vector<CompositeData*>& o)
 
 		for (cditer i = o.begin(); i != o.end(); ++i)
 		{
-			(*i)->_i->setYawPitchRoll(ypr);
-			(*i)->_i->setPositionEstimatedEcef(position);
-			(*i)->_i->setVelocityEstimatedEcef(velocity);
-			(*i)->_i->setAcceleration(accel);
-			(*i)->_i->setAngularRate(ar);
+			(*i)->_i.setYawPitchRoll(ypr);
+			(*i)->_i.setPositionEstimatedEcef(position);
+			(*i)->_i.setVelocityEstimatedEcef(velocity);
+			(*i)->_i.setAcceleration(accel);
+			(*i)->_i.setAngularRate(ar);
 		}
 
 		break;
@@ -2473,9 +1251,9 @@ void CompositeData::parseAscii(Packet& p, vector<CompositeData*>& o)
 
 		for (cditer i = o.begin(); i != o.end(); ++i)
 		{
-			(*i)->_i->setDeltaTime(deltaTime);
-			(*i)->_i->setDeltaTheta(deltaTheta);
-			(*i)->_i->setDeltaVelocity(deltaVel);
+			(*i)->_i.setDeltaTime(deltaTime);
+			(*i)->_i.setDeltaTheta(deltaTheta);
+			(*i)->_i.setDeltaVelocity(deltaVel);
 		}
 
 		break;
@@ -2488,397 +1266,342 @@ void CompositeData::parseAscii(Packet& p, vector<CompositeData*>& o)
 	}
 }
 
-void CompositeData::parseBinary(Packet& p, vector<CompositeData*>& o)
+uint8_t CompositeData_readUint8(const char* data)
 {
-	BinaryGroup groups = static_cast<BinaryGroup>(p.groups());
-	size_t curGroupFieldIndex = 0;
-
-	if (groups & BINARYGROUP_COMMON)
-		parseBinaryPacketCommonGroup(p, CommonGroup(p.groupField(curGroupFieldIndex++)), o);
-	if (groups & BINARYGROUP_TIME)
-		parseBinaryPacketTimeGroup(p, TimeGroup(p.groupField(curGroupFieldIndex++)), o);
-	if (groups & BINARYGROUP_IMU)
-		parseBinaryPacketImuGroup(p, ImuGroup(p.groupField(curGroupFieldIndex++)), o);
-	if (groups & BINARYGROUP_GPS)
-		parseBinaryPacketGpsGroup(p, GpsGroup(p.groupField(curGroupFieldIndex++)), o);
-	if (groups & BINARYGROUP_ATTITUDE)
-		parseBinaryPacketAttitudeGroup(p, AttitudeGroup(p.groupField(curGroupFieldIndex++)), o);
-	if (groups & BINARYGROUP_INS)
-		parseBinaryPacketInsGroup(p, InsGroup(p.groupField(curGroupFieldIndex++)), o);
-  if(groups & BINARYGROUP_GPS2)
-    parseBinaryPacketGps2Group(p, GpsGroup(p.groupField(curGroupFieldIndex++)), o);
+	return static_cast<uint8_t>(*data);
 }
 
-void CompositeData::parseBinaryPacketCommonGroup(Packet& p, CommonGroup gf, vector<CompositeData*>& o)
+int8_t CompositeData_readInt8(const char* data)
 {
-	if (gf & COMMONGROUP_TIMESTARTUP)
-		setValues(p.extractUint64(), o, &Impl::setTimeStartup);
+	return static_cast<int8_t>(*data);
+}
 
-	if (gf & COMMONGROUP_TIMEGPS)
-		setValues(p.extractUint64(), o, &Impl::setTimeGps);
+uint16_t CompositeData_readUint16(const char* data)
+{
+	uint16_t d;
 
-	if (gf & COMMONGROUP_TIMESYNCIN)
-		setValues(p.extractUint64(), o, &Impl::setTimeSyncIn);
+	memcpy(&d, data, sizeof(uint16_t));
 
-	if (gf & COMMONGROUP_YAWPITCHROLL)
-		setValues(p.extractVec3f(), o, &Impl::setYawPitchRoll);
+	return stoh(d);
+}
 
-	if (gf & COMMONGROUP_QUATERNION)
-		setValues(p.extractVec4f(), o, &Impl::setQuaternion);
+uint32_t CompositeData_readUint32(const char* data)
+{
+	uint32_t d;
 
-	if (gf & COMMONGROUP_ANGULARRATE)
-		setValues(p.extractVec3f(), o, &Impl::setAngularRate);
+	memcpy(&d, data, sizeof(uint32_t));
 
-	if (gf & COMMONGROUP_POSITION)
-		setValues(p.extractVec3d(), o, &Impl::setPositionEstimatedLla);
+	return stoh(d);
+}
 
-	if (gf & COMMONGROUP_VELOCITY)
-		setValues(p.extractVec3f(), o, &Impl::setVelocityEstimatedNed);
+uint64_t CompositeData_readUint64(const char* data)
+{
+	uint64_t d;
 
-	if (gf & COMMONGROUP_ACCEL)
-		setValues(p.extractVec3f(), o, &Impl::setAcceleration);
+	memcpy(&d, data, sizeof(uint64_t));
 
-	if (gf & COMMONGROUP_IMU)
-	{
-		setValues(p.extractVec3f(), o, &Impl::setAccelerationUncompensated);
-		setValues(p.extractVec3f(), o, &Impl::setAngularRateUncompensated);
-	}
+	return stoh(d);
+}
 
-	if (gf & COMMONGROUP_MAGPRES)
-	{
-		setValues(p.extractVec3f(), o, &Impl::setMagnetic);
-		setValues(p.extractFloat(), o, &Impl::setTemperature);
-		setValues(p.extractFloat(), o, &Impl::setPressure);
-	}
+float CompositeData_readFloat(const char* data)
+{
+	float f;
 
-	if (gf & COMMONGROUP_DELTATHETA)
-	{
-		setValues(p.extractFloat(), o, &Impl::setDeltaTime);
-		setValues(p.extractVec3f(), o, &Impl::setDeltaTheta);
-		setValues(p.extractVec3f(), o, &Impl::setDeltaVelocity);
-	}
+	memcpy(&f, data, sizeof(float));
 
-	if (gf & COMMONGROUP_INSSTATUS)
-	{
-		// Don't know if this is a VN-100, VN-200 or VN-300 so we can't know for sure if
-		// this is VpeStatus or InsStatus.
-		uint16_t v = p.extractUint16();
-		setValues(VpeStatus(v), o, &Impl::setVpeStatus);
-		setValues(InsStatus(v), o, &Impl::setInsStatus);
-	}
+	return f;
+}
 
-	if (gf & COMMONGROUP_SYNCINCNT)
-		setValues(p.extractUint32(), o, &Impl::setSyncInCnt);
+vec3f CompositeData_readVec3f(const char* data)
+{
+	vec3f d;
 
-	if (gf & COMMONGROUP_TIMEGPSPPS)
-		setValues(p.extractUint64(), o, &Impl::setTimeGpsPps);
+	memcpy(&d.x, data, sizeof(float));
+	memcpy(&d.y, data + sizeof(float), sizeof(float));
+	memcpy(&d.z, data + 2 * sizeof(float), sizeof(float));
 
+	return d;
 }
 
-void CompositeData::parseBinaryPacketTimeGroup(Packet& p, TimeGroup gf, vector<CompositeData*>& o)
+vec3d CompositeData_readVec3d(const char* data)
 {
-	if (gf & TIMEGROUP_TIMESTARTUP)
-		setValues(p.extractUint64(), o, &Impl::setTimeStartup);
+	vec3d d;
 
-	if (gf & TIMEGROUP_TIMEGPS)
-		setValues(p.extractUint64(), o, &Impl::setTimeGps);
+	memcpy(&d.x, data, sizeof(double));
+	memcpy(&d.y, data + sizeof(double), sizeof(double));
+	memcpy(&d.z, data + 2 * sizeof(double), sizeof(double));
 
-	if (gf & TIMEGROUP_GPSTOW)
-		setValues(((double)p.extractUint64()/1000000000), o, &Impl::setTow);
+	return d;
+}
 
-	if (gf & TIMEGROUP_GPSWEEK)
-		setValues(p.extractUint16(), o, &Impl::setWeek);
+vec4f CompositeData_readVec4f(const char* data)
+{
+	vec4f d;
 
-	if (gf & TIMEGROUP_TIMESYNCIN)
-		setValues(p.extractUint64(), o, &Impl::setTimeSyncIn);
+	memcpy(&d.x, data, sizeof(float));
+	memcpy(&d.y, data + sizeof(float), sizeof(float));
+	memcpy(&d.z, data + 2 * sizeof(float), sizeof(float));
+	memcpy(&d.w, data + 3 * sizeof(float), sizeof(float));
 
-	if (gf & TIMEGROUP_TIMEGPSPPS)
-		setValues(p.extractUint64(), o, &Impl::setTimeGpsPps);
+	return d;
+}
 
-	if (gf & TIMEGROUP_TIMEUTC)
-	{
-		TimeUtc t;
+mat3f CompositeData_readMat3f(const char* data)
+{
+	mat3f m;
 
-		t.year = p.extractInt8();
-		t.month = p.extractUint8();
-		t.day = p.extractUint8();
-		t.hour = p.extractUint8();
-		t.min = p.extractUint8();
-		t.sec = p.extractUint8();
-		t.ms = p.extractUint16();
+	memcpy(&m.e00, data, sizeof(float));
+	memcpy(&m.e10, data + sizeof(float), sizeof(float));
+	memcpy(&m.e20, data + 2 * sizeof(float), sizeof(float));
+	memcpy(&m.e01, data + 3 * sizeof(float), sizeof(float));
+	memcpy(&m.e11, data + 4 * sizeof(float), sizeof(float));
+	memcpy(&m.e21, data + 5 * sizeof(float), sizeof(float));
+	memcpy(&m.e02, data + 6 * sizeof(float), sizeof(float));
+	memcpy(&m.e12, data + 7 * sizeof(float), sizeof(float));
+	memcpy(&m.e22, data + 8 * sizeof(float), sizeof(float));
 
-		setValues(t, o, &Impl::setTimeUtc);
-	}
+	return m;
+}
 
-	if (gf & TIMEGROUP_SYNCINCNT)
-		setValues(p.extractUint32(), o, &Impl::setSyncInCnt);
+TimeUtc CompositeData_readTimeUtc(const char* data)
+{
+	TimeUtc t;
 
-  if (gf & TIMEGROUP_SYNCOUTCNT)
-    setValues(p.extractUint32(), o, &Impl::setSyncOutCnt);
+	t.year = CompositeData_readInt8(data);
+	t.month = CompositeData_readUint8(data + 1);
+	t.day = CompositeData_readUint8(data + 2);
+	t.hour = CompositeData_readUint8(data + 3);
+	t.min = CompositeData_readUint8(data + 4);
+	t.sec = CompositeData_readUint8(data + 5);
+	t.ms = CompositeData_readUint16(data + 6);
 
-  if (gf & TIMEGROUP_TIMESTATUS)
-    setValues(p.extractUint8(), o, &Impl::setTimeStatus);
+	return t;
 }
 
-void CompositeData::parseBinaryPacketImuGroup(Packet& p, ImuGroup gf, vector<CompositeData*>& o)
+TimeInfo CompositeData_readTimeInfo(const char* data)
 {
-	if (gf & IMUGROUP_IMUSTATUS)
-		// This field is currently reserved.
-		p.extractUint16();
-
-	if (gf & IMUGROUP_UNCOMPMAG)
-		setValues(p.extractVec3f(), o, &Impl::setMagneticUncompensated);
+	TimeInfo t;
 
-	if (gf & IMUGROUP_UNCOMPACCEL)
-		setValues(p.extractVec3f(), o, &Impl::setAccelerationUncompensated);
+	t.timeStatus = CompositeData_readUint8(data);
+	t.leapSecs = CompositeData_readInt8(data + 1);
 
-	if (gf & IMUGROUP_UNCOMPGYRO)
-		setValues(p.extractVec3f(), o, &Impl::setAngularRateUncompensated);
-
-	if (gf & IMUGROUP_TEMP)
-		setValues(p.extractFloat(), o, &Impl::setTemperature);
+	return t;
+}
 
-	if (gf & IMUGROUP_PRES)
-		setValues(p.extractFloat(), o, &Impl::setPressure);
+GnssDop CompositeData_readGnssDop(const char* data)
+{
+	GnssDop d;
 
-	if (gf & IMUGROUP_DELTATHETA)
-	{
-		setValues(p.extractFloat(), o, &Impl::setDeltaTime);
-		setValues(p.extractVec3f(), o, &Impl::setDeltaTheta);
-	}
+	d.gDop = CompositeData_readFloat(data);
+	d.pDop = CompositeData_readFloat(data + 4);
+	d.tDop = CompositeData_readFloat(data + 8);
+	d.vDop = CompositeData_readFloat(data + 12);
+	d.hDop = CompositeData_readFloat(data + 16);
+	d.nDop = CompositeData_readFloat(data + 20);
+	d.eDop = CompositeData_readFloat(data + 24);
 
-	if (gf & IMUGROUP_DELTAVEL)
-		setValues(p.extractVec3f(), o, &Impl::setDeltaVelocity);
+	return d;
+}
 
-	if (gf & IMUGROUP_MAG)
-		setValues(p.extractVec3f(), o, &Impl::setMagnetic);
+VpeStatus CompositeData_readVpeStatus(const char* data)
+{
+	return VpeStatus(CompositeData_readUint16(data));
+}
 
-	if (gf & IMUGROUP_ACCEL)
-		setValues(p.extractVec3f(), o, &Impl::setAcceleration);
+InsStatus CompositeData_readInsStatus(const char* data)
+{
+	return InsStatus(CompositeData_readUint16(data));
+}
 
-	if (gf & IMUGROUP_ANGULARRATE)
-		setValues(p.extractVec3f(), o, &Impl::setAngularRate);
+SensSat CompositeData_readSensSat(const char* data)
+{
+	return SensSat(CompositeData_readUint16(data));
+}
 
-	if (gf & IMUGROUP_SENSSAT)
-		setValues(SensSat(p.extractUint16()), o, &Impl::setSensSat);
+GpsFix CompositeData_readGpsFix(const char* data)
+{
+	return GpsFix(CompositeData_readUint8(data));
+}
 
+double CompositeData_readTow(const char* data)
+{
+	return ((double)CompositeData_readUint64(data)/1000000000);
 }
 
-void CompositeData::parseBinaryPacketGpsGroup(Packet& p, GpsGroup gf, vector<CompositeData*>& o)
+const CompositeData::BinaryFieldParser CompositeData::BinaryFieldParsers[7][15] =
 {
-	if (gf & GPSGROUP_UTC)
+	// Group 1 (Common)
 	{
-		TimeUtc t;
-
-		t.year = p.extractInt8();
-		t.month = p.extractUint8();
-		t.day = p.extractUint8();
-		t.hour = p.extractUint8();
-		t.min = p.extractUint8();
-		t.sec = p.extractUint8();
-		t.ms = p.extractUint16();
-
-		setValues(t, o, &Impl::setTimeUtc);
+		&parseBinaryField<uint64_t, CompositeData_readUint64, &Impl::setTimeStartup>,
+		&parseBinaryField<uint64_t, CompositeData_readUint64, &Impl::setTimeGps>,
+		&parseBinaryField<uint64_t, CompositeData_readUint64, &Impl::setTimeSyncIn>,
+		&parseBinaryField<vec3f, CompositeData_readVec3f, &Impl::setYawPitchRoll>,
+		&parseBinaryField<vec4f, CompositeData_readVec4f, &Impl::setQuaternion>,
+		&parseBinaryField<vec3f, CompositeData_readVec3f, &Impl::setAngularRate>,
+		&parseBinaryField<vec3d, CompositeData_readVec3d, &Impl::setPositionEstimatedLla>,
+		&parseBinaryField<vec3f, CompositeData_readVec3f, &Impl::setVelocityEstimatedNed>,
+		&parseBinaryField<vec3f, CompositeData_readVec3f, &Impl::setAcceleration>,
+		&parseBinaryPacketCommonImu,
+		&parseBinaryPacketCommonMagPres,
+		&parseBinaryPacketCommonDeltaTheta,
+		&parseBinaryPacketCommonInsStatus,
+		&parseBinaryField<uint32_t, CompositeData_readUint32, &Impl::setSyncInCnt>,
+		&parseBinaryField<uint64_t, CompositeData_readUint64, &Impl::setTimeGpsPps>
+	},
+	// Group 2 (Time)
+	{
+		&parseBinaryField<uint64_t, CompositeData_readUint64, &Impl::setTimeStartup>,
+		&parseBinaryField<uint64_t, CompositeData_readUint64, &Impl::setTimeGps>,
+		&parseBinaryField<double, CompositeData_readTow, &Impl::setTow>,
+		&parseBinaryField<uint16_t, CompositeData_readUint16, &Impl::setWeek>,
+		&parseBinaryField<uint64_t, CompositeData_readUint64, &Impl::setTimeSyncIn>,
+		&parseBinaryField<uint64_t, CompositeData_readUint64, &Impl::setTimeGpsPps>,
+		&parseBinaryField<TimeUtc, CompositeData_readTimeUtc, &Impl::setTimeUtc>,
+		&parseBinaryField<uint32_t, CompositeData_readUint32, &Impl::setSyncInCnt>,
+		&parseBinaryField<uint32_t, CompositeData_readUint32, &Impl::setSyncOutCnt>,
+		&parseBinaryField<uint8_t, CompositeData_readUint8, &Impl::setTimeStatus>,
+		NULL, NULL, NULL, NULL, NULL
+	},
+	// Group 3 (IMU)
+	{
+		NULL,	// ImuStatus is currently reserved.
+		&parseBinaryField<vec3f, CompositeData_readVec3f, &Impl::setMagneticUncompensated>,
+		&parseBinaryField<vec3f, CompositeData_readVec3f, &Impl::setAccelerationUncompensated>,
+		&parseBinaryField<vec3f, CompositeData_readVec3f, &Impl::setAngularRateUncompensated>,
+		&parseBinaryField<float, CompositeData_readFloat, &Impl::setTemperature>,
+		&parseBinaryField<float, CompositeData_readFloat, &Impl::setPressure>,
+		&parseBinaryPacketImuDeltaTheta,
+		&parseBinaryField<vec3f, CompositeData_readVec3f, &Impl::setDeltaVelocity>,
+		&parseBinaryField<vec3f, CompositeData_readVec3f, &Impl::setMagnetic>,
+		&parseBinaryField<vec3f, CompositeData_readVec3f, &Impl::setAcceleration>,
+		&parseBinaryField<vec3f, CompositeData_readVec3f, &Impl::setAngularRate>,
+		&parseBinaryField<SensSat, CompositeData_readSensSat, &Impl::setSensSat>,
+		NULL, NULL, NULL
+	},
+	// Group 4 (GPS)
+	{
+		&parseBinaryField<TimeUtc, CompositeData_readTimeUtc, &Impl::setTimeUtc>,
+		&parseBinaryField<uint64_t, CompositeData_readUint64, &Impl::setGpsTow>,
+		&parseBinaryField<uint16_t, CompositeData_readUint16, &Impl::setGpsWeek>,
+		&parseBinaryField<uint8_t, CompositeData_readUint8, &Impl::setNumSats>,
+		&parseBinaryField<GpsFix, CompositeData_readGpsFix, &Impl::setFix>,
+		&parseBinaryField<vec3d, CompositeData_readVec3d, &Impl::setPositionGpsLla>,
+		&parseBinaryField<vec3d, CompositeData_readVec3d, &Impl::setPositionGpsEcef>,
+		&parseBinaryField<vec3f, CompositeData_readVec3f, &Impl::setVelocityGpsNed>,
+		&parseBinaryField<vec3f, CompositeData_readVec3f, &Impl::setVelocityGpsEcef>,
+		&parseBinaryField<vec3f, CompositeData_readVec3f, &Impl::setPositionUncertaintyGpsNed>,
+		&parseBinaryField<float, CompositeData_readFloat, &Impl::setVelocityUncertaintyGps>,
+		&parseBinaryField<uint32_t, CompositeData_readUint32, &Impl::setTimeUncertainty>,
+		&parseBinaryField<TimeInfo, CompositeData_readTimeInfo, &Impl::setTimeInfo>,
+		&parseBinaryField<GnssDop, CompositeData_readGnssDop, &Impl::setGnssDop>,
+		NULL
+	},
+	// Group 5 (Attitude)
+	{
+		&parseBinaryField<VpeStatus, CompositeData_readVpeStatus, &Impl::setVpeStatus>,
+		&parseBinaryField<vec3f, CompositeData_readVec3f, &Impl::setYawPitchRoll>,
+		&parseBinaryField<vec4f, CompositeData_readVec4f, &Impl::setQuaternion>,
+		&parseBinaryField<mat3f, CompositeData_readMat3f, &Impl::setDirectionConsineMatrix>,
+		&parseBinaryField<vec3f, CompositeData_readVec3f, &Impl::setMagneticNed>,
+		&parseBinaryField<vec3f, CompositeData_readVec3f, &Impl::setAccelerationNed>,
+		&parseBinaryField<vec3f, CompositeData_readVec3f, &Impl::setAccelerationLinearBody>,
+		&parseBinaryField<vec3f, CompositeData_readVec3f, &Impl::setAccelerationLinearNed>,
+		&parseBinaryField<vec3f, CompositeData_readVec3f, &Impl::setAttitudeUncertainty>,
+		NULL, NULL, NULL, NULL, NULL, NULL
+	},
+	// Group 6 (INS)
+	{
+		&parseBinaryField<InsStatus, CompositeData_readInsStatus, &Impl::setInsStatus>,
+		&parseBinaryField<vec3d, CompositeData_readVec3d, &Impl::setPositionEstimatedLla>,
+		&parseBinaryField<vec3d, CompositeData_readVec3d, &Impl::setPositionEstimatedEcef>,
+		&parseBinaryField<vec3f, CompositeData_readVec3f, &Impl::setVelocityEstimatedBody>,
+		&parseBinaryField<vec3f, CompositeData_readVec3f, &Impl::setVelocityEstimatedNed>,
+		&parseBinaryField<vec3f, CompositeData_readVec3f, &Impl::setVelocityEstimatedEcef>,
+		&parseBinaryField<vec3f, CompositeData_readVec3f, &Impl::setMagneticEcef>,
+		&parseBinaryField<vec3f, CompositeData_readVec3f, &Impl::setAccelerationEcef>,
+		&parseBinaryField<vec3f, CompositeData_readVec3f, &Impl::setAccelerationLinearEcef>,
+		&parseBinaryField<float, CompositeData_readFloat, &Impl::setPositionUncertaintyEstimated>,
+		&parseBinaryField<float, CompositeData_readFloat, &Impl::setVelocityUncertaintyEstimated>,
+		NULL, NULL, NULL, NULL
+	},
+	// Group 7 (GPS2)
+	{
+		&parseBinaryField<TimeUtc, CompositeData_readTimeUtc, &Impl::setTimeUtc2>,
+		&parseBinaryField<uint64_t, CompositeData_readUint64, &Impl::setGps2Tow>,
+		&parseBinaryField<uint16_t, CompositeData_readUint16, &Impl::setGps2Week>,
+		&parseBinaryField<uint8_t, CompositeData_readUint8, &Impl::setNumSats2>,
+		&parseBinaryField<GpsFix, CompositeData_readGpsFix, &Impl::setFix2>,
+		&parseBinaryField<vec3d, CompositeData_readVec3d, &Impl::setPositionGps2Lla>,
+		&parseBinaryField<vec3d, CompositeData_readVec3d, &Impl::setPositionGps2Ecef>,
+		&parseBinaryField<vec3f, CompositeData_readVec3f, &Impl::setVelocityGps2Ned>,
+		&parseBinaryField<vec3f, CompositeData_readVec3f, &Impl::setVelocityGps2Ecef>,
+		&parseBinaryField<vec3f, CompositeData_readVec3f, &Impl::setPositionUncertaintyGps2Ned>,
+		&parseBinaryField<float, CompositeData_readFloat, &Impl::setVelocityUncertaintyGps2>,
+		&parseBinaryField<uint32_t, CompositeData_readUint32, &Impl::setTimeUncertainty2>,
+		&parseBinaryField<TimeInfo, CompositeData_readTimeInfo, &Impl::setTimeInfo2>,
+		&parseBinaryField<GnssDop, CompositeData_readGnssDop, &Impl::setGnssDop2>,
+		NULL
 	}
+};
 
-	if (gf & GPSGROUP_TOW)
-		setValues(p.extractUint64(), o, &Impl::setGpsTow);
-
-	if (gf & GPSGROUP_WEEK)
-		setValues(p.extractUint16(), o, &Impl::setGpsWeek);
-
-	if (gf & GPSGROUP_NUMSATS)
-		setValues(p.extractUint8(), o, &Impl::setNumSats);
-
-	if (gf & GPSGROUP_FIX)
-		setValues(GpsFix(p.extractUint8()), o, &Impl::setFix);
-
-	if (gf & GPSGROUP_POSLLA)
-		setValues(p.extractVec3d(), o, &Impl::setPositionGpsLla);
-
-	if (gf & GPSGROUP_POSECEF)
-		setValues(p.extractVec3d(), o, &Impl::setPositionGpsEcef);
-
-	if (gf & GPSGROUP_VELNED)
-		setValues(p.extractVec3f(), o, &Impl::setVelocityGpsNed);
-
-	if (gf & GPSGROUP_VELECEF)
-		setValues(p.extractVec3f(), o, &Impl::setVelocityGpsEcef);
-
-	if (gf & GPSGROUP_POSU)
-		setValues(p.extractVec3f(), o, &Impl::setPositionUncertaintyGpsNed);
-
-	if (gf & GPSGROUP_VELU)
-		setValues(p.extractFloat(), o, &Impl::setVelocityUncertaintyGps);
-
-	if (gf & GPSGROUP_TIMEU)
-		setValues(p.extractUint32(), o, &Impl::setTimeUncertainty);
-
-  if (gf & GPSGROUP_TIMEINFO)
-  {
-      TimeInfo t;
+void CompositeData::parseBinary(Packet& p, const Targets& o)
+{
+	const char* data = p.data();
 
-      t.timeStatus = p.extractUint8();
-      t.leapSecs = p.extractInt8();
+	// The whole header must be present before we can look up its plan.
+	if (p.length() < 2 || p.length() < 2 + 2 * static_cast<size_t>(countSetBits(static_cast<uint8_t>(data[1]))))
+		throw invalid_operation();
 
-      setValues(t, o, &Impl::setTimeInfo);
-  }
+	BinaryPlan scratch;
+	const BinaryPlan& plan = BinaryPlan::get(data, scratch);
 
-  if (gf & GPSGROUP_DOP)
-  {
-    GnssDop d;
+	if (p.length() < plan.length)
+		// The packet is too short for the fields its header says it has.
+		throw invalid_operation();
 
-    d.gDop = p.extractFloat();
-    d.pDop = p.extractFloat();
-    d.tDop = p.extractFloat();
-    d.vDop = p.extractFloat();
-    d.hDop = p.extractFloat();
-    d.nDop = p.extractFloat();
-    d.eDop = p.extractFloat();
+	for (size_t i = 0; i < plan.numOfFields; i++)
+	{
+		const BinaryPlan::Field& field = plan.fields[i];
+		BinaryFieldParser parser = BinaryFieldParsers[field.code >> 4][field.code & 0x0F];
 
-    setValues(d, o, &Impl::setGnssDop);
-  }
+		if (parser != NULL)
+			parser(data + field.offset, o);
+	}
 }
 
-void CompositeData::parseBinaryPacketAttitudeGroup(Packet& p, AttitudeGroup gf, vector<CompositeData*>& o)
+void CompositeData::parseBinaryPacketCommonImu(const char* data, const Targets& o)
 {
-	if (gf & ATTITUDEGROUP_VPESTATUS)
-		setValues(VpeStatus(p.extractUint16()), o, &Impl::setVpeStatus);
-
-	if (gf & ATTITUDEGROUP_YAWPITCHROLL)
-		setValues(p.extractVec3f(), o, &Impl::setYawPitchRoll);
-
-	if (gf & ATTITUDEGROUP_QUATERNION)
-		setValues(p.extractVec4f(), o, &Impl::setQuaternion);
-
-	if (gf & ATTITUDEGROUP_DCM)
-		setValues(p.extractMat3f(), o, &Impl::setDirectionConsineMatrix);
-
-	if (gf & ATTITUDEGROUP_MAGNED)
-		setValues(p.extractVec3f(), o, &Impl::setMagneticNed);
-
-	if (gf & ATTITUDEGROUP_ACCELNED)
-		setValues(p.extractVec3f(), o, &Impl::setAccelerationNed);
-
-	if (gf & ATTITUDEGROUP_LINEARACCELBODY)
-		setValues(p.extractVec3f(), o, &Impl::setAccelerationLinearBody);
-
-	if (gf & ATTITUDEGROUP_LINEARACCELNED)
-		setValues(p.extractVec3f(), o, &Impl::setAccelerationLinearNed);
-
-	if (gf & ATTITUDEGROUP_YPRU)
-		setValues(p.extractVec3f(), o, &Impl::setAttitudeUncertainty);
-
+	setValues(CompositeData_readVec3f(data), o, &Impl::setAccelerationUncompensated);
+	setValues(CompositeData_readVec3f(data + 12), o, &Impl::setAngularRateUncompensated);
 }
 
-void CompositeData::parseBinaryPacketInsGroup(Packet& p, InsGroup gf, vector<CompositeData*>& o)
+void CompositeData::parseBinaryPacketCommonMagPres(const char* data, const Targets& o)
 {
-	if (gf & INSGROUP_INSSTATUS)
-		setValues(InsStatus(p.extractUint16()), o, &Impl::setInsStatus);
-
-	if (gf & INSGROUP_POSLLA)
-		setValues(p.extractVec3d(), o, &Impl::setPositionEstimatedLla);
-
-	if (gf & INSGROUP_POSECEF)
-		setValues(p.extractVec3d(), o, &Impl::setPositionEstimatedEcef);
-
-	if (gf & INSGROUP_VELBODY)
-		setValues(p.extractVec3f(), o, &Impl::setVelocityEstimatedBody);
-
-	if (gf & INSGROUP_VELNED)
-		setValues(p.extractVec3f(), o, &Impl::setVelocityEstimatedNed);
-
-	if (gf & INSGROUP_VELECEF)
-		setValues(p.extractVec3f(), o, &Impl::setVelocityEstimatedEcef);
-
-	if (gf & INSGROUP_MAGECEF)
-		setValues(p.extractVec3f(), o, &Impl::setMagneticEcef);
-
-	if (gf & INSGROUP_ACCELECEF)
-		setValues(p.extractVec3f(), o, &Impl::setAccelerationEcef);
-
-	if (gf & INSGROUP_LINEARACCELECEF)
-		setValues(p.extractVec3f(), o, &Impl::setAccelerationLinearEcef);
-
-	if (gf & INSGROUP_POSU)
-		setValues(p.extractFloat(), o, &Impl::setPositionUncertaintyEstimated);
-
-	if (gf & INSGROUP_VELU)
-		setValues(p.extractFloat(), o, &Impl::setVelocityUncertaintyEstimated);
-
+	setValues(CompositeData_readVec3f(data), o, &Impl::setMagnetic);
+	setValues(CompositeData_readFloat(data + 12), o, &Impl::setTemperature);
+	setValues(CompositeData_readFloat(data + 16), o, &Impl::setPressure);
 }
 
-void CompositeData::parseBinaryPacketGps2Group(Packet& p, GpsGroup gf, vector<CompositeData*>& o)
+void CompositeData::parseBinaryPacketCommonDeltaTheta(const char* data, const Targets& o)
 {
-  if(gf & GPSGROUP_UTC) {
-    TimeUtc t;
-
-    t.year = p.extractInt8();
-    t.month = p.extractUint8();
-    t.day = p.extractUint8();
-    t.hour = p.extractUint8();
-    t.min = p.extractUint8();
-    t.sec = p.extractUint8();
-    t.ms = p.extractUint16();
-
-    setValues(t, o, &Impl::setTimeUtc2);
-  }
-
-  if(gf & GPSGROUP_TOW)
-    setValues(p.extractUint64(), o, &Impl::setGps2Tow);
-
-  if(gf & GPSGROUP_WEEK)
-    setValues(p.extractUint16(), o, &Impl::setGps2Week);
-
-  if(gf & GPSGROUP_NUMSATS)
-    setValues(p.extractUint8(), o, &Impl::setNumSats2);
-
-  if(gf & GPSGROUP_FIX)
-    setValues(GpsFix(p.extractUint8()), o, &Impl::setFix2);
-
-  if(gf & GPSGROUP_POSLLA)
-    setValues(p.extractVec3d(), o, &Impl::setPositionGps2Lla);
-
-  if(gf & GPSGROUP_POSECEF)
-    setValues(p.extractVec3d(), o, &Impl::setPositionGps2Ecef);
-
-  if(gf & GPSGROUP_VELNED)
-    setValues(p.extractVec3f(), o, &Impl::setVelocityGps2Ned);
-
-  if(gf & GPSGROUP_VELECEF)
-    setValues(p.extractVec3f(), o, &Impl::setVelocityGps2Ecef);
-
-  if(gf & GPSGROUP_POSU)
-    setValues(p.extractVec3f(), o, &Impl::setPositionUncertaintyGps2Ned);
-
-  if(gf & GPSGROUP_VELU)
-    setValues(p.extractFloat(), o, &Impl::setVelocityUncertaintyGps2);
-
-  if(gf & GPSGROUP_TIMEU)
-    setValues(p.extractUint32(), o, &Impl::setTimeUncertainty2);
-
-  if(gf & GPSGROUP_TIMEINFO) {
-    TimeInfo t;
-
-    t.timeStatus = p.extractUint8();
-    t.leapSecs = p.extractInt8();
-
-    setValues(t, o, &Impl::setTimeInfo2);
-  }
-
-  if(gf & GPSGROUP_DOP) {
-    GnssDop d;
+	setValues(CompositeData_readFloat(data), o, &Impl::setDeltaTime);
+	setValues(CompositeData_readVec3f(data + 4), o, &Impl::setDeltaTheta);
+	setValues(CompositeData_readVec3f(data + 16), o, &Impl::setDeltaVelocity);
+}
 
-    d.gDop = p.extractFloat();
-    d.pDop = p.extractFloat();
-    d.tDop = p.extractFloat();
-    d.vDop = p.extractFloat();
-    d.hDop = p.extractFloat();
-    d.nDop = p.extractFloat();
-    d.eDop = p.extractFloat();
+void CompositeData::parseBinaryPacketCommonInsStatus(const char* data, const Targets& o)
+{
+	// Don't know if this is a VN-100, VN-200 or VN-300 so we can't know for sure if
+	// this is VpeStatus or InsStatus.
+	uint16_t v = CompositeData_readUint16(data);
+	setValues(VpeStatus(v), o, &Impl::setVpeStatus);
+	setValues(InsStatus(v), o, &Impl::setInsStatus);
+}
 
-    setValues(d, o, &Impl::setGnssDop2);
-  }
+void CompositeData::parseBinaryPacketImuDeltaTheta(const char* data, const Targets& o)
+{
+	setValues(CompositeData_readFloat(data), o, &Impl::setDeltaTime);
+	setValues(CompositeData_readVec3f(data + 4), o, &Impl::setDeltaTheta);
 }
 
 
@@ -0,0 +1,722 @@
+#include "gtest/gtest.h"
+
+#include "vn/compositedata.h"
+#include "vn/packet.h"
+#include "vn/error_detection.h"
+#include "vn/exceptions.h"
+
+#include <cstring>
+#include <vector>
+
+using namespace std;
+using namespace vn::math;
+using namespace vn::sensors;
+using namespace vn::protocol::uart;
+using namespace vn::data::integrity;
+
+namespace {
+
+// A binary packet holding only YawPitchRoll in the common group.
+Packet makeYawPitchRollPacket(float yaw, float pitch, float roll)
+{
+	char packet[18];
+	packet[0] = static_cast<char>(0xFA);
+	packet[1] = 0x01;
+	packet[2] = 0x08;
+	packet[3] = 0x00;
+	memcpy(packet + 4, &yaw, 4);
+	memcpy(packet + 8, &pitch, 4);
+	memcpy(packet + 12, &roll, 4);
+
+	uint16_t crc = Crc16::compute(packet + 1, 15);
+	packet[16] = static_cast<char>(crc >> 8);
+	packet[17] = static_cast<char>(crc & 0xFF);
+
+	return Packet(packet, sizeof(packet));
+}
+
+// Deterministic generator so every run sees the same packets.
+class PayloadRandom
+{
+public:
+	PayloadRandom() : _state(88172645463325252ULL) { }
+
+	uint64_t next()
+	{
+		_state ^= _state << 13;
+		_state ^= _state >> 7;
+		_state ^= _state << 17;
+
+		return _state;
+	}
+
+private:
+	uint64_t _state;
+};
+
+// Builds a binary packet with the fields selected for each of the seven
+// groups and a random payload. The payload bytes are kept below 0x40 so
+// every float and double in it is finite.
+Packet makeGroupsPacket(const uint16_t fields[7], PayloadRandom& rnd)
+{
+	vector<char> packet;
+	packet.push_back(static_cast<char>(0xFA));
+	packet.push_back(0);
+
+	for (size_t i = 0; i < 7; i++)
+	{
+		if (fields[i] == 0)
+			continue;
+
+		packet[1] = static_cast<char>(packet[1] | (1 << i));
+		packet.push_back(static_cast<char>(fields[i] & 0xFF));
+		packet.push_back(static_cast<char>(fields[i] >> 8));
+	}
+
+	size_t length = Packet::computeBinaryPacketLength(&packet[0]);
+
+	while (packet.size() < length - 2)
+		packet.push_back(static_cast<char>(rnd.next() & 0x3F));
+
+	uint16_t crc = Crc16::compute(&packet[1], packet.size() - 1);
+	packet.push_back(static_cast<char>(crc >> 8));
+	packet.push_back(static_cast<char>(crc & 0xFF));
+
+	return Packet(&packet[0], packet.size());
+}
+
+// Compares values bit for bit, as vectors and the status structures have no
+// equality operator.
+template<typename T>
+::testing::AssertionResult isSameBits(const char* expectedText, const char* actualText, const T& expected, const T& actual)
+{
+	if (memcmp(&expected, &actual, sizeof(T)) == 0)
+		return ::testing::AssertionSuccess();
+
+	return ::testing::AssertionFailure() << actualText << " differs from " << expectedText;
+}
+
+TimeUtc extractTimeUtc(Packet& p)
+{
+	TimeUtc t;
+
+	t.year = p.extractInt8();
+	t.month = p.extractUint8();
+	t.day = p.extractUint8();
+	t.hour = p.extractUint8();
+	t.min = p.extractUint8();
+	t.sec = p.extractUint8();
+	t.ms = p.extractUint16();
+
+	return t;
+}
+
+TimeInfo extractTimeInfo(Packet& p)
+{
+	TimeInfo t;
+
+	t.timeStatus = p.extractUint8();
+	t.leapSecs = p.extractInt8();
+
+	return t;
+}
+
+GnssDop extractGnssDop(Packet& p)
+{
+	GnssDop d;
+
+	d.gDop = p.extractFloat();
+	d.pDop = p.extractFloat();
+	d.tDop = p.extractFloat();
+	d.vDop = p.extractFloat();
+	d.hDop = p.extractFloat();
+	d.nDop = p.extractFloat();
+	d.eDop = p.extractFloat();
+
+	return d;
+}
+
+// The checks below walk a packet one group and field at a time, the way
+// CompositeData parsed packets before it kept the fields in a bitmask, and
+// expect the parsed data to hold each value extracted. Fields without a
+// public accessor are only skipped.
+
+void expectCommonGroup(Packet& p, uint16_t gf, CompositeData& cd)
+{
+	if (gf & COMMONGROUP_TIMESTARTUP)
+	{
+		EXPECT_EQ(p.extractUint64(), cd.timeStartup());
+	}
+
+	if (gf & COMMONGROUP_TIMEGPS)
+	{
+		EXPECT_EQ(p.extractUint64(), cd.timeGps());
+	}
+
+	if (gf & COMMONGROUP_TIMESYNCIN)
+	{
+		EXPECT_EQ(p.extractUint64(), cd.timeSyncIn());
+	}
+
+	if (gf & COMMONGROUP_YAWPITCHROLL)
+	{
+		EXPECT_PRED_FORMAT2(isSameBits, p.extractVec3f(), cd.yawPitchRoll());
+	}
+
+	if (gf & COMMONGROUP_QUATERNION)
+	{
+		EXPECT_PRED_FORMAT2(isSameBits, p.extractVec4f(), cd.quaternion());
+	}
+
+	if (gf & COMMONGROUP_ANGULARRATE)
+	{
+		EXPECT_PRED_FORMAT2(isSameBits, p.extractVec3f(), cd.angularRate());
+	}
+
+	if (gf & COMMONGROUP_POSITION)
+	{
+		EXPECT_PRED_FORMAT2(isSameBits, p.extractVec3d(), cd.positionEstimatedLla());
+	}
+
+	if (gf & COMMONGROUP_VELOCITY)
+	{
+		EXPECT_PRED_FORMAT2(isSameBits, p.extractVec3f(), cd.velocityEstimatedNed());
+	}
+
+	if (gf & COMMONGROUP_ACCEL)
+	{
+		EXPECT_PRED_FORMAT2(isSameBits, p.extractVec3f(), cd.acceleration());
+	}
+
+	if (gf & COMMONGROUP_IMU)
+	{
+		EXPECT_PRED_FORMAT2(isSameBits, p.extractVec3f(), cd.accelerationUncompensated());
+		EXPECT_PRED_FORMAT2(isSameBits, p.extractVec3f(), cd.angularRateUncompensated());
+	}
+
+	if (gf & COMMONGROUP_MAGPRES)
+	{
+		EXPECT_PRED_FORMAT2(isSameBits, p.extractVec3f(), cd.magnetic());
+		EXPECT_PRED_FORMAT2(isSameBits, p.extractFloat(), cd.temperature());
+		EXPECT_PRED_FORMAT2(isSameBits, p.extractFloat(), cd.pressure());
+	}
+
+	if (gf & COMMONGROUP_DELTATHETA)
+	{
+		EXPECT_PRED_FORMAT2(isSameBits, p.extractFloat(), cd.deltaTime());
+		EXPECT_PRED_FORMAT2(isSameBits, p.extractVec3f(), cd.deltaTheta());
+		EXPECT_PRED_FORMAT2(isSameBits, p.extractVec3f(), cd.deltaVelocity());
+	}
+
+	if (gf & COMMONGROUP_INSSTATUS)
+	{
+		uint16_t v = p.extractUint16();
+		EXPECT_PRED_FORMAT2(isSameBits, VpeStatus(v), cd.vpeStatus());
+		EXPECT_EQ(InsStatus(v), cd.insStatus());
+	}
+
+	if (gf & COMMONGROUP_SYNCINCNT)
+	{
+		EXPECT_EQ(p.extractUint32(), cd.syncInCnt());
+	}
+
+	if (gf & COMMONGROUP_TIMEGPSPPS)
+	{
+		EXPECT_EQ(p.extractUint64(), cd.timeGpsPps());
+	}
+}
+
+void expectTimeGroup(Packet& p, uint16_t gf, CompositeData& cd)
+{
+	if (gf & TIMEGROUP_TIMESTARTUP)
+	{
+		EXPECT_EQ(p.extractUint64(), cd.timeStartup());
+	}
+
+	if (gf & TIMEGROUP_TIMEGPS)
+	{
+		EXPECT_EQ(p.extractUint64(), cd.timeGps());
+	}
+
+	if (gf & TIMEGROUP_GPSTOW)
+	{
+		EXPECT_PRED_FORMAT2(isSameBits, static_cast<double>(p.extractUint64()) / 1000000000, cd.tow());
+	}
+
+	if (gf & TIMEGROUP_GPSWEEK)
+	{
+		EXPECT_EQ(p.extractUint16(), cd.week());
+	}
+
+	if (gf & TIMEGROUP_TIMESYNCIN)
+	{
+		EXPECT_EQ(p.extractUint64(), cd.timeSyncIn());
+	}
+
+	if (gf & TIMEGROUP_TIMEGPSPPS)
+	{
+		EXPECT_EQ(p.extractUint64(), cd.timeGpsPps());
+	}
+
+	if (gf & TIMEGROUP_TIMEUTC)
+	{
+		EXPECT_PRED_FORMAT2(isSameBits, extractTimeUtc(p), cd.timeUtc());
+	}
+
+	if (gf & TIMEGROUP_SYNCINCNT)
+	{
+		EXPECT_EQ(p.extractUint32(), cd.syncInCnt());
+	}
+
+	if (gf & TIMEGROUP_SYNCOUTCNT)
+	{
+		EXPECT_EQ(p.extractUint32(), cd.syncOutCnt());
+	}
+
+	if (gf & TIMEGROUP_TIMESTATUS)
+	{
+		EXPECT_EQ(p.extractUint8(), cd.timeStatus());
+	}
+}
+
+void expectImuGroup(Packet& p, uint16_t gf, CompositeData& cd)
+{
+	if (gf & IMUGROUP_IMUSTATUS)
+		// This field is currently reserved.
+		p.extractUint16();
+
+	if (gf & IMUGROUP_UNCOMPMAG)
+	{
+		EXPECT_PRED_FORMAT2(isSameBits, p.extractVec3f(), cd.magneticUncompensated());
+	}
+
+	if (gf & IMUGROUP_UNCOMPACCEL)
+	{
+		EXPECT_PRED_FORMAT2(isSameBits, p.extractVec3f(), cd.accelerationUncompensated());
+	}
+
+	if (gf & IMUGROUP_UNCOMPGYRO)
+	{
+		EXPECT_PRED_FORMAT2(isSameBits, p.extractVec3f(), cd.angularRateUncompensated());
+	}
+
+	if (gf & IMUGROUP_TEMP)
+	{
+		EXPECT_PRED_FORMAT2(isSameBits, p.extractFloat(), cd.temperature());
+	}
+
+	if (gf & IMUGROUP_PRES)
+	{
+		EXPECT_PRED_FORMAT2(isSameBits, p.extractFloat(), cd.pressure());
+	}
+
+	if (gf & IMUGROUP_DELTATHETA)
+	{
+		EXPECT_PRED_FORMAT2(isSameBits, p.extractFloat(), cd.deltaTime());
+		EXPECT_PRED_FORMAT2(isSameBits, p.extractVec3f(), cd.deltaTheta());
+	}
+
+	if (gf & IMUGROUP_DELTAVEL)
+	{
+		EXPECT_PRED_FORMAT2(isSameBits, p.extractVec3f(), cd.deltaVelocity());
+	}
+
+	if (gf & IMUGROUP_MAG)
+	{
+		EXPECT_PRED_FORMAT2(isSameBits, p.extractVec3f(), cd.magnetic());
+	}
+
+	if (gf & IMUGROUP_ACCEL)
+	{
+		EXPECT_PRED_FORMAT2(isSameBits, p.extractVec3f(), cd.acceleration());
+	}
+
+	if (gf & IMUGROUP_ANGULARRATE)
+	{
+		EXPECT_PRED_FORMAT2(isSameBits, p.extractVec3f(), cd.angularRate());
+	}
+
+	if (gf & IMUGROUP_SENSSAT)
+	{
+		EXPECT_EQ(SensSat(p.extractUint16()), cd.sensSat());
+	}
+}
+
+void expectGpsGroup(Packet& p, uint16_t gf, CompositeData& cd)
+{
+	if (gf & GPSGROUP_UTC)
+	{
+		EXPECT_PRED_FORMAT2(isSameBits, extractTimeUtc(p), cd.timeUtc());
+	}
+
+	if (gf & GPSGROUP_TOW)
+	{
+		EXPECT_EQ(p.extractUint64(), cd.gpsTow());
+	}
+
+	if (gf & GPSGROUP_WEEK)
+		p.extractUint16();
+
+	if (gf & GPSGROUP_NUMSATS)
+	{
+		EXPECT_EQ(p.extractUint8(), cd.numSats());
+	}
+
+	if (gf & GPSGROUP_FIX)
+	{
+		EXPECT_EQ(GpsFix(p.extractUint8()), cd.fix());
+	}
+
+	if (gf & GPSGROUP_POSLLA)
+	{
+		EXPECT_PRED_FORMAT2(isSameBits, p.extractVec3d(), cd.positionGpsLla());
+	}
+
+	if (gf & GPSGROUP_POSECEF)
+	{
+		EXPECT_PRED_FORMAT2(isSameBits, p.extractVec3d(), cd.positionGpsEcef());
+	}
+
+	if (gf & GPSGROUP_VELNED)
+	{
+		EXPECT_PRED_FORMAT2(isSameBits, p.extractVec3f(), cd.velocityGpsNed());
+	}
+
+	if (gf & GPSGROUP_VELECEF)
+	{
+		EXPECT_PRED_FORMAT2(isSameBits, p.extractVec3f(), cd.velocityGpsEcef());
+	}
+
+	if (gf & GPSGROUP_POSU)
+	{
+		EXPECT_PRED_FORMAT2(isSameBits, p.extractVec3f(), cd.positionUncertaintyGpsNed());
+	}
+
+	if (gf & GPSGROUP_VELU)
+	{
+		EXPECT_PRED_FORMAT2(isSameBits, p.extractFloat(), cd.velocityUncertaintyGps());
+	}
+
+	if (gf & GPSGROUP_TIMEU)
+	{
+		EXPECT_EQ(p.extractUint32(), cd.timeUncertainty());
+	}
+
+	if (gf & GPSGROUP_TIMEINFO)
+	{
+		EXPECT_PRED_FORMAT2(isSameBits, extractTimeInfo(p), cd.timeInfo());
+	}
+
+	if (gf & GPSGROUP_DOP)
+	{
+		EXPECT_PRED_FORMAT2(isSameBits, extractGnssDop(p), cd.dop());
+	}
+}
+
+void expectAttitudeGroup(Packet& p, uint16_t gf, CompositeData& cd)
+{
+	if (gf & ATTITUDEGROUP_VPESTATUS)
+	{
+		EXPECT_PRED_FORMAT2(isSameBits, VpeStatus(p.extractUint16()), cd.vpeStatus());
+	}
+
+	if (gf & ATTITUDEGROUP_YAWPITCHROLL)
+	{
+		EXPECT_PRED_FORMAT2(isSameBits, p.extractVec3f(), cd.yawPitchRoll());
+	}
+
+	if (gf & ATTITUDEGROUP_QUATERNION)
+	{
+		EXPECT_PRED_FORMAT2(isSameBits, p.extractVec4f(), cd.quaternion());
+	}
+
+	if (gf & ATTITUDEGROUP_DCM)
+	{
+		EXPECT_PRED_FORMAT2(isSameBits, p.extractMat3f(), cd.directionCosineMatrix());
+	}
+
+	if (gf & ATTITUDEGROUP_MAGNED)
+	{
+		EXPECT_PRED_FORMAT2(isSameBits, p.extractVec3f(), cd.magneticNed());
+	}
+
+	if (gf & ATTITUDEGROUP_ACCELNED)
+	{
+		EXPECT_PRED_FORMAT2(isSameBits, p.extractVec3f(), cd.accelerationNed());
+	}
+
+	if (gf & ATTITUDEGROUP_LINEARACCELBODY)
+	{
+		EXPECT_PRED_FORMAT2(isSameBits, p.extractVec3f(), cd.accelerationLinearBody());
+	}
+
+	if (gf & ATTITUDEGROUP_LINEARACCELNED)
+	{
+		EXPECT_PRED_FORMAT2(isSameBits, p.extractVec3f(), cd.accelerationLinearNed());
+	}
+
+	if (gf & ATTITUDEGROUP_YPRU)
+	{
+		EXPECT_PRED_FORMAT2(isSameBits, p.extractVec3f(), cd.attitudeUncertainty());
+	}
+}
+
+void expectInsGroup(Packet& p, uint16_t gf, CompositeData& cd)
+{
+	if (gf & INSGROUP_INSSTATUS)
+	{
+		EXPECT_EQ(InsStatus(p.extractUint16()), cd.insStatus());
+	}
+
+	if (gf & INSGROUP_POSLLA)
+	{
+		EXPECT_PRED_FORMAT2(isSameBits, p.extractVec3d(), cd.positionEstimatedLla());
+	}
+
+	if (gf & INSGROUP_POSECEF)
+	{
+		EXPECT_PRED_FORMAT2(isSameBits, p.extractVec3d(), cd.positionEstimatedEcef());
+	}
+
+	if (gf & INSGROUP_VELBODY)
+	{
+		EXPECT_PRED_FORMAT2(isSameBits, p.extractVec3f(), cd.velocityEstimatedBody());
+	}
+
+	if (gf & INSGROUP_VELNED)
+	{
+		EXPECT_PRED_FORMAT2(isSameBits, p.extractVec3f(), cd.velocityEstimatedNed());
+	}
+
+	if (gf & INSGROUP_VELECEF)
+	{
+		EXPECT_PRED_FORMAT2(isSameBits, p.extractVec3f(), cd.velocityEstimatedEcef());
+	}
+
+	if (gf & INSGROUP_MAGECEF)
+	{
+		EXPECT_PRED_FORMAT2(isSameBits, p.extractVec3f(), cd.magneticEcef());
+	}
+
+	if (gf & INSGROUP_ACCELECEF)
+	{
+		EXPECT_PRED_FORMAT2(isSameBits, p.extractVec3f(), cd.accelerationEcef());
+	}
+
+	if (gf & INSGROUP_LINEARACCELECEF)
+	{
+		EXPECT_PRED_FORMAT2(isSameBits, p.extractVec3f(), cd.accelerationLinearEcef());
+	}
+
+	if (gf & INSGROUP_POSU)
+	{
+		EXPECT_PRED_FORMAT2(isSameBits, p.extractFloat(), cd.positionUncertaintyEstimated());
+	}
+
+	if (gf & INSGROUP_VELU)
+	{
+		EXPECT_PRED_FORMAT2(isSameBits, p.extractFloat(), cd.velocityUncertaintyEstimated());
+	}
+}
+
+void expectGps2Group(Packet& p, uint16_t gf, CompositeData& cd)
+{
+	if (gf & GPSGROUP_UTC)
+		extractTimeUtc(p);
+
+	if (gf & GPSGROUP_TOW)
+	{
+		EXPECT_EQ(p.extractUint64(), cd.gps2Tow());
+	}
+
+	if (gf & GPSGROUP_WEEK)
+		p.extractUint16();
+
+	if (gf & GPSGROUP_NUMSATS)
+		p.extractUint8();
+
+	if (gf & GPSGROUP_FIX)
+	{
+		EXPECT_EQ(GpsFix(p.extractUint8()), cd.fix2());
+	}
+
+	if (gf & GPSGROUP_POSLLA)
+	{
+		EXPECT_PRED_FORMAT2(isSameBits, p.extractVec3d(), cd.positionGps2Lla());
+	}
+
+	if (gf & GPSGROUP_POSECEF)
+	{
+		EXPECT_PRED_FORMAT2(isSameBits, p.extractVec3d(), cd.positionGps2Ecef());
+	}
+
+	if (gf & GPSGROUP_VELNED)
+	{
+		EXPECT_PRED_FORMAT2(isSameBits, p.extractVec3f(), cd.velocityGps2Ned());
+	}
+
+	if (gf & GPSGROUP_VELECEF)
+	{
+		EXPECT_PRED_FORMAT2(isSameBits, p.extractVec3f(), cd.velocityGps2Ecef());
+	}
+
+	if (gf & GPSGROUP_POSU)
+	{
+		EXPECT_PRED_FORMAT2(isSameBits, p.extractVec3f(), cd.positionUncertaintyGps2Ned());
+	}
+
+	if (gf & GPSGROUP_VELU)
+	{
+		EXPECT_PRED_FORMAT2(isSameBits, p.extractFloat(), cd.velocityUncertaintyGps2());
+	}
+
+	if (gf & GPSGROUP_TIMEU)
+		p.extractUint32();
+
+	if (gf & GPSGROUP_TIMEINFO)
+	{
+		EXPECT_PRED_FORMAT2(isSameBits, extractTimeInfo(p), cd.timeInfo2());
+	}
+
+	if (gf & GPSGROUP_DOP)
+		extractGnssDop(p);
+}
+
+typedef void (*GroupExpectation)(Packet& p, uint16_t gf, CompositeData& cd);
+
+const GroupExpectation GroupExpectations[7] =
+{
+	expectCommonGroup, expectTimeGroup, expectImuGroup, expectGpsGroup,
+	expectAttitudeGroup, expectInsGroup, expectGps2Group
+};
+
+// Every field defined for each group.
+const uint16_t AllFields[7] = { 0x7FFF, 0x03FF, 0x0FFF, 0x3FFF, 0x01FF, 0x07FF, 0x3FFF };
+
+void expectSameAsGroupByGroupParse(Packet& p, const uint16_t fields[7])
+{
+	CompositeData cd = CompositeData::parse(p);
+
+	for (size_t i = 0; i < 7; i++)
+	{
+		if (fields[i] != 0)
+			GroupExpectations[i](p, fields[i], cd);
+	}
+
+	// Every byte of the payload was accounted for.
+	uint8_t extra;
+	EXPECT_FALSE(p.tryExtractUint8(extra));
+}
+
+}
+
+TEST(CompositeDataTest, TryGetReportsAbsentFieldWithoutThrowing)
+{
+	Packet p = makeYawPitchRollPacket(10, 20, 30);
+	CompositeData cd = CompositeData::parse(p);
+
+	vec3f angularRate;
+	float temperature;
+	uint64_t timeStartup;
+
+	EXPECT_FALSE(cd.tryGetAngularRate(angularRate));
+	EXPECT_FALSE(cd.tryGetTemperature(temperature));
+	EXPECT_FALSE(cd.tryGetTimeStartup(timeStartup));
+
+	EXPECT_THROW(cd.angularRate(), vn::invalid_operation);
+}
+
+TEST(CompositeDataTest, TryGetReturnsPresentField)
+{
+	Packet p = makeYawPitchRollPacket(10, 20, 30);
+	CompositeData cd = CompositeData::parse(p);
+
+	vec3f ypr;
+	ASSERT_TRUE(cd.tryGetYawPitchRoll(ypr));
+	EXPECT_EQ(10, ypr.x);
+	EXPECT_EQ(20, ypr.y);
+	EXPECT_EQ(30, ypr.z);
+
+	EXPECT_EQ(ypr.x, cd.yawPitchRoll().x);
+}
+
+TEST(CompositeDataTest, ParsingTruncatedPacketThrowsRatherThanOverrunning)
+{
+	Packet full = makeYawPitchRollPacket(10, 20, 30);
+
+	// Drop the roll, keeping the header's claim that all three are present.
+	string truncated = full.datastr().substr(0, 12);
+	truncated += full.datastr().substr(16);
+	Packet p(truncated);
+
+	EXPECT_THROW(CompositeData::parse(p), std::exception);
+}
+
+TEST(CompositeDataTest, EachGroupParsesTheSameAsGroupByGroup)
+{
+	PayloadRandom rnd;
+
+	for (size_t group = 0; group < 7; group++)
+	{
+		uint16_t fields[7] = { 0 };
+		fields[group] = AllFields[group];
+
+		Packet p = makeGroupsPacket(fields, rnd);
+
+		SCOPED_TRACE(group);
+		expectSameAsGroupByGroupParse(p, fields);
+	}
+}
+
+TEST(CompositeDataTest, RandomFieldsParseTheSameAsGroupByGroup)
+{
+	PayloadRandom rnd;
+
+	for (size_t i = 0; i < 2000; i++)
+	{
+		// The common and GPS groups hold fields also found in other groups,
+		// where the last group parsed wins, so each packet holds at most one
+		// of them alongside groups that do not overlap with it.
+		uint16_t fields[7] = { 0 };
+		size_t shared = rnd.next() % 3;
+
+		if (shared == 0)
+			fields[0] = static_cast<uint16_t>(rnd.next() & AllFields[0]);
+		else if (shared == 1)
+			fields[3] = static_cast<uint16_t>(rnd.next() & AllFields[3] & ~GPSGROUP_UTC);
+
+		fields[6] = static_cast<uint16_t>(rnd.next() & AllFields[6]);
+
+		if (shared != 0)
+		{
+			fields[1] = static_cast<uint16_t>(rnd.next() & AllFields[1]);
+			fields[2] = static_cast<uint16_t>(rnd.next() & AllFields[2]);
+			fields[4] = static_cast<uint16_t>(rnd.next() & AllFields[4]);
+			fields[5] = static_cast<uint16_t>(rnd.next() & AllFields[5]);
+		}
+
+		if (fields[0] == 0 && fields[1] == 0 && fields[2] == 0 && fields[3] == 0 && fields[4] == 0 && fields[5] == 0 && fields[6] == 0)
+			continue;
+
+		Packet p = makeGroupsPacket(fields, rnd);
+
+		SCOPED_TRACE(i);
+		expectSameAsGroupByGroupParse(p, fields);
+	}
+}
+
+TEST(CompositeDataTest, LaterGroupWinsForFieldsInMoreThanOneGroup)
+{
+	PayloadRandom rnd;
+
+	uint16_t fields[7] = { COMMONGROUP_YAWPITCHROLL | COMMONGROUP_POSITION, 0, 0, 0, ATTITUDEGROUP_YAWPITCHROLL, INSGROUP_POSLLA, 0 };
+	Packet p = makeGroupsPacket(fields, rnd);
+
+	CompositeData cd = CompositeData::parse(p);
+
+	p.extractVec3f();
+	p.extractVec3d();
+
+	EXPECT_PRED_FORMAT2(isSameBits, p.extractVec3f(), cd.yawPitchRoll());
+	EXPECT_PRED_FORMAT2(isSameBits, p.extractVec3d(), cd.positionEstimatedLla());
+}
@@ -0,0 +1,333 @@
+#include "vn/configurationplan.h"
+#include "vn/sensors.h"
+#include "vn/compiler.h"
+
+#include <cstdio>
+#include <vector>
+
+using namespace std;
+using namespace vn::math;
+using namespace vn::protocol::uart;
+
+namespace vn {
+namespace sensors {
+
+namespace {
+
+// Large enough for any of the write commands the plan generates.
+const size_t CommandBufferSize = 256;
+
+// Produces the write command which would give a register the values reported
+// in the response to reading it.
+typedef size_t (*ResponseToWrite)(Packet& response, char* buffer, size_t size);
+
+// Returns a generated command without its checksum and line ending so the
+// sensor's error detection mode can be applied when it is sent.
+string commandBody(const char* command, size_t length)
+{
+	string body(command, length);
+
+	return body.substr(0, body.find('*'));
+}
+
+size_t asyncDataOutputTypeWrite(Packet& response, char* buffer, size_t size)
+{
+	uint32_t ador;
+	response.parseAsyncDataOutputType(&ador);
+
+	return Packet::genWriteAsyncDataOutputType(ERRORDETECTIONMODE_NONE, buffer, size, ador);
+}
+
+size_t asyncDataOutputFrequencyWrite(Packet& response, char* buffer, size_t size)
+{
+	uint32_t adof;
+	response.parseAsyncDataOutputFrequency(&adof);
+
+	return Packet::genWriteAsyncDataOutputFrequency(ERRORDETECTIONMODE_NONE, buffer, size, adof);
+}
+
+size_t imuRateConfigurationWrite(Packet& response, char* buffer, size_t size)
+{
+	uint16_t imuRate, navDivisor;
+	float filterTargetRate, filterMinRate;
+	response.parseImuRateConfiguration(&imuRate, &navDivisor, &filterTargetRate, &filterMinRate);
+
+	return Packet::genWriteImuRateConfiguration(ERRORDETECTIONMODE_NONE, buffer, size, imuRate, navDivisor, filterTargetRate, filterMinRate);
+}
+
+size_t vpeBasicControlWrite(Packet& response, char* buffer, size_t size)
+{
+	uint8_t enable, headingMode, filteringMode, tuningMode;
+	response.parseVpeBasicControl(&enable, &headingMode, &filteringMode, &tuningMode);
+
+	return Packet::genWriteVpeBasicControl(ERRORDETECTIONMODE_NONE, buffer, size, enable, headingMode, filteringMode, tuningMode);
+}
+
+size_t insBasicConfigurationVn300Write(Packet& response, char* buffer, size_t size)
+{
+	uint8_t scenario, ahrsAiding, estBaseline;
+	response.parseInsBasicConfiguration(&scenario, &ahrsAiding, &estBaseline);
+
+	return Packet::genWriteInsBasicConfiguration(ERRORDETECTIONMODE_NONE, buffer, size, scenario, ahrsAiding, estBaseline);
+}
+
+size_t magnetometerCalibrationControlWrite(Packet& response, char* buffer, size_t size)
+{
+	uint8_t hsiMode, hsiOutput, convergeRate;
+	response.parseMagnetometerCalibrationControl(&hsiMode, &hsiOutput, &convergeRate);
+
+	return Packet::genWriteMagnetometerCalibrationControl(ERRORDETECTIONMODE_NONE, buffer, size, hsiMode, hsiOutput, convergeRate);
+}
+
+size_t gpsAntennaOffsetWrite(Packet& response, char* buffer, size_t size)
+{
+	vec3f position;
+	response.parseGpsAntennaOffset(&position);
+
+	return Packet::genWriteGpsAntennaOffset(ERRORDETECTIONMODE_NONE, buffer, size, position);
+}
+
+size_t gpsCompassBaselineWrite(Packet& response, char* buffer, size_t size)
+{
+	vec3f position, uncertainty;
+	response.parseGpsCompassBaseline(&position, &uncertainty);
+
+	return Packet::genWriteGpsCompassBaseline(ERRORDETECTIONMODE_NONE, buffer, size, position, uncertainty);
+}
+
+typedef size_t (*BinaryOutputGenerator)(ErrorDetectionMode errorDetectionMode, char* buffer, size_t size, uint16_t asyncMode, uint16_t rateDivisor, uint16_t commonField, uint16_t timeField, uint16_t imuField, uint16_t gpsField, uint16_t attitudeField, uint16_t insField, uint16_t gps2Field);
+
+template<BinaryOutputGenerator generate>
+size_t binaryOutputWrite(Packet& response, char* buffer, size_t size)
+{
+	uint16_t asyncMode, rateDivisor, outputGroup, commonField, timeField, imuField, gpsField, attitudeField, insField, gps2Field;
+	response.parseBinaryOutput(&asyncMode, &rateDivisor, &outputGroup, &commonField, &timeField, &imuField, &gpsField, &attitudeField, &insField, &gps2Field);
+
+	return generate(ERRORDETECTIONMODE_NONE, buffer, size, asyncMode, rateDivisor, commonField, timeField, imuField, gpsField, attitudeField, insField, gps2Field);
+}
+
+template<BinaryOutputGenerator generate>
+size_t binaryOutputWrite(BinaryOutputRegister& fields, char* buffer, size_t size)
+{
+	return generate(ERRORDETECTIONMODE_NONE, buffer, size, fields.asyncMode, fields.rateDivisor, fields.commonField, fields.timeField, fields.imuField, fields.gpsField, fields.attitudeField, fields.insField, fields.gps2Field);
+}
+
+}
+
+struct ConfigurationPlan::Impl
+{
+	// A register in the plan along with the command which writes its value.
+	struct Entry
+	{
+		uint8_t registerId;
+		string write;
+		ResponseToWrite responseToWrite;
+	};
+
+	// Kept sorted by register ID so the fingerprint does not depend on the
+	// order the values were set in.
+	vector<Entry> entries;
+
+	void set(uint8_t registerId, const char* command, size_t length, ResponseToWrite responseToWrite)
+	{
+		Entry e;
+		e.registerId = registerId;
+		e.write = commandBody(command, length);
+		e.responseToWrite = responseToWrite;
+
+		vector<Entry>::iterator it = entries.begin();
+
+		while (it != entries.end() && it->registerId < registerId)
+			++it;
+
+		if (it != entries.end() && it->registerId == registerId)
+			*it = e;
+		else
+			entries.insert(it, e);
+	}
+};
+
+ConfigurationPlan::ConfigurationPlan() :
+	_pi(new Impl())
+{
+}
+
+ConfigurationPlan::~ConfigurationPlan()
+{
+	delete _pi;
+}
+
+void ConfigurationPlan::setAsyncDataOutputType(AsciiAsync ador)
+{
+	char command[CommandBufferSize];
+
+	size_t length = Packet::genWriteAsyncDataOutputType(ERRORDETECTIONMODE_NONE, command, sizeof(command), ador);
+
+	_pi->set(6, command, length, asyncDataOutputTypeWrite);
+}
+
+void ConfigurationPlan::setAsyncDataOutputFrequency(uint32_t adof)
+{
+	char command[CommandBufferSize];
+
+	size_t length = Packet::genWriteAsyncDataOutputFrequency(ERRORDETECTIONMODE_NONE, command, sizeof(command), adof);
+
+	_pi->set(7, command, length, asyncDataOutputFrequencyWrite);
+}
+
+void ConfigurationPlan::setImuRateConfiguration(ImuRateConfigurationRegister &fields)
+{
+	char command[CommandBufferSize];
+
+	size_t length = Packet::genWriteImuRateConfiguration(ERRORDETECTIONMODE_NONE, command, sizeof(command), fields.imuRate, fields.navDivisor, fields.filterTargetRate, fields.filterMinRate);
+
+	_pi->set(227, command, length, imuRateConfigurationWrite);
+}
+
+void ConfigurationPlan::setVpeBasicControl(VpeBasicControlRegister &fields)
+{
+	char command[CommandBufferSize];
+
+	size_t length = Packet::genWriteVpeBasicControl(ERRORDETECTIONMODE_NONE, command, sizeof(command), fields.enable, fields.headingMode, fields.filteringMode, fields.tuningMode);
+
+	_pi->set(35, command, length, vpeBasicControlWrite);
+}
+
+void ConfigurationPlan::setInsBasicConfigurationVn300(InsBasicConfigurationRegisterVn300 &fields)
+{
+	char command[CommandBufferSize];
+
+	size_t length = Packet::genWriteInsBasicConfiguration(ERRORDETECTIONMODE_NONE, command, sizeof(command), fields.scenario, fields.ahrsAiding, fields.estBaseline);
+
+	_pi->set(67, command, length, insBasicConfigurationVn300Write);
+}
+
+void ConfigurationPlan::setMagnetometerCalibrationControl(MagnetometerCalibrationControlRegister &fields)
+{
+	char command[CommandBufferSize];
+
+	size_t length = Packet::genWriteMagnetometerCalibrationControl(ERRORDETECTIONMODE_NONE, command, sizeof(command), fields.hsiMode, fields.hsiOutput, fields.convergeRate);
+
+	_pi->set(44, command, length, magnetometerCalibrationControlWrite);
+}
+
+void ConfigurationPlan::setGpsAntennaOffset(vec3f position)
+{
+	char command[CommandBufferSize];
+
+	size_t length = Packet::genWriteGpsAntennaOffset(ERRORDETECTIONMODE_NONE, command, sizeof(command), position);
+
+	_pi->set(57, command, length, gpsAntennaOffsetWrite);
+}
+
+void ConfigurationPlan::setGpsCompassBaseline(GpsCompassBaselineRegister &fields)
+{
+	char command[CommandBufferSize];
+
+	size_t length = Packet::genWriteGpsCompassBaseline(ERRORDETECTIONMODE_NONE, command, sizeof(command), fields.position, fields.uncertainty);
+
+	_pi->set(93, command, length, gpsCompassBaselineWrite);
+}
+
+void ConfigurationPlan::setBinaryOutput1(BinaryOutputRegister &fields)
+{
+	char command[CommandBufferSize];
+
+	size_t length = binaryOutputWrite<Packet::genWriteBinaryOutput1>(fields, command, sizeof(command));
+
+	_pi->set(75, command, length, binaryOutputWrite<Packet::genWriteBinaryOutput1>);
+}
+
+void ConfigurationPlan::setBinaryOutput2(BinaryOutputRegister &fields)
+{
+	char command[CommandBufferSize];
+
+	size_t length = binaryOutputWrite<Packet::genWriteBinaryOutput2>(fields, command, sizeof(command));
+
+	_pi->set(76, command, length, binaryOutputWrite<Packet::genWriteBinaryOutput2>);
+}
+
+void ConfigurationPlan::setBinaryOutput3(BinaryOutputRegister &fields)
+{
+	char command[CommandBufferSize];
+
+	size_t length = binaryOutputWrite<Packet::genWriteBinaryOutput3>(fields, command, sizeof(command));
+
+	_pi->set(77, command, length, binaryOutputWrite<Packet::genWriteBinaryOutput3>);
+}
+
+string ConfigurationPlan::fingerprint() const
+{
+	// 32-bit FNV-1a over the write commands, which hold every value in the
+	// plan in a canonical form.
+	uint32_t hash = 2166136261u;
+
+	for (size_t i = 0; i < _pi->entries.size(); i++)
+	{
+		const string& write = _pi->entries[i].write;
+
+		for (size_t j = 0; j < write.size(); j++)
+		{
+			hash ^= static_cast<uint8_t>(write[j]);
+			hash *= 16777619u;
+		}
+
+		hash ^= '\n';
+		hash *= 16777619u;
+	}
+
+	char tag[16];
+
+	#if VN_HAVE_SECURE_CRT
+	sprintf_s(tag, sizeof(tag), "vncfg-%08X", hash);
+	#else
+	sprintf(tag, "vncfg-%08X", hash);
+	#endif
+
+	return tag;
+}
+
+PlanOutcome ConfigurationPlan::apply(VnSensor& sensor, size_t* numOfRegistersWritten)
+{
+	string tag = fingerprint();
+
+	if (numOfRegistersWritten != NULL)
+		*numOfRegistersWritten = 0;
+
+	if (sensor.readUserTag() == tag)
+		return PLANOUTCOME_UNCHANGED;
+
+	vector<uint8_t> registerIds;
+
+	for (size_t i = 0; i < _pi->entries.size(); i++)
+		registerIds.push_back(_pi->entries[i].registerId);
+
+	vector<Packet> current = sensor.readRegisters(registerIds);
+
+	// Compare the commands rather than the values so both sides are
+	// formatted alike.
+	vector<string> writes;
+	char command[CommandBufferSize];
+
+	for (size_t i = 0; i < _pi->entries.size(); i++)
+	{
+		size_t length = _pi->entries[i].responseToWrite(current[i], command, sizeof(command));
+
+		if (commandBody(command, length) != _pi->entries[i].write)
+			writes.push_back(_pi->entries[i].write);
+	}
+
+	if (!writes.empty())
+		sensor.transactions(writes);
+
+	sensor.writeUserTag(tag);
+	sensor.writeSettings();
+
+	if (numOfRegistersWritten != NULL)
+		*numOfRegistersWritten = writes.size();
+
+	return writes.empty() ? PLANOUTCOME_TAGREFRESHED : PLANOUTCOME_APPLIED;
+}
+
+}
+}
@@ -0,0 +1,138 @@
+#include "gtest/gtest.h"
+
+#include "vn/configurationplan.h"
+#include "vn/sensors.h"
+#include "fakesensorport.h"
+
+#include <string>
+
+using namespace std;
+using namespace vn::sensors;
+using namespace vn::xplat;
+using namespace vn::protocol::uart;
+
+namespace {
+
+class ConfigurationPlanTest : public ::testing::Test
+{
+protected:
+
+	virtual void SetUp()
+	{
+		_port.setRegister(0, "");
+		_port.setRegister(7, "40");
+		_port.setRegister(35, "1,0,1,1");
+		_port.setRegister(227, "800,4,+200.000,+40.000");
+
+		_sensor.connect(&_port);
+	}
+
+	virtual void TearDown()
+	{
+		_sensor.disconnect();
+	}
+
+	// Sets the plan to the values the sensor starts with.
+	static void planCurrentValues(ConfigurationPlan& plan)
+	{
+		plan.setAsyncDataOutputFrequency(40);
+
+		ImuRateConfigurationRegister imuRate(800, 4, 200, 40);
+		plan.setImuRateConfiguration(imuRate);
+
+		VpeBasicControlRegister vpe(VPEENABLE_ENABLE, HEADINGMODE_ABSOLUTE, VPEMODE_MODE1, VPEMODE_MODE1);
+		plan.setVpeBasicControl(vpe);
+	}
+
+	FakeSensorPort _port;
+	VnSensor _sensor;
+};
+
+}
+
+TEST(ConfigurationPlanFingerprintTest, DoesNotDependOnTheOrderValuesAreSetIn)
+{
+	ImuRateConfigurationRegister imuRate(800, 4, 200, 40);
+	VpeBasicControlRegister vpe(VPEENABLE_ENABLE, HEADINGMODE_ABSOLUTE, VPEMODE_MODE1, VPEMODE_MODE1);
+
+	ConfigurationPlan a;
+	a.setAsyncDataOutputFrequency(40);
+	a.setImuRateConfiguration(imuRate);
+	a.setVpeBasicControl(vpe);
+
+	ConfigurationPlan b;
+	b.setVpeBasicControl(vpe);
+	b.setImuRateConfiguration(imuRate);
+	b.setAsyncDataOutputFrequency(40);
+
+	EXPECT_EQ(a.fingerprint(), b.fingerprint());
+	EXPECT_EQ(14u, a.fingerprint().length());
+	EXPECT_EQ(0u, a.fingerprint().find("vncfg-"));
+}
+
+TEST(ConfigurationPlanFingerprintTest, ChangesWithAnyValue)
+{
+	ConfigurationPlan a;
+	a.setAsyncDataOutputFrequency(40);
+
+	string before = a.fingerprint();
+
+	// Setting a register again replaces its value rather than adding to it.
+	a.setAsyncDataOutputFrequency(20);
+	EXPECT_NE(before, a.fingerprint());
+
+	a.setAsyncDataOutputFrequency(40);
+	EXPECT_EQ(before, a.fingerprint());
+
+	ConfigurationPlan b;
+	b.setAsyncDataOutputFrequency(40);
+	b.setAsyncDataOutputType(VNOFF);
+	EXPECT_NE(before, b.fingerprint());
+}
+
+TEST_F(ConfigurationPlanTest, WritesOnlyRegistersHoldingOtherValues)
+{
+	ConfigurationPlan plan;
+	planCurrentValues(plan);
+	plan.setAsyncDataOutputFrequency(20);
+
+	size_t numOfRegistersWritten = 0;
+
+	EXPECT_EQ(PLANOUTCOME_APPLIED, plan.apply(_sensor, &numOfRegistersWritten));
+	EXPECT_EQ(1u, numOfRegistersWritten);
+	EXPECT_EQ(20u, _sensor.readAsyncDataOutputFrequency());
+	EXPECT_EQ(plan.fingerprint(), _sensor.readUserTag());
+}
+
+TEST_F(ConfigurationPlanTest, StoresTheTagWhenRegistersAlreadyHoldThePlan)
+{
+	ConfigurationPlan plan;
+	planCurrentValues(plan);
+
+	size_t numOfRegistersWritten = 1;
+	int numOfCommands = _port.numOfCommands();
+
+	EXPECT_EQ(PLANOUTCOME_TAGREFRESHED, plan.apply(_sensor, &numOfRegistersWritten));
+	EXPECT_EQ(0u, numOfRegistersWritten);
+	EXPECT_EQ(plan.fingerprint(), _sensor.readUserTag());
+
+	// The tag read, three register reads, the tag write, saving the settings
+	// and the tag read above.
+	EXPECT_EQ(numOfCommands + 7, _port.numOfCommands());
+}
+
+TEST_F(ConfigurationPlanTest, SkipsSensorWhoseTagMatches)
+{
+	ConfigurationPlan plan;
+	planCurrentValues(plan);
+	plan.setAsyncDataOutputFrequency(20);
+
+	EXPECT_EQ(PLANOUTCOME_APPLIED, plan.apply(_sensor));
+
+	int numOfCommands = _port.numOfCommands();
+	size_t numOfRegistersWritten = 1;
+
+	EXPECT_EQ(PLANOUTCOME_UNCHANGED, plan.apply(_sensor, &numOfRegistersWritten));
+	EXPECT_EQ(0u, numOfRegistersWritten);
+	EXPECT_EQ(numOfCommands + 1, _port.numOfCommands());
+}
@@ -0,0 +1,125 @@
+#include "vn/cpu.h"
+#include "vn/compiler.h"
+#include "vn/int.h"
+
+#include <cstddef>
+
+#if VN_HAVE_X86_DISPATCH
+	#if defined(_MSC_VER)
+		#include <intrin.h>
+	#else
+		#include <cpuid.h>
+	#endif
+#endif
+
+namespace vn {
+namespace xplat {
+
+namespace {
+
+struct CpuFeatures
+{
+	bool sse2;
+	bool avx2;
+	bool ssse3;
+	bool pclmul;
+
+	CpuFeatures() :
+		sse2(false),
+		avx2(false),
+		ssse3(false),
+		pclmul(false)
+	{
+		#if VN_HAVE_X86_DISPATCH
+
+		uint32_t regs[4];
+
+		query(0, regs);
+		uint32_t maxLeaf = regs[0];
+
+		if (maxLeaf < 1)
+			return;
+
+		query(1, regs);
+
+		sse2 = (regs[3] & (1u << 26)) != 0;
+		ssse3 = (regs[2] & (1u << 9)) != 0;
+		pclmul = (regs[2] & (1u << 1)) != 0;
+
+		// AVX registers must be enabled by the operating system (OSXSAVE and
+		// XCR0 bits 1 and 2) before any AVX instructions may be used.
+		bool osSavesAvxState =
+			(regs[2] & (1u << 27)) != 0 &&
+			(regs[2] & (1u << 28)) != 0 &&
+			(readXcr0() & 0x6) == 0x6;
+
+		if (osSavesAvxState && maxLeaf >= 7)
+		{
+			query(7, regs);
+
+			avx2 = (regs[1] & (1u << 5)) != 0;
+		}
+
+		#endif
+	}
+
+	#if VN_HAVE_X86_DISPATCH
+
+	static void query(uint32_t leaf, uint32_t regs[4])
+	{
+		#if defined(_MSC_VER)
+		int r[4];
+		__cpuidex(r, static_cast<int>(leaf), 0);
+		for (size_t i = 0; i < 4; i++)
+			regs[i] = static_cast<uint32_t>(r[i]);
+		#else
+		__cpuid_count(leaf, 0, regs[0], regs[1], regs[2], regs[3]);
+		#endif
+	}
+
+	static uint64_t readXcr0()
+	{
+		#if defined(_MSC_VER)
+		return _xgetbv(0);
+		#else
+		uint32_t eax, edx;
+		// Encoded xgetbv so older assemblers are not required to know it.
+		__asm__ __volatile__(".byte 0x0f, 0x01, 0xd0" : "=a"(eax), "=d"(edx) : "c"(0));
+		return (static_cast<uint64_t>(edx) << 32) | eax;
+		#endif
+	}
+
+	#endif
+};
+
+const CpuFeatures& features()
+{
+	static const CpuFeatures f;
+
+	return f;
+}
+
+}
+
+bool Cpu::hasSse2()
+{
+	return features().sse2;
+}
+
+bool Cpu::hasAvx2()
+{
+	return features().avx2;
+}
+
+bool Cpu::hasSsse3()
+{
+	return features().ssse3;
+}
+
+bool Cpu::hasPclmul()
+{
+	return features().pclmul;
+}
+
+}
+}
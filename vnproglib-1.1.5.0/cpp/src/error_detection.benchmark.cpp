@@ -0,0 +1,75 @@
+#include "benchmark/benchmark.h"
+
+#include "vn/error_detection.h"
+
+#include <vector>
+
+using namespace std;
+using namespace vn::data::integrity;
+
+namespace {
+
+// The byte at a time CRC the library used before the table and folding
+// routines, kept as the baseline the others are measured against.
+uint16_t computeCrc16ByteAtATime(const char data[], size_t length)
+{
+	uint16_t crc = 0;
+
+	for (size_t i = 0; i < length; i++)
+	{
+		crc = static_cast<uint16_t>((crc >> 8) | (crc << 8));
+
+		crc ^= static_cast<uint8_t>(data[i]);
+		crc ^= static_cast<uint16_t>(static_cast<uint8_t>(crc & 0xFF) >> 4);
+		crc ^= static_cast<uint16_t>((crc << 8) << 4);
+		crc ^= static_cast<uint16_t>(((crc & 0xFF) << 4) << 1);
+	}
+
+	return crc;
+}
+
+vector<char> makeData(size_t length)
+{
+	vector<char> data(length);
+
+	for (size_t i = 0; i < length; i++)
+		data[i] = static_cast<char>(i * 37 + 11);
+
+	return data;
+}
+
+void Crc16_Compute(benchmark::State& state)
+{
+	vector<char> data = makeData(static_cast<size_t>(state.range(0)));
+
+	while (state.KeepRunning())
+		benchmark::DoNotOptimize(Crc16::compute(&data[0], data.size()));
+
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * data.size()));
+}
+
+void Crc16_ComputeByteAtATime(benchmark::State& state)
+{
+	vector<char> data = makeData(static_cast<size_t>(state.range(0)));
+
+	while (state.KeepRunning())
+		benchmark::DoNotOptimize(computeCrc16ByteAtATime(&data[0], data.size()));
+
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * data.size()));
+}
+
+void Checksum8_Compute(benchmark::State& state)
+{
+	vector<char> data = makeData(static_cast<size_t>(state.range(0)));
+
+	while (state.KeepRunning())
+		benchmark::DoNotOptimize(Checksum8::compute(&data[0], data.size()));
+
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * data.size()));
+}
+
+}
+
+BENCHMARK(Crc16_Compute)->RangeMultiplier(4)->Range(64, 4096);
+BENCHMARK(Crc16_ComputeByteAtATime)->RangeMultiplier(4)->Range(64, 4096);
+BENCHMARK(Checksum8_Compute)->RangeMultiplier(4)->Range(64, 4096);
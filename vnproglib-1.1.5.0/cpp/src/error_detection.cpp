@@ -1,45 +1,245 @@
 #include "vn/error_detection.h"
+#include "vn/compiler.h"
+#include "vn/cpu.h"
+
+#include <cstring>
+
+#if VN_HAVE_X86_DISPATCH
+	#include <emmintrin.h>
+	#include <tmmintrin.h>
+	#include <wmmintrin.h>
+#endif
 
-#include <iostream>
 using namespace std;
+using namespace vn::xplat;
 
 namespace vn {
 namespace data {
 namespace integrity {
 
-uint8_t Checksum8::compute(char const data[], size_t length)
+namespace {
+
+// The CRC-16/CCITT polynomial x^16 + x^12 + x^5 + 1 used by the sensor.
+const uint32_t Crc16Polynomial = 0x11021;
+
+// Below this length the slicing-by-8 routine beats the setup cost of the
+// carry-less multiply folding.
+const size_t MinimumLengthForCrc16Folding = 64;
+
+typedef uint16_t (*Crc16Function)(uint16_t crc, const uint8_t* data, size_t length);
+typedef uint8_t (*Checksum8Function)(const uint8_t* data, size_t length);
+
+// Computes x^n mod P for the CRC polynomial P.
+uint16_t xPowModCrc16Polynomial(size_t n)
 {
-	if (length > 1000)
-		cout << "HAPPENING!" << endl;
+	uint32_t r = 1;
 
-	uint8_t xorVal = 0;
+	for (size_t i = 0; i < n; i++)
+	{
+		r <<= 1;
 
-	for (size_t i = 0; i < length; i++)
+		if (r & 0x10000)
+			r ^= Crc16Polynomial;
+	}
+
+	return static_cast<uint16_t>(r);
+}
+
+struct Crc16Tables
+{
+	// Lookup tables for processing eight bytes at a time (slicing-by-8).
+	// table[k][b] is the CRC of the byte b followed by k zero bytes.
+	uint16_t table[8][256];
+
+	// Constants for folding 128-bit blocks with carry-less multiplies.
+	uint16_t xPow64;
+	uint16_t xPow128;
+	uint16_t xPow192;
+
+	Crc16Tables() :
+		xPow64(xPowModCrc16Polynomial(64)),
+		xPow128(xPowModCrc16Polynomial(128)),
+		xPow192(xPowModCrc16Polynomial(192))
 	{
-		xorVal ^= data[i];
+		for (uint32_t b = 0; b < 256; b++)
+		{
+			uint32_t crc = b << 8;
+
+			for (size_t bit = 0; bit < 8; bit++)
+			{
+				crc <<= 1;
+
+				if (crc & 0x10000)
+					crc ^= Crc16Polynomial;
+			}
+
+			table[0][b] = static_cast<uint16_t>(crc);
+		}
+
+		for (size_t k = 1; k < 8; k++)
+		{
+			for (size_t b = 0; b < 256; b++)
+				table[k][b] = static_cast<uint16_t>((table[k - 1][b] << 8) ^ table[0][table[k - 1][b] >> 8]);
+		}
 	}
+};
 
-	return xorVal;
+const Crc16Tables& crc16Tables()
+{
+	static const Crc16Tables tables;
+
+	return tables;
 }
 
-uint16_t Crc16::compute(char const data[], size_t length)
+uint16_t crc16Slicing8(uint16_t crc, const uint8_t* data, size_t length)
 {
-	uint32_t i;
-	uint16_t crc = 0;
+	const uint16_t (*t)[256] = crc16Tables().table;
 
-	for (i = 0; i < length; i++)
+	for (; length >= 8; length -= 8, data += 8)
 	{
-		crc = static_cast<uint16_t>((crc >> 8) | (crc << 8));
+		uint16_t first = static_cast<uint16_t>(crc ^ ((data[0] << 8) | data[1]));
 
-		crc ^= static_cast<uint8_t>(data[i]);
-		crc ^= static_cast<uint16_t>(static_cast<uint8_t>(crc & 0xFF) >> 4);
-		crc ^= static_cast<uint16_t>((crc << 8) << 4);
-		crc ^= static_cast<uint16_t>(((crc & 0xFF) << 4) << 1);
+		crc = static_cast<uint16_t>(
+			t[7][first >> 8] ^ t[6][first & 0xFF] ^
+			t[5][data[2]] ^ t[4][data[3]] ^
+			t[3][data[4]] ^ t[2][data[5]] ^
+			t[1][data[6]] ^ t[0][data[7]]);
 	}
 
+	for (; length != 0; length--, data++)
+		crc = static_cast<uint16_t>((crc << 8) ^ t[0][(crc >> 8) ^ *data]);
+
 	return crc;
 }
 
+uint8_t checksum8Scalar(const uint8_t* data, size_t length)
+{
+	// XOR is order independent so we can combine a word at a time and fold
+	// the word down to a byte at the end.
+	uint64_t wide = 0;
+
+	for (; length >= 8; length -= 8, data += 8)
+	{
+		uint64_t word;
+		memcpy(&word, data, sizeof(word));
+		wide ^= word;
+	}
+
+	wide ^= wide >> 32;
+	wide ^= wide >> 16;
+	wide ^= wide >> 8;
+
+	uint8_t xorVal = static_cast<uint8_t>(wide);
+
+	for (; length != 0; length--, data++)
+		xorVal ^= *data;
+
+	return xorVal;
+}
+
+#if VN_HAVE_X86_DISPATCH
+
+// Folds the data 16 bytes at a time using carry-less multiplies. Each block
+// is byte reversed so the first byte is the most significant, as in the
+// CRC. The accumulator only needs to stay congruent to the message modulo
+// the polynomial, so it is reduced to 64 bits and the final CRC is taken
+// with the table routine.
+VN_TARGET("pclmul,ssse3")
+uint16_t crc16Folding(uint16_t crc, const uint8_t* data, size_t length)
+{
+	if (length < MinimumLengthForCrc16Folding)
+		return crc16Slicing8(crc, data, length);
+
+	const Crc16Tables& tables = crc16Tables();
+
+	const __m128i byteReverse = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+	const __m128i foldBy128 = _mm_set_epi32(0, tables.xPow192, 0, tables.xPow128);
+	const __m128i reduceBy64 = _mm_set_epi32(0, 0, 0, tables.xPow64);
+
+	__m128i x = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data)), byteReverse);
+	x = _mm_xor_si128(x, _mm_set_epi32(static_cast<int>(static_cast<uint32_t>(crc) << 16), 0, 0, 0));
+
+	data += 16;
+	length -= 16;
+
+	for (; length >= 16; length -= 16, data += 16)
+	{
+		__m128i block = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data)), byteReverse);
+
+		x = _mm_xor_si128(
+			_mm_xor_si128(_mm_clmulepi64_si128(x, foldBy128, 0x11), _mm_clmulepi64_si128(x, foldBy128, 0x00)),
+			block);
+	}
+
+	// Two reductions bring the 128-bit accumulator down to 64 bits.
+	x = _mm_xor_si128(_mm_clmulepi64_si128(x, reduceBy64, 0x01), _mm_move_epi64(x));
+	x = _mm_xor_si128(_mm_clmulepi64_si128(x, reduceBy64, 0x01), _mm_move_epi64(x));
+
+	uint8_t reduced[16];
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(reduced), _mm_shuffle_epi8(x, byteReverse));
+
+	crc = crc16Slicing8(0, reduced + 8, 8);
+
+	return crc16Slicing8(crc, data, length);
+}
+
+VN_TARGET("sse2")
+uint8_t checksum8Sse2(const uint8_t* data, size_t length)
+{
+	__m128i acc = _mm_setzero_si128();
+
+	for (; length >= 16; length -= 16, data += 16)
+		acc = _mm_xor_si128(acc, _mm_loadu_si128(reinterpret_cast<const __m128i*>(data)));
+
+	uint8_t folded[16];
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(folded), acc);
+
+	return checksum8Scalar(folded, sizeof(folded)) ^ checksum8Scalar(data, length);
+}
+
+#endif
+
+Crc16Function selectCrc16()
+{
+	#if VN_HAVE_X86_DISPATCH
+	if (Cpu::hasPclmul() && Cpu::hasSsse3())
+		return &crc16Folding;
+	#endif
+
+	return &crc16Slicing8;
+}
+
+Checksum8Function selectChecksum8()
+{
+	#if VN_HAVE_X86_DISPATCH
+	if (Cpu::hasSse2())
+		return &checksum8Sse2;
+	#endif
+
+	return &checksum8Scalar;
+}
+
+}
+
+uint8_t Checksum8::compute(char const data[], size_t length)
+{
+	static const Checksum8Function checksum8 = selectChecksum8();
+
+	return checksum8(reinterpret_cast<const uint8_t*>(data), length);
+}
+
+uint16_t Crc16::compute(char const data[], size_t length)
+{
+	return update(0, data, length);
+}
+
+uint16_t Crc16::update(uint16_t crc, char const data[], size_t length)
+{
+	static const Crc16Function crc16 = selectCrc16();
+
+	return crc16(crc, reinterpret_cast<const uint8_t*>(data), length);
+}
+
 }
 }
 }
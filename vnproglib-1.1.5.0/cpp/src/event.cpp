@@ -99,9 +99,17 @@ void Event::wait()
 
 	pthread_mutex_lock(&_pi->Mutex);
 
-	int errorCode = pthread_cond_wait(
-		&_pi->Condition,
-		&_pi->Mutex);
+	int errorCode = 0;
+
+	// Loop since condition variables can wake up without being signalled.
+	while (!_pi->IsTriggered && errorCode == 0)
+	{
+		errorCode = pthread_cond_wait(
+			&_pi->Condition,
+			&_pi->Mutex);
+	}
+
+	_pi->IsTriggered = false;
 
 	pthread_mutex_unlock(&_pi->Mutex);
 
@@ -146,20 +154,29 @@ Event::WaitResult Event::waitUs(uint32_t timeoutInMicroSec)
 	now.tv_sec += numOfSecs;
 	now.tv_nsec += numOfNanoseconds;
 
-	if (now.tv_nsec > 1000000000)
+	if (now.tv_nsec >= 1000000000)
 	{
 		now.tv_nsec %= 1000000000;
 		now.tv_sec++;
 	}
 
-	int errorCode = pthread_cond_timedwait(
-		&_pi->Condition,
-		&_pi->Mutex,
-		&now);
+	int errorCode = 0;
+
+	// Loop since condition variables can wake up without being signalled.
+	while (!_pi->IsTriggered && errorCode == 0)
+	{
+		errorCode = pthread_cond_timedwait(
+			&_pi->Condition,
+			&_pi->Mutex,
+			&now);
+	}
+
+	bool wasTriggered = _pi->IsTriggered;
+	_pi->IsTriggered = false;
 
 	pthread_mutex_unlock(&_pi->Mutex);
 
-	if (errorCode == 0)
+	if (wasTriggered)
 		return WAIT_SIGNALED;
 
 	if (errorCode == ETIMEDOUT)
@@ -185,20 +202,29 @@ Event::WaitResult Event::waitUs(uint32_t timeoutInMicroSec)
 	now.tv_sec += numOfSecs;
 	now.tv_nsec += numOfNanoseconds;
 
-	if (now.tv_nsec > 1000000000)
+	if (now.tv_nsec >= 1000000000)
 	{
 		now.tv_nsec %= 1000000000;
 		now.tv_sec++;
 	}
 
-	int errorCode = pthread_cond_timedwait(
-		&_pi->Condition,
-		&_pi->Mutex,
-		&now);
+	int errorCode = 0;
+
+	// Loop since condition variables can wake up without being signalled.
+	while (!_pi->IsTriggered && errorCode == 0)
+	{
+		errorCode = pthread_cond_timedwait(
+			&_pi->Condition,
+			&_pi->Mutex,
+			&now);
+	}
+
+	bool wasTriggered = _pi->IsTriggered;
+	_pi->IsTriggered = false;
 
 	pthread_mutex_unlock(&_pi->Mutex);
 
-	if (errorCode == 0)
+	if (wasTriggered)
 		return WAIT_SIGNALED;
 
 	if (errorCode == ETIMEDOUT)
@@ -0,0 +1,35 @@
+#include "gtest/gtest.h"
+
+#include "vn/event.h"
+
+using namespace vn::xplat;
+
+TEST(EventTest, SignalMadeBeforeWaitIsNotLost)
+{
+	Event e;
+
+	e.signal();
+
+	EXPECT_EQ(Event::WAIT_SIGNALED, e.waitMs(0));
+}
+
+TEST(EventTest, ResetsWhenWaitReturns)
+{
+	Event e;
+
+	e.signal();
+	e.signal();
+
+	EXPECT_EQ(Event::WAIT_SIGNALED, e.waitMs(0));
+	EXPECT_EQ(Event::WAIT_TIMEDOUT, e.waitMs(10));
+}
+
+TEST(EventTest, WaitReturnsAfterEarlierSignal)
+{
+	Event e;
+
+	e.signal();
+	e.wait();
+
+	EXPECT_EQ(Event::WAIT_TIMEDOUT, e.waitUs(1000));
+}
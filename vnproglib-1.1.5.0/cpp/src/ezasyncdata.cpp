@@ -16,22 +16,16 @@ void EzAsyncData::asyncPacketReceivedHandler(void* userData, protocol::uart::Pac
 {
 	EzAsyncData* ez = static_cast<EzAsyncData*>(userData);
 
-	CompositeData nd;
+	ez->_receivedData.reset();
 
-	#if VN_SUPPORTS_INITIALIZER_LIST
-	vector<CompositeData*> d({ &ez->_persistentData, &nd });
-	#else
-	vector<CompositeData*> d(2);
-	d[0] = &ez->_persistentData;
-	d[1] = &nd;
-	#endif
+	CompositeData* const d[] = { &ez->_persistentData, &ez->_receivedData };
 
 	ez->_mainCS.enter();
-	CompositeData::parse(p, d);
+	CompositeData::parse(p, d, 2);
 	ez->_mainCS.leave();
 
 	ez->_copyCS.enter();
-	ez->_nextData = nd;
+	ez->_nextData = ez->_receivedData;
 	ez->_copyCS.leave();
 
 	ez->_newDataEvent.signal();
@@ -87,7 +81,7 @@ CompositeData EzAsyncData::currentData()
 	cd = _persistentData;
 	_mainCS.leave();
 
-	return CompositeData(cd);
+	return cd;
 }
 
 CompositeData EzAsyncData::getNextData()
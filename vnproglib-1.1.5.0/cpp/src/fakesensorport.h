@@ -0,0 +1,261 @@
+#ifndef _VN_FAKESENSORPORT_H_
+#define _VN_FAKESENSORPORT_H_
+
+#include "vn/port.h"
+#include "vn/atomic.h"
+#include "vn/criticalsection.h"
+#include "vn/error_detection.h"
+#include "vn/handlerslot.h"
+#include "vn/thread.h"
+#include "vn/vntime.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <string>
+
+namespace vn {
+namespace xplat {
+
+// Stands in for a sensor, answering commands in the order they were written
+// once ReplyDelayMs has passed.
+class FakeSensorPort : public IPort
+{
+public:
+
+	static const uint32_t ReplyDelayMs = 20;
+
+	FakeSensorPort() :
+		_isOpen(false),
+		_numOfErrorsToSend(0),
+		_numOfDuplicatesToSend(0),
+		_numOfCommands(0),
+		_lastDueMs(0)
+	{
+		_continueDelivering.store(true);
+		_thread = Thread::startNew(deliverReplies, this);
+	}
+
+	~FakeSensorPort()
+	{
+		_continueDelivering.store(false);
+		_thread->join();
+		delete _thread;
+	}
+
+	void setRegister(int registerId, const std::string& values)
+	{
+		_cs.enter();
+		_registers[registerId] = values;
+		_cs.leave();
+	}
+
+	// The next command is answered with an error.
+	void failNextCommand()
+	{
+		_cs.enter();
+		_numOfErrorsToSend++;
+		_cs.leave();
+	}
+
+	// Reads of the register are answered after delayMs rather than in turn,
+	// or never if delayMs is negative.
+	void setReadDelay(int registerId, int delayMs)
+	{
+		_cs.enter();
+		_readDelays[registerId] = delayMs;
+		_cs.leave();
+	}
+
+	// The next command is answered twice, as when a retransmit crosses the
+	// first response.
+	void duplicateNextReply()
+	{
+		_cs.enter();
+		_numOfDuplicatesToSend++;
+		_cs.leave();
+	}
+
+	// The number of commands written to the sensor so far.
+	int numOfCommands()
+	{
+		_cs.enter();
+		int n = _numOfCommands;
+		_cs.leave();
+
+		return n;
+	}
+
+	void open() { _isOpen = true; }
+	void close() { _isOpen = false; }
+	bool isOpen() { return _isOpen; }
+
+	void write(const char data[], size_t length)
+	{
+		std::string command(data, length);
+		std::string body = command.substr(1, command.find('*') - 1);
+		std::string reply = body;
+
+		_cs.enter();
+
+		_numOfCommands++;
+
+		int readDelayMs = -1;
+		bool isReadOutOfTurn = false;
+
+		if (body.compare(0, 5, "VNRRG") == 0)
+		{
+			int registerId = atoi(body.c_str() + 6);
+
+			if (_readDelays.count(registerId) != 0)
+			{
+				readDelayMs = _readDelays[registerId];
+				isReadOutOfTurn = true;
+			}
+
+			char header[16];
+			sprintf(header, "VNRRG,%02d,", registerId);
+
+			reply = header + _registers[registerId];
+		}
+		else if (body.compare(0, 5, "VNWRG") == 0)
+		{
+			size_t valuesStart = body.find(',', 6);
+
+			if (valuesStart != std::string::npos)
+				_registers[atoi(body.c_str() + 6)] = body.substr(valuesStart + 1);
+		}
+
+		if (_numOfErrorsToSend > 0)
+		{
+			reply = "VNERR,05";
+			_numOfErrorsToSend--;
+		}
+
+		char checksum[8];
+		sprintf(checksum, "*%02X\r\n", vn::data::integrity::Checksum8::compute(reply.c_str(), reply.length()));
+
+		if (isReadOutOfTurn && readDelayMs < 0)
+		{
+			_cs.leave();
+			return;
+		}
+
+		float dueMs = _clock.elapsedMs() + (isReadOutOfTurn ? readDelayMs : ReplyDelayMs);
+
+		if (!isReadOutOfTurn)
+		{
+			if (dueMs < _lastDueMs)
+				dueMs = _lastDueMs;
+
+			_lastDueMs = dueMs;
+		}
+
+		Reply r;
+		r.dueMs = dueMs;
+		r.data = "$" + reply + checksum;
+
+		insertReply(r);
+
+		if (_numOfDuplicatesToSend > 0)
+		{
+			insertReply(r);
+			_numOfDuplicatesToSend--;
+		}
+
+		_cs.leave();
+	}
+
+	void read(char dataBuffer[], size_t numOfBytesToRead, size_t &numOfBytesActuallyRead)
+	{
+		_cs.enter();
+
+		numOfBytesActuallyRead = _received.length() < numOfBytesToRead ? _received.length() : numOfBytesToRead;
+		memcpy(dataBuffer, _received.data(), numOfBytesActuallyRead);
+		_received.erase(0, numOfBytesActuallyRead);
+
+		_cs.leave();
+	}
+
+	void registerDataReceivedHandler(void* userData, DataReceivedHandler handler)
+	{
+		_dataReceived.registerHandler(userData, handler);
+	}
+
+	void unregisterDataReceivedHandler()
+	{
+		_dataReceived.unregisterHandler();
+	}
+
+private:
+
+	struct Reply
+	{
+		float dueMs;
+		std::string data;
+	};
+
+	// Keeps the replies in the order they are due.
+	void insertReply(const Reply& r)
+	{
+		std::deque<Reply>::iterator it = _replies.end();
+
+		while (it != _replies.begin() && (it - 1)->dueMs > r.dueMs)
+			--it;
+
+		_replies.insert(it, r);
+	}
+
+	static void deliverReplies(void* userData)
+	{
+		FakeSensorPort* port = static_cast<FakeSensorPort*>(userData);
+
+		while (port->_continueDelivering.load())
+		{
+			Thread::sleepUs(500);
+
+			port->_cs.enter();
+
+			bool delivered = false;
+
+			while (!port->_replies.empty() && port->_replies.front().dueMs <= port->_clock.elapsedMs())
+			{
+				port->_received += port->_replies.front().data;
+				port->_replies.pop_front();
+				delivered = true;
+			}
+
+			port->_cs.leave();
+
+			if (!delivered)
+				continue;
+
+			HandlerSlot<DataReceivedHandler>::Dispatch dispatch(port->_dataReceived);
+
+			if (dispatch.isRegistered())
+				dispatch->handler(dispatch->userData);
+		}
+	}
+
+	bool _isOpen;
+	HandlerSlot<DataReceivedHandler> _dataReceived;
+	std::map<int, std::string> _registers;
+	std::map<int, int> _readDelays;
+	int _numOfErrorsToSend;
+	int _numOfDuplicatesToSend;
+	int _numOfCommands;
+	std::deque<Reply> _replies;
+	std::string _received;
+	float _lastDueMs;
+	Stopwatch _clock;
+	CriticalSection _cs;
+	Atomic<bool> _continueDelivering;
+	Thread* _thread;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,89 @@
+#include "benchmark/benchmark.h"
+
+#include "vn/handlerslot.h"
+#include "vn/criticalsection.h"
+
+using namespace vn::xplat;
+
+namespace {
+
+typedef void (*CountingHandler)(void* userData);
+
+void countCall(void* userData)
+{
+	(*static_cast<size_t*>(userData))++;
+}
+
+void HandlerSlot_DispatchUnregistered(benchmark::State& state)
+{
+	HandlerSlot<CountingHandler> slot;
+
+	while (state.KeepRunning())
+	{
+		HandlerSlot<CountingHandler>::Dispatch dispatch(slot);
+
+		benchmark::DoNotOptimize(dispatch.isRegistered());
+	}
+}
+
+void HandlerSlot_DispatchRegistered(benchmark::State& state)
+{
+	size_t numOfCalls = 0;
+
+	HandlerSlot<CountingHandler> slot;
+	slot.registerHandler(&numOfCalls, countCall);
+
+	while (state.KeepRunning())
+	{
+		HandlerSlot<CountingHandler>::Dispatch dispatch(slot);
+
+		if (dispatch.isRegistered())
+			dispatch->handler(dispatch->userData);
+	}
+
+	benchmark::DoNotOptimize(numOfCalls);
+
+	slot.unregisterHandler();
+}
+
+void HandlerSlot_RegisterAndUnregister(benchmark::State& state)
+{
+	size_t numOfCalls = 0;
+
+	HandlerSlot<CountingHandler> slot;
+
+	while (state.KeepRunning())
+	{
+		slot.registerHandler(&numOfCalls, countCall);
+		slot.unregisterHandler();
+	}
+}
+
+// Holding a lock around the call, as the ports did before HandlerSlot.
+void CriticalSection_DispatchRegistered(benchmark::State& state)
+{
+	size_t numOfCalls = 0;
+
+	CriticalSection cs;
+	CountingHandler handler = countCall;
+	void* userData = &numOfCalls;
+
+	while (state.KeepRunning())
+	{
+		cs.enter();
+
+		if (handler != NULL)
+			handler(userData);
+
+		cs.leave();
+	}
+
+	benchmark::DoNotOptimize(numOfCalls);
+}
+
+}
+
+BENCHMARK(HandlerSlot_DispatchUnregistered);
+BENCHMARK(HandlerSlot_DispatchRegistered);
+BENCHMARK(HandlerSlot_RegisterAndUnregister);
+BENCHMARK(CriticalSection_DispatchRegistered);
@@ -0,0 +1,102 @@
+#include "gtest/gtest.h"
+
+#include "vn/handlerslot.h"
+#include "vn/thread.h"
+
+using namespace vn::xplat;
+
+namespace {
+
+typedef void (*CheckedHandler)(void* userData);
+
+// User data which is marked as destroyed once its handler is unregistered.
+struct HandlerData
+{
+	Atomic<bool> destroyed;
+	Atomic<size_t> numOfCalls;
+};
+
+Atomic<size_t> NumOfCallsAfterUnregister;
+
+void checkNotDestroyed(void* userData)
+{
+	HandlerData* data = static_cast<HandlerData*>(userData);
+
+	if (data->destroyed.load())
+		NumOfCallsAfterUnregister.fetchAdd(1);
+
+	data->numOfCalls.fetchAdd(1);
+}
+
+struct Dispatcher
+{
+	HandlerSlot<CheckedHandler> slot;
+	Atomic<bool> keepDispatching;
+
+	Dispatcher() : keepDispatching(true) { }
+};
+
+void dispatchUntilStopped(void* routineData)
+{
+	Dispatcher* dispatcher = static_cast<Dispatcher*>(routineData);
+
+	while (dispatcher->keepDispatching.load())
+	{
+		HandlerSlot<CheckedHandler>::Dispatch dispatch(dispatcher->slot);
+
+		if (dispatch.isRegistered())
+			dispatch->handler(dispatch->userData);
+	}
+}
+
+}
+
+TEST(HandlerSlotTest, RegisterThrowsWhenAlreadyRegistered)
+{
+	HandlerData data;
+	HandlerSlot<CheckedHandler> slot;
+
+	slot.registerHandler(&data, checkNotDestroyed);
+
+	EXPECT_THROW(slot.registerHandler(&data, checkNotDestroyed), vn::invalid_operation);
+
+	slot.unregisterHandler();
+
+	EXPECT_THROW(slot.unregisterHandler(), vn::invalid_operation);
+}
+
+TEST(HandlerSlotTest, HandlerIsNotCalledAfterUnregisterReturns)
+{
+	Dispatcher dispatcher;
+	NumOfCallsAfterUnregister.store(0);
+
+	Thread* thread = Thread::startNew(dispatchUntilStopped, &dispatcher);
+
+	size_t numOfCalls = 0;
+
+	for (size_t i = 0; i < 2000; i++)
+	{
+		HandlerData data;
+
+		dispatcher.slot.registerHandler(&data, checkNotDestroyed);
+
+		if (i % 16 == 0)
+			Thread::sleepUs(100);
+
+		dispatcher.slot.unregisterHandler();
+
+		data.destroyed.store(true);
+
+		numOfCalls += data.numOfCalls.load();
+
+		if (i % 2 == 0)
+			Thread::sleepUs(0);
+	}
+
+	dispatcher.keepDispatching.store(false);
+	thread->join();
+	delete thread;
+
+	EXPECT_EQ(0u, NumOfCallsAfterUnregister.load());
+	EXPECT_LT(0u, numOfCalls);
+}
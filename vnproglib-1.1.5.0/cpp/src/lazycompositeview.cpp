@@ -0,0 +1,28 @@
+#include "vn/lazycompositeview.h"
+#include "vn/utilities.h"
+
+using namespace vn::protocol::uart;
+
+namespace vn {
+namespace sensors {
+
+LazyCompositeView::LazyCompositeView(Packet& p) :
+	_data(p.data()),
+	_plan(NULL)
+{
+	if (p.type() != Packet::TYPE_BINARY)
+		throw invalid_operation();
+
+	// The whole header must be present before we can look up its plan.
+	if (p.length() < 2 || p.length() < 2 + 2 * static_cast<size_t>(countSetBits(static_cast<uint8_t>(_data[1]))))
+		throw invalid_operation();
+
+	_plan = &BinaryPlan::get(_data, _scratch);
+
+	if (p.length() < _plan->length)
+		// The packet is too short for the fields its header says it has.
+		throw invalid_operation();
+}
+
+}
+}
@@ -0,0 +1,210 @@
+#include "gtest/gtest.h"
+
+#include "vn/lazycompositeview.h"
+#include "vn/compositedata.h"
+#include "vn/packet.h"
+#include "vn/error_detection.h"
+#include "vn/exceptions.h"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+using namespace std;
+using namespace vn::math;
+using namespace vn::sensors;
+using namespace vn::protocol::uart;
+using namespace vn::data::integrity;
+
+namespace {
+
+// Deterministic generator so every run sees the same packets.
+class PayloadRandom
+{
+public:
+	PayloadRandom() : _state(88172645463325252ULL) { }
+
+	uint64_t next()
+	{
+		_state ^= _state << 13;
+		_state ^= _state >> 7;
+		_state ^= _state << 17;
+
+		return _state;
+	}
+
+private:
+	uint64_t _state;
+};
+
+// Every field of each of the seven binary groups.
+const uint16_t AllFields[7] = { 0x7FFF, 0x03FF, 0x0FFF, 0x3FFF, 0x01FF, 0x07FF, 0x3FFF };
+
+// Builds a binary packet with the fields selected for each of the seven
+// groups and a random payload. The payload bytes are kept below 0x40 so
+// every float and double in it is finite.
+vector<char> makeGroupsPacket(const uint16_t fields[7], PayloadRandom& rnd)
+{
+	vector<char> packet;
+	packet.push_back(static_cast<char>(0xFA));
+	packet.push_back(0);
+
+	for (size_t i = 0; i < 7; i++)
+	{
+		if (fields[i] == 0)
+			continue;
+
+		packet[1] = static_cast<char>(packet[1] | (1 << i));
+		packet.push_back(static_cast<char>(fields[i] & 0xFF));
+		packet.push_back(static_cast<char>(fields[i] >> 8));
+	}
+
+	size_t length = Packet::computeBinaryPacketLength(&packet[0]);
+
+	while (packet.size() < length - 2)
+		packet.push_back(static_cast<char>(rnd.next() & 0x3F));
+
+	uint16_t crc = Crc16::compute(&packet[1], packet.size() - 1);
+	packet.push_back(static_cast<char>(crc >> 8));
+	packet.push_back(static_cast<char>(crc & 0xFF));
+
+	return packet;
+}
+
+// Compares values bit for bit, as vectors, matrices and the status
+// structures have no equality operator.
+template<typename T>
+::testing::AssertionResult isSameBits(const char* expectedText, const char* actualText, const T& expected, const T& actual)
+{
+	if (memcmp(&expected, &actual, sizeof(T)) == 0)
+		return ::testing::AssertionSuccess();
+
+	return ::testing::AssertionFailure() << actualText << " differs from " << expectedText;
+}
+
+// Checks the view reports a field as present exactly when CompositeData
+// does, with the same value, and throws the same way when it is absent.
+#define EXPECT_SAME_FIELD(Name, name) \
+	{ \
+		SCOPED_TRACE(#name); \
+		ASSERT_EQ(cd.has##Name(), view.has##Name()); \
+		if (cd.has##Name()) \
+		{ \
+			EXPECT_PRED_FORMAT2(isSameBits, cd.name(), view.name()); \
+		} \
+		else \
+		{ \
+			EXPECT_THROW(view.name(), vn::invalid_operation); \
+		} \
+	}
+
+void expectViewMatchesParse(Packet& p)
+{
+	CompositeData cd = CompositeData::parse(p);
+	LazyCompositeView view(p);
+
+	EXPECT_SAME_FIELD(TimeStartup, timeStartup);
+	EXPECT_SAME_FIELD(TimeGps, timeGps);
+	EXPECT_SAME_FIELD(TimeSyncIn, timeSyncIn);
+	EXPECT_SAME_FIELD(Tow, tow);
+	EXPECT_SAME_FIELD(Week, week);
+	EXPECT_SAME_FIELD(TimeGpsPps, timeGpsPps);
+	EXPECT_SAME_FIELD(SyncInCnt, syncInCnt);
+	EXPECT_SAME_FIELD(YawPitchRoll, yawPitchRoll);
+	EXPECT_SAME_FIELD(Quaternion, quaternion);
+	EXPECT_SAME_FIELD(DirectionCosineMatrix, directionCosineMatrix);
+	EXPECT_SAME_FIELD(VpeStatus, vpeStatus);
+	EXPECT_SAME_FIELD(AttitudeUncertainty, attitudeUncertainty);
+	EXPECT_SAME_FIELD(AngularRate, angularRate);
+	EXPECT_SAME_FIELD(Acceleration, acceleration);
+	EXPECT_SAME_FIELD(Magnetic, magnetic);
+	EXPECT_SAME_FIELD(Temperature, temperature);
+	EXPECT_SAME_FIELD(Pressure, pressure);
+	EXPECT_SAME_FIELD(AccelerationUncompensated, accelerationUncompensated);
+	EXPECT_SAME_FIELD(AngularRateUncompensated, angularRateUncompensated);
+	EXPECT_SAME_FIELD(MagneticUncompensated, magneticUncompensated);
+	EXPECT_SAME_FIELD(DeltaTime, deltaTime);
+	EXPECT_SAME_FIELD(DeltaTheta, deltaTheta);
+	EXPECT_SAME_FIELD(DeltaVelocity, deltaVelocity);
+	EXPECT_SAME_FIELD(InsStatus, insStatus);
+	EXPECT_SAME_FIELD(PositionEstimatedLla, positionEstimatedLla);
+	EXPECT_SAME_FIELD(PositionEstimatedEcef, positionEstimatedEcef);
+	EXPECT_SAME_FIELD(VelocityEstimatedBody, velocityEstimatedBody);
+	EXPECT_SAME_FIELD(VelocityEstimatedNed, velocityEstimatedNed);
+	EXPECT_SAME_FIELD(VelocityEstimatedEcef, velocityEstimatedEcef);
+	EXPECT_SAME_FIELD(AccelerationEcef, accelerationEcef);
+	EXPECT_SAME_FIELD(PositionUncertaintyEstimated, positionUncertaintyEstimated);
+	EXPECT_SAME_FIELD(VelocityUncertaintyEstimated, velocityUncertaintyEstimated);
+	EXPECT_SAME_FIELD(GpsTow, gpsTow);
+	EXPECT_SAME_FIELD(NumSats, numSats);
+	EXPECT_SAME_FIELD(Fix, fix);
+	EXPECT_SAME_FIELD(PositionGpsLla, positionGpsLla);
+	EXPECT_SAME_FIELD(PositionGpsEcef, positionGpsEcef);
+	EXPECT_SAME_FIELD(VelocityGpsNed, velocityGpsNed);
+	EXPECT_SAME_FIELD(VelocityGpsEcef, velocityGpsEcef);
+}
+
+#undef EXPECT_SAME_FIELD
+
+}
+
+TEST(LazyCompositeViewTest, EachGroupMatchesCompositeData)
+{
+	PayloadRandom rnd;
+
+	for (size_t group = 0; group < 7; group++)
+	{
+		uint16_t fields[7] = { 0 };
+		fields[group] = AllFields[group];
+
+		vector<char> bytes = makeGroupsPacket(fields, rnd);
+		PacketView p(&bytes[0], bytes.size());
+
+		SCOPED_TRACE(group);
+		expectViewMatchesParse(p);
+	}
+}
+
+TEST(LazyCompositeViewTest, RandomFieldsMatchCompositeData)
+{
+	PayloadRandom rnd;
+
+	for (size_t i = 0; i < 2000; i++)
+	{
+		// Fields found in more than one group are included freely, so the
+		// view has to pick the same group CompositeData does.
+		uint16_t fields[7] = { 0 };
+
+		for (size_t group = 0; group < 7; group++)
+		{
+			if (rnd.next() % 2 == 0)
+				fields[group] = static_cast<uint16_t>(rnd.next() & AllFields[group]);
+		}
+
+		if (fields[0] == 0 && fields[1] == 0 && fields[2] == 0 && fields[3] == 0 && fields[4] == 0 && fields[5] == 0 && fields[6] == 0)
+			continue;
+
+		vector<char> bytes = makeGroupsPacket(fields, rnd);
+		PacketView p(&bytes[0], bytes.size());
+
+		SCOPED_TRACE(i);
+		expectViewMatchesParse(p);
+	}
+}
+
+TEST(LazyCompositeViewTest, PacketsItCannotViewAreRejected)
+{
+	const char ascii[] = "$VNYPR,+010.000,-020.500,+030.250*6E\r\n";
+	PacketView asciiPacket(ascii, sizeof(ascii) - 1);
+
+	EXPECT_THROW(LazyCompositeView view(asciiPacket), vn::invalid_operation);
+
+	PayloadRandom rnd;
+	uint16_t fields[7] = { COMMONGROUP_YAWPITCHROLL | COMMONGROUP_POSITION, 0, 0, 0, 0, 0, 0 };
+	vector<char> bytes = makeGroupsPacket(fields, rnd);
+
+	// Cut off inside the payload.
+	PacketView truncated(&bytes[0], bytes.size() - 8);
+
+	EXPECT_THROW(LazyCompositeView view(truncated), vn::invalid_operation);
+}
@@ -1,6 +1,6 @@
 #include "vn/memoryport.h"
-#include "vn/criticalsection.h"
 #include "vn/exceptions.h"
+#include "vn/handlerslot.h"
 
 #include <list>
 
@@ -15,12 +15,10 @@ struct MemoryPort::Impl
 	// Indiates if the serial port is open.
 	bool IsOpen;
 
-	// Critical section for registering, unregistering, and notifying observers
-	// of events.
-	CriticalSection ObserversCriticalSection;
+	// The handler notified when data is received. Registering and
+	// unregistering do not block on notifications in progress.
+	HandlerSlot<DataReceivedHandler> DataReceived;
 
-	DataReceivedHandler _dataReceivedHandler;
-	void* _dataReceivedUserData;
 	DataWrittenHandler _dataWrittenHandler;
 	void* _dataWrittenUserData;
 
@@ -32,8 +30,6 @@ struct MemoryPort::Impl
 
 	explicit Impl(MemoryPort* backReference) :
 		IsOpen(false),
-		_dataReceivedHandler(NULL),
-		_dataReceivedUserData(NULL),
 		_dataWrittenHandler(NULL),
 		_dataWrittenUserData(NULL),
 		DataAvailableForRead(NULL),
@@ -43,14 +39,10 @@ struct MemoryPort::Impl
 
 	void OnDataReceived()
 	{
-		if (_dataReceivedHandler == NULL)
-			return;
+		HandlerSlot<DataReceivedHandler>::Dispatch dispatch(DataReceived);
 
-		ObserversCriticalSection.enter();
-
-		_dataReceivedHandler(_dataReceivedUserData);
-
-		ObserversCriticalSection.leave();
+		if (dispatch.isRegistered())
+			dispatch->handler(dispatch->userData);
 	}
 };
 
@@ -119,28 +111,12 @@ void MemoryPort::read(char dataBuffer[], size_t numOfBytesToRead, size_t &numOfB
 
 void MemoryPort::registerDataReceivedHandler(void* userData, DataReceivedHandler handler)
 {
-	if (_pi->_dataReceivedHandler != NULL)
-		throw invalid_operation();
-
-	_pi->ObserversCriticalSection.enter();
-
-	_pi->_dataReceivedHandler = handler;
-	_pi->_dataReceivedUserData = userData;
-
-	_pi->ObserversCriticalSection.leave();
+	_pi->DataReceived.registerHandler(userData, handler);
 }
 
 void MemoryPort::unregisterDataReceivedHandler()
 {
-	if (_pi->_dataReceivedHandler == NULL)
-		throw invalid_operation();
-
-	_pi->ObserversCriticalSection.enter();
-
-	_pi->_dataReceivedHandler = NULL;
-	_pi->_dataReceivedUserData = NULL;
-
-	_pi->ObserversCriticalSection.leave();
+	_pi->DataReceived.unregisterHandler();
 }
 
 void MemoryPort::registerDataWrittenHandler(void* userData, DataWrittenHandler handler)
@@ -1,4 +1,6 @@
 #include "vn/packet.h"
+#include "vn/binaryplan.h"
+#include "vn/commandencoder.h"
 #include "vn/utilities.h"
 #include "vn/error_detection.h"
 #include "vn/compiler.h"
@@ -13,8 +15,9 @@
 #include <string>
 #include <queue>
 #include <list>
-
-#include <cstring>
+#include <sstream>
+#include <locale>
+#include <limits>
 
 #if PYTHON
 	#include "python.hpp"
@@ -22,16 +25,15 @@
 	namespace bp = boost::python;
 #endif
 
-#define NEXT result = getNextData(_data, parseIndex); \
-	if (result == NULL) \
+#define NEXT if (!nextAsciiField(result)) \
 		return;
 
-#define ATOFF static_cast<float>(std::atof(result))
-#define ATOFD std::atof(result)
-#define ATOU32 static_cast<uint32_t>(std::atoi(result))
-#define ATOU16X ((uint16_t) std::strtoul(result, NULL, 16))
-#define ATOU16 static_cast<uint16_t>(std::atoi(result))
-#define ATOU8 static_cast<uint8_t>(std::atoi(result))
+#define ATOFF static_cast<float>(scanAsciiDouble(result))
+#define ATOFD scanAsciiDouble(result)
+#define ATOU32 static_cast<uint32_t>(scanAsciiInt(result))
+#define ATOU16X static_cast<uint16_t>(scanAsciiHex(result))
+#define ATOU16 static_cast<uint16_t>(scanAsciiInt(result))
+#define ATOU8 static_cast<uint8_t>(scanAsciiInt(result))
 
 using namespace std;
 using namespace vn::math;
@@ -42,8 +44,6 @@ namespace vn {
 namespace protocol {
 namespace uart {
 
-char* vnstrtok(char* str, size_t& startIndex);
-
 const unsigned char Packet::BinaryGroupLengths[sizeof(uint8_t)*8][sizeof(uint16_t)*15] = {
 	{ 8,  8,  8, 12, 16, 12, 24, 12, 12, 24, 20, 28,  2,  4,  8},		// Group 1
 	{ 8,  8,  8,  2,  8,  8,  8,  4,  4,  1,  0,  0,  0,  0,  0},		// Group 2
@@ -58,7 +58,10 @@ const unsigned char Packet::BinaryGroupLengths[sizeof(uint8_t)*8][sizeof(uint16_
 Packet::Packet() :
 	_isPacketDataMine(false),
 	_length(0),
-	_data(NULL)
+	_data(NULL),
+	_isKnownValid(false),
+	_kind(KIND_UNCLASSIFIED),
+	_asciiAsyncType(VNOFF)
 {
 }
 
@@ -66,7 +69,10 @@ Packet::Packet(char const* packet, size_t length) :
 	_isPacketDataMine(true),
 	_length(length),
 	_data(new char[length]),
-	_curExtractLoc(0)
+	_curExtractLoc(0),
+	_isKnownValid(false),
+	_kind(KIND_UNCLASSIFIED),
+	_asciiAsyncType(VNOFF)
 {
 	std::memcpy(_data, packet, length);
 }
@@ -75,7 +81,10 @@ Packet::Packet(string packet) :
 	_isPacketDataMine(true),
 	_length(packet.size()),
 	_data(new char[packet.size()]),
-	_curExtractLoc(0)
+	_curExtractLoc(0),
+	_isKnownValid(false),
+	_kind(KIND_UNCLASSIFIED),
+	_asciiAsyncType(VNOFF)
 {
 	std::memcpy(_data, packet.c_str(), packet.size());
 }
@@ -84,11 +93,32 @@ Packet::Packet(Packet const& toCopy) :
 	_isPacketDataMine(true),
 	_length(toCopy._length),
 	_data(new char[toCopy._length]),
-	_curExtractLoc(0)
+	_curExtractLoc(0),
+	_isKnownValid(toCopy._isKnownValid),
+	_kind(toCopy._kind),
+	_asciiAsyncType(toCopy._asciiAsyncType)
 {
 	std::memcpy(_data, toCopy._data, toCopy._length);
 }
 
+PacketView::PacketView(char const* packet, size_t length)
+{
+	_length = length;
+	_data = const_cast<char*>(packet);
+	_curExtractLoc = 0;
+}
+
+PacketView::PacketView(PacketView const& toCopy) :
+	Packet()
+{
+	_length = toCopy._length;
+	_data = toCopy._data;
+	_curExtractLoc = 0;
+	_isKnownValid = toCopy._isKnownValid;
+	_kind = toCopy._kind;
+	_asciiAsyncType = toCopy._asciiAsyncType;
+}
+
 Packet::~Packet()
 {
 	if (_isPacketDataMine)
@@ -109,6 +139,9 @@ Packet& Packet::operator=(Packet const& from)
 	_data = new char[from._length];
 	_length = from._length;
 	_curExtractLoc = from._curExtractLoc;
+	_isKnownValid = from._isKnownValid;
+	_kind = from._kind;
+	_asciiAsyncType = from._asciiAsyncType;
 
 	std::memcpy(_data, from._data, from._length);
 
@@ -120,6 +153,16 @@ string Packet::datastr()
 	return string(_data, _length);
 }
 
+char const* Packet::data() const
+{
+	return _data;
+}
+
+size_t Packet::length() const
+{
+	return _length;
+}
+
 Packet::Type Packet::type()
 {
 	if (_length < 1)
@@ -144,6 +187,9 @@ Packet::Type Packet::type()
 
 bool Packet::isValid()
 {
+	if (_isKnownValid)
+		return true;
+
 	if (_length < 7)  // minumum binary packet is 7 bytes, minimum ASCII is 8 bytes
 		return false;
 
@@ -161,7 +207,9 @@ bool Packet::isValid()
 
 			uint8_t computedChecksum = Checksum8::compute(_data + 1, _length - 6);
 
-			return expectedChecksum == computedChecksum;
+			_isKnownValid = expectedChecksum == computedChecksum;
+
+			return _isKnownValid;
 		}
 		else if (_data[_length - 7] == '*')
 		{
@@ -170,7 +218,9 @@ bool Packet::isValid()
 
 			uint16_t computedCrc = Crc16::compute(_data + 1, _length - 8);
 
-			return packetCrc == computedCrc;
+			_isKnownValid = packetCrc == computedCrc;
+
+			return _isKnownValid;
 		}
 		else
 		{
@@ -182,7 +232,9 @@ bool Packet::isValid()
 	{
 		uint16_t computedCrc = Crc16::compute(_data + 1, _length - 1);
 
-		return computedCrc == 0;
+		_isKnownValid = computedCrc == 0;
+
+		return _isKnownValid;
 	}
 	else
 	{
@@ -190,205 +242,132 @@ bool Packet::isValid()
 	}
 }
 
-bool Packet::isError()
+void Packet::markAsValid()
 {
-	return std::strncmp(_data + 3, "ERR", 3) == 0;
+	_isKnownValid = true;
 }
 
-bool Packet::isResponse()
+// Packs the three characters identifying an ASCII message (e.g. the "YPR" of
+// "$VNYPR") into one value so headers can be classified with a single switch.
+#define ASCII_HEADER(a, b, c) \
+	((static_cast<uint32_t>(static_cast<unsigned char>(a)) << 16) | \
+	(static_cast<uint32_t>(static_cast<unsigned char>(b)) << 8) | \
+	static_cast<uint32_t>(static_cast<unsigned char>(c)))
+
+void Packet::classify()
 {
-	if (std::strncmp(_data + 3, "WRG", 3) == 0)
-		return true;
-	if (std::strncmp(_data + 3, "RRG", 3) == 0)
-		return true;
-	if (std::strncmp(_data + 3, "WNV", 3) == 0)
-		return true;
-	if (std::strncmp(_data + 3, "RFS", 3) == 0)
-		return true;
-	if (std::strncmp(_data + 3, "RST", 3) == 0)
-		return true;
-	if (std::strncmp(_data + 3, "FWU", 3) == 0)
-		return true;
-	if (std::strncmp(_data + 3, "CMD", 3) == 0)
-		return true;
-	if (std::strncmp(_data + 3, "ASY", 3) == 0)
-		return true;
-	if (std::strncmp(_data + 3, "TAR", 3) == 0)
-		return true;
-	if (std::strncmp(_data + 3, "KMD", 3) == 0)
-		return true;
-	if (std::strncmp(_data + 3, "KAD", 3) == 0)
-		return true;
-	if (std::strncmp(_data + 3, "SGB", 3) == 0)
-		return true;
+	_kind = KIND_OTHER;
+	_asciiAsyncType = VNOFF;
 
-	return false;
-}
+	// Binary packets and anything too short to have a header are never
+	// errors, responses or ASCII asynchronous messages.
+	if (_length < 6 || _data[0] != '$')
+		return;
 
-bool Packet::isAsciiAsync()
-{
-	// Pointer to the unique asynchronous data type identifier.
-	char* pAT = _data + 3;
+	switch (ASCII_HEADER(_data[3], _data[4], _data[5]))
+	{
+	case ASCII_HEADER('E', 'R', 'R'):
+		_kind = KIND_ERROR;
+		return;
 
-	if (strncmp(pAT, "YPR", 3) == 0)
-		return true;
-	if (strncmp(pAT, "QTN", 3) == 0)
-		return true;
+	case ASCII_HEADER('W', 'R', 'G'):
+	case ASCII_HEADER('R', 'R', 'G'):
+	case ASCII_HEADER('W', 'N', 'V'):
+	case ASCII_HEADER('R', 'F', 'S'):
+	case ASCII_HEADER('R', 'S', 'T'):
+	case ASCII_HEADER('F', 'W', 'U'):
+	case ASCII_HEADER('C', 'M', 'D'):
+	case ASCII_HEADER('A', 'S', 'Y'):
+	case ASCII_HEADER('T', 'A', 'R'):
+	case ASCII_HEADER('K', 'M', 'D'):
+	case ASCII_HEADER('K', 'A', 'D'):
+	case ASCII_HEADER('S', 'G', 'B'):
+		_kind = KIND_RESPONSE;
+		return;
+
+	case ASCII_HEADER('Y', 'P', 'R'): _asciiAsyncType = VNYPR; break;
+	case ASCII_HEADER('Q', 'T', 'N'): _asciiAsyncType = VNQTN; break;
 	#ifdef INTERNAL
-	if (strncmp(pAT, "QTM", 3) == 0)
-		return true;
-	if (strncmp(pAT, "QTA", 3) == 0)
-		return true;
-	if (strncmp(pAT, "QTR", 3) == 0)
-		return true;
-	if (strncmp(pAT, "QMA", 3) == 0)
-		return true;
-	if (strncmp(pAT, "QAR", 3) == 0)
-		return true;
+	case ASCII_HEADER('Q', 'T', 'M'): _asciiAsyncType = VNQTM; break;
+	case ASCII_HEADER('Q', 'T', 'A'): _asciiAsyncType = VNQTA; break;
+	case ASCII_HEADER('Q', 'T', 'R'): _asciiAsyncType = VNQTR; break;
+	case ASCII_HEADER('Q', 'M', 'A'): _asciiAsyncType = VNQMA; break;
+	case ASCII_HEADER('Q', 'A', 'R'): _asciiAsyncType = VNQAR; break;
 	#endif
-	if (strncmp(pAT, "QMR", 3) == 0)
-		return true;
+	case ASCII_HEADER('Q', 'M', 'R'): _asciiAsyncType = VNQMR; break;
 	#ifdef INTERNAL
-	if (strncmp(pAT, "DCM", 3) == 0)
-		return true;
+	case ASCII_HEADER('D', 'C', 'M'): _asciiAsyncType = VNDCM; break;
 	#endif
-	if (strncmp(pAT, "MAG", 3) == 0)
-		return true;
-	if (strncmp(pAT, "ACC", 3) == 0)
-		return true;
-	if (strncmp(pAT, "GYR", 3) == 0)
-		return true;
-	if (strncmp(pAT, "MAR", 3) == 0)
-		return true;
-	if (strncmp(pAT, "YMR", 3) == 0)
-		return true;
+	case ASCII_HEADER('M', 'A', 'G'): _asciiAsyncType = VNMAG; break;
+	case ASCII_HEADER('A', 'C', 'C'): _asciiAsyncType = VNACC; break;
+	case ASCII_HEADER('G', 'Y', 'R'): _asciiAsyncType = VNGYR; break;
+	case ASCII_HEADER('M', 'A', 'R'): _asciiAsyncType = VNMAR; break;
+	case ASCII_HEADER('Y', 'M', 'R'): _asciiAsyncType = VNYMR; break;
 	#ifdef INTERNAL
-	if (strncmp(pAT, "YCM", 3) == 0)
-		return true;
+	case ASCII_HEADER('Y', 'C', 'M'): _asciiAsyncType = VNYCM; break;
 	#endif
-	if (strncmp(pAT, "YBA", 3) == 0)
-		return true;
-	if (strncmp(pAT, "YIA", 3) == 0)
-		return true;
+	case ASCII_HEADER('Y', 'B', 'A'): _asciiAsyncType = VNYBA; break;
+	case ASCII_HEADER('Y', 'I', 'A'): _asciiAsyncType = VNYIA; break;
 	#ifdef INTERNAL
-	if (strncmp(pAT, "ICM", 3) == 0)
-		return true;
-	#endif
-	if (strncmp(pAT, "IMU", 3) == 0)
-		return true;
-	if (strncmp(pAT, "GPS", 3) == 0)
-		return true;
-	if (strncmp(pAT, "GPE", 3) == 0)
-		return true;
-	if (strncmp(pAT, "INS", 3) == 0)
-		return true;
-	if (strncmp(pAT, "INE", 3) == 0)
-		return true;
-	if (strncmp(pAT, "ISL", 3) == 0)
-		return true;
-	if (strncmp(pAT, "ISE", 3) == 0)
-		return true;
-	if (strncmp(pAT, "DTV", 3) == 0)
-		return true;
-  if(strncmp(pAT, "G2S", 3) == 0)
-    return true;
-  if(strncmp(pAT, "G2E", 3) == 0)
-    return true;
-#ifdef INTERNAL
-	if (strncmp(pAT, "RAW", 3) == 0)
-		return true;
-	if (strncmp(pAT, "CMV", 3) == 0)
-		return true;
-	if (strncmp(pAT, "STV", 3) == 0)
-		return true;
-	if (strncmp(pAT, "COV", 3) == 0)
-		return true;
+	case ASCII_HEADER('I', 'C', 'M'): _asciiAsyncType = VNICM; break;
+	#endif
+	case ASCII_HEADER('I', 'M', 'U'): _asciiAsyncType = VNIMU; break;
+	case ASCII_HEADER('G', 'P', 'S'): _asciiAsyncType = VNGPS; break;
+	case ASCII_HEADER('G', 'P', 'E'): _asciiAsyncType = VNGPE; break;
+	case ASCII_HEADER('I', 'N', 'S'): _asciiAsyncType = VNINS; break;
+	case ASCII_HEADER('I', 'N', 'E'): _asciiAsyncType = VNINE; break;
+	case ASCII_HEADER('I', 'S', 'L'): _asciiAsyncType = VNISL; break;
+	case ASCII_HEADER('I', 'S', 'E'): _asciiAsyncType = VNISE; break;
+	case ASCII_HEADER('D', 'T', 'V'): _asciiAsyncType = VNDTV; break;
+	case ASCII_HEADER('G', '2', 'S'): _asciiAsyncType = VNG2S; break;
+	case ASCII_HEADER('G', '2', 'E'): _asciiAsyncType = VNG2E; break;
+	#ifdef INTERNAL
+	case ASCII_HEADER('R', 'A', 'W'): _asciiAsyncType = VNRAW; break;
+	case ASCII_HEADER('C', 'M', 'V'): _asciiAsyncType = VNCMV; break;
+	case ASCII_HEADER('S', 'T', 'V'): _asciiAsyncType = VNSTV; break;
+	case ASCII_HEADER('C', 'O', 'V'): _asciiAsyncType = VNCOV; break;
 	#endif
-	else
-		return false;
+
+	default:
+		return;
+	}
+
+	_kind = KIND_ASCII_ASYNC;
+}
+
+bool Packet::isError()
+{
+	if (_kind == KIND_UNCLASSIFIED)
+		classify();
+
+	return _kind == KIND_ERROR;
+}
+
+bool Packet::isResponse()
+{
+	if (_kind == KIND_UNCLASSIFIED)
+		classify();
+
+	return _kind == KIND_RESPONSE;
+}
+
+bool Packet::isAsciiAsync()
+{
+	if (_kind == KIND_UNCLASSIFIED)
+		classify();
+
+	return _kind == KIND_ASCII_ASYNC;
 }
 
 AsciiAsync Packet::determineAsciiAsyncType()
 {
-	// Pointer to the unique asynchronous data type identifier.
-	char* pAT = _data + 3;
+	if (_kind == KIND_UNCLASSIFIED)
+		classify();
 
-	if (strncmp(pAT, "YPR", 3) == 0)
-		return VNYPR;
-	if (strncmp(pAT, "QTN", 3) == 0)
-		return VNQTN;
-	#ifdef INTERNAL
-	if (strncmp(pAT, "QTM", 3) == 0)
-		return VNQTM;
-	if (strncmp(pAT, "QTA", 3) == 0)
-		return VNQTA;
-	if (strncmp(pAT, "QTR", 3) == 0)
-		return VNQTR;
-	if (strncmp(pAT, "QMA", 3) == 0)
-		return VNQMA;
-	if (strncmp(pAT, "QAR", 3) == 0)
-		return VNQAR;
-	#endif
-	if (strncmp(pAT, "QMR", 3) == 0)
-		return VNQMR;
-	#ifdef INTERNAL
-	if (strncmp(pAT, "DCM", 3) == 0)
-		return VNDCM;
-	#endif
-	if (strncmp(pAT, "MAG", 3) == 0)
-		return VNMAG;
-	if (strncmp(pAT, "ACC", 3) == 0)
-		return VNACC;
-	if (strncmp(pAT, "GYR", 3) == 0)
-		return VNGYR;
-	if (strncmp(pAT, "MAR", 3) == 0)
-		return VNMAR;
-	if (strncmp(pAT, "YMR", 3) == 0)
-		return VNYMR;
-	#ifdef INTERNAL
-	if (strncmp(pAT, "YCM", 3) == 0)
-		return VNYCM;
-	#endif
-	if (strncmp(pAT, "YBA", 3) == 0)
-		return VNYBA;
-	if (strncmp(pAT, "YIA", 3) == 0)
-		return VNYIA;
-	#ifdef INTERNAL
-	if (strncmp(pAT, "ICM", 3) == 0)
-		return VNICM;
-	#endif
-	if (strncmp(pAT, "IMU", 3) == 0)
-		return VNIMU;
-	if (strncmp(pAT, "GPS", 3) == 0)
-		return VNGPS;
-	if (strncmp(pAT, "GPE", 3) == 0)
-		return VNGPE;
-	if (strncmp(pAT, "INS", 3) == 0)
-		return VNINS;
-	if (strncmp(pAT, "INE", 3) == 0)
-		return VNINE;
-	if (strncmp(pAT, "ISL", 3) == 0)
-		return VNISL;
-	if (strncmp(pAT, "ISE", 3) == 0)
-		return VNISE;
-	if (strncmp(pAT, "DTV", 3) == 0)
-		return VNDTV;
-  if(strncmp(pAT, "G2S", 3) == 0)
-    return VNG2S;
-  if(strncmp(pAT, "G2E", 3) == 0)
-    return VNG2E;
-#ifdef INTERNAL
-	if (strncmp(pAT, "RAW", 3) == 0)
-		return VNRAW;
-	if (strncmp(pAT, "CMV", 3) == 0)
-		return VNCMV;
-	if (strncmp(pAT, "STV", 3) == 0)
-		return VNSTV;
-	if (strncmp(pAT, "COV", 3) == 0)
-		return VNCOV;
-	#endif
-	else
+	if (_kind != KIND_ASCII_ASYNC)
 		throw unknown_error();
+
+	return static_cast<AsciiAsync>(_asciiAsyncType);
 }
 
 bool Packet::isCompatible(CommonGroup commonGroup, TimeGroup timeGroup, ImuGroup imuGroup, GpsGroup gpsGroup, AttitudeGroup attitudeGroup, InsGroup insGroup, GpsGroup gps2Group)
@@ -498,73 +477,356 @@ bool Packet::isCompatible(CommonGroup commonGroup, TimeGroup timeGroup, ImuGroup
 
 }
 
-char* startAsciiPacketParse(char* packetStart, size_t& index)
+// The fields of an ASCII packet are read in place with a cursor that is
+// advanced past each value as it is converted, so the packet is only scanned
+// once and is never modified. The conversions do not depend on the current
+// locale.
+
+const char* startAsciiPacketParse(const char* packetStart)
+{
+	// Skip over the '$VNXXX,' header.
+	return packetStart + 7;
+}
+
+bool nextAsciiField(const char*& cur)
 {
-	index = 7;
+	// Skip anything left in the current field.
+	while (*cur != ',' && *cur != '*')
+	{
+		if ((*cur < ' ') || (*cur > '~') || (*cur == '$')) // check for garbage characters
+			return false;
+
+		cur++;
+	}
 
-	return vnstrtok(packetStart, index);
+	if (*cur == '*') // attempting to read too many fields
+		return false;
+
+	cur++;
+
+	return true;
 }
 
-char* getNextData(char* str, size_t& startIndex)
+size_t asciiFieldLength(const char* field)
 {
-	return vnstrtok(str, startIndex);
+	const char* end = field;
+
+	while (*end != ',' && *end != '*' && *end >= ' ' && *end <= '~' && *end != '$')
+		end++;
+
+	return end - field;
+}
+
+// Returns true if the text starting at p is the word, ignoring case.
+bool isAsciiWord(const char* p, const char* word)
+{
+	for (; *word != '\0'; p++, word++)
+	{
+		if ((*p | 0x20) != *word)
+			return false;
+	}
+
+	return true;
 }
 
-char* vnstrtok(char* str, size_t& startIndex)
+double scanAsciiDoubleWithStream(const char*& cur)
 {
-	size_t origIndex = startIndex;
+	// Converts the field with the classic locale, so the decimal point is
+	// always '.' whatever locale the application has set, and the value is
+	// rounded the same way strtod rounds it.
+	size_t length = asciiFieldLength(cur);
+
+	const char* p = cur;
+
+	while (*p == ' ')
+		p++;
+
+	bool isNegative = *p == '-';
+
+	if (*p == '+' || *p == '-')
+		p++;
+
+	if (isAsciiWord(p, "nan"))
+	{
+		cur = p + 3;
+		return std::numeric_limits<double>::quiet_NaN();
+	}
+
+	if (isAsciiWord(p, "inf"))
+	{
+		cur = p + 3;
+		return isNegative ? -std::numeric_limits<double>::infinity() : std::numeric_limits<double>::infinity();
+	}
+
+	std::istringstream in(std::string(cur, length));
+	in.imbue(std::locale::classic());
 
-	if (str[startIndex-1] == '*') // attempting to read too many fields
-		return NULL;
-		
-	while (str[startIndex] != ',' && str[startIndex] != '*')
+	double value = 0;
+	in >> value;
+
+	if (in.fail())
 	{
-		if((str[startIndex] < ' ') || (str[startIndex] > '~') || (str[startIndex] == '$')) // check for garbage characters
-			return NULL;
-		startIndex++;
+		// Values too large for a double are reported as the largest one.
+		if (value == std::numeric_limits<double>::max() || value == -std::numeric_limits<double>::max())
+		{
+			cur += length;
+			return value < 0 ? -std::numeric_limits<double>::infinity() : std::numeric_limits<double>::infinity();
+		}
+
+		return 0;
 	}
-	
-	str[startIndex++] = '\0';
 
-	return str + origIndex;
+	cur += in.eof() ? length : static_cast<size_t>(in.tellg());
+
+	return value;
 }
 
-void Packet::ensureCanExtract(size_t numOfBytes)
+double scanAsciiDouble(const char*& cur)
+{
+	// Powers of ten that are exactly representable as a double.
+	static const double ExactPowersOfTen[] = {
+		1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+		1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+	// Integers with up to this many digits are exactly representable as a
+	// double.
+	static const int MaximumExactDigits = 15;
+
+	const char* p = cur;
+	bool isNegative = false;
+
+	if (*p == '+' || *p == '-')
+	{
+		isNegative = *p == '-';
+		p++;
+	}
+
+	uint64_t mantissa = 0;
+	int numOfDigits = 0;
+	int exponent = 0;
+	bool hasDigits = false;
+
+	for (; *p >= '0' && *p <= '9'; p++)
+	{
+		hasDigits = true;
+
+		if (mantissa == 0 && *p == '0')
+			continue;
+
+		if (numOfDigits < MaximumExactDigits)
+			mantissa = mantissa * 10 + (*p - '0');
+		else
+			exponent++;
+
+		numOfDigits++;
+	}
+
+	if (*p == '.')
+	{
+		for (p++; *p >= '0' && *p <= '9'; p++)
+		{
+			hasDigits = true;
+
+			if (mantissa == 0 && *p == '0')
+			{
+				exponent--;
+				continue;
+			}
+
+			if (numOfDigits < MaximumExactDigits)
+			{
+				mantissa = mantissa * 10 + (*p - '0');
+				exponent--;
+			}
+
+			numOfDigits++;
+		}
+	}
+
+	if (!hasDigits)
+		// Leave anything unusual like leading spaces or NaN to the stream.
+		return scanAsciiDoubleWithStream(cur);
+
+	if (*p == 'e' || *p == 'E')
+	{
+		const char* e = p + 1;
+		bool isExponentNegative = false;
+
+		if (*e == '+' || *e == '-')
+		{
+			isExponentNegative = *e == '-';
+			e++;
+		}
+
+		if (*e >= '0' && *e <= '9')
+		{
+			int explicitExponent = 0;
+
+			for (; *e >= '0' && *e <= '9'; e++)
+			{
+				if (explicitExponent < 10000)
+					explicitExponent = explicitExponent * 10 + (*e - '0');
+			}
+
+			exponent += isExponentNegative ? -explicitExponent : explicitExponent;
+			p = e;
+		}
+	}
+
+	// When the mantissa and power of ten are both exact, a single
+	// multiplication or division gives the correctly rounded result.
+	// Otherwise digits were dropped, or the field holds something we do not
+	// handle, and a correctly rounding conversion is needed.
+	if (numOfDigits > MaximumExactDigits || exponent < -22 || exponent > 22
+		|| (*p != ',' && *p != '*'))
+		return scanAsciiDoubleWithStream(cur);
+
+	double value = static_cast<double>(mantissa);
+
+	if (exponent < 0)
+		value /= ExactPowersOfTen[-exponent];
+	else
+		value *= ExactPowersOfTen[exponent];
+
+	cur = p;
+
+	return isNegative ? -value : value;
+}
+
+int64_t scanAsciiInt(const char*& cur)
+{
+	const char* p = cur;
+
+	while (*p == ' ')
+		p++;
+
+	bool isNegative = false;
+
+	if (*p == '+' || *p == '-')
+	{
+		isNegative = *p == '-';
+		p++;
+	}
+
+	uint64_t value = 0;
+
+	for (; *p >= '0' && *p <= '9'; p++)
+		value = value * 10 + (*p - '0');
+
+	cur = p;
+
+	return isNegative ? -static_cast<int64_t>(value) : static_cast<int64_t>(value);
+}
+
+uint64_t scanAsciiHex(const char*& cur)
+{
+	const char* p = cur;
+
+	while (*p == ' ')
+		p++;
+
+	bool isNegative = false;
+
+	if (*p == '+' || *p == '-')
+	{
+		isNegative = *p == '-';
+		p++;
+	}
+
+	if (p[0] == '0' && (p[1] == 'x' || p[1] == 'X'))
+		p += 2;
+
+	uint64_t value = 0;
+
+	for (;; p++)
+	{
+		if (*p >= '0' && *p <= '9')
+			value = (value << 4) | (*p - '0');
+		else if (*p >= 'a' && *p <= 'f')
+			value = (value << 4) | (*p - 'a' + 10);
+		else if (*p >= 'A' && *p <= 'F')
+			value = (value << 4) | (*p - 'A' + 10);
+		else
+			break;
+	}
+
+	cur = p;
+
+	return isNegative ? (~value + 1) : value;
+}
+
+void copyAsciiField(const char* field, char* to)
+{
+	size_t length = asciiFieldLength(field);
+
+	memcpy(to, field, length);
+	to[length] = '\0';
+}
+
+bool Packet::canExtract(size_t numOfBytes)
 {
 	if (_curExtractLoc == 0)
 		// Determine the location to start extracting.
 		_curExtractLoc = countSetBits(_data[1]) * 2 + 2;
 
-	if (_curExtractLoc + numOfBytes > _length - 2)
-		// About to overrun data.
+	// Make sure we will not overrun the data.
+	return _curExtractLoc + numOfBytes <= _length - 2;
+}
+
+void Packet::ensureCanExtract(size_t numOfBytes)
+{
+	if (!canExtract(numOfBytes))
 		throw invalid_operation();
 }
 
-uint8_t Packet::extractUint8()
+bool Packet::tryExtractUint8(uint8_t& value)
 {
-	ensureCanExtract(sizeof(uint8_t));
+	if (!canExtract(sizeof(uint8_t)))
+		return false;
 
-	uint8_t d = *reinterpret_cast<uint8_t*>(_data + _curExtractLoc);
+	value = *reinterpret_cast<uint8_t*>(_data + _curExtractLoc);
 
 	_curExtractLoc += sizeof(uint8_t);
 
-	return d;
+	return true;
 }
 
-int8_t Packet::extractInt8()
+uint8_t Packet::extractUint8()
+{
+	uint8_t value;
+
+	if (!tryExtractUint8(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+bool Packet::tryExtractInt8(int8_t& value)
 {
-	ensureCanExtract(sizeof(int8_t));
+	if (!canExtract(sizeof(int8_t)))
+		return false;
 
-	int8_t d = *reinterpret_cast<int8_t*>(_data + _curExtractLoc);
+	value = *reinterpret_cast<int8_t*>(_data + _curExtractLoc);
 
 	_curExtractLoc += sizeof(int8_t);
 
-	return d;
+	return true;
 }
 
-uint16_t Packet::extractUint16()
+int8_t Packet::extractInt8()
 {
-	ensureCanExtract(sizeof(uint16_t));
+	int8_t value;
+
+	if (!tryExtractInt8(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+bool Packet::tryExtractUint16(uint16_t& value)
+{
+	if (!canExtract(sizeof(uint16_t)))
+		return false;
 
 	uint16_t d;
 
@@ -572,12 +834,25 @@ uint16_t Packet::extractUint16()
 
 	_curExtractLoc += sizeof(uint16_t);
 
-	return stoh(d);
+	value = stoh(d);
+
+	return true;
 }
 
-uint32_t Packet::extractUint32()
+uint16_t Packet::extractUint16()
 {
-	ensureCanExtract(sizeof(uint32_t));
+	uint16_t value;
+
+	if (!tryExtractUint16(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+bool Packet::tryExtractUint32(uint32_t& value)
+{
+	if (!canExtract(sizeof(uint32_t)))
+		return false;
 
 	uint32_t d;
 
@@ -585,12 +860,25 @@ uint32_t Packet::extractUint32()
 
 	_curExtractLoc += sizeof(uint32_t);
 
-	return stoh(d);
+	value = stoh(d);
+
+	return true;
 }
 
-uint64_t Packet::extractUint64()
+uint32_t Packet::extractUint32()
+{
+	uint32_t value;
+
+	if (!tryExtractUint32(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+bool Packet::tryExtractUint64(uint64_t& value)
 {
-	ensureCanExtract(sizeof(uint64_t));
+	if (!canExtract(sizeof(uint64_t)))
+		return false;
 
 	uint64_t d;
 
@@ -598,148 +886,174 @@ uint64_t Packet::extractUint64()
 
 	_curExtractLoc += sizeof(uint64_t);
 
-	return stoh(d);
+	value = stoh(d);
+
+	return true;
 }
 
-float Packet::extractFloat()
+uint64_t Packet::extractUint64()
 {
-	ensureCanExtract(sizeof(float));
+	uint64_t value;
+
+	if (!tryExtractUint64(value))
+		throw invalid_operation();
+
+	return value;
+}
 
-	float f;
+bool Packet::tryExtractFloat(float& value)
+{
+	if (!canExtract(sizeof(float)))
+		return false;
 
-	memcpy(&f, _data + _curExtractLoc, sizeof(float));
+	memcpy(&value, _data + _curExtractLoc, sizeof(float));
 
 	_curExtractLoc += sizeof(float);
 
-	return f;
+	return true;
 }
 
-vec3f Packet::extractVec3f()
+float Packet::extractFloat()
 {
-	ensureCanExtract(3 * sizeof(float));
+	float value;
+
+	if (!tryExtractFloat(value))
+		throw invalid_operation();
+
+	return value;
+}
 
-	vec3f d;
+bool Packet::tryExtractVec3f(vec3f& value)
+{
+	if (!canExtract(3 * sizeof(float)))
+		return false;
 
-	memcpy(&d.x, _data + _curExtractLoc, sizeof(float));
-	memcpy(&d.y, _data + _curExtractLoc + sizeof(float), sizeof(float));
-	memcpy(&d.z, _data + _curExtractLoc + 2 * sizeof(float), sizeof(float));
+	memcpy(&value.x, _data + _curExtractLoc, sizeof(float));
+	memcpy(&value.y, _data + _curExtractLoc + sizeof(float), sizeof(float));
+	memcpy(&value.z, _data + _curExtractLoc + 2 * sizeof(float), sizeof(float));
 
 	_curExtractLoc += 3 * sizeof(float);
 
-	return d;
+	return true;
 }
 
-vec3d Packet::extractVec3d()
+vec3f Packet::extractVec3f()
 {
-	ensureCanExtract(3 * sizeof(double));
+	vec3f value;
 
-	vec3d d;
+	if (!tryExtractVec3f(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+bool Packet::tryExtractVec3d(vec3d& value)
+{
+	if (!canExtract(3 * sizeof(double)))
+		return false;
 
-	memcpy(&d.x, _data + _curExtractLoc, sizeof(double));
-	memcpy(&d.y, _data + _curExtractLoc + sizeof(double), sizeof(double));
-	memcpy(&d.z, _data + _curExtractLoc + 2 * sizeof(double), sizeof(double));
+	memcpy(&value.x, _data + _curExtractLoc, sizeof(double));
+	memcpy(&value.y, _data + _curExtractLoc + sizeof(double), sizeof(double));
+	memcpy(&value.z, _data + _curExtractLoc + 2 * sizeof(double), sizeof(double));
 
 	_curExtractLoc += 3 * sizeof(double);
 
-	return d;
+	return true;
 }
 
-vec4f Packet::extractVec4f()
+vec3d Packet::extractVec3d()
 {
-	ensureCanExtract(4 * sizeof(float));
+	vec3d value;
+
+	if (!tryExtractVec3d(value))
+		throw invalid_operation();
+
+	return value;
+}
 
-	vec4f d;
+bool Packet::tryExtractVec4f(vec4f& value)
+{
+	if (!canExtract(4 * sizeof(float)))
+		return false;
 
-	memcpy(&d.x, _data + _curExtractLoc, sizeof(float));
-	memcpy(&d.y, _data + _curExtractLoc + sizeof(float), sizeof(float));
-	memcpy(&d.z, _data + _curExtractLoc + 2 * sizeof(float), sizeof(float));
-	memcpy(&d.w, _data + _curExtractLoc + 3 * sizeof(float), sizeof(float));
+	memcpy(&value.x, _data + _curExtractLoc, sizeof(float));
+	memcpy(&value.y, _data + _curExtractLoc + sizeof(float), sizeof(float));
+	memcpy(&value.z, _data + _curExtractLoc + 2 * sizeof(float), sizeof(float));
+	memcpy(&value.w, _data + _curExtractLoc + 3 * sizeof(float), sizeof(float));
 
 	_curExtractLoc += 4 * sizeof(float);
 
-	return d;
+	return true;
+}
+
+vec4f Packet::extractVec4f()
+{
+	vec4f value;
+
+	if (!tryExtractVec4f(value))
+		throw invalid_operation();
+
+	return value;
+}
+
+bool Packet::tryExtractMat3f(mat3f& value)
+{
+	if (!canExtract(9 * sizeof(float)))
+		return false;
+
+	memcpy(&value.e00, _data + _curExtractLoc, sizeof(float));
+	memcpy(&value.e10, _data + _curExtractLoc + sizeof(float), sizeof(float));
+	memcpy(&value.e20, _data + _curExtractLoc + 2 * sizeof(float), sizeof(float));
+	memcpy(&value.e01, _data + _curExtractLoc + 3 * sizeof(float), sizeof(float));
+	memcpy(&value.e11, _data + _curExtractLoc + 4 * sizeof(float), sizeof(float));
+	memcpy(&value.e21, _data + _curExtractLoc + 5 * sizeof(float), sizeof(float));
+	memcpy(&value.e02, _data + _curExtractLoc + 6 * sizeof(float), sizeof(float));
+	memcpy(&value.e12, _data + _curExtractLoc + 7 * sizeof(float), sizeof(float));
+	memcpy(&value.e22, _data + _curExtractLoc + 8 * sizeof(float), sizeof(float));
+
+	_curExtractLoc += 9 * sizeof(float);
+
+	return true;
 }
 
 mat3f Packet::extractMat3f()
 {
-	ensureCanExtract(9 * sizeof(float));
-
-	mat3f m;
-
-	memcpy(&m.e00, _data + _curExtractLoc, sizeof(float));
-	memcpy(&m.e10, _data + _curExtractLoc + sizeof(float), sizeof(float));
-	memcpy(&m.e20, _data + _curExtractLoc + 2 * sizeof(float), sizeof(float));
-	memcpy(&m.e01, _data + _curExtractLoc + 3 * sizeof(float), sizeof(float));
-	memcpy(&m.e11, _data + _curExtractLoc + 4 * sizeof(float), sizeof(float));
-	memcpy(&m.e21, _data + _curExtractLoc + 5 * sizeof(float), sizeof(float));
-	memcpy(&m.e02, _data + _curExtractLoc + 6 * sizeof(float), sizeof(float));
-	memcpy(&m.e12, _data + _curExtractLoc + 7 * sizeof(float), sizeof(float));
-	memcpy(&m.e22, _data + _curExtractLoc + 8 * sizeof(float), sizeof(float));
+	mat3f value;
 
-	_curExtractLoc += 9 * sizeof(float);
+	if (!tryExtractMat3f(value))
+		throw invalid_operation();
 
-	return m;
+	return value;
 }
 
 size_t Packet::finalizeCommand(ErrorDetectionMode errorDetectionMode, char *packet, size_t length)
 {
-	#if defined(_MSC_VER)
-		// Unable to use save version 'sprintf_s' since the length of 'packet' is unknown here.
-		#pragma warning(push)
-		#pragma warning(disable:4996)
-	#endif
-
-	if (errorDetectionMode == ERRORDETECTIONMODE_CHECKSUM)
-	{
-		length += sprintf(packet + length, "*%02X\r\n", Checksum8::compute(packet + 1, length - 1));
-	}
-	else if (errorDetectionMode == ERRORDETECTIONMODE_CRC)
-	{
-		length += sprintf(packet + length, "*%04X\r\n", Crc16::compute(packet + 1, length - 1));
-	}
-	else
-	{
-		length += sprintf(packet + length, "*XX\r\n");
-	}
-
-	#if defined(_MSC_VER)
-		#pragma warning(pop)
-	#endif
+	packet[length] = '*';
+	length += 1 + CommandEncoder::writeErrorDetectionCode(errorDetectionMode, packet + 1, length - 1, packet + length + 1);
+	packet[length] = '\0';
 
 	return length;
 }
 
 size_t Packet::genReadBinaryOutput1(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,75");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,75");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,75");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadBinaryOutput2(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,76");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,76");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,76");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadBinaryOutput3(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,77");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,77");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,77");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 
@@ -762,56 +1076,28 @@ size_t writeBinaryOutput(ErrorDetectionMode errorDetectionMode, char* buffer, si
   if(gps2Field)
     groups |= 0x0040;
 
-	#if VN_HAVE_SECURE_CRT
-	int length = sprintf_s(buffer, size, "$VNWRG,%u,%u,%u,%X", 74 + binaryOutputNumber, asyncMode, rateDivisor, groups);
-	#else
-	int length = sprintf(buffer, "$VNWRG,%u,%u,%u,%X", 74 + binaryOutputNumber, asyncMode, rateDivisor, groups);
-	#endif
+	CommandEncoder command(buffer, size, "$VNWRG");
+	command.unsignedField(74 + binaryOutputNumber);
+	command.unsignedField(asyncMode);
+	command.unsignedField(rateDivisor);
+	command.hexField(groups);
 
 	if (commonField)
-		#if VN_HAVE_SECURE_CRT
-		length += sprintf_s(buffer + length, size - length, ",%X", commonField);
-		#else
-		length += sprintf(buffer + length, ",%X", commonField);
-		#endif
+		command.hexField(commonField);
 	if (timeField)
-		#if VN_HAVE_SECURE_CRT
-		length += sprintf_s(buffer + length, size - length, ",%X", timeField);
-		#else
-		length += sprintf(buffer + length, ",%X", timeField);
-		#endif
+		command.hexField(timeField);
 	if (imuField)
-		#if VN_HAVE_SECURE_CRT
-		length += sprintf_s(buffer + length, size - length, ",%X", imuField);
-		#else
-		length += sprintf(buffer + length, ",%X", imuField);
-		#endif
+		command.hexField(imuField);
 	if (gpsField)
-		#if VN_HAVE_SECURE_CRT
-		length += sprintf_s(buffer + length, size - length, ",%X", gpsField);
-		#else
-		length += sprintf(buffer + length, ",%X", gpsField);
-		#endif
+		command.hexField(gpsField);
 	if (attitudeField)
-		#if VN_HAVE_SECURE_CRT
-		length += sprintf_s(buffer + length, size - length, ",%X", attitudeField);
-		#else
-		length += sprintf(buffer + length, ",%X", attitudeField);
-		#endif
+		command.hexField(attitudeField);
 	if (insField)
-		#if VN_HAVE_SECURE_CRT
-		length += sprintf_s(buffer + length, size - length, ",%X", insField);
-		#else
-		length += sprintf(buffer + length, ",%X", insField);
-		#endif
-  if(gps2Field)
-  #if VN_HAVE_SECURE_CRT
-  length += sprintf_s(buffer + length, size - length, ",%X", gps2Field);
-  #else
-  length += sprintf(buffer + length, ",%X", gps2Field);
-  #endif
+		command.hexField(insField);
+	if (gps2Field)
+		command.hexField(gps2Field);
 
-	return Packet::finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genWriteBinaryOutput1(ErrorDetectionMode errorDetectionMode, char* buffer, size_t size, uint16_t asyncMode, uint16_t rateDivisor, uint16_t commonField, uint16_t timeField, uint16_t imuField, uint16_t gpsField, uint16_t attitudeField, uint16_t insField, uint16_t gps2Field)
@@ -832,1469 +1118,1014 @@ size_t Packet::genWriteBinaryOutput3(ErrorDetectionMode errorDetectionMode, char
 
 size_t Packet::genWriteSettings(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNWNV");
-	#else
-	size_t length = sprintf(buffer, "$VNWNV");
-	#endif
+	CommandEncoder command(buffer, size, "$VNWNV");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genTare(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNTAR");
-	#else
-	size_t length = sprintf(buffer, "$VNTAR");
-	#endif
+	CommandEncoder command(buffer, size, "$VNTAR");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genKnownMagneticDisturbance(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size, bool isMagneticDisturbancePresent)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNKMD,%d", isMagneticDisturbancePresent ? 1 : 0);
-	#else
-	size_t length = sprintf(buffer, "$VNKMD,%d", isMagneticDisturbancePresent ? 1 : 0);
-	#endif
+	CommandEncoder command(buffer, size, "$VNKMD");
+	command.signedField(isMagneticDisturbancePresent ? 1 : 0);
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genKnownAccelerationDisturbance(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size, bool isAccelerationDisturbancePresent)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNKAD,%d", isAccelerationDisturbancePresent ? 1 : 0);
-	#else
-	size_t length = sprintf(buffer, "$VNKAD,%d", isAccelerationDisturbancePresent ? 1 : 0);
-	#endif
+	CommandEncoder command(buffer, size, "$VNKAD");
+	command.signedField(isAccelerationDisturbancePresent ? 1 : 0);
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genSetGyroBias(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNSGB");
-	#else
-	size_t length = sprintf(buffer, "$VNSGB");
-	#endif
+	CommandEncoder command(buffer, size, "$VNSGB");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genRestoreFactorySettings(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRFS");
-	#else
-	size_t length = sprintf(buffer, "$VNRFS");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRFS");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReset(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRST");
-	#else
-	size_t length = sprintf(buffer, "$VNRST");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRST");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadSerialBaudRate(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size, uint8_t port)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,05,%u", port);
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,05,%u", port);
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,05");
+	command.unsignedField(port);
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genWriteSerialBaudRate(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size, uint32_t baudrate, uint8_t port)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNWRG,05,%u,%u", baudrate, port);
-	#else
-	size_t length = sprintf(buffer, "$VNWRG,05,%u,%u", baudrate, port);
-	#endif
+	CommandEncoder command(buffer, size, "$VNWRG,05");
+	command.unsignedField(baudrate);
+	command.unsignedField(port);
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadAsyncDataOutputType(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size, uint8_t port)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,06,%u", port);
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,06,%u", port);
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,06");
+	command.unsignedField(port);
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genWriteAsyncDataOutputType(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size, uint32_t ador, uint8_t port)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNWRG,06,%u,%u", ador, port);
-	#else
-	size_t length = sprintf(buffer, "$VNWRG,06,%u,%u", ador, port);
-	#endif
+	CommandEncoder command(buffer, size, "$VNWRG,06");
+	command.unsignedField(ador);
+	command.unsignedField(port);
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadAsyncDataOutputFrequency(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size, uint8_t port)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,07,%u", port);
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,07,%u", port);
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,07");
+	command.unsignedField(port);
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genWriteAsyncDataOutputFrequency(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size, uint32_t adof, uint8_t port)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNWRG,07,%u,%u", adof, port);
-	#else
-	size_t length = sprintf(buffer, "$VNWRG,07,%u,%u", adof, port);
-	#endif
+	CommandEncoder command(buffer, size, "$VNWRG,07");
+	command.unsignedField(adof);
+	command.unsignedField(port);
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genWriteFilterMeasurementsVarianceParameters(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size, float angularWalkVariance, vec3f angularRateVariance, vec3f magneticVariance, vec3f accelerationVariance)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNWRG,22,%E,%E,%E,%E,%f,%f,%f,%f,%f,%f",
-	#else
-	size_t length = sprintf(buffer, "$VNWRG,22,%E,%E,%E,%E,%f,%f,%f,%f,%f,%f",
-	#endif
-		angularWalkVariance,
-		angularRateVariance.x,
-		angularRateVariance.y,
-		angularRateVariance.z,
-		magneticVariance.x,
-		magneticVariance.y,
-		magneticVariance.z,
-		accelerationVariance.x,
-		accelerationVariance.y,
-		accelerationVariance.z);
+	CommandEncoder command(buffer, size, "$VNWRG,22");
+	command.scientificField(angularWalkVariance);
+	command.scientificField(angularRateVariance.x);
+	command.scientificField(angularRateVariance.y);
+	command.scientificField(angularRateVariance.z);
+	command.floatField(magneticVariance.x);
+	command.floatField(magneticVariance.y);
+	command.floatField(magneticVariance.z);
+	command.floatField(accelerationVariance.x);
+	command.floatField(accelerationVariance.y);
+	command.floatField(accelerationVariance.z);
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadUserTag(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,00");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,00");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,00");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genWriteUserTag(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size, string tag)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNWRG,00,%s"
-	#else
-	size_t length = sprintf(buffer, "$VNWRG,00,%s"
-	#endif
-,
-		tag.c_str());
+	CommandEncoder command(buffer, size, "$VNWRG,00");
+	command.textField(tag.c_str());
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadModelNumber(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,01");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,01");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,01");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadHardwareRevision(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,02");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,02");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,02");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadSerialNumber(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,03");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,03");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,03");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadFirmwareVersion(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,04");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,04");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,04");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadSerialBaudRate(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,05");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,05");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,05");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genWriteSerialBaudRate(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size, uint32_t baudrate)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNWRG,05,%u"
-	#else
-	size_t length = sprintf(buffer, "$VNWRG,05,%u"
-	#endif
-,
-		baudrate);
+	CommandEncoder command(buffer, size, "$VNWRG,05");
+	command.unsignedField(baudrate);
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadAsyncDataOutputType(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,06");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,06");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,06");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genWriteAsyncDataOutputType(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size, uint32_t ador)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNWRG,06,%u"
-	#else
-	size_t length = sprintf(buffer, "$VNWRG,06,%u"
-	#endif
-,
-		ador);
+	CommandEncoder command(buffer, size, "$VNWRG,06");
+	command.unsignedField(ador);
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadAsyncDataOutputFrequency(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,07");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,07");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,07");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genWriteAsyncDataOutputFrequency(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size, uint32_t adof)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNWRG,07,%u"
-	#else
-	size_t length = sprintf(buffer, "$VNWRG,07,%u"
-	#endif
-,
-		adof);
+	CommandEncoder command(buffer, size, "$VNWRG,07");
+	command.unsignedField(adof);
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadYawPitchRoll(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,08");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,08");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,08");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadAttitudeQuaternion(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,09");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,09");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,09");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadQuaternionMagneticAccelerationAndAngularRates(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,15");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,15");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,15");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadMagneticMeasurements(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,17");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,17");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,17");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadAccelerationMeasurements(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,18");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,18");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,18");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadAngularRateMeasurements(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,19");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,19");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,19");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadMagneticAccelerationAndAngularRates(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,20");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,20");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,20");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadMagneticAndGravityReferenceVectors(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,21");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,21");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,21");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genWriteMagneticAndGravityReferenceVectors(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size, vec3f magRef, vec3f accRef)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNWRG,21,%f,%f,%f,%f,%f,%f"
-	#else
-	size_t length = sprintf(buffer, "$VNWRG,21,%f,%f,%f,%f,%f,%f"
-	#endif
-,
-		magRef.x,
-		magRef.y,
-		magRef.z,
-		accRef.x,
-		accRef.y,
-		accRef.z);
+	CommandEncoder command(buffer, size, "$VNWRG,21");
+	command.floatField(magRef.x);
+	command.floatField(magRef.y);
+	command.floatField(magRef.z);
+	command.floatField(accRef.x);
+	command.floatField(accRef.y);
+	command.floatField(accRef.z);
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadFilterMeasurementsVarianceParameters(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,22");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,22");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,22");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadMagnetometerCompensation(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,23");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,23");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,23");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genWriteMagnetometerCompensation(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size, mat3f c, vec3f b)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNWRG,23,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f"
-	#else
-	size_t length = sprintf(buffer, "$VNWRG,23,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f"
-	#endif
-,
-		c.e00,
-		c.e01,
-		c.e02,
-		c.e10,
-		c.e11,
-		c.e12,
-		c.e20,
-		c.e21,
-		c.e22,
-		b.x,
-		b.y,
-		b.z);
-
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	CommandEncoder command(buffer, size, "$VNWRG,23");
+	command.floatField(c.e00);
+	command.floatField(c.e01);
+	command.floatField(c.e02);
+	command.floatField(c.e10);
+	command.floatField(c.e11);
+	command.floatField(c.e12);
+	command.floatField(c.e20);
+	command.floatField(c.e21);
+	command.floatField(c.e22);
+	command.floatField(b.x);
+	command.floatField(b.y);
+	command.floatField(b.z);
+
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadFilterActiveTuningParameters(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,24");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,24");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,24");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genWriteFilterActiveTuningParameters(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size, float magneticDisturbanceGain, float accelerationDisturbanceGain, float magneticDisturbanceMemory, float accelerationDisturbanceMemory)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNWRG,24,%f,%f,%f,%f"
-	#else
-	size_t length = sprintf(buffer, "$VNWRG,24,%f,%f,%f,%f"
-	#endif
-,
-		magneticDisturbanceGain,
-		accelerationDisturbanceGain,
-		magneticDisturbanceMemory,
-		accelerationDisturbanceMemory);
+	CommandEncoder command(buffer, size, "$VNWRG,24");
+	command.floatField(magneticDisturbanceGain);
+	command.floatField(accelerationDisturbanceGain);
+	command.floatField(magneticDisturbanceMemory);
+	command.floatField(accelerationDisturbanceMemory);
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadAccelerationCompensation(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,25");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,25");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,25");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genWriteAccelerationCompensation(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size, mat3f c, vec3f b)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNWRG,25,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f"
-	#else
-	size_t length = sprintf(buffer, "$VNWRG,25,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f"
-	#endif
-,
-		c.e00,
-		c.e01,
-		c.e02,
-		c.e10,
-		c.e11,
-		c.e12,
-		c.e20,
-		c.e21,
-		c.e22,
-		b.x,
-		b.y,
-		b.z);
-
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	CommandEncoder command(buffer, size, "$VNWRG,25");
+	command.floatField(c.e00);
+	command.floatField(c.e01);
+	command.floatField(c.e02);
+	command.floatField(c.e10);
+	command.floatField(c.e11);
+	command.floatField(c.e12);
+	command.floatField(c.e20);
+	command.floatField(c.e21);
+	command.floatField(c.e22);
+	command.floatField(b.x);
+	command.floatField(b.y);
+	command.floatField(b.z);
+
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadReferenceFrameRotation(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,26");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,26");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,26");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genWriteReferenceFrameRotation(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size, mat3f c)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNWRG,26,%f,%f,%f,%f,%f,%f,%f,%f,%f"
-	#else
-	size_t length = sprintf(buffer, "$VNWRG,26,%f,%f,%f,%f,%f,%f,%f,%f,%f"
-	#endif
-,
-		c.e00,
-		c.e01,
-		c.e02,
-		c.e10,
-		c.e11,
-		c.e12,
-		c.e20,
-		c.e21,
-		c.e22);
+	CommandEncoder command(buffer, size, "$VNWRG,26");
+	command.floatField(c.e00);
+	command.floatField(c.e01);
+	command.floatField(c.e02);
+	command.floatField(c.e10);
+	command.floatField(c.e11);
+	command.floatField(c.e12);
+	command.floatField(c.e20);
+	command.floatField(c.e21);
+	command.floatField(c.e22);
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadYawPitchRollMagneticAccelerationAndAngularRates(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,27");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,27");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,27");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadCommunicationProtocolControl(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,30");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,30");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,30");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genWriteCommunicationProtocolControl(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size, uint8_t serialCount, uint8_t serialStatus, uint8_t spiCount, uint8_t spiStatus, uint8_t serialChecksum, uint8_t spiChecksum, uint8_t errorMode)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNWRG,30,%u,%u,%u,%u,%u,%u,%u"
-	#else
-	size_t length = sprintf(buffer, "$VNWRG,30,%u,%u,%u,%u,%u,%u,%u"
-	#endif
-,
-		serialCount,
-		serialStatus,
-		spiCount,
-		spiStatus,
-		serialChecksum,
-		spiChecksum,
-		errorMode);
+	CommandEncoder command(buffer, size, "$VNWRG,30");
+	command.unsignedField(serialCount);
+	command.unsignedField(serialStatus);
+	command.unsignedField(spiCount);
+	command.unsignedField(spiStatus);
+	command.unsignedField(serialChecksum);
+	command.unsignedField(spiChecksum);
+	command.unsignedField(errorMode);
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadSynchronizationControl(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,32");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,32");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,32");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genWriteSynchronizationControl(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size, uint8_t syncInMode, uint8_t syncInEdge, uint16_t syncInSkipFactor, uint8_t syncOutMode, uint8_t syncOutPolarity, uint16_t syncOutSkipFactor, uint32_t syncOutPulseWidth)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNWRG,32,%u,%u,%u,0,%u,%u,%u,%u,0"
-	#else
-	size_t length = sprintf(buffer, "$VNWRG,32,%u,%u,%u,0,%u,%u,%u,%u,0"
-	#endif
-,
-		syncInMode,
-		syncInEdge,
-		syncInSkipFactor,
-		syncOutMode,
-		syncOutPolarity,
-		syncOutSkipFactor,
-		syncOutPulseWidth);
+	CommandEncoder command(buffer, size, "$VNWRG,32");
+	command.unsignedField(syncInMode);
+	command.unsignedField(syncInEdge);
+	command.unsignedField(syncInSkipFactor);
+	command.unsignedField(0);
+	command.unsignedField(syncOutMode);
+	command.unsignedField(syncOutPolarity);
+	command.unsignedField(syncOutSkipFactor);
+	command.unsignedField(syncOutPulseWidth);
+	command.unsignedField(0);
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadSynchronizationStatus(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,33");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,33");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,33");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genWriteSynchronizationStatus(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size, uint32_t syncInCount, uint32_t syncInTime, uint32_t syncOutCount)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNWRG,33,%u,%u,%u"
-	#else
-	size_t length = sprintf(buffer, "$VNWRG,33,%u,%u,%u"
-	#endif
-,
-		syncInCount,
-		syncInTime,
-		syncOutCount);
+	CommandEncoder command(buffer, size, "$VNWRG,33");
+	command.unsignedField(syncInCount);
+	command.unsignedField(syncInTime);
+	command.unsignedField(syncOutCount);
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadFilterBasicControl(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,34");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,34");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,34");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genWriteFilterBasicControl(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size, uint8_t magMode, uint8_t extMagMode, uint8_t extAccMode, uint8_t extGyroMode, vec3f gyroLimit)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNWRG,34,%u,%u,%u,%u,%f,%f,%f"
-	#else
-	size_t length = sprintf(buffer, "$VNWRG,34,%u,%u,%u,%u,%f,%f,%f"
-	#endif
-,
-		magMode,
-		extMagMode,
-		extAccMode,
-		extGyroMode,
-		gyroLimit.x,
-		gyroLimit.y,
-		gyroLimit.z);
+	CommandEncoder command(buffer, size, "$VNWRG,34");
+	command.unsignedField(magMode);
+	command.unsignedField(extMagMode);
+	command.unsignedField(extAccMode);
+	command.unsignedField(extGyroMode);
+	command.floatField(gyroLimit.x);
+	command.floatField(gyroLimit.y);
+	command.floatField(gyroLimit.z);
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadVpeBasicControl(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,35");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,35");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,35");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genWriteVpeBasicControl(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size, uint8_t enable, uint8_t headingMode, uint8_t filteringMode, uint8_t tuningMode)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNWRG,35,%u,%u,%u,%u"
-	#else
-	size_t length = sprintf(buffer, "$VNWRG,35,%u,%u,%u,%u"
-	#endif
-,
-		enable,
-		headingMode,
-		filteringMode,
-		tuningMode);
+	CommandEncoder command(buffer, size, "$VNWRG,35");
+	command.unsignedField(enable);
+	command.unsignedField(headingMode);
+	command.unsignedField(filteringMode);
+	command.unsignedField(tuningMode);
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadVpeMagnetometerBasicTuning(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,36");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,36");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,36");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genWriteVpeMagnetometerBasicTuning(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size, vec3f baseTuning, vec3f adaptiveTuning, vec3f adaptiveFiltering)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNWRG,36,%f,%f,%f,%f,%f,%f,%f,%f,%f"
-	#else
-	size_t length = sprintf(buffer, "$VNWRG,36,%f,%f,%f,%f,%f,%f,%f,%f,%f"
-	#endif
-,
-		baseTuning.x,
-		baseTuning.y,
-		baseTuning.z,
-		adaptiveTuning.x,
-		adaptiveTuning.y,
-		adaptiveTuning.z,
-		adaptiveFiltering.x,
-		adaptiveFiltering.y,
-		adaptiveFiltering.z);
+	CommandEncoder command(buffer, size, "$VNWRG,36");
+	command.floatField(baseTuning.x);
+	command.floatField(baseTuning.y);
+	command.floatField(baseTuning.z);
+	command.floatField(adaptiveTuning.x);
+	command.floatField(adaptiveTuning.y);
+	command.floatField(adaptiveTuning.z);
+	command.floatField(adaptiveFiltering.x);
+	command.floatField(adaptiveFiltering.y);
+	command.floatField(adaptiveFiltering.z);
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadVpeMagnetometerAdvancedTuning(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,37");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,37");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,37");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genWriteVpeMagnetometerAdvancedTuning(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size, vec3f minFiltering, vec3f maxFiltering, float maxAdaptRate, float disturbanceWindow, float maxTuning)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNWRG,37,%f,%f,%f,%f,%f,%f,%f,%f,%f"
-	#else
-	size_t length = sprintf(buffer, "$VNWRG,37,%f,%f,%f,%f,%f,%f,%f,%f,%f"
-	#endif
-,
-		minFiltering.x,
-		minFiltering.y,
-		minFiltering.z,
-		maxFiltering.x,
-		maxFiltering.y,
-		maxFiltering.z,
-		maxAdaptRate,
-		disturbanceWindow,
-		maxTuning);
+	CommandEncoder command(buffer, size, "$VNWRG,37");
+	command.floatField(minFiltering.x);
+	command.floatField(minFiltering.y);
+	command.floatField(minFiltering.z);
+	command.floatField(maxFiltering.x);
+	command.floatField(maxFiltering.y);
+	command.floatField(maxFiltering.z);
+	command.floatField(maxAdaptRate);
+	command.floatField(disturbanceWindow);
+	command.floatField(maxTuning);
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadVpeAccelerometerBasicTuning(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,38");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,38");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,38");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genWriteVpeAccelerometerBasicTuning(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size, vec3f baseTuning, vec3f adaptiveTuning, vec3f adaptiveFiltering)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNWRG,38,%f,%f,%f,%f,%f,%f,%f,%f,%f"
-	#else
-	size_t length = sprintf(buffer, "$VNWRG,38,%f,%f,%f,%f,%f,%f,%f,%f,%f"
-	#endif
-,
-		baseTuning.x,
-		baseTuning.y,
-		baseTuning.z,
-		adaptiveTuning.x,
-		adaptiveTuning.y,
-		adaptiveTuning.z,
-		adaptiveFiltering.x,
-		adaptiveFiltering.y,
-		adaptiveFiltering.z);
+	CommandEncoder command(buffer, size, "$VNWRG,38");
+	command.floatField(baseTuning.x);
+	command.floatField(baseTuning.y);
+	command.floatField(baseTuning.z);
+	command.floatField(adaptiveTuning.x);
+	command.floatField(adaptiveTuning.y);
+	command.floatField(adaptiveTuning.z);
+	command.floatField(adaptiveFiltering.x);
+	command.floatField(adaptiveFiltering.y);
+	command.floatField(adaptiveFiltering.z);
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadVpeAccelerometerAdvancedTuning(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,39");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,39");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,39");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genWriteVpeAccelerometerAdvancedTuning(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size, vec3f minFiltering, vec3f maxFiltering, float maxAdaptRate, float disturbanceWindow, float maxTuning)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNWRG,39,%f,%f,%f,%f,%f,%f,%f,%f,%f"
-	#else
-	size_t length = sprintf(buffer, "$VNWRG,39,%f,%f,%f,%f,%f,%f,%f,%f,%f"
-	#endif
-,
-		minFiltering.x,
-		minFiltering.y,
-		minFiltering.z,
-		maxFiltering.x,
-		maxFiltering.y,
-		maxFiltering.z,
-		maxAdaptRate,
-		disturbanceWindow,
-		maxTuning);
+	CommandEncoder command(buffer, size, "$VNWRG,39");
+	command.floatField(minFiltering.x);
+	command.floatField(minFiltering.y);
+	command.floatField(minFiltering.z);
+	command.floatField(maxFiltering.x);
+	command.floatField(maxFiltering.y);
+	command.floatField(maxFiltering.z);
+	command.floatField(maxAdaptRate);
+	command.floatField(disturbanceWindow);
+	command.floatField(maxTuning);
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadVpeGyroBasicTuning(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,40");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,40");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,40");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genWriteVpeGyroBasicTuning(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size, vec3f angularWalkVariance, vec3f baseTuning, vec3f adaptiveTuning)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNWRG,40,%f,%f,%f,%f,%f,%f,%f,%f,%f"
-	#else
-	size_t length = sprintf(buffer, "$VNWRG,40,%f,%f,%f,%f,%f,%f,%f,%f,%f"
-	#endif
-,
-		angularWalkVariance.x,
-		angularWalkVariance.y,
-		angularWalkVariance.z,
-		baseTuning.x,
-		baseTuning.y,
-		baseTuning.z,
-		adaptiveTuning.x,
-		adaptiveTuning.y,
-		adaptiveTuning.z);
+	CommandEncoder command(buffer, size, "$VNWRG,40");
+	command.floatField(angularWalkVariance.x);
+	command.floatField(angularWalkVariance.y);
+	command.floatField(angularWalkVariance.z);
+	command.floatField(baseTuning.x);
+	command.floatField(baseTuning.y);
+	command.floatField(baseTuning.z);
+	command.floatField(adaptiveTuning.x);
+	command.floatField(adaptiveTuning.y);
+	command.floatField(adaptiveTuning.z);
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadFilterStartupGyroBias(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,43");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,43");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,43");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genWriteFilterStartupGyroBias(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size, vec3f bias)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNWRG,43,%f,%f,%f"
-	#else
-	size_t length = sprintf(buffer, "$VNWRG,43,%f,%f,%f"
-	#endif
-,
-		bias.x,
-		bias.y,
-		bias.z);
+	CommandEncoder command(buffer, size, "$VNWRG,43");
+	command.floatField(bias.x);
+	command.floatField(bias.y);
+	command.floatField(bias.z);
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadMagnetometerCalibrationControl(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,44");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,44");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,44");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genWriteMagnetometerCalibrationControl(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size, uint8_t hsiMode, uint8_t hsiOutput, uint8_t convergeRate)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNWRG,44,%u,%u,%u"
-	#else
-	size_t length = sprintf(buffer, "$VNWRG,44,%u,%u,%u"
-	#endif
-,
-		hsiMode,
-		hsiOutput,
-		convergeRate);
+	CommandEncoder command(buffer, size, "$VNWRG,44");
+	command.unsignedField(hsiMode);
+	command.unsignedField(hsiOutput);
+	command.unsignedField(convergeRate);
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadCalculatedMagnetometerCalibration(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,47");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,47");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,47");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadIndoorHeadingModeControl(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,48");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,48");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,48");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genWriteIndoorHeadingModeControl(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size, float maxRateError)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNWRG,48,%f,0"
-	#else
-	size_t length = sprintf(buffer, "$VNWRG,48,%f,0"
-	#endif
-,
-		maxRateError);
+	CommandEncoder command(buffer, size, "$VNWRG,48");
+	command.floatField(maxRateError);
+	command.unsignedField(0);
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadVelocityCompensationMeasurement(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,50");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,50");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,50");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genWriteVelocityCompensationMeasurement(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size, vec3f velocity)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNWRG,50,%f,%f,%f"
-	#else
-	size_t length = sprintf(buffer, "$VNWRG,50,%f,%f,%f"
-	#endif
-,
-		velocity.x,
-		velocity.y,
-		velocity.z);
+	CommandEncoder command(buffer, size, "$VNWRG,50");
+	command.floatField(velocity.x);
+	command.floatField(velocity.y);
+	command.floatField(velocity.z);
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadVelocityCompensationControl(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,51");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,51");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,51");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genWriteVelocityCompensationControl(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size, uint8_t mode, float velocityTuning, float rateTuning)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNWRG,51,%u,%f,%f"
-	#else
-	size_t length = sprintf(buffer, "$VNWRG,51,%u,%f,%f"
-	#endif
-,
-		mode,
-		velocityTuning,
-		rateTuning);
+	CommandEncoder command(buffer, size, "$VNWRG,51");
+	command.unsignedField(mode);
+	command.floatField(velocityTuning);
+	command.floatField(rateTuning);
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadVelocityCompensationStatus(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,52");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,52");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,52");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadImuMeasurements(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,54");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,54");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,54");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadGpsConfiguration(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,55");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,55");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,55");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genWriteGpsConfiguration(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size, uint8_t mode, uint8_t ppsSource)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNWRG,55,%u,%u,5,0,0"
-	#else
-	size_t length = sprintf(buffer, "$VNWRG,55,%u,%u,5,0,0"
-	#endif
-,
-		mode,
-		ppsSource);
+	CommandEncoder command(buffer, size, "$VNWRG,55");
+	command.unsignedField(mode);
+	command.unsignedField(ppsSource);
+	command.unsignedField(5);
+	command.unsignedField(0);
+	command.unsignedField(0);
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadGpsAntennaOffset(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,57");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,57");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,57");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genWriteGpsAntennaOffset(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size, vec3f position)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNWRG,57,%f,%f,%f"
-	#else
-	size_t length = sprintf(buffer, "$VNWRG,57,%f,%f,%f"
-	#endif
-,
-		position.x,
-		position.y,
-		position.z);
+	CommandEncoder command(buffer, size, "$VNWRG,57");
+	command.floatField(position.x);
+	command.floatField(position.y);
+	command.floatField(position.z);
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadGpsSolutionLla(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,58");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,58");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,58");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadGpsSolutionEcef(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,59");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,59");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,59");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadInsSolutionLla(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,63");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,63");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,63");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadInsSolutionEcef(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,64");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,64");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,64");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadInsBasicConfiguration(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,67");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,67");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,67");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genWriteInsBasicConfiguration(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size, uint8_t scenario, uint8_t ahrsAiding, uint8_t estBaseline)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNWRG,67,%u,%u,%u,0"
-	#else
-	size_t length = sprintf(buffer, "$VNWRG,67,%u,%u,%u,0"
-	#endif
-,
-		scenario,
-		ahrsAiding,
-		estBaseline);
+	CommandEncoder command(buffer, size, "$VNWRG,67");
+	command.unsignedField(scenario);
+	command.unsignedField(ahrsAiding);
+	command.unsignedField(estBaseline);
+	command.unsignedField(0);
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadInsAdvancedConfiguration(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,68");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,68");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,68");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genWriteInsAdvancedConfiguration(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size, uint8_t useMag, uint8_t usePres, uint8_t posAtt, uint8_t velAtt, uint8_t velBias, uint8_t useFoam, uint8_t gpsCovType, uint8_t velCount, float velInit, float moveOrigin, float gpsTimeout, float deltaLimitPos, float deltaLimitVel, float minPosUncertainty, float minVelUncertainty)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNWRG,68,%u,%u,%u,%u,%u,%u,%u,%u,%f,%f,%f,%f,%f,%f,%f"
-	#else
-	size_t length = sprintf(buffer, "$VNWRG,68,%u,%u,%u,%u,%u,%u,%u,%u,%f,%f,%f,%f,%f,%f,%f"
-	#endif
-,
-		useMag,
-		usePres,
-		posAtt,
-		velAtt,
-		velBias,
-		useFoam,
-		gpsCovType,
-		velCount,
-		velInit,
-		moveOrigin,
-		gpsTimeout,
-		deltaLimitPos,
-		deltaLimitVel,
-		minPosUncertainty,
-		minVelUncertainty);
-
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	CommandEncoder command(buffer, size, "$VNWRG,68");
+	command.unsignedField(useMag);
+	command.unsignedField(usePres);
+	command.unsignedField(posAtt);
+	command.unsignedField(velAtt);
+	command.unsignedField(velBias);
+	command.unsignedField(useFoam);
+	command.unsignedField(gpsCovType);
+	command.unsignedField(velCount);
+	command.floatField(velInit);
+	command.floatField(moveOrigin);
+	command.floatField(gpsTimeout);
+	command.floatField(deltaLimitPos);
+	command.floatField(deltaLimitVel);
+	command.floatField(minPosUncertainty);
+	command.floatField(minVelUncertainty);
+
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadInsStateLla(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,72");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,72");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,72");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadInsStateEcef(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,73");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,73");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,73");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadStartupFilterBiasEstimate(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,74");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,74");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,74");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genWriteStartupFilterBiasEstimate(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size, vec3f gyroBias, vec3f accelBias, float pressureBias)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNWRG,74,%f,%f,%f,%f,%f,%f,%f"
-	#else
-	size_t length = sprintf(buffer, "$VNWRG,74,%f,%f,%f,%f,%f,%f,%f"
-	#endif
-,
-		gyroBias.x,
-		gyroBias.y,
-		gyroBias.z,
-		accelBias.x,
-		accelBias.y,
-		accelBias.z,
-		pressureBias);
+	CommandEncoder command(buffer, size, "$VNWRG,74");
+	command.floatField(gyroBias.x);
+	command.floatField(gyroBias.y);
+	command.floatField(gyroBias.z);
+	command.floatField(accelBias.x);
+	command.floatField(accelBias.y);
+	command.floatField(accelBias.z);
+	command.floatField(pressureBias);
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadDeltaThetaAndDeltaVelocity(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,80");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,80");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,80");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadDeltaThetaAndDeltaVelocityConfiguration(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,82");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,82");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,82");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genWriteDeltaThetaAndDeltaVelocityConfiguration(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size, uint8_t integrationFrame, uint8_t gyroCompensation, uint8_t accelCompensation)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNWRG,82,%u,%u,%u,0,0"
-	#else
-	size_t length = sprintf(buffer, "$VNWRG,82,%u,%u,%u,0,0"
-	#endif
-,
-		integrationFrame,
-		gyroCompensation,
-		accelCompensation);
+	CommandEncoder command(buffer, size, "$VNWRG,82");
+	command.unsignedField(integrationFrame);
+	command.unsignedField(gyroCompensation);
+	command.unsignedField(accelCompensation);
+	command.unsignedField(0);
+	command.unsignedField(0);
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadReferenceVectorConfiguration(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,83");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,83");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,83");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genWriteReferenceVectorConfiguration(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size, uint8_t useMagModel, uint8_t useGravityModel, uint32_t recalcThreshold, float year, vec3d position)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNWRG,83,%u,%u,0,0,%u,%f,%f,%f,%f"
-	#else
-	size_t length = sprintf(buffer, "$VNWRG,83,%u,%u,0,0,%u,%f,%f,%f,%f"
-	#endif
-,
-		useMagModel,
-		useGravityModel,
-		recalcThreshold,
-		year,
-		position.x,
-		position.y,
-		position.z);
+	CommandEncoder command(buffer, size, "$VNWRG,83");
+	command.unsignedField(useMagModel);
+	command.unsignedField(useGravityModel);
+	command.unsignedField(0);
+	command.unsignedField(0);
+	command.unsignedField(recalcThreshold);
+	command.floatField(year);
+	command.floatField(position.x);
+	command.floatField(position.y);
+	command.floatField(position.z);
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadGyroCompensation(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,84");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,84");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,84");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genWriteGyroCompensation(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size, mat3f c, vec3f b)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNWRG,84,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f"
-	#else
-	size_t length = sprintf(buffer, "$VNWRG,84,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f"
-	#endif
-,
-		c.e00,
-		c.e01,
-		c.e02,
-		c.e10,
-		c.e11,
-		c.e12,
-		c.e20,
-		c.e21,
-		c.e22,
-		b.x,
-		b.y,
-		b.z);
-
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	CommandEncoder command(buffer, size, "$VNWRG,84");
+	command.floatField(c.e00);
+	command.floatField(c.e01);
+	command.floatField(c.e02);
+	command.floatField(c.e10);
+	command.floatField(c.e11);
+	command.floatField(c.e12);
+	command.floatField(c.e20);
+	command.floatField(c.e21);
+	command.floatField(c.e22);
+	command.floatField(b.x);
+	command.floatField(b.y);
+	command.floatField(b.z);
+
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadImuFilteringConfiguration(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,85");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,85");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,85");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genWriteImuFilteringConfiguration(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size, uint16_t magWindowSize, uint16_t accelWindowSize, uint16_t gyroWindowSize, uint16_t tempWindowSize, uint16_t presWindowSize, uint8_t magFilterMode, uint8_t accelFilterMode, uint8_t gyroFilterMode, uint8_t tempFilterMode, uint8_t presFilterMode)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNWRG,85,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u"
-	#else
-	size_t length = sprintf(buffer, "$VNWRG,85,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u"
-	#endif
-,
-		magWindowSize,
-		accelWindowSize,
-		gyroWindowSize,
-		tempWindowSize,
-		presWindowSize,
-		magFilterMode,
-		accelFilterMode,
-		gyroFilterMode,
-		tempFilterMode,
-		presFilterMode);
+	CommandEncoder command(buffer, size, "$VNWRG,85");
+	command.unsignedField(magWindowSize);
+	command.unsignedField(accelWindowSize);
+	command.unsignedField(gyroWindowSize);
+	command.unsignedField(tempWindowSize);
+	command.unsignedField(presWindowSize);
+	command.unsignedField(magFilterMode);
+	command.unsignedField(accelFilterMode);
+	command.unsignedField(gyroFilterMode);
+	command.unsignedField(tempFilterMode);
+	command.unsignedField(presFilterMode);
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadGpsCompassBaseline(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,93");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,93");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,93");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genWriteGpsCompassBaseline(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size, vec3f position, vec3f uncertainty)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNWRG,93,%f,%f,%f,%f,%f,%f"
-	#else
-	size_t length = sprintf(buffer, "$VNWRG,93,%f,%f,%f,%f,%f,%f"
-	#endif
-,
-		position.x,
-		position.y,
-		position.z,
-		uncertainty.x,
-		uncertainty.y,
-		uncertainty.z);
+	CommandEncoder command(buffer, size, "$VNWRG,93");
+	command.floatField(position.x);
+	command.floatField(position.y);
+	command.floatField(position.z);
+	command.floatField(uncertainty.x);
+	command.floatField(uncertainty.y);
+	command.floatField(uncertainty.z);
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadGpsCompassEstimatedBaseline(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,97");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,97");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,97");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadImuRateConfiguration(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,227");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,227");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,227");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genWriteImuRateConfiguration(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size, uint16_t imuRate, uint16_t navDivisor, float filterTargetRate, float filterMinRate)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNWRG,227,%u,%u,%f,%f"
-	#else
-	size_t length = sprintf(buffer, "$VNWRG,227,%u,%u,%f,%f"
-	#endif
-,
-		imuRate,
-		navDivisor,
-		filterTargetRate,
-		filterMinRate);
+	CommandEncoder command(buffer, size, "$VNWRG,227");
+	command.unsignedField(imuRate);
+	command.unsignedField(navDivisor);
+	command.floatField(filterTargetRate);
+	command.floatField(filterMinRate);
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadYawPitchRollTrueBodyAccelerationAndAngularRates(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,239");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,239");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,239");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 size_t Packet::genReadYawPitchRollTrueInertialAccelerationAndAngularRates(ErrorDetectionMode errorDetectionMode, char *buffer, size_t size)
 {
-	#if VN_HAVE_SECURE_CRT
-	size_t length = sprintf_s(buffer, size, "$VNRRG,240");
-	#else
-	size_t length = sprintf(buffer, "$VNRRG,240");
-	#endif
+	CommandEncoder command(buffer, size, "$VNRRG,240");
 
-	return finalizeCommand(errorDetectionMode, buffer, length);
+	return command.finalize(errorDetectionMode);
 }
 
 void Packet::parseVNYPR(vec3f* yawPitchRoll)
 {
-	size_t parseIndex;
-
-	char* result = startAsciiPacketParse(_data, parseIndex);
+	const char* result = startAsciiPacketParse(_data);
 
 	yawPitchRoll->x = ATOFF; NEXT
 	yawPitchRoll->y = ATOFF; NEXT
@@ -2303,9 +2134,7 @@ void Packet::parseVNYPR(vec3f* yawPitchRoll)
 
 void Packet::parseVNQTN(vec4f* quaternion)
 {
-	size_t parseIndex;
-
-	char* result = startAsciiPacketParse(_data, parseIndex);
+	const char* result = startAsciiPacketParse(_data);
 
 	quaternion->x = ATOFF; NEXT
 	quaternion->y = ATOFF; NEXT
@@ -2317,9 +2146,7 @@ void Packet::parseVNQTN(vec4f* quaternion)
 
 void Packet::parseVNQTM(vec4f *quaternion, vec3f *magnetic)
 {
-	size_t parseIndex;
-
-	char* result = startAsciiPacketParse(_data, parseIndex);
+	const char* result = startAsciiPacketParse(_data);
 
 	quaternion->x = ATOFF; NEXT
 	quaternion->y = ATOFF; NEXT
@@ -2332,9 +2159,7 @@ void Packet::parseVNQTM(vec4f *quaternion, vec3f *magnetic)
 
 void Packet::parseVNQTA(vec4f* quaternion, vec3f* acceleration)
 {
-	size_t parseIndex;
-
-	char* result = startAsciiPacketParse(_data, parseIndex);
+	const char* result = startAsciiPacketParse(_data);
 
 	quaternion->x = ATOFF; NEXT
 	quaternion->y = ATOFF; NEXT
@@ -2347,9 +2172,7 @@ void Packet::parseVNQTA(vec4f* quaternion, vec3f* acceleration)
 
 void Packet::parseVNQTR(vec4f* quaternion, vec3f* angularRate)
 {
-	size_t parseIndex;
-
-	char* result = startAsciiPacketParse(_data, parseIndex);
+	const char* result = startAsciiPacketParse(_data);
 
 	quaternion->x = ATOFF; NEXT
 	quaternion->y = ATOFF; NEXT
@@ -2362,9 +2185,7 @@ void Packet::parseVNQTR(vec4f* quaternion, vec3f* angularRate)
 
 void Packet::parseVNQMA(vec4f* quaternion, vec3f* magnetic, vec3f* acceleration)
 {
-	size_t parseIndex;
-
-	char* result = startAsciiPacketParse(_data, parseIndex);
+	const char* result = startAsciiPacketParse(_data);
 
 	quaternion->x = ATOFF; NEXT
 	quaternion->y = ATOFF; NEXT
@@ -2380,9 +2201,7 @@ void Packet::parseVNQMA(vec4f* quaternion, vec3f* magnetic, vec3f* acceleration)
 
 void Packet::parseVNQAR(vec4f* quaternion, vec3f* acceleration, vec3f* angularRate)
 {
-	size_t parseIndex;
-
-	char* result = startAsciiPacketParse(_data, parseIndex);
+	const char* result = startAsciiPacketParse(_data);
 
 	quaternion->x = ATOFF; NEXT
 	quaternion->y = ATOFF; NEXT
@@ -2400,9 +2219,7 @@ void Packet::parseVNQAR(vec4f* quaternion, vec3f* acceleration, vec3f* angularRa
 
 void Packet::parseVNQMR(vec4f* quaternion, vec3f* magnetic, vec3f* acceleration, vec3f* angularRate)
 {
-	size_t parseIndex;
-
-	char* result = startAsciiPacketParse(_data, parseIndex);
+	const char* result = startAsciiPacketParse(_data);
 
 	quaternion->x = ATOFF; NEXT
 	quaternion->y = ATOFF; NEXT
@@ -2469,9 +2286,7 @@ void Packet::parseVNDCM(mat3f* dcm)
 
 void Packet::parseVNMAG(vec3f* magnetic)
 {
-	size_t parseIndex;
-
-	char* result = startAsciiPacketParse(_data, parseIndex);
+	const char* result = startAsciiPacketParse(_data);
 
 	magnetic->x = ATOFF; NEXT
 	magnetic->y = ATOFF; NEXT
@@ -2480,9 +2295,7 @@ void Packet::parseVNMAG(vec3f* magnetic)
 
 void Packet::parseVNACC(vec3f* acceleration)
 {
-	size_t parseIndex;
-
-	char* result = startAsciiPacketParse(_data, parseIndex);
+	const char* result = startAsciiPacketParse(_data);
 
 	acceleration->x = ATOFF; NEXT
 	acceleration->y = ATOFF; NEXT
@@ -2491,9 +2304,7 @@ void Packet::parseVNACC(vec3f* acceleration)
 
 void Packet::parseVNGYR(vec3f* angularRate)
 {
-	size_t parseIndex;
-
-	char* result = startAsciiPacketParse(_data, parseIndex);
+	const char* result = startAsciiPacketParse(_data);
 
 	angularRate->x = ATOFF; NEXT
 	angularRate->y = ATOFF; NEXT
@@ -2502,9 +2313,7 @@ void Packet::parseVNGYR(vec3f* angularRate)
 
 void Packet::parseVNMAR(vec3f* magnetic, vec3f* acceleration, vec3f* angularRate)
 {
-	size_t parseIndex;
-
-	char* result = startAsciiPacketParse(_data, parseIndex);
+	const char* result = startAsciiPacketParse(_data);
 
 	magnetic->x = ATOFF; NEXT
 	magnetic->y = ATOFF; NEXT
@@ -2519,9 +2328,7 @@ void Packet::parseVNMAR(vec3f* magnetic, vec3f* acceleration, vec3f* angularRate
 
 void Packet::parseVNYMR(vec3f* yawPitchRoll, vec3f* magnetic, vec3f* acceleration, vec3f* angularRate)
 {
-	size_t parseIndex;
-
-	char* result = startAsciiPacketParse(_data, parseIndex);
+	const char* result = startAsciiPacketParse(_data);
 
 	yawPitchRoll->x = ATOFF; NEXT
 	yawPitchRoll->y = ATOFF; NEXT
@@ -2541,9 +2348,7 @@ void Packet::parseVNYMR(vec3f* yawPitchRoll, vec3f* magnetic, vec3f* acceleratio
 
 void Packet::parseVNYCM(vec3f* yawPitchRoll, vec3f* magnetic, vec3f* acceleration, vec3f* angularRate, float* temperature)
 {
-	size_t parseIndex;
-
-	char* result = startAsciiPacketParse(_data, parseIndex);
+	const char* result = startAsciiPacketParse(_data);
 
 	yawPitchRoll->x = ATOFF; NEXT
 	yawPitchRoll->y = ATOFF; NEXT
@@ -2564,9 +2369,7 @@ void Packet::parseVNYCM(vec3f* yawPitchRoll, vec3f* magnetic, vec3f* acceleratio
 
 void Packet::parseVNYBA(vec3f* yawPitchRoll, vec3f* accelerationBody, vec3f* angularRate)
 {
-	size_t parseIndex;
-
-	char* result = startAsciiPacketParse(_data, parseIndex);
+	const char* result = startAsciiPacketParse(_data);
 
 	yawPitchRoll->x = ATOFF; NEXT
 	yawPitchRoll->y = ATOFF; NEXT
@@ -2581,9 +2384,7 @@ void Packet::parseVNYBA(vec3f* yawPitchRoll, vec3f* accelerationBody, vec3f* ang
 
 void Packet::parseVNYIA(vec3f* yawPitchRoll, vec3f* accelerationInertial, vec3f* angularRate)
 {
-	size_t parseIndex;
-
-	char* result = startAsciiPacketParse(_data, parseIndex);
+	const char* result = startAsciiPacketParse(_data);
 
 	yawPitchRoll->x = ATOFF; NEXT
 	yawPitchRoll->y = ATOFF; NEXT
@@ -2600,9 +2401,7 @@ void Packet::parseVNYIA(vec3f* yawPitchRoll, vec3f* accelerationInertial, vec3f*
 
 void Packet::parseVNICM(vec3f* yawPitchRoll, vec3f* magnetic, vec3f* accelerationInertial, vec3f* angularRate)
 {
-	size_t parseIndex;
-
-	char* result = startAsciiPacketParse(_data, parseIndex);
+	const char* result = startAsciiPacketParse(_data);
 
 	yawPitchRoll->x = ATOFF; NEXT
 	yawPitchRoll->y = ATOFF; NEXT
@@ -2622,9 +2421,7 @@ void Packet::parseVNICM(vec3f* yawPitchRoll, vec3f* magnetic, vec3f* acceleratio
 
 void Packet::parseVNIMU(vec3f* magneticUncompensated, vec3f* accelerationUncompensated, vec3f* angularRateUncompensated, float* temperature, float* pressure)
 {
-	size_t parseIndex;
-
-	char* result = startAsciiPacketParse(_data, parseIndex);
+	const char* result = startAsciiPacketParse(_data);
 
 	magneticUncompensated->x = ATOFF; NEXT
 	magneticUncompensated->y = ATOFF; NEXT
@@ -2641,9 +2438,7 @@ void Packet::parseVNIMU(vec3f* magneticUncompensated, vec3f* accelerationUncompe
 
 void Packet::parseVNGPS(double* time, uint16_t* week, uint8_t* gpsFix, uint8_t* numSats, vec3d* lla, vec3f* nedVel, vec3f* nedAcc, float* speedAcc, float* timeAcc)
 {
-	size_t parseIndex;
-
-	char* result = startAsciiPacketParse(_data, parseIndex);
+	const char* result = startAsciiPacketParse(_data);
 
 	*time = ATOFD; NEXT
 	*week = ATOU16; NEXT
@@ -2664,9 +2459,7 @@ void Packet::parseVNGPS(double* time, uint16_t* week, uint8_t* gpsFix, uint8_t*
 
 void Packet::parseVNINS(double* time, uint16_t* week, uint16_t* status, vec3f* yawPitchRoll, vec3d* lla, vec3f* nedVel, float* attUncertainty, float* posUncertainty, float* velUncertainty)
 {
-	size_t parseIndex;
-
-	char* result = startAsciiPacketParse(_data, parseIndex);
+	const char* result = startAsciiPacketParse(_data);
 
 	*time = ATOFD; NEXT
 	*week = ATOU16; NEXT
@@ -2687,9 +2480,7 @@ void Packet::parseVNINS(double* time, uint16_t* week, uint16_t* status, vec3f* y
 
 void Packet::parseVNINE(double* time, uint16_t* week, uint16_t* status, vec3f* ypr, vec3d* position, vec3f* velocity, float* attUncertainty, float* posUncertainty, float* velUncertainty)
 {
-	size_t parseIndex;
-
-	char* result = startAsciiPacketParse(_data, parseIndex);
+	const char* result = startAsciiPacketParse(_data);
 
 	*time = ATOFD; NEXT
 	*week = ATOU16; NEXT
@@ -2710,9 +2501,7 @@ void Packet::parseVNINE(double* time, uint16_t* week, uint16_t* status, vec3f* y
 
 void Packet::parseVNISL(vec3f* ypr, vec3d* lla, vec3f* velocity, vec3f* acceleration, vec3f* angularRate)
 {
-	size_t parseIndex;
-
-	char* result = startAsciiPacketParse(_data, parseIndex);
+	const char* result = startAsciiPacketParse(_data);
 
 	ypr->x = ATOFF; NEXT
 	ypr->y = ATOFF; NEXT
@@ -2733,9 +2522,7 @@ void Packet::parseVNISL(vec3f* ypr, vec3d* lla, vec3f* velocity, vec3f* accelera
 
 void Packet::parseVNISE(vec3f* ypr, vec3d* position, vec3f* velocity, vec3f* acceleration, vec3f* angularRate)
 {
-	size_t parseIndex;
-
-	char* result = startAsciiPacketParse(_data, parseIndex);
+	const char* result = startAsciiPacketParse(_data);
 
 	ypr->x = ATOFF; NEXT
 	ypr->y = ATOFF; NEXT
@@ -2758,9 +2545,7 @@ void Packet::parseVNISE(vec3f* ypr, vec3d* position, vec3f* velocity, vec3f* acc
 
 void Packet::parseVNRAW(vec3f *magneticVoltage, vec3f *accelerationVoltage, vec3f *angularRateVoltage, float* temperatureVoltage)
 {
-	size_t parseIndex;
-
-	char* result = startAsciiPacketParse(_data, parseIndex);
+	const char* result = startAsciiPacketParse(_data);
 
 	magneticVoltage->x = ATOFF; NEXT
 	magneticVoltage->y = ATOFF; NEXT
@@ -2776,9 +2561,7 @@ void Packet::parseVNRAW(vec3f *magneticVoltage, vec3f *accelerationVoltage, vec3
 
 void Packet::parseVNCMV(vec3f* magneticUncompensated, vec3f* accelerationUncompensated, vec3f* angularRateUncompensated, float* temperature)
 {
-	size_t parseIndex;
-
-	char* result = startAsciiPacketParse(_data, parseIndex);
+	const char* result = startAsciiPacketParse(_data);
 
 	magneticUncompensated->x = ATOFF; NEXT
 	magneticUncompensated->y = ATOFF; NEXT
@@ -2794,9 +2577,7 @@ void Packet::parseVNCMV(vec3f* magneticUncompensated, vec3f* accelerationUncompe
 
 void Packet::parseVNSTV(vec4f* quaternion, vec3f* angularRateBias)
 {
-	size_t parseIndex;
-
-	char* result = startAsciiPacketParse(_data, parseIndex);
+	const char* result = startAsciiPacketParse(_data);
 
 	quaternion->x = ATOFF; NEXT
 	quaternion->y = ATOFF; NEXT
@@ -2809,9 +2590,7 @@ void Packet::parseVNSTV(vec4f* quaternion, vec3f* angularRateBias)
 
 void Packet::parseVNCOV(vec3f* attitudeVariance, vec3f* angularRateBiasVariance)
 {
-	size_t parseIndex;
-
-	char* result = startAsciiPacketParse(_data, parseIndex);
+	const char* result = startAsciiPacketParse(_data);
 
 	attitudeVariance->x = ATOFF; NEXT
 	attitudeVariance->y = ATOFF; NEXT
@@ -2825,9 +2604,7 @@ void Packet::parseVNCOV(vec3f* attitudeVariance, vec3f* angularRateBiasVariance)
 
 void Packet::parseVNGPE(double* tow, uint16_t* week, uint8_t* gpsFix, uint8_t* numSats, vec3d* position, vec3f* velocity, vec3f* posAcc, float* speedAcc, float* timeAcc)
 {
-	size_t parseIndex;
-
-	char* result = startAsciiPacketParse(_data, parseIndex);
+	const char* result = startAsciiPacketParse(_data);
 
 	*tow = ATOFD; NEXT
 	*week = ATOU16; NEXT
@@ -2848,9 +2625,7 @@ void Packet::parseVNGPE(double* tow, uint16_t* week, uint8_t* gpsFix, uint8_t* n
 
 void Packet::parseVNDTV(float* deltaTime, vec3f* deltaTheta, vec3f* deltaVelocity)
 {
-	size_t parseIndex;
-
-	char* result = startAsciiPacketParse(_data, parseIndex);
+	const char* result = startAsciiPacketParse(_data);
 
 	*deltaTime = ATOFF; NEXT
 	deltaTheta->x = ATOFF; NEXT
@@ -2863,6 +2638,11 @@ void Packet::parseVNDTV(float* deltaTime, vec3f* deltaTheta, vec3f* deltaVelocit
 
 size_t Packet::computeBinaryPacketLength(char const* startOfPossibleBinaryPacket)
 {
+	const BinaryPlan* plan = BinaryPlan::find(startOfPossibleBinaryPacket);
+
+	if (plan != NULL)
+		return plan->length;
+
 	char groupsPresent = startOfPossibleBinaryPacket[1];
 	size_t runningPayloadLength = 2;	// Start of packet character plus groups present field.
 	const char* pCurrentGroupField = startOfPossibleBinaryPacket + 2;
@@ -2903,6 +2683,12 @@ size_t Packet::computeBinaryPacketLength(char const* startOfPossibleBinaryPacket
 		pCurrentGroupField += 2;
 	}
 
+	if (groupsPresent & 0x40)
+	{
+		runningPayloadLength += 2 + computeNumOfBytesForBinaryGroupPayload(BINARYGROUP_GPS2, stoh(*reinterpret_cast<const uint16_t*>(pCurrentGroupField)));
+		pCurrentGroupField += 2;
+	}
+
 	return runningPayloadLength + 2;	// Add 2 bytes for CRC.
 }
 
@@ -2931,9 +2717,7 @@ size_t Packet::computeNumOfBytesForBinaryGroupPayload(BinaryGroup group, uint16_
 
 SensorError Packet::parseError()
 {
-	size_t parseIndex;
-
-	char* result = startAsciiPacketParse(_data, parseIndex);
+	const char* result = startAsciiPacketParse(_data);
 
 	return static_cast<SensorError>(to_uint8_from_hexstr(result));
 }
@@ -2965,9 +2749,7 @@ void Packet::parseBinaryOutput(
 	uint16_t* insField,
   uint16_t* gps2Field)
 {
-	size_t parseIndex;
-
-	char *result = startAsciiPacketParse(_data, parseIndex); NEXT
+	const char *result = startAsciiPacketParse(_data); NEXT
 
 	*commonField = 0;
 	*timeField = 0;
@@ -3018,135 +2800,69 @@ void Packet::parseBinaryOutput(
 
 void Packet::parseUserTag(char* tag)
 {
-	size_t parseIndex;
-
-	char* result = startAsciiPacketParse(_data, parseIndex);
-
-	if (*(result + strlen(result) + 1) == '*')
-	{
-		tag[0] = '\0';
-		return;
-	}
+	const char* result = startAsciiPacketParse(_data);
 
 	NEXT
-	
-	#if defined(_MSC_VER)
-		//Unable to use strcpy_s since we do not have length of the output array.
-		#pragma warning(push)
-		#pragma warning(disable:4996)
-	#endif
 
-	strcpy(tag, result);
-
-	#if defined(_MSC_VER)
-		#pragma warning(pop)
-	#endif
+	copyAsciiField(result, tag);
 }
 
 void Packet::parseModelNumber(char* productName)
 {
-	size_t parseIndex;
-
-	char* result = startAsciiPacketParse(_data, parseIndex);
-
-	if (*(result + strlen(result) + 1) == '*')
-	{
-		productName[0] = '\0';
-		return;
-	}
+	const char* result = startAsciiPacketParse(_data);
 
 	NEXT
-	
-	#if defined(_MSC_VER)
-		//Unable to use strcpy_s since we do not have length of the output array.
-		#pragma warning(push)
-		#pragma warning(disable:4996)
-	#endif
 
-	strcpy(productName, result);
-
-	#if defined(_MSC_VER)
-		#pragma warning(pop)
-	#endif
+	copyAsciiField(result, productName);
 }
 
 void Packet::parseHardwareRevision(uint32_t* revision)
 {
-	size_t parseIndex;
-
-	char *result = startAsciiPacketParse(_data, parseIndex); NEXT
+	const char *result = startAsciiPacketParse(_data); NEXT
 
 	*revision = ATOU32;
 }
 
 void Packet::parseSerialNumber(uint32_t* serialNum)
 {
-	size_t parseIndex;
-
-	char *result = startAsciiPacketParse(_data, parseIndex); NEXT
+	const char *result = startAsciiPacketParse(_data); NEXT
 
 	*serialNum = ATOU32;
 }
 
 void Packet::parseFirmwareVersion(char* firmwareVersion)
 {
-	size_t parseIndex;
-
-	char* result = startAsciiPacketParse(_data, parseIndex);
-
-	if (*(result + strlen(result) + 1) == '*')
-	{
-		firmwareVersion[0] = '\0';
-		return;
-	}
+	const char* result = startAsciiPacketParse(_data);
 
 	NEXT
 
-	#if defined(_MSC_VER)
-		//Unable to use strcpy_s since we do not have length of the output array.
-		#pragma warning(push)
-		#pragma warning(disable:4996)
-	#endif
-
-	strcpy(firmwareVersion, result);
-
-	#if defined(_MSC_VER)
-		#pragma warning(pop)
-	#endif
+	copyAsciiField(result, firmwareVersion);
 }
 
 void Packet::parseSerialBaudRate(uint32_t* baudrate)
 {
-	size_t parseIndex;
-
-	char *result = startAsciiPacketParse(_data, parseIndex); NEXT
+	const char *result = startAsciiPacketParse(_data); NEXT
 
 	*baudrate = ATOU32;
 }
 
 void Packet::parseAsyncDataOutputType(uint32_t* ador)
 {
-	size_t parseIndex;
-
-	char *result = startAsciiPacketParse(_data, parseIndex); NEXT
+	const char *result = startAsciiPacketParse(_data); NEXT
 
 	*ador = ATOU32;
 }
 
 void Packet::parseAsyncDataOutputFrequency(uint32_t* adof)
 {
-	size_t parseIndex;
-
-	char *result = startAsciiPacketParse(_data, parseIndex); NEXT
+	const char *result = startAsciiPacketParse(_data); NEXT
 
 	*adof = ATOU32;
 }
 
 void Packet::parseYawPitchRoll(vec3f* yawPitchRoll)
 {
-	size_t parseIndex;
-
-	char *result = startAsciiPacketParse(_data, parseIndex); NEXT
+	const char *result = startAsciiPacketParse(_data); NEXT
 
 	yawPitchRoll->x = ATOFF; NEXT
 	yawPitchRoll->y = ATOFF; NEXT
@@ -3155,9 +2871,7 @@ void Packet::parseYawPitchRoll(vec3f* yawPitchRoll)
 
 void Packet::parseAttitudeQuaternion(vec4f* quat)
 {
-	size_t parseIndex;
-
-	char *result = startAsciiPacketParse(_data, parseIndex); NEXT
+	const char *result = startAsciiPacketParse(_data); NEXT
 
 	quat->x = ATOFF; NEXT
 	quat->y = ATOFF; NEXT
@@ -3167,9 +2881,7 @@ void Packet::parseAttitudeQuaternion(vec4f* quat)
 
 void Packet::parseQuaternionMagneticAccelerationAndAngularRates(vec4f* quat, vec3f* mag, vec3f* accel, vec3f* gyro)
 {
-	size_t parseIndex;
-
-	char *result = startAsciiPacketParse(_data, parseIndex); NEXT
+	const char *result = startAsciiPacketParse(_data); NEXT
 
 	quat->x = ATOFF; NEXT
 	quat->y = ATOFF; NEXT
@@ -3188,9 +2900,7 @@ void Packet::parseQuaternionMagneticAccelerationAndAngularRates(vec4f* quat, vec
 
 void Packet::parseMagneticMeasurements(vec3f* mag)
 {
-	size_t parseIndex;
-
-	char *result = startAsciiPacketParse(_data, parseIndex); NEXT
+	const char *result = startAsciiPacketParse(_data); NEXT
 
 	mag->x = ATOFF; NEXT
 	mag->y = ATOFF; NEXT
@@ -3199,9 +2909,7 @@ void Packet::parseMagneticMeasurements(vec3f* mag)
 
 void Packet::parseAccelerationMeasurements(vec3f* accel)
 {
-	size_t parseIndex;
-
-	char *result = startAsciiPacketParse(_data, parseIndex); NEXT
+	const char *result = startAsciiPacketParse(_data); NEXT
 
 	accel->x = ATOFF; NEXT
 	accel->y = ATOFF; NEXT
@@ -3210,9 +2918,7 @@ void Packet::parseAccelerationMeasurements(vec3f* accel)
 
 void Packet::parseAngularRateMeasurements(vec3f* gyro)
 {
-	size_t parseIndex;
-
-	char *result = startAsciiPacketParse(_data, parseIndex); NEXT
+	const char *result = startAsciiPacketParse(_data); NEXT
 
 	gyro->x = ATOFF; NEXT
 	gyro->y = ATOFF; NEXT
@@ -3221,9 +2927,7 @@ void Packet::parseAngularRateMeasurements(vec3f* gyro)
 
 void Packet::parseMagneticAccelerationAndAngularRates(vec3f* mag, vec3f* accel, vec3f* gyro)
 {
-	size_t parseIndex;
-
-	char *result = startAsciiPacketParse(_data, parseIndex); NEXT
+	const char *result = startAsciiPacketParse(_data); NEXT
 
 	mag->x = ATOFF; NEXT
 	mag->y = ATOFF; NEXT
@@ -3238,9 +2942,7 @@ void Packet::parseMagneticAccelerationAndAngularRates(vec3f* mag, vec3f* accel,
 
 void Packet::parseMagneticAndGravityReferenceVectors(vec3f* magRef, vec3f* accRef)
 {
-	size_t parseIndex;
-
-	char *result = startAsciiPacketParse(_data, parseIndex); NEXT
+	const char *result = startAsciiPacketParse(_data); NEXT
 
 	magRef->x = ATOFF; NEXT
 	magRef->y = ATOFF; NEXT
@@ -3252,9 +2954,7 @@ void Packet::parseMagneticAndGravityReferenceVectors(vec3f* magRef, vec3f* accRe
 
 void Packet::parseFilterMeasurementsVarianceParameters(float* angularWalkVariance, vec3f* angularRateVariance, vec3f* magneticVariance, vec3f* accelerationVariance)
 {
-	size_t parseIndex;
-
-	char *result = startAsciiPacketParse(_data, parseIndex); NEXT
+	const char *result = startAsciiPacketParse(_data); NEXT
 
 	*angularWalkVariance = ATOFF; NEXT
 	angularRateVariance->x = ATOFF; NEXT
@@ -3270,9 +2970,7 @@ void Packet::parseFilterMeasurementsVarianceParameters(float* angularWalkVarianc
 
 void Packet::parseMagnetometerCompensation(mat3f* c, vec3f* b)
 {
-	size_t parseIndex;
-
-	char *result = startAsciiPacketParse(_data, parseIndex); NEXT
+	const char *result = startAsciiPacketParse(_data); NEXT
 
 	c->e00 = ATOFF; NEXT
 	c->e01 = ATOFF; NEXT
@@ -3290,9 +2988,7 @@ void Packet::parseMagnetometerCompensation(mat3f* c, vec3f* b)
 
 void Packet::parseFilterActiveTuningParameters(float* magneticDisturbanceGain, float* accelerationDisturbanceGain, float* magneticDisturbanceMemory, float* accelerationDisturbanceMemory)
 {
-	size_t parseIndex;
-
-	char *result = startAsciiPacketParse(_data, parseIndex); NEXT
+	const char *result = startAsciiPacketParse(_data); NEXT
 
 	*magneticDisturbanceGain = ATOFF; NEXT
 	*accelerationDisturbanceGain = ATOFF; NEXT
@@ -3302,9 +2998,7 @@ void Packet::parseFilterActiveTuningParameters(float* magneticDisturbanceGain, f
 
 void Packet::parseAccelerationCompensation(mat3f* c, vec3f* b)
 {
-	size_t parseIndex;
-
-	char *result = startAsciiPacketParse(_data, parseIndex); NEXT
+	const char *result = startAsciiPacketParse(_data); NEXT
 
 	c->e00 = ATOFF; NEXT
 	c->e01 = ATOFF; NEXT
@@ -3322,9 +3016,7 @@ void Packet::parseAccelerationCompensation(mat3f* c, vec3f* b)
 
 void Packet::parseReferenceFrameRotation(mat3f* c)
 {
-	size_t parseIndex;
-
-	char *result = startAsciiPacketParse(_data, parseIndex); NEXT
+	const char *result = startAsciiPacketParse(_data); NEXT
 
 	c->e00 = ATOFF; NEXT
 	c->e01 = ATOFF; NEXT
@@ -3339,9 +3031,7 @@ void Packet::parseReferenceFrameRotation(mat3f* c)
 
 void Packet::parseYawPitchRollMagneticAccelerationAndAngularRates(vec3f* yawPitchRoll, vec3f* mag, vec3f* accel, vec3f* gyro)
 {
-	size_t parseIndex;
-
-	char *result = startAsciiPacketParse(_data, parseIndex); NEXT
+	const char *result = startAsciiPacketParse(_data); NEXT
 
 	yawPitchRoll->x = ATOFF; NEXT
 	yawPitchRoll->y = ATOFF; NEXT
@@ -3359,9 +3049,7 @@ void Packet::parseYawPitchRollMagneticAccelerationAndAngularRates(vec3f* yawPitc
 
 void Packet::parseCommunicationProtocolControl(uint8_t* serialCount, uint8_t* serialStatus, uint8_t* spiCount, uint8_t* spiStatus, uint8_t* serialChecksum, uint8_t* spiChecksum, uint8_t* errorMode)
 {
-	size_t parseIndex;
-
-	char *result = startAsciiPacketParse(_data, parseIndex); NEXT
+	const char *result = startAsciiPacketParse(_data); NEXT
 
 	*serialCount = ATOU8; NEXT
 	*serialStatus = ATOU8; NEXT
@@ -3374,9 +3062,7 @@ void Packet::parseCommunicationProtocolControl(uint8_t* serialCount, uint8_t* se
 
 void Packet::parseSynchronizationControl(uint8_t* syncInMode, uint8_t* syncInEdge, uint16_t* syncInSkipFactor, uint8_t* syncOutMode, uint8_t* syncOutPolarity, uint16_t* syncOutSkipFactor, uint32_t* syncOutPulseWidth)
 {
-	size_t parseIndex;
-
-	char *result = startAsciiPacketParse(_data, parseIndex); NEXT
+	const char *result = startAsciiPacketParse(_data); NEXT
 
 	*syncInMode = ATOU8; NEXT
 	*syncInEdge = ATOU8; NEXT
@@ -3390,9 +3076,7 @@ void Packet::parseSynchronizationControl(uint8_t* syncInMode, uint8_t* syncInEdg
 
 void Packet::parseSynchronizationStatus(uint32_t* syncInCount, uint32_t* syncInTime, uint32_t* syncOutCount)
 {
-	size_t parseIndex;
-
-	char *result = startAsciiPacketParse(_data, parseIndex); NEXT
+	const char *result = startAsciiPacketParse(_data); NEXT
 
 	*syncInCount = ATOU32; NEXT
 	*syncInTime = ATOU32; NEXT
@@ -3401,9 +3085,7 @@ void Packet::parseSynchronizationStatus(uint32_t* syncInCount, uint32_t* syncInT
 
 void Packet::parseFilterBasicControl(uint8_t* magMode, uint8_t* extMagMode, uint8_t* extAccMode, uint8_t* extGyroMode, vec3f* gyroLimit)
 {
-	size_t parseIndex;
-
-	char *result = startAsciiPacketParse(_data, parseIndex); NEXT
+	const char *result = startAsciiPacketParse(_data); NEXT
 
 	*magMode = ATOU8; NEXT
 	*extMagMode = ATOU8; NEXT
@@ -3416,9 +3098,7 @@ void Packet::parseFilterBasicControl(uint8_t* magMode, uint8_t* extMagMode, uint
 
 void Packet::parseVpeBasicControl(uint8_t* enable, uint8_t* headingMode, uint8_t* filteringMode, uint8_t* tuningMode)
 {
-	size_t parseIndex;
-
-	char *result = startAsciiPacketParse(_data, parseIndex); NEXT
+	const char *result = startAsciiPacketParse(_data); NEXT
 
 	*enable = ATOU8; NEXT
 	*headingMode = ATOU8; NEXT
@@ -3428,9 +3108,7 @@ void Packet::parseVpeBasicControl(uint8_t* enable, uint8_t* headingMode, uint8_t
 
 void Packet::parseVpeMagnetometerBasicTuning(vec3f* baseTuning, vec3f* adaptiveTuning, vec3f* adaptiveFiltering)
 {
-	size_t parseIndex;
-
-	char *result = startAsciiPacketParse(_data, parseIndex); NEXT
+	const char *result = startAsciiPacketParse(_data); NEXT
 
 	baseTuning->x = ATOFF; NEXT
 	baseTuning->y = ATOFF; NEXT
@@ -3445,9 +3123,7 @@ void Packet::parseVpeMagnetometerBasicTuning(vec3f* baseTuning, vec3f* adaptiveT
 
 void Packet::parseVpeMagnetometerAdvancedTuning(vec3f* minFiltering, vec3f* maxFiltering, float* maxAdaptRate, float* disturbanceWindow, float* maxTuning)
 {
-	size_t parseIndex;
-
-	char *result = startAsciiPacketParse(_data, parseIndex); NEXT
+	const char *result = startAsciiPacketParse(_data); NEXT
 
 	minFiltering->x = ATOFF; NEXT
 	minFiltering->y = ATOFF; NEXT
@@ -3462,9 +3138,7 @@ void Packet::parseVpeMagnetometerAdvancedTuning(vec3f* minFiltering, vec3f* maxF
 
 void Packet::parseVpeAccelerometerBasicTuning(vec3f* baseTuning, vec3f* adaptiveTuning, vec3f* adaptiveFiltering)
 {
-	size_t parseIndex;
-
-	char *result = startAsciiPacketParse(_data, parseIndex); NEXT
+	const char *result = startAsciiPacketParse(_data); NEXT
 
 	baseTuning->x = ATOFF; NEXT
 	baseTuning->y = ATOFF; NEXT
@@ -3479,9 +3153,7 @@ void Packet::parseVpeAccelerometerBasicTuning(vec3f* baseTuning, vec3f* adaptive
 
 void Packet::parseVpeAccelerometerAdvancedTuning(vec3f* minFiltering, vec3f* maxFiltering, float* maxAdaptRate, float* disturbanceWindow, float* maxTuning)
 {
-	size_t parseIndex;
-
-	char *result = startAsciiPacketParse(_data, parseIndex); NEXT
+	const char *result = startAsciiPacketParse(_data); NEXT
 
 	minFiltering->x = ATOFF; NEXT
 	minFiltering->y = ATOFF; NEXT
@@ -3496,9 +3168,7 @@ void Packet::parseVpeAccelerometerAdvancedTuning(vec3f* minFiltering, vec3f* max
 
 void Packet::parseVpeGyroBasicTuning(vec3f* angularWalkVariance, vec3f* baseTuning, vec3f* adaptiveTuning)
 {
-	size_t parseIndex;
-
-	char *result = startAsciiPacketParse(_data, parseIndex); NEXT
+	const char *result = startAsciiPacketParse(_data); NEXT
 
 	angularWalkVariance->x = ATOFF; NEXT
 	angularWalkVariance->y = ATOFF; NEXT
@@ -3513,9 +3183,7 @@ void Packet::parseVpeGyroBasicTuning(vec3f* angularWalkVariance, vec3f* baseTuni
 
 void Packet::parseFilterStartupGyroBias(vec3f* bias)
 {
-	size_t parseIndex;
-
-	char *result = startAsciiPacketParse(_data, parseIndex); NEXT
+	const char *result = startAsciiPacketParse(_data); NEXT
 
 	bias->x = ATOFF; NEXT
 	bias->y = ATOFF; NEXT
@@ -3524,9 +3192,7 @@ void Packet::parseFilterStartupGyroBias(vec3f* bias)
 
 void Packet::parseMagnetometerCalibrationControl(uint8_t* hsiMode, uint8_t* hsiOutput, uint8_t* convergeRate)
 {
-	size_t parseIndex;
-
-	char *result = startAsciiPacketParse(_data, parseIndex); NEXT
+	const char *result = startAsciiPacketParse(_data); NEXT
 
 	*hsiMode = ATOU8; NEXT
 	*hsiOutput = ATOU8; NEXT
@@ -3535,9 +3201,7 @@ void Packet::parseMagnetometerCalibrationControl(uint8_t* hsiMode, uint8_t* hsiO
 
 void Packet::parseCalculatedMagnetometerCalibration(mat3f* c, vec3f* b)
 {
-	size_t parseIndex;
-
-	char *result = startAsciiPacketParse(_data, parseIndex); NEXT
+	const char *result = startAsciiPacketParse(_data); NEXT
 
 	c->e00 = ATOFF; NEXT
 	c->e01 = ATOFF; NEXT
@@ -3555,18 +3219,14 @@ void Packet::parseCalculatedMagnetometerCalibration(mat3f* c, vec3f* b)
 
 void Packet::parseIndoorHeadingModeControl(float* maxRateError)
 {
-	size_t parseIndex;
-
-	char *result = startAsciiPacketParse(_data, parseIndex); NEXT
+	const char *result = startAsciiPacketParse(_data); NEXT
 
 	*maxRateError = ATOFF; NEXT
 }
 
 void Packet::parseVelocityCompensationMeasurement(vec3f* velocity)
 {
-	size_t parseIndex;
-
-	char *result = startAsciiPacketParse(_data, parseIndex); NEXT
+	const char *result = startAsciiPacketParse(_data); NEXT
 
 	velocity->x = ATOFF; NEXT
 	velocity->y = ATOFF; NEXT
@@ -3575,9 +3235,7 @@ void Packet::parseVelocityCompensationMeasurement(vec3f* velocity)
 
 void Packet::parseVelocityCompensationControl(uint8_t* mode, float* velocityTuning, float* rateTuning)
 {
-	size_t parseIndex;
-
-	char *result = startAsciiPacketParse(_data, parseIndex); NEXT
+	const char *result = startAsciiPacketParse(_data); NEXT
 
 	*mode = ATOU8; NEXT
 	*velocityTuning = ATOFF; NEXT
@@ -3586,9 +3244,7 @@ void Packet::parseVelocityCompensationControl(uint8_t* mode, float* velocityTuni
 
 void Packet::parseVelocityCompensationStatus(float* x, float* xDot, vec3f* accelOffset, vec3f* omega)
 {
-	size_t parseIndex;
-
-	char *result = startAsciiPacketParse(_data, parseIndex); NEXT
+	const char *result = startAsciiPacketParse(_data); NEXT
 
 	*x = ATOFF; NEXT
 	*xDot = ATOFF; NEXT
@@ -3602,9 +3258,7 @@ void Packet::parseVelocityCompensationStatus(float* x, float* xDot, vec3f* accel
 
 void Packet::parseImuMeasurements(vec3f* mag, vec3f* accel, vec3f* gyro, float* temp, float* pressure)
 {
-	size_t parseIndex;
-
-	char *result = startAsciiPacketParse(_data, parseIndex); NEXT
+	const char *result = startAsciiPacketParse(_data); NEXT
 
 	mag->x = ATOFF; NEXT
 	mag->y = ATOFF; NEXT
@@ -3621,9 +3275,7 @@ void Packet::parseImuMeasurements(vec3f* mag, vec3f* accel, vec3f* gyro, float*
 
 void Packet::parseGpsConfiguration(uint8_t* mode, uint8_t* ppsSource)
 {
-	size_t parseIndex;
-
-	char *result = startAsciiPacketParse(_data, parseIndex); NEXT
+	const char *result = startAsciiPacketParse(_data); NEXT
 
 	*mode = ATOU8; NEXT
 	*ppsSource = ATOU8; NEXT
@@ -3633,9 +3285,7 @@ void Packet::parseGpsConfiguration(uint8_t* mode, uint8_t* ppsSource)
 
 void Packet::parseGpsAntennaOffset(vec3f* position)
 {
-	size_t parseIndex;
-
-	char *result = startAsciiPacketParse(_data, parseIndex); NEXT
+	const char *result = startAsciiPacketParse(_data); NEXT
 
 	position->x = ATOFF; NEXT
 	position->y = ATOFF; NEXT
@@ -3644,9 +3294,7 @@ void Packet::parseGpsAntennaOffset(vec3f* position)
 
 void Packet::parseGpsSolutionLla(double* time, uint16_t* week, uint8_t* gpsFix, uint8_t* numSats, vec3d* lla, vec3f* nedVel, vec3f* nedAcc, float* speedAcc, float* timeAcc)
 {
-	size_t parseIndex;
-
-	char *result = startAsciiPacketParse(_data, parseIndex); NEXT
+	const char *result = startAsciiPacketParse(_data); NEXT
 
 	*time = ATOFD; NEXT
 	*week = ATOU16; NEXT
@@ -3667,9 +3315,7 @@ void Packet::parseGpsSolutionLla(double* time, uint16_t* week, uint8_t* gpsFix,
 
 void Packet::parseGpsSolutionEcef(double* tow, uint16_t* week, uint8_t* gpsFix, uint8_t* numSats, vec3d* position, vec3f* velocity, vec3f* posAcc, float* speedAcc, float* timeAcc)
 {
-	size_t parseIndex;
-
-	char *result = startAsciiPacketParse(_data, parseIndex); NEXT
+	const char *result = startAsciiPacketParse(_data); NEXT
 
 	*tow = ATOFD; NEXT
 	*week = ATOU16; NEXT
@@ -3690,9 +3336,7 @@ void Packet::parseGpsSolutionEcef(double* tow, uint16_t* week, uint8_t* gpsFix,
 
 void Packet::parseInsSolutionLla(double* time, uint16_t* week, uint16_t* status, vec3f* yawPitchRoll, vec3d* position, vec3f* nedVel, float* attUncertainty, float* posUncertainty, float* velUncertainty)
 {
-	size_t parseIndex;
-
-	char *result = startAsciiPacketParse(_data, parseIndex); NEXT
+	const char *result = startAsciiPacketParse(_data); NEXT
 
 	*time = ATOFD; NEXT
 	*week = ATOU16; NEXT
@@ -3713,9 +3357,7 @@ void Packet::parseInsSolutionLla(double* time, uint16_t* week, uint16_t* status,
 
 void Packet::parseInsSolutionEcef(double* time, uint16_t* week, uint16_t* status, vec3f* yawPitchRoll, vec3d* position, vec3f* velocity, float* attUncertainty, float* posUncertainty, float* velUncertainty)
 {
-	size_t parseIndex;
-
-	char *result = startAsciiPacketParse(_data, parseIndex); NEXT
+	const char *result = startAsciiPacketParse(_data); NEXT
 
 	*time = ATOFD; NEXT
 	*week = ATOU16; NEXT
@@ -3736,9 +3378,7 @@ void Packet::parseInsSolutionEcef(double* time, uint16_t* week, uint16_t* status
 
 void Packet::parseInsBasicConfiguration(uint8_t* scenario, uint8_t* ahrsAiding)
 {
-	size_t parseIndex;
-
-	char *result = startAsciiPacketParse(_data, parseIndex); NEXT
+	const char *result = startAsciiPacketParse(_data); NEXT
 
 	*scenario = ATOU8; NEXT
 	*ahrsAiding = ATOU8; NEXT
@@ -3747,9 +3387,7 @@ void Packet::parseInsBasicConfiguration(uint8_t* scenario, uint8_t* ahrsAiding)
 
 void Packet::parseInsBasicConfiguration(uint8_t* scenario, uint8_t* ahrsAiding, uint8_t* estBaseline)
 {
-	size_t parseIndex;
-
-	char *result = startAsciiPacketParse(_data, parseIndex); NEXT
+	const char *result = startAsciiPacketParse(_data); NEXT
 
 	*scenario = ATOU8; NEXT
 	*ahrsAiding = ATOU8; NEXT
@@ -3758,9 +3396,7 @@ void Packet::parseInsBasicConfiguration(uint8_t* scenario, uint8_t* ahrsAiding,
 
 void Packet::parseInsAdvancedConfiguration(uint8_t* useMag, uint8_t* usePres, uint8_t* posAtt, uint8_t* velAtt, uint8_t* velBias, uint8_t* useFoam, uint8_t* gpsCovType, uint8_t* velCount, float* velInit, float* moveOrigin, float* gpsTimeout, float* deltaLimitPos, float* deltaLimitVel, float* minPosUncertainty, float* minVelUncertainty)
 {
-	size_t parseIndex;
-
-	char *result = startAsciiPacketParse(_data, parseIndex); NEXT
+	const char *result = startAsciiPacketParse(_data); NEXT
 
 	*useMag = ATOU8; NEXT
 	*usePres = ATOU8; NEXT
@@ -3781,9 +3417,7 @@ void Packet::parseInsAdvancedConfiguration(uint8_t* useMag, uint8_t* usePres, ui
 
 void Packet::parseInsStateLla(vec3f* yawPitchRoll, vec3d* position, vec3f* velocity, vec3f* accel, vec3f* angularRate)
 {
-	size_t parseIndex;
-
-	char *result = startAsciiPacketParse(_data, parseIndex); NEXT
+	const char *result = startAsciiPacketParse(_data); NEXT
 
 	yawPitchRoll->x = ATOFF; NEXT
 	yawPitchRoll->y = ATOFF; NEXT
@@ -3804,9 +3438,7 @@ void Packet::parseInsStateLla(vec3f* yawPitchRoll, vec3d* position, vec3f* veloc
 
 void Packet::parseInsStateEcef(vec3f* yawPitchRoll, vec3d* position, vec3f* velocity, vec3f* accel, vec3f* angularRate)
 {
-	size_t parseIndex;
-
-	char *result = startAsciiPacketParse(_data, parseIndex); NEXT
+	const char *result = startAsciiPacketParse(_data); NEXT
 
 	yawPitchRoll->x = ATOFF; NEXT
 	yawPitchRoll->y = ATOFF; NEXT
@@ -3827,9 +3459,7 @@ void Packet::parseInsStateEcef(vec3f* yawPitchRoll, vec3d* position, vec3f* velo
 
 void Packet::parseStartupFilterBiasEstimate(vec3f* gyroBias, vec3f* accelBias, float* pressureBias)
 {
-	size_t parseIndex;
-
-	char *result = startAsciiPacketParse(_data, parseIndex); NEXT
+	const char *result = startAsciiPacketParse(_data); NEXT
 
 	gyroBias->x = ATOFF; NEXT
 	gyroBias->y = ATOFF; NEXT
@@ -3842,9 +3472,7 @@ void Packet::parseStartupFilterBiasEstimate(vec3f* gyroBias, vec3f* accelBias, f
 
 void Packet::parseDeltaThetaAndDeltaVelocity(float* deltaTime, vec3f* deltaTheta, vec3f* deltaVelocity)
 {
-	size_t parseIndex;
-
-	char *result = startAsciiPacketParse(_data, parseIndex); NEXT
+	const char *result = startAsciiPacketParse(_data); NEXT
 
 	*deltaTime = ATOFF; NEXT
 	deltaTheta->x = ATOFF; NEXT
@@ -3857,9 +3485,7 @@ void Packet::parseDeltaThetaAndDeltaVelocity(float* deltaTime, vec3f* deltaTheta
 
 void Packet::parseDeltaThetaAndDeltaVelocityConfiguration(uint8_t* integrationFrame, uint8_t* gyroCompensation, uint8_t* accelCompensation)
 {
-	size_t parseIndex;
-
-	char *result = startAsciiPacketParse(_data, parseIndex); NEXT
+	const char *result = startAsciiPacketParse(_data); NEXT
 
 	*integrationFrame = ATOU8; NEXT
 	*gyroCompensation = ATOU8; NEXT
@@ -3869,9 +3495,7 @@ void Packet::parseDeltaThetaAndDeltaVelocityConfiguration(uint8_t* integrationFr
 
 void Packet::parseReferenceVectorConfiguration(uint8_t* useMagModel, uint8_t* useGravityModel, uint32_t* recalcThreshold, float* year, vec3d* position)
 {
-	size_t parseIndex;
-
-	char *result = startAsciiPacketParse(_data, parseIndex); NEXT
+	const char *result = startAsciiPacketParse(_data); NEXT
 
 	*useMagModel = ATOU8; NEXT
 	*useGravityModel = ATOU8; NEXT
@@ -3886,9 +3510,7 @@ void Packet::parseReferenceVectorConfiguration(uint8_t* useMagModel, uint8_t* us
 
 void Packet::parseGyroCompensation(mat3f* c, vec3f* b)
 {
-	size_t parseIndex;
-
-	char *result = startAsciiPacketParse(_data, parseIndex); NEXT
+	const char *result = startAsciiPacketParse(_data); NEXT
 
 	c->e00 = ATOFF; NEXT
 	c->e01 = ATOFF; NEXT
@@ -3906,9 +3528,7 @@ void Packet::parseGyroCompensation(mat3f* c, vec3f* b)
 
 void Packet::parseImuFilteringConfiguration(uint16_t* magWindowSize, uint16_t* accelWindowSize, uint16_t* gyroWindowSize, uint16_t* tempWindowSize, uint16_t* presWindowSize, uint8_t* magFilterMode, uint8_t* accelFilterMode, uint8_t* gyroFilterMode, uint8_t* tempFilterMode, uint8_t* presFilterMode)
 {
-	size_t parseIndex;
-
-	char *result = startAsciiPacketParse(_data, parseIndex); NEXT
+	const char *result = startAsciiPacketParse(_data); NEXT
 
 	*magWindowSize = ATOU16; NEXT
 	*accelWindowSize = ATOU16; NEXT
@@ -3924,9 +3544,7 @@ void Packet::parseImuFilteringConfiguration(uint16_t* magWindowSize, uint16_t* a
 
 void Packet::parseGpsCompassBaseline(vec3f* position, vec3f* uncertainty)
 {
-	size_t parseIndex;
-
-	char *result = startAsciiPacketParse(_data, parseIndex); NEXT
+	const char *result = startAsciiPacketParse(_data); NEXT
 
 	position->x = ATOFF; NEXT
 	position->y = ATOFF; NEXT
@@ -3938,9 +3556,7 @@ void Packet::parseGpsCompassBaseline(vec3f* position, vec3f* uncertainty)
 
 void Packet::parseGpsCompassEstimatedBaseline(uint8_t* estBaselineUsed, uint16_t* numMeas, vec3f* position, vec3f* uncertainty)
 {
-	size_t parseIndex;
-
-	char *result = startAsciiPacketParse(_data, parseIndex); NEXT
+	const char *result = startAsciiPacketParse(_data); NEXT
 
 	*estBaselineUsed = ATOU8; NEXT
 	NEXT
@@ -3955,9 +3571,7 @@ void Packet::parseGpsCompassEstimatedBaseline(uint8_t* estBaselineUsed, uint16_t
 
 void Packet::parseImuRateConfiguration(uint16_t* imuRate, uint16_t* navDivisor, float* filterTargetRate, float* filterMinRate)
 {
-	size_t parseIndex;
-
-	char *result = startAsciiPacketParse(_data, parseIndex); NEXT
+	const char *result = startAsciiPacketParse(_data); NEXT
 
 	*imuRate = ATOU16; NEXT
 	*navDivisor = ATOU16; NEXT
@@ -3967,9 +3581,7 @@ void Packet::parseImuRateConfiguration(uint16_t* imuRate, uint16_t* navDivisor,
 
 void Packet::parseYawPitchRollTrueBodyAccelerationAndAngularRates(vec3f* yawPitchRoll, vec3f* bodyAccel, vec3f* gyro)
 {
-	size_t parseIndex;
-
-	char *result = startAsciiPacketParse(_data, parseIndex); NEXT
+	const char *result = startAsciiPacketParse(_data); NEXT
 
 	yawPitchRoll->x = ATOFF; NEXT
 	yawPitchRoll->y = ATOFF; NEXT
@@ -3984,9 +3596,7 @@ void Packet::parseYawPitchRollTrueBodyAccelerationAndAngularRates(vec3f* yawPitc
 
 void Packet::parseYawPitchRollTrueInertialAccelerationAndAngularRates(vec3f* yawPitchRoll, vec3f* inertialAccel, vec3f* gyro)
 {
-	size_t parseIndex;
-
-	char *result = startAsciiPacketParse(_data, parseIndex); NEXT
+	const char *result = startAsciiPacketParse(_data); NEXT
 
 	yawPitchRoll->x = ATOFF; NEXT
 	yawPitchRoll->y = ATOFF; NEXT
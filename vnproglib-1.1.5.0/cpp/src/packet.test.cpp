@@ -0,0 +1,387 @@
+#include "gtest/gtest.h"
+
+#include "vn/packet.h"
+#include "vn/error_detection.h"
+#include "vn/exceptions.h"
+
+#include <clocale>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace vn::math;
+using namespace vn::protocol::uart;
+using namespace vn::data::integrity;
+
+namespace {
+
+// Builds a binary packet whose common group holds the provided payload,
+// followed by its CRC.
+Packet makeBinaryPacket(const char* payload, size_t length)
+{
+	char packet[64];
+	packet[0] = static_cast<char>(0xFA);
+	packet[1] = 0x01;
+	packet[2] = 0x08;
+	packet[3] = 0x00;
+	if (length > 0)
+		memcpy(packet + 4, payload, length);
+
+	uint16_t crc = Crc16::compute(packet + 1, length + 3);
+	packet[length + 4] = static_cast<char>(crc >> 8);
+	packet[length + 5] = static_cast<char>(crc & 0xFF);
+
+	return Packet(packet, length + 6);
+}
+
+// Deterministic generator so every run sees the same values.
+class FieldRandom
+{
+public:
+	FieldRandom() : _state(88172645463325252ULL) { }
+
+	uint64_t next()
+	{
+		_state ^= _state << 13;
+		_state ^= _state >> 7;
+		_state ^= _state << 17;
+
+		return _state;
+	}
+
+private:
+	uint64_t _state;
+};
+
+// Fields as the sensor formats them along with the unusual forms the ASCII
+// scanner has to hand off to a correctly rounding conversion.
+vector<string> makeFloatingPointFields()
+{
+	const char* const Fixed[] =
+	{
+		"+000.000", "-000.000", "0", "", "+012.345", "-179.999", "+37.4193516",
+		"-122.1234567890123", "+1.23456789012345678", "123456789012345.6",
+		"9007199254740993", "-98765432109876543210.5", "0.1", "+1E+05",
+		"-2.5e-07", "1e22", "1e23", "8.589973e9", "+5.000000E-001",
+		"1.7976931348623157e308", "2.2250738585072011e-308",
+		"4.9406564584124654e-324", "1e-400", "1e400", "-1e400", " 5.5",
+		".5", "5.", "-.25e1", "nan", "-INF"
+	};
+
+	vector<string> fields(Fixed, Fixed + sizeof(Fixed) / sizeof(Fixed[0]));
+
+	const char* const Formats[] = { "%+.3f", "%+.6f", "%+.9f", "%.17g", "%+.6E", "%.20e" };
+
+	FieldRandom rnd;
+	char buffer[64];
+
+	for (size_t i = 0; i < 3000; i++)
+	{
+		uint64_t r = rnd.next();
+
+		// Spread the magnitudes out over the range sensors report.
+		double value = static_cast<double>(r >> 11) / 9007199254740992.0;
+		value = ldexp(value, static_cast<int>(r % 40) - 20);
+
+		if (r & 0x400)
+			value = -value;
+
+		sprintf(buffer, Formats[(r >> 3) % (sizeof(Formats) / sizeof(Formats[0]))], value);
+		fields.push_back(buffer);
+	}
+
+	return fields;
+}
+
+string withChecksum(const string& sentence)
+{
+	char checksum[8];
+	sprintf(checksum, "*%02X\r\n", Checksum8::compute(sentence.c_str() + 1, sentence.length() - 1));
+
+	return sentence + checksum;
+}
+
+// Compares bit for bit so the sign of zero counts, with any NaN equal to
+// any other.
+bool isSameDouble(double a, double b)
+{
+	if (a != a || b != b)
+		return a != a && b != b;
+
+	return memcmp(&a, &b, sizeof(a)) == 0;
+}
+
+bool isSameFloat(float a, float b)
+{
+	if (a != a || b != b)
+		return a != a && b != b;
+
+	return memcmp(&a, &b, sizeof(a)) == 0;
+}
+
+// Checks the fields of a VNINS sentence holding the field in every
+// floating point position, the last of them ending at the '*'.
+void expectInsFieldsMatchStrtod(const string& field)
+{
+	string sentence = "$VNINS," + field + ",2000,0001";
+
+	for (size_t i = 0; i < 12; i++)
+		sentence += "," + field;
+
+	Packet p(withChecksum(sentence));
+
+	double time;
+	uint16_t week, status;
+	vec3f ypr, nedVel;
+	vec3d lla;
+	float attUncertainty, posUncertainty, velUncertainty;
+
+	p.parseVNINS(&time, &week, &status, &ypr, &lla, &nedVel, &attUncertainty, &posUncertainty, &velUncertainty);
+
+	double expected = strtod(field.c_str(), NULL);
+	float expectedFloat = static_cast<float>(expected);
+
+	EXPECT_PRED2(isSameDouble, expected, time) << "field \"" << field << "\"";
+	EXPECT_PRED2(isSameDouble, expected, lla.x) << "field \"" << field << "\"";
+	EXPECT_PRED2(isSameDouble, expected, lla.z) << "field \"" << field << "\"";
+	EXPECT_PRED2(isSameFloat, expectedFloat, ypr.x) << "field \"" << field << "\"";
+	EXPECT_PRED2(isSameFloat, expectedFloat, nedVel.y) << "field \"" << field << "\"";
+	EXPECT_PRED2(isSameFloat, expectedFloat, velUncertainty) << "field \"" << field << "\"";
+	EXPECT_EQ(2000, week);
+	EXPECT_EQ(1, status);
+}
+
+}
+
+TEST(PacketTest, TryExtractReportsTruncatedPacketWithoutThrowing)
+{
+	// Room for a float and a uint16_t but not for a second float.
+	char payload[6];
+	float yaw = 12.5f;
+	memcpy(payload, &yaw, sizeof(yaw));
+	payload[4] = 0x34;
+	payload[5] = 0x12;
+
+	Packet p = makeBinaryPacket(payload, sizeof(payload));
+
+	float f = 0;
+	ASSERT_TRUE(p.tryExtractFloat(f));
+	EXPECT_EQ(12.5f, f);
+
+	// A failed extraction leaves the extraction point where it was.
+	uint32_t u32 = 0;
+	EXPECT_FALSE(p.tryExtractUint32(u32));
+
+	vec3f v3;
+	EXPECT_FALSE(p.tryExtractVec3f(v3));
+
+	uint16_t u16 = 0;
+	ASSERT_TRUE(p.tryExtractUint16(u16));
+	EXPECT_EQ(0x1234, u16);
+
+	uint8_t u8 = 0;
+	EXPECT_FALSE(p.tryExtractUint8(u8));
+	EXPECT_THROW(p.extractUint8(), std::exception);
+}
+
+TEST(PacketTest, TryExtractFailsOnPacketWithoutPayload)
+{
+	Packet p = makeBinaryPacket(NULL, 0);
+
+	uint8_t u8;
+	uint64_t u64;
+	vec3d v3d;
+	vec4f v4f;
+	mat3f m3f;
+
+	EXPECT_FALSE(p.tryExtractUint8(u8));
+	EXPECT_FALSE(p.tryExtractUint64(u64));
+	EXPECT_FALSE(p.tryExtractVec3d(v3d));
+	EXPECT_FALSE(p.tryExtractVec4f(v4f));
+	EXPECT_FALSE(p.tryExtractMat3f(m3f));
+
+	EXPECT_THROW(p.extractFloat(), std::exception);
+}
+
+TEST(PacketTest, AsciiFloatingPointFieldsMatchStrtod)
+{
+	vector<string> fields = makeFloatingPointFields();
+
+	for (size_t i = 0; i < fields.size(); i++)
+		expectInsFieldsMatchStrtod(fields[i]);
+}
+
+TEST(PacketTest, AsciiIntegerFieldsMatchStrtoul)
+{
+	const char* const Decimal[] = { "0", "2000", "+0012", "65535", "", "7" };
+	const char* const Hex[] = { "0000", "0001", "ABCD", "abcd", "0x1F", "FFFF", "" };
+
+	for (size_t i = 0; i < sizeof(Decimal) / sizeof(Decimal[0]); i++)
+	{
+		for (size_t j = 0; j < sizeof(Hex) / sizeof(Hex[0]); j++)
+		{
+			string sentence = string("$VNINS,1.0,") + Decimal[i] + "," + Hex[j];
+
+			for (size_t k = 0; k < 12; k++)
+				sentence += ",1.0";
+
+			Packet p(withChecksum(sentence));
+
+			double time;
+			uint16_t week, status;
+			vec3f ypr, nedVel;
+			vec3d lla;
+			float attUncertainty, posUncertainty, velUncertainty;
+
+			p.parseVNINS(&time, &week, &status, &ypr, &lla, &nedVel, &attUncertainty, &posUncertainty, &velUncertainty);
+
+			EXPECT_EQ(static_cast<uint16_t>(strtoul(Decimal[i], NULL, 10)), week) << "field \"" << Decimal[i] << "\"";
+			EXPECT_EQ(static_cast<uint16_t>(strtoul(Hex[j], NULL, 16)), status) << "field \"" << Hex[j] << "\"";
+		}
+	}
+}
+
+TEST(PacketTest, AsciiFieldsDoNotDependOnTheLocale)
+{
+	const char* const CommaLocales[] = { "de_DE.UTF-8", "de_DE", "fr_FR.UTF-8", "fr_FR", "German" };
+
+	string previous = setlocale(LC_NUMERIC, NULL);
+	bool isCommaLocale = false;
+
+	for (size_t i = 0; i < sizeof(CommaLocales) / sizeof(CommaLocales[0]) && !isCommaLocale; i++)
+		isCommaLocale = setlocale(LC_NUMERIC, CommaLocales[i]) != NULL;
+
+	if (!isCommaLocale)
+		GTEST_SKIP() << "No locale with a ',' decimal point is installed.";
+
+	Packet p(withChecksum("$VNYMR,+012.345,-1.23456789012345678,+1E+05,1.0,2.0,3.0,4.0,5.0,6.0,7.0,8.0,+9.5"));
+
+	vec3f ypr, mag, accel, angularRate;
+	p.parseVNYMR(&ypr, &mag, &accel, &angularRate);
+
+	setlocale(LC_NUMERIC, previous.c_str());
+
+	EXPECT_EQ(12.345f, ypr.x);
+	EXPECT_EQ(static_cast<float>(-1.23456789012345678), ypr.y);
+	EXPECT_EQ(1e5f, ypr.z);
+	EXPECT_EQ(9.5f, angularRate.z);
+}
+
+namespace {
+
+// The headers the library recognized before packets were classified with a
+// switch, kept as the lists of strncmp comparisons they used to be.
+const char* const ResponseHeaders[] =
+{
+	"WRG", "RRG", "WNV", "RFS", "RST", "FWU", "CMD", "ASY", "TAR", "KMD", "KAD", "SGB"
+};
+
+struct AsciiAsyncHeader
+{
+	const char* header;
+	AsciiAsync type;
+};
+
+const AsciiAsyncHeader AsciiAsyncHeaders[] =
+{
+	{ "YPR", VNYPR }, { "QTN", VNQTN }, { "QMR", VNQMR }, { "MAG", VNMAG },
+	{ "ACC", VNACC }, { "GYR", VNGYR }, { "MAR", VNMAR }, { "YMR", VNYMR },
+	{ "YBA", VNYBA }, { "YIA", VNYIA }, { "IMU", VNIMU }, { "GPS", VNGPS },
+	{ "GPE", VNGPE }, { "INS", VNINS }, { "INE", VNINE }, { "ISL", VNISL },
+	{ "ISE", VNISE }, { "DTV", VNDTV }, { "G2S", VNG2S }, { "G2E", VNG2E }
+};
+
+bool isReferenceResponse(const char* header)
+{
+	for (size_t i = 0; i < sizeof(ResponseHeaders) / sizeof(ResponseHeaders[0]); i++)
+	{
+		if (strncmp(header, ResponseHeaders[i], 3) == 0)
+			return true;
+	}
+
+	return false;
+}
+
+// Returns VNOFF for a header which is not an ASCII asynchronous message.
+AsciiAsync referenceAsciiAsyncType(const char* header)
+{
+	for (size_t i = 0; i < sizeof(AsciiAsyncHeaders) / sizeof(AsciiAsyncHeaders[0]); i++)
+	{
+		if (strncmp(header, AsciiAsyncHeaders[i].header, 3) == 0)
+			return AsciiAsyncHeaders[i].type;
+	}
+
+	return VNOFF;
+}
+
+void expectClassifiedAsReference(Packet& p, const char* header)
+{
+	AsciiAsync expectedType = referenceAsciiAsyncType(header);
+
+	EXPECT_EQ(strncmp(header, "ERR", 3) == 0, p.isError()) << header;
+	EXPECT_EQ(isReferenceResponse(header), p.isResponse()) << header;
+	EXPECT_EQ(expectedType != VNOFF, p.isAsciiAsync()) << header;
+
+	if (expectedType != VNOFF)
+	{
+		EXPECT_EQ(expectedType, p.determineAsciiAsyncType()) << header;
+	}
+	else
+	{
+		EXPECT_THROW(p.determineAsciiAsyncType(), vn::unknown_error) << header;
+	}
+}
+
+}
+
+TEST(PacketTest, ClassificationMatchesHeaderComparisonsForEveryHeader)
+{
+	const char Characters[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+	const size_t NumOfCharacters = sizeof(Characters) - 1;
+
+	char header[4] = { 0 };
+
+	for (size_t a = 0; a < NumOfCharacters; a++)
+	{
+		for (size_t b = 0; b < NumOfCharacters; b++)
+		{
+			for (size_t c = 0; c < NumOfCharacters; c++)
+			{
+				header[0] = Characters[a];
+				header[1] = Characters[b];
+				header[2] = Characters[c];
+
+				Packet p(withChecksum(string("$VN") + header + ",1,2"));
+
+				expectClassifiedAsReference(p, header);
+
+				// A copy keeps the classification rather than redoing it.
+				Packet copy(p);
+				expectClassifiedAsReference(copy, header);
+			}
+		}
+	}
+}
+
+TEST(PacketTest, BinaryPacketSpellingAHeaderIsNotClassifiedAsAscii)
+{
+	const char* const Payloads[] = { "ERR", "RRG", "YPR", "INS" };
+
+	for (size_t i = 0; i < sizeof(Payloads) / sizeof(Payloads[0]); i++)
+	{
+		// Bytes 3 to 5 of the packet are the header of an ASCII message.
+		char packet[18] = { static_cast<char>(0xFA), 0x01, 0x08 };
+		memcpy(packet + 3, Payloads[i], 3);
+
+		Packet p(packet, sizeof(packet));
+
+		EXPECT_FALSE(p.isError()) << Payloads[i];
+		EXPECT_FALSE(p.isResponse()) << Payloads[i];
+		EXPECT_FALSE(p.isAsciiAsync()) << Payloads[i];
+		EXPECT_THROW(p.determineAsciiAsyncType(), vn::unknown_error) << Payloads[i];
+	}
+}
@@ -0,0 +1,88 @@
+#include "benchmark/benchmark.h"
+#include "benchmark.h"
+
+#include "vn/packetfinder.h"
+#include "vn/error_detection.h"
+
+#include <cstdio>
+#include <vector>
+
+using namespace std;
+using namespace vn::xplat;
+using namespace vn::data::integrity;
+using namespace vn::protocol::uart;
+
+namespace {
+
+// Stands in for a capture of the 800 Hz INS+IMU output, optionally with an
+// ASCII async message after every eighth binary packet.
+vector<char> makeCapture(bool withAsciiMessages)
+{
+	vector<char> capture;
+
+	for (uint32_t i = 0; i < 8000; i++)
+	{
+		vector<char> packet = makeInsAndImuPacket(i);
+		capture.insert(capture.end(), packet.begin(), packet.end());
+
+		if (withAsciiMessages && i % 8 == 0)
+		{
+			char body[64];
+			int length = sprintf(body, "VNYPR,%+08.3f,%+08.3f,%+08.3f", i * 0.01, -1.5, 120.25);
+
+			char message[80];
+			int messageLength = sprintf(message, "$%s*%02X\r\n", body, Checksum8::compute(body, length));
+
+			capture.insert(capture.end(), message, message + messageLength);
+		}
+	}
+
+	return capture;
+}
+
+void countPacket(void* userData, Packet&, size_t, TimeStamp)
+{
+	(*static_cast<size_t*>(userData))++;
+}
+
+// Feeds the capture in reads of state.range(0) bytes.
+void feedCapture(benchmark::State& state, vector<char>& capture)
+{
+	size_t numOfPackets = 0;
+	size_t readSize = static_cast<size_t>(state.range(0));
+
+	PacketFinder finder;
+	finder.registerPossiblePacketFoundHandler(&numOfPackets, countPacket);
+
+	while (state.KeepRunning())
+	{
+		for (size_t pos = 0; pos < capture.size(); pos += readSize)
+		{
+			size_t length = capture.size() - pos < readSize ? capture.size() - pos : readSize;
+
+			finder.processReceivedData(&capture[pos], length);
+		}
+	}
+
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * capture.size()));
+	state.counters["packets"] = benchmark::Counter(static_cast<double>(numOfPackets), benchmark::Counter::kIsRate);
+}
+
+void PacketFinder_BinaryCapture(benchmark::State& state)
+{
+	vector<char> capture = makeCapture(false);
+
+	feedCapture(state, capture);
+}
+
+void PacketFinder_MixedCapture(benchmark::State& state)
+{
+	vector<char> capture = makeCapture(true);
+
+	feedCapture(state, capture);
+}
+
+}
+
+BENCHMARK(PacketFinder_BinaryCapture)->Arg(1)->Arg(64)->Arg(512)->Arg(4096);
+BENCHMARK(PacketFinder_MixedCapture)->Arg(64)->Arg(512)->Arg(4096);
@@ -1,11 +1,19 @@
 #include "vn/packetfinder.h"
 #include "vn/utilities.h"
 #include "vn/error_detection.h"
+#include "vn/compiler.h"
+#include "vn/cpu.h"
 
-#include <queue>
-#include <list>
 #include <cstring>
 
+#if VN_HAVE_X86_DISPATCH
+	#include <emmintrin.h>
+	#include <immintrin.h>
+	#if defined(_MSC_VER)
+		#include <intrin.h>
+	#endif
+#endif
+
 #if PYTHON
 	#include "boostpython.h"
 	namespace bp = boost::python;
@@ -31,27 +39,30 @@ struct BinaryTracker
 	bool startFoundInProvidedDataBuffer;
 	size_t runningDataIndexOfStart;
 	vn::xplat::TimeStamp timeFound;
+	uint16_t runningCrc;	// CRC of the bytes received after the start character.
+	BinaryTracker() :
+		possibleStartIndex(0),
+		groupsPresentFound(false),
+		groupsPresent(0),
+		numOfBytesRemainingToHaveAllGroupFields(0),
+		numOfBytesRemainingForCompletePacket(0),
+		startFoundInProvidedDataBuffer(true),
+		runningDataIndexOfStart(0),
+		runningCrc(0)
+	{ }
 	explicit BinaryTracker(size_t possibleStartIndex, size_t runningDataIndex, TimeStamp timeFound_) :
 		possibleStartIndex(possibleStartIndex),
 		groupsPresentFound(false),
+		groupsPresent(0),
 		numOfBytesRemainingToHaveAllGroupFields(0),
 		numOfBytesRemainingForCompletePacket(0),
 		startFoundInProvidedDataBuffer(true),
 		runningDataIndexOfStart(runningDataIndex),
-		timeFound(timeFound_)
+		timeFound(timeFound_),
+		runningCrc(0)
 	{ }
 };
 
-bool operator==(const BinaryTracker& lhs, const BinaryTracker& rhs)
-{
-	return
-		lhs.possibleStartIndex == rhs.possibleStartIndex &&
-		lhs.groupsPresentFound == rhs.groupsPresentFound &&
-		lhs.groupsPresent == rhs.groupsPresent &&
-		lhs.numOfBytesRemainingToHaveAllGroupFields == rhs.numOfBytesRemainingToHaveAllGroupFields &&
-		lhs.numOfBytesRemainingForCompletePacket == rhs.numOfBytesRemainingForCompletePacket;
-}
-
 struct PacketFinder::Impl
 {
 	static const size_t DefaultReceiveBufferSize = 512;
@@ -63,6 +74,25 @@ struct PacketFinder::Impl
 	static const size_t MaximumSizeForBinaryStartAndAllGroupData = 18;
 	static const size_t MaximumSizeForAsciiPacket = 256;
 
+	// Maximum number of possible binary packets tracked at once. A tracker
+	// either completes or is found invalid by the time it has seen its
+	// largest possible header plus the largest packet body we accept, so
+	// with one tracker per byte over that span a real packet start never
+	// finds all of the trackers in use.
+	static const size_t MaximumNumberOfBinaryTrackers = MaximumSizeForBinaryStartAndAllGroupData + MaximumSizeExpectedForBinaryPacket;
+
+	// Scans [begin, end) and returns a pointer to the first byte which can
+	// start or end a packet, or end if there is none.
+	typedef const uint8_t* (*SyncCandidateScanner)(const uint8_t* begin, const uint8_t* end);
+
+	// Result of feeding a byte to a binary tracker.
+	enum BinaryTrackerStatus
+	{
+		BINARY_TRACKER_INCOMPLETE,	///< Tracker still needs more data.
+		BINARY_TRACKER_INVALID,		///< Tracker cannot be a valid packet.
+		BINARY_TRACKER_COMPLETE		///< Tracker has a complete possible packet.
+	};
+
 	struct AsciiTracker
 	{
 		bool currentlyBuildingAsciiPacket;
@@ -89,12 +119,21 @@ struct PacketFinder::Impl
 	};
 
 	PacketFinder* _backReference;
+
+	// Holds the bytes of packets still being built when the data provided
+	// runs out, from the start of the oldest one onward. Packets which are
+	// complete within the data provided are found where they lie and never
+	// copied here. It is allocated once and starts over from the beginning
+	// whenever no packet is pending, so it is used as a linear buffer rather
+	// than a ring; what it holds never has to wrap around its end.
 	uint8_t* _buffer;
 	const size_t _bufferSize;
 	size_t _bufferAppendLocation;
 	AsciiTracker _asciiOnDeck;
-	list<BinaryTracker> _binaryOnDeck;	// Collection of possible binary packets we are checking.
+	BinaryTracker _binaryOnDeck[MaximumNumberOfBinaryTrackers];	// Collection of possible binary packets we are checking.
+	size_t _binaryOnDeckCount;			// Number of entries in use in _binaryOnDeck.
 	size_t _runningDataIndex;			// Used for correlating raw data with where the packet was found for the end user.
+	SyncCandidateScanner _findSyncCandidate;	// Fastest scanner supported by the processor.
 	void* _possiblePacketFoundUserData;
 	ValidPacketFoundHandler _possiblePacketFoundHandler;
 	#if PYTHON
@@ -107,7 +146,9 @@ struct PacketFinder::Impl
 		_buffer(new uint8_t[DefaultReceiveBufferSize]),
 		_bufferSize(DefaultReceiveBufferSize),
 		_bufferAppendLocation(0),
+		_binaryOnDeckCount(0),
 		_runningDataIndex(0),
+		_findSyncCandidate(selectSyncCandidateScanner()),
 		_possiblePacketFoundUserData(NULL),
 		_possiblePacketFoundHandler(NULL)
 		#if PYTHON
@@ -121,7 +162,9 @@ struct PacketFinder::Impl
 		_buffer(new uint8_t[internalReceiveBufferSize]),
 		_bufferSize(internalReceiveBufferSize),
 		_bufferAppendLocation(0),
+		_binaryOnDeckCount(0),
 		_runningDataIndex(0),
+		_findSyncCandidate(selectSyncCandidateScanner()),
 		_possiblePacketFoundUserData(NULL),
 		_possiblePacketFoundHandler(NULL)
 	{ }
@@ -134,10 +177,144 @@ struct PacketFinder::Impl
 	void resetTracking()
 	{
 		_asciiOnDeck.reset();
-		_binaryOnDeck.clear();
+		_binaryOnDeckCount = 0;
 		_bufferAppendLocation = 0;
 	}
 
+	static bool isSyncCandidate(uint8_t b)
+	{
+		return b == BinaryStartChar || b == AsciiStartChar || b == AsciiEndChar1 || b == AsciiEndChar2;
+	}
+
+	static const uint8_t* findSyncCandidateScalar(const uint8_t* begin, const uint8_t* end)
+	{
+		for (; begin != end; ++begin)
+		{
+			if (isSyncCandidate(*begin))
+				return begin;
+		}
+
+		return end;
+	}
+
+	#if VN_HAVE_X86_DISPATCH
+
+	static uint32_t indexOfLowestSetBit(uint32_t v)
+	{
+		#if defined(_MSC_VER)
+		unsigned long index;
+		_BitScanForward(&index, v);
+		return index;
+		#else
+		return __builtin_ctz(v);
+		#endif
+	}
+
+	VN_TARGET("sse2")
+	static const uint8_t* findSyncCandidateSse2(const uint8_t* begin, const uint8_t* end)
+	{
+		const __m128i binaryStart = _mm_set1_epi8(static_cast<char>(BinaryStartChar));
+		const __m128i asciiStart = _mm_set1_epi8(static_cast<char>(AsciiStartChar));
+		const __m128i asciiEnd1 = _mm_set1_epi8(static_cast<char>(AsciiEndChar1));
+		const __m128i asciiEnd2 = _mm_set1_epi8(static_cast<char>(AsciiEndChar2));
+
+		for (; end - begin >= 16; begin += 16)
+		{
+			__m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+
+			__m128i matches = _mm_or_si128(
+				_mm_or_si128(_mm_cmpeq_epi8(block, binaryStart), _mm_cmpeq_epi8(block, asciiStart)),
+				_mm_or_si128(_mm_cmpeq_epi8(block, asciiEnd1), _mm_cmpeq_epi8(block, asciiEnd2)));
+
+			uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(matches));
+
+			if (mask != 0)
+				return begin + indexOfLowestSetBit(mask);
+		}
+
+		return findSyncCandidateScalar(begin, end);
+	}
+
+	VN_TARGET("avx2")
+	static const uint8_t* findSyncCandidateAvx2(const uint8_t* begin, const uint8_t* end)
+	{
+		const __m256i binaryStart = _mm256_set1_epi8(static_cast<char>(BinaryStartChar));
+		const __m256i asciiStart = _mm256_set1_epi8(static_cast<char>(AsciiStartChar));
+		const __m256i asciiEnd1 = _mm256_set1_epi8(static_cast<char>(AsciiEndChar1));
+		const __m256i asciiEnd2 = _mm256_set1_epi8(static_cast<char>(AsciiEndChar2));
+
+		for (; end - begin >= 32; begin += 32)
+		{
+			__m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+
+			__m256i matches = _mm256_or_si256(
+				_mm256_or_si256(_mm256_cmpeq_epi8(block, binaryStart), _mm256_cmpeq_epi8(block, asciiStart)),
+				_mm256_or_si256(_mm256_cmpeq_epi8(block, asciiEnd1), _mm256_cmpeq_epi8(block, asciiEnd2)));
+
+			uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(matches));
+
+			if (mask != 0)
+				return begin + indexOfLowestSetBit(mask);
+		}
+
+		return findSyncCandidateSse2(begin, end);
+	}
+
+	#endif
+
+	static SyncCandidateScanner selectSyncCandidateScanner()
+	{
+		#if VN_HAVE_X86_DISPATCH
+		if (Cpu::hasAvx2())
+			return &findSyncCandidateAvx2;
+		if (Cpu::hasSse2())
+			return &findSyncCandidateSse2;
+		#endif
+
+		return &findSyncCandidateScalar;
+	}
+
+	// Returns the number of bytes starting at data[i] that can be consumed
+	// without doing anything other than counting down the payload of the
+	// binary packets on deck. These are the bytes before the next sync
+	// candidate, the end of any binary packet on deck, or the point where an
+	// ASCII packet on deck becomes too long.
+	size_t numOfBytesSafeToSkip(uint8_t data[], size_t i, size_t length)
+	{
+		size_t end = length;
+
+		if (_asciiOnDeck.asciiEndChar1Found)
+			return 0;
+
+		if (_asciiOnDeck.currentlyBuildingAsciiPacket)
+		{
+			size_t numOfAsciiBytesSoFar = _runningDataIndex - _asciiOnDeck.runningDataIndexOfStart;
+
+			if (numOfAsciiBytesSoFar >= MaximumSizeForAsciiPacket)
+				return 0;
+
+			if (end - i > MaximumSizeForAsciiPacket - numOfAsciiBytesSoFar)
+				end = i + MaximumSizeForAsciiPacket - numOfAsciiBytesSoFar;
+		}
+
+		for (size_t t = 0; t < _binaryOnDeckCount; t++)
+		{
+			const BinaryTracker &bt = _binaryOnDeck[t];
+
+			// Header bytes and the last byte of a packet are always handled
+			// one at a time.
+			if (!bt.groupsPresentFound
+				|| bt.numOfBytesRemainingToHaveAllGroupFields != 0
+				|| bt.numOfBytesRemainingForCompletePacket <= 1)
+				return 0;
+
+			if (i + bt.numOfBytesRemainingForCompletePacket - 1 < end)
+				end = i + bt.numOfBytesRemainingForCompletePacket - 1;
+		}
+
+		return _findSyncCandidate(data + i, data + end) - (data + i);
+	}
+
 	void dataReceived(uint8_t data[], size_t length, TimeStamp timestamp)
 	{
 		bool asciiStartFoundInProvidedBuffer = false;
@@ -146,6 +323,25 @@ struct PacketFinder::Impl
 		// will naturally go to zero, which is the behavior that we want.
 		for (size_t i = 0; i < length; i++, _runningDataIndex++)
 		{
+			// Consume in bulk any bytes that cannot start or end a packet.
+			size_t numOfBytesToSkip = numOfBytesSafeToSkip(data, i, length);
+			if (numOfBytesToSkip != 0)
+			{
+				for (size_t t = 0; t < _binaryOnDeckCount; t++)
+				{
+					BinaryTracker &bt = _binaryOnDeck[t];
+
+					bt.numOfBytesRemainingForCompletePacket -= numOfBytesToSkip;
+					bt.runningCrc = Crc16::update(bt.runningCrc, reinterpret_cast<char*>(data) + i, numOfBytesToSkip);
+				}
+
+				i += numOfBytesToSkip;
+				_runningDataIndex += numOfBytesToSkip;
+
+				if (i == length)
+					break;
+			}
+
 			if (data[i] == AsciiStartChar)
 			{
 				_asciiOnDeck.reset();
@@ -197,23 +393,26 @@ struct PacketFinder::Impl
 						}
 					}
 
-					Packet p(reinterpret_cast<char*>(startOfAsciiPacket), packetLength);
+					// Parsing ASCII packets does not modify them so, as with
+					// binary packets, a view is enough.
+					PacketView p(reinterpret_cast<char*>(startOfAsciiPacket), packetLength);
 
 					if (p.isValid())
 						dispatchPacket(p, runningIndexOfPacketStart, _asciiOnDeck.timeFound);
 				}
 				
 				// Either this is an invalid packet or was a packet that was processed.
-				if (_binaryOnDeck.empty())
+				if (_binaryOnDeckCount == 0)
 					resetTracking();
 				else
 					_asciiOnDeck.reset();
 				asciiStartFoundInProvidedBuffer = false;
 			}
-			else if (i + 1 > MaximumSizeForAsciiPacket)
+			else if (_asciiOnDeck.currentlyBuildingAsciiPacket
+				&& _runningDataIndex - _asciiOnDeck.runningDataIndexOfStart + 1 > MaximumSizeForAsciiPacket)
 			{
 				// This must not be a valid ASCII packet.
-				if (_binaryOnDeck.empty())
+				if (_binaryOnDeckCount == 0)
 				{
 					resetTracking();
 				}
@@ -224,160 +423,66 @@ struct PacketFinder::Impl
 				}
 			}
 
-			// Update all of our binary packets on deck.
-			queue<BinaryTracker> invalidPackets;
-			for (list<BinaryTracker>::iterator it = _binaryOnDeck.begin(); it != _binaryOnDeck.end(); ++it)
+			// Update all of our binary packets on deck, compacting out any
+			// invalid trackers in place.
+			size_t numOfTrackersKept = 0;
+			bool packetDispatched = false;
+			for (size_t t = 0; t < _binaryOnDeckCount; t++)
 			{
-				BinaryTracker &ez = (*it);
+				uint8_t* packetStart = NULL;
+				size_t packetLength = 0;
 
-				if (!ez.groupsPresentFound)
-				{
-					// This byte must be the groups present.
-					ez.groupsPresentFound = true;
-					ez.groupsPresent = data[i];
-					ez.numOfBytesRemainingToHaveAllGroupFields = 2 * countSetBits(data[i]);
-
-					continue;
-				}
+				BinaryTrackerStatus status = updateBinaryTracker(_binaryOnDeck[t], data, i, packetStart, packetLength);
 
-				if (ez.numOfBytesRemainingToHaveAllGroupFields != 0)
+				if (status == BINARY_TRACKER_COMPLETE)
 				{
-					// We found another byte belonging to this possible binary packet.
-					ez.numOfBytesRemainingToHaveAllGroupFields--;
-
-					if (ez.numOfBytesRemainingToHaveAllGroupFields == 0)
-					{
-						// We have all of the group fields now.
-						size_t remainingBytesForCompletePacket;
-						if (ez.startFoundInProvidedDataBuffer)
-						{
-							size_t headerLength = i - ez.possibleStartIndex + 1;
-							remainingBytesForCompletePacket = Packet::computeBinaryPacketLength(reinterpret_cast<char*>(data) + ez.possibleStartIndex) - headerLength;
-						}
-						else
-						{
-							// Not all of the packet's group is inside the caller's provided buffer.
-
-							// Temporarily copy the rest of the packet to the receive buffer
-							// for computing the size of the packet.
+					// We have a valid binary packet!!!. The tracker already
+					// checked the CRC while the packet's bytes arrived.
 
-							size_t numOfBytesToCopyIntoReceiveBuffer = i + 1;
-							size_t headerLength = _bufferAppendLocation - ez.possibleStartIndex + numOfBytesToCopyIntoReceiveBuffer;
+					// The packet's bytes stay in place until dispatch returns
+					// so a view is enough.
+					PacketView p(reinterpret_cast<char*>(packetStart), packetLength);
+					p.markAsValid();
 
-							if (_bufferAppendLocation + numOfBytesToCopyIntoReceiveBuffer < _bufferSize)
-							{
-								std::memcpy(_buffer + _bufferAppendLocation, data, numOfBytesToCopyIntoReceiveBuffer);
+					// Copy data out of the tracking lists since we will be resetting them.
+					BinaryTracker bt = _binaryOnDeck[t];
 
-								remainingBytesForCompletePacket = Packet::computeBinaryPacketLength(reinterpret_cast<char*>(_buffer) + ez.possibleStartIndex) - headerLength;
-							}
-							else
-							{
-								// About to overrun our receive buffer!
-								invalidPackets.push(ez);
-
-								// TODO: Should we just go ahead and clear the ASCII tracker
-								//       and buffer append location?
+					resetTracking();
 
-								continue;
-							}
-						}
+					dispatchPacket(p, bt.runningDataIndexOfStart, bt.timeFound);
 
-						if (remainingBytesForCompletePacket > MaximumSizeExpectedForBinaryPacket)
-						{
-							// Must be a bad possible binary packet.
-							invalidPackets.push(ez);
-						}
-						else
-						{
-							ez.numOfBytesRemainingForCompletePacket = remainingBytesForCompletePacket;
-						}
-					}
+					packetDispatched = true;
 
-					continue;
+					break;
 				}
 
-				// We are currently collecting data for our packet.
-
-				ez.numOfBytesRemainingForCompletePacket--;
-
-				if (ez.numOfBytesRemainingForCompletePacket == 0)
-				{
-					// We have a possible binary packet!
-
-					uint8_t* packetStart;
-					size_t packetLength;
-
-					if (ez.startFoundInProvidedDataBuffer)
-					{
-						// The binary packet exists completely in the user's provided buffer.
-						packetStart = data + ez.possibleStartIndex;
-						packetLength = i - ez.possibleStartIndex + 1;
-					}
-					else
-					{
-						// The packet is split between our receive buffer and the user's buffer.
-						size_t numOfBytesToCopyIntoReceiveBuffer = i + 1;
-
-						if (_bufferAppendLocation + numOfBytesToCopyIntoReceiveBuffer < _bufferSize)
-						{
-							std::memcpy(_buffer + _bufferAppendLocation, data, numOfBytesToCopyIntoReceiveBuffer);
-
-							packetStart = _buffer + ez.possibleStartIndex;
-							packetLength = _bufferAppendLocation - ez.possibleStartIndex + i + 1;
-						}
-						else
-						{
-							// About to overrun our receive buffer!
-							invalidPackets.push(ez);
-
-							continue;
-						}
-					}
-
-					Packet p(reinterpret_cast<char*>(packetStart), packetLength);
-
-					if (!p.isValid())
-					{
-						// Invalid packet!
-						invalidPackets.push(ez);
-					}
-					else
-					{
-						// We have a valid binary packet!!!.
-
-						// Copy data out of the tracking lists since we will be resetting them.
-						BinaryTracker bt = ez;
-
-						invalidPackets = queue<BinaryTracker>();
-						resetTracking();
+				if (status == BINARY_TRACKER_INVALID)
+					continue;
 
-						dispatchPacket(p, bt.runningDataIndexOfStart, bt.timeFound);
+				if (numOfTrackersKept != t)
+					_binaryOnDeck[numOfTrackersKept] = _binaryOnDeck[t];
 
-						break;
-					}
-				}
+				numOfTrackersKept++;
 			}
 
-			// Remove any invalid packets.
-			while (!invalidPackets.empty())
-			{
-				_binaryOnDeck.remove(invalidPackets.front());
-				invalidPackets.pop();
-			}
+			if (!packetDispatched)
+				_binaryOnDeckCount = numOfTrackersKept;
 
-			if (_binaryOnDeck.empty() && !_asciiOnDeck.currentlyBuildingAsciiPacket)
+			if (_binaryOnDeckCount == 0 && !_asciiOnDeck.currentlyBuildingAsciiPacket)
 			{
 				_bufferAppendLocation = 0;
 			}
 
 			if (data[i] == BinaryStartChar)
 			{
-				// Possible start of a binary packet.
-				_binaryOnDeck.push_back(BinaryTracker(i, _runningDataIndex, timestamp));
+				// Possible start of a binary packet. There is always room
+				// since the count is bounded by the packet length limits.
+				if (_binaryOnDeckCount < MaximumNumberOfBinaryTrackers)
+					_binaryOnDeck[_binaryOnDeckCount++] = BinaryTracker(i, _runningDataIndex, timestamp);
 			}
 		}
 
-		if (_binaryOnDeck.empty() && !_asciiOnDeck.currentlyBuildingAsciiPacket)
+		if (_binaryOnDeckCount == 0 && !_asciiOnDeck.currentlyBuildingAsciiPacket)
 			// No data to copy over.
 			return;
 
@@ -387,13 +492,13 @@ struct PacketFinder::Impl
 		bool binaryDataToCopyOver = false;
 		size_t binaryDataMoveOverIndexAdjustment = 0;
 
-		if (!_binaryOnDeck.empty())
+		if (_binaryOnDeckCount != 0)
 		{
 			binaryDataToCopyOver = true;
 
-			if (_binaryOnDeck.front().startFoundInProvidedDataBuffer)
+			if (_binaryOnDeck[0].startFoundInProvidedDataBuffer)
 			{
-				dataIndexToStartCopyingFrom = _binaryOnDeck.front().possibleStartIndex;
+				dataIndexToStartCopyingFrom = _binaryOnDeck[0].possibleStartIndex;
 				binaryDataMoveOverIndexAdjustment = dataIndexToStartCopyingFrom;
 			}
 		}
@@ -415,12 +520,14 @@ struct PacketFinder::Impl
 		}
 
 		// Adjust any binary packet indexes we are currently building.
-		for (list<BinaryTracker>::iterator it = _binaryOnDeck.begin(); it != _binaryOnDeck.end(); ++it)
+		for (size_t t = 0; t < _binaryOnDeckCount; t++)
 		{
-			if ((*it).startFoundInProvidedDataBuffer)
+			BinaryTracker &bt = _binaryOnDeck[t];
+
+			if (bt.startFoundInProvidedDataBuffer)
 			{
-				(*it).startFoundInProvidedDataBuffer = false;
-				(*it).possibleStartIndex = (*it).possibleStartIndex - binaryDataMoveOverIndexAdjustment + _bufferAppendLocation;
+				bt.startFoundInProvidedDataBuffer = false;
+				bt.possibleStartIndex = bt.possibleStartIndex - binaryDataMoveOverIndexAdjustment + _bufferAppendLocation;
 			}
 		}
 
@@ -441,6 +548,125 @@ struct PacketFinder::Impl
 		}
 	}
 
+	// Feeds the byte at data[i] to a binary tracker. When the tracker has
+	// collected a complete packet with a good CRC, packetStart and
+	// packetLength are set to where the packet's bytes are located.
+	BinaryTrackerStatus updateBinaryTracker(BinaryTracker &ez, uint8_t data[], size_t i, uint8_t* &packetStart, size_t &packetLength)
+	{
+		ez.runningCrc = Crc16::update(ez.runningCrc, reinterpret_cast<char*>(data) + i, 1);
+
+		if (!ez.groupsPresentFound)
+		{
+			// This byte must be the groups present.
+			ez.groupsPresentFound = true;
+			ez.groupsPresent = data[i];
+			ez.numOfBytesRemainingToHaveAllGroupFields = 2 * countSetBits(data[i]);
+
+			// A binary packet always has at least one group present. Without
+			// this check the tracker would never complete and would hold one
+			// of our fixed tracker slots until tracking is reset.
+			if (ez.numOfBytesRemainingToHaveAllGroupFields == 0)
+				return BINARY_TRACKER_INVALID;
+
+			return BINARY_TRACKER_INCOMPLETE;
+		}
+
+		if (ez.numOfBytesRemainingToHaveAllGroupFields != 0)
+		{
+			// We found another byte belonging to this possible binary packet.
+			ez.numOfBytesRemainingToHaveAllGroupFields--;
+
+			if (ez.numOfBytesRemainingToHaveAllGroupFields == 0)
+			{
+				// We have all of the group fields now.
+				size_t remainingBytesForCompletePacket;
+				if (ez.startFoundInProvidedDataBuffer)
+				{
+					size_t headerLength = i - ez.possibleStartIndex + 1;
+					remainingBytesForCompletePacket = Packet::computeBinaryPacketLength(reinterpret_cast<char*>(data) + ez.possibleStartIndex) - headerLength;
+				}
+				else
+				{
+					// Not all of the packet's group is inside the caller's provided buffer.
+
+					// Temporarily copy the rest of the packet to the receive buffer
+					// for computing the size of the packet.
+
+					size_t numOfBytesToCopyIntoReceiveBuffer = i + 1;
+					size_t headerLength = _bufferAppendLocation - ez.possibleStartIndex + numOfBytesToCopyIntoReceiveBuffer;
+
+					if (_bufferAppendLocation + numOfBytesToCopyIntoReceiveBuffer < _bufferSize)
+					{
+						std::memcpy(_buffer + _bufferAppendLocation, data, numOfBytesToCopyIntoReceiveBuffer);
+
+						remainingBytesForCompletePacket = Packet::computeBinaryPacketLength(reinterpret_cast<char*>(_buffer) + ez.possibleStartIndex) - headerLength;
+					}
+					else
+					{
+						// About to overrun our receive buffer!
+
+						// TODO: Should we just go ahead and clear the ASCII tracker
+						//       and buffer append location?
+
+						return BINARY_TRACKER_INVALID;
+					}
+				}
+
+				// A computed length that does not extend past the header (such
+				// as for groups we do not know the size of) would underflow our
+				// countdown, so it is treated as a bad packet too.
+				if (remainingBytesForCompletePacket == 0
+					|| remainingBytesForCompletePacket > MaximumSizeExpectedForBinaryPacket)
+					// Must be a bad possible binary packet.
+					return BINARY_TRACKER_INVALID;
+
+				ez.numOfBytesRemainingForCompletePacket = remainingBytesForCompletePacket;
+			}
+
+			return BINARY_TRACKER_INCOMPLETE;
+		}
+
+		// We are currently collecting data for our packet.
+
+		ez.numOfBytesRemainingForCompletePacket--;
+
+		if (ez.numOfBytesRemainingForCompletePacket != 0)
+			return BINARY_TRACKER_INCOMPLETE;
+
+		// Running the CRC over a packet including its CRC field gives zero.
+		if (ez.runningCrc != 0)
+			return BINARY_TRACKER_INVALID;
+
+		// We have a valid binary packet!
+
+		if (ez.startFoundInProvidedDataBuffer)
+		{
+			// The binary packet exists completely in the user's provided buffer.
+			packetStart = data + ez.possibleStartIndex;
+			packetLength = i - ez.possibleStartIndex + 1;
+		}
+		else
+		{
+			// The packet is split between our receive buffer and the user's buffer.
+			size_t numOfBytesToCopyIntoReceiveBuffer = i + 1;
+
+			if (_bufferAppendLocation + numOfBytesToCopyIntoReceiveBuffer < _bufferSize)
+			{
+				std::memcpy(_buffer + _bufferAppendLocation, data, numOfBytesToCopyIntoReceiveBuffer);
+
+				packetStart = _buffer + ez.possibleStartIndex;
+				packetLength = _bufferAppendLocation - ez.possibleStartIndex + i + 1;
+			}
+			else
+			{
+				// About to overrun our receive buffer!
+				return BINARY_TRACKER_INVALID;
+			}
+		}
+
+		return BINARY_TRACKER_COMPLETE;
+	}
+
 	void dispatchPacket(Packet &packet, size_t runningDataIndexAtPacketStart, TimeStamp timestamp)
 	{
 		if (_possiblePacketFoundHandler != NULL)
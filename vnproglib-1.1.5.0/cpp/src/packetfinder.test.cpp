@@ -0,0 +1,265 @@
+#include "gtest/gtest.h"
+
+#include "vn/packetfinder.h"
+#include "vn/error_detection.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <vector>
+
+using namespace std;
+using namespace vn::xplat;
+using namespace vn::data::integrity;
+using namespace vn::protocol::uart;
+
+namespace {
+
+bool CountingAllocations = false;
+size_t NumOfAllocations = 0;
+
+void* countedAllocation(size_t size)
+{
+	if (CountingAllocations)
+		NumOfAllocations++;
+
+	void* p = malloc(size == 0 ? 1 : size);
+
+	if (p == NULL)
+		throw bad_alloc();
+
+	return p;
+}
+
+}
+
+void* operator new(size_t size)
+{
+	return countedAllocation(size);
+}
+
+void* operator new[](size_t size)
+{
+	return countedAllocation(size);
+}
+
+void operator delete(void* p) throw()
+{
+	free(p);
+}
+
+void operator delete[](void* p) throw()
+{
+	free(p);
+}
+
+namespace {
+
+// Deterministic generator so every run sees the same stream.
+class StreamRandom
+{
+public:
+	StreamRandom() : _state(88172645463325252ULL) { }
+
+	uint32_t next()
+	{
+		_state ^= _state << 13;
+		_state ^= _state >> 7;
+		_state ^= _state << 17;
+
+		return static_cast<uint32_t>(_state);
+	}
+
+private:
+	uint64_t _state;
+};
+
+// Stands in for a capture from a sensor outputting a common binary
+// configuration alongside ASCII async messages, with line noise between
+// packets. Payloads are random so they regularly contain 0xFA and '$'.
+struct CapturedStream
+{
+	vector<char> data;
+	size_t numOfBinaryPackets;
+	size_t numOfAsciiPackets;
+	bool syncByteBursts;	// Precede each binary packet with a burst of 0xFA.
+
+	explicit CapturedStream(bool syncByteBursts_ = false) :
+		numOfBinaryPackets(0),
+		numOfAsciiPackets(0),
+		syncByteBursts(syncByteBursts_)
+	{
+		StreamRandom rnd;
+
+		for (size_t i = 0; i < 4000; i++)
+		{
+			uint32_t kind = rnd.next() % 10;
+
+			if (kind < 6)
+				appendBinaryPacket(rnd);
+			else if (kind < 9)
+				appendAsciiPacket(rnd);
+			else
+				appendNoise(rnd);
+		}
+	}
+
+	void appendBinaryPacket(StreamRandom& rnd)
+	{
+		if (syncByteBursts)
+			appendSyncByteBurst();
+
+		// Common group with TimeStartup, YawPitchRoll, AngularRate and Accel.
+		char packet[64];
+		packet[0] = static_cast<char>(0xFA);
+		packet[1] = 0x01;
+		packet[2] = 0x29;
+		packet[3] = 0x01;
+
+		size_t length = Packet::computeBinaryPacketLength(packet);
+
+		for (size_t i = 4; i < length - 2; i++)
+			packet[i] = static_cast<char>(rnd.next());
+
+		uint16_t crc = Crc16::compute(packet + 1, length - 3);
+		packet[length - 2] = static_cast<char>(crc >> 8);
+		packet[length - 1] = static_cast<char>(crc);
+
+		data.insert(data.end(), packet, packet + length);
+		numOfBinaryPackets++;
+	}
+
+	void appendAsciiPacket(StreamRandom& rnd)
+	{
+		char body[128];
+		int length = sprintf(body, "VNYPR,%+08.3f,%+08.3f,%+08.3f",
+			(rnd.next() % 36000) / 100.0 - 180,
+			(rnd.next() % 18000) / 100.0 - 90,
+			(rnd.next() % 36000) / 100.0 - 180);
+
+		char packet[140];
+		int packetLength = sprintf(packet, "$%s*%02X\r\n", body, Checksum8::compute(body, length));
+
+		data.insert(data.end(), packet, packet + packetLength);
+		numOfAsciiPackets++;
+	}
+
+	// Each 0xFA of the burst is followed by a groups byte which makes the
+	// one after it a field byte, so every 0xFA looks like the start of a
+	// packet a little under 256 bytes long. All of them are still being
+	// tracked when the following packet starts.
+	void appendSyncByteBurst()
+	{
+		for (size_t i = 0; i < 100; i++)
+		{
+			data.push_back(static_cast<char>(0xFA));
+			data.push_back(static_cast<char>(0xE2));
+		}
+	}
+
+	void appendNoise(StreamRandom& rnd)
+	{
+		static const char Interesting[] = { static_cast<char>(0xFA), '$', '\r', '\n' };
+
+		size_t length = rnd.next() % 40;
+
+		for (size_t i = 0; i < length; i++)
+		{
+			uint32_t r = rnd.next() % 8;
+
+			data.push_back(r < 4 ? Interesting[r] : static_cast<char>(rnd.next()));
+		}
+	}
+};
+
+struct PacketCounts
+{
+	size_t binary;
+	size_t ascii;
+
+	PacketCounts() : binary(0), ascii(0) { }
+};
+
+void countPacket(void* userData, Packet& packet, size_t, TimeStamp)
+{
+	PacketCounts* counts = static_cast<PacketCounts*>(userData);
+
+	if (packet.type() == Packet::TYPE_BINARY)
+		counts->binary++;
+	else if (packet.type() == Packet::TYPE_ASCII)
+		counts->ascii++;
+}
+
+// Feeds the stream in reads of varying size, as they arrive from a serial
+// port.
+void feed(PacketFinder& finder, const vector<char>& stream, StreamRandom& rnd)
+{
+	char buffer[600];
+
+	for (size_t pos = 0; pos < stream.size(); )
+	{
+		size_t length = rnd.next() % sizeof(buffer) + 1;
+
+		if (pos + length > stream.size())
+			length = stream.size() - pos;
+
+		memcpy(buffer, &stream[pos], length);
+		finder.processReceivedData(buffer, length);
+
+		pos += length;
+	}
+}
+
+}
+
+TEST(PacketFinderTest, FindsEveryPacketInCapturedStream)
+{
+	CapturedStream stream;
+	PacketCounts counts;
+
+	PacketFinder finder;
+	finder.registerPossiblePacketFoundHandler(&counts, countPacket);
+
+	StreamRandom rnd;
+	feed(finder, stream.data, rnd);
+
+	EXPECT_EQ(stream.numOfBinaryPackets, counts.binary);
+	EXPECT_EQ(stream.numOfAsciiPackets, counts.ascii);
+}
+
+TEST(PacketFinderTest, FindsEveryPacketAfterBurstsOfSyncBytes)
+{
+	CapturedStream stream(true);
+	PacketCounts counts;
+
+	PacketFinder finder;
+	finder.registerPossiblePacketFoundHandler(&counts, countPacket);
+
+	StreamRandom rnd;
+	feed(finder, stream.data, rnd);
+
+	EXPECT_EQ(stream.numOfBinaryPackets, counts.binary);
+	EXPECT_EQ(stream.numOfAsciiPackets, counts.ascii);
+}
+
+TEST(PacketFinderTest, DoesNotAllocateWhileProcessingCapturedStream)
+{
+	CapturedStream stream;
+	PacketCounts counts;
+
+	PacketFinder finder;
+	finder.registerPossiblePacketFoundHandler(&counts, countPacket);
+
+	StreamRandom rnd;
+
+	NumOfAllocations = 0;
+	CountingAllocations = true;
+
+	feed(finder, stream.data, rnd);
+
+	CountingAllocations = false;
+
+	EXPECT_EQ(0u, NumOfAllocations);
+	EXPECT_EQ(stream.numOfBinaryPackets, counts.binary);
+}
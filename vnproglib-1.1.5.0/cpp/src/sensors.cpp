@@ -10,9 +10,16 @@
 #include "vn/matrix.h"
 #include "vn/compiler.h"
 #include "vn/util.h"
+#include "vn/atomic.h"
+#include "vn/handlerslot.h"
+#include "vn/thread.h"
+#include "vn/commandencoder.h"
 
 #include <string>
 #include <queue>
+#include <map>
+#include <algorithm>
+#include <vector>
 #include <string.h>
 #include <stdio.h>
 
@@ -70,34 +77,374 @@ char const* sensor_error::what() const throw()
 	return _errorMessage;
 }
 
+namespace {
+
+// Throws the exception the throwing transaction methods use to report status.
+void throwIfFailed(TransactionStatus status, Packet* response)
+{
+	switch (status)
+	{
+	case TRANSACTIONSTATUS_OK:
+		return;
+	case TRANSACTIONSTATUS_NOTCONNECTED:
+		throw invalid_operation();
+	case TRANSACTIONSTATUS_TIMEOUT:
+		throw timeout();
+	case TRANSACTIONSTATUS_SENSORERROR:
+		throw sensor_error(response->parseError());
+	default:
+		throw not_implemented();
+	}
+}
+
+// Identifies a command and its response by the five characters following the
+// '$' and by the register ID which follows them, if any. For example
+// "$VNRRG,35*..." has type "VNRRG" and register ID 35. Commands without a
+// register ID have an ID of -1.
+struct CommandKey
+{
+	char type[5];
+	int registerId;
+};
+
+CommandKey commandKeyOf(const char* data, size_t length)
+{
+	CommandKey key;
+
+	memset(key.type, 0, sizeof(key.type));
+	key.registerId = -1;
+
+	if (length < 6)
+		return key;
+
+	memcpy(key.type, data + 1, sizeof(key.type));
+
+	if (length < 8 || data[6] != ',')
+		return key;
+
+	size_t i = 7;
+	int id = 0;
+
+	for (; i < length && data[i] >= '0' && data[i] <= '9'; i++)
+		id = id * 10 + (data[i] - '0');
+
+	if (i > 7)
+		key.registerId = id;
+
+	return key;
+}
+
+bool operator==(const CommandKey& lhs, const CommandKey& rhs)
+{
+	return lhs.registerId == rhs.registerId && memcmp(lhs.type, rhs.type, sizeof(lhs.type)) == 0;
+}
+
+// Registers which can be kept in the register cache since their values only
+// change when they are written, or never change at all.
+const uint8_t CacheableRegisters[] =
+{
+	0, 1, 2, 3, 4, 5, 6, 7, 22, 23, 24, 25, 26, 30, 32, 34, 35, 36, 37, 38, 39,
+	40, 43, 44, 48, 51, 55, 57, 67, 68, 75, 76, 77, 82, 83, 84, 85, 93, 227
+};
+
+// What a command means for the register cache.
+enum CacheAction
+{
+	CACHEACTION_NONE,				// Does not affect cached registers.
+	CACHEACTION_READ,				// Reads a cacheable register.
+	CACHEACTION_WRITE,				// Writes a cacheable register.
+	CACHEACTION_INVALIDATEREGISTER,	// Changes a register in a way we cannot cache.
+	CACHEACTION_INVALIDATEALL		// Changes any number of registers.
+};
+
+// Commands other than register reads and writes which are known to leave
+// every register as it is. Any other command, such as restoring the factory
+// settings, resetting or setting the gyro bias, may change registers.
+const char* const CommandsKeepingRegisters[] =
+{
+	"VNWNV", "VNBOM", "VNKMD", "VNKAD", "VNASY"
+};
+
+CacheAction cacheActionOf(const char* command, size_t length, uint8_t& registerId)
+{
+	CommandKey key = commandKeyOf(command, length);
+
+	bool isRead = memcmp(key.type, "VNRRG", sizeof(key.type)) == 0;
+	bool isWrite = memcmp(key.type, "VNWRG", sizeof(key.type)) == 0;
+
+	if (!isRead && !isWrite)
+	{
+		for (size_t i = 0; i < sizeof(CommandsKeepingRegisters) / sizeof(CommandsKeepingRegisters[0]); i++)
+			if (memcmp(key.type, CommandsKeepingRegisters[i], sizeof(key.type)) == 0)
+				return CACHEACTION_NONE;
+
+		return CACHEACTION_INVALIDATEALL;
+	}
+
+	if (key.registerId < 0)
+		return isRead ? CACHEACTION_NONE : CACHEACTION_INVALIDATEALL;
+
+	registerId = static_cast<uint8_t>(key.registerId);
+
+	if (find(CacheableRegisters, CacheableRegisters + sizeof(CacheableRegisters), registerId) == CacheableRegisters + sizeof(CacheableRegisters))
+		return CACHEACTION_NONE;
+
+	if (registerId < 5 || registerId > 7)
+		return isRead ? CACHEACTION_READ : CACHEACTION_WRITE;
+
+	// The serial port registers can also be accessed for a port other than
+	// the one we are connected to, with the port as an extra field. Only the
+	// forms without it are cached.
+	size_t numOfFields = 0;
+
+	for (size_t i = 0; i < length && command[i] != '*'; i++)
+		if (command[i] == ',')
+			numOfFields++;
+
+	if (isRead)
+		return numOfFields == 1 ? CACHEACTION_READ : CACHEACTION_NONE;
+
+	return numOfFields == 2 ? CACHEACTION_WRITE : CACHEACTION_INVALIDATEREGISTER;
+}
+
+// Describes data received from the port in a single read, as stored in the
+// pipeline.
+struct ReceivedDataChunk
+{
+	size_t start;
+	size_t length;
+	TimeStamp timestamp;
+};
+
+// Lock-free ring of received bytes between a single reader thread (the
+// producer) and a single parser thread (the consumer). Each read is recorded
+// as a chunk in a second, smaller ring so its arrival time is kept with it.
+// All positions keep counting up and are masked to index the rings, so a
+// ring is full when its head and tail differ by its capacity.
+class ReceivedDataRing : private util::NoCopy
+{
+public:
+
+	ReceivedDataRing() :
+		_dataMask(0),
+		_chunkMask(0),
+		_dataTail(0)
+	{ }
+
+	// Allocates the rings and clears the statistics. Must only be called
+	// while neither thread is using the ring. Both capacities must be powers
+	// of two.
+	void reset(size_t numOfBytes, size_t numOfChunks)
+	{
+		vector<char>(numOfBytes).swap(_data);
+		vector<ReceivedDataChunk>(numOfChunks).swap(_chunks);
+		_dataMask = numOfBytes - 1;
+		_chunkMask = numOfChunks - 1;
+
+		_dataHead.store(0);
+		_dataTail = 0;
+		_chunkHead.store(0);
+		_chunkTail.store(0);
+
+		_capacity.store(numOfBytes);
+		_highWaterMark.store(0);
+		_numOfOverflows.store(0);
+		_numOfBytesDropped.store(0);
+	}
+
+	// Frees the rings. The statistics remain available.
+	void release()
+	{
+		vector<char>().swap(_data);
+		vector<ReceivedDataChunk>().swap(_chunks);
+	}
+
+	// Returns where the producer may write the next chunk, or NULL if the
+	// ring is full. Chunks never wrap around the end of the ring, so the
+	// space available may be less than the total free space.
+	char* beginWrite(size_t& maxLength)
+	{
+		if (_chunkTail.loadAcquire() - _chunkHead.loadAcquire() == _chunks.size())
+			return NULL;
+
+		size_t numOfBytesFree = _data.size() - (_dataTail - _dataHead.loadAcquire());
+		size_t numOfBytesToEnd = _data.size() - (_dataTail & _dataMask);
+
+		maxLength = numOfBytesFree < numOfBytesToEnd ? numOfBytesFree : numOfBytesToEnd;
+
+		if (maxLength == 0)
+			return NULL;
+
+		return &_data[_dataTail & _dataMask];
+	}
+
+	// Hands the bytes written at the location returned by beginWrite over to
+	// the consumer.
+	void commitWrite(size_t length, TimeStamp timestamp)
+	{
+		size_t chunkTail = _chunkTail.loadAcquire();
+
+		ReceivedDataChunk& chunk = _chunks[chunkTail & _chunkMask];
+		chunk.start = _dataTail;
+		chunk.length = length;
+		chunk.timestamp = timestamp;
+
+		_dataTail += length;
+		_chunkTail.storeRelease(chunkTail + 1);
+
+		size_t numOfBytesWaiting = _dataTail - _dataHead.loadAcquire();
+
+		if (numOfBytesWaiting > _highWaterMark.loadAcquire())
+			_highWaterMark.storeRelease(numOfBytesWaiting);
+	}
+
+	void recordOverflow(size_t numOfBytesDropped)
+	{
+		_numOfOverflows.fetchAdd(1);
+		_numOfBytesDropped.fetchAdd(numOfBytesDropped);
+	}
+
+	// Returns the oldest chunk for the consumer to process, or NULL if the
+	// ring is empty.
+	const ReceivedDataChunk* front()
+	{
+		size_t chunkHead = _chunkHead.loadAcquire();
+
+		if (chunkHead == _chunkTail.loadAcquire())
+			return NULL;
+
+		return &_chunks[chunkHead & _chunkMask];
+	}
+
+	char* data(const ReceivedDataChunk& chunk)
+	{
+		return &_data[chunk.start & _dataMask];
+	}
+
+	// Returns the chunk from front, and its bytes, back to the producer.
+	void pop()
+	{
+		size_t chunkHead = _chunkHead.loadAcquire();
+		const ReceivedDataChunk& chunk = _chunks[chunkHead & _chunkMask];
+
+		_dataHead.storeRelease(chunk.start + chunk.length);
+		_chunkHead.storeRelease(chunkHead + 1);
+	}
+
+	VnSensor::PipelineStatistics statistics() const
+	{
+		VnSensor::PipelineStatistics stats;
+
+		stats.capacity = _capacity.load();
+		stats.highWaterMark = _highWaterMark.load();
+		stats.numOfOverflows = _numOfOverflows.load();
+		stats.numOfBytesDropped = _numOfBytesDropped.load();
+
+		return stats;
+	}
+
+private:
+
+	vector<char> _data;
+	vector<ReceivedDataChunk> _chunks;
+	size_t _dataMask;
+	size_t _chunkMask;
+
+	// Keep the consumer's and producer's positions on separate cache lines
+	// so the two threads do not contend for them.
+	char _consumerPadding[64];
+	Atomic<size_t> _dataHead;
+	Atomic<size_t> _chunkHead;
+	char _producerPadding[64];
+	size_t _dataTail;
+	Atomic<size_t> _chunkTail;
+	char _statisticsPadding[64];
+
+	Atomic<size_t> _capacity;
+	Atomic<size_t> _highWaterMark;
+	Atomic<size_t> _numOfOverflows;
+	Atomic<size_t> _numOfBytesDropped;
+};
+
+}
+
 struct VnSensor::Impl
 {
-	static const size_t DefaultReadBufferSize = 256;
+	static const size_t DefaultReadBufferSize = 4096;
+	static const size_t MaximumReadBufferSize = 16384;
 	static const uint16_t DefaultResponseTimeoutMs = 500;
 	static const uint16_t DefaultRetransmitDelayMs = 200;
+	// Bounds how many pipelined commands may wait in the sensor's input
+	// buffer at once.
+	static const size_t MaximumNumOfCommandsInFlight = 8;
+	static const size_t PipelineCapacity = 65536;
+	static const size_t PipelineMaximumNumOfChunks = 1024;
+	// How long the async command timer sleeps when nothing is outstanding.
+	static const uint32_t AsyncIdleWaitMs = 1000;
+	// Leaves room in a command buffer for the longest error detection code
+	// and line ending, "*XXXX\r\n".
+	static const size_t MaximumUserCommandLength = COMMAND_MAX_LENGTH - 7;
+
+	// A command issued with one of the asynchronous methods.
+	struct AsyncCommand
+	{
+		uint32_t id;
+		CommandKey key;
+		char command[COMMAND_MAX_LENGTH];
+		size_t length;
+		CommandCompletedHandler handler;
+		void* userData;
+		uint16_t timeoutMs;
+		bool sent;
+		float firstSentMs;
+		float lastSentMs;
+	};
+
+	// A command awaiting a blocking or pipelined response.
+	struct TransactionCommand
+	{
+		CommandKey key;
+		float firstSentMs;		// On _asyncClock.
+	};
 
 	SerialPort *pSerialPort;
 	IPort* port;
 	bool SimplePortIsOurs;
 	bool DidWeOpenSimplePort;
-	RawDataReceivedHandler _rawDataReceivedHandler;
-	void* _rawDataReceivedUserData;
-	PossiblePacketFoundHandler _possiblePacketFoundHandler;
-	void* _possiblePacketFoundUserData;
+	HandlerSlot<RawDataReceivedHandler> _rawDataReceived;
+	HandlerSlot<PossiblePacketFoundHandler> _possiblePacketFound;
 	PacketFinder _packetFinder;
+	vector<char> _readBuffer;
+	bool _readBufferFilled;		// The last read filled the whole read buffer.
 	size_t _dataRunningIndex;
-	AsyncPacketReceivedHandler _asyncPacketReceivedHandler;
-	void* _asyncPacketReceivedUserData;
+	HandlerSlot<AsyncPacketReceivedHandler> _asyncPacketReceived;
 	ErrorDetectionMode _sendErrorDetectionMode;
 	VnSensor* BackReference;
 	queue<Packet> _receivedResponses;
 	CriticalSection _transactionCS;
-	bool _waitingForResponse;
-	ErrorPacketReceivedHandler _errorPacketReceivedHandler;
-	void* _errorPacketReceivedUserData;
+	Atomic<bool> _waitingForResponse;
+	// The commands awaiting a blocking or pipelined response.
+	vector<TransactionCommand> _transactionCommands;
+	HandlerSlot<ErrorPacketReceivedHandler> _errorPacketReceived;
 	uint16_t _responseTimeoutMs;
 	uint16_t _retransmitDelayMs;
 	xplat::Event _newResponsesEvent;
+	bool _pipelineMode;
+	ReceivedDataRing _pipelineRing;
+	Thread* _pipelineParserThread;
+	Atomic<bool> _continuePipelineParsing;
+	xplat::Event _pipelineDataEvent;
+	Atomic<bool> _registerCacheEnabled;
+	map<uint8_t, Packet> _registerCache;
+	CriticalSection _registerCacheCS;
+	// Outstanding asynchronous commands, oldest first.
+	vector<AsyncCommand> _asyncCommands;
+	CriticalSection _asyncCS;
+	uint32_t _nextAsyncId;
+	Stopwatch _asyncClock;
+	Thread* _asyncTimerThread;
+	Atomic<bool> _continueAsyncTimer;
+	xplat::Event _asyncEvent;
 	#if PYTHON
 	PyObject* _rawDataReceivedHandlerPython;
 	PyObject* _asyncPacketReceivedHandlerPython;
@@ -108,20 +455,17 @@ struct VnSensor::Impl
 		port(NULL),
 		SimplePortIsOurs(false),
 		DidWeOpenSimplePort(false),
-		_rawDataReceivedHandler(NULL),
-		_rawDataReceivedUserData(NULL),
-		_possiblePacketFoundHandler(NULL),
-		_possiblePacketFoundUserData(NULL),
+		_readBuffer(DefaultReadBufferSize),
+		_readBufferFilled(false),
 		_dataRunningIndex(0),
-		_asyncPacketReceivedHandler(NULL),
-		_asyncPacketReceivedUserData(NULL),
 		_sendErrorDetectionMode(ERRORDETECTIONMODE_CHECKSUM),
 		BackReference(backReference),
-		_waitingForResponse(false),
-		_errorPacketReceivedHandler(NULL),
-		_errorPacketReceivedUserData(NULL),
 		_responseTimeoutMs(DefaultResponseTimeoutMs),
-		_retransmitDelayMs(DefaultRetransmitDelayMs)
+		_retransmitDelayMs(DefaultRetransmitDelayMs),
+		_pipelineMode(false),
+		_pipelineParserThread(NULL),
+		_nextAsyncId(1),
+		_asyncTimerThread(NULL)
 		#if PYTHON
 		,
 		_asyncPacketReceivedHandlerPython(NULL),
@@ -133,21 +477,341 @@ struct VnSensor::Impl
 
 	~Impl()
 	{
+		stopAsyncCommands();
+		stopPipeline();
+
         _packetFinder.unregisterPossiblePacketFoundHandler();
 	}
 
+	void startPipeline()
+	{
+		_pipelineRing.reset(PipelineCapacity, PipelineMaximumNumOfChunks);
+
+		_continuePipelineParsing.store(true);
+
+		_pipelineParserThread = Thread::startNew(pipelineParserThread, this);
+	}
+
+	void stopPipeline()
+	{
+		if (_pipelineParserThread == NULL)
+			return;
+
+		_continuePipelineParsing.store(false);
+		_pipelineDataEvent.signal();
+
+		_pipelineParserThread->join();
+
+		delete _pipelineParserThread;
+		_pipelineParserThread = NULL;
+
+		// Anything the parser had not gotten to yet is discarded.
+		_pipelineRing.release();
+	}
+
+	// Sends the asynchronous commands which are waiting for room in the
+	// sensor's input buffer, retransmits those which are due and removes
+	// those which timed out into timedOut. Returns how long the timer may
+	// sleep before something else is due. Must be called within _asyncCS.
+	float serviceAsyncCommands(vector<AsyncCommand>& timedOut)
+	{
+		float now = _asyncClock.elapsedMs();
+		float waitMs = static_cast<float>(AsyncIdleWaitMs);
+		size_t numInFlight = 0;
+
+		for (size_t i = 0; i < _asyncCommands.size(); )
+		{
+			AsyncCommand& c = _asyncCommands[i];
+
+			if (!c.sent)
+			{
+				if (numInFlight >= MaximumNumOfCommandsInFlight)
+				{
+					i++;
+					continue;
+				}
+
+				port->write(c.command, c.length);
+				c.sent = true;
+				c.firstSentMs = c.lastSentMs = now;
+			}
+			else if (now - c.firstSentMs >= c.timeoutMs)
+			{
+				timedOut.push_back(c);
+				_asyncCommands.erase(_asyncCommands.begin() + i);
+				continue;
+			}
+			else if (now - c.lastSentMs >= _retransmitDelayMs)
+			{
+				port->write(c.command, c.length);
+				c.lastSentMs = now;
+			}
+
+			waitMs = std::min(waitMs, c.firstSentMs + c.timeoutMs - now);
+			waitMs = std::min(waitMs, c.lastSentMs + _retransmitDelayMs - now);
+			numInFlight++;
+			i++;
+		}
+
+		return std::max(waitMs, 0.f);
+	}
+
+	static void asyncTimerThread(void* userData)
+	{
+		Impl* pi = static_cast<Impl*>(userData);
+
+		while (pi->_continueAsyncTimer.load())
+		{
+			vector<AsyncCommand> timedOut;
+
+			pi->_asyncCS.enter();
+			float waitMs = pi->serviceAsyncCommands(timedOut);
+			pi->_asyncCS.leave();
+
+			Packet none;
+
+			for (size_t i = 0; i < timedOut.size(); i++)
+				timedOut[i].handler(timedOut[i].userData, TRANSACTIONSTATUS_TIMEOUT, none);
+
+			// The event latches, so a command issued after _asyncCS was left
+			// still cuts this wait short.
+			if (timedOut.empty())
+				pi->_asyncEvent.waitUs(static_cast<uint32_t>(waitMs * 1000));
+		}
+	}
+
+	uint32_t issueAsyncCommand(const char* toSend, size_t length, CommandCompletedHandler handler, void* userData, uint16_t timeoutMs)
+	{
+		if (!isConnected())
+			throwIfFailed(TRANSACTIONSTATUS_NOTCONNECTED, NULL);
+
+		if (length > COMMAND_MAX_LENGTH)
+			throw invalid_operation();
+
+		AsyncCommand c;
+		c.key = commandKeyOf(toSend, length);
+		memcpy(c.command, toSend, length);
+		c.length = length;
+		c.handler = handler;
+		c.userData = userData;
+		c.timeoutMs = timeoutMs == 0 ? _responseTimeoutMs : timeoutMs;
+		c.sent = false;
+
+		_asyncCS.enter();
+
+		if (_asyncTimerThread == NULL)
+		{
+			_continueAsyncTimer.store(true);
+			_asyncTimerThread = Thread::startNew(asyncTimerThread, this);
+		}
+
+		c.id = _nextAsyncId++;
+
+		if (_nextAsyncId == 0)
+			_nextAsyncId = 1;
+
+		// The command is sent from here if it does not have to wait behind
+		// others so the caller does not wait for the timer thread to be
+		// scheduled.
+		if (_asyncCommands.size() < MaximumNumOfCommandsInFlight && (_asyncCommands.empty() || _asyncCommands.back().sent))
+		{
+			port->write(c.command, c.length);
+			c.sent = true;
+			c.firstSentMs = c.lastSentMs = _asyncClock.elapsedMs();
+		}
+
+		_asyncCommands.push_back(c);
+
+		_asyncCS.leave();
+
+		_asyncEvent.signal();
+
+		return c.id;
+	}
+
+	bool cancelAsyncCommand(uint32_t id)
+	{
+		bool found = false;
+
+		_asyncCS.enter();
+
+		for (size_t i = 0; i < _asyncCommands.size(); i++)
+		{
+			if (_asyncCommands[i].id == id)
+			{
+				_asyncCommands.erase(_asyncCommands.begin() + i);
+				found = true;
+				break;
+			}
+		}
+
+		_asyncCS.leave();
+
+		if (found)
+			_asyncEvent.signal();
+
+		return found;
+	}
+
+	// Completes the asynchronous command a response answers, if any.
+	bool completeAsyncCommand(Packet& response)
+	{
+		_asyncCS.enter();
+
+		size_t match = 0;
+
+		if (response.isError())
+		{
+			while (match < _asyncCommands.size() && !_asyncCommands[match].sent)
+				match++;
+		}
+		else
+		{
+			CommandKey key = commandKeyOf(response.data(), response.length());
+
+			while (match < _asyncCommands.size() && !(_asyncCommands[match].sent && _asyncCommands[match].key == key))
+				match++;
+		}
+
+		if (match >= _asyncCommands.size())
+		{
+			_asyncCS.leave();
+			return false;
+		}
+
+		AsyncCommand c = _asyncCommands[match];
+		_asyncCommands.erase(_asyncCommands.begin() + match);
+
+		_asyncCS.leave();
+
+		// A command waiting for room in the sensor's input buffer can now be
+		// sent.
+		_asyncEvent.signal();
+
+		if (response.isError())
+		{
+			c.handler(c.userData, TRANSACTIONSTATUS_SENSORERROR, response);
+		}
+		else
+		{
+			updateRegisterCache(c.command, c.length, &response);
+			c.handler(c.userData, TRANSACTIONSTATUS_OK, response);
+		}
+
+		return true;
+	}
+
+	// Stops the async command timer and completes the commands still
+	// outstanding.
+	void stopAsyncCommands()
+	{
+		if (_asyncTimerThread != NULL)
+		{
+			_continueAsyncTimer.store(false);
+			_asyncEvent.signal();
+
+			_asyncTimerThread->join();
+
+			delete _asyncTimerThread;
+			_asyncTimerThread = NULL;
+		}
+
+		_asyncCS.enter();
+		vector<AsyncCommand> abandoned;
+		abandoned.swap(_asyncCommands);
+		_asyncCS.leave();
+
+		Packet none;
+
+		for (size_t i = 0; i < abandoned.size(); i++)
+			abandoned[i].handler(abandoned[i].userData, TRANSACTIONSTATUS_NOTCONNECTED, none);
+	}
+
+	static void pipelineParserThread(void* userData)
+	{
+		Impl* pi = static_cast<Impl*>(userData);
+
+		while (pi->_continuePipelineParsing.load())
+		{
+			const ReceivedDataChunk* chunk = pi->_pipelineRing.front();
+
+			if (chunk == NULL)
+			{
+				// The event remembers a signal made since the check above,
+				// so data committed in between is not left waiting.
+				pi->_pipelineDataEvent.wait();
+
+				continue;
+			}
+
+			try
+			{
+				pi->processReceivedData(pi->_pipelineRing.data(*chunk), chunk->length, chunk->timestamp);
+			}
+			catch (...)
+			{
+				// Don't want user-code exceptions stopping the thread.
+			}
+
+			pi->_pipelineRing.pop();
+		}
+	}
+
+	// Reads everything waiting on the port into the pipeline.
+	void readIntoPipeline()
+	{
+		while (true)
+		{
+			size_t maxLength = 0;
+			char* buffer = _pipelineRing.beginWrite(maxLength);
+			size_t numOfBytesRead = 0;
+
+			if (buffer == NULL)
+			{
+				// The parser thread has fallen behind. The data is still read
+				// so the port does not keep notifying us about it.
+				port->read(&_readBuffer[0], _readBuffer.size(), numOfBytesRead);
+
+				if (numOfBytesRead != 0)
+					_pipelineRing.recordOverflow(numOfBytesRead);
+
+				_pipelineDataEvent.signal();
+
+				return;
+			}
+
+			port->read(buffer, maxLength, numOfBytesRead);
+
+			if (numOfBytesRead == 0)
+				return;
+
+			_pipelineRing.commitWrite(numOfBytesRead, TimeStamp::get());
+			_pipelineDataEvent.signal();
+
+			if (numOfBytesRead < maxLength)
+				// The port has most likely been drained.
+				return;
+		}
+	}
+
 	void onPossiblePacketFound(Packet& possiblePacket, size_t packetStartRunningIndex)
 	{
-		if (_possiblePacketFoundHandler != NULL)
-			_possiblePacketFoundHandler(_possiblePacketFoundUserData, possiblePacket, packetStartRunningIndex);
+		HandlerSlot<PossiblePacketFoundHandler>::Dispatch dispatch(_possiblePacketFound);
+
+		if (dispatch.isRegistered())
+			dispatch->handler(dispatch->userData, possiblePacket, packetStartRunningIndex);
 	}
 
 	void onAsyncPacketReceived(Packet& asciiPacket, size_t runningIndex, TimeStamp timestamp)
 	{
 		//cout << "Made A" << flush << endl;
 
-		if (_asyncPacketReceivedHandler != NULL)
-			_asyncPacketReceivedHandler(_asyncPacketReceivedUserData, asciiPacket, runningIndex);
+		{
+			HandlerSlot<AsyncPacketReceivedHandler>::Dispatch dispatch(_asyncPacketReceived);
+
+			if (dispatch.isRegistered())
+				dispatch->handler(dispatch->userData, asciiPacket, runningIndex);
+		}
 
 		#if PYTHON
 		BackReference->eventAsyncPacketReceived.fire(asciiPacket, runningIndex, timestamp);
@@ -165,8 +829,74 @@ struct VnSensor::Impl
 
 	void onErrorPacketReceived(Packet& errorPacket, size_t runningIndex)
 	{
-		if (_errorPacketReceivedHandler != NULL)
-			_errorPacketReceivedHandler(_errorPacketReceivedUserData, errorPacket, runningIndex);
+		HandlerSlot<ErrorPacketReceivedHandler>::Dispatch dispatch(_errorPacketReceived);
+
+		if (dispatch.isRegistered())
+			dispatch->handler(dispatch->userData, errorPacket, runningIndex);
+	}
+
+	// The sensor answers commands in the order it receives them, so a
+	// response goes to the earliest sent of the commands it could answer,
+	// whether a blocking or pipelined transaction awaits it or it was sent
+	// with one of the asynchronous methods. Error responses do not say which
+	// command they answer, so they could answer any of them.
+	bool responseAnswersTransaction(Packet& response)
+	{
+		bool isError = response.isError();
+		CommandKey key = commandKeyOf(response.data(), response.length());
+
+		bool found = false;
+		float transactionSentMs = 0;
+
+		_transactionCS.enter();
+
+		if (_waitingForResponse.load())
+		{
+			for (size_t i = 0; i < _transactionCommands.size(); i++)
+			{
+				TransactionCommand& c = _transactionCommands[i];
+
+				if ((isError || c.key == key) && (!found || c.firstSentMs < transactionSentMs))
+				{
+					transactionSentMs = c.firstSentMs;
+					found = true;
+				}
+			}
+		}
+
+		_transactionCS.leave();
+
+		if (!found)
+			return false;
+
+		bool answersTransaction = true;
+
+		_asyncCS.enter();
+
+		for (size_t i = 0; i < _asyncCommands.size(); i++)
+		{
+			AsyncCommand& c = _asyncCommands[i];
+
+			if (c.sent && (isError || c.key == key) && c.firstSentMs < transactionSentMs)
+			{
+				answersTransaction = false;
+				break;
+			}
+		}
+
+		_asyncCS.leave();
+
+		return answersTransaction;
+	}
+
+	// Responses outlive the packet finder's callback so the queue takes
+	// ownership of a copy of the packet.
+	void queueResponse(Packet& response)
+	{
+		_transactionCS.enter();
+		_receivedResponses.push(response);
+		_newResponsesEvent.signal();
+		_transactionCS.leave();
 	}
 
 	static void possiblePacketFoundHandler(void* userData, Packet& possiblePacket, size_t packetStartRunningIndex, TimeStamp timestamp)
@@ -180,104 +910,392 @@ struct VnSensor::Impl
 
 		if (possiblePacket.isError())
 		{
-			if (pThis->_waitingForResponse)
-			{
-				pThis->_transactionCS.enter();
-				pThis->_receivedResponses.push(possiblePacket);
-				pThis->_newResponsesEvent.signal();
-				pThis->_transactionCS.leave();
-			}
+			if (pThis->responseAnswersTransaction(possiblePacket))
+				pThis->queueResponse(possiblePacket);
+			else
+				pThis->completeAsyncCommand(possiblePacket);
 
 			pThis->onErrorPacketReceived(possiblePacket, packetStartRunningIndex);
 
 			return;
 		}
 
-		if (possiblePacket.isResponse() && pThis->_waitingForResponse)
+		if (possiblePacket.isResponse())
 		{
-			pThis->_transactionCS.enter();
-			pThis->_receivedResponses.push(possiblePacket);
-			pThis->_newResponsesEvent.signal();
-			pThis->_transactionCS.leave();
+			if (pThis->responseAnswersTransaction(possiblePacket))
+			{
+				pThis->queueResponse(possiblePacket);
+				return;
+			}
 
-			return;
+			if (pThis->completeAsyncCommand(possiblePacket))
+				return;
+
+			// A response to a retransmit of a command already completed is
+			// left for the waiting transaction to skip, as before commands
+			// were matched.
+			if (pThis->_waitingForResponse.load())
+			{
+				pThis->queueResponse(possiblePacket);
+				return;
+			}
 		}
 
 		// This wasn't anything else. We assume it is an async packet.
 		pThis->onAsyncPacketReceived(possiblePacket, packetStartRunningIndex, timestamp);
 	}
 
+	// Grows the read buffer so the bytes already waiting on the serial port
+	// can be collected with a single read. The backlog is only queried after
+	// a read filled the buffer, since otherwise the port was drained.
+	void ensureReadBufferFitsBacklog()
+	{
+		if (!_readBufferFilled || pSerialPort == NULL || _readBuffer.size() >= MaximumReadBufferSize)
+			return;
+
+		size_t backlog = pSerialPort->bytesToRead();
+
+		if (backlog <= _readBuffer.size())
+			return;
+
+		size_t newSize = _readBuffer.size();
+
+		while (newSize < backlog && newSize < MaximumReadBufferSize)
+			newSize *= 2;
+
+		_readBuffer.resize(newSize);
+	}
+
 	static void dataReceivedHandler(void* userData)
 	{
-		static char readBuffer[DefaultReadBufferSize];
 		Impl *pi = static_cast<Impl*>(userData);
 
+		if (pi->_pipelineMode)
+		{
+			pi->readIntoPipeline();
+
+			return;
+		}
+
+		pi->ensureReadBufferFitsBacklog();
+
+		// The data is read into this sensor's own buffer rather than into the
+		// packet finder, since the finder scans the data where it lies and
+		// hands out complete packets as views of it. Its internal buffer
+		// only holds the start of a packet cut off by the end of a read, so
+		// there is no copy for reading straight into it to save.
+		char* readBuffer = &pi->_readBuffer[0];
 		size_t numOfBytesRead = 0;
 
 		pi->port->read(
 			readBuffer,
-			DefaultReadBufferSize,
+			pi->_readBuffer.size(),
 			numOfBytesRead);
 
-		if (numOfBytesRead == 0)
-			return;
+		pi->_readBufferFilled = numOfBytesRead == pi->_readBuffer.size();
+
+		if (numOfBytesRead == 0)
+			return;
+
+		pi->processReceivedData(readBuffer, numOfBytesRead, TimeStamp::get());
+	}
+
+	void processReceivedData(char* data, size_t length, TimeStamp t)
+	{
+		{
+			HandlerSlot<RawDataReceivedHandler>::Dispatch dispatch(_rawDataReceived);
+
+			if (dispatch.isRegistered())
+				dispatch->handler(dispatch->userData, data, length, _dataRunningIndex);
+		}
+
+		#if PYTHON
+		if (_rawDataReceivedHandlerPython != NULL)
+		{
+			vector<char> pRawData(data, data + length);
+
+			python::AcquireGIL scopedLock;
+				
+			boost::python::call<void>(_rawDataReceivedHandlerPython, pRawData, _dataRunningIndex);
+		}
+		#endif
+
+		_packetFinder.processReceivedData(data, length, t);
+
+		_dataRunningIndex += length;
+	}
+
+	bool isConnected()
+	{
+		return port != NULL && port->isOpen();
+	}
+
+	// Appends the error detection code and line ending to a command which
+	// ends with its '*'.
+	size_t finalizeCommandToSend(char *toSend, size_t length)
+	{
+		return length + CommandEncoder::writeErrorDetectionCode(_sendErrorDetectionMode, toSend + 1, length - 2, toSend + length);
+	}
+
+	// Copies a command provided by the user to buffer, adding the checksum
+	// or line ending if they are missing. Returns the length of the command.
+	size_t completeUserCommand(const string& toSend, char* buffer)
+	{
+		if (toSend.empty() || toSend.length() > MaximumUserCommandLength)
+			throw invalid_operation();
+
+		size_t finalLength = toSend.length();
+
+		// Copy over what was provided.
+		copy(toSend.begin(), toSend.end(), buffer);
+
+		// First see if an '*' is present.
+		if (toSend.find('*') == string::npos)
+		{
+			buffer[toSend.length()] = '*';
+			finalLength = finalizeCommandToSend(buffer, toSend.length() + 1);
+		}
+		else if (toSend.length() < 2 || (toSend[toSend.length() - 2] != '\r' && toSend[toSend.length() - 1] != '\n'))
+		{
+			buffer[toSend.length()] = '\r';
+			buffer[toSend.length() + 1] = '\n';
+			finalLength += 2;
+		}
+
+		return finalLength;
+	}
+
+	TransactionStatus tryTransactionWithWait(char* toSend, size_t length, uint16_t responseTimeoutMs, uint16_t retransmitDelayMs, Packet& response)
+	{
+		CommandKey key = commandKeyOf(toSend, length);
+
+		// Make sure we don't have any existing responses.
+		_transactionCS.enter();
+
+		#if VN_SUPPORTS_SWAP
+		queue<Packet> empty;
+		_receivedResponses.swap(empty);
+		#else
+		while (!_receivedResponses.empty()) _receivedResponses.pop();
+		#endif
+		_waitingForResponse.store(true);
+		_transactionCommands.resize(1);
+		_transactionCommands[0].key = key;
+		_transactionCommands[0].firstSentMs = _asyncClock.elapsedMs();
+		_transactionCS.leave();
+
+		// Send the command and continue sending if retransmits are enabled
+		// until we receive the response or timeout.
+		Stopwatch timeoutSw;
+
+		port->write(toSend, length);
+		float lastSentMs = timeoutSw.elapsedMs();
+
+		while (true)
+		{
+			// Get the current collection of responses.
+			queue<Packet> responsesToProcess;
+
+			_transactionCS.enter();
+			#if VN_SUPPORTS_SWAP
+			_receivedResponses.swap(responsesToProcess);
+			#else
+			while (!_receivedResponses.empty())
+			{
+				responsesToProcess.push(_receivedResponses.front());
+				_receivedResponses.pop();
+			}
+			#endif
+			_transactionCS.leave();
+
+			// Responses to other commands, such as a late reply to an
+			// asynchronous command which already completed, are skipped.
+			// Errors are only queued when they belong to this command.
+			for (; !responsesToProcess.empty(); responsesToProcess.pop())
+			{
+				Packet& p = responsesToProcess.front();
+
+				if (!p.isError() && !(commandKeyOf(p.data(), p.length()) == key))
+					continue;
+
+				response = p;
+				_waitingForResponse.store(false);
+
+				return response.isError() ? TRANSACTIONSTATUS_SENSORERROR : TRANSACTIONSTATUS_OK;
+			}
+
+			float now = timeoutSw.elapsedMs();
+
+			// See if we have time left.
+			if (now >= responseTimeoutMs)
+			{
+				_waitingForResponse.store(false);
+				return TRANSACTIONSTATUS_TIMEOUT;
+			}
+
+			// Retransmit if no response came within the delay of the last
+			// send.
+			if (now - lastSentMs >= retransmitDelayMs)
+			{
+				port->write(toSend, length);
+				lastSentMs = now;
+			}
+
+			// Wait for any new responses that come in or until it is time to
+			// send a new retransmit.
+			float dueMs = responseTimeoutMs;
+
+			if (lastSentMs + retransmitDelayMs < dueMs)
+				dueMs = lastSentMs + retransmitDelayMs;
+
+			_newResponsesEvent.waitUs(static_cast<uint32_t>((dueMs - now) * 1000));
+		}
+	}
+
+	Packet transactionWithWait(char* toSend, size_t length, uint16_t responseTimeoutMs, uint16_t retransmitDelayMs)
+	{
+		Packet response;
+
+		throwIfFailed(tryTransactionWithWait(toSend, length, responseTimeoutMs, retransmitDelayMs, response), &response);
+
+		return response;
+	}
+
+	// Answers a read of a cached register without involving the sensor.
+	bool lookupRegisterCache(const char* command, size_t length, Packet& response)
+	{
+		uint8_t registerId;
+
+		if (!_registerCacheEnabled.load() || cacheActionOf(command, length, registerId) != CACHEACTION_READ)
+			return false;
+
+		_registerCacheCS.enter();
+
+		map<uint8_t, Packet>::iterator it = _registerCache.find(registerId);
+		bool found = it != _registerCache.end();
+
+		if (found)
+			response = it->second;
+
+		_registerCacheCS.leave();
+
+		return found;
+	}
+
+	// Keeps the register cache in step with a command which the sensor
+	// accepted. The response to a register write echoes the values written
+	// in the same format as a read, so it is cached as the register's value.
+	// response is NULL if we did not wait for it.
+	void updateRegisterCache(const char* command, size_t length, Packet* response)
+	{
+		uint8_t registerId;
+
+		// Asynchronous commands complete on the thread processing received
+		// data, so the cache may be updated from more than one thread.
+		_registerCacheCS.enter();
+
+		switch (cacheActionOf(command, length, registerId))
+		{
+		case CACHEACTION_READ:
+		case CACHEACTION_WRITE:
+			if (_registerCacheEnabled.load() && response != NULL)
+				_registerCache[registerId] = *response;
+			else
+				_registerCache.erase(registerId);
+			break;
+
+		case CACHEACTION_INVALIDATEREGISTER:
+			_registerCache.erase(registerId);
+			break;
+
+		case CACHEACTION_INVALIDATEALL:
+			_registerCache.clear();
+			break;
+
+		default:
+			break;
+		}
+
+		_registerCacheCS.leave();
+	}
+
+	void clearRegisterCache()
+	{
+		_registerCacheCS.enter();
+		_registerCache.clear();
+		_registerCacheCS.leave();
+	}
 
-		TimeStamp t = TimeStamp::get();
+	// Same as transactionNoFinalize but reports failures with a status rather
+	// than by throwing, so callers polling a misbehaving sensor do not pay for
+	// an exception on every attempt.
+	TransactionStatus tryTransactionNoFinalize(char* toSend, size_t length, bool waitForReply, Packet *response, uint16_t responseTimeoutMs, uint16_t retransmitDelayMs)
+	{
+		if (!isConnected())
+			return TRANSACTIONSTATUS_NOTCONNECTED;
 
-		if (pi->_rawDataReceivedHandler != NULL)
-			pi->_rawDataReceivedHandler(pi->_rawDataReceivedUserData, reinterpret_cast<char*>(readBuffer), numOfBytesRead, pi->_dataRunningIndex);
+		if (waitForReply && lookupRegisterCache(toSend, length, *response))
+			return TRANSACTIONSTATUS_OK;
 
-		#if PYTHON
-		if (pi->_rawDataReceivedHandlerPython != NULL)
-		{
-			vector<char> pRawData(readBuffer, readBuffer + numOfBytesRead);
+		TransactionStatus status = TRANSACTIONSTATUS_OK;
 
-			python::AcquireGIL scopedLock;
-				
-			boost::python::call<void>(pi->_rawDataReceivedHandlerPython, pRawData, pi->_dataRunningIndex);
-		}
-		#endif
+		if (waitForReply)
+			status = tryTransactionWithWait(toSend, length, responseTimeoutMs, retransmitDelayMs, *response);
+		else
+			port->write(toSend, length);
 
-		pi->_packetFinder.processReceivedData(reinterpret_cast<char*>(readBuffer), numOfBytesRead, t);
+		if (status == TRANSACTIONSTATUS_OK)
+			updateRegisterCache(toSend, length, waitForReply ? response : NULL);
 
-		pi->_dataRunningIndex += numOfBytesRead;
+		return status;
 	}
 
-	bool isConnected()
+	void transactionNoFinalize(char* toSend, size_t length, bool waitForReply, Packet *response, uint16_t responseTimeoutMs, uint16_t retransmitDelayMs)
 	{
-		return port != NULL && port->isOpen();
+		throwIfFailed(tryTransactionNoFinalize(toSend, length, waitForReply, response, responseTimeoutMs, retransmitDelayMs), response);
 	}
 
-	size_t finalizeCommandToSend(char *toSend, size_t length)
+	void transactionNoFinalize(char* toSend, size_t length, bool waitForReply, Packet *response)
 	{
-		#if defined(_MSC_VER)
-			// Unable to use save version 'sprintf_s' since the length of 'toSend' is unknown here.
-			#pragma warning(push)
-			#pragma warning(disable:4996)
-		#endif
-		
-		if (_sendErrorDetectionMode == ERRORDETECTIONMODE_CHECKSUM)
-		{
-			length += sprintf(toSend + length, "%02X\r\n", Checksum8::compute(toSend + 1, length - 2));
-		}
-		else if (_sendErrorDetectionMode == ERRORDETECTIONMODE_CRC)
-		{
-			length += sprintf(toSend + length, "%04X\r\n", Crc16::compute(toSend + 1, length - 2));
-		}
-		else
+		transactionNoFinalize(toSend, length, waitForReply, response, _responseTimeoutMs, _retransmitDelayMs);
+	}
+
+	// A pipelined command which is awaiting its response.
+	struct PendingCommand
+	{
+		size_t index;
+		CommandKey key;
+		float firstSentMs;
+		float lastSentMs;
+	};
+
+	// Makes the pipelined commands in flight the ones responses are routed
+	// to by responseAnswersTransaction.
+	void setTransactionCommands(const vector<PendingCommand>& inFlight)
+	{
+		_transactionCS.enter();
+
+		_transactionCommands.resize(inFlight.size());
+
+		for (size_t i = 0; i < inFlight.size(); i++)
 		{
-			length += sprintf(toSend + length, "XX\r\n");
+			_transactionCommands[i].key = inFlight[i].key;
+			_transactionCommands[i].firstSentMs = inFlight[i].firstSentMs;
 		}
 
-		#if defined(_MSC_VER)
-			#pragma warning(pop)
-		#endif
-
-		return length;
+		_transactionCS.leave();
 	}
 
-	Packet transactionWithWait(char* toSend, size_t length, uint16_t responseTimeoutMs, uint16_t retransmitDelayMs)
+	// Sends finalized commands, keeping up to MaximumNumOfCommandsInFlight of
+	// them awaiting a response at once rather than waiting for each response
+	// before sending the next command. Command i is the lengths[i] bytes at
+	// commands[i * COMMAND_MAX_LENGTH]. On failure, failedIndex is set to the
+	// command which failed.
+	TransactionStatus tryPipelinedTransactions(const vector<char>& commands, const vector<size_t>& lengths, vector<Packet>& responses, size_t& failedIndex)
 	{
+		if (!isConnected())
+			return TRANSACTIONSTATUS_NOTCONNECTED;
+
 		// Make sure we don't have any existing responses.
 		_transactionCS.enter();
 
@@ -287,126 +1305,138 @@ struct VnSensor::Impl
 		#else
 		while (!_receivedResponses.empty()) _receivedResponses.pop();
 		#endif
-		_waitingForResponse = true;
+		_waitingForResponse.store(true);
+		_transactionCommands.clear();
 		_transactionCS.leave();
 
-		// Send the command and continue sending if retransmits are enabled
-		// until we receive the response or timeout.
-		Stopwatch timeoutSw;
+		vector<PendingCommand> inFlight;
+		inFlight.reserve(MaximumNumOfCommandsInFlight);
+		size_t nextToSend = 0;
 
-		port->write(toSend, length);
-		float curElapsedTime = timeoutSw.elapsedMs();
+		// Times are kept on _asyncClock so errors can be routed between
+		// these commands and asynchronous ones.
+		Stopwatch& sw = _asyncClock;
 
-		while (true)
+		while (nextToSend < lengths.size() || !inFlight.empty())
 		{
-			bool shouldRetransmit = false;
-
-			// Compute how long we should wait for a response before taking
-			// more action.
-			float responseWaitTime = responseTimeoutMs - curElapsedTime;
-			if (responseWaitTime > retransmitDelayMs)
+			// Keep the sensor supplied with commands.
+			while (nextToSend < lengths.size() && inFlight.size() < MaximumNumOfCommandsInFlight)
 			{
-				responseWaitTime = retransmitDelayMs;
-				shouldRetransmit = true;
+				const char* command = &commands[nextToSend * COMMAND_MAX_LENGTH];
+
+				PendingCommand pending;
+				pending.index = nextToSend;
+				pending.key = commandKeyOf(command, lengths[nextToSend]);
+				pending.firstSentMs = pending.lastSentMs = sw.elapsedMs();
+				inFlight.push_back(pending);
+				setTransactionCommands(inFlight);
+
+				port->write(command, lengths[nextToSend]);
+				nextToSend++;
 			}
 
-			// See if we have time left.
-			if (responseWaitTime < 0)
+			// Collect the responses received so far before deciding which
+			// commands are overdue, so one which arrived just as the wait timed
+			// out is not retransmitted or failed.
+			queue<Packet> responsesToProcess;
+
+			_transactionCS.enter();
+			#if VN_SUPPORTS_SWAP
+			_receivedResponses.swap(responsesToProcess);
+			#else
+			while (!_receivedResponses.empty())
 			{
-				_waitingForResponse = false;
-				throw timeout();
+				responsesToProcess.push(_receivedResponses.front());
+				_receivedResponses.pop();
 			}
+			#endif
+			_transactionCS.leave();
 
-			// Wait for any new responses that come in or until it is time to
-			// send a new retransmit.
-			xplat::Event::WaitResult waitResult = _newResponsesEvent.waitUs(static_cast<uint32_t>(responseWaitTime * 1000));
+			for (; !responsesToProcess.empty(); responsesToProcess.pop())
+			{
+				Packet& p = responsesToProcess.front();
 
-			queue<Packet> responsesToProcess;
+				// Error responses do not say which command they answer, so
+				// they go to the oldest one. Responses which match nothing
+				// answer a retransmit of a command already completed.
+				size_t match = 0;
 
-			if (waitResult == xplat::Event::WAIT_TIMEDOUT)
-			{
-				if (!shouldRetransmit)
+				if (!p.isError())
 				{
-					_waitingForResponse = false;
-					throw timeout();
+					CommandKey key = commandKeyOf(p.data(), p.length());
+
+					while (match < inFlight.size() && !(inFlight[match].key == key))
+						match++;
 				}
-			}
 
-			if (waitResult == xplat::Event::WAIT_SIGNALED)
-			{
-				// Get the current collection of responses.
-				_transactionCS.enter();
-				#if VN_SUPPORTS_SWAP
-				_receivedResponses.swap(responsesToProcess);
-				#else
-				while (!_receivedResponses.empty())
+				if (match >= inFlight.size())
+					continue;
+
+				size_t index = inFlight[match].index;
+				responses[index] = p;
+
+				if (p.isError())
 				{
-					responsesToProcess.push(_receivedResponses.front());
-					_receivedResponses.pop();
+					_waitingForResponse.store(false);
+					failedIndex = index;
+					return TRANSACTIONSTATUS_SENSORERROR;
 				}
-				#endif
-				_transactionCS.leave();
+
+				updateRegisterCache(&commands[index * COMMAND_MAX_LENGTH], lengths[index], &p);
+				inFlight.erase(inFlight.begin() + match);
+				setTransactionCommands(inFlight);
 			}
 
-			// Process the collection of responses we have.
-			while (!responsesToProcess.empty())
+			if (inFlight.empty())
+				continue;
+
+			// Time out or retransmit the commands which are due, and find out
+			// how long we can wait before one of them is due again.
+			float now = sw.elapsedMs();
+			float nextDueMs = now + _responseTimeoutMs;
+
+			for (size_t i = 0; i < inFlight.size(); i++)
 			{
-				Packet p = responsesToProcess.front();
-				responsesToProcess.pop();
+				PendingCommand& pending = inFlight[i];
 
-				if (p.isError())
+				if (now - pending.firstSentMs >= _responseTimeoutMs)
 				{
-					_waitingForResponse = false;
-					throw sensor_error(p.parseError());
+					_waitingForResponse.store(false);
+					failedIndex = pending.index;
+					return TRANSACTIONSTATUS_TIMEOUT;
 				}
 
-				// We must have a response packet.
-				_waitingForResponse = false;
-				return p;
+				if (now - pending.lastSentMs >= _retransmitDelayMs)
+				{
+					port->write(&commands[pending.index * COMMAND_MAX_LENGTH], lengths[pending.index]);
+					pending.lastSentMs = now;
+				}
+
+				nextDueMs = std::min(nextDueMs, pending.firstSentMs + _responseTimeoutMs);
+				nextDueMs = std::min(nextDueMs, pending.lastSentMs + _retransmitDelayMs);
 			}
 
-			// Retransmit.
-			port->write(toSend, length);
-			curElapsedTime = timeoutSw.elapsedMs();
+			// Whether this wakes for a response or times out, the responses
+			// are collected at the top of the next pass before anything is
+			// judged overdue.
+			_newResponsesEvent.waitUs(static_cast<uint32_t>((nextDueMs - now) * 1000));
 		}
-	}
-
-	void transactionNoFinalize(char* toSend, size_t length, bool waitForReply, Packet *response, uint16_t responseTimeoutMs, uint16_t retransmitDelayMs)
-	{
-		if (!isConnected())
-			throw invalid_operation();
 
-		if (waitForReply)
-		{
-			*response = transactionWithWait(toSend, length, responseTimeoutMs, retransmitDelayMs);
+		_waitingForResponse.store(false);
 
-			if (response->isError())
-				throw sensor_error(response->parseError());
-		}
-		else
-		{
-			port->write(toSend, length);
-		}
+		return TRANSACTIONSTATUS_OK;
 	}
 
-	void transactionNoFinalize(char* toSend, size_t length, bool waitForReply, Packet *response)
+	vector<Packet> pipelinedTransactions(const vector<char>& commands, const vector<size_t>& lengths)
 	{
-		transactionNoFinalize(toSend, length, waitForReply, response, _responseTimeoutMs, _retransmitDelayMs);
-	}
+		vector<Packet> responses(lengths.size());
+		size_t failedIndex = 0;
 
-	void transaction(char* toSend, size_t length, bool waitForReply, Packet *response, uint16_t responseTimeoutMs, uint16_t retransmitDelayMs)
-	{
-		length = finalizeCommandToSend(toSend, length);
+		TransactionStatus status = tryPipelinedTransactions(commands, lengths, responses, failedIndex);
 
-		transactionNoFinalize(toSend, length, waitForReply, response, responseTimeoutMs, retransmitDelayMs);
-	}
+		throwIfFailed(status, status == TRANSACTIONSTATUS_OK ? NULL : &responses[failedIndex]);
 
-	// Performs a communication transaction with the sensor. If waitForReply is
-	// set to true, we will retransmit the message until we receive a response
-	// or until we time out, depending on current settings.
-	void transaction(char* toSend, size_t length, bool waitForReply, Packet *response)
-	{
-		transaction(toSend, length, waitForReply, response, _responseTimeoutMs, _retransmitDelayMs);
+		return responses;
 	}
 
 	BinaryOutputRegister readBinaryOutput(uint8_t binaryOutputNumber)
@@ -415,13 +1445,12 @@ struct VnSensor::Impl
 		Packet response;
 		uint16_t asyncMode, rateDivisor, outputGroup, commonField, timeField, imuField, gpsField, attitudeField, insField, gps2Field;
 
-		#if VN_HAVE_SECURE_CRT
-		int length = sprintf_s(toSend, sizeof(toSend), "$VNRRG,%u*", 74 + binaryOutputNumber);
-		#else
-		int length = sprintf(toSend, "$VNRRG,%u*", 74 + binaryOutputNumber);
-		#endif
+		CommandEncoder command(toSend, sizeof(toSend), "$VNRRG");
+		command.unsignedField(74 + binaryOutputNumber);
+
+		size_t length = command.finalize(_sendErrorDetectionMode);
 
-		transaction(toSend, length, true, &response);
+		transactionNoFinalize(toSend, length, true, &response);
 
 		response.parseBinaryOutput(
 			&asyncMode,
@@ -469,62 +1498,30 @@ struct VnSensor::Impl
     if(fields.gps2Field)
       groups |= 0x0040;
 
-		#if VN_HAVE_SECURE_CRT
-		int length = sprintf_s(toSend, sizeof(toSend), "$VNWRG,%u,%u,%u,%X", 74 + binaryOutputNumber, fields.asyncMode, fields.rateDivisor, groups);
-		#else
-		int length = sprintf(toSend, "$VNWRG,%u,%u,%u,%X", 74 + binaryOutputNumber, fields.asyncMode, fields.rateDivisor, groups);
-		#endif
+		CommandEncoder command(toSend, sizeof(toSend), "$VNWRG");
+		command.unsignedField(74 + binaryOutputNumber);
+		command.unsignedField(fields.asyncMode);
+		command.unsignedField(fields.rateDivisor);
+		command.hexField(groups);
 
 		if (fields.commonField)
-			#if VN_HAVE_SECURE_CRT
-			length += sprintf_s(toSend + length, sizeof(toSend) - length, ",%X", fields.commonField);
-			#else
-			length += sprintf(toSend + length, ",%X", fields.commonField);
-			#endif
+			command.hexField(fields.commonField);
 		if (fields.timeField)
-			#if VN_HAVE_SECURE_CRT
-			length += sprintf_s(toSend + length, sizeof(toSend) - length, ",%X", fields.timeField);
-			#else
-			length += sprintf(toSend + length, ",%X", fields.timeField);
-			#endif
+			command.hexField(fields.timeField);
 		if (fields.imuField)
-			#if VN_HAVE_SECURE_CRT
-			length += sprintf_s(toSend + length, sizeof(toSend) - length, ",%X", fields.imuField);
-			#else
-			length += sprintf(toSend + length, ",%X", fields.imuField);
-			#endif
+			command.hexField(fields.imuField);
 		if (fields.gpsField)
-			#if VN_HAVE_SECURE_CRT
-			length += sprintf_s(toSend + length, sizeof(toSend) - length, ",%X", fields.gpsField);
-			#else
-			length += sprintf(toSend + length, ",%X", fields.gpsField);
-			#endif
+			command.hexField(fields.gpsField);
 		if (fields.attitudeField)
-			#if VN_HAVE_SECURE_CRT
-			length += sprintf_s(toSend + length, sizeof(toSend) - length, ",%X", fields.attitudeField);
-			#else
-			length += sprintf(toSend + length, ",%X", fields.attitudeField);
-			#endif
+			command.hexField(fields.attitudeField);
 		if (fields.insField)
-			#if VN_HAVE_SECURE_CRT
-			length += sprintf_s(toSend + length, sizeof(toSend) - length, ",%X", fields.insField);
-			#else
-			length += sprintf(toSend + length, ",%X", fields.insField);
-			#endif
-    if(fields.gps2Field)
-      #if VN_HAVE_SECURE_CRT
-      length += sprintf_s(toSend + length, sizeof(toSend) - length, ",%X", fields.gps2Field);
-      #else
-      length += sprintf(toSend + length, ",%X", fields.gps2Field);
-      #endif
-
-		#if VN_HAVE_SECURE_CRT
-		length += sprintf_s(toSend + length, sizeof(toSend) - length, "*");
-		#else
-		length += sprintf(toSend + length, "*");
-		#endif
+			command.hexField(fields.insField);
+		if (fields.gps2Field)
+			command.hexField(fields.gps2Field);
+
+		size_t length = command.finalize(_sendErrorDetectionMode);
 
-		transaction(toSend, length, waitForReply, &response);
+		transactionNoFinalize(toSend, length, waitForReply, &response);
 	}
 };
 
@@ -623,6 +1620,76 @@ void VnSensor::setRetransmitDelayMs(uint16_t delay)
 	_pi->_retransmitDelayMs = delay;
 }
 
+bool VnSensor::pipelineMode()
+{
+	return _pi->_pipelineMode;
+}
+
+void VnSensor::setPipelineMode(bool enabled)
+{
+	if (isConnected())
+		// Can only be changed while not connected.
+		throw invalid_operation();
+
+	_pi->_pipelineMode = enabled;
+}
+
+uint32_t VnSensor::transactionAsync(string toSend, CommandCompletedHandler handler, void* userData, uint16_t timeoutMs)
+{
+	char buffer[COMMAND_MAX_LENGTH];
+
+	size_t finalLength = _pi->completeUserCommand(toSend, buffer);
+
+	return _pi->issueAsyncCommand(buffer, finalLength, handler, userData, timeoutMs);
+}
+
+uint32_t VnSensor::readRegisterAsync(uint8_t registerId, CommandCompletedHandler handler, void* userData, uint16_t timeoutMs)
+{
+	char toSend[COMMAND_MAX_LENGTH];
+
+	CommandEncoder command(toSend, sizeof(toSend), "$VNRRG");
+	command.unsignedField(registerId, 2);
+
+	size_t length = command.finalize(_pi->_sendErrorDetectionMode);
+
+	return _pi->issueAsyncCommand(toSend, length, handler, userData, timeoutMs);
+}
+
+bool VnSensor::cancelAsync(uint32_t id)
+{
+	return _pi->cancelAsyncCommand(id);
+}
+
+VnSensor::PipelineStatistics VnSensor::pipelineStatistics()
+{
+	return _pi->_pipelineRing.statistics();
+}
+
+bool VnSensor::registerCacheEnabled()
+{
+	return _pi->_registerCacheEnabled.load();
+}
+
+void VnSensor::setRegisterCacheEnabled(bool enabled)
+{
+	_pi->_registerCacheEnabled.store(enabled);
+
+	if (!enabled)
+		_pi->clearRegisterCache();
+}
+
+void VnSensor::invalidateRegisterCache()
+{
+	_pi->clearRegisterCache();
+}
+
+void VnSensor::invalidateRegisterCache(uint8_t registerId)
+{
+	_pi->_registerCacheCS.enter();
+	_pi->_registerCache.erase(registerId);
+	_pi->_registerCacheCS.leave();
+}
+
 bool VnSensor::verifySensorConnectivity()
 {
 	try
@@ -643,11 +1710,31 @@ void VnSensor::connect(const string &portName, uint32_t baudrate)
 	connect(dynamic_cast<IPort*>(_pi->pSerialPort));
 }
 
+void VnSensor::connect(const string &portName, uint32_t baudrate, bool optimizePort)
+{
+	if (optimizePort)
+	{
+		try
+		{
+			SerialPort::optimizePort(portName);
+		}
+		catch (...)
+		{
+			// The optimization is only best effort.
+		}
+	}
+
+	connect(portName, baudrate);
+}
+
 void VnSensor::connect(IPort* simplePort)
 {
 	_pi->port = simplePort;
 	_pi->SimplePortIsOurs = false;
 
+	if (_pi->_pipelineMode)
+		_pi->startPipeline();
+
 	_pi->port->registerDataReceivedHandler(_pi, Impl::dataReceivedHandler);
 
 	if (!_pi->port->isOpen())
@@ -664,11 +1751,18 @@ void VnSensor::disconnect()
 
 	_pi->port->unregisterDataReceivedHandler();
 
+	_pi->stopAsyncCommands();
+
 	if (_pi->DidWeOpenSimplePort)
 	{
 		_pi->port->close();
 	}
 
+	_pi->stopPipeline();
+
+	// We may be connected to a different sensor next time.
+	_pi->clearRegisterCache();
+
 	_pi->DidWeOpenSimplePort = false;
 
 	if (_pi->SimplePortIsOurs)
@@ -683,34 +1777,85 @@ void VnSensor::disconnect()
 		// Assuming we created this serial port.
 		delete _pi->pSerialPort;
 		_pi->pSerialPort = NULL;
+		_pi->port = NULL;
 	}
 }
 
 string VnSensor::transaction(string toSend)
 {
 	char buffer[COMMAND_MAX_LENGTH];
-	size_t finalLength = toSend.length();
 	Packet response;
 
-	// Copy over what was provided.
-	copy(toSend.begin(), toSend.end(), buffer);
+	size_t finalLength = _pi->completeUserCommand(toSend, buffer);
 
-	// First see if an '*' is present.
-	if (toSend.find('*') == string::npos)
-	{
-		buffer[toSend.length()] = '*';
-		finalLength = _pi->finalizeCommandToSend(buffer, toSend.length() + 1);
-	}
-	else if (toSend[toSend.length() - 2] != '\r' && toSend[toSend.length() - 1] != '\n')
+	_pi->transactionNoFinalize(buffer, finalLength, true, &response);
+
+	return response.datastr();
+}
+
+vector<Packet> VnSensor::transactions(const vector<string>& commands)
+{
+	vector<char> buffer(commands.size() * COMMAND_MAX_LENGTH);
+	vector<size_t> lengths(commands.size());
+
+	for (size_t i = 0; i < commands.size(); i++)
+		lengths[i] = _pi->completeUserCommand(commands[i], &buffer[i * COMMAND_MAX_LENGTH]);
+
+	return _pi->pipelinedTransactions(buffer, lengths);
+}
+
+vector<Packet> VnSensor::readRegisters(const vector<uint8_t>& registerIds)
+{
+	vector<Packet> responses(registerIds.size());
+	vector<char> buffer;
+	vector<size_t> lengths;
+	// The index in registerIds of each read which is sent.
+	vector<size_t> sent;
+
+	for (size_t i = 0; i < registerIds.size(); i++)
 	{
-		buffer[toSend.length()] = '\r';
-		buffer[toSend.length() + 1] = '\n';
-		finalLength += 2;
+		buffer.resize(buffer.size() + COMMAND_MAX_LENGTH);
+		char* command = &buffer[buffer.size() - COMMAND_MAX_LENGTH];
+
+		CommandEncoder encoder(command, COMMAND_MAX_LENGTH, "$VNRRG");
+		encoder.unsignedField(registerIds[i], 2);
+
+		size_t length = encoder.finalize(_pi->_sendErrorDetectionMode);
+
+		if (_pi->lookupRegisterCache(command, length, responses[i]))
+		{
+			buffer.resize(buffer.size() - COMMAND_MAX_LENGTH);
+			continue;
+		}
+
+		lengths.push_back(length);
+		sent.push_back(i);
 	}
 
-	_pi->transactionNoFinalize(buffer, finalLength, true, &response);
+	if (sent.empty())
+		return responses;
 
-	return response.datastr();
+	vector<Packet> received = _pi->pipelinedTransactions(buffer, lengths);
+
+	for (size_t i = 0; i < sent.size(); i++)
+		responses[sent[i]] = received[i];
+
+	return responses;
+}
+
+TransactionStatus VnSensor::tryTransaction(string toSend, string& response)
+{
+	char buffer[COMMAND_MAX_LENGTH];
+	Packet p;
+
+	size_t finalLength = _pi->completeUserCommand(toSend, buffer);
+
+	TransactionStatus status = _pi->tryTransactionNoFinalize(buffer, finalLength, true, &p, _pi->_responseTimeoutMs, _pi->_retransmitDelayMs);
+
+	if (status == TRANSACTIONSTATUS_OK || status == TRANSACTIONSTATUS_SENSORERROR)
+		response = p.datastr();
+
+	return status;
 }
 
 string VnSensor::send(string toSend, bool waitForReply, ErrorDetectionMode errorDetectionMode)
@@ -761,30 +1906,7 @@ string VnSensor::send(string toSend, bool waitForReply, ErrorDetectionMode error
 	// Do we need to add a checksum/CRC?
 	if (astrickLocation == curToSendLength - 1)
 	{
-		if (errorDetectionMode == ERRORDETECTIONMODE_CHECKSUM)
-		{
-			#if VN_HAVE_SECURE_CRT
-			curToSendLength += sprintf_s(buffer + curToSendLength, toSend.size() + 8 - curToSendLength, "%02X\r\n", Checksum8::compute(buffer + 1, curToSendLength - 2));
-			#else
-			curToSendLength += sprintf(buffer + curToSendLength, "%02X\r\n", Checksum8::compute(buffer + 1, curToSendLength - 2));
-			#endif
-		}
-		else if (errorDetectionMode == ERRORDETECTIONMODE_CRC)
-		{
-			#if VN_HAVE_SECURE_CRT
-			curToSendLength += sprintf_s(buffer + curToSendLength, toSend.size() + 8 - curToSendLength, "%04X\r\n", Crc16::compute(buffer + 1, curToSendLength - 2));
-			#else
-			curToSendLength += sprintf(buffer + curToSendLength, "%04X\r\n", Crc16::compute(buffer + 1, curToSendLength - 2));
-			#endif
-		}
-		else
-		{
-			#if VN_HAVE_SECURE_CRT
-			curToSendLength += sprintf_s(buffer + curToSendLength, toSend.size() + 8 - curToSendLength, "*XX\r\n");
-			#else
-			curToSendLength += sprintf(buffer + curToSendLength, "*XX\r\n");
-			#endif
-		}
+		curToSendLength += CommandEncoder::writeErrorDetectionCode(errorDetectionMode, buffer + 1, curToSendLength - 2, buffer + curToSendLength);
 	}
 	// Do we need to add "\r\n"?
 	else if (buffer[curToSendLength - 1] != '\n')
@@ -802,11 +1924,7 @@ string VnSensor::send(string toSend, bool waitForReply, ErrorDetectionMode error
 
 void VnSensor::registerRawDataReceivedHandler(void* userData, RawDataReceivedHandler handler)
 {
-	if (_pi->_rawDataReceivedHandler != NULL)
-		throw invalid_operation();
-
-	_pi->_rawDataReceivedHandler = handler;
-	_pi->_rawDataReceivedUserData = userData;
+	_pi->_rawDataReceived.registerHandler(userData, handler);
 }
 
 #if PL150
@@ -827,38 +1945,22 @@ PyObject* VnSensor::registerRawDataReceivedHandler(PyObject* callable)
 
 void VnSensor::unregisterRawDataReceivedHandler()
 {
-	if (_pi->_rawDataReceivedHandler == NULL)
-		throw invalid_operation();
-
-	_pi->_rawDataReceivedHandler = NULL;
-	_pi->_rawDataReceivedUserData = NULL;
+	_pi->_rawDataReceived.unregisterHandler();
 }
 
 void VnSensor::registerPossiblePacketFoundHandler(void* userData, PossiblePacketFoundHandler handler)
 {
-	if (_pi->_possiblePacketFoundHandler != NULL)
-		throw invalid_operation();
-
-	_pi->_possiblePacketFoundHandler = handler;
-	_pi->_possiblePacketFoundUserData = userData;
+	_pi->_possiblePacketFound.registerHandler(userData, handler);
 }
 
 void VnSensor::unregisterPossiblePacketFoundHandler()
 {
-	if (_pi->_possiblePacketFoundHandler == NULL)
-		throw invalid_operation();
-
-	_pi->_possiblePacketFoundHandler = NULL;
-	_pi->_possiblePacketFoundUserData = NULL;
+	_pi->_possiblePacketFound.unregisterHandler();
 }
 
 void VnSensor::registerAsyncPacketReceivedHandler(void* userData, AsyncPacketReceivedHandler handler)
 {
-	if (_pi->_asyncPacketReceivedHandler != NULL)
-		throw invalid_operation();
-
-	_pi->_asyncPacketReceivedHandler = handler;
-	_pi->_asyncPacketReceivedUserData = userData;
+	_pi->_asyncPacketReceived.registerHandler(userData, handler);
 }
 
 #if PL150
@@ -879,29 +1981,17 @@ PyObject* VnSensor::registerAsyncPacketReceivedHandler(PyObject* callable)
 
 void VnSensor::unregisterAsyncPacketReceivedHandler()
 {
-	if (_pi->_asyncPacketReceivedHandler == NULL)
-		throw invalid_operation();
-
-	_pi->_asyncPacketReceivedHandler = NULL;
-	_pi->_asyncPacketReceivedUserData = NULL;
+	_pi->_asyncPacketReceived.unregisterHandler();
 }
 
 void VnSensor::registerErrorPacketReceivedHandler(void* userData, ErrorPacketReceivedHandler handler)
 {
-	if (_pi->_errorPacketReceivedHandler != NULL)
-		throw invalid_operation();
-
-	_pi->_errorPacketReceivedHandler = handler;
-	_pi->_errorPacketReceivedUserData = userData;
+	_pi->_errorPacketReceived.registerHandler(userData, handler);
 }
 
 void VnSensor::unregisterErrorPacketReceivedHandler()
 {
-	if (_pi->_errorPacketReceivedHandler == NULL)
-		throw invalid_operation();
-
-	_pi->_errorPacketReceivedHandler = NULL;
-	_pi->_errorPacketReceivedUserData = NULL;
+	_pi->_errorPacketReceived.unregisterHandler();
 }
 
 void VnSensor::writeSettings(bool waitForReply)
@@ -950,6 +2040,33 @@ void VnSensor::magneticDisturbancePresent(bool disturbancePresent, bool waitForR
 	_pi->transactionNoFinalize(toSend, length, waitForReply, &response);
 }
 
+uint32_t VnSensor::tareAsync(CommandCompletedHandler handler, void* userData, uint16_t timeoutMs)
+{
+	char toSend[14];
+
+	size_t length = Packet::genTare(_pi->_sendErrorDetectionMode, toSend, sizeof(toSend));
+
+	return _pi->issueAsyncCommand(toSend, length, handler, userData, timeoutMs);
+}
+
+uint32_t VnSensor::setGyroBiasAsync(CommandCompletedHandler handler, void* userData, uint16_t timeoutMs)
+{
+	char toSend[14];
+
+	size_t length = Packet::genSetGyroBias(_pi->_sendErrorDetectionMode, toSend, sizeof(toSend));
+
+	return _pi->issueAsyncCommand(toSend, length, handler, userData, timeoutMs);
+}
+
+uint32_t VnSensor::magneticDisturbancePresentAsync(bool disturbancePresent, CommandCompletedHandler handler, void* userData, uint16_t timeoutMs)
+{
+	char toSend[16];
+
+	size_t length = Packet::genKnownMagneticDisturbance(_pi->_sendErrorDetectionMode, toSend, sizeof(toSend), disturbancePresent);
+
+	return _pi->issueAsyncCommand(toSend, length, handler, userData, timeoutMs);
+}
+
 void VnSensor::accelerationDisturbancePresent(bool disturbancePresent, bool waitForReply)
 {
 	char toSend[16];
@@ -1405,6 +2522,15 @@ vec3f VnSensor::readYawPitchRoll()
 	return reg;
 }
 
+uint32_t VnSensor::readYawPitchRollAsync(CommandCompletedHandler handler, void* userData, uint16_t timeoutMs)
+{
+	char toSend[17];
+
+	size_t length = Packet::genReadYawPitchRoll(_pi->_sendErrorDetectionMode, toSend, sizeof(toSend));
+
+	return _pi->issueAsyncCommand(toSend, length, handler, userData, timeoutMs);
+}
+
 vec4f VnSensor::readAttitudeQuaternion()
 {
 	char toSend[17];
@@ -0,0 +1,294 @@
+#include "gtest/gtest.h"
+
+#include "vn/sensors.h"
+#include "vn/event.h"
+#include "vn/exceptions.h"
+#include "vn/thread.h"
+#include "fakesensorport.h"
+
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace vn::sensors;
+using namespace vn::xplat;
+using namespace vn::protocol::uart;
+
+namespace {
+
+struct Completion
+{
+	Completion() : status(TRANSACTIONSTATUS_OK) { }
+
+	TransactionStatus status;
+	string response;
+	Event completed;
+};
+
+void recordCompletion(void* userData, TransactionStatus status, Packet& response)
+{
+	Completion* c = static_cast<Completion*>(userData);
+
+	c->status = status;
+
+	if (status == TRANSACTIONSTATUS_OK || status == TRANSACTIONSTATUS_SENSORERROR)
+		c->response = response.datastr();
+
+	c->completed.signal();
+}
+
+class VnSensorTest : public ::testing::Test
+{
+protected:
+
+	virtual void SetUp()
+	{
+		_port.setRegister(35, "1,0,1,1");
+		_port.setRegister(227, "800,4,+200.000,+40.000");
+
+		_sensor.connect(&_port);
+	}
+
+	virtual void TearDown()
+	{
+		_sensor.disconnect();
+	}
+
+	// Issues an asynchronous read while a blocking command is on the wire.
+	static void issueAsyncReadLater(void* userData)
+	{
+		VnSensorTest* test = static_cast<VnSensorTest*>(userData);
+
+		Thread::sleepMs(FakeSensorPort::ReplyDelayMs / 2);
+
+		test->_sensor.readRegisterAsync(227, recordCompletion, &test->_completion);
+	}
+
+	// Issues an asynchronous read of the register a blocking read on the
+	// wire is reading, once the sensor's value for it has changed.
+	static void issueAsyncVpeReadLater(void* userData)
+	{
+		VnSensorTest* test = static_cast<VnSensorTest*>(userData);
+
+		Thread::sleepMs(FakeSensorPort::ReplyDelayMs / 2);
+
+		test->_port.setRegister(35, "0,1,0,0");
+		test->_sensor.readRegisterAsync(35, recordCompletion, &test->_completion);
+	}
+
+	FakeSensorPort _port;
+	VnSensor _sensor;
+
+	// Outlives the sensor so commands abandoned by a failed test can still
+	// be completed.
+	Completion _completion;
+};
+
+}
+
+TEST_F(VnSensorTest, ErrorForAsyncCommandDoesNotFailLaterBlockingRead)
+{
+	_port.failNextCommand();
+	_sensor.readRegisterAsync(35, recordCompletion, &_completion);
+
+	ImuRateConfigurationRegister imuRate;
+	ASSERT_NO_THROW(imuRate = _sensor.readImuRateConfiguration());
+	EXPECT_EQ(800, imuRate.imuRate);
+
+	ASSERT_EQ(Event::WAIT_SIGNALED, _completion.completed.waitMs(1000));
+	EXPECT_EQ(TRANSACTIONSTATUS_SENSORERROR, _completion.status);
+}
+
+TEST_F(VnSensorTest, ErrorForBlockingReadIsNotGivenToLaterAsyncCommand)
+{
+	_port.failNextCommand();
+
+	Thread* issuer = Thread::startNew(issueAsyncReadLater, this);
+
+	EXPECT_THROW(_sensor.readVpeBasicControl(), sensor_error);
+
+	issuer->join();
+	delete issuer;
+
+	ASSERT_EQ(Event::WAIT_SIGNALED, _completion.completed.waitMs(1000));
+	EXPECT_EQ(TRANSACTIONSTATUS_OK, _completion.status);
+}
+
+TEST_F(VnSensorTest, BlockingReadSkipsLateReplyToAsyncCommand)
+{
+	_port.duplicateNextReply();
+	_sensor.readRegisterAsync(227, recordCompletion, &_completion);
+
+	VpeBasicControlRegister vpe = _sensor.readVpeBasicControl();
+
+	EXPECT_EQ(1, vpe.enable);
+	EXPECT_EQ(0, vpe.headingMode);
+	EXPECT_EQ(1, vpe.filteringMode);
+	EXPECT_EQ(1, vpe.tuningMode);
+
+	ASSERT_EQ(Event::WAIT_SIGNALED, _completion.completed.waitMs(1000));
+	EXPECT_EQ(TRANSACTIONSTATUS_OK, _completion.status);
+}
+
+TEST_F(VnSensorTest, BlockingReadGetsFirstReplyWhenAsyncReadOfSameRegisterFollows)
+{
+	Thread* issuer = Thread::startNew(issueAsyncVpeReadLater, this);
+
+	VpeBasicControlRegister vpe = _sensor.readVpeBasicControl();
+
+	issuer->join();
+	delete issuer;
+
+	EXPECT_EQ(1, vpe.enable);
+	EXPECT_EQ(0, vpe.headingMode);
+
+	ASSERT_EQ(Event::WAIT_SIGNALED, _completion.completed.waitMs(1000));
+	EXPECT_EQ(TRANSACTIONSTATUS_OK, _completion.status);
+	EXPECT_NE(string::npos, _completion.response.find("VNRRG,35,0,1,0,0"));
+}
+
+TEST_F(VnSensorTest, AsyncReadGetsFirstReplyWhenBlockingReadOfSameRegisterFollows)
+{
+	_sensor.readRegisterAsync(35, recordCompletion, &_completion);
+	_port.setRegister(35, "0,1,0,0");
+
+	VpeBasicControlRegister vpe = _sensor.readVpeBasicControl();
+
+	EXPECT_EQ(0, vpe.enable);
+	EXPECT_EQ(1, vpe.headingMode);
+
+	ASSERT_EQ(Event::WAIT_SIGNALED, _completion.completed.waitMs(1000));
+	EXPECT_EQ(TRANSACTIONSTATUS_OK, _completion.status);
+	EXPECT_NE(string::npos, _completion.response.find("VNRRG,35,1,0,1,1"));
+}
+
+TEST_F(VnSensorTest, OverlongCommandsAreRejected)
+{
+	string command = "$VNRRG,35," + string(300, '0');
+
+	EXPECT_THROW(_sensor.transaction(command), vn::invalid_operation);
+	EXPECT_THROW(_sensor.transactionAsync(command, recordCompletion, &_completion), vn::invalid_operation);
+
+	// The longest command accepted still fits with a CRC appended.
+	_sensor.setSendErrorDetectionMode(ERRORDETECTIONMODE_CRC);
+	command.resize(249);
+
+	EXPECT_NO_THROW(_sensor.transactionAsync(command, recordCompletion, &_completion));
+
+	ASSERT_EQ(Event::WAIT_SIGNALED, _completion.completed.waitMs(1000));
+	EXPECT_EQ(TRANSACTIONSTATUS_OK, _completion.status);
+}
+
+TEST_F(VnSensorTest, PipelinedResponsesAreMatchedWhenAnsweredOutOfOrder)
+{
+	_port.setReadDelay(35, 3 * FakeSensorPort::ReplyDelayMs);
+
+	vector<string> commands;
+	commands.push_back("$VNRRG,35");
+	commands.push_back("$VNRRG,227");
+
+	vector<Packet> responses = _sensor.transactions(commands);
+
+	ASSERT_EQ(2u, responses.size());
+	EXPECT_NE(string::npos, responses[0].datastr().find("VNRRG,35,1,0,1,1"));
+	EXPECT_NE(string::npos, responses[1].datastr().find("VNRRG,227,800,4"));
+}
+
+TEST_F(VnSensorTest, PipelinedTransactionsTimeOutWhenOneCommandIsNotAnswered)
+{
+	_port.setReadDelay(35, -1);
+	_sensor.setResponseTimeoutMs(100);
+
+	vector<uint8_t> registerIds;
+	registerIds.push_back(227);
+	registerIds.push_back(35);
+
+	EXPECT_THROW(_sensor.readRegisters(registerIds), vn::timeout);
+
+	// The sensor is still usable afterwards.
+	EXPECT_EQ(800, _sensor.readImuRateConfiguration().imuRate);
+}
+
+TEST_F(VnSensorTest, ShortCommandsAreCompletedWithoutOverrunning)
+{
+	EXPECT_THROW(_sensor.transactionAsync("", recordCompletion, &_completion), vn::invalid_operation);
+
+	uint32_t id = 0;
+	EXPECT_NO_THROW(id = _sensor.transactionAsync("*", recordCompletion, &_completion));
+	_sensor.cancelAsync(id);
+}
+
+TEST_F(VnSensorTest, CachedRegisterIsReadOnlyOnce)
+{
+	_sensor.setRegisterCacheEnabled(true);
+
+	EXPECT_EQ(800, _sensor.readImuRateConfiguration().imuRate);
+	int numOfCommands = _port.numOfCommands();
+
+	// Changed behind the sensor's back, so only a read which goes to the
+	// sensor sees it.
+	_port.setRegister(227, "400,4,+200.000,+40.000");
+
+	EXPECT_EQ(800, _sensor.readImuRateConfiguration().imuRate);
+	EXPECT_EQ(numOfCommands, _port.numOfCommands());
+
+	_sensor.setRegisterCacheEnabled(false);
+
+	EXPECT_EQ(400, _sensor.readImuRateConfiguration().imuRate);
+	EXPECT_EQ(numOfCommands + 1, _port.numOfCommands());
+}
+
+TEST_F(VnSensorTest, RegisterWriteIsCachedAsTheRegistersValue)
+{
+	_sensor.setRegisterCacheEnabled(true);
+
+	VpeBasicControlRegister written(VPEENABLE_ENABLE, HEADINGMODE_RELATIVE, VPEMODE_OFF, VPEMODE_OFF);
+	_sensor.writeVpeBasicControl(written);
+	int numOfCommands = _port.numOfCommands();
+
+	VpeBasicControlRegister vpe = _sensor.readVpeBasicControl();
+
+	EXPECT_EQ(numOfCommands, _port.numOfCommands());
+	EXPECT_EQ(VPEENABLE_ENABLE, vpe.enable);
+	EXPECT_EQ(HEADINGMODE_RELATIVE, vpe.headingMode);
+	EXPECT_EQ(VPEMODE_OFF, vpe.filteringMode);
+	EXPECT_EQ(VPEMODE_OFF, vpe.tuningMode);
+}
+
+TEST_F(VnSensorTest, CommandsWhichMayChangeRegistersEmptyTheCache)
+{
+	_sensor.setRegisterCacheEnabled(true);
+
+	_sensor.readVpeBasicControl();
+	_sensor.setGyroBias();
+	int numOfCommands = _port.numOfCommands();
+
+	_sensor.readVpeBasicControl();
+	EXPECT_EQ(numOfCommands + 1, _port.numOfCommands());
+
+	_sensor.restoreFactorySettings();
+	numOfCommands = _port.numOfCommands();
+
+	_sensor.readVpeBasicControl();
+	EXPECT_EQ(numOfCommands + 1, _port.numOfCommands());
+
+	_sensor.invalidateRegisterCache();
+	_sensor.readVpeBasicControl();
+	EXPECT_EQ(numOfCommands + 2, _port.numOfCommands());
+
+	// Writing the settings to non-volatile memory leaves the registers alone.
+	_sensor.writeSettings();
+	numOfCommands = _port.numOfCommands();
+
+	_sensor.readVpeBasicControl();
+	EXPECT_EQ(numOfCommands, _port.numOfCommands());
+}
+
+TEST(VnSensorNotConnectedTest, TryTransactionReportsStatusWithoutThrowing)
+{
+	VnSensor sensor;
+	string response;
+
+	EXPECT_EQ(TRANSACTIONSTATUS_NOTCONNECTED, sensor.tryTransaction("$VNRRG,35", response));
+	EXPECT_THROW(sensor.transaction("$VNRRG,35"), std::exception);
+}
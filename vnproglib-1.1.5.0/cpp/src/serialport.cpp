@@ -25,18 +25,23 @@
 
 #if __linux__
 	#include <linux/serial.h>
+	#include <sys/epoll.h>
+	#include <sys/eventfd.h>
 #elif __APPLE__
 	#include <dirent.h>
 #endif
 
 #include <list>
 #include <iostream>
+#include <cstdio>
+#include <cstdlib>
 
 #include "vn/thread.h"
 #include "vn/criticalsection.h"
 #include "vn/exceptions.h"
 #include "vn/event.h"
 #include "vn/compiler.h"
+#include "vn/handlerslot.h"
 
 #if PYTHON
 	#include "util.h"
@@ -56,6 +61,11 @@ struct SerialPort::Impl
 
 	static const uint8_t WaitTimeForSerialPortReadsInMs = 100;
 
+	#if __linux__
+	// The serial port and the wakeup event are the only things we wait on.
+	static const int MaximumNumberOfEpollEvents = 2;
+	#endif
+
 	// Members ////////////////////////////////////////////////////////////////
 
 	#if _WIN32
@@ -69,6 +79,14 @@ struct SerialPort::Impl
 	#error "Unknown System"
 	#endif
 
+	#if __linux__
+	// epoll instance the notifications thread waits on.
+	int EpollHandle;
+	// eventfd used to wake the notifications thread immediately, such as
+	// when it needs to stop.
+	int WakeupHandle;
+	#endif
+
 	Thread *pThreadForHandlingReceivedDataInternally;
 
 	// The name of the serial port.
@@ -80,12 +98,9 @@ struct SerialPort::Impl
 	// Indicates if the serial port is open.
 	bool IsOpen;
 
-	// Critical section for registering, unregistering, and notifying observers
-	// of events.
-	CriticalSection ObserversCriticalSection;
-
-	DataReceivedHandler _dataReceivedHandler;
-	void* _dataReceivedUserData;
+	// The handler notified when data is received. Registering and
+	// unregistering do not block on notifications in progress.
+	HandlerSlot<DataReceivedHandler> DataReceived;
 
 	Thread *pSerialPortEventsThread;
 
@@ -117,11 +132,13 @@ struct SerialPort::Impl
 		#else
 		#error "Unknown System"
 		#endif
+		#if __linux__
+		EpollHandle(-1),
+		WakeupHandle(-1),
+		#endif
 		pThreadForHandlingReceivedDataInternally(NULL),
 		Baudrate(0),
 		IsOpen(false),
-		_dataReceivedHandler(NULL),
-		_dataReceivedUserData(NULL),
 		pSerialPortEventsThread(NULL),
 		ContinueHandlingSerialPortEvents(false),
 		ChangingBaudrate(false),
@@ -208,7 +225,11 @@ struct SerialPort::Impl
 			SerialPortHandle,
 			EV_RXCHAR | EV_ERR | EV_RX80FULL);
 
-		#elif __linux__ || __APPLE__ || __CYGWIN__ || __QNXNTO__
+		#elif __linux__
+
+		epoll_event events[MaximumNumberOfEpollEvents];
+
+		#elif __APPLE__ || __CYGWIN__ || __QNXNTO__
 
 		fd_set readfs;
 		int error;
@@ -335,7 +356,54 @@ struct SerialPort::Impl
 					continue;
 				}
 
-				#elif __linux__ || __APPLE__ || __CYGWIN__ || __QNXNTO__
+				#elif __linux__
+
+				// No timeout is needed since stopping the thread signals the
+				// wakeup event.
+				int numOfEvents = epoll_wait(
+					EpollHandle,
+					events,
+					MaximumNumberOfEpollEvents,
+					-1);
+
+				if (numOfEvents == -1)
+				{
+					if (errno == EINTR)
+						continue;
+
+					// Something unexpected happened.
+					break;
+				}
+
+				for (int e = 0; e < numOfEvents; e++)
+				{
+					if (events[e].data.fd == WakeupHandle)
+					{
+						// The wakeup event only interrupts the wait. The loop
+						// condition decides if we keep going.
+						uint64_t numOfWakeups;
+						if (::read(WakeupHandle, &numOfWakeups, sizeof(numOfWakeups)) == -1)
+						{
+							// Nothing to clear.
+						}
+
+						continue;
+					}
+
+					if (events[e].events & (EPOLLERR | EPOLLHUP))
+					{
+						// The device has probably been unplugged. Stop watching
+						// it so we do not spin on the error. User code finds
+						// out when it next reads from or writes to the port.
+						epoll_event unused;
+						epoll_ctl(EpollHandle, EPOLL_CTL_DEL, SerialPortHandle, &unused);
+					}
+
+					if (events[e].events & EPOLLIN)
+						OnDataReceived();
+				}
+
+				#elif __APPLE__ || __CYGWIN__ || __QNXNTO__
 
 				FD_ZERO(&readfs);
 				FD_SET(SerialPortHandle, &readfs);
@@ -419,6 +487,10 @@ struct SerialPort::Impl
 
 	void StartSerialPortNotificationsThread()
 	{
+		#if __linux__
+		CreateNotificationHandles();
+		#endif
+
 		ContinueHandlingSerialPortEvents = true;
 
 		pSerialPortEventsThread = Thread::startNew(
@@ -442,47 +514,99 @@ struct SerialPort::Impl
 	{
 		ContinueHandlingSerialPortEvents = false;
 
+		#if __linux__
+		WakeSerialPortNotificationsThread();
+		#endif
+
 		pSerialPortEventsThread->join();
 
 		delete pSerialPortEventsThread;
+
+		#if __linux__
+		CloseNotificationHandles();
+		#endif
 	}
 
-	void OnDataReceived()
+	#if __linux__
+
+	void CreateNotificationHandles()
 	{
-		bool exception_happened = false;
-		exception rethrow;
+		EpollHandle = epoll_create1(EPOLL_CLOEXEC);
 
-		ObserversCriticalSection.enter();
+		if (EpollHandle == -1)
+			throw unknown_error();
 
-		// This is a critical section block
-		// The exception must be handled here or the critical section will never
-		// unlock
-		try
+		WakeupHandle = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+
+		if (WakeupHandle == -1)
 		{
-			// Moved this NULL check down here due to the nature of critical sections.
-			// The handler could easily be changed to NULL while waiting for the lock
-			if (_dataReceivedHandler != NULL)
-			{
-				_dataReceivedHandler(_dataReceivedUserData);
-			}
+			CloseNotificationHandles();
+			throw unknown_error();
+		}
+
+		// The set of handles we wait on is only built once here rather than
+		// on every wakeup.
+		epoll_event ev;
+		memset(&ev, 0, sizeof(ev));
+
+		ev.events = EPOLLIN;
+		ev.data.fd = WakeupHandle;
+
+		if (epoll_ctl(EpollHandle, EPOLL_CTL_ADD, WakeupHandle, &ev) == -1)
+		{
+			CloseNotificationHandles();
+			throw unknown_error();
+		}
+
+		ev.events = EPOLLIN;
+		ev.data.fd = SerialPortHandle;
+
+		if (epoll_ctl(EpollHandle, EPOLL_CTL_ADD, SerialPortHandle, &ev) == -1)
+		{
+			CloseNotificationHandles();
+			throw unknown_error();
 		}
-		catch (exception& e)
+	}
+
+	void CloseNotificationHandles()
+	{
+		if (WakeupHandle != -1)
 		{
-			// We still want to throw an exception if it happens
-			// Set a flag to indicate we need to throw an exception
-			exception_happened = true;
-			rethrow = e;
+			::close(WakeupHandle);
+			WakeupHandle = -1;
 		}
 
-		ObserversCriticalSection.leave();
+		if (EpollHandle != -1)
+		{
+			::close(EpollHandle);
+			EpollHandle = -1;
+		}
+	}
+
+	// Interrupts the notifications thread's wait so it notices changes (such
+	// as being asked to stop) without waiting for data to arrive.
+	void WakeSerialPortNotificationsThread()
+	{
+		uint64_t one = 1;
 
-		// Rethrow the exception
-		if (exception_happened)
+		if (::write(WakeupHandle, &one, sizeof(one)) == -1)
 		{
-			throw rethrow;
+			// The counter can only be full if the thread already has a
+			// wakeup pending.
 		}
 	}
 
+	#endif
+
+	void OnDataReceived()
+	{
+		// The dispatch is ended even if the handler throws.
+		HandlerSlot<DataReceivedHandler>::Dispatch dispatch(DataReceived);
+
+		if (dispatch.isRegistered())
+			dispatch->handler(dispatch->userData);
+	}
+
 	void ensureOpened()
 	{
 		if (!IsOpen)
@@ -1006,11 +1130,79 @@ HKEY SerialPort_getRegistryKeyForActiveFtdiPort(string portName, bool isReadOnly
 	return ftdiKey;
 }
 
+#elif __linux__
+
+/// \brief Opens a serial port only so its driver settings can be queried or
+/// changed.
+///
+/// \return The file descriptor of the opened port.
+int SerialPort_openForConfiguration(string portName)
+{
+	int portFd = ::open(portName.c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK);
+
+	if (portFd != -1)
+		return portFd;
+
+	switch (errno)
+	{
+	case EACCES:
+		throw permission_denied(portName);
+	case ENXIO:
+	case ENOTDIR:
+	case ENOENT:
+		throw not_found("Port not found.");
+	default:
+		throw unknown_error();
+	}
+}
+
+/// \brief Locates the sysfs attribute holding the latency timer of a USB
+/// serial adapter.
+///
+/// \return The path to the attribute, or an empty string if the port does
+///     not have a latency timer.
+string SerialPort_getLatencyTimerPath(string portName)
+{
+	// Resolve links such as the ones in /dev/serial/by-id to the actual
+	// device so we know its name in sysfs.
+	char* resolvedName = realpath(portName.c_str(), NULL);
+
+	if (resolvedName == NULL)
+		throw not_found("Port not found.");
+
+	string deviceName(resolvedName);
+	free(resolvedName);
+
+	size_t lastSeparator = deviceName.find_last_of('/');
+	if (lastSeparator != string::npos)
+		deviceName = deviceName.substr(lastSeparator + 1);
+
+	string path = "/sys/class/tty/" + deviceName + "/device/latency_timer";
+
+	struct stat attributeInfo;
+	if (stat(path.c_str(), &attributeInfo) != 0)
+		return string();
+
+	return path;
+}
+
 #endif
 
 bool SerialPort::determineIfPortIsOptimized(string portName)
 {
-	#if !_WIN32
+	#if __linux__
+
+	LatencySettings settings = latencySettings(portName);
+
+	if (settings.hasLowLatencyMode && !settings.lowLatencyMode)
+		return false;
+
+	if (settings.hasLatencyTimer && settings.latencyTimerMs > 1)
+		return false;
+
+	return true;
+
+	#elif !_WIN32
 
 	// Don't know of any optimizations that need to be done for non-Windows systems.
 	return true;
@@ -1050,9 +1242,59 @@ bool SerialPort::determineIfPortIsOptimized(string portName)
 	#endif
 }
 
-void SerialPort::optimizePort(string portName)
+SerialPort::LatencySettings SerialPort::optimizePort(string portName)
 {
-	#if !_WIN32
+	#if __linux__
+
+	int portFd = SerialPort_openForConfiguration(portName);
+
+	serial_struct serialInfo;
+
+	// Ports which do not support TIOCGSERIAL (such as pseudo terminals) have
+	// no low latency mode to enable.
+	if (ioctl(portFd, TIOCGSERIAL, &serialInfo) == 0)
+	{
+		serialInfo.flags |= ASYNC_LOW_LATENCY;
+
+		if (ioctl(portFd, TIOCSSERIAL, &serialInfo) == -1)
+		{
+			int error = errno;
+
+			::close(portFd);
+
+			if (error == EPERM || error == EACCES)
+				throw permission_denied(portName);
+
+			throw unknown_error();
+		}
+	}
+
+	::close(portFd);
+
+	string latencyTimerPath = SerialPort_getLatencyTimerPath(portName);
+
+	if (!latencyTimerPath.empty())
+	{
+		FILE* latencyTimer = fopen(latencyTimerPath.c_str(), "w");
+
+		if (latencyTimer == NULL)
+		{
+			if (errno == EPERM || errno == EACCES)
+				throw permission_denied(latencyTimerPath);
+
+			throw unknown_error();
+		}
+
+		bool succeeded = fputs("1", latencyTimer) >= 0;
+		succeeded = fclose(latencyTimer) == 0 && succeeded;
+
+		if (!succeeded)
+			throw unknown_error();
+	}
+
+	return latencySettings(portName);
+
+	#elif !_WIN32
 
 	throw not_supported();
 
@@ -1073,9 +1315,83 @@ void SerialPort::optimizePort(string portName)
 		throw unknown_error();
 	}
 
+	return latencySettings(portName);
+
 	#endif
 }
 
+SerialPort::LatencySettings SerialPort::latencySettings(string portName)
+{
+	LatencySettings settings = { false, false, false, 0 };
+
+	#if _WIN32
+
+	if (!SerialPort_isFtdiUsbSerialPort(portName))
+		return settings;
+
+	HKEY ftdiKey = SerialPort_getRegistryKeyForActiveFtdiPort(portName, true);
+
+	DWORD latencyTimerValue;
+	DWORD latencyTimerValueSize = sizeof(latencyTimerValue);
+
+	if (RegQueryValueEx(
+		ftdiKey,
+		TEXT("LatencyTimer"),
+		NULL,
+		NULL,
+		(LPBYTE) &latencyTimerValue,
+		&latencyTimerValueSize) != ERROR_SUCCESS)
+	{
+		throw unknown_error();
+	}
+
+	settings.hasLatencyTimer = true;
+	settings.latencyTimerMs = static_cast<uint8_t>(latencyTimerValue);
+
+	#elif __linux__
+
+	int portFd = SerialPort_openForConfiguration(portName);
+
+	serial_struct serialInfo;
+
+	if (ioctl(portFd, TIOCGSERIAL, &serialInfo) == 0)
+	{
+		settings.hasLowLatencyMode = true;
+		settings.lowLatencyMode = (serialInfo.flags & ASYNC_LOW_LATENCY) != 0;
+	}
+
+	::close(portFd);
+
+	string latencyTimerPath = SerialPort_getLatencyTimerPath(portName);
+
+	if (!latencyTimerPath.empty())
+	{
+		FILE* latencyTimer = fopen(latencyTimerPath.c_str(), "r");
+		unsigned int latencyTimerValue;
+
+		if (latencyTimer == NULL)
+			throw unknown_error();
+
+		bool succeeded = fscanf(latencyTimer, "%u", &latencyTimerValue) == 1;
+		fclose(latencyTimer);
+
+		if (!succeeded)
+			throw unknown_error();
+
+		settings.hasLatencyTimer = true;
+		settings.latencyTimerMs = static_cast<uint8_t>(latencyTimerValue);
+	}
+
+	#else
+
+	// Don't know of any latency settings on other systems.
+	(void) portName;
+
+	#endif
+
+	return settings;
+}
+
 std::vector<std::string> SerialPort::getPortNames()
 {
 	std::vector<std::string> comPorts;
@@ -1360,28 +1676,12 @@ void SerialPort::read(char dataBuffer[], size_t numOfBytesToRead, size_t &numOfB
 
 void SerialPort::registerDataReceivedHandler(void* userData, DataReceivedHandler handler)
 {
-	if (_pi->_dataReceivedHandler != NULL)
-		throw invalid_operation();
-
-	_pi->ObserversCriticalSection.enter();
-
-	_pi->_dataReceivedHandler = handler;
-	_pi->_dataReceivedUserData = userData;
-
-	_pi->ObserversCriticalSection.leave();
+	_pi->DataReceived.registerHandler(userData, handler);
 }
 
 void SerialPort::unregisterDataReceivedHandler()
 {
-	if (_pi->_dataReceivedHandler == NULL)
-		throw invalid_operation();
-
-	_pi->ObserversCriticalSection.enter();
-
-	_pi->_dataReceivedHandler = NULL;
-	_pi->_dataReceivedUserData = NULL;
-
-	_pi->ObserversCriticalSection.leave();
+	_pi->DataReceived.unregisterHandler();
 }
 
 uint32_t SerialPort::baudrate()
@@ -1432,6 +1732,34 @@ size_t SerialPort::NumberOfReceiveDataDroppedSections()
 	#endif
 }
 
+size_t SerialPort::bytesToRead()
+{
+	_pi->ensureOpened();
+
+	#if _WIN32
+
+	COMSTAT comStat;
+	DWORD errors;
+
+	if (!ClearCommError(_pi->SerialPortHandle, &errors, &comStat))
+		throw unknown_error();
+
+	return comStat.cbInQue;
+
+	#elif __linux__ || __APPLE__ || __CYGWIN__ || __QNXNTO__
+
+	int numOfBytes = 0;
+
+	if (ioctl(_pi->SerialPortHandle, FIONREAD, &numOfBytes) == -1)
+		throw unknown_error();
+
+	return static_cast<size_t>(numOfBytes);
+
+	#else
+	#error "Unknown System"
+	#endif
+}
+
 #if PYTHON && !PL156_ORIGINAL && !PL156_FIX_ATTEMPT_1
 
 void SerialPort::stopThread()
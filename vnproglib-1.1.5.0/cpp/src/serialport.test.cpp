@@ -0,0 +1,117 @@
+#include "gtest/gtest.h"
+
+#include "vn/serialport.h"
+#include "vn/exceptions.h"
+
+#if __linux__
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace std;
+using namespace vn::xplat;
+
+namespace {
+
+// A pseudo terminal standing in for a serial port. Pseudo terminals have
+// neither a low latency mode nor a latency timer.
+class PseudoTerminalTest : public ::testing::Test
+{
+protected:
+
+	PseudoTerminalTest() : _master(-1) { }
+
+	virtual void SetUp()
+	{
+		_master = posix_openpt(O_RDWR | O_NOCTTY);
+		ASSERT_NE(-1, _master);
+		ASSERT_EQ(0, grantpt(_master));
+		ASSERT_EQ(0, unlockpt(_master));
+
+		_portName = ptsname(_master);
+	}
+
+	virtual void TearDown()
+	{
+		if (_master != -1)
+			close(_master);
+	}
+
+	int _master;
+	string _portName;
+};
+
+}
+
+TEST_F(PseudoTerminalTest, LatencySettingsReportsNothingToTune)
+{
+	SerialPort::LatencySettings settings = SerialPort::latencySettings(_portName);
+
+	EXPECT_FALSE(settings.hasLowLatencyMode);
+	EXPECT_FALSE(settings.lowLatencyMode);
+	EXPECT_FALSE(settings.hasLatencyTimer);
+}
+
+TEST_F(PseudoTerminalTest, OptimizePortSucceedsWithoutLatencyControls)
+{
+	SerialPort::LatencySettings settings = SerialPort::optimizePort(_portName);
+
+	EXPECT_FALSE(settings.hasLowLatencyMode);
+	EXPECT_FALSE(settings.hasLatencyTimer);
+	EXPECT_TRUE(SerialPort::determineIfPortIsOptimized(_portName));
+}
+
+TEST_F(PseudoTerminalTest, OptimizePortFollowsLinks)
+{
+	// Ports are usually opened through the links in /dev/serial/by-id.
+	char directory[] = "/tmp/vnserialportXXXXXX";
+	ASSERT_TRUE(mkdtemp(directory) != NULL);
+
+	string linkName = string(directory) + "/usb-VectorNav-if00";
+	ASSERT_EQ(0, symlink(_portName.c_str(), linkName.c_str()));
+
+	SerialPort::LatencySettings settings = SerialPort::optimizePort(linkName);
+
+	unlink(linkName.c_str());
+	rmdir(directory);
+
+	EXPECT_FALSE(settings.hasLowLatencyMode);
+	EXPECT_FALSE(settings.hasLatencyTimer);
+}
+
+TEST_F(PseudoTerminalTest, PortStillCarriesDataAfterOptimizing)
+{
+	SerialPort::optimizePort(_portName);
+
+	SerialPort port(_portName, 115200);
+	port.open();
+
+	ASSERT_EQ(5, write(_master, "$VNRR", 5));
+
+	char buffer[16];
+	size_t numOfBytesRead = 0;
+
+	for (int attempt = 0; attempt < 100 && numOfBytesRead == 0; attempt++)
+	{
+		port.read(buffer, sizeof(buffer), numOfBytesRead);
+
+		if (numOfBytesRead == 0)
+			usleep(1000);
+	}
+
+	port.close();
+
+	ASSERT_EQ(5u, numOfBytesRead);
+	EXPECT_EQ(0, memcmp(buffer, "$VNRR", 5));
+}
+
+TEST(SerialPortTest, LatencySettingsThrowsForMissingPort)
+{
+	EXPECT_THROW(SerialPort::latencySettings("/dev/vn-no-such-port"), vn::not_found);
+	EXPECT_THROW(SerialPort::optimizePort("/dev/vn-no-such-port"), vn::not_found);
+}
+
+#endif
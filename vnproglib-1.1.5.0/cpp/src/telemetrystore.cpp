@@ -0,0 +1,632 @@
+#include "vn/telemetrystore.h"
+#include "vn/compositedata.h"
+#include "vn/atomic.h"
+#include "vn/compiler.h"
+#include "vn/cpu.h"
+#include "vn/vntime.h"
+
+#if VN_HAVE_X86_DISPATCH
+	#include <emmintrin.h>
+	#include <immintrin.h>
+#endif
+
+#include <cmath>
+#include <cstring>
+
+using namespace std;
+using namespace vn::math;
+using namespace vn::xplat;
+using namespace vn::protocol::uart;
+
+namespace vn {
+namespace sensors {
+
+namespace {
+
+// Readers copy a slot while the writer may be overwriting it and throw the
+// copy away if so, which a thread sanitizer reports as a race. The writer's
+// stores to the slots are hidden from it so only real races are reported.
+#if defined(__SANITIZE_THREAD__)
+	#define VN_SLOT_STORES __attribute__((no_sanitize_thread))
+#elif defined(__has_feature)
+	#if __has_feature(thread_sanitizer)
+		#define VN_SLOT_STORES __attribute__((no_sanitize("thread")))
+	#endif
+#endif
+
+#if !defined(VN_SLOT_STORES)
+	#define VN_SLOT_STORES
+#endif
+
+// Running totals of the values of one component over a window.
+struct WindowSums
+{
+	double sum;
+	double sumOfSquares;
+	double min;
+	double max;
+};
+
+typedef void (*WindowReducer)(const double* values, size_t count, WindowSums& sums);
+
+void reduceWindowScalar(const double* values, size_t count, WindowSums& sums)
+{
+	for (size_t i = 0; i < count; i++)
+	{
+		double v = values[i];
+
+		sums.sum += v;
+		sums.sumOfSquares += v * v;
+
+		if (v < sums.min)
+			sums.min = v;
+		if (v > sums.max)
+			sums.max = v;
+	}
+}
+
+#if VN_HAVE_X86_DISPATCH
+
+VN_TARGET("sse2")
+void reduceWindowSse2(const double* values, size_t count, WindowSums& sums)
+{
+	__m128d sum = _mm_setzero_pd();
+	__m128d sumOfSquares = _mm_setzero_pd();
+	__m128d min = _mm_set1_pd(sums.min);
+	__m128d max = _mm_set1_pd(sums.max);
+
+	size_t i = 0;
+
+	for (; i + 2 <= count; i += 2)
+	{
+		__m128d v = _mm_loadu_pd(values + i);
+
+		sum = _mm_add_pd(sum, v);
+		sumOfSquares = _mm_add_pd(sumOfSquares, _mm_mul_pd(v, v));
+		min = _mm_min_pd(min, v);
+		max = _mm_max_pd(max, v);
+	}
+
+	double lanes[2];
+
+	_mm_storeu_pd(lanes, sum);
+	sums.sum += lanes[0] + lanes[1];
+	_mm_storeu_pd(lanes, sumOfSquares);
+	sums.sumOfSquares += lanes[0] + lanes[1];
+	_mm_storeu_pd(lanes, min);
+	sums.min = lanes[0] < lanes[1] ? lanes[0] : lanes[1];
+	_mm_storeu_pd(lanes, max);
+	sums.max = lanes[0] > lanes[1] ? lanes[0] : lanes[1];
+
+	reduceWindowScalar(values + i, count - i, sums);
+}
+
+VN_TARGET("avx2")
+void reduceWindowAvx2(const double* values, size_t count, WindowSums& sums)
+{
+	__m256d sum = _mm256_setzero_pd();
+	__m256d sumOfSquares = _mm256_setzero_pd();
+	__m256d min = _mm256_set1_pd(sums.min);
+	__m256d max = _mm256_set1_pd(sums.max);
+
+	size_t i = 0;
+
+	for (; i + 4 <= count; i += 4)
+	{
+		__m256d v = _mm256_loadu_pd(values + i);
+
+		sum = _mm256_add_pd(sum, v);
+		sumOfSquares = _mm256_add_pd(sumOfSquares, _mm256_mul_pd(v, v));
+		min = _mm256_min_pd(min, v);
+		max = _mm256_max_pd(max, v);
+	}
+
+	double lanes[4];
+
+	_mm256_storeu_pd(lanes, sum);
+	sums.sum += (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+	_mm256_storeu_pd(lanes, sumOfSquares);
+	sums.sumOfSquares += (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+
+	_mm256_storeu_pd(lanes, min);
+	sums.min = lanes[0];
+	for (size_t j = 1; j < 4; j++)
+	{
+		if (lanes[j] < sums.min)
+			sums.min = lanes[j];
+	}
+
+	_mm256_storeu_pd(lanes, max);
+	sums.max = lanes[0];
+	for (size_t j = 1; j < 4; j++)
+	{
+		if (lanes[j] > sums.max)
+			sums.max = lanes[j];
+	}
+
+	reduceWindowScalar(values + i, count - i, sums);
+}
+
+#endif
+
+WindowReducer selectWindowReducer()
+{
+	#if VN_HAVE_X86_DISPATCH
+	if (Cpu::hasAvx2())
+		return &reduceWindowAvx2;
+	if (Cpu::hasSse2())
+		return &reduceWindowSse2;
+	#endif
+
+	return &reduceWindowScalar;
+}
+
+// Copies a field's value out of decoded data. Returns false if the field is
+// not present.
+typedef bool (*FieldExtractor)(CompositeData& d, double* v);
+
+template<size_t Dim, typename T>
+void copyComponents(const vec<Dim, T>& from, double* to)
+{
+	for (size_t i = 0; i < Dim; i++)
+		to[i] = from.c[i];
+}
+
+bool extractYawPitchRoll(CompositeData& d, double* v)
+{
+	if (!d.hasYawPitchRoll())
+		return false;
+
+	copyComponents(d.yawPitchRoll(), v);
+
+	return true;
+}
+
+bool extractQuaternion(CompositeData& d, double* v)
+{
+	if (!d.hasQuaternion())
+		return false;
+
+	copyComponents(d.quaternion(), v);
+
+	return true;
+}
+
+bool extractAngularRate(CompositeData& d, double* v)
+{
+	if (!d.hasAngularRate())
+		return false;
+
+	copyComponents(d.angularRate(), v);
+
+	return true;
+}
+
+bool extractAcceleration(CompositeData& d, double* v)
+{
+	if (!d.hasAcceleration())
+		return false;
+
+	copyComponents(d.acceleration(), v);
+
+	return true;
+}
+
+bool extractMagnetic(CompositeData& d, double* v)
+{
+	if (!d.hasMagnetic())
+		return false;
+
+	copyComponents(d.magnetic(), v);
+
+	return true;
+}
+
+bool extractTemperature(CompositeData& d, double* v)
+{
+	if (!d.hasTemperature())
+		return false;
+
+	v[0] = d.temperature();
+
+	return true;
+}
+
+bool extractPressure(CompositeData& d, double* v)
+{
+	if (!d.hasPressure())
+		return false;
+
+	v[0] = d.pressure();
+
+	return true;
+}
+
+bool extractPositionEstimatedLla(CompositeData& d, double* v)
+{
+	if (!d.hasPositionEstimatedLla())
+		return false;
+
+	copyComponents(d.positionEstimatedLla(), v);
+
+	return true;
+}
+
+bool extractVelocityEstimatedNed(CompositeData& d, double* v)
+{
+	if (!d.hasVelocityEstimatedNed())
+		return false;
+
+	copyComponents(d.velocityEstimatedNed(), v);
+
+	return true;
+}
+
+bool extractAttitudeUncertainty(CompositeData& d, double* v)
+{
+	if (!d.hasAttitudeUncertainty())
+		return false;
+
+	copyComponents(d.attitudeUncertainty(), v);
+
+	return true;
+}
+
+struct FieldDescription
+{
+	size_t numOfComponents;
+	FieldExtractor extract;
+};
+
+// Indexed by TelemetryField.
+const FieldDescription FieldDescriptions[TelemetryStore::NumOfFields] =
+{
+	{ 3, &extractYawPitchRoll },
+	{ 4, &extractQuaternion },
+	{ 3, &extractAngularRate },
+	{ 3, &extractAcceleration },
+	{ 3, &extractMagnetic },
+	{ 1, &extractTemperature },
+	{ 1, &extractPressure },
+	{ 3, &extractPositionEstimatedLla },
+	{ 3, &extractVelocityEstimatedNed },
+	{ 3, &extractAttitudeUncertainty }
+};
+
+const size_t CacheLineSize = 64;
+
+size_t roundUpCapacity(size_t capacity)
+{
+	// Keeping the capacity a multiple of 8 samples means every array in a
+	// ring starts on a cache line.
+	size_t rounded = 8;
+
+	while (rounded < capacity)
+		rounded <<= 1;
+
+	return rounded;
+}
+
+}
+
+struct TelemetryStore::Impl
+{
+	// The samples of one field.
+	//
+	// Samples are numbered in the order they are added and sample i is kept
+	// in slot i % capacity. Before the writer starts writing sample i it sets
+	// claimed to i + 1, so readers know that the slot of sample
+	// i - capacity may no longer hold that sample.
+	struct Ring
+	{
+		size_t capacity;
+		size_t numOfComponents;
+		char* storage;
+		uint64_t* timestamps;
+		double* values[4];
+
+		// The number of samples that have been completely written.
+		Atomic<uint64_t> written;
+
+		// The number of samples whose writing has started.
+		Atomic<uint64_t> claimed;
+
+		Ring() :
+			capacity(0),
+			numOfComponents(0),
+			storage(NULL),
+			timestamps(NULL)
+		{
+		}
+
+		~Ring()
+		{
+			delete[] storage;
+		}
+
+		void allocate(size_t newCapacity)
+		{
+			delete[] storage;
+
+			capacity = roundUpCapacity(newCapacity);
+
+			size_t arraySize = capacity * sizeof(uint64_t);
+
+			storage = new char[arraySize * (1 + numOfComponents) + CacheLineSize - 1];
+
+			char* aligned = storage + (CacheLineSize - reinterpret_cast<size_t>(storage) % CacheLineSize) % CacheLineSize;
+
+			timestamps = reinterpret_cast<uint64_t*>(aligned);
+
+			for (size_t i = 0; i < 4; i++)
+				values[i] = i < numOfComponents ? reinterpret_cast<double*>(aligned + arraySize * (1 + i)) : NULL;
+
+			written.store(0);
+			claimed.store(0);
+		}
+
+		VN_SLOT_STORES
+		void add(uint64_t timestamp, const double* v)
+		{
+			uint64_t i = written.load();
+			size_t slot = static_cast<size_t>(i & (capacity - 1));
+
+			claimed.store(i + 1);
+			fenceRelease();
+
+			timestamps[slot] = timestamp;
+			for (size_t c = 0; c < numOfComponents; c++)
+				values[c][slot] = v[c];
+
+			written.storeRelease(i + 1);
+		}
+
+		// Returns the index of the oldest sample that is available and not
+		// about to be overwritten.
+		uint64_t oldest(uint64_t end) const
+		{
+			return end > capacity ? end - capacity : 0;
+		}
+
+		// Indicates if all samples from index first onward read since
+		// written was loaded are intact.
+		bool intact(uint64_t first) const
+		{
+			fenceAcquire();
+
+			return first >= oldest(claimed.load());
+		}
+
+		uint64_t timestamp(uint64_t i) const
+		{
+			return timestamps[i & (capacity - 1)];
+		}
+
+		// Returns the index of the first sample in [begin, end) whose
+		// timestamp is at least t, or is greater than t if after is true.
+		uint64_t search(uint64_t begin, uint64_t end, uint64_t t, bool after) const
+		{
+			while (begin < end)
+			{
+				uint64_t middle = begin + (end - begin) / 2;
+				uint64_t ts = timestamp(middle);
+
+				if (ts < t || (after && ts == t))
+					begin = middle + 1;
+				else
+					end = middle;
+			}
+
+			return begin;
+		}
+
+		void copy(uint64_t i, TelemetrySample& sample) const
+		{
+			size_t slot = static_cast<size_t>(i & (capacity - 1));
+
+			sample.timestamp = timestamps[slot];
+			for (size_t c = 0; c < 4; c++)
+				sample.value[c] = c < numOfComponents ? values[c][slot] : 0;
+		}
+
+		// Reduces one component of the samples [first, last).
+		void reduce(WindowReducer reduceWindow, size_t component, uint64_t first, uint64_t last, WindowSums& sums) const
+		{
+			size_t begin = static_cast<size_t>(first & (capacity - 1));
+			size_t count = static_cast<size_t>(last - first);
+
+			// The window may wrap around the end of the ring.
+			size_t untilWrap = capacity - begin;
+
+			if (count <= untilWrap)
+			{
+				reduceWindow(values[component] + begin, count, sums);
+			}
+			else
+			{
+				reduceWindow(values[component] + begin, untilWrap, sums);
+				reduceWindow(values[component], count - untilWrap, sums);
+			}
+		}
+	};
+
+	Ring rings[NumOfFields];
+
+	WindowReducer reduceWindow;
+
+	// Holds the data of the packet being handled by
+	// asyncPacketReceivedHandler so its storage is reused for every packet.
+	CompositeData receivedData;
+};
+
+TelemetryStore::TelemetryStore(size_t capacity) :
+	_pi(new Impl())
+{
+	_pi->reduceWindow = selectWindowReducer();
+
+	for (size_t i = 0; i < NumOfFields; i++)
+	{
+		_pi->rings[i].numOfComponents = FieldDescriptions[i].numOfComponents;
+		_pi->rings[i].allocate(capacity);
+	}
+}
+
+TelemetryStore::~TelemetryStore()
+{
+	delete _pi;
+}
+
+void TelemetryStore::setCapacity(TelemetryField field, size_t capacity)
+{
+	_pi->rings[field].allocate(capacity);
+}
+
+size_t TelemetryStore::capacity(TelemetryField field) const
+{
+	return _pi->rings[field].capacity;
+}
+
+size_t TelemetryStore::numOfComponents(TelemetryField field)
+{
+	return FieldDescriptions[field].numOfComponents;
+}
+
+void TelemetryStore::add(CompositeData& data, uint64_t timestamp)
+{
+	double v[4];
+
+	for (size_t i = 0; i < NumOfFields; i++)
+	{
+		if (FieldDescriptions[i].extract(data, v))
+			_pi->rings[i].add(timestamp, v);
+	}
+}
+
+bool TelemetryStore::latestTimestamp(TelemetryField field, uint64_t& timestamp) const
+{
+	const Impl::Ring& ring = _pi->rings[field];
+
+	for (;;)
+	{
+		uint64_t end = ring.written.loadAcquire();
+
+		if (end == 0)
+			return false;
+
+		timestamp = ring.timestamp(end - 1);
+
+		if (ring.intact(end - 1))
+			return true;
+	}
+}
+
+size_t TelemetryStore::latest(TelemetryField field, size_t numOfSamples, TelemetrySample* samples) const
+{
+	const Impl::Ring& ring = _pi->rings[field];
+
+	for (;;)
+	{
+		uint64_t end = ring.written.loadAcquire();
+		uint64_t first = ring.oldest(end);
+
+		if (end - first > numOfSamples)
+			first = end - numOfSamples;
+
+		for (uint64_t i = first; i < end; i++)
+			ring.copy(i, samples[i - first]);
+
+		if (ring.intact(first))
+			return static_cast<size_t>(end - first);
+	}
+}
+
+size_t TelemetryStore::range(TelemetryField field, uint64_t from, uint64_t to, TelemetrySample* samples, size_t maxNumOfSamples) const
+{
+	const Impl::Ring& ring = _pi->rings[field];
+
+	for (;;)
+	{
+		uint64_t end = ring.written.loadAcquire();
+		uint64_t begin = ring.oldest(end);
+
+		uint64_t first = ring.search(begin, end, from, false);
+		uint64_t last = ring.search(first, end, to, true);
+
+		if (last - first > maxNumOfSamples)
+			first = last - maxNumOfSamples;
+
+		for (uint64_t i = first; i < last; i++)
+			ring.copy(i, samples[i - first]);
+
+		// The searches may have looked at any sample from begin onward.
+		if (ring.intact(begin))
+			return static_cast<size_t>(last - first);
+	}
+}
+
+bool TelemetryStore::stats(TelemetryField field, uint64_t from, uint64_t to, TelemetryStats& stats) const
+{
+	const Impl::Ring& ring = _pi->rings[field];
+
+	for (;;)
+	{
+		uint64_t end = ring.written.loadAcquire();
+		uint64_t begin = ring.oldest(end);
+
+		uint64_t first = ring.search(begin, end, from, false);
+		uint64_t last = ring.search(first, end, to, true);
+
+		memset(&stats, 0, sizeof(stats));
+		stats.count = static_cast<size_t>(last - first);
+
+		if (stats.count != 0)
+		{
+			for (size_t c = 0; c < ring.numOfComponents; c++)
+			{
+				WindowSums sums;
+				sums.sum = 0;
+				sums.sumOfSquares = 0;
+				sums.min = HUGE_VAL;
+				sums.max = -HUGE_VAL;
+
+				ring.reduce(_pi->reduceWindow, c, first, last, sums);
+
+				stats.mean[c] = sums.sum / stats.count;
+				stats.rms[c] = sqrt(sums.sumOfSquares / stats.count);
+				stats.min[c] = sums.min;
+				stats.max[c] = sums.max;
+			}
+		}
+
+		if (ring.intact(begin))
+			return stats.count != 0;
+	}
+}
+
+void TelemetryStore::asyncPacketReceivedHandler(void* userData, Packet& p, size_t index)
+{
+	(void) index;
+
+	TelemetryStore* store = static_cast<TelemetryStore*>(userData);
+	CompositeData& d = store->_pi->receivedData;
+
+	CompositeData::parseInto(p, d);
+
+	uint64_t timestamp;
+
+	if (d.hasTimeStartup())
+	{
+		timestamp = d.timeStartup();
+	}
+	else
+	{
+		TimeStamp now = TimeStamp::get();
+
+		timestamp = static_cast<uint64_t>(now._sec) * 1000000000 + now._usec * 1000;
+	}
+
+	store->add(d, timestamp);
+}
+
+}
+}
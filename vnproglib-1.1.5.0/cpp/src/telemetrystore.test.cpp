@@ -0,0 +1,280 @@
+#include "gtest/gtest.h"
+
+#include "vn/telemetrystore.h"
+#include "vn/compositedata.h"
+#include "vn/packet.h"
+#include "vn/error_detection.h"
+#include "vn/atomic.h"
+#include "vn/thread.h"
+
+#include <cmath>
+#include <cstring>
+
+using namespace std;
+using namespace vn::sensors;
+using namespace vn::xplat;
+using namespace vn::protocol::uart;
+using namespace vn::data::integrity;
+
+namespace {
+
+// A binary packet holding TimeStartup and YawPitchRoll in the common group.
+// The time is left out when timeStartup is zero.
+Packet makeYawPitchRollPacket(uint64_t timeStartup, float yaw, float pitch, float roll)
+{
+	char packet[26];
+	size_t length = 0;
+
+	packet[length++] = static_cast<char>(0xFA);
+	packet[length++] = 0x01;
+	packet[length++] = timeStartup == 0 ? 0x08 : 0x09;
+	packet[length++] = 0x00;
+
+	if (timeStartup != 0)
+	{
+		memcpy(packet + length, &timeStartup, 8);
+		length += 8;
+	}
+
+	memcpy(packet + length, &yaw, 4);
+	memcpy(packet + length + 4, &pitch, 4);
+	memcpy(packet + length + 8, &roll, 4);
+	length += 12;
+
+	uint16_t crc = Crc16::compute(packet + 1, length - 1);
+	packet[length++] = static_cast<char>(crc >> 8);
+	packet[length++] = static_cast<char>(crc & 0xFF);
+
+	return Packet(packet, length);
+}
+
+// Adds the sample i with the timestamp i and the yaw, pitch and roll i, 2i
+// and 3i, so a reader can tell a sample is whole from its timestamp.
+void addSample(TelemetryStore& store, uint64_t i)
+{
+	Packet p = makeYawPitchRollPacket(0, static_cast<float>(i), static_cast<float>(2 * i), static_cast<float>(3 * i));
+
+	CompositeData d;
+	CompositeData::parseInto(p, d);
+
+	store.add(d, i);
+}
+
+void expectSample(const TelemetrySample& s, uint64_t i)
+{
+	EXPECT_EQ(i, s.timestamp);
+	EXPECT_EQ(static_cast<double>(i), s.value[0]);
+	EXPECT_EQ(static_cast<double>(2 * i), s.value[1]);
+	EXPECT_EQ(static_cast<double>(3 * i), s.value[2]);
+	EXPECT_EQ(0, s.value[3]);
+}
+
+}
+
+TEST(TelemetryStoreTest, CapacityIsRoundedUpToPowerOfTwo)
+{
+	TelemetryStore store(10);
+
+	EXPECT_EQ(16u, store.capacity(TELEMETRYFIELD_YAWPITCHROLL));
+
+	store.setCapacity(TELEMETRYFIELD_PRESSURE, 1);
+
+	EXPECT_EQ(8u, store.capacity(TELEMETRYFIELD_PRESSURE));
+	EXPECT_EQ(16u, store.capacity(TELEMETRYFIELD_YAWPITCHROLL));
+}
+
+TEST(TelemetryStoreTest, OnlyFieldsInTheDataAreRecorded)
+{
+	TelemetryStore store;
+	addSample(store, 5);
+
+	uint64_t timestamp = 0;
+
+	EXPECT_TRUE(store.latestTimestamp(TELEMETRYFIELD_YAWPITCHROLL, timestamp));
+	EXPECT_EQ(5u, timestamp);
+	EXPECT_FALSE(store.latestTimestamp(TELEMETRYFIELD_QUATERNION, timestamp));
+
+	TelemetrySample samples[4];
+
+	EXPECT_EQ(0u, store.latest(TELEMETRYFIELD_QUATERNION, 4, samples));
+}
+
+TEST(TelemetryStoreTest, LatestReturnsNewestSamplesOldestFirst)
+{
+	TelemetryStore store(8);
+
+	for (uint64_t i = 1; i <= 20; i++)
+		addSample(store, i);
+
+	TelemetrySample samples[16];
+
+	ASSERT_EQ(5u, store.latest(TELEMETRYFIELD_YAWPITCHROLL, 5, samples));
+	for (size_t i = 0; i < 5; i++)
+		expectSample(samples[i], 16 + i);
+
+	// Only the last capacity samples survive the ring wrapping around.
+	ASSERT_EQ(8u, store.latest(TELEMETRYFIELD_YAWPITCHROLL, 16, samples));
+	for (size_t i = 0; i < 8; i++)
+		expectSample(samples[i], 13 + i);
+}
+
+TEST(TelemetryStoreTest, RangeIsInclusiveAndKeepsTheNewestSamples)
+{
+	TelemetryStore store(8);
+
+	for (uint64_t i = 1; i <= 20; i++)
+		addSample(store, 10 * i);
+
+	TelemetrySample samples[8];
+
+	ASSERT_EQ(3u, store.range(TELEMETRYFIELD_YAWPITCHROLL, 150, 170, samples, 8));
+	EXPECT_EQ(150u, samples[0].timestamp);
+	EXPECT_EQ(170u, samples[2].timestamp);
+
+	ASSERT_EQ(2u, store.range(TELEMETRYFIELD_YAWPITCHROLL, 145, 170, samples, 2));
+	EXPECT_EQ(160u, samples[0].timestamp);
+	EXPECT_EQ(170u, samples[1].timestamp);
+
+	// Samples which have been overwritten are not in any range.
+	ASSERT_EQ(2u, store.range(TELEMETRYFIELD_YAWPITCHROLL, 0, 140, samples, 8));
+	EXPECT_EQ(130u, samples[0].timestamp);
+	EXPECT_EQ(140u, samples[1].timestamp);
+
+	EXPECT_EQ(0u, store.range(TELEMETRYFIELD_YAWPITCHROLL, 201, 300, samples, 8));
+}
+
+TEST(TelemetryStoreTest, StatsReduceTheWindowAcrossTheEndOfTheRing)
+{
+	TelemetryStore store(8);
+
+	for (uint64_t i = 1; i <= 12; i++)
+		addSample(store, i);
+
+	// Samples 7 to 10 sit at the end and the start of the ring.
+	TelemetryStats stats;
+
+	ASSERT_TRUE(store.stats(TELEMETRYFIELD_YAWPITCHROLL, 7, 10, stats));
+	EXPECT_EQ(4u, stats.count);
+
+	for (size_t c = 0; c < 3; c++)
+	{
+		double scale = static_cast<double>(c + 1);
+
+		EXPECT_DOUBLE_EQ(8.5 * scale, stats.mean[c]);
+		EXPECT_DOUBLE_EQ(7 * scale, stats.min[c]);
+		EXPECT_DOUBLE_EQ(10 * scale, stats.max[c]);
+		EXPECT_DOUBLE_EQ(sqrt((49 + 64 + 81 + 100) / 4.0) * scale, stats.rms[c]);
+	}
+
+	EXPECT_FALSE(store.stats(TELEMETRYFIELD_YAWPITCHROLL, 13, 20, stats));
+	EXPECT_EQ(0u, stats.count);
+}
+
+TEST(TelemetryStoreTest, HandlerTimestampsSamplesWithTimeStartup)
+{
+	TelemetryStore store;
+
+	Packet p = makeYawPitchRollPacket(123456789, 10, 20, 30);
+	TelemetryStore::asyncPacketReceivedHandler(&store, p, 0);
+
+	TelemetrySample sample;
+
+	ASSERT_EQ(1u, store.latest(TELEMETRYFIELD_YAWPITCHROLL, 1, &sample));
+	EXPECT_EQ(123456789u, sample.timestamp);
+	EXPECT_EQ(10, sample.value[0]);
+	EXPECT_EQ(20, sample.value[1]);
+	EXPECT_EQ(30, sample.value[2]);
+}
+
+namespace {
+
+const uint64_t NumOfConcurrentSamples = 100000;
+
+struct ConcurrentReader
+{
+	ConcurrentReader() : store(NULL), done(NULL), numOfTornSamples(0), numOfOutOfOrderSamples(0) { }
+
+	const TelemetryStore* store;
+	const Atomic<bool>* done;
+	size_t numOfTornSamples;
+	size_t numOfOutOfOrderSamples;
+};
+
+bool isWhole(const TelemetrySample& s)
+{
+	double i = static_cast<double>(s.timestamp);
+
+	return s.value[0] == i && s.value[1] == 2 * i && s.value[2] == 3 * i;
+}
+
+// Reads windows while the writer adds samples, counting any sample which
+// mixes two writes and any window which is not consecutive.
+void readConcurrently(void* userData)
+{
+	ConcurrentReader* r = static_cast<ConcurrentReader*>(userData);
+	TelemetrySample samples[8];
+
+	while (!r->done->load())
+	{
+		size_t n = r->store->latest(TELEMETRYFIELD_YAWPITCHROLL, 8, samples);
+
+		for (size_t i = 0; i < n; i++)
+		{
+			if (!isWhole(samples[i]))
+				r->numOfTornSamples++;
+
+			if (i != 0 && samples[i].timestamp != samples[i - 1].timestamp + 1)
+				r->numOfOutOfOrderSamples++;
+		}
+
+		n = r->store->range(TELEMETRYFIELD_YAWPITCHROLL, 0, NumOfConcurrentSamples, samples, 8);
+
+		for (size_t i = 0; i < n; i++)
+		{
+			if (!isWhole(samples[i]))
+				r->numOfTornSamples++;
+
+			if (i != 0 && samples[i].timestamp != samples[i - 1].timestamp + 1)
+				r->numOfOutOfOrderSamples++;
+		}
+	}
+}
+
+}
+
+TEST(TelemetryStoreTest, ReadersSeeWholeSamplesWhileWriterAdds)
+{
+	// A small ring has the writer overtake the readers often.
+	TelemetryStore store(8);
+	Atomic<bool> done(false);
+
+	const size_t NumOfReaders = 2;
+	ConcurrentReader readers[NumOfReaders];
+	Thread* threads[NumOfReaders];
+
+	for (size_t i = 0; i < NumOfReaders; i++)
+	{
+		readers[i].store = &store;
+		readers[i].done = &done;
+		threads[i] = Thread::startNew(readConcurrently, &readers[i]);
+	}
+
+	for (uint64_t i = 1; i <= NumOfConcurrentSamples; i++)
+		addSample(store, i);
+
+	done.store(true);
+
+	for (size_t i = 0; i < NumOfReaders; i++)
+	{
+		threads[i]->join();
+		delete threads[i];
+
+		EXPECT_EQ(0u, readers[i].numOfTornSamples);
+		EXPECT_EQ(0u, readers[i].numOfOutOfOrderSamples);
+	}
+
+	TelemetrySample sample;
+
+	ASSERT_EQ(1u, store.latest(TELEMETRYFIELD_YAWPITCHROLL, 1, &sample));
+	expectSample(sample, NumOfConcurrentSamples);
+}
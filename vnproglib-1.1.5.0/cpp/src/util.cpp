@@ -8,8 +8,6 @@ namespace vn {
 namespace protocol {
 namespace uart {
 
-char* vnstrtok(char* str, size_t& startIndex);
-
 string str(AsciiAsync val)
 {
 	switch (val)